@@ -0,0 +1,102 @@
+#include <dekaf2/time/duration/kprof.h>
+#include <dekaf2/system/process/kchildprocess.h>
+#include <vector>
+#include <cstring>
+
+#ifndef DEKAF2_IS_WINDOWS
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace dekaf2;
+
+// Compares starting a child process with fork() and exec(), as KChildProcess and
+// KBasePipe did before, with posix_spawn(), at different resident sizes of the
+// parent. fork() copies the page tables of the parent, which takes longer the
+// more memory the parent has mapped, posix_spawn() does not copy them.
+
+namespace {
+
+//-----------------------------------------------------------------------------
+/// the former way to start a child
+pid_t ForkExec(const char* const argV[])
+//-----------------------------------------------------------------------------
+{
+	auto pid = ::fork();
+
+	if (pid == 0)
+	{
+		::execvp(argV[0], const_cast<char* const*>(argV));
+		::_exit(127);
+	}
+
+	return pid;
+
+} // ForkExec
+
+//-----------------------------------------------------------------------------
+void Wait(pid_t pid)
+//-----------------------------------------------------------------------------
+{
+	if (pid > 0)
+	{
+		int iStatus;
+		::waitpid(pid, &iStatus, 0);
+	}
+
+} // Wait
+
+//-----------------------------------------------------------------------------
+/// the profiler keeps the label pointers, therefore they have to be literals
+void Bench(std::size_t iMegaBytes, const char* sForkLabel, const char* sSpawnLabel)
+//-----------------------------------------------------------------------------
+{
+	// grow the resident size of this process - every page has to be touched
+	std::vector<char> Ballast(iMegaBytes * 1024 * 1024);
+	std::memset(Ballast.data(), 1, Ballast.size());
+
+	static constexpr std::size_t iRounds = 100;
+	const char* argV[] = { "true", nullptr };
+
+	{
+		dekaf2::KProf prof(sForkLabel);
+		prof.SetMultiplier(iRounds);
+
+		for (std::size_t i = 0; i < iRounds; ++i)
+		{
+			Wait(ForkExec(argV));
+		}
+	}
+
+	{
+		dekaf2::KProf prof(sSpawnLabel);
+		prof.SetMultiplier(iRounds);
+
+		for (std::size_t i = 0; i < iRounds; ++i)
+		{
+			Wait(detail::kSpawn(argV));
+		}
+	}
+
+	KProf::Force(Ballast.data());
+
+} // Bench
+
+} // anonymous namespace
+
+void kchildprocess_bench()
+{
+	dekaf2::KProf ps("-KChildProcess");
+
+	Bench(   0, "fork+exec (RSS +0 MB)"   , "posix_spawn (RSS +0 MB)"   );
+	Bench( 256, "fork+exec (RSS +256 MB)" , "posix_spawn (RSS +256 MB)" );
+	Bench(1024, "fork+exec (RSS +1024 MB)", "posix_spawn (RSS +1024 MB)");
+}
+
+#else
+
+void kchildprocess_bench()
+{
+}
+
+#endif
@@ -0,0 +1,104 @@
+#include <dekaf2/time/duration/kprof.h>
+#include <dekaf2/core/strings/kstring.h>
+#include <dekaf2/core/format/kformat.h>
+#include <dekaf2/data/csv/kcsv.h>
+#include <dekaf2/io/readwrite/kreader.h>
+#include <dekaf2/io/readwrite/kwriter.h>
+#include <dekaf2/io/readwrite/kmemorymap.h>
+#include <dekaf2/system/filesystem/kfilesystem.h>
+#include <dekaf2/system/os/ksystem.h>
+#include <atomic>
+
+using namespace dekaf2;
+
+// Compares reading a CSV file with the stream based KInCSV, which pulls one character
+// at a time from the file stream, with the KInCSVBuffer on a memory map of the same
+// file, sequentially and in parallel. Most columns are plain, some are quoted, and a
+// few need unescaping.
+
+namespace {
+
+//-----------------------------------------------------------------------------
+std::size_t CreateFile(KStringViewZ sFilename, std::size_t iRecords)
+//-----------------------------------------------------------------------------
+{
+	KOutFile File(sFilename);
+	KOutCSV CSV(File);
+
+	for (std::size_t i = 0; i < iRecords; ++i)
+	{
+		CSV.Write(std::vector<KString>
+		{
+			kFormat("{}", i),
+			"2026-10-17 12:34:56",
+			"some plain text column",
+			"a column, with a comma",
+			(i % 10) ? "4711.42" : "a \"quoted\" word",
+			"last"
+		});
+	}
+
+	return iRecords;
+
+} // CreateFile
+
+} // anonymous namespace
+
+void kcsv_bench()
+{
+	KString sFilename = kFormat("{}{}dekaf2_csv_bench.csv", kGetTemp(), kDirSep);
+
+	auto iRecords = CreateFile(sFilename, 500000);
+
+	dekaf2::KProf ps("-KCSV");
+
+	{
+		dekaf2::KProf prof("KInCSV stream");
+		prof.SetMultiplier(iRecords);
+
+		KInFile File(sFilename);
+		std::size_t iColumns { 0 };
+
+		for (const auto& Record : KInCSV<>(File))
+		{
+			iColumns += Record.size();
+		}
+
+		KProf::Force(&iColumns);
+	}
+
+	{
+		dekaf2::KProf prof("KInCSVBuffer memory map");
+		prof.SetMultiplier(iRecords);
+
+		KConstMemoryMap Map(sFilename);
+		KInCSVBuffer CSV(Map.ToView());
+		KInCSVBuffer::Record Record;
+		std::size_t iColumns { 0 };
+
+		while (CSV.Read(Record))
+		{
+			iColumns += Record.size();
+		}
+
+		KProf::Force(&iColumns);
+	}
+
+	{
+		dekaf2::KProf prof("KInCSVBuffer memory map, parallel");
+		prof.SetMultiplier(iRecords);
+
+		KConstMemoryMap Map(sFilename);
+		KInCSVBuffer CSV(Map.ToView());
+		std::atomic<std::size_t> iColumns { 0 };
+
+		CSV.ParallelRead([&iColumns](KInCSVBuffer::Record& Record, std::size_t)
+		{
+			iColumns += Record.size();
+		});
+
+		KProf::Force(&iColumns);
+	}
+
+	kRemoveFile(sFilename);
+}
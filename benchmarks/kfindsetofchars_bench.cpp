@@ -6,6 +6,8 @@
 #include <cinttypes>
 #include <dekaf2/time/duration/kprof.h>
 #include <dekaf2/core/strings/kstring.h>
+#include <dekaf2/core/strings/kcaseless.h>
+#include <dekaf2/core/strings/bits/simd/ksimd.h>
 
 using namespace dekaf2;
 
@@ -857,6 +859,69 @@ void kfindsetofchars()
 		}
 	}
 
+	// -----------------------------------------------------------------
+	// the set search and a caseless compare with each instruction set
+	// level this CPU supports, the labels are indexed by detail::KSimd::Level
+	// -----------------------------------------------------------------
+	{
+		static constexpr const char* FindLabels[] {
+			"soc find_first_of (5000) ns=8 scalar",
+			"soc find_first_of (5000) ns=8 sse2",
+			"soc find_first_of (5000) ns=8 ssse3",
+			"soc find_first_of (5000) ns=8 sse4.2",
+			"soc find_first_of (5000) ns=8 avx2",
+			"soc find_first_of (5000) ns=8 avx512",
+			"soc find_first_of (5000) ns=8 neon"
+		};
+		static constexpr const char* CaselessLabels[] {
+			"kCaselessEqual (5000) scalar",
+			"kCaselessEqual (5000) sse2",
+			"kCaselessEqual (5000) ssse3",
+			"kCaselessEqual (5000) sse4.2",
+			"kCaselessEqual (5000) avx2",
+			"kCaselessEqual (5000) avx512",
+			"kCaselessEqual (5000) neon"
+		};
+
+		using KSimd = detail::KSimd;
+
+		const auto StartLevel = KSimd::GetLevel();
+		SoC = KFindSetOfChars("defghijw");
+		dekaf2::KString s(5000, '-');
+		s.append("abcdefg");
+		dekaf2::KStringView sv(s);
+		auto sUpper = sHaystackSource.substr(0, 5000).ToUpperASCII();
+		auto sLower = sHaystackSource.substr(0, 5000).ToLowerASCII();
+
+		for (uint8_t i = KSimd::Scalar; i <= KSimd::GetCPULevel(); ++i)
+		{
+			auto Level = KSimd::SetLevel(static_cast<KSimd::Level>(i));
+
+			if (Level != i) continue;
+
+			{
+				dekaf2::KProf prof(FindLabels[Level]);
+				prof.SetMultiplier(200000);
+				for (int ct = 0; ct < 200000; ++ct)
+				{
+					KProf::Force(&sv);
+					if (SoC.find_first_in(sv) < 100) KProf::Force();
+				}
+			}
+			{
+				dekaf2::KProf prof(CaselessLabels[Level]);
+				prof.SetMultiplier(200000);
+				for (int ct = 0; ct < 200000; ++ct)
+				{
+					KProf::Force(&sUpper);
+					if (!kCaselessEqual(sUpper, sLower)) KProf::Force();
+				}
+			}
+		}
+
+		KSimd::SetLevel(StartLevel);
+	}
+
 	// -----------------------------------------------------------------
 	// construction-only cost: independent of haystack size/content,
 	// so a single measurement per needle set is enough
@@ -0,0 +1,105 @@
+#include <dekaf2/time/duration/kprof.h>
+#include <dekaf2/core/strings/kstring.h>
+#include <dekaf2/core/format/kformat.h>
+#include <dekaf2/containers/associative/kassociative.h>
+#include <dekaf2/containers/associative/kflathash.h>
+#include <unordered_map>
+#include <vector>
+
+using namespace dekaf2;
+
+// Compares insert, find and erase on the open addressing KFlatHashMap with the
+// boost::multi_index based KUnorderedMap and with std::unordered_map, for string
+// and for integer keys. Half of the lookups are misses.
+
+namespace {
+
+struct Labels
+{
+	const char* sInsert;
+	const char* sFind;
+	const char* sErase;
+};
+
+//-----------------------------------------------------------------------------
+/// the profiler keeps the label pointers, therefore they have to be literals
+template<class Map, class Key>
+void Bench(const std::vector<Key>& Keys, const Labels& Label)
+//-----------------------------------------------------------------------------
+{
+	// the first half of the keys is inserted, the second half only searched
+	auto iHalf = Keys.size() / 2;
+	Map map;
+
+	{
+		dekaf2::KProf prof(Label.sInsert);
+		prof.SetMultiplier(iHalf);
+
+		for (std::size_t i = 0; i < iHalf; ++i)
+		{
+			map.emplace(Keys[i], i);
+		}
+	}
+
+	{
+		dekaf2::KProf prof(Label.sFind);
+		prof.SetMultiplier(Keys.size());
+
+		std::size_t iFound { 0 };
+
+		for (const auto& key : Keys)
+		{
+			iFound += (map.find(key) != map.end());
+		}
+
+		KProf::Force(&iFound);
+	}
+
+	{
+		dekaf2::KProf prof(Label.sErase);
+		prof.SetMultiplier(iHalf);
+
+		for (std::size_t i = 0; i < iHalf; ++i)
+		{
+			map.erase(Keys[i]);
+		}
+	}
+
+	KProf::Force(&map);
+
+} // Bench
+
+} // anonymous namespace
+
+void kflathash_bench()
+{
+	dekaf2::KProf ps("-KFlatHash");
+
+	constexpr std::size_t iCount = 200000;
+
+	std::vector<KString> StringKeys;
+	std::vector<uint64_t> IntKeys;
+
+	StringKeys.reserve(iCount);
+	IntKeys.reserve(iCount);
+
+	for (std::size_t i = 0; i < iCount; ++i)
+	{
+		StringKeys.push_back(kFormat("some/path/to/key/{}", i * 7919));
+		IntKeys.push_back(i * 0x9E3779B97F4A7C15ULL);
+	}
+
+	Bench<KFlatHashMap<KString, std::size_t>>(StringKeys,
+		{ "KFlatHashMap<KString> insert", "KFlatHashMap<KString> find", "KFlatHashMap<KString> erase" });
+	Bench<KUnorderedMap<KString, std::size_t>>(StringKeys,
+		{ "KUnorderedMap<KString> insert", "KUnorderedMap<KString> find", "KUnorderedMap<KString> erase" });
+	Bench<std::unordered_map<KString, std::size_t>>(StringKeys,
+		{ "std::unordered_map<KString> insert", "std::unordered_map<KString> find", "std::unordered_map<KString> erase" });
+
+	Bench<KFlatHashMap<uint64_t, std::size_t>>(IntKeys,
+		{ "KFlatHashMap<uint64_t> insert", "KFlatHashMap<uint64_t> find", "KFlatHashMap<uint64_t> erase" });
+	Bench<KUnorderedMap<uint64_t, std::size_t>>(IntKeys,
+		{ "KUnorderedMap<uint64_t> insert", "KUnorderedMap<uint64_t> find", "KUnorderedMap<uint64_t> erase" });
+	Bench<std::unordered_map<uint64_t, std::size_t>>(IntKeys,
+		{ "std::unordered_map<uint64_t> insert", "std::unordered_map<uint64_t> find", "std::unordered_map<uint64_t> erase" });
+}
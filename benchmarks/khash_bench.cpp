@@ -13,10 +13,30 @@ void khash_bench()
 {
 	dekaf2::KProf ps("-Hash/CRC");
 
+	KString sTiny(16, 'a');
 	KString sShort(64, 'A');
 	KString sMedium(1024, 'B');
 	KString sLarge(65536, 'C');
 
+	{
+		dekaf2::KProf prof("KHash FNV 16B");
+		prof.SetMultiplier(1000000);
+		for (int ct = 0; ct < 1000000; ++ct)
+		{
+			auto v = kHash(sTiny.data(), sTiny.size());
+			KProf::Force(&v);
+		}
+	}
+	{
+		dekaf2::KProf prof("kFastHash 16B");
+		prof.SetMultiplier(1000000);
+		for (int ct = 0; ct < 1000000; ++ct)
+		{
+			auto v = kFastHash(sTiny.data(), sTiny.size());
+			KProf::Force(&v);
+		}
+	}
+
 	{
 		dekaf2::KProf prof("KHash FNV 64B");
 		prof.SetMultiplier(100000);
@@ -47,6 +67,81 @@ void khash_bench()
 			KProf::Force(&v);
 		}
 	}
+	{
+		dekaf2::KProf prof("kFastHash 64B");
+		prof.SetMultiplier(100000);
+		for (int ct = 0; ct < 100000; ++ct)
+		{
+			auto v = kFastHash(sShort.data(), sShort.size());
+			KProf::Force(&v);
+		}
+	}
+	{
+		dekaf2::KProf prof("kFastHash 1KB");
+		prof.SetMultiplier(100000);
+		for (int ct = 0; ct < 100000; ++ct)
+		{
+			auto v = kFastHash(sMedium.data(), sMedium.size());
+			KProf::Force(&v);
+		}
+	}
+	{
+		dekaf2::KProf prof("kFastHash 64KB");
+		prof.SetMultiplier(5000);
+		for (int ct = 0; ct < 5000; ++ct)
+		{
+			auto v = kFastHash(sLarge.data(), sLarge.size());
+			KProf::Force(&v);
+		}
+	}
+	{
+		dekaf2::KProf prof("KCaseHash FNV 64B");
+		prof.SetMultiplier(100000);
+		for (int ct = 0; ct < 100000; ++ct)
+		{
+			KCaseHash h(sShort);
+			auto v = h.Hash();
+			KProf::Force(&v);
+		}
+	}
+	{
+		dekaf2::KProf prof("KCaseHash FNV 1KB");
+		prof.SetMultiplier(100000);
+		for (int ct = 0; ct < 100000; ++ct)
+		{
+			KCaseHash h(sMedium);
+			auto v = h.Hash();
+			KProf::Force(&v);
+		}
+	}
+	{
+		dekaf2::KProf prof("kFastCaseHash 64B");
+		prof.SetMultiplier(100000);
+		for (int ct = 0; ct < 100000; ++ct)
+		{
+			auto v = kFastCaseHash(sShort.data(), sShort.size());
+			KProf::Force(&v);
+		}
+	}
+	{
+		dekaf2::KProf prof("kFastCaseHash 1KB");
+		prof.SetMultiplier(100000);
+		for (int ct = 0; ct < 100000; ++ct)
+		{
+			auto v = kFastCaseHash(sMedium.data(), sMedium.size());
+			KProf::Force(&v);
+		}
+	}
+	{
+		// FNV or wyhash, depending on DEKAF2_USE_FAST_HASH
+		dekaf2::KProf prof("std::hash<KString> 64B");
+		prof.SetMultiplier(100000);
+		for (int ct = 0; ct < 100000; ++ct)
+		{
+			auto v = std::hash<KString>()(sShort);
+			KProf::Force(&v);
+		}
+	}
 	{
 		dekaf2::KProf prof("KCRC32 64B");
 		prof.SetMultiplier(100000);
@@ -77,6 +172,36 @@ void khash_bench()
 			KProf::Force(&v);
 		}
 	}
+	{
+		dekaf2::KProf prof("KCRC32C 64B");
+		prof.SetMultiplier(100000);
+		for (int ct = 0; ct < 100000; ++ct)
+		{
+			KCRC32C crc(sShort);
+			auto v = crc.CRC();
+			KProf::Force(&v);
+		}
+	}
+	{
+		dekaf2::KProf prof("KCRC32C 1KB");
+		prof.SetMultiplier(100000);
+		for (int ct = 0; ct < 100000; ++ct)
+		{
+			KCRC32C crc(sMedium);
+			auto v = crc.CRC();
+			KProf::Force(&v);
+		}
+	}
+	{
+		dekaf2::KProf prof("KCRC32C 64KB");
+		prof.SetMultiplier(5000);
+		for (int ct = 0; ct < 5000; ++ct)
+		{
+			KCRC32C crc(sLarge);
+			auto v = crc.CRC();
+			KProf::Force(&v);
+		}
+	}
 	{
 		dekaf2::KProf prof("MD5 64B");
 		prof.SetMultiplier(50000);
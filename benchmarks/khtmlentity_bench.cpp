@@ -4,6 +4,7 @@
 #include <dekaf2/core/strings/kstring.h>
 #include <dekaf2/core/strings/kstringview.h>
 #include <dekaf2/web/html/khtmlentities.h>
+#include <dekaf2/io/streams/koutstringstream.h>
 
 using namespace dekaf2;
 
@@ -19,6 +20,14 @@ void khtmlentity_bench()
 	KString sLongPlain(2000, 'x');
 	sLongPlain += " <tag> & \"quoted\" text ";
 
+	// markup with a special character every few bytes
+	KString sLongHeavy;
+
+	for (int i = 0; i < 50; ++i)
+	{
+		sLongHeavy += "<a href=\"x?a=1&b=2\">it's</a> ";
+	}
+
 	KString sLongEncoded(2000, 'x');
 	sLongEncoded += " &lt;tag&gt; &amp; &quot;quoted&quot; text ";
 
@@ -49,6 +58,26 @@ void khtmlentity_bench()
 			KProf::Force(&s);
 		}
 	}
+	{
+		dekaf2::KProf prof("EncodeMandatory long heavy");
+		prof.SetMultiplier(10000);
+		for (int ct = 0; ct < 10000; ++ct)
+		{
+			KString s = KHTMLEntity::EncodeMandatory(sLongHeavy);
+			KProf::Force(&s);
+		}
+	}
+	{
+		dekaf2::KProf prof("EncodeMandatory stream long");
+		prof.SetMultiplier(10000);
+		for (int ct = 0; ct < 10000; ++ct)
+		{
+			KString s;
+			KOStringStream oss(s);
+			KHTMLEntity::EncodeMandatory(oss, sLongPlain);
+			KProf::Force(&s);
+		}
+	}
 	{
 		dekaf2::KProf prof("Encode full");
 		prof.SetMultiplier(50000);
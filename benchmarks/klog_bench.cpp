@@ -0,0 +1,102 @@
+#include <cinttypes>
+#include <thread>
+#include <vector>
+#include <dekaf2/time/duration/kprof.h>
+#include <dekaf2/core/strings/kstring.h>
+#include <dekaf2/core/format/kformat.h>
+#include <dekaf2/core/logging/klog.h>
+#include <dekaf2/system/filesystem/kfilesystem.h>
+
+using namespace dekaf2;
+
+// Measures the cost of one log line written by kDebug() into a log file, with 1 to 32
+// threads logging concurrently. The "sync" cases serialize and write under the log mutex,
+// the "async" cases serialize into thread local serializers and hand the lines to the
+// background writer thread. The async numbers include the final flush of the queue, so
+// they show the sustained throughput and not only the time the producers were busy.
+// Numbers are per log line, measured as wall time over all threads.
+
+namespace {
+
+constexpr std::size_t s_iLinesTotal = 200000;
+
+struct Labels
+{
+	std::size_t iThreads;
+	const char* sSync;
+	const char* sAsync;
+};
+
+// the profiler keeps the label pointers, therefore they have to be literals
+constexpr Labels s_Labels[]
+{
+	{  1, "log line  1 thread  (sync)" , "log line  1 thread  (async)"  },
+	{  2, "log line  2 threads (sync)" , "log line  2 threads (async)"  },
+	{  4, "log line  4 threads (sync)" , "log line  4 threads (async)"  },
+	{  8, "log line  8 threads (sync)" , "log line  8 threads (async)"  },
+	{ 16, "log line 16 threads (sync)" , "log line 16 threads (async)"  },
+	{ 32, "log line 32 threads (sync)" , "log line 32 threads (async)"  },
+};
+
+//-----------------------------------------------------------------------------
+void Bench(std::size_t iThreads, bool bAsync, const char* sLabel)
+//-----------------------------------------------------------------------------
+{
+	auto& Log = KLog::getInstance();
+
+	Log.SetAsync(bAsync);
+
+	std::vector<std::thread> Threads;
+	Threads.reserve(iThreads);
+
+	dekaf2::KProf prof(sLabel);
+	prof.SetMultiplier(s_iLinesTotal);
+
+	for (std::size_t t = 0; t < iThreads; ++t)
+	{
+		Threads.emplace_back([t](std::size_t iLines)
+		{
+			KLog::SyncLevel();
+
+			for (std::size_t i = 0; i < iLines; ++i)
+			{
+				kDebug(1, "thread {} writes line {} of {}", t, i, iLines);
+			}
+
+		}, s_iLinesTotal / iThreads);
+	}
+
+	for (auto& Thread : Threads)
+	{
+		Thread.join();
+	}
+
+	Log.Flush();
+
+} // Bench
+
+} // anonymous namespace
+
+void klog_bench()
+{
+	dekaf2::KProf ps("-KLog");
+
+	auto&   Log       = KLog::getInstance();
+	KString sOldLog   = Log.GetDebugLog();
+	auto    iOldLevel = Log.GetLevel();
+
+	KTempDir TempDir;
+
+	Log.SetDebugLog(kFormat("{}{}klog_bench.log", TempDir.Name(), kDirSep));
+	Log.SetLevel(1);
+
+	for (const auto& Label : s_Labels)
+	{
+		Bench(Label.iThreads, false, Label.sSync);
+		Bench(Label.iThreads, true , Label.sAsync);
+	}
+
+	Log.SetAsync(false);
+	Log.SetLevel(iOldLevel);
+	Log.SetDebugLog(sOldLog);
+}
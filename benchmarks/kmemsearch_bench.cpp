@@ -18,6 +18,7 @@
 #include <dekaf2/core/strings/kstring.h>
 #include <dekaf2/core/strings/kstringview.h>
 #include <dekaf2/core/strings/bits/kstring_view.h>
+#include <dekaf2/core/strings/bits/simd/ksimd.h>
 
 using namespace dekaf2;
 
@@ -505,5 +506,62 @@ void kmemsearch_bench()
 				if (sv.find_last_not_of('-') != KStringView::npos) KProf::Force();
 			}
 		}
+
+		// the same scans with each instruction set level this CPU supports,
+		// indexed by detail::KSimd::Level
+		{
+			static constexpr const char* FirstLabels[] {
+				"find_first_not_of(ch) 5000 miss scalar",
+				"find_first_not_of(ch) 5000 miss sse2",
+				"find_first_not_of(ch) 5000 miss ssse3",
+				"find_first_not_of(ch) 5000 miss sse4.2",
+				"find_first_not_of(ch) 5000 miss avx2",
+				"find_first_not_of(ch) 5000 miss avx512",
+				"find_first_not_of(ch) 5000 miss neon"
+			};
+			static constexpr const char* LastLabels[] {
+				"find_last_not_of(ch) 5000 miss scalar",
+				"find_last_not_of(ch) 5000 miss sse2",
+				"find_last_not_of(ch) 5000 miss ssse3",
+				"find_last_not_of(ch) 5000 miss sse4.2",
+				"find_last_not_of(ch) 5000 miss avx2",
+				"find_last_not_of(ch) 5000 miss avx512",
+				"find_last_not_of(ch) 5000 miss neon"
+			};
+
+			using KSimd = detail::KSimd;
+
+			const auto StartLevel = KSimd::GetLevel();
+			std::string s(5000, '-');
+			KStringView sv(s);
+
+			for (uint8_t i = KSimd::Scalar; i <= KSimd::GetCPULevel(); ++i)
+			{
+				auto Level = KSimd::SetLevel(static_cast<KSimd::Level>(i));
+
+				if (Level != i) continue;
+
+				{
+					dekaf2::KProf prof(FirstLabels[Level]);
+					prof.SetMultiplier(200000);
+					for (int ct = 0; ct < 200000; ++ct)
+					{
+						KProf::Force(s.data());
+						if (sv.find_first_not_of('-') != KStringView::npos) KProf::Force();
+					}
+				}
+				{
+					dekaf2::KProf prof(LastLabels[Level]);
+					prof.SetMultiplier(200000);
+					for (int ct = 0; ct < 200000; ++ct)
+					{
+						KProf::Force(s.data());
+						if (sv.find_last_not_of('-') != KStringView::npos) KProf::Force();
+					}
+				}
+			}
+
+			KSimd::SetLevel(StartLevel);
+		}
 	}
 }
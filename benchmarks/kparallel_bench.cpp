@@ -0,0 +1,104 @@
+#include <cinttypes>
+#include <mutex>
+#include <dekaf2/time/duration/kprof.h>
+#include <dekaf2/threading/execution/kparallel.h>
+
+using namespace dekaf2;
+
+// Compares the former kParallelForEach(), which starts new threads on every call and
+// takes a mutex for every element to advance the shared iterator, with kParallelFor()
+// on the persistent work stealing scheduler. The work per element is tiny, so the
+// per element overhead dominates.
+
+namespace {
+
+thread_local uint64_t t_iSink { 0 };
+
+//-----------------------------------------------------------------------------
+inline void Work(std::size_t i)
+//-----------------------------------------------------------------------------
+{
+	t_iSink += (i * 0x9E3779B97F4A7C15ULL) >> 7;
+}
+
+//-----------------------------------------------------------------------------
+/// the former implementation of kParallelForEach(), on an index instead of an iterator
+void FormerParallelForEach(std::size_t iSize)
+//-----------------------------------------------------------------------------
+{
+	std::mutex IterMutex;
+	std::size_t iNext { 0 };
+
+	auto Loop = [&]()
+	{
+		for (;;)
+		{
+			std::size_t i;
+
+			{
+				std::lock_guard<std::mutex> Lock(IterMutex);
+
+				if (iNext == iSize)
+				{
+					return;
+				}
+
+				i = iNext++;
+			}
+
+			Work(i);
+		}
+	};
+
+	auto iThreads = std::max(std::thread::hardware_concurrency(), 2u);
+
+	KRunThreads Threads(iThreads - 1, iSize - 1);
+	Threads.Create(std::ref(Loop));
+	Loop();
+}
+
+//-----------------------------------------------------------------------------
+/// the profiler keeps the label pointers, therefore they have to be literals
+void Bench(std::size_t iSize, std::size_t iRounds, const char* sFormerLabel, const char* sSchedulerLabel)
+//-----------------------------------------------------------------------------
+{
+	{
+		dekaf2::KProf prof(sFormerLabel);
+		prof.SetMultiplier(iRounds * iSize);
+
+		for (std::size_t i = 0; i < iRounds; ++i)
+		{
+			FormerParallelForEach(iSize);
+		}
+	}
+
+	{
+		dekaf2::KProf prof(sSchedulerLabel);
+		prof.SetMultiplier(iRounds * iSize);
+
+		for (std::size_t i = 0; i < iRounds; ++i)
+		{
+			kParallelFor(0, iSize, Work);
+		}
+	}
+
+	KProf::Force(&t_iSink);
+
+} // Bench
+
+} // anonymous namespace
+
+void kparallel_bench()
+{
+	dekaf2::KProf ps("-kParallel");
+
+	// start the scheduler threads outside of the measurements
+	kParallelFor(0, 1, Work);
+
+	Bench(     1000, 1000, "former kParallelForEach (1e3)", "kParallelFor (1e3)");
+	Bench(    10000,  100, "former kParallelForEach (1e4)", "kParallelFor (1e4)");
+	Bench(   100000,   10, "former kParallelForEach (1e5)", "kParallelFor (1e5)");
+	Bench(  1000000,    3, "former kParallelForEach (1e6)", "kParallelFor (1e6)");
+	Bench( 10000000,    1, "former kParallelForEach (1e7)", "kParallelFor (1e7)");
+	Bench(100000000,    1, "former kParallelForEach (1e8)", "kParallelFor (1e8)");
+}
@@ -12,6 +12,7 @@
 #include <dekaf2/containers/associative/kprops.h>
 #include <dekaf2/web/url/kurlencode.h>
 #include <dekaf2/containers/associative/kassociative.h>
+#include <dekaf2/http/protocol/khttp_header.h>
 
 using namespace std;
 using namespace dekaf2;
@@ -1117,6 +1118,68 @@ void maps()
 	}
 }
 
+// a typical browser request, with 14 headers
+constexpr KStringView sRequestHeaders =
+	"Host: www.example.com\r\n"
+	"User-Agent: Mozilla/5.0 (X11; Linux x86_64; rv:128.0) Gecko/20100101 Firefox/128.0\r\n"
+	"Accept: text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8\r\n"
+	"Accept-Language: en-US,en;q=0.5\r\n"
+	"Accept-Encoding: gzip, deflate, br, zstd\r\n"
+	"Referer: https://www.example.com/index.html\r\n"
+	"Connection: keep-alive\r\n"
+	"Cookie: session=0123456789abcdef; theme=dark\r\n"
+	"Upgrade-Insecure-Requests: 1\r\n"
+	"Sec-Fetch-Dest: document\r\n"
+	"Sec-Fetch-Mode: navigate\r\n"
+	"Sec-Fetch-Site: same-origin\r\n"
+	"Priority: u=0, i\r\n"
+	"X-Forwarded-For: 192.168.1.1\r\n";
+
+template <class HeaderMap>
+void run_header_bench(const char* label)
+{
+	std::size_t iFound { 0 };
+
+	KProf pp(label);
+	pp.SetMultiplier(100000);
+
+	for (uint32_t ct = 0; ct < 100000; ++ct)
+	{
+		HeaderMap Headers;
+
+		// parse like KHTTPHeaders::Parse()
+		for (auto sLine : sRequestHeaders.Split("\r\n"))
+		{
+			auto pos = sLine.find(':');
+			if (pos == KStringView::npos) continue;
+			KStringView sKey(sLine.ToView(0, pos));
+			KStringView sValue(sLine.ToView(pos + 1));
+			kTrimRight(sKey);
+			kTrim(sValue);
+			Headers.Add(sKey, sValue);
+		}
+
+		// and look up what a request handler typically looks up
+		iFound += !Headers.Get(KHTTPHeader::HOST).empty();
+		iFound += !Headers.Get(KHTTPHeader::CONTENT_LENGTH).empty();
+		iFound += !Headers.Get(KHTTPHeader::TRANSFER_ENCODING).empty();
+		iFound += !Headers.Get(KHTTPHeader::CONNECTION).empty();
+		iFound += !Headers.Get(KHTTPHeader::ACCEPT_ENCODING).empty();
+		iFound += !Headers.Get(KHTTPHeader::COOKIE).empty();
+		iFound += !Headers.Get(KHTTPHeader::AUTHORIZATION).empty();
+		iFound += !Headers.Get("x-forwarded-for").empty();
+		KProf::Force(&Headers);
+	}
+
+	KProf::Force(&iFound);
+}
+
+void headers()
+{
+	run_header_bench<KProps<KHTTPHeader, KString, true, false>>("KProps HTTP headers parse and lookup");
+	run_header_bench<KSmallProps<KHTTPHeader, KString, true, false>>("KSmallProps HTTP headers parse and lookup");
+}
+
 void kprops_bench()
 {
 //	thread_local_bench();
@@ -1124,6 +1187,7 @@ void kprops_bench()
 	sets();
 	maps();
 	UrlDecode_bench();
+	headers();
 }
 
 
@@ -0,0 +1,140 @@
+#include <cinttypes>
+#include <thread>
+#include <vector>
+#include <dekaf2/time/duration/kprof.h>
+#include <dekaf2/core/strings/kstring.h>
+#include <dekaf2/core/format/kformat.h>
+#include <dekaf2/rest/limits/kratelimiter.h>
+#include <dekaf2/rest/limits/kconnectionlimiter.h>
+
+using namespace dekaf2;
+
+// Measures lock contention of KRateLimiter::Check() and KConnectionLimiter::Acquire() with
+// 1 to 64 threads hammering a common set of client keys. The "1 shard" cases behave like the
+// former single mutex implementation, the "16 shards" cases use the default lock striping.
+// The rate is set so high that no request gets limited - we measure the bookkeeping only.
+// Numbers are per check, measured as wall time over all threads.
+
+namespace {
+
+constexpr std::size_t s_iKeys          = 1024;
+constexpr std::size_t s_iChecksTotal   = 1000000;
+
+struct Labels
+{
+	std::size_t iThreads;
+	const char* sRateOneShard;
+	const char* sRateSharded;
+	const char* sConnOneShard;
+	const char* sConnSharded;
+};
+
+// the profiler keeps the label pointers, therefore they have to be literals
+constexpr Labels s_Labels[]
+{
+	{  1, "rate check  1 thread  (1 shard)" , "rate check  1 thread  (16 shards)" , "conn acquire  1 thread  (1 shard)" , "conn acquire  1 thread  (16 shards)"  },
+	{  2, "rate check  2 threads (1 shard)" , "rate check  2 threads (16 shards)" , "conn acquire  2 threads (1 shard)" , "conn acquire  2 threads (16 shards)"  },
+	{  4, "rate check  4 threads (1 shard)" , "rate check  4 threads (16 shards)" , "conn acquire  4 threads (1 shard)" , "conn acquire  4 threads (16 shards)"  },
+	{  8, "rate check  8 threads (1 shard)" , "rate check  8 threads (16 shards)" , "conn acquire  8 threads (1 shard)" , "conn acquire  8 threads (16 shards)"  },
+	{ 16, "rate check 16 threads (1 shard)" , "rate check 16 threads (16 shards)" , "conn acquire 16 threads (1 shard)" , "conn acquire 16 threads (16 shards)"  },
+	{ 32, "rate check 32 threads (1 shard)" , "rate check 32 threads (16 shards)" , "conn acquire 32 threads (1 shard)" , "conn acquire 32 threads (16 shards)"  },
+	{ 64, "rate check 64 threads (1 shard)" , "rate check 64 threads (16 shards)" , "conn acquire 64 threads (1 shard)" , "conn acquire 64 threads (16 shards)"  },
+};
+
+//-----------------------------------------------------------------------------
+template<class Func>
+void RunThreads(std::size_t iThreads, const char* sLabel, Func Worker)
+//-----------------------------------------------------------------------------
+{
+	std::vector<std::thread> Threads;
+	Threads.reserve(iThreads);
+
+	dekaf2::KProf prof(sLabel);
+	prof.SetMultiplier(s_iChecksTotal);
+
+	for (std::size_t t = 0; t < iThreads; ++t)
+	{
+		Threads.emplace_back(Worker, t, s_iChecksTotal / iThreads);
+	}
+
+	for (auto& Thread : Threads)
+	{
+		Thread.join();
+	}
+
+} // RunThreads
+
+//-----------------------------------------------------------------------------
+void BenchRateLimiter(const std::vector<KString>& Keys, std::size_t iThreads, uint16_t iShards, const char* sLabel)
+//-----------------------------------------------------------------------------
+{
+	KRateLimiter Limiter(1000000000.0, 1000, iShards, false);
+
+	// insert all keys up front, the benchmark measures the hot path
+	std::size_t iAllowed { 0 };
+
+	for (const auto& sKey : Keys)
+	{
+		iAllowed += Limiter.Check(sKey);
+	}
+
+	KProf::Force(&iAllowed);
+
+	RunThreads(iThreads, sLabel, [&](std::size_t iThread, std::size_t iChecks)
+	{
+		std::size_t iAllowed { 0 };
+
+		for (std::size_t i = 0; i < iChecks; ++i)
+		{
+			iAllowed += Limiter.Check(Keys[(i * 7 + iThread * 131) % Keys.size()]);
+		}
+
+		KProf::Force(&iAllowed);
+	});
+
+} // BenchRateLimiter
+
+//-----------------------------------------------------------------------------
+void BenchConnectionLimiter(const std::vector<KString>& Keys, std::size_t iThreads, uint16_t iShards, const char* sLabel)
+//-----------------------------------------------------------------------------
+{
+	KConnectionLimiter Limiter(1000, iShards);
+
+	RunThreads(iThreads, sLabel, [&](std::size_t iThread, std::size_t iChecks)
+	{
+		for (std::size_t i = 0; i < iChecks; ++i)
+		{
+			// acquire and release again
+			auto Guard = Limiter.Acquire(Keys[(i * 7 + iThread * 131) % Keys.size()]);
+			KProf::Force(&Guard);
+		}
+	});
+
+} // BenchConnectionLimiter
+
+} // anonymous namespace
+
+void kratelimiter_bench()
+{
+	dekaf2::KProf ps("-KRateLimiter");
+
+	std::vector<KString> Keys;
+	Keys.reserve(s_iKeys);
+
+	for (std::size_t i = 0; i < s_iKeys; ++i)
+	{
+		Keys.push_back(kFormat("10.{}.{}.{}", i / 65536, (i / 256) % 256, i % 256));
+	}
+
+	for (const auto& Label : s_Labels)
+	{
+		BenchRateLimiter(Keys, Label.iThreads, 1, Label.sRateOneShard);
+		BenchRateLimiter(Keys, Label.iThreads, KRateLimiter::DefaultShards, Label.sRateSharded);
+	}
+
+	for (const auto& Label : s_Labels)
+	{
+		BenchConnectionLimiter(Keys, Label.iThreads, 1, Label.sConnOneShard);
+		BenchConnectionLimiter(Keys, Label.iThreads, KConnectionLimiter::DefaultShards, Label.sConnSharded);
+	}
+}
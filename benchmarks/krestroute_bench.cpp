@@ -0,0 +1,138 @@
+#include <cinttypes>
+#include <vector>
+#include <dekaf2/time/duration/kprof.h>
+#include <dekaf2/core/strings/kstring.h>
+#include <dekaf2/core/format/kformat.h>
+#include <dekaf2/rest/framework/krestroute.h>
+
+using namespace dekaf2;
+
+// Compares the route lookup of KRESTRoutes::FindRoute(), which preselects candidates
+// through its route index, with the former linear scan that calls Matches() on every
+// route in registration order. Each route table mixes plain routes, parameter routes
+// and wildcard routes, and the looked up paths match routes from all over the table,
+// with a bias to the end, where the linear scan is slowest.
+
+namespace {
+
+//-----------------------------------------------------------------------------
+void AddRoutes(std::size_t iCount, KRESTRoutes& Routes, std::vector<KRESTRoute>& Linear)
+//-----------------------------------------------------------------------------
+{
+	auto Callback = [](KRESTServer&) {};
+
+	for (std::size_t i = 0; i < iCount; ++i)
+	{
+		KString sRoute;
+		KHTTPMethod Method;
+
+		switch (i % 4)
+		{
+			case 0:
+				sRoute = kFormat("/api/v1/resource{}", i);
+				Method = KHTTPMethod::GET;
+				break;
+
+			case 1:
+				sRoute = kFormat("/api/v1/resource{}/:id", i);
+				Method = KHTTPMethod::GET;
+				break;
+
+			case 2:
+				sRoute = kFormat("/api/v1/resource{}/:id/items/=item", i);
+				Method = KHTTPMethod::POST;
+				break;
+
+			case 3:
+				sRoute = kFormat("/static/area{}/*", i);
+				Method = KHTTPMethod{};
+				break;
+		}
+
+		Routes.AddRoute(KRESTRoute(Method, KRESTRoute::Options{}, sRoute, KString{}, Callback));
+		Linear.push_back(KRESTRoute(Method, KRESTRoute::Options{}, sRoute, KString{}, Callback));
+	}
+
+} // AddRoutes
+
+//-----------------------------------------------------------------------------
+std::vector<KRESTPath> CreatePaths(std::size_t iCount)
+//-----------------------------------------------------------------------------
+{
+	std::vector<KRESTPath> Paths;
+
+	// one path for each route kind, taken from the last 4 routes, the middle, and the start
+	for (auto iBase : { iCount - 4, iCount / 2, std::size_t(0) })
+	{
+		Paths.push_back(KRESTPath(KHTTPMethod::GET , kFormat("/api/v1/resource{}"               , iBase + 0)));
+		Paths.push_back(KRESTPath(KHTTPMethod::GET , kFormat("/api/v1/resource{}/4711"          , iBase + 1)));
+		Paths.push_back(KRESTPath(KHTTPMethod::POST, kFormat("/api/v1/resource{}/4711/items/12" , iBase + 2)));
+		Paths.push_back(KRESTPath(KHTTPMethod::GET , kFormat("/static/area{}/css/main.css"      , iBase + 3)));
+	}
+
+	return Paths;
+
+} // CreatePaths
+
+//-----------------------------------------------------------------------------
+/// the profiler keeps the label pointers, therefore they have to be literals
+void Bench(std::size_t iCount, std::size_t iRounds, const char* sLinearLabel, const char* sIndexLabel)
+//-----------------------------------------------------------------------------
+{
+	KRESTRoutes Routes;
+	std::vector<KRESTRoute> Linear;
+
+	AddRoutes(iCount, Routes, Linear);
+
+	auto Paths = CreatePaths(iCount);
+
+	{
+		dekaf2::KProf prof(sLinearLabel);
+		prof.SetMultiplier(iRounds * Paths.size());
+
+		KRESTRoutes::Parameters Params;
+
+		for (std::size_t i = 0; i < iRounds; ++i)
+		{
+			for (const auto& Path : Paths)
+			{
+				for (const auto& Route : Linear)
+				{
+					if (Route.Matches(Path, &Params, true, true, false))
+					{
+						KProf::Force(const_cast<KRESTRoute*>(&Route));
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	{
+		dekaf2::KProf prof(sIndexLabel);
+		prof.SetMultiplier(iRounds * Paths.size());
+
+		KRESTRoutes::Parameters Params;
+
+		for (std::size_t i = 0; i < iRounds; ++i)
+		{
+			for (const auto& Path : Paths)
+			{
+				const auto& Route = Routes.FindRoute(Path, Params, false, false);
+				KProf::Force(const_cast<KRESTRoute*>(&Route));
+			}
+		}
+	}
+
+} // Bench
+
+} // anonymous namespace
+
+void krestroute_bench()
+{
+	dekaf2::KProf ps("-KRESTRoutes");
+
+	Bench(  10, 20000, "linear scan (10 routes)"  , "route index (10 routes)"  );
+	Bench( 100,  5000, "linear scan (100 routes)" , "route index (100 routes)" );
+	Bench(1000,   500, "linear scan (1000 routes)", "route index (1000 routes)");
+}
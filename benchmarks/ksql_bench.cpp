@@ -0,0 +1,120 @@
+#include <dekaf2/core/init/dekaf2.h>
+#include <dekaf2/core/format/kformat.h>
+#include <dekaf2/data/sql/ksql.h>
+#include <dekaf2/system/filesystem/kfilesystem.h>
+#include <dekaf2/time/duration/kprof.h>
+
+using namespace dekaf2;
+
+// Buffers a result set of 1M rows from a SQLite database with F_BufferResults,
+// and reads it twice, with a rewind in between. The buffer is either held
+// completely in memory, or spills into the temp results file after 16 MB. The
+// plain streaming read of the same rows is shown for comparison.
+
+namespace {
+
+constexpr std::size_t iRows = 1000000;
+
+//-----------------------------------------------------------------------------
+std::size_t ReadRows(KSQL& db)
+//-----------------------------------------------------------------------------
+{
+	std::size_t iCount { 0 };
+	std::size_t iBytes { 0 };
+
+	while (db.NextRow())
+	{
+		++iCount;
+		iBytes += db.Get(1).size() + db.Get(2).size() + db.Get(3).size();
+	}
+
+	KProf::Force(&iBytes);
+
+	return iCount;
+
+} // ReadRows
+
+//-----------------------------------------------------------------------------
+/// the profiler keeps the label pointers, therefore they have to be literals
+void Bench(KSQL& db, KSQL::Flags Flags, std::size_t iMemoryLimit, const char* sBufferLabel, const char* sReadLabel)
+//-----------------------------------------------------------------------------
+{
+	db.SetBufferedResultsMemoryLimit(iMemoryLimit);
+	db.SetFlags(Flags);
+
+	{
+		dekaf2::KProf prof(sBufferLabel);
+
+		if (!db.ExecQuery("select id, name, value from BENCH order by id"))
+		{
+			kPrintLine("query failed: {}", db.GetLastError());
+			return;
+		}
+	}
+
+	std::size_t iRead { 0 };
+
+	{
+		dekaf2::KProf prof(sReadLabel);
+
+		iRead = ReadRows(db);
+
+		if (Flags & KSQL::F_BufferResults)
+		{
+			db.ResetBuffer();
+			iRead += ReadRows(db);
+		}
+	}
+
+	if (iRead != iRows * ((Flags & KSQL::F_BufferResults) ? 2 : 1))
+	{
+		kPrintLine("{}: read {} rows", sReadLabel, iRead);
+	}
+
+	db.EndQuery();
+	db.SetFlags(KSQL::F_None);
+
+} // Bench
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+	kInit();
+
+	KTempDir TempDir;
+
+	KSQL db;
+	db.SetDBType(KSQL::DBT::SQLITE3);
+	db.SetDBName(kFormat("{}/bench.db", TempDir.Name()));
+	db.SetTempDir(TempDir.Name());
+
+	if (!db.OpenConnection())
+	{
+		kPrintLine("cannot open database: {}", db.GetLastError());
+		return 1;
+	}
+
+	db.ExecSQL("create table BENCH (id integer primary key, name text not null, value text not null)");
+
+	db.BeginTransaction();
+
+	for (std::size_t i = 0; i < iRows; ++i)
+	{
+		db.ExecSQL("insert into BENCH (id,name,value) values ({},'name-{}','{}')", i, i, KString(i % 64 + 8, 'v'));
+	}
+
+	db.CommitTransaction();
+
+	{
+		dekaf2::KProf ps("-KSQL 1M rows");
+
+		Bench(db, KSQL::F_None         , 0                , "query (unbuffered)"     , "read (unbuffered)"          );
+		Bench(db, KSQL::F_BufferResults, 0                , "buffer (memory)"        , "read + rewind + read (memory)");
+		Bench(db, KSQL::F_BufferResults, 16 * 1024 * 1024 , "buffer (spill at 16MB)" , "read + rewind + read (spill)" );
+	}
+
+	kProfFinalize();
+
+	return 0;
+}
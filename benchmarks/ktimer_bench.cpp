@@ -0,0 +1,123 @@
+#include <atomic>
+#include <vector>
+#include <dekaf2/time/duration/kprof.h>
+#include <dekaf2/time/duration/ktimer.h>
+#include <dekaf2/time/duration/ktimerwheel.h>
+
+using namespace dekaf2;
+
+// Measures the cost of scheduling and cancelling timers. The wheel cases show the raw
+// data structure (O(1) add and remove, expiry in order), the KTimer cases add the
+// ID map, the control block allocation and the locking of the public interface.
+
+namespace {
+
+constexpr std::size_t s_iTimers = 1000000;
+
+struct BenchNode : public KTimerWheel::Node {};
+
+} // anonymous namespace
+
+void ktimer_bench()
+{
+	dekaf2::KProf ps("-KTimer");
+
+	{
+		KTimerWheel Wheel;
+		std::vector<BenchNode> Nodes(s_iTimers);
+
+		{
+			dekaf2::KProf prof("wheel add (1M)");
+			prof.SetMultiplier(s_iTimers);
+
+			for (std::size_t i = 0; i < s_iTimers; ++i)
+			{
+				// spread over about one hour of milliseconds
+				Wheel.Add(Nodes[i], 1 + (i * 7919) % 3600000);
+			}
+			KProf::Force(&Wheel);
+		}
+
+		{
+			dekaf2::KProf prof("wheel move (1M)");
+			prof.SetMultiplier(s_iTimers);
+
+			for (std::size_t i = 0; i < s_iTimers; ++i)
+			{
+				Wheel.Add(Nodes[i], 1 + (i * 104729) % 3600000);
+			}
+			KProf::Force(&Wheel);
+		}
+
+		{
+			dekaf2::KProf prof("wheel expire (1M)");
+			prof.SetMultiplier(s_iTimers);
+
+			std::size_t iExpired = 0;
+			Wheel.Advance(3600000, [&iExpired](KTimerWheel::Node&) { ++iExpired; });
+			KProf::Force(&iExpired);
+		}
+	}
+
+	{
+		KTimerWheel Wheel;
+		std::vector<BenchNode> Nodes(s_iTimers);
+
+		for (std::size_t i = 0; i < s_iTimers; ++i)
+		{
+			Wheel.Add(Nodes[i], 1 + (i * 7919) % 3600000);
+		}
+
+		dekaf2::KProf prof("wheel remove (1M)");
+		prof.SetMultiplier(s_iTimers);
+
+		for (auto& Node : Nodes)
+		{
+			Wheel.Remove(Node);
+		}
+		KProf::Force(&Wheel);
+	}
+
+	{
+		KTimer Timer;
+		std::vector<KTimer::ID_t> IDs;
+		IDs.reserve(s_iTimers);
+
+		{
+			dekaf2::KProf prof("KTimer CallOnce (1M)");
+			prof.SetMultiplier(s_iTimers);
+
+			for (std::size_t i = 0; i < s_iTimers; ++i)
+			{
+				IDs.push_back(Timer.CallOnce(chrono::seconds(3600 + i % 1000), [](KUnixTime) {}, false));
+			}
+			KProf::Force(&IDs);
+		}
+
+		{
+			dekaf2::KProf prof("KTimer Restart (1M)");
+			prof.SetMultiplier(s_iTimers);
+
+			std::size_t iRestarted = 0;
+
+			for (auto ID : IDs)
+			{
+				iRestarted += Timer.Restart(ID);
+			}
+			KProf::Force(&iRestarted);
+		}
+
+		{
+			dekaf2::KProf prof("KTimer Cancel (1M)");
+			prof.SetMultiplier(s_iTimers);
+
+			std::size_t iCancelled = 0;
+
+			for (auto ID : IDs)
+			{
+				iCancelled += Timer.Cancel(ID);
+			}
+			KProf::Force(&iCancelled);
+		}
+	}
+}
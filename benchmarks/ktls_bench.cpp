@@ -0,0 +1,110 @@
+#include <dekaf2/time/duration/kprof.h>
+#include <dekaf2/time/duration/kduration.h>
+#include <dekaf2/core/strings/kstring.h>
+#include <dekaf2/core/format/kformat.h>
+#include <dekaf2/net/tcp/ktcpserver.h>
+#include <dekaf2/net/tls/ktlscontext.h>
+#include <dekaf2/net/tls/ktlsstream.h>
+#include <openssl/ssl.h>
+
+using namespace dekaf2;
+
+// Measures TLS connection setup over the loopback interface: connect, handshake, and
+// one echoed line, once with full handshakes (client session cache switched off) and
+// once with handshakes resumed from the per-endpoint session cache. The profiler
+// shows the time per connection, the additional lines the handshakes per second and
+// the count of resumed handshakes.
+
+namespace {
+
+constexpr uint16_t    s_iPort   = 30378;
+constexpr std::size_t s_iRounds = 500;
+
+class KTLSEchoServer : public KTCPServer
+{
+
+public:
+
+	using KTCPServer::KTCPServer;
+
+protected:
+
+	virtual bool Accepted(std::unique_ptr<KIOStreamSocket>& stream) override
+	{
+		stream->SetReaderRightTrim("\r\n");
+		stream->SetWriterEndOfLine("\r\n");
+		return true;
+	}
+
+	virtual KString Request(KStringRef& sLine, Parameters& parameters) override
+	{
+		parameters.terminate = true;
+		return sLine + "\r\n";
+	}
+
+}; // KTLSEchoServer
+
+//-----------------------------------------------------------------------------
+/// the profiler keeps the label pointers, therefore they have to be literals
+void Connect(KTLSContext& Context, const char* sLabel)
+//-----------------------------------------------------------------------------
+{
+	std::size_t iResumed { 0 };
+	KStopTime Timer;
+
+	{
+		dekaf2::KProf prof(sLabel);
+		prof.SetMultiplier(s_iRounds);
+
+		for (std::size_t i = 0; i < s_iRounds; ++i)
+		{
+			KTLSStream Stream(Context, KTCPEndPoint(kFormat("127.0.0.1:{}", s_iPort)), KStreamOptions(chrono::seconds(5)));
+
+			Stream.SetReaderRightTrim("\r\n");
+			Stream.SetWriterEndOfLine("\r\n");
+			// the echo also reads the TLS 1.3 session tickets
+			Stream.WriteLine("hello").Flush();
+
+			KString sLine;
+			Stream.ReadLine(sLine);
+			KProf::Force(&sLine);
+
+			iResumed += ::SSL_session_reused(Stream.GetNativeTLSHandle()) == 1;
+		}
+	}
+
+	auto iNanoSecs = std::max<int64_t>(Timer.elapsed().nanoseconds().count(), 1);
+
+	kPrintLine("{:<28}: {:>10.1f} handshakes/s, {} of {} resumed", sLabel,
+	           static_cast<double>(s_iRounds) * 1000000000.0 / iNanoSecs, iResumed, s_iRounds);
+
+} // Connect
+
+} // anonymous namespace
+
+void ktls_bench()
+{
+	dekaf2::KProf ps("-KTLS");
+
+	KTLSEchoServer Server(s_iPort, true, 4);
+	Server.SetBindAddress("127.0.0.1");
+
+	if (!Server.Start(chrono::seconds(5), false))
+	{
+		kPrintLine("cannot start server: {}", Server.Error());
+		return;
+	}
+
+	{
+		KTLSContext Context(false);
+		Context.SetSessionCache(0);
+		Connect(Context, "full handshake");
+	}
+
+	{
+		KTLSContext Context(false);
+		Connect(Context, "resumed handshake");
+	}
+
+	Server.Stop();
+}
@@ -86,6 +86,58 @@ void kurlencode_bench()
 			KProf::Force(&s);
 		}
 	}
+	// long inputs, one mostly clean and one where almost every byte needs encoding
+	KString sLongClean;
+	KString sLongHeavy;
+
+	for (int i = 0; i < 40; ++i)
+	{
+		sLongClean += "some_long-query.value~without-any-special-chars";
+		sLongClean += (i % 8) ? "_" : "&";
+		sLongHeavy += "\xc3\xbc\xc3\xb6\xc3\xa4 <\"\xe2\x82\xac\">";
+	}
+
+	KString sEncodedLongClean = kUrlEncode(sLongClean, URIPart::Query);
+	KString sEncodedLongHeavy = kUrlEncode(sLongHeavy, URIPart::Query);
+
+	{
+		dekaf2::KProf prof("kUrlEncode long clean");
+		prof.SetMultiplier(10000);
+		for (int ct = 0; ct < 10000; ++ct)
+		{
+			KString s = kUrlEncode(sLongClean, URIPart::Query);
+			KProf::Force(&s);
+		}
+	}
+	{
+		dekaf2::KProf prof("kUrlEncode long heavy");
+		prof.SetMultiplier(10000);
+		for (int ct = 0; ct < 10000; ++ct)
+		{
+			KString s = kUrlEncode(sLongHeavy, URIPart::Query);
+			KProf::Force(&s);
+		}
+	}
+	{
+		dekaf2::KProf prof("kUrlDecode long clean");
+		prof.SetMultiplier(10000);
+		for (int ct = 0; ct < 10000; ++ct)
+		{
+			KString s;
+			kUrlDecode(KStringView(sEncodedLongClean), s, true);
+			KProf::Force(&s);
+		}
+	}
+	{
+		dekaf2::KProf prof("kUrlDecode long heavy");
+		prof.SetMultiplier(10000);
+		for (int ct = 0; ct < 10000; ++ct)
+		{
+			KString s;
+			kUrlDecode(KStringView(sEncodedLongHeavy), s, true);
+			KProf::Force(&s);
+		}
+	}
 	{
 		dekaf2::KProf prof("kUrlEncode path");
 		prof.SetMultiplier(50000);
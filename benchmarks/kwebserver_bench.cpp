@@ -0,0 +1,113 @@
+#include <cinttypes>
+#include <dekaf2/time/duration/kprof.h>
+#include <dekaf2/time/duration/kduration.h>
+#include <dekaf2/core/strings/kstring.h>
+#include <dekaf2/core/format/kformat.h>
+#include <dekaf2/system/filesystem/kfilesystem.h>
+#include <dekaf2/rest/framework/krest.h>
+#include <dekaf2/http/client/kwebclient.h>
+
+using namespace dekaf2;
+
+// Measures the download throughput of a static file from a local REST server over
+// the loopback interface. The file is either set as a stream, which is copied through
+// the stream buffers into the socket, or as a file, which on plain TCP connections
+// without compression is sent zero copy from the file into the socket. The profiler
+// shows the time per download, the additional lines the throughput in MB/s.
+
+namespace {
+
+//-----------------------------------------------------------------------------
+void PrintThroughput(KStringView sWhat, std::size_t iBytes, KDuration Duration)
+//-----------------------------------------------------------------------------
+{
+	auto iNanoSecs = std::max<int64_t>(Duration.nanoseconds().count(), 1);
+	kPrintLine("{:<28}: {:>10.1f} MB/s", sWhat, static_cast<double>(iBytes) * 1000.0 / iNanoSecs);
+
+} // PrintThroughput
+
+//-----------------------------------------------------------------------------
+/// the profiler keeps the label pointers, therefore they have to be literals
+void Download(KWebClient& Client, KStringView sURL, std::size_t iFileSize, std::size_t iRounds, const char* sLabel)
+//-----------------------------------------------------------------------------
+{
+	std::size_t iReceived { 0 };
+	KStopTime Timer;
+
+	dekaf2::KProf prof(sLabel);
+	prof.SetMultiplier(iRounds);
+
+	for (std::size_t i = 0; i < iRounds; ++i)
+	{
+		auto sBody = Client.Get(sURL);
+		iReceived += sBody.size();
+		KProf::Force(&sBody);
+	}
+
+	if (iReceived != iFileSize * iRounds)
+	{
+		kPrintLine("{}: received {} instead of {} bytes", sLabel, iReceived, iFileSize * iRounds);
+	}
+
+	PrintThroughput(sLabel, iReceived, Timer.elapsed());
+
+} // Download
+
+} // anonymous namespace
+
+void kwebserver_bench()
+{
+	dekaf2::KProf ps("-KWebServer");
+
+	constexpr std::size_t iFileSize = 64 * 1024 * 1024;
+
+	KTempDir TempDir;
+	auto sFile = kFormat("{}/download.bin", TempDir.Name());
+
+	{
+		KString sBlock;
+		for (std::size_t i = 0; i < 1024 * 1024; ++i)
+		{
+			sBlock += static_cast<KString::value_type>(i * 31);
+		}
+
+		KOutFile File(sFile);
+		for (std::size_t i = 0; i < iFileSize / sBlock.size(); ++i)
+		{
+			File.Write(sBlock);
+		}
+	}
+
+	KRESTRoutes Routes;
+
+	Routes.AddRoute({ KHTTPMethod::GET, false, "/stream", [&](KRESTServer& HTTP)
+	{
+		HTTP.SetStreamToOutput(std::make_unique<KInFile>(sFile), iFileSize, false);
+	}});
+
+	Routes.AddRoute({ KHTTPMethod::GET, false, "/file", [&](KRESTServer& HTTP)
+	{
+		HTTP.SetFileToOutput(sFile, false);
+	}});
+
+	KREST::Options Options;
+	Options.Type         = KREST::HTTP;
+	Options.iPort        = 30377;
+	Options.sBindAddress = "127.0.0.1";
+	Options.bBlocking    = false;
+	Options.bCreateEphemeralCert = false;
+
+	KREST REST;
+
+	if (!REST.Execute(Options, Routes))
+	{
+		kPrintLine("cannot start server: {}", REST.Error());
+		return;
+	}
+
+	KWebClient Client;
+	Client.RequestCompression(false);
+
+	Download(Client, "http://127.0.0.1:30377/stream", iFileSize, 20, "download 64MB as stream");
+	Download(Client, "http://127.0.0.1:30377/file"  , iFileSize, 20, "download 64MB as file");
+}
@@ -54,6 +54,17 @@ extern void khash_bench();
 extern void ktime_bench();
 extern void kmemsearch_bench();
 extern void kthreadpool_bench();
+extern void krestroute_bench();
+extern void kratelimiter_bench();
+extern void klog_bench();
+extern void kwebserver_bench();
+extern void kwebsocket_bench();
+extern void kcsv_bench();
+extern void kparallel_bench();
+extern void kflathash_bench();
+extern void kchildprocess_bench();
+extern void ktimer_bench();
+extern void ktls_bench();
 
 using namespace dekaf2;
 
@@ -143,6 +154,17 @@ int main(int argc, char* argv[])
 		{ "ktime",           &ktime_bench           },
 		{ "kmemsearch",      &kmemsearch_bench      },
 		{ "kthreadpool",     &kthreadpool_bench     },
+		{ "krestroute",      &krestroute_bench      },
+		{ "kratelimiter",    &kratelimiter_bench    },
+		{ "klog",            &klog_bench            },
+		{ "kwebserver",      &kwebserver_bench      },
+		{ "kwebsocket",      &kwebsocket_bench      },
+		{ "kcsv",            &kcsv_bench            },
+		{ "kparallel",       &kparallel_bench       },
+		{ "kflathash",       &kflathash_bench       },
+		{ "kchildprocess",   &kchildprocess_bench   },
+		{ "ktimer",          &ktimer_bench          },
+		{ "ktls",            &ktls_bench            },
 	};
 
 	for (int ii = 1; ii < argc; ++ii)
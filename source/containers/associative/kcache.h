@@ -43,12 +43,22 @@
 #pragma once
 
 /// @file kcache.h
-/// a generic cache with LRU removal
+/// generic caches with LRU or CLOCK removal
 
 #include <dekaf2/core/init/kcompatibility.h>
 #include <dekaf2/core/init/dekaf2.h>
+#include <dekaf2/core/types/ktemplate.h>
 #include <dekaf2/containers/memory/ksharedref.h>
 #include <dekaf2/containers/associative/kmru.h>
+#include <dekaf2/containers/associative/kassociative.h>
+#include <dekaf2/time/duration/kduration.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <exception>
+#include <future>
+#include <memory>
+#include <vector>
 
 
 DEKAF2_NAMESPACE_BEGIN
@@ -415,6 +425,540 @@ private:
 
 }; // KSharedCache
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+/// KConcurrentCache is a multi threading variant of KSharedCache for highly
+/// concurrent access. The keys are spread over independent segments, each with
+/// its own lock and its own CLOCK (second chance) eviction, so that a cache hit
+/// only needs a shared lock on one segment and sets an atomic reference bit instead
+/// of reordering an LRU list. Concurrent misses on the same key run the Load
+/// functor only once, all other callers wait for its result (no cache stampede).
+/// Entries can optionally expire after a time to live, and the cache counts hits,
+/// misses, evictions, expirations and coalesced loads.
+template<class Key, class Value, class Load = detail::LoadByConstruction<KSharedRef<Value, true> > >
+class KConcurrentCache
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+{
+
+//----------
+public:
+//----------
+
+	using value_type = KSharedRef<Value, true>;
+
+	enum { DEFAULT_MAX_CACHE_SIZE = 1000, DEFAULT_SEGMENTS = 16 };
+
+	/// cache statistics
+	struct Stats
+	{
+		std::size_t iHits        { 0 }; ///< found in the cache
+		std::size_t iMisses      { 0 }; ///< had to be loaded
+		std::size_t iCoalesced   { 0 }; ///< waited for a concurrent load of the same key
+		std::size_t iEvictions   { 0 }; ///< removed to make room for new entries
+		std::size_t iExpirations { 0 }; ///< removed or reloaded because the time to live was exceeded
+	};
+
+	//-----------------------------------------------------------------------------
+	/// construct a cache
+	/// @param iMaxSize the maximum count of cached elements, spread over all segments
+	/// @param iSegments the count of independent segments, defaults to 16
+	/// @param TimeToLive if > 0, entries expire after this duration
+	KConcurrentCache(size_t iMaxSize = DEFAULT_MAX_CACHE_SIZE, uint16_t iSegments = DEFAULT_SEGMENTS, KDuration TimeToLive = KDuration::zero())
+	//-----------------------------------------------------------------------------
+	: m_Segments(std::max(iSegments, uint16_t(1)))
+	, m_TimeToLive(TimeToLive)
+	{
+		SetMaxSize(iMaxSize);
+	}
+
+	KConcurrentCache(const KConcurrentCache&) = delete;
+	KConcurrentCache& operator=(const KConcurrentCache&) = delete;
+	KConcurrentCache(KConcurrentCache&&) = delete;
+	KConcurrentCache& operator=(KConcurrentCache&&) = delete;
+
+	//-----------------------------------------------------------------------------
+	/// Add a new key value pair to the cache, or replace the value of an existing key.
+	template<class K = Key, class V = Value>
+	value_type Set(K&& key, V&& value)
+	//-----------------------------------------------------------------------------
+	{
+		auto& segment = GetSegment(key);
+		auto  tNow    = Now();
+
+		std::unique_lock<std::shared_mutex> Lock(segment.Mutex);
+
+		return Insert(segment, Key(std::forward<K>(key)), value_type(std::forward<V>(value)), tNow);
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Get a value for a key from the cache. If the key does not exist, a new
+	/// value will be created and the key value pair will be inserted into the
+	/// cache. For this to be possible, the Value type needs to be constructible
+	/// from the Key type (so, have a constructor Value(Key)). Alternatively,
+	/// additional parameters can be given in args... which will be supplied
+	/// to a Load type. If another thread is currently loading the same key, waits
+	/// for its result instead of loading again. If the Load type throws, the
+	/// exception is rethrown in all callers waiting for this key.
+	template<class K = Key, typename...Args>
+	value_type Get(K&& key, Args&&...args)
+	//-----------------------------------------------------------------------------
+	{
+		auto& segment = GetSegment(key);
+		auto  tNow    = Now();
+
+		{
+			std::shared_lock<std::shared_mutex> Lock(segment.Mutex);
+
+			auto it = segment.Map.find(key);
+
+			if (it != segment.Map.end() && !IsExpired(*it->second, tNow))
+			{
+				return Hit(*it->second);
+			}
+		}
+
+		std::promise<value_type>       Promise;
+		std::shared_future<value_type> Future;
+
+		{
+			std::unique_lock<std::shared_mutex> Lock(segment.Mutex);
+
+			// check again, the key may have been loaded meanwhile
+			auto it = segment.Map.find(key);
+
+			if (it != segment.Map.end() && !IsExpired(*it->second, tNow))
+			{
+				return Hit(*it->second);
+			}
+
+			auto pending = segment.Loading.find(key);
+
+			if (pending != segment.Loading.end())
+			{
+				++segment.iCoalesced;
+				Future = pending->second;
+			}
+			else
+			{
+				++segment.iMisses;
+				segment.Loading.emplace(Key(key), Promise.get_future().share());
+			}
+		}
+
+		if (Future.valid())
+		{
+			// another thread loads this key - wait for it
+			return Future.get();
+		}
+
+		// Create a copy of the key, as the loader could also consume the key.
+		Key kk(key);
+
+		DEKAF2_TRY
+		{
+			value_type Loaded(Load()(std::forward<K>(key), std::forward<Args>(args)...));
+
+			{
+				std::unique_lock<std::shared_mutex> Lock(segment.Mutex);
+
+				segment.Loading.erase(kk);
+				Insert(segment, std::move(kk), value_type(Loaded), tNow);
+			}
+
+			Promise.set_value(Loaded);
+
+			return Loaded;
+		}
+		DEKAF2_CATCH (...)
+		{
+			{
+				std::unique_lock<std::shared_mutex> Lock(segment.Mutex);
+				segment.Loading.erase(kk);
+			}
+
+			auto Exception = std::current_exception();
+
+			Promise.set_exception(Exception);
+
+			// unlike 'throw;' this also compiles without exception support
+			std::rethrow_exception(Exception);
+		}
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Get a value for a key from the cache. If the key does not exist or is expired,
+	/// a default constructed value will be returned.
+	template<class K = Key>
+	value_type Find(const K& key)
+	//-----------------------------------------------------------------------------
+	{
+		auto& segment = GetSegment(key);
+		auto  tNow    = Now();
+
+		std::shared_lock<std::shared_mutex> Lock(segment.Mutex);
+
+		auto it = segment.Map.find(key);
+
+		if (it == segment.Map.end() || IsExpired(*it->second, tNow))
+		{
+			return value_type{};
+		}
+
+		return Hit(*it->second);
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Erase a key and its corresponding value from the cache.
+	template<class K = Key>
+	bool Erase(const K& key)
+	//-----------------------------------------------------------------------------
+	{
+		auto& segment = GetSegment(key);
+
+		std::unique_lock<std::shared_mutex> Lock(segment.Mutex);
+
+		auto it = segment.Map.find(key);
+
+		if (it == segment.Map.end())
+		{
+			return false;
+		}
+
+		Remove(segment, it);
+
+		return true;
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Erase a vector of keys and their corresponding values from the cache.
+	template<class K = Key>
+	void Erase(const std::vector<K>& keys)
+	//-----------------------------------------------------------------------------
+	{
+		for (const auto& key : keys)
+		{
+			Erase(key);
+		}
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Set a new maximum cache size. The size is spread evenly over the segments, and
+	/// each segment that holds more elements than its new share evicts the excess.
+	void SetMaxSize(size_t iMaxSize)
+	//-----------------------------------------------------------------------------
+	{
+		m_iMaxSize.store(iMaxSize, std::memory_order_relaxed);
+
+		auto iPerSegment = std::max((iMaxSize + m_Segments.size() - 1) / m_Segments.size(), std::size_t(1));
+		auto tNow        = Now();
+
+		for (auto& segment : m_Segments)
+		{
+			std::unique_lock<std::shared_mutex> Lock(segment.Mutex);
+
+			segment.iCapacity = iPerSegment;
+
+			while (segment.Ring.size() > segment.iCapacity)
+			{
+				EvictOne(segment, tNow);
+			}
+		}
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Returns the maximum cache size.
+	size_t GetMaxSize() const
+	//-----------------------------------------------------------------------------
+	{
+		return m_iMaxSize.load(std::memory_order_relaxed);
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Returns the time to live of the entries, 0 if they do not expire
+	KDuration GetTimeToLive() const
+	//-----------------------------------------------------------------------------
+	{
+		return m_TimeToLive;
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Returns the count of segments
+	size_t GetSegmentCount() const
+	//-----------------------------------------------------------------------------
+	{
+		return m_Segments.size();
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Clears the cache. Does not reset the statistics.
+	void clear()
+	//-----------------------------------------------------------------------------
+	{
+		for (auto& segment : m_Segments)
+		{
+			std::unique_lock<std::shared_mutex> Lock(segment.Mutex);
+
+			segment.Ring.clear();
+			segment.Map.clear();
+			segment.iHand = 0;
+		}
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Returns count of cached elements.
+	size_t size() const
+	//-----------------------------------------------------------------------------
+	{
+		std::size_t iSize { 0 };
+
+		for (const auto& segment : m_Segments)
+		{
+			std::shared_lock<std::shared_mutex> Lock(segment.Mutex);
+			iSize += segment.Map.size();
+		}
+
+		return iSize;
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Returns true if no cached elements.
+	bool empty() const
+	//-----------------------------------------------------------------------------
+	{
+		return size() == 0;
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Returns the statistics, summed up over all segments
+	Stats GetStats() const
+	//-----------------------------------------------------------------------------
+	{
+		Stats stats;
+
+		for (const auto& stripe : m_HitStripes)
+		{
+			stats.iHits        += stripe.iHits.load(std::memory_order_relaxed);
+		}
+
+		for (const auto& segment : m_Segments)
+		{
+			stats.iMisses      += segment.iMisses.load(std::memory_order_relaxed);
+			stats.iCoalesced   += segment.iCoalesced.load(std::memory_order_relaxed);
+			stats.iEvictions   += segment.iEvictions.load(std::memory_order_relaxed);
+			stats.iExpirations += segment.iExpirations.load(std::memory_order_relaxed);
+		}
+
+		return stats;
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Get a value for a key from the cache. If the key does not exist, a new
+	/// value will be created and the key value pair will be inserted into the
+	/// cache. For this to be possible, the Value type needs to be constructible
+	/// from the Key type (so, have a constructor Value(Key) ).
+	template<class K = Key>
+	value_type operator[](K&& key)
+	//-----------------------------------------------------------------------------
+	{
+		return Get(std::forward<K>(key));
+	}
+
+//----------
+private:
+//----------
+
+	struct Entry
+	{
+		Entry(value_type _Value, KSteadyTime _tExpires, std::size_t _iSlot)
+		: Cached(std::move(_Value)), tExpires(_tExpires), iSlot(_iSlot)
+		{
+		}
+
+		value_type                Cached;
+		KSteadyTime               tExpires;
+		std::size_t               iSlot;
+		mutable std::atomic<bool> bReferenced { false };
+	};
+
+	using map_type = KUnorderedMap<Key, std::unique_ptr<Entry>>;
+
+	// the clock ring of a segment - the key pointers point into the (node based) map
+	struct Slot
+	{
+		const Key* pKey;
+		Entry*     pEntry;
+	};
+
+	// the hits are not counted per segment but in stripes selected by the calling
+	// thread, so that concurrent hits do not write to a shared cache line
+	struct alignas(64) HitStripe
+	{
+		std::atomic<std::size_t> iHits { 0 };
+	};
+
+	static constexpr std::size_t s_iHitStripes = 16;
+
+	struct alignas(64) Segment
+	{
+		mutable std::shared_mutex                          Mutex;
+		map_type                                           Map;
+		KUnorderedMap<Key, std::shared_future<value_type>> Loading;
+		std::vector<Slot>                                  Ring;
+		std::size_t                                        iHand     { 0 };
+		std::size_t                                        iCapacity { 1 };
+		std::atomic<std::size_t>                           iMisses      { 0 };
+		std::atomic<std::size_t>                           iCoalesced   { 0 };
+		std::atomic<std::size_t>                           iEvictions   { 0 };
+		std::atomic<std::size_t>                           iExpirations { 0 };
+	};
+
+	//-----------------------------------------------------------------------------
+	template<class K>
+	Segment& GetSegment(const K& key)
+	//-----------------------------------------------------------------------------
+	{
+		// a lookup with another type than Key does not construct a Key for the hash
+		return m_Segments[detail::transparent_hash<Key>()(key) % m_Segments.size()];
+	}
+
+	//-----------------------------------------------------------------------------
+	KSteadyTime Now() const
+	//-----------------------------------------------------------------------------
+	{
+		// only read the clock if we need it
+		return (m_TimeToLive > KDuration::zero()) ? KSteadyTime::now() : KSteadyTime{};
+	}
+
+	//-----------------------------------------------------------------------------
+	bool IsExpired(const Entry& entry, KSteadyTime tNow) const
+	//-----------------------------------------------------------------------------
+	{
+		return m_TimeToLive > KDuration::zero() && tNow >= entry.tExpires;
+	}
+
+	//-----------------------------------------------------------------------------
+	static std::size_t GetHitStripe()
+	//-----------------------------------------------------------------------------
+	{
+		// hand out the stripes round robin - thread ids are too regular to be hashed into them
+		static std::atomic<std::size_t> s_iThreads { 0 };
+		static thread_local std::size_t iStripe = s_iThreads.fetch_add(1, std::memory_order_relaxed) % s_iHitStripes;
+		return iStripe;
+	}
+
+	//-----------------------------------------------------------------------------
+	value_type Hit(const Entry& entry)
+	//-----------------------------------------------------------------------------
+	{
+		// only write the reference bit if not yet set, to keep the cache line shared
+		if (!entry.bReferenced.load(std::memory_order_relaxed))
+		{
+			entry.bReferenced.store(true, std::memory_order_relaxed);
+		}
+
+		m_HitStripes[GetHitStripe()].iHits.fetch_add(1, std::memory_order_relaxed);
+
+		return entry.Cached;
+	}
+
+	//-----------------------------------------------------------------------------
+	/// caller must hold the unique lock of the segment
+	value_type Insert(Segment& segment, Key&& key, value_type&& value, KSteadyTime tNow)
+	//-----------------------------------------------------------------------------
+	{
+		auto tExpires = tNow + m_TimeToLive;
+		auto it       = segment.Map.find(key);
+
+		if (it != segment.Map.end())
+		{
+			if (IsExpired(*it->second, tNow))
+			{
+				++segment.iExpirations;
+			}
+
+			// replace the existing value
+			it->second->Cached    = std::move(value);
+			it->second->tExpires = tExpires;
+			it->second->bReferenced.store(true, std::memory_order_relaxed);
+
+			return it->second->Cached;
+		}
+
+		if (segment.Ring.size() >= segment.iCapacity)
+		{
+			EvictOne(segment, tNow);
+		}
+
+		auto iSlot = segment.Ring.size();
+
+		it = segment.Map.emplace(std::move(key), std::make_unique<Entry>(std::move(value), tExpires, iSlot)).first;
+
+		segment.Ring.push_back(Slot { &it->first, it->second.get() });
+
+		return it->second->Cached;
+	}
+
+	//-----------------------------------------------------------------------------
+	/// caller must hold the unique lock of the segment
+	void EvictOne(Segment& segment, KSteadyTime tNow)
+	//-----------------------------------------------------------------------------
+	{
+		// the clock hand gives each referenced entry a second chance, and stops
+		// at the first entry that was not referenced since the last round
+		for (;;)
+		{
+			if (segment.iHand >= segment.Ring.size())
+			{
+				segment.iHand = 0;
+			}
+
+			auto& slot = segment.Ring[segment.iHand];
+
+			if (IsExpired(*slot.pEntry, tNow))
+			{
+				++segment.iExpirations;
+			}
+			else if (slot.pEntry->bReferenced.exchange(false, std::memory_order_relaxed))
+			{
+				++segment.iHand;
+				continue;
+			}
+			else
+			{
+				++segment.iEvictions;
+			}
+
+			Remove(segment, segment.Map.find(*slot.pKey));
+
+			return;
+		}
+	}
+
+	//-----------------------------------------------------------------------------
+	/// caller must hold the unique lock of the segment
+	void Remove(Segment& segment, typename map_type::iterator it)
+	//-----------------------------------------------------------------------------
+	{
+		auto iSlot = it->second->iSlot;
+
+		segment.Map.erase(it);
+
+		// fill the gap in the ring with its last slot
+		if (iSlot + 1 < segment.Ring.size())
+		{
+			segment.Ring[iSlot] = segment.Ring.back();
+			segment.Ring[iSlot].pEntry->iSlot = iSlot;
+		}
+
+		segment.Ring.pop_back();
+	}
+
+	std::vector<Segment>     m_Segments;
+	KDuration                m_TimeToLive;
+	std::atomic<std::size_t> m_iMaxSize { 0 };
+	std::array<HitStripe, s_iHitStripes> m_HitStripes;
+
+}; // KConcurrentCache
+
 
 /// @}
 
@@ -0,0 +1,975 @@
+/*
+//
+// DEKAF(tm): Lighter, Faster, Smarter(tm)
+//
+// Copyright (c) 2026, Ridgeware, Inc.
+//
+// +-------------------------------------------------------------------------+
+// | /\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\|
+// |/+---------------------------------------------------------------------+/|
+// |/|                                                                     |/|
+// |\|  ** THIS NOTICE MUST NOT BE REMOVED FROM THE SOURCE CODE MODULE **  |\|
+// |/|                                                                     |/|
+// |\|   OPEN SOURCE LICENSE                                               |\|
+// |/|                                                                     |/|
+// |\|   Permission is hereby granted, free of charge, to any person       |\|
+// |/|   obtaining a copy of this software and associated                  |/|
+// |\|   documentation files (the "Software"), to deal in the              |\|
+// |/|   Software without restriction, including without limitation        |/|
+// |\|   the rights to use, copy, modify, merge, publish,                  |\|
+// |/|   distribute, sublicense, and/or sell copies of the Software,       |/|
+// |\|   and to permit persons to whom the Software is furnished to        |\|
+// |/|   do so, subject to the following conditions:                       |/|
+// |\|                                                                     |\|
+// |/|   The above copyright notice and this permission notice shall       |/|
+// |\|   be included in all copies or substantial portions of the          |\|
+// |/|   Software.                                                         |/|
+// |\|                                                                     |\|
+// |/|   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY         |/|
+// |\|   KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE        |\|
+// |/|   WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR           |/|
+// |\|   PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS        |\|
+// |/|   OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR          |/|
+// |\|   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR        |\|
+// |/|   OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE         |/|
+// |\|   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.            |\|
+// |/|                                                                     |/|
+// |/+---------------------------------------------------------------------+/|
+// |\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/ |
+// +-------------------------------------------------------------------------+
+//
+*/
+
+#pragma once
+
+/// @file kflathash.h
+/// Open addressing hash map and set in the style of the "Swiss tables". Elements
+/// are stored inline in one array, next to an array of one control byte per
+/// slot that holds 7 bits of the element's hash, or marks the slot as empty or
+/// deleted. Lookups compare a whole group of control bytes at once (16 with SSE2,
+/// 8 otherwise) and only touch the elements whose control byte matches.
+///
+/// Like the KUnorderedMap / KUnorderedSet in kassociative.h they allow for
+/// heterogeneous lookups, e.g. find(KStringView) on a map with KString keys,
+/// if the hash and the comparator accept the other type (std::hash<KString> and
+/// the default std::equal_to<> do), have a contains() member, and the map has an
+/// operator[](Key) const that does not add an element.
+///
+/// Pointer stability: there is none on insertion. Any insertion that grows the
+/// table, and reserve() or rehash(), move all elements into a new array, which
+/// invalidates all pointers, references and iterators. Erasure does not move
+/// other elements, it only invalidates iterators and references to the erased
+/// element. Use KUnorderedMap / KUnorderedSet if you need stable references.
+
+#include <dekaf2/core/init/kdefinitions.h>
+#include <dekaf2/core/types/kbit.h>
+#include <dekaf2/containers/associative/bits/kmutable_pair.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+#if defined(__SSE2__) || (defined(DEKAF2_IS_MSC) && defined(DEKAF2_X86_64))
+	#define DEKAF2_FLAT_HASH_USE_SSE2 1
+	#include <emmintrin.h>
+#endif
+
+DEKAF2_NAMESPACE_BEGIN
+
+/// @addtogroup containers_associative
+/// @{
+
+namespace detail {
+namespace flathash {
+
+using ctrl_t = int8_t;
+
+/// the control byte values for non-full slots, full slots have the 7 bit hash value (0..127)
+enum : ctrl_t
+{
+	Empty    = -128,
+	Deleted  = -2,
+	Sentinel = -1
+};
+
+#ifdef DEKAF2_FLAT_HASH_USE_SSE2
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+/// a group of 16 control bytes, compared with SSE2, one bit per slot in the masks
+struct Group
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+{
+	static constexpr std::size_t Width = 16;
+	static constexpr int         Shift = 0;
+
+	explicit Group(const ctrl_t* pCtrl) noexcept
+	: m_Ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pCtrl)))
+	{
+	}
+
+	/// returns a mask of the slots with the given hash value
+	uint64_t Match(ctrl_t iHash) const noexcept
+	{
+		return static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(iHash), m_Ctrl)));
+	}
+
+	/// returns a mask of the empty slots
+	uint64_t MatchEmpty() const noexcept
+	{
+		return Match(Empty);
+	}
+
+	/// returns a mask of the empty or deleted slots
+	uint64_t MatchEmptyOrDeleted() const noexcept
+	{
+		return static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(Sentinel), m_Ctrl)));
+	}
+
+	__m128i m_Ctrl;
+
+}; // Group
+
+#else
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+/// a group of 8 control bytes, compared in a 64 bit word, the high bit of each byte in the masks
+struct Group
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+{
+	static constexpr std::size_t Width = 8;
+	static constexpr int         Shift = 3;
+
+	static constexpr uint64_t    LSBs  = 0x0101010101010101ULL;
+	static constexpr uint64_t    MSBs  = 0x8080808080808080ULL;
+
+	explicit Group(const ctrl_t* pCtrl) noexcept
+	{
+		std::memcpy(&m_Ctrl, pCtrl, sizeof(m_Ctrl));
+		kFromLittleEndian(m_Ctrl);
+	}
+
+	/// returns a mask of the slots with the given hash value - this may have false
+	/// positives on full slots, which are sorted out by the key comparison
+	uint64_t Match(ctrl_t iHash) const noexcept
+	{
+		auto x = m_Ctrl ^ (LSBs * static_cast<uint8_t>(iHash));
+		return (x - LSBs) & ~x & MSBs;
+	}
+
+	/// returns a mask of the empty slots
+	uint64_t MatchEmpty() const noexcept
+	{
+		return m_Ctrl & ~(m_Ctrl << 6) & MSBs;
+	}
+
+	/// returns a mask of the empty or deleted slots
+	uint64_t MatchEmptyOrDeleted() const noexcept
+	{
+		return m_Ctrl & ~(m_Ctrl << 7) & MSBs;
+	}
+
+	uint64_t m_Ctrl;
+
+}; // Group
+
+#endif
+
+/// returns the index of the first slot in a mask
+inline std::size_t LowestSlot(uint64_t iMask) noexcept
+{
+	return static_cast<std::size_t>(kBitCountRightZero(iMask)) >> Group::Shift;
+}
+
+/// returns the index of the last slot in a mask
+inline std::size_t HighestSlot(uint64_t iMask) noexcept
+{
+	return static_cast<std::size_t>(63 - kBitCountLeftZero(iMask)) >> Group::Shift;
+}
+
+/// the control bytes of a table without slots: the sentinel for the iteration, then empty slots for the lookup
+alignas(16) inline constexpr ctrl_t s_EmptyGroup[16]
+{
+	Sentinel, Empty, Empty, Empty, Empty, Empty, Empty, Empty,
+	Empty,    Empty, Empty, Empty, Empty, Empty, Empty, Empty
+};
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+template<class Key>
+struct SetPolicy
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+{
+	using key_type   = Key;
+	using value_type = Key;
+
+	static const key_type& GetKey(const value_type& Element) noexcept { return Element; }
+};
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+template<class Key, class Value>
+struct MapPolicy
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+{
+	using key_type   = Key;
+	using value_type = KMutablePair<Key, Value>;
+
+	static const key_type& GetKey(const value_type& Element) noexcept { return Element.first; }
+};
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+/// the common implementation of KFlatHashMap and KFlatHashSet
+template<class Policy, class Hash, class KeyEqual, class Allocator>
+class Table
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+{
+
+//----------
+public:
+//----------
+
+	using key_type        = typename Policy::key_type;
+	using value_type      = typename Policy::value_type;
+	using size_type       = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using hasher          = Hash;
+	using key_equal       = KeyEqual;
+	using allocator_type  = typename std::allocator_traits<Allocator>::template rebind_alloc<value_type>;
+	using reference       = const value_type&;
+	using const_reference = const value_type&;
+
+	//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+	/// the elements are const like in the boost::multi_index containers, the
+	/// mapped values of the map are declared mutable
+	class iterator
+	//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+	{
+		friend class Table;
+
+	public:
+
+		using iterator_category = std::forward_iterator_tag;
+		using value_type        = typename Policy::value_type;
+		using difference_type   = std::ptrdiff_t;
+		using pointer           = const value_type*;
+		using reference         = const value_type&;
+
+		iterator() = default;
+
+		reference operator*()  const { return *m_pSlot; }
+		pointer   operator->() const { return  m_pSlot; }
+
+		iterator& operator++()
+		{
+			++m_pCtrl;
+			++m_pSlot;
+			SkipEmpty();
+			return *this;
+		}
+
+		iterator operator++(int)
+		{
+			auto it = *this;
+			++*this;
+			return it;
+		}
+
+		bool operator==(const iterator& other) const { return m_pCtrl == other.m_pCtrl; }
+		bool operator!=(const iterator& other) const { return m_pCtrl != other.m_pCtrl; }
+
+	private:
+
+		iterator(const ctrl_t* pCtrl, value_type* pSlot)
+		: m_pCtrl(pCtrl)
+		, m_pSlot(pSlot)
+		{
+		}
+
+		void SkipEmpty()
+		{
+			// stops at full slots and at the sentinel behind the last slot
+			while (*m_pCtrl < Sentinel)
+			{
+				++m_pCtrl;
+				++m_pSlot;
+			}
+		}
+
+		const ctrl_t* m_pCtrl { nullptr };
+		value_type*   m_pSlot { nullptr };
+
+	}; // iterator
+
+	using const_iterator = iterator;
+
+	Table() = default;
+
+	explicit Table(size_type iBuckets, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual(), const Allocator& alloc = Allocator())
+	: m_Hash(hash)
+	, m_Equal(equal)
+	, m_Alloc(alloc)
+	{
+		reserve(iBuckets);
+	}
+
+	template<class InputIt>
+	Table(InputIt first, InputIt last)
+	{
+		insert(first, last);
+	}
+
+	Table(std::initializer_list<value_type> Init)
+	{
+		insert(Init);
+	}
+
+	Table(const Table& other)
+	: m_Hash(other.m_Hash)
+	, m_Equal(other.m_Equal)
+	, m_Alloc(std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.m_Alloc))
+	{
+		reserve(other.size());
+
+		for (const auto& Value : other)
+		{
+			// all keys are unique, no need to search
+			auto iHash = HashOf(Policy::GetKey(Value));
+			auto iSlot = PrepareInsert(iHash);
+			std::allocator_traits<allocator_type>::construct(m_Alloc, m_pSlots + iSlot, Value);
+			FinishInsert(iSlot, iHash);
+		}
+	}
+
+	Table(Table&& other) noexcept
+	: m_Hash(std::move(other.m_Hash))
+	, m_Equal(std::move(other.m_Equal))
+	, m_Alloc(std::move(other.m_Alloc))
+	, m_pCtrl(other.m_pCtrl)
+	, m_pSlots(other.m_pSlots)
+	, m_iCapacity(other.m_iCapacity)
+	, m_iSize(other.m_iSize)
+	, m_iGrowthLeft(other.m_iGrowthLeft)
+	{
+		other.Reset();
+	}
+
+	Table& operator=(const Table& other)
+	{
+		if (this != &other)
+		{
+			Table Copy(other);
+			swap(Copy);
+		}
+		return *this;
+	}
+
+	Table& operator=(Table&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Destroy();
+			m_Hash        = std::move(other.m_Hash);
+			m_Equal       = std::move(other.m_Equal);
+			m_Alloc       = std::move(other.m_Alloc);
+			m_pCtrl       = other.m_pCtrl;
+			m_pSlots      = other.m_pSlots;
+			m_iCapacity   = other.m_iCapacity;
+			m_iSize       = other.m_iSize;
+			m_iGrowthLeft = other.m_iGrowthLeft;
+			other.Reset();
+		}
+		return *this;
+	}
+
+	~Table()
+	{
+		Destroy();
+	}
+
+	iterator       begin()        { iterator it(m_pCtrl, m_pSlots); it.SkipEmpty(); return it; }
+	const_iterator begin()  const { iterator it(m_pCtrl, m_pSlots); it.SkipEmpty(); return it; }
+	const_iterator cbegin() const { return begin(); }
+	iterator       end()          { return iterator(m_pCtrl + m_iCapacity, m_pSlots + m_iCapacity); }
+	const_iterator end()    const { return iterator(m_pCtrl + m_iCapacity, m_pSlots + m_iCapacity); }
+	const_iterator cend()   const { return end(); }
+
+	DEKAF2_NODISCARD
+	bool      empty()         const { return !m_iSize;                    }
+	DEKAF2_NODISCARD
+	size_type size()          const { return m_iSize;                     }
+	DEKAF2_NODISCARD
+	size_type max_size()      const { return std::allocator_traits<allocator_type>::max_size(m_Alloc); }
+	DEKAF2_NODISCARD
+	size_type bucket_count()  const { return m_iCapacity;                 }
+	DEKAF2_NODISCARD
+	float     load_factor()   const { return m_iCapacity ? float(m_iSize) / float(m_iCapacity) : 0.0f; }
+	DEKAF2_NODISCARD
+	float max_load_factor()   const { return 7.0f / 8.0f;                 }
+
+	hasher         hash_function() const { return m_Hash;  }
+	key_equal      key_eq()        const { return m_Equal; }
+	allocator_type get_allocator() const { return m_Alloc; }
+
+	/// removes all elements, but keeps the allocated memory
+	void clear() noexcept
+	{
+		if (m_iCapacity)
+		{
+			DestroySlots();
+			std::memset(m_pCtrl, Empty, m_iCapacity + Group::Width);
+			m_pCtrl[m_iCapacity] = Sentinel;
+			m_iSize              = 0;
+			m_iGrowthLeft        = CapacityToGrowth(m_iCapacity);
+		}
+	}
+
+	/// prepare for iCount elements without further growth
+	void reserve(size_type iCount)
+	{
+		if (iCount > m_iSize + m_iGrowthLeft)
+		{
+			Resize(GrowthToCapacity(iCount));
+		}
+	}
+
+	/// resize to at least iCount slots, and drop the deleted slots
+	void rehash(size_type iCount)
+	{
+		if (!iCount && !m_iSize)
+		{
+			Destroy();
+			return;
+		}
+
+		auto iCapacity = GrowthToCapacity(std::max(iCount, m_iSize));
+
+		if (iCapacity != m_iCapacity || m_iGrowthLeft + m_iSize < CapacityToGrowth(m_iCapacity))
+		{
+			Resize(iCapacity);
+		}
+	}
+
+	std::pair<iterator, bool> insert(const value_type& Value)
+	{
+		return EmplaceUnique(Policy::GetKey(Value), Value);
+	}
+
+	std::pair<iterator, bool> insert(value_type&& Value)
+	{
+		return EmplaceUnique(Policy::GetKey(Value), std::move(Value));
+	}
+
+	template<class InputIt>
+	void insert(InputIt first, InputIt last)
+	{
+		for (; first != last; ++first)
+		{
+			emplace(*first);
+		}
+	}
+
+	void insert(std::initializer_list<value_type> Init)
+	{
+		reserve(m_iSize + Init.size());
+		insert(Init.begin(), Init.end());
+	}
+
+	/// constructs the element first, and drops it if the key is already in the table
+	template<class... Args>
+	std::pair<iterator, bool> emplace(Args&&... args)
+	{
+		value_type Value(std::forward<Args>(args)...);
+		return EmplaceUnique(Policy::GetKey(Value), std::move(Value));
+	}
+
+	template<class K>
+	DEKAF2_NODISCARD
+	iterator find(const K& key)
+	{
+		auto iSlot = FindSlot(key, HashOf(key));
+		return (iSlot == npos) ? end() : iterator(m_pCtrl + iSlot, m_pSlots + iSlot);
+	}
+
+	template<class K>
+	DEKAF2_NODISCARD
+	const_iterator find(const K& key) const
+	{
+		auto iSlot = FindSlot(key, HashOf(key));
+		return (iSlot == npos) ? end() : iterator(m_pCtrl + iSlot, m_pSlots + iSlot);
+	}
+
+	template<class K>
+	DEKAF2_NODISCARD
+	bool contains(const K& key) const
+	{
+		return FindSlot(key, HashOf(key)) != npos;
+	}
+
+	template<class K>
+	DEKAF2_NODISCARD
+	size_type count(const K& key) const
+	{
+		return contains(key) ? 1 : 0;
+	}
+
+	/// erase the element at pos, returns the iterator to the next element
+	iterator erase(const_iterator pos)
+	{
+		auto it = pos;
+		++it;
+		EraseSlot(static_cast<size_type>(pos.m_pCtrl - m_pCtrl));
+		return it;
+	}
+
+	/// erase the element with key, returns count of erased elements
+	template<class K>
+	size_type erase(const K& key)
+	{
+		auto iSlot = FindSlot(key, HashOf(key));
+
+		if (iSlot == npos)
+		{
+			return 0;
+		}
+
+		EraseSlot(iSlot);
+		return 1;
+	}
+
+	void swap(Table& other) noexcept
+	{
+		using std::swap;
+		swap(m_Hash       , other.m_Hash       );
+		swap(m_Equal      , other.m_Equal      );
+		swap(m_Alloc      , other.m_Alloc      );
+		swap(m_pCtrl      , other.m_pCtrl      );
+		swap(m_pSlots     , other.m_pSlots     );
+		swap(m_iCapacity  , other.m_iCapacity  );
+		swap(m_iSize      , other.m_iSize      );
+		swap(m_iGrowthLeft, other.m_iGrowthLeft);
+	}
+
+	friend void swap(Table& left, Table& right) noexcept
+	{
+		left.swap(right);
+	}
+
+	/// the elements compare equal, regardless of their order
+	bool operator==(const Table& other) const
+	{
+		if (size() != other.size())
+		{
+			return false;
+		}
+
+		for (const auto& Value : *this)
+		{
+			auto it = other.find(Policy::GetKey(Value));
+
+			if (it == other.end() || !(*it == Value))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool operator!=(const Table& other) const
+	{
+		return !operator==(other);
+	}
+
+//----------
+protected:
+//----------
+
+	static constexpr size_type npos = size_type(-1);
+
+	/// insert the element constructed from args if key is not yet in the table
+	template<class K, class... Args>
+	std::pair<iterator, bool> EmplaceUnique(const K& key, Args&&... args)
+	{
+		auto iHash = HashOf(key);
+		auto iSlot = FindSlot(key, iHash);
+
+		if (iSlot != npos)
+		{
+			return { iterator(m_pCtrl + iSlot, m_pSlots + iSlot), false };
+		}
+
+		iSlot = PrepareInsert(iHash);
+		std::allocator_traits<allocator_type>::construct(m_Alloc, m_pSlots + iSlot, std::forward<Args>(args)...);
+		FinishInsert(iSlot, iHash);
+
+		return { iterator(m_pCtrl + iSlot, m_pSlots + iSlot), true };
+	}
+
+	/// insert the element returned by Make() if key is not yet in the table - Make() is only called
+	/// after the lookup, so it may consume the object that key refers to
+	template<class K, class MakeValue>
+	std::pair<iterator, bool> EmplaceWith(const K& key, MakeValue&& Make)
+	{
+		auto iHash = HashOf(key);
+		auto iSlot = FindSlot(key, iHash);
+
+		if (iSlot != npos)
+		{
+			return { iterator(m_pCtrl + iSlot, m_pSlots + iSlot), false };
+		}
+
+		iSlot = PrepareInsert(iHash);
+		std::allocator_traits<allocator_type>::construct(m_Alloc, m_pSlots + iSlot, Make());
+		FinishInsert(iSlot, iHash);
+
+		return { iterator(m_pCtrl + iSlot, m_pSlots + iSlot), true };
+	}
+
+//----------
+private:
+//----------
+
+	using CtrlAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<ctrl_t>;
+
+	/// the hash functions for strings or integers do not always spread their bits well
+	/// enough for the 7 bit control bytes, therefore the hash is mixed once more
+	template<class K>
+	std::size_t HashOf(const K& key) const
+	{
+		uint64_t iHash = static_cast<uint64_t>(m_Hash(key)) * 0x9E3779B97F4A7C15ULL;
+		return static_cast<std::size_t>(iHash ^ (iHash >> 32));
+	}
+
+	static ctrl_t    H2(std::size_t iHash) noexcept { return static_cast<ctrl_t>(iHash & 0x7F); }
+	static size_type H1(std::size_t iHash) noexcept { return iHash >> 7; }
+
+	/// capacities are 2^n - 1, so that the capacity is the mask for the probe position
+	static size_type NormalizeCapacity(size_type iCapacity) noexcept
+	{
+		return std::max(kBitCeil(iCapacity + 1) - 1, Group::Width - 1);
+	}
+
+	/// the maximum load factor is 7/8, but at least one slot stays empty
+	static size_type CapacityToGrowth(size_type iCapacity) noexcept
+	{
+		return std::min(iCapacity - 1, iCapacity - iCapacity / 8);
+	}
+
+	static size_type GrowthToCapacity(size_type iGrowth) noexcept
+	{
+		auto iCapacity = NormalizeCapacity(iGrowth + iGrowth / 7);
+
+		while (CapacityToGrowth(iCapacity) < iGrowth)
+		{
+			iCapacity = iCapacity * 2 + 1;
+		}
+
+		return iCapacity;
+	}
+
+	/// set a control byte, and its clone behind the sentinel for the first Width - 1 slots
+	void SetCtrl(size_type iSlot, ctrl_t iCtrl) noexcept
+	{
+		m_pCtrl[iSlot] = iCtrl;
+		m_pCtrl[((iSlot - (Group::Width - 1)) & m_iCapacity) + (Group::Width - 1)] = iCtrl;
+	}
+
+	template<class K>
+	size_type FindSlot(const K& key, std::size_t iHash) const
+	{
+		// the empty table has a group of empty control bytes at position 0
+		auto        iPos   = H1(iHash) & m_iCapacity;
+		auto        iH2    = H2(iHash);
+		std::size_t iProbe = 0;
+
+		for (;;)
+		{
+			Group group(m_pCtrl + iPos);
+
+			for (auto iMatch = group.Match(iH2); iMatch; iMatch &= iMatch - 1)
+			{
+				auto iSlot = (iPos + LowestSlot(iMatch)) & m_iCapacity;
+
+				if (DEKAF2_LIKELY(m_Equal(Policy::GetKey(m_pSlots[iSlot]), key)))
+				{
+					return iSlot;
+				}
+			}
+
+			if (DEKAF2_LIKELY(group.MatchEmpty()))
+			{
+				return npos;
+			}
+
+			// triangular probing visits all groups of a 2^n table
+			iProbe += Group::Width;
+			iPos    = (iPos + iProbe) & m_iCapacity;
+		}
+	}
+
+	/// returns the first empty or deleted slot in the probe sequence
+	size_type FindFirstNonFull(std::size_t iHash) const noexcept
+	{
+		auto        iPos   = H1(iHash) & m_iCapacity;
+		std::size_t iProbe = 0;
+
+		for (;;)
+		{
+			Group group(m_pCtrl + iPos);
+			auto iMask = group.MatchEmptyOrDeleted();
+
+			if (iMask)
+			{
+				return (iPos + LowestSlot(iMask)) & m_iCapacity;
+			}
+
+			iProbe += Group::Width;
+			iPos    = (iPos + iProbe) & m_iCapacity;
+		}
+	}
+
+	/// returns the slot for a new element, grows the table if needed
+	size_type PrepareInsert(std::size_t iHash)
+	{
+		if (!m_iCapacity)
+		{
+			Resize(Group::Width - 1);
+		}
+
+		auto iSlot = FindFirstNonFull(iHash);
+
+		if (DEKAF2_UNLIKELY(!m_iGrowthLeft && m_pCtrl[iSlot] != Deleted))
+		{
+			// if many slots are deleted, rehash at the same size to drop them, else grow
+			if (m_iCapacity > Group::Width && m_iSize * 32 <= m_iCapacity * 25)
+			{
+				Resize(m_iCapacity);
+			}
+			else
+			{
+				Resize(m_iCapacity * 2 + 1);
+			}
+
+			iSlot = FindFirstNonFull(iHash);
+		}
+
+		return iSlot;
+	}
+
+	/// mark a slot as full after the element was constructed
+	void FinishInsert(size_type iSlot, std::size_t iHash) noexcept
+	{
+		if (m_pCtrl[iSlot] == Empty)
+		{
+			--m_iGrowthLeft;
+		}
+
+		SetCtrl(iSlot, H2(iHash));
+		++m_iSize;
+	}
+
+	void EraseSlot(size_type iSlot)
+	{
+		std::allocator_traits<allocator_type>::destroy(m_Alloc, m_pSlots + iSlot);
+		--m_iSize;
+
+		// if the slot was never part of a full group, probes never went past it,
+		// and it can become empty again instead of deleted
+		auto iBefore      = (iSlot - Group::Width) & m_iCapacity;
+		auto iEmptyAfter  = Group(m_pCtrl + iSlot  ).MatchEmpty();
+		auto iEmptyBefore = Group(m_pCtrl + iBefore).MatchEmpty();
+
+		if (iEmptyBefore && iEmptyAfter &&
+		    (Group::Width - 1 - HighestSlot(iEmptyBefore)) + LowestSlot(iEmptyAfter) < Group::Width)
+		{
+			SetCtrl(iSlot, Empty);
+			++m_iGrowthLeft;
+		}
+		else
+		{
+			SetCtrl(iSlot, Deleted);
+		}
+	}
+
+	void Resize(size_type iNewCapacity)
+	{
+		auto pOldCtrl     = m_pCtrl;
+		auto pOldSlots    = m_pSlots;
+		auto iOldCapacity = m_iCapacity;
+
+		CtrlAllocator CtrlAlloc(m_Alloc);
+
+		m_pCtrl     = std::allocator_traits<CtrlAllocator>::allocate(CtrlAlloc, iNewCapacity + Group::Width);
+		m_pSlots    = std::allocator_traits<allocator_type>::allocate(m_Alloc, iNewCapacity);
+		m_iCapacity = iNewCapacity;
+
+		std::memset(m_pCtrl, Empty, iNewCapacity + Group::Width);
+		m_pCtrl[iNewCapacity] = Sentinel;
+		m_iGrowthLeft         = CapacityToGrowth(iNewCapacity) - m_iSize;
+
+		for (size_type i = 0; i < iOldCapacity; ++i)
+		{
+			if (pOldCtrl[i] >= 0)
+			{
+				auto iHash = HashOf(Policy::GetKey(pOldSlots[i]));
+				auto iSlot = FindFirstNonFull(iHash);
+				std::allocator_traits<allocator_type>::construct(m_Alloc, m_pSlots + iSlot, std::move(pOldSlots[i]));
+				std::allocator_traits<allocator_type>::destroy(m_Alloc, pOldSlots + i);
+				SetCtrl(iSlot, H2(iHash));
+			}
+		}
+
+		if (iOldCapacity)
+		{
+			std::allocator_traits<CtrlAllocator>::deallocate(CtrlAlloc, const_cast<ctrl_t*>(pOldCtrl), iOldCapacity + Group::Width);
+			std::allocator_traits<allocator_type>::deallocate(m_Alloc, pOldSlots, iOldCapacity);
+		}
+	}
+
+	void DestroySlots() noexcept
+	{
+		for (size_type i = 0; i < m_iCapacity; ++i)
+		{
+			if (m_pCtrl[i] >= 0)
+			{
+				std::allocator_traits<allocator_type>::destroy(m_Alloc, m_pSlots + i);
+			}
+		}
+	}
+
+	void Destroy() noexcept
+	{
+		if (m_iCapacity)
+		{
+			DestroySlots();
+			CtrlAllocator CtrlAlloc(m_Alloc);
+			std::allocator_traits<CtrlAllocator>::deallocate(CtrlAlloc, m_pCtrl, m_iCapacity + Group::Width);
+			std::allocator_traits<allocator_type>::deallocate(m_Alloc, m_pSlots, m_iCapacity);
+		}
+
+		Reset();
+	}
+
+	void Reset() noexcept
+	{
+		m_pCtrl       = const_cast<ctrl_t*>(s_EmptyGroup);
+		m_pSlots      = nullptr;
+		m_iCapacity   = 0;
+		m_iSize       = 0;
+		m_iGrowthLeft = 0;
+	}
+
+	Hash           m_Hash;
+	KeyEqual       m_Equal;
+	allocator_type m_Alloc;
+	ctrl_t*        m_pCtrl       { const_cast<ctrl_t*>(s_EmptyGroup) };
+	value_type*    m_pSlots      { nullptr };
+	size_type      m_iCapacity   { 0 };
+	size_type      m_iSize       { 0 };
+	size_type      m_iGrowthLeft { 0 };
+
+}; // Table
+
+} // end of namespace flathash
+} // end of namespace detail
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+/// open addressing hash set with SIMD group probing, see the notes on pointer stability in kflathash.h
+template<
+	class Key,
+	class Hash      = std::hash<Key>,
+	class KeyEqual  = std::equal_to<>,
+	class Allocator = std::allocator<Key>
+>
+class KFlatHashSet : public detail::flathash::Table<detail::flathash::SetPolicy<Key>, Hash, KeyEqual, Allocator>
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+{
+	using base_type = detail::flathash::Table<detail::flathash::SetPolicy<Key>, Hash, KeyEqual, Allocator>;
+
+public:
+
+	using base_type::base_type;
+
+}; // KFlatHashSet
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+/// open addressing hash map with SIMD group probing, see the notes on pointer stability in kflathash.h
+template<
+	class Key,
+	class Value,
+	class Hash      = std::hash<Key>,
+	class KeyEqual  = std::equal_to<>,
+	class Allocator = std::allocator<std::pair<const Key, Value>>
+>
+class KFlatHashMap : public detail::flathash::Table<detail::flathash::MapPolicy<Key, Value>, Hash, KeyEqual, Allocator>
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+{
+	using base_type = detail::flathash::Table<detail::flathash::MapPolicy<Key, Value>, Hash, KeyEqual, Allocator>;
+
+public:
+
+	using mapped_type = Value;
+	using typename base_type::iterator;
+
+	using base_type::base_type;
+
+	/// inserts a new element with the key and a value constructed from args, if the key is not yet in the map
+	template<class K, class... Args>
+	std::pair<iterator, bool> try_emplace(K&& key, Args&&... args)
+	{
+		return this->EmplaceWith(key, [&]()
+		{
+			return typename base_type::value_type(Key(std::forward<K>(key)), Value(std::forward<Args>(args)...));
+		});
+	}
+
+	/// inserts a new element with the key and the value, or assigns the value to an existing element
+	template<class K, class V>
+	std::pair<iterator, bool> insert_or_assign(K&& key, V&& value)
+	{
+		auto it = this->find(key);
+
+		if (it != this->end())
+		{
+			it->second = std::forward<V>(value);
+			return { it, false };
+		}
+
+		return try_emplace(std::forward<K>(key), std::forward<V>(value));
+	}
+
+	template<typename K>
+	const Value& operator[](K&& key) const
+	{
+		auto it = this->find(key);
+
+		if (it != this->end())
+		{
+			return it->second;
+		}
+		else
+		{
+			return s_Empty;
+		}
+	}
+
+	template<typename K>
+	Value& operator[](K&& key)
+	{
+		return try_emplace(std::forward<K>(key)).first->second;
+	}
+
+private:
+
+	static const Value s_Empty;
+
+}; // KFlatHashMap
+
+template<class Key, class Value, class Hash, class KeyEqual, class Allocator>
+const Value KFlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::s_Empty = Value();
+
+/// @}
+
+DEKAF2_NAMESPACE_END
@@ -49,5 +49,6 @@ template class KProps<KString, KString, /*order-matters=*/false, /*unique-keys=*
 template class KProps<KString, KString, /*order-matters=*/true,  /*unique-keys=*/true >;
 template class KProps<KString, KString, /*order-matters=*/false, /*unique-keys=*/false>;
 template class KProps<KString, KString, /*order-matters=*/true,  /*unique-keys=*/false>;
+template class KSmallProps<KString, KString, /*order-matters=*/true, /*unique-keys=*/false>;
 
 DEKAF2_NAMESPACE_END
@@ -73,7 +73,11 @@
 #pragma GCC diagnostic pop
 #endif
 #include <algorithm>
+#include <exception>
+#include <vector>
 #include <dekaf2/core/init/kcompatibility.h>
+#include <dekaf2/core/types/kbit.h>
+#include <dekaf2/core/types/ktemplate.h>
 #include <dekaf2/containers/associative/bits/kmutable_pair.h>
 #include <dekaf2/core/strings/ksplit.h>
 #include <dekaf2/core/strings/kjoin.h>
@@ -1077,12 +1081,938 @@ template<class Key, class Value, bool Sequential, bool Unique>
 typename KProps<Key, Value, Sequential, Unique>::Element
 KProps<Key, Value, Sequential, Unique>::s_EmptyElement_v = Element();
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+/// A KProps for small sets of key value pairs, like HTTP headers or query
+/// parameters, with the same interface and the same ordering semantics.
+///
+/// The elements are kept in one vector in insertion order, next to a vector
+/// with the hash of each key. Up to iMaxLinear elements are searched linearly
+/// on the hashes, without any index. Only when the container grows beyond that,
+/// a hashed index is built, which chains the positions of elements with equal
+/// hashes. Filling the container therefore allocates two vectors instead of one
+/// node per element and index.
+///
+/// Like the hashed index of KProps, find() and Get() return the element with the
+/// key that was inserted last, and equal_range() iterates from the last to the
+/// first inserted element with the key.
+///
+/// Differing from KProps, iterators and references are invalidated when the
+/// vector grows beyond its reserved capacity of iMaxLinear elements, and by
+/// erasing elements. Also the iteration order of a non-sequential instance is
+/// the insertion order.
+template <class Key, class Value, bool Sequential = true, bool Unique = false, std::size_t iMaxLinear = 16>
+class DEKAF2_PUBLIC KSmallProps
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+{
+
+//----------
+protected:
+//----------
+
+	using self_type      = KSmallProps<Key, Value, Sequential, Unique, iMaxLinear>;
+	using Element        = detail::KMutablePair<Key, Value>;
+	using storage_type   = std::vector<Element>;
+
+	static constexpr std::size_t npos   = std::size_t(-1);
+	static constexpr uint32_t    noslot = uint32_t(-1);
+
+	storage_type             m_Storage;
+	std::vector<std::size_t> m_Hashes;
+	// the hashed index, only built for more than iMaxLinear elements: the last
+	// position per bucket, and for each position the previous one in its bucket
+	std::vector<uint32_t>    m_Buckets;
+	std::vector<uint32_t>    m_Prev;
+
+	static const Element s_EmptyElement;
+	static Element s_EmptyElement_v;
+
+//----------
+public:
+//----------
+
+	//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+	/// iterates over all elements with the same key, from the last to the first inserted
+	class EqualKeyIterator
+	//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+	{
+
+	//----------
+	public:
+	//----------
+
+		using iterator_category = std::forward_iterator_tag;
+		using value_type        = Element;
+		using difference_type   = std::ptrdiff_t;
+		using pointer           = const Element*;
+		using reference         = const Element&;
+
+		EqualKeyIterator() = default;
+		EqualKeyIterator(const self_type* pProps, std::size_t iPos) : m_pProps(pProps), m_iPos(iPos) {}
+
+		reference operator*()  const { return  m_pProps->m_Storage[m_iPos]; }
+		pointer   operator->() const { return &m_pProps->m_Storage[m_iPos]; }
+
+		EqualKeyIterator& operator++()
+		{
+			m_iPos = m_pProps->PrevEqual(m_iPos);
+			return *this;
+		}
+
+		EqualKeyIterator operator++(int)
+		{
+			auto it = *this;
+			++*this;
+			return it;
+		}
+
+		bool operator==(const EqualKeyIterator& other) const { return m_iPos == other.m_iPos; }
+		bool operator!=(const EqualKeyIterator& other) const { return m_iPos != other.m_iPos; }
+
+	//----------
+	private:
+	//----------
+
+		const self_type* m_pProps { nullptr };
+		std::size_t      m_iPos   { 0 };
+
+	}; // EqualKeyIterator
+
+	// the elements are const like in KProps, but the values are mutable
+	using iterator           = typename storage_type::const_iterator;
+	using const_iterator     = typename storage_type::const_iterator;
+	using map_iterator       = EqualKeyIterator;
+	using const_map_iterator = EqualKeyIterator;
+	using range              = std::pair<map_iterator, map_iterator>;
+	using const_range        = std::pair<const_map_iterator, const_map_iterator>;
+	using value_type         = Element;
+	using key_type           = Key;
+	using mapped_type        = Value;
+	using Parser             = typename KProps<Key, Value, Sequential, Unique>::Parser;
+	using Serializer         = typename KProps<Key, Value, Sequential, Unique>::Serializer;
+
+	KSmallProps() = default;
+	KSmallProps (std::initializer_list<value_type> il) : KSmallProps(il.begin(), il.end()) {}
+	template<class _InputIterator>
+	KSmallProps (_InputIterator first, _InputIterator last)
+	{
+		for (; first != last; ++first)
+		{
+			insert(*first);
+		}
+	}
+
+	//-----------------------------------------------------------------------------
+	bool operator==(const self_type& other) const
+	//-----------------------------------------------------------------------------
+	{
+		return (
+			size() == other.size()) &&
+			std::equal(begin(), end(), other.begin());
+	}
+
+	//-----------------------------------------------------------------------------
+	bool operator!=(const self_type& other) const
+	//-----------------------------------------------------------------------------
+	{
+		return !operator==(other);
+	}
+
+	//-----------------------------------------------------------------------------
+	bool operator<(const self_type& other) const
+	//-----------------------------------------------------------------------------
+	{
+		return std::lexicographical_compare(begin(), end(), other.begin(), other.end());
+	}
+
+	//-----------------------------------------------------------------------------
+	bool operator>(const self_type& other) const
+	//-----------------------------------------------------------------------------
+	{
+		return other < *this;
+	}
+
+	//-----------------------------------------------------------------------------
+	bool operator<=(const self_type& other) const
+	//-----------------------------------------------------------------------------
+	{
+		return !(other < *this);
+	}
+
+	//-----------------------------------------------------------------------------
+	bool operator>=(const self_type& other) const
+	//-----------------------------------------------------------------------------
+	{
+		return !(*this < other);
+	}
+
+	//-----------------------------------------------------------------------------
+	DEKAF2_NODISCARD
+	const_iterator begin() const
+	//-----------------------------------------------------------------------------
+	{
+		return m_Storage.cbegin();
+	}
+
+	//-----------------------------------------------------------------------------
+	DEKAF2_NODISCARD
+	const_iterator end() const
+	//-----------------------------------------------------------------------------
+	{
+		return m_Storage.cend();
+	}
+
+	//-----------------------------------------------------------------------------
+	DEKAF2_NODISCARD
+	const_iterator cbegin() const
+	//-----------------------------------------------------------------------------
+	{
+		return m_Storage.cbegin();
+	}
+
+	//-----------------------------------------------------------------------------
+	DEKAF2_NODISCARD
+	const_iterator cend() const
+	//-----------------------------------------------------------------------------
+	{
+		return m_Storage.cend();
+	}
+
+	//-----------------------------------------------------------------------------
+	/// append a KSmallProps struct to another one
+	self_type& operator+=(const self_type& other)
+	//-----------------------------------------------------------------------------
+	{
+		for (auto& it : other)
+		{
+			Add(it.first, it.second);
+		}
+		return *this;
+	}
+
+	//-----------------------------------------------------------------------------
+	/// move a KSmallProps struct to the end of another one
+	self_type& operator+=(self_type&& other)
+	//-----------------------------------------------------------------------------
+	{
+		for (auto& it : other.m_Storage)
+		{
+			Add(std::move(it.first), std::move(it.second));
+		}
+		return *this;
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Parse input and add to the KSmallProps struct
+	size_t Parse(Parser& parser)
+	//-----------------------------------------------------------------------------
+	{
+		size_t iCount{0};
+		for (;;)
+		{
+			Key key;
+			Value value;
+			if (!parser.Get(key, value))
+			{
+				break;
+			}
+			Add(std::move(key), std::move(value));
+			++iCount;
+		}
+		return iCount;
+	}
+
+	//-----------------------------------------------------------------------------
+	/// serialize a KSmallProps struct
+	bool Serialize(Serializer& serializer) const
+	//-----------------------------------------------------------------------------
+	{
+		for (auto& it : *this)
+		{
+			serializer.Set(it.first, it.second);
+		}
+		return true;
+	}
+
+	//-----------------------------------------------------------------------------
+	// perfect forwarding and SFINAE for unique instances
+	template<class ValueType = value_type, bool Uq = Unique,
+	         typename std::enable_if<Uq == true, int>::type = 0>
+	std::pair<iterator, bool> insert(ValueType&& value)
+	//-----------------------------------------------------------------------------
+	{
+		return InsertUnique(Convert(std::forward<ValueType>(value)));
+	}
+
+	//-----------------------------------------------------------------------------
+	// perfect forwarding and SFINAE for non-unique instances
+	template<class ValueType = value_type, bool Uq = Unique,
+	         typename std::enable_if<Uq == false, int>::type = 0>
+	std::pair<iterator, bool> insert(ValueType&& value)
+	//-----------------------------------------------------------------------------
+	{
+		return { Append(Convert(std::forward<ValueType>(value))), true };
+	}
+
+	//-----------------------------------------------------------------------------
+	// perfect forwarding and SFINAE for unique instances
+	template<class K, class V, bool Uq = Unique,
+	         typename std::enable_if<Uq == true, int>::type = 0>
+	std::pair<iterator, bool> insert_or_assign(K&& key, V&& value)
+	//-----------------------------------------------------------------------------
+	{
+		auto iPos = FindPos(key);
+		if (iPos != npos)
+		{
+			m_Storage[iPos].second = std::forward<V>(value);
+			return { begin() + iPos, false };
+		}
+		else
+		{
+			return { Append(value_type(std::forward<K>(key), std::forward<V>(value))), true };
+		}
+	}
+
+	//-----------------------------------------------------------------------------
+	// perfect forwarding and SFINAE for non-unique instances
+	template<class K, class V, bool Uq = Unique,
+	         typename std::enable_if<Uq == false, int>::type = 0>
+	std::pair<iterator, bool> insert_or_assign(K&& key, V&& value)
+	//-----------------------------------------------------------------------------
+	{
+		return insert(value_type(std::forward<K>(key), std::forward<V>(value)));
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Inserts one element.
+	template<class K, class V>
+	std::pair<iterator, bool> emplace(K&& key, V&& value)
+	//-----------------------------------------------------------------------------
+	{
+		return insert(value_type(std::forward<K>(key), std::forward<V>(value)));
+	}
+
+	//-----------------------------------------------------------------------------
+	/// returns const_iterator on the first element with the given key.
+	template<class K>
+	DEKAF2_NODISCARD
+	const_iterator find(const K& key) const
+	//-----------------------------------------------------------------------------
+	{
+		auto iPos = FindPos(key);
+		return (iPos == npos) ? end() : begin() + iPos;
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Returns iterator range of the elements with the given key.
+	template<class K>
+	DEKAF2_NODISCARD
+	const_range equal_range(const K& key) const
+	//-----------------------------------------------------------------------------
+	{
+		auto iPos = FindPos(key);
+		return { map_iterator(this, (iPos == npos) ? size() : iPos), map_iterator(this, size()) };
+	}
+
+	//-----------------------------------------------------------------------------
+	// SFINAE for Unique instances
+	/// remove a Key/Value pair with a given key. Returns count of removed elements.
+	template<class K, bool Uq = Unique,
+			typename std::enable_if<Uq == true, int>::type = 0>
+	size_t erase(const K& key)
+	//-----------------------------------------------------------------------------
+	{
+		auto iPos = FindPos(key);
+		if (iPos == npos)
+		{
+			return 0;
+		}
+
+		m_Storage.erase(m_Storage.begin() + iPos);
+		m_Hashes.erase(m_Hashes.begin() + iPos);
+		RebuildIndex();
+
+		return 1;
+	}
+
+	//-----------------------------------------------------------------------------
+	// SFINAE for non Unique instances
+	/// remove Key/Value pairs with a given key. Returns count of removed elements.
+	template<class K, bool Uq = Unique,
+			typename std::enable_if<Uq == false, int>::type = 0>
+	size_t erase(const K& key)
+	//-----------------------------------------------------------------------------
+	{
+		auto iPos = FindPos(key);
+		if (iPos == npos)
+		{
+			return 0;
+		}
+
+		// compact the remaining elements, keeping their order
+		auto iHash = m_Hashes[iPos];
+		std::size_t iKept { 0 };
+
+		for (std::size_t i = 0; i < size(); ++i)
+		{
+			if (m_Hashes[i] != iHash || !(m_Storage[i].first == key))
+			{
+				if (iKept != i)
+				{
+					m_Storage[iKept] = std::move(m_Storage[i]);
+					m_Hashes [iKept] = m_Hashes[i];
+				}
+				++iKept;
+			}
+		}
+
+		auto iErased = size() - iKept;
+		m_Storage.erase(m_Storage.begin() + iKept, m_Storage.end());
+		m_Hashes.resize(iKept);
+		RebuildIndex();
+
+		return iErased;
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Returns count of elements with the given key.
+	template<class K>
+	DEKAF2_NODISCARD
+	size_t count(const K& key) const
+	//-----------------------------------------------------------------------------
+	{
+		auto Range = equal_range(key);
+		return std::distance(Range.first, Range.second);
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Returns true if at least one element with the given key exists.
+	template<class K>
+	DEKAF2_NODISCARD
+	bool contains(const K& key) const
+	//-----------------------------------------------------------------------------
+	{
+		return FindPos(key) != npos;
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Deletes all elements.
+	void clear()
+	//-----------------------------------------------------------------------------
+	{
+		m_Storage.clear();
+		m_Hashes.clear();
+		m_Buckets.clear();
+		m_Prev.clear();
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Returns count of all stored elements.
+	DEKAF2_NODISCARD
+	size_t size() const noexcept
+	//-----------------------------------------------------------------------------
+	{
+		return m_Storage.size();
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Returns maximum size.
+	DEKAF2_NODISCARD
+	size_t max_size() const noexcept
+	//-----------------------------------------------------------------------------
+	{
+		return std::min<std::size_t>(m_Storage.max_size(), noslot);
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Returns true if no elements are stored.
+	DEKAF2_NODISCARD
+	bool empty() const noexcept
+	//-----------------------------------------------------------------------------
+	{
+		return m_Storage.empty();
+	}
+
+	//-----------------------------------------------------------------------------
+	// perfect forwarding and SFINAE for unique instances
+	/// Set a new value for an existing key. If the key is not existing it is created.
+	template <class K, class V = Value, bool Uq = Unique,
+			typename std::enable_if<Uq == true, int>::type = 0>
+	iterator Set(K&& key, V&& newValue = V{})
+	//-----------------------------------------------------------------------------
+	{
+		return insert_or_assign(std::forward<K>(key), std::forward<V>(newValue)).first;
+	}
+
+	//-----------------------------------------------------------------------------
+	// perfect forwarding and SFINAE for non-unique instances
+	/// Set a new value for all existing keys. If the key is not existing it is created.
+	template <class K, class V = Value, bool Uq = Unique,
+			typename std::enable_if<Uq == false, int>::type = 0>
+	iterator Set(K&& key, V&& newValue = V{})
+	//-----------------------------------------------------------------------------
+	{
+		auto range = equal_range(key);
+		if (range.first != range.second)
+		{
+			auto ret = begin() + (&*range.first - m_Storage.data());
+
+			for (auto it = range.first; it != range.second; ++it)
+			{
+				// we cannot forward as we may have multiple values to insert to
+				it->second = newValue;
+			}
+
+			return ret;
+		}
+		else
+		{
+			return insert(value_type(std::forward<K>(key), std::forward<V>(newValue))).first;
+		}
+	}
+
+	//-----------------------------------------------------------------------------
+	// perfect forwarding and SFINAE for unique instances
+	/// Set a new value for an existing key. If the key is not existing it is created.
+	template <class K, class V1, class V2, bool Uq = Unique,
+			typename std::enable_if<Uq == true, int>::type = 0>
+	iterator Set(K&& key, V1&& value, V2&& newValue)
+	//-----------------------------------------------------------------------------
+	{
+		// this is actually the same as a Set(key, newValue) as we can only have one
+		// record with this key
+		return insert_or_assign(std::forward<K>(key), std::forward<V2>(newValue)).first;
+	}
+
+	//-----------------------------------------------------------------------------
+	// perfect forwarding and SFINAE for non-unique instances
+	/// Set a new value for existing key/value pairs. If the key/value pair is not existing it is created.
+	template <class K, class V1, class V2, bool Uq = Unique,
+			typename std::enable_if<Uq == false, int>::type = 0>
+	iterator Set(K&& key, V1&& value, V2&& newValue)
+	//-----------------------------------------------------------------------------
+	{
+		auto ret   = end();
+		auto range = equal_range(key);
+
+		for (auto it = range.first; it != range.second; ++it)
+		{
+			if (it->second == value)
+			{
+				// we cannot forward as we may have multiple values to insert to
+				it->second = newValue;
+
+				if (ret == end())
+				{
+					ret = begin() + (&*it - m_Storage.data());
+				}
+			}
+		}
+
+		if (ret != end())
+		{
+			// returns an iterator on the first element replaced
+			return ret;
+		}
+		else
+		{
+			return insert(value_type(std::forward<K>(key), std::forward<V2>(newValue))).first;
+		}
+	}
+
+	//-----------------------------------------------------------------------------
+	// perfect forwarding
+	/// Add a new Key/Value pair. If the key is already existing, its value is replaced.
+	template<class K, class V = Value>
+	iterator Add(K&& key, V&& value = V{})
+	//-----------------------------------------------------------------------------
+	{
+		return insert_or_assign(std::forward<K>(key), std::forward<V>(value)).first;
+	}
+
+	//-----------------------------------------------------------------------------
+	/// remove a Key/Value pair with a given key. Returns count of removed elements.
+	template<class K>
+	size_t Remove(const K& key)
+	//-----------------------------------------------------------------------------
+	{
+		return erase(key);
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Returns value of the element with the given key. Returns default constructed
+	/// value if not found.
+	template<class K>
+	DEKAF2_NODISCARD
+	Value& Get(const K& key)
+	//-----------------------------------------------------------------------------
+	{
+		auto iPos = FindPos(key);
+		if (iPos != npos)
+		{
+			return m_Storage[iPos].second;
+		}
+		return s_EmptyElement_v.second;
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Returns value of the element with the given key. Returns default constructed
+	/// value if not found.
+	template<class K>
+	DEKAF2_NODISCARD
+	const Value& Get(const K& key) const
+	//-----------------------------------------------------------------------------
+	{
+		auto iPos = FindPos(key);
+		if (iPos != npos)
+		{
+			return m_Storage[iPos].second;
+		}
+		return s_EmptyElement.second;
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Returns iterator range of the elements with the given key.
+	template<class K>
+	DEKAF2_NODISCARD
+	const_range GetMulti(const K& key) const
+	//-----------------------------------------------------------------------------
+	{
+		return equal_range(key);
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Returns count of elements with the given key.
+	template<class K>
+	DEKAF2_NODISCARD
+	size_t Count(const K& key) const
+	//-----------------------------------------------------------------------------
+	{
+		return count(key);
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Returns true if at least one element with the given key exists.
+	template<class K>
+	DEKAF2_NODISCARD
+	bool Contains(const K& key) const
+	//-----------------------------------------------------------------------------
+	{
+		return contains(key);
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Returns true if a key appears multiple times.
+	template<class K>
+	DEKAF2_NODISCARD
+	bool IsMulti(const K& key) const
+	//-----------------------------------------------------------------------------
+	{
+		auto Range = equal_range(key);
+		return Range.first != Range.second && ++Range.first != Range.second;
+	}
+
+	//-----------------------------------------------------------------------------
+	// SFINAE, only active for Sequential instances
+	/// Gets the element at index position. Returns empty element if out of range.
+	template<bool Seq = Sequential,
+			typename std::enable_if<Seq == true, int>::type = 0>
+	DEKAF2_NODISCARD
+	const Element& at(size_t index) const
+	//-----------------------------------------------------------------------------
+	{
+		if (index < size())
+		{
+			return m_Storage[index];
+		}
+		else
+		{
+			kWarning("called for index {}, which is out of range [0,{})", index, size());
+			return s_EmptyElement;
+		}
+	}
+
+	//-----------------------------------------------------------------------------
+	// SFINAE, only active for non-integral Sequential instances
+	/// Gets the element at index position. Returns empty element if out of range.
+	template<class T = Key, bool Seq = Sequential,
+			typename std::enable_if<!std::is_integral<T>::value && Seq == true, int>::type = 0>
+	DEKAF2_NODISCARD
+	const Element& operator[](size_t index) const
+	//-----------------------------------------------------------------------------
+	{
+		return at(index);
+	}
+
+	//-----------------------------------------------------------------------------
+	// SFINAE, only active for non-integral K, or if the Key is integral
+	/// Gets the value with the given key. Returns empty value if not found.
+	template<class K, class T = Key,
+			typename std::enable_if<std::is_integral<T>::value || !std::is_integral<K>::value, int>::type = 0>
+	DEKAF2_NODISCARD
+	const Value& operator[](const K& key) const
+	//-----------------------------------------------------------------------------
+	{
+		return Get(key);
+	}
+
+	//-----------------------------------------------------------------------------
+	// SFINAE && perfect forwarding, only active for non-integral K, or if the Key is integral
+	/// Gets the element with the given key. Returns empty element if not found.
+	template<class K, class T = Key,
+			typename std::enable_if<std::is_integral<T>::value || !std::is_integral<K>::value, int>::type = 0>
+	DEKAF2_NODISCARD
+	Value& operator[](K&& key)
+	//-----------------------------------------------------------------------------
+	{
+		auto iPos = FindPos(key);
+		if (iPos != npos)
+		{
+			return m_Storage[iPos].second;
+		}
+		else
+		{
+			// create new element and return it
+			return Append(value_type(std::forward<K>(key), Value{}))->second;
+		}
+	}
+
+	//-----------------------------------------------------------------------------
+	/// test if the container is non-empty.
+	explicit operator bool() const noexcept
+	//-----------------------------------------------------------------------------
+	{
+		return !empty();
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Inserts one element at the end.
+	template<class E>
+	void push_back(E&& element)
+	//-----------------------------------------------------------------------------
+	{
+		insert(std::forward<E>(element));
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Inserts one key / value pair at the end.
+	template<class K, class V>
+	void push_back(K&& key, V&& value)
+	//-----------------------------------------------------------------------------
+	{
+		insert(value_type(std::forward<K>(key), std::forward<V>(value)));
+	}
+
+//----------
+protected:
+//----------
+
+	//-----------------------------------------------------------------------------
+	static value_type&& Convert(value_type&& value)
+	//-----------------------------------------------------------------------------
+	{
+		return std::move(value);
+	}
+
+	//-----------------------------------------------------------------------------
+	template<class ValueType>
+	static value_type Convert(ValueType&& value)
+	//-----------------------------------------------------------------------------
+	{
+		return value_type(std::forward<ValueType>(value));
+	}
+
+	//-----------------------------------------------------------------------------
+	/// a transparent std::hash<Key> hashes a different lookup type as is, else it gets
+	/// converted into the key type - the comparison converts only on equal hashes
+	template<class K>
+	static std::size_t HashOf(const K& key)
+	//-----------------------------------------------------------------------------
+	{
+		return detail::transparent_hash<Key>()(key);
+	}
+
+	//-----------------------------------------------------------------------------
+	/// returns the position of the last inserted element with key, or npos
+	template<class K>
+	std::size_t FindPos(const K& key) const
+	//-----------------------------------------------------------------------------
+	{
+		if (m_Storage.empty())
+		{
+			return npos;
+		}
+
+		auto iHash = HashOf(key);
+
+		if (m_Buckets.empty())
+		{
+			for (auto i = m_Hashes.size(); i-- > 0;)
+			{
+				if (m_Hashes[i] == iHash && m_Storage[i].first == key)
+				{
+					return i;
+				}
+			}
+		}
+		else
+		{
+			for (auto i = m_Buckets[iHash & (m_Buckets.size() - 1)]; i != noslot; i = m_Prev[i])
+			{
+				if (m_Hashes[i] == iHash && m_Storage[i].first == key)
+				{
+					return i;
+				}
+			}
+		}
+
+		return npos;
+	}
+
+	//-----------------------------------------------------------------------------
+	/// returns the position of the previous element with the same key as the one at iPos, or size()
+	std::size_t PrevEqual(std::size_t iPos) const
+	//-----------------------------------------------------------------------------
+	{
+		const auto& key   = m_Storage[iPos].first;
+		auto        iHash = m_Hashes[iPos];
+
+		if (m_Buckets.empty())
+		{
+			for (auto i = iPos; i-- > 0;)
+			{
+				if (m_Hashes[i] == iHash && m_Storage[i].first == key)
+				{
+					return i;
+				}
+			}
+		}
+		else
+		{
+			for (auto i = m_Prev[iPos]; i != noslot; i = m_Prev[i])
+			{
+				if (m_Hashes[i] == iHash && m_Storage[i].first == key)
+				{
+					return i;
+				}
+			}
+		}
+
+		return size();
+	}
+
+	//-----------------------------------------------------------------------------
+	std::pair<iterator, bool> InsertUnique(value_type&& value)
+	//-----------------------------------------------------------------------------
+	{
+		auto iPos = FindPos(value.first);
+
+		if (iPos != npos)
+		{
+			return { begin() + iPos, false };
+		}
+
+		return { Append(std::move(value)), true };
+	}
+
+	//-----------------------------------------------------------------------------
+	/// adds an element at the end, and to the hashed index if there is one
+	iterator Append(value_type&& value)
+	//-----------------------------------------------------------------------------
+	{
+		if (m_Storage.capacity() == 0)
+		{
+			m_Storage.reserve(iMaxLinear);
+			m_Hashes.reserve(iMaxLinear);
+		}
+
+		m_Hashes.push_back(HashOf(value.first));
+
+		DEKAF2_TRY
+		{
+			m_Storage.push_back(std::move(value));
+		}
+		DEKAF2_CATCH (...)
+		{
+			m_Hashes.pop_back();
+			// unlike 'throw;' this also compiles without exception support
+			std::rethrow_exception(std::current_exception());
+		}
+
+		auto iPos = size() - 1;
+
+		if (m_Buckets.empty())
+		{
+			if (size() > iMaxLinear)
+			{
+				RebuildIndex();
+			}
+		}
+		else if (size() > m_Buckets.size())
+		{
+			RebuildIndex();
+		}
+		else
+		{
+			Link(iPos);
+		}
+
+		return begin() + iPos;
+	}
+
+	//-----------------------------------------------------------------------------
+	/// makes the element at iPos the last one in the chain of its bucket
+	void Link(std::size_t iPos)
+	//-----------------------------------------------------------------------------
+	{
+		auto& iLast = m_Buckets[m_Hashes[iPos] & (m_Buckets.size() - 1)];
+
+		if (m_Prev.size() <= iPos)
+		{
+			m_Prev.resize(iPos + 1);
+		}
+
+		m_Prev[iPos] = iLast;
+		iLast        = static_cast<uint32_t>(iPos);
+	}
+
+	//-----------------------------------------------------------------------------
+	/// builds the hashed index for more than iMaxLinear elements, or removes it
+	void RebuildIndex()
+	//-----------------------------------------------------------------------------
+	{
+		m_Buckets.clear();
+		m_Prev.clear();
+
+		if (size() > iMaxLinear)
+		{
+			// a load factor of at most 1/2 right after the rebuild
+			m_Buckets.resize(kBitCeil(size() * 2), noslot);
+			m_Prev.reserve(m_Buckets.size());
+
+			for (std::size_t i = 0; i < size(); ++i)
+			{
+				Link(i);
+			}
+		}
+	}
+
+}; // KSmallProps
+
+template<class Key, class Value, bool Sequential, bool Unique, std::size_t iMaxLinear>
+const typename KSmallProps<Key, Value, Sequential, Unique, iMaxLinear>::Element
+KSmallProps<Key, Value, Sequential, Unique, iMaxLinear>::s_EmptyElement = Element();
+
+template<class Key, class Value, bool Sequential, bool Unique, std::size_t iMaxLinear>
+typename KSmallProps<Key, Value, Sequential, Unique, iMaxLinear>::Element
+KSmallProps<Key, Value, Sequential, Unique, iMaxLinear>::s_EmptyElement_v = Element();
+
 class KString;
 
 extern template class KProps<KString, KString, /*order-matters=*/false, /*unique-keys=*/true >;
 extern template class KProps<KString, KString, /*order-matters=*/true,  /*unique-keys=*/true >;
 extern template class KProps<KString, KString, /*order-matters=*/false, /*unique-keys=*/false>;
 extern template class KProps<KString, KString, /*order-matters=*/true,  /*unique-keys=*/false>;
+extern template class KSmallProps<KString, KString, /*order-matters=*/true, /*unique-keys=*/false>;
 
 
 /// @}
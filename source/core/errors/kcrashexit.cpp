@@ -78,6 +78,9 @@ void kCrashExitExt (int iSignalNum, siginfo_t* siginfo, void* context)
 	// switch automatic backtracing off
 	KLog::getInstance().SetBackTraceLevel(-100);
 
+	// write out what the asynchronous logging still holds, and log synchronously from here on
+	KLog::getInstance().FlushOnCrash();
+
 	switch (iSignalNum)
 	{
 #ifdef DEKAF2_IS_UNIX
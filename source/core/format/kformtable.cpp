@@ -352,11 +352,11 @@ void KFormTable::PrintBottom()
 			break;
 
 			case Style::JSON:
-				// check if we have to dump the json into an output stream
-				if (m_JsonOut && m_JsonTemp)
+				// close the array we streamed into the output
+				if (!m_JsonOut)
 				{
-					if (m_Out) m_Out->Write(m_JsonOut->dump());
-					*m_JsonOut = KJSON::array();
+					Print(m_bJsonArrayOpen ? "]" : "[]");
+					m_bJsonArrayOpen = false;
 				}
 				break;
 
@@ -609,7 +609,6 @@ void KFormTable::PrintColumnInt(bool bIsNumber, KStringView sText, ColumnRendere
 	{
 		case Style::JSON:
 		case Style::NDJSON:
-			kAssert(m_Style == Style::NDJSON || m_JsonOut, "no JSON pointer");
 			if (m_bHaveColHeaders)
 			{
 				if (!m_iColumn)
@@ -1027,6 +1026,15 @@ void KFormTable::PrintNextRow()
 						if (m_JsonOut->empty()) *m_JsonOut = KJSON::array();
 						m_JsonOut->push_back(std::move(m_JsonRow));
 					}
+					else
+					{
+						// print the row right away as the next array element, so that
+						// memory use does not grow with the count of rows
+						Print(m_bJsonArrayOpen ? "," : "[");
+						Print(m_JsonRow.dump());
+						m_JsonRow = KJSON();
+						m_bJsonArrayOpen = true;
+					}
 				}
 				break;
 
@@ -1261,24 +1269,15 @@ void KFormTable::SetStyle(Style Style)
 			}
 			break;
 
-		case Style::JSON:
-			if (!m_JsonOut)
-			{
-				if (!m_JsonTemp)
-				{
-					m_JsonTemp = std::make_unique<KJSON>();
-				}
-				m_JsonOut = m_JsonTemp.get();
-			}
-			break;
-
 		case Style::HTML:
 		case Style::Markdown:
 		case Style::Spaced:
 		case Style::Vertical:
+		case Style::JSON:
 		case Style::NDJSON:
-			// NDJSON builds each row's object on the fly and writes it straight to the
-			// output stream, so it needs neither a KCSV nor a JSON accumulator
+			// without a JSON output object, JSON and NDJSON build each row's object on
+			// the fly and write it straight to the output stream, so they need neither
+			// a KCSV nor a JSON accumulator
 			break;
 	}
 
@@ -1411,6 +1410,41 @@ bool KFormTable::IsKnownStyle(KStringView sStyle)
 
 } // IsKnownStyle
 
+//-----------------------------------------------------------------------------
+KStringViewZ KFormTable::GetMIMEType(Style Style)
+//-----------------------------------------------------------------------------
+{
+	switch (Style)
+	{
+		case Style::HTML:
+			return "text/html; charset=UTF-8";
+
+		case Style::JSON:
+			return "application/json";
+
+		case Style::NDJSON:
+			return "application/x-ndjson";
+
+		case Style::CSV:
+			return "text/csv; charset=UTF-8";
+
+		case Style::Markdown:
+			return "text/markdown; charset=UTF-8";
+
+		case Style::ASCII:
+		case Style::Bold:
+		case Style::Thin:
+		case Style::Double:
+		case Style::Rounded:
+		case Style::Vertical:
+		case Style::Spaced:
+			break;
+	}
+
+	return "text/plain; charset=UTF-8";
+
+} // GetMIMEType
+
 //-----------------------------------------------------------------------------
 KFormTable::StyleDefs KFormTable::GetStyles()
 //-----------------------------------------------------------------------------
@@ -399,6 +399,10 @@ public:
 	DEKAF2_NODISCARD
 	static bool IsKnownStyle(KStringView sStyle);
 
+	/// Returns the MIME type of the output of a style, e.g. to set the Content-Type of a HTTP response
+	DEKAF2_NODISCARD
+	static KStringViewZ GetMIMEType(Style Style);
+
 	/// Describes one supported style name, its enum value, a short description, and whether it is an alias
 	struct StyleDef
 	{
@@ -452,7 +456,6 @@ private:
 
 	std::unique_ptr<KOutStringStream> m_OutStringStream;
 	KOutStream*                       m_Out { &kGetNullOutStream() };
-	std::unique_ptr<KJSON>            m_JsonTemp;
 	KJSON*                            m_JsonOut { nullptr };
 	KJSON                             m_JsonRow;
 	std::unique_ptr<KCSV>             m_CSV;
@@ -468,6 +471,7 @@ private:
 	BoxChars  m_BoxChars;
 	Style     m_Style            { Style::ASCII };
 	bool      m_bHadTopPrinted   { false };
+	bool      m_bJsonArrayOpen   { false };
 	bool      m_bGetExtents      { false };
 	bool      m_bPrintHeader     { true  };
 	bool      m_bHaveColHeaders  { false };
@@ -443,10 +443,16 @@ pid_t Dekaf::Fork()
 		m_Timer->Pause();
 	}
 
+	// write out the asynchronous log, and keep other threads from holding the log
+	// mutex while we fork
+	KLog::getInstance().PrepareFork();
+
 	if ((pid = fork()))
 	{
 		// parent
 
+		KLog::getInstance().FinishFork(false);
+
 		kDebug(2, "new pid: {}", pid);
 
 		// resume the timer if it had been running before
@@ -460,6 +466,9 @@ pid_t Dekaf::Fork()
 
 	// child
 
+	// the asynchronous log writer thread is gone, log synchronously
+	KLog::getInstance().FinishFork(true);
+
 	// block all signals before we start the timer
 	kBlockAllSignals();
 
@@ -0,0 +1,331 @@
+/*
+//
+// DEKAF(tm): Lighter, Faster, Smarter(tm)
+//
+// Copyright (c) 2026, Ridgeware, Inc.
+//
+// +-------------------------------------------------------------------------+
+// | /\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\|
+// |/+---------------------------------------------------------------------+/|
+// |/|                                                                     |/|
+// |\|  ** THIS NOTICE MUST NOT BE REMOVED FROM THE SOURCE CODE MODULE **  |\|
+// |/|                                                                     |/|
+// |\|   OPEN SOURCE LICENSE                                               |\|
+// |/|                                                                     |/|
+// |\|   Permission is hereby granted, free of charge, to any person       |\|
+// |/|   obtaining a copy of this software and associated                  |/|
+// |\|   documentation files (the "Software"), to deal in the              |\|
+// |/|   Software without restriction, including without limitation        |/|
+// |\|   the rights to use, copy, modify, merge, publish,                  |\|
+// |/|   distribute, sublicense, and/or sell copies of the Software,       |/|
+// |\|   and to permit persons to whom the Software is furnished to        |\|
+// |/|   do so, subject to the following conditions:                       |/|
+// |\|                                                                     |\|
+// |/|   The above copyright notice and this permission notice shall       |/|
+// |\|   be included in all copies or substantial portions of the          |\|
+// |/|   Software.                                                         |/|
+// |\|                                                                     |\|
+// |/|   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY         |/|
+// |\|   KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE        |\|
+// |/|   WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR           |/|
+// |\|   PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS        |\|
+// |/|   OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR          |/|
+// |\|   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR        |\|
+// |/|   OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE         |/|
+// |\|   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.            |\|
+// |/|                                                                     |/|
+// |/+---------------------------------------------------------------------+/|
+// |\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/ |
+// +-------------------------------------------------------------------------+
+//
+*/
+
+#include <dekaf2/core/logging/bits/klogasync.h>
+
+#ifdef DEKAF2_WITH_KLOG
+
+#include <cstdint>
+
+DEKAF2_NAMESPACE_BEGIN
+
+//---------------------------------------------------------------------------
+KLogAsync::KLogAsync(std::size_t iQueueSize, bool bBlockWhenFull, Writer Write)
+//---------------------------------------------------------------------------
+: m_Write(std::move(Write))
+, m_bBlockWhenFull(bBlockWhenFull)
+{
+	std::size_t iCapacity { 2 };
+
+	while (iCapacity < iQueueSize)
+	{
+		iCapacity <<= 1;
+	}
+
+	m_iMask  = iCapacity - 1;
+	m_Cells  = std::make_unique<Cell[]>(iCapacity);
+
+	for (std::size_t i = 0; i < iCapacity; ++i)
+	{
+		m_Cells[i].iSequence.store(i, std::memory_order_relaxed);
+	}
+
+	m_Thread = std::thread(&KLogAsync::Run, this);
+
+} // ctor
+
+//---------------------------------------------------------------------------
+KLogAsync::~KLogAsync()
+//---------------------------------------------------------------------------
+{
+	m_bStop = true;
+
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		m_Wakeup.notify_one();
+	}
+
+	if (m_Thread.joinable())
+	{
+		m_Thread.join();
+	}
+
+} // dtor
+
+//---------------------------------------------------------------------------
+bool KLogAsync::TryPush(int iLevel, bool bIsMultiline, KStringView sLine)
+//---------------------------------------------------------------------------
+{
+	auto  iPos = m_iEnqueuePos.load(std::memory_order_relaxed);
+	Cell* cell;
+
+	for (;;)
+	{
+		cell = &m_Cells[iPos & m_iMask];
+
+		auto iSequence = cell->iSequence.load(std::memory_order_acquire);
+		auto iDiff     = static_cast<std::intptr_t>(iSequence) - static_cast<std::intptr_t>(iPos);
+
+		if (iDiff == 0)
+		{
+			// the cell is free - try to claim it
+			if (m_iEnqueuePos.compare_exchange_weak(iPos, iPos + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (iDiff < 0)
+		{
+			// the queue is full
+			return false;
+		}
+		else
+		{
+			// another producer claimed this cell
+			iPos = m_iEnqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+
+	cell->Rec.iLevel       = iLevel;
+	cell->Rec.bIsMultiline = bIsMultiline;
+	// assign() reuses the capacity the cell's string got from earlier records
+	cell->Rec.sLine.assign(sLine.data(), sLine.size());
+	cell->iSequence.store(iPos + 1, std::memory_order_release);
+
+	return true;
+
+} // TryPush
+
+//---------------------------------------------------------------------------
+void KLogAsync::WakeConsumer()
+//---------------------------------------------------------------------------
+{
+	// pairs with the fence in Run() - either the consumer sees the new record,
+	// or we see it sleeping
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	if (m_bSleeping.load(std::memory_order_relaxed))
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		m_Wakeup.notify_one();
+	}
+
+} // WakeConsumer
+
+//---------------------------------------------------------------------------
+bool KLogAsync::Push(int iLevel, bool bIsMultiline, KStringView sLine)
+//---------------------------------------------------------------------------
+{
+	if (DEKAF2_LIKELY(TryPush(iLevel, bIsMultiline, sLine)))
+	{
+		WakeConsumer();
+		return true;
+	}
+
+	// the queue is full - the consumer thread itself must never wait for free space
+	while (m_bBlockWhenFull && !m_bStop && !IsConsumerThread())
+	{
+		WakeConsumer();
+
+		std::this_thread::sleep_for(chrono::microseconds(50));
+
+		if (TryPush(iLevel, bIsMultiline, sLine))
+		{
+			WakeConsumer();
+			return true;
+		}
+	}
+
+	m_iDropped.fetch_add(1, std::memory_order_relaxed);
+
+	return false;
+
+} // Push
+
+//---------------------------------------------------------------------------
+bool KLogAsync::HasRecord() const
+//---------------------------------------------------------------------------
+{
+	return m_Cells[m_iDequeuePos & m_iMask].iSequence.load(std::memory_order_acquire) == m_iDequeuePos + 1;
+
+} // HasRecord
+
+//---------------------------------------------------------------------------
+std::size_t KLogAsync::PopBatch(std::vector<Record>& Records)
+//---------------------------------------------------------------------------
+{
+	std::size_t iCount { 0 };
+
+	while (iCount < s_iMaxBatch && HasRecord())
+	{
+		auto& cell = m_Cells[m_iDequeuePos & m_iMask];
+
+		if (Records.size() <= iCount)
+		{
+			Records.emplace_back();
+		}
+
+		auto& Rec = Records[iCount++];
+
+		Rec.iLevel       = cell.Rec.iLevel;
+		Rec.bIsMultiline = cell.Rec.bIsMultiline;
+		// swap, so that the string buffers keep circulating instead of being reallocated
+		Rec.sLine.swap(cell.Rec.sLine);
+
+		// release the cell for the next round
+		cell.iSequence.store(m_iDequeuePos + m_iMask + 1, std::memory_order_release);
+		++m_iDequeuePos;
+	}
+
+	return iCount;
+
+} // PopBatch
+
+//---------------------------------------------------------------------------
+void KLogAsync::Run()
+//---------------------------------------------------------------------------
+{
+	std::vector<Record> Records;
+	Records.reserve(s_iMaxBatch);
+
+	for (;;)
+	{
+		auto iCount = PopBatch(Records);
+
+		if (iCount)
+		{
+			m_Write(Records.data(), iCount);
+
+			m_iWritten.fetch_add(iCount, std::memory_order_seq_cst);
+
+			if (m_iFlushWaiters.load(std::memory_order_seq_cst))
+			{
+				std::lock_guard<std::mutex> Lock(m_Mutex);
+				m_Written.notify_all();
+			}
+
+			continue;
+		}
+
+		if (m_bStop)
+		{
+			break;
+		}
+
+		std::unique_lock<std::mutex> Lock(m_Mutex);
+
+		m_bSleeping.store(true, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		if (!HasRecord() && !m_bStop)
+		{
+			// the timeout only covers for a missed wakeup
+			m_Wakeup.wait_for(Lock, chrono::milliseconds(100));
+		}
+
+		m_bSleeping.store(false, std::memory_order_relaxed);
+	}
+
+} // Run
+
+//---------------------------------------------------------------------------
+bool KLogAsync::Flush(KDuration Timeout)
+//---------------------------------------------------------------------------
+{
+	if (IsConsumerThread())
+	{
+		// we would wait for ourselves
+		return false;
+	}
+
+	// every claimed position will be written, but not the dropped records
+	auto iTarget = m_iEnqueuePos.load(std::memory_order_seq_cst);
+
+	m_iFlushWaiters.fetch_add(1, std::memory_order_seq_cst);
+
+	std::unique_lock<std::mutex> Lock(m_Mutex);
+
+	m_Wakeup.notify_one();
+
+	bool bFlushed = m_Written.wait_for(Lock, Timeout, [this, iTarget]()
+	{
+		return m_iWritten.load(std::memory_order_seq_cst) >= iTarget;
+	});
+
+	m_iFlushWaiters.fetch_sub(1, std::memory_order_seq_cst);
+
+	return bFlushed;
+
+} // Flush
+
+//---------------------------------------------------------------------------
+bool KLogAsync::FlushOnCrash(KDuration Timeout)
+//---------------------------------------------------------------------------
+{
+	if (IsConsumerThread())
+	{
+		return false;
+	}
+
+	auto iTarget = m_iEnqueuePos.load(std::memory_order_seq_cst);
+
+	// the steady clock and sleep_for() only use clock_gettime() and nanosleep(),
+	// which are async-signal-safe
+	KStopTime Timer;
+
+	while (m_iWritten.load(std::memory_order_seq_cst) < iTarget)
+	{
+		if (Timer.elapsed() >= Timeout)
+		{
+			return false;
+		}
+
+		std::this_thread::sleep_for(chrono::milliseconds(1));
+	}
+
+	return true;
+
+} // FlushOnCrash
+
+DEKAF2_NAMESPACE_END
+
+#endif // of DEKAF2_WITH_KLOG
@@ -0,0 +1,164 @@
+/*
+//
+// DEKAF(tm): Lighter, Faster, Smarter(tm)
+//
+// Copyright (c) 2026, Ridgeware, Inc.
+//
+// +-------------------------------------------------------------------------+
+// | /\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\|
+// |/+---------------------------------------------------------------------+/|
+// |/|                                                                     |/|
+// |\|  ** THIS NOTICE MUST NOT BE REMOVED FROM THE SOURCE CODE MODULE **  |\|
+// |/|                                                                     |/|
+// |\|   OPEN SOURCE LICENSE                                               |\|
+// |/|                                                                     |/|
+// |\|   Permission is hereby granted, free of charge, to any person       |\|
+// |/|   obtaining a copy of this software and associated                  |/|
+// |\|   documentation files (the "Software"), to deal in the              |\|
+// |/|   Software without restriction, including without limitation        |/|
+// |\|   the rights to use, copy, modify, merge, publish,                  |\|
+// |/|   distribute, sublicense, and/or sell copies of the Software,       |/|
+// |\|   and to permit persons to whom the Software is furnished to        |\|
+// |/|   do so, subject to the following conditions:                       |/|
+// |\|                                                                     |\|
+// |/|   The above copyright notice and this permission notice shall       |/|
+// |\|   be included in all copies or substantial portions of the          |\|
+// |/|   Software.                                                         |/|
+// |\|                                                                     |\|
+// |/|   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY         |/|
+// |\|   KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE        |\|
+// |/|   WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR           |/|
+// |\|   PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS        |\|
+// |/|   OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR          |/|
+// |\|   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR        |\|
+// |/|   OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE         |/|
+// |\|   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.            |\|
+// |/|                                                                     |/|
+// |/+---------------------------------------------------------------------+/|
+// |\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/ |
+// +-------------------------------------------------------------------------+
+//
+*/
+
+#pragma once
+
+/// @file klogasync.h
+/// Asynchronous record queue for the logging framework
+
+#include <dekaf2/core/init/kdefinitions.h>
+
+#ifdef DEKAF2_WITH_KLOG
+#include <dekaf2/core/strings/kstring.h>
+#include <dekaf2/core/strings/kstringview.h>
+#include <dekaf2/time/duration/kduration.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+DEKAF2_NAMESPACE_BEGIN
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+/// Bounded multi producer / single consumer queue of serialized log records,
+/// drained by a background thread that hands the records in batches to a
+/// write callback. Producers never take a lock unless the consumer sleeps.
+class DEKAF2_PUBLIC KLogAsync
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+{
+
+//----------
+public:
+//----------
+
+	struct Record
+	{
+		int     iLevel       { 0 };
+		bool    bIsMultiline { false };
+		KString sLine;
+	};
+
+	/// the write callback, called from the consumer thread with up to 256 records at a time
+	using Writer = std::function<void(const Record* Records, std::size_t iCount)>;
+
+	/// @param iQueueSize the count of records the queue can hold, rounded up to the next power of two
+	/// @param bBlockWhenFull if true, producers wait for free space, else the record is dropped and counted
+	/// @param Write the callback that receives the batches
+	KLogAsync(std::size_t iQueueSize, bool bBlockWhenFull, Writer Write);
+	~KLogAsync();
+
+	KLogAsync(const KLogAsync&) = delete;
+	KLogAsync& operator=(const KLogAsync&) = delete;
+
+	/// push a record into the queue - returns false if the record was dropped
+	bool Push(int iLevel, bool bIsMultiline, KStringView sLine);
+
+	/// wait until all records pushed before the call have been written, or until the timeout
+	/// expired - returns false on timeout
+	bool Flush(KDuration Timeout = chrono::seconds(5));
+
+	/// like Flush(), but safe to be called from a signal handler: takes no lock and polls
+	/// until the records have been written (the consumer wakes up by itself at least every
+	/// 100 milliseconds), or until the timeout expired - returns false on timeout
+	bool FlushOnCrash(KDuration Timeout);
+
+	/// set the overflow policy
+	void SetBlockWhenFull(bool bYesNo) { m_bBlockWhenFull = bYesNo; }
+
+	/// returns the count of records dropped since construction
+	DEKAF2_NODISCARD
+	std::size_t GetDropped() const { return m_iDropped.load(std::memory_order_relaxed); }
+
+	/// returns the capacity of the queue
+	DEKAF2_NODISCARD
+	std::size_t GetCapacity() const { return m_iMask + 1; }
+
+	/// returns true if called from the consumer thread
+	DEKAF2_NODISCARD
+	bool IsConsumerThread() const { return std::this_thread::get_id() == m_Thread.get_id(); }
+
+//----------
+private:
+//----------
+
+	struct Cell
+	{
+		std::atomic<std::size_t> iSequence;
+		Record                   Rec;
+	};
+
+	bool TryPush(int iLevel, bool bIsMultiline, KStringView sLine);
+	std::size_t PopBatch(std::vector<Record>& Records);
+	bool HasRecord() const;
+	void WakeConsumer();
+	void Run();
+
+	static constexpr std::size_t s_iMaxBatch = 256;
+
+	std::unique_ptr<Cell[]>  m_Cells;
+	std::size_t              m_iMask;
+	Writer                   m_Write;
+
+	// producers share the enqueue position, the consumer owns the dequeue position
+	alignas(64) std::atomic<std::size_t> m_iEnqueuePos  { 0 };
+	alignas(64) std::size_t              m_iDequeuePos  { 0 };
+
+	alignas(64) std::atomic<std::size_t> m_iWritten { 0 };
+	std::atomic<std::size_t> m_iFlushWaiters { 0 };
+	std::atomic<std::size_t> m_iDropped      { 0 };
+	std::atomic<bool>        m_bSleeping     { false };
+	std::atomic<bool>        m_bStop         { false };
+	std::atomic<bool>        m_bBlockWhenFull;
+
+	std::mutex               m_Mutex;
+	std::condition_variable  m_Wakeup;
+	std::condition_variable  m_Written;
+	std::thread              m_Thread;
+
+}; // KLogAsync
+
+DEKAF2_NAMESPACE_END
+
+#endif // of DEKAF2_WITH_KLOG
@@ -48,6 +48,7 @@
 
 #include <dekaf2/core/logging/bits/klogwriter.h>
 #include <dekaf2/core/logging/bits/klogserializer.h>
+#include <dekaf2/core/logging/bits/klogasync.h>
 #include <dekaf2/core/init/dekaf2.h>
 #include <dekaf2/core/strings/kstring.h>
 #include <dekaf2/system/os/kgetruntimestack.h>
@@ -56,6 +57,7 @@
 #include <dekaf2/system/filesystem/kfilesystem.h>
 #include <dekaf2/http/server/kcgistream.h>
 #include <mutex>
+#include <new>
 #include <iostream>
 
 #ifdef DEKAF2_HAS_SYSLOG
@@ -87,6 +89,8 @@ thread_local bool KLog::s_bPrintTimeStampOnClose { false };
 #endif
 thread_local bool KLog::s_bPerThreadEGrep { false };
 thread_local bool KLog::PreventRecursion::s_bCalledFromInsideKlog { false };
+thread_local std::unique_ptr<KLogSerializer> KLog::s_AsyncSerializer;
+thread_local uint32_t KLog::s_iAsyncSerializerGeneration { 0 };
 
 // do not initialize this static var - it risks to override a value set by KLog()'s
 // initialization before..
@@ -180,6 +184,11 @@ KLog::~KLog()
 	// we need the dtor in the cpp, as otherwise the compiler would not have
 	// access to KLogWriter / KLogSerializer type information..
 
+	// stop the asynchronous writer while the log writer is still alive - this
+	// writes out all pending log lines
+	m_bAsync = false;
+	m_Async.reset();
+
 } // dtor
 
 //---------------------------------------------------------------------------
@@ -214,6 +223,8 @@ KLog& KLog::SetDefaults()
 
 	m_Traces.clear();
 
+	UpdateHasFilters();
+
 	return *this;
 
 } // SetDefaults
@@ -441,6 +452,8 @@ bool KLog::SetDebugLog(KStringView sLogfile)
 KLog& KLog::SetWriter(std::unique_ptr<KLogWriter> logger)
 //---------------------------------------------------------------------------
 {
+	// the asynchronous writer thread may use the logger concurrently
+	std::lock_guard<std::recursive_mutex> Lock(m_LogMutex);
 	m_Logger = std::move(logger);
 	return *this;
 
@@ -468,7 +481,11 @@ KLog& KLog::SetWriter(Writer writer, KStringViewZ sLogname)
 KLog& KLog::SetSerializer(std::unique_ptr<KLogSerializer> serializer)
 //---------------------------------------------------------------------------
 {
+	std::lock_guard<std::recursive_mutex> Lock(m_LogMutex);
 	m_Serializer = std::move(serializer);
+	// a custom serializer cannot be cloned per thread for asynchronous logging
+	m_iSerializer = -1;
+	++m_iSerializerGeneration;
 	return *this;
 
 } // SetSerializer
@@ -477,7 +494,9 @@ KLog& KLog::SetSerializer(std::unique_ptr<KLogSerializer> serializer)
 KLog& KLog::SetSerializer(Serializer serializer)
 //---------------------------------------------------------------------------
 {
-	return SetSerializer(CreateSerializer(serializer));
+	SetSerializer(CreateSerializer(serializer));
+	m_iSerializer = static_cast<int>(serializer);
+	return *this;
 
 } // SetSerializer
 
@@ -542,13 +561,13 @@ bool KLog::IntOpenLog()
 	if (url.IsHttpURL())
 	{
 		SetWriter(CreateWriter(Writer::HTTP, m_sLogName));
-		SetSerializer(CreateSerializer(Serializer::JSON));
+		SetSerializer(Serializer::JSON);
 	}
 	else if (!url.Port.empty() && !url.Domain.empty())
 	{
 		// this is a simple domain:port TCP connection
 		SetWriter(CreateWriter(Writer::TCP, m_sLogName));
-		SetSerializer(CreateSerializer(Serializer::TTY));
+		SetSerializer(Serializer::TTY);
 	}
 	else
 #endif
@@ -556,7 +575,7 @@ bool KLog::IntOpenLog()
 	if (m_sLogName == SYSLOG)
 	{
 		SetWriter(CreateWriter(Writer::SYSLOG));
-		SetSerializer(CreateSerializer(Serializer::SYSLOG));
+		SetSerializer(Serializer::SYSLOG);
 	}
 	else
 #endif
@@ -575,7 +594,7 @@ bool KLog::IntOpenLog()
 			SetWriter(CreateWriter(Writer::FILE, m_sLogName));
 			m_bLogIsRegularFile = true;
 		}
-		SetSerializer(CreateSerializer(Serializer::TTY));
+		SetSerializer(Serializer::TTY);
 	}
 
 	return m_Logger && m_Logger->Good();
@@ -776,6 +795,7 @@ void KLog::CheckDebugFlag(bool bForce/*=false*/)
 							if (bNewTrace)
 							{
 								m_Traces.push_back(it.second);
+								UpdateHasFilters();
 							}
 						}
 
@@ -814,6 +834,8 @@ KLog& KLog::LogWithGrepExpression(bool bEGrep, bool bInverted, KStringView sGrep
 	m_bInvertedGrep   = bInverted;
 	m_sGrepExpression = sGrepExpression.ToLower();
 
+	UpdateHasFilters();
+
 	return *this;
 
 } // LogWithGrepExpression
@@ -857,12 +879,28 @@ bool KLog::IntDebug(int iLevel, KStringView sFunction, KStringView sMessage)
 		return false;
 	}
 
+	bool bAsync = m_bAsync.load(std::memory_order_acquire);
+
+	if (bAsync)
+	{
+		if (DEKAF2_LIKELY(iLevel <= s_iLogLevel))
+		{
+			IntAsyncDebug(iLevel, sFunction, sMessage);
+		}
+
+		// the per-thread logging below only uses thread local serializers and writers
+		if (DEKAF2_LIKELY(iLevel > s_iThreadLogLevel || !s_PerThreadSerializer || !s_PerThreadWriter))
+		{
+			return true;
+		}
+	}
+
 	// We need a lock if we run in multithreading, as the serializers
 	// have data members. We use a recursive mutex because we want to
 	// protect multiple entry points that eventually call this function.
 	std::lock_guard<std::recursive_mutex> Lock(m_LogMutex);
 
-	if (DEKAF2_LIKELY(iLevel <= s_iLogLevel))
+	if (DEKAF2_LIKELY(iLevel <= s_iLogLevel) && !bAsync)
 	{
 		// this is the regular logging
 
@@ -871,15 +909,17 @@ bool KLog::IntDebug(int iLevel, KStringView sFunction, KStringView sMessage)
 			m_Serializer->Set(iLevel, m_sShortName, m_sPathName, sFunction, sMessage);
 		}
 
+		auto iBackTrace = m_iBackTrace.load(std::memory_order_relaxed);
+
 		// check if we shall print a stacktrace on demand
-		if (iLevel > m_iBackTrace)
+		if (iLevel > iBackTrace)
 		{
 			for (const auto& sTrace : m_Traces)
 			{
 				if (sFunction.contains(sTrace) ||
 					sMessage.contains(sTrace))
 				{
-					iLevel = m_iBackTrace;
+					iLevel = iBackTrace;
 					break;
 				}
 			}
@@ -888,7 +928,7 @@ bool KLog::IntDebug(int iLevel, KStringView sFunction, KStringView sMessage)
 		// need to keep this buffer until the log record is written
 		KString sStack;
 
-		if (iLevel <= m_iBackTrace)
+		if (iLevel <= iBackTrace)
 		{
 			// we can protect the recursion without a mutex, as we
 			// are already protected by a mutex..
@@ -939,6 +979,243 @@ bool KLog::IntDebug(int iLevel, KStringView sFunction, KStringView sMessage)
 
 } // IntDebug
 
+//---------------------------------------------------------------------------
+void KLog::UpdateHasFilters()
+//---------------------------------------------------------------------------
+{
+	// call with the log mutex held
+	m_bHasFilters = !m_Traces.empty() || !m_sGrepExpression.empty();
+
+} // UpdateHasFilters
+
+//---------------------------------------------------------------------------
+KLogSerializer* KLog::GetAsyncSerializer()
+//---------------------------------------------------------------------------
+{
+	auto iSerializer = m_iSerializer.load(std::memory_order_acquire);
+
+	if (iSerializer < 0)
+	{
+		return nullptr;
+	}
+
+	auto iGeneration = m_iSerializerGeneration.load(std::memory_order_acquire);
+
+	if (DEKAF2_UNLIKELY(!s_AsyncSerializer || s_iAsyncSerializerGeneration != iGeneration))
+	{
+		// the serializer type changed since this thread logged the last time
+		s_AsyncSerializer            = CreateSerializer(static_cast<Serializer>(iSerializer));
+		s_iAsyncSerializerGeneration = iGeneration;
+	}
+
+	return s_AsyncSerializer.get();
+
+} // GetAsyncSerializer
+
+//---------------------------------------------------------------------------
+void KLog::IntAsyncDebug(int iLevel, KStringView sFunction, KStringView sMessage)
+//---------------------------------------------------------------------------
+{
+	// the thread local serializer needs no lock, but traces, grep expressions
+	// and custom serializers do
+	std::unique_lock<std::recursive_mutex> Lock(m_LogMutex, std::defer_lock);
+
+	auto Serializer = GetAsyncSerializer();
+
+	if (!Serializer)
+	{
+		Lock.lock();
+		Serializer = m_Serializer.get();
+
+		if (!Serializer)
+		{
+			return;
+		}
+	}
+	else if (m_bHasFilters.load(std::memory_order_relaxed))
+	{
+		Lock.lock();
+	}
+
+	Serializer->Set(iLevel, m_sShortName, m_sPathName, sFunction, sMessage);
+
+	// the level may be changed concurrently, read it only once
+	auto iBackTrace = m_iBackTrace.load(std::memory_order_relaxed);
+
+	if (Lock.owns_lock() && iLevel > iBackTrace)
+	{
+		for (const auto& sTrace : m_Traces)
+		{
+			if (sFunction.contains(sTrace) ||
+				sMessage.contains(sTrace))
+			{
+				iLevel = iBackTrace;
+				break;
+			}
+		}
+	}
+
+	// need to keep this buffer until the log record is serialized
+	KString sStack;
+
+	if (iLevel <= iBackTrace)
+	{
+		// recursion is already prevented by the caller
+		int iSkipFromStack { iLevel == -2 ? 4 : 3 };
+		sStack = kGetBacktrace(iSkipFromStack);
+		Serializer->SetBacktrace(sStack);
+	}
+
+	if (!Lock.owns_lock() || Serializer->Matches(m_bEGrep, m_bInvertedGrep, m_sGrepExpression))
+	{
+		m_Async->Push(iLevel, Serializer->IsMultiline(), Serializer->Get(GetUSecMode()));
+	}
+
+} // IntAsyncDebug
+
+//---------------------------------------------------------------------------
+KLog& KLog::SetAsync(bool bYesNo, std::size_t iQueueSize, AsyncOverflow Overflow)
+//---------------------------------------------------------------------------
+{
+	if (bYesNo)
+	{
+		std::lock_guard<std::recursive_mutex> Lock(m_LogMutex);
+
+		if (!m_Async)
+		{
+			m_Async = std::make_unique<KLogAsync>(iQueueSize, Overflow == AsyncOverflow::Block,
+			                                      [this](const KLogAsync::Record* Records, std::size_t iCount)
+			{
+				// the writers may log themselves - which would be lost in synchronous mode as well
+				PreventRecursion PR;
+
+				std::lock_guard<std::recursive_mutex> Lock(m_LogMutex);
+
+				for (std::size_t i = 0; i < iCount; ++i)
+				{
+					const auto& Record = Records[i];
+
+					if (m_Logger)
+					{
+						m_Logger->Write(Record.iLevel, Record.bIsMultiline, Record.sLine);
+					}
+
+					if (DEKAF2_UNLIKELY(m_Mirror != nullptr))
+					{
+						m_Mirror->Write(Record.iLevel, Record.bIsMultiline, Record.sLine);
+					}
+				}
+			});
+
+			m_bAsyncStarted.store(true, std::memory_order_release);
+		}
+		else
+		{
+			m_Async->SetBlockWhenFull(Overflow == AsyncOverflow::Block);
+		}
+
+		m_bAsync.store(true, std::memory_order_release);
+	}
+	else if (m_bAsync.exchange(false))
+	{
+		// do not hold the log mutex here, the background thread needs it
+		Flush();
+	}
+
+	return *this;
+
+} // SetAsync
+
+//---------------------------------------------------------------------------
+bool KLog::Flush()
+//---------------------------------------------------------------------------
+{
+	if (!m_bAsyncStarted.load(std::memory_order_acquire))
+	{
+		return true;
+	}
+
+	return m_Async->Flush();
+
+} // Flush
+
+//---------------------------------------------------------------------------
+std::size_t KLog::GetDroppedLines() const
+//---------------------------------------------------------------------------
+{
+	if (!m_bAsyncStarted.load(std::memory_order_acquire))
+	{
+		return 0;
+	}
+
+	return m_Async->GetDropped();
+
+} // GetDroppedLines
+
+//---------------------------------------------------------------------------
+void KLog::FlushOnCrash()
+//---------------------------------------------------------------------------
+{
+	if (!m_bAsyncStarted.load(std::memory_order_acquire))
+	{
+		return;
+	}
+
+	// all following log lines, including the crash report, are written synchronously
+	m_bAsync = false;
+
+	// if the background thread itself crashed there is nobody left to write the
+	// queue, and if it hangs in a writer we do not want to wait forever - we are
+	// in a signal handler, so we must not wait on the queue's mutex
+	if (!m_Async->IsConsumerThread())
+	{
+		m_Async->FlushOnCrash(chrono::seconds(2));
+	}
+
+} // FlushOnCrash
+
+//---------------------------------------------------------------------------
+void KLog::PrepareFork()
+//---------------------------------------------------------------------------
+{
+	// the background thread needs the log mutex to write, so flush first
+	if (m_bAsync.load(std::memory_order_acquire))
+	{
+		Flush();
+	}
+
+	m_LogMutex.lock();
+
+} // PrepareFork
+
+//---------------------------------------------------------------------------
+void KLog::FinishFork(bool bIsChild)
+//---------------------------------------------------------------------------
+{
+	if (bIsChild && m_bAsyncStarted.load(std::memory_order_acquire))
+	{
+		// the background thread did not survive the fork, and the queue may still hold
+		// lines that the parent writes - we cannot destroy the queue, as it would try to
+		// join the missing thread and to lock mutexes that may have been locked by other
+		// threads of the parent, so we leave it alone and log synchronously from now on
+		m_bAsync = false;
+		m_bAsyncStarted = false;
+		static_cast<void>(m_Async.release());
+	}
+
+	if (bIsChild)
+	{
+		// the recursive mutex is owned by the thread id of the parent, which the
+		// child cannot unlock - we are the only thread, so simply construct it anew
+		::new (&m_LogMutex) std::recursive_mutex;
+	}
+	else
+	{
+		m_LogMutex.unlock();
+	}
+
+} // FinishFork
+
 //---------------------------------------------------------------------------
 void KLog::IntException(KStringView sWhat, KStringView sFunction, KStringView sClass)
 //---------------------------------------------------------------------------
@@ -52,6 +52,7 @@
 	#include <dekaf2/core/strings/kstring.h>
 	#include <dekaf2/core/format/kformat.h>
 	#include <dekaf2/time/clock/ktime.h>
+	#include <atomic>
 	#include <memory>
 	#include <exception>
 	#include <mutex>
@@ -72,6 +73,7 @@ DEKAF2_NAMESPACE_BEGIN
 #ifdef DEKAF2_WITH_KLOG
 class KLogWriter;
 class KLogSerializer;
+class KLogAsync;
 #endif
 
 #ifdef DEKAF2_KLOG_WITH_TCP
@@ -273,7 +275,7 @@ public:
 	//---------------------------------------------------------------------------
 	{
 #ifdef DEKAF2_WITH_KLOG
-		return m_iBackTrace;
+		return m_iBackTrace.load(std::memory_order_relaxed);
 #else
 		return -2;
 #endif
@@ -285,7 +287,7 @@ public:
 	//---------------------------------------------------------------------------
 	{
 #ifdef DEKAF2_WITH_KLOG
-		m_iBackTrace = iLevel;
+		m_iBackTrace.store(iLevel, std::memory_order_relaxed);
 #endif
 		return GetBackTraceLevel();
 	}
@@ -618,6 +620,103 @@ public:
 	{ return *this; }
 #endif
 
+	/// overflow policy for the asynchronous logging
+	enum class AsyncOverflow
+	{
+		Block, ///< wait until the background thread has made room in the queue
+		Drop   ///< drop the log line and count it, see GetDroppedLines()
+	};
+
+	//---------------------------------------------------------------------------
+	/// Switch asynchronous logging on or off. When on, the logging threads serialize
+	/// into thread local serializers and push the log lines into a bounded lock-free
+	/// queue, which a background thread writes in batches into the configured log writer.
+	/// Per-thread logging, traces and grep expressions keep working, the latter two however
+	/// need the log mutex again. A child process forked with Dekaf::Fork() returns to
+	/// synchronous logging, switch it on again there if needed.
+	/// @param bYesNo true to switch asynchronous logging on, false to return to synchronous
+	/// logging after flushing the queue
+	/// @param iQueueSize the capacity of the queue in log lines, only used when the background
+	/// thread is started the first time
+	/// @param Overflow what to do if the queue is full
+	self& SetAsync(bool bYesNo, std::size_t iQueueSize = 8192, AsyncOverflow Overflow = AsyncOverflow::Block)
+	//---------------------------------------------------------------------------
+#ifdef DEKAF2_WITH_KLOG
+	;
+#else
+	{ return *this; }
+#endif
+
+	//---------------------------------------------------------------------------
+	/// Returns true if asynchronous logging is switched on
+	DEKAF2_NODISCARD
+	bool IsAsync() const
+	//---------------------------------------------------------------------------
+	{
+#ifdef DEKAF2_WITH_KLOG
+		return m_bAsync.load(std::memory_order_relaxed);
+#else
+		return false;
+#endif
+	}
+
+	//---------------------------------------------------------------------------
+	/// Wait until all log lines queued by asynchronous logging have been written - returns
+	/// false if that did not happen within five seconds
+	bool Flush()
+	//---------------------------------------------------------------------------
+#ifdef DEKAF2_WITH_KLOG
+	;
+#else
+	{ return true; }
+#endif
+
+	//---------------------------------------------------------------------------
+	/// Returns the count of log lines dropped by asynchronous logging with AsyncOverflow::Drop
+	DEKAF2_NODISCARD
+	std::size_t GetDroppedLines() const
+	//---------------------------------------------------------------------------
+#ifdef DEKAF2_WITH_KLOG
+	;
+#else
+	{ return 0; }
+#endif
+
+	//---------------------------------------------------------------------------
+	/// Called by the crash handler: switches back to synchronous logging and writes
+	/// out what is still queued, so that the last log lines before a crash are not lost.
+	/// Takes no locks, and waits at most two seconds for the queue to drain.
+	void FlushOnCrash()
+	//---------------------------------------------------------------------------
+#ifdef DEKAF2_WITH_KLOG
+	;
+#else
+	{ }
+#endif
+
+	//---------------------------------------------------------------------------
+	/// Called by Dekaf::Fork() right before fork(): writes out the asynchronous queue and
+	/// holds the log mutex, so that the child does not inherit it in a locked state
+	void PrepareFork()
+	//---------------------------------------------------------------------------
+#ifdef DEKAF2_WITH_KLOG
+	;
+#else
+	{ }
+#endif
+
+	//---------------------------------------------------------------------------
+	/// Called by Dekaf::Fork() after fork(), in the parent and in the child process.
+	/// Releases the log mutex, and in the child, which has no background thread,
+	/// returns to synchronous logging
+	void FinishFork(bool bIsChild)
+	//---------------------------------------------------------------------------
+#ifdef DEKAF2_WITH_KLOG
+	;
+#else
+	{ }
+#endif
+
 #ifdef DEKAF2_WITH_KLOG
 	static KStringView s_sJSONSkipFiles;
 	static thread_local int s_iThreadLogLevel;
@@ -630,6 +729,9 @@ private:
 #ifdef DEKAF2_WITH_KLOG
 
 	bool IntDebug (int iLevel, KStringView sFunction, KStringView sMessage);
+	void IntAsyncDebug (int iLevel, KStringView sFunction, KStringView sMessage);
+	KLogSerializer* GetAsyncSerializer ();
+	void UpdateHasFilters ();
 	void IntException (KStringView sWhat, KStringView sFunction, KStringView sClass);
 
 	//---------------------------------------------------------------------------
@@ -697,6 +799,8 @@ private:
 	static thread_local bool s_bPrintTimeStampOnClose;
 #endif
 	static thread_local bool s_bPerThreadEGrep;
+	static thread_local std::unique_ptr<KLogSerializer> s_AsyncSerializer;
+	static thread_local uint32_t s_iAsyncSerializerGeneration;
 
 	KStringViewZ m_sPathName;
 	KString m_sShortName;
@@ -709,7 +813,7 @@ private:
 
 	std::recursive_mutex m_LogMutex;
 
-	int m_iBackTrace { -2 };
+	std::atomic<int> m_iBackTrace { -2 }; // atomic, as the async logging reads it without the log mutex
 	KUnixTime m_sTimestampFlagfile;
 	std::unique_ptr<KLogSerializer> m_Serializer;
 	std::unique_ptr<KLogWriter> m_Logger;
@@ -737,6 +841,16 @@ private:
 
 	LOGMODE m_Logmode              { CLI   };
 
+	// the asynchronous writer, once started it runs until destruction
+	std::unique_ptr<KLogAsync> m_Async;
+	std::atomic<bool> m_bAsync                { false };
+	std::atomic<bool> m_bAsyncStarted         { false };
+	// true if traces or a grep expression are set, which need the log mutex
+	std::atomic<bool> m_bHasFilters           { false };
+	// the type of m_Serializer, or -1 if it was not created by CreateSerializer()
+	std::atomic<int>  m_iSerializer           { -1 };
+	std::atomic<uint32_t> m_iSerializerGeneration { 0 };
+
 #endif // of ifdef DEKAF2_WITH_KLOG
 
 }; // KLog
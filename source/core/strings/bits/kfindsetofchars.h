@@ -48,6 +48,7 @@
 #include <dekaf2/core/types/kbit.h>
 #include <dekaf2/core/strings/kstringview.h>
 #include <dekaf2/core/strings/bits/simd/kmemsearch_neon.h>
+#include <dekaf2/core/strings/bits/simd/kmemsearch_x86.h>
 #include <cinttypes>
 
 #if !DEKAF2_FIND_FIRST_OF_USE_SSE
@@ -69,6 +70,14 @@
 // m_iOffset / m_iBuckets bookkeeping (it would only complicate the lookup).
 #define DEKAF2_USE_COMPRESSED_SEARCH_TABLES 1
 #define DEKAF2_USE_COMPRESSED_SEARCH_TABLES_OFFSET 0
+#elif DEKAF2_HAS_X86_SIMD_DISPATCH && !DEKAF2_FIND_FIRST_OF_USE_SSE
+// On X86 without SSE 4.2 at compile time (the portable builds) we search the
+// needle set with the byteset kernels of kmemsearch_x86, which select SSSE3,
+// AVX2 or AVX-512BW at run time. They read the 256 bit mask as nibble tables,
+// therefore the bits are stored in that order (see MaskBit()).
+#define DEKAF2_USE_COMPRESSED_SEARCH_TABLES 1
+#define DEKAF2_USE_COMPRESSED_SEARCH_TABLES_OFFSET 0
+#define DEKAF2_USE_NIBBLE_SEARCH_TABLES 1
 #elif DEKAF2_USE_COMPRESSED_SEARCH_TABLES
 #define DEKAF2_USE_COMPRESSED_SEARCH_TABLES_OFFSET 1
 #endif
@@ -84,10 +93,11 @@ DEKAF2_NAMESPACE_BEGIN
 /// which operate repeatedly on the same set of characters. Why not simply using std::string's methods?
 /// They are orders of magnitude slower as they do not use a table based approach (which of course
 /// only works with 8 bit characters..).
-/// On X86_64 architectures we assume that SSE 4.2 is available and delegate the call to the SSE
-/// implementation; on ARM64 we build a 256 bit membership mask and delegate to the NEON byteset
-/// kernels (with a memchr-style fast path for single-character sets). Everything else uses a flat
-/// 256 byte membership table.
+/// On X86_64 architectures compiled for SSE 4.2 we delegate the call to the SSE implementation;
+/// on ARM64 and on all other X86_64 builds we build a 256 bit membership mask and delegate to the
+/// NEON byteset kernels, or to the X86 byteset kernels that select the instruction set at run
+/// time (both with a memchr-style fast path for single-character sets). Everything else uses a
+/// flat 256 byte membership table.
 /// Please note that the construction can happen constexpr, and therefore the class instance itself declared
 /// as a constexpr variable.
 class DEKAF2_PUBLIC KFindSetOfChars
@@ -197,13 +207,46 @@ private:
 
 #elif DEKAF2_USE_COMPRESSED_SEARCH_TABLES
 
-#if !DEKAF2_HAS_NEON
-	// scalar workers, only used by the non-NEON compressed configuration -
-	// the NEON build defines the public find methods directly in the .cpp
+#if !DEKAF2_HAS_NEON && !DEKAF2_USE_NIBBLE_SEARCH_TABLES
+	// scalar workers, only used by the non-SIMD compressed configuration -
+	// the NEON and X86 builds define the public find methods directly in the .cpp
 	size_type find_first_in(KStringView sHaystack, size_type pos, bool bNot) const;
 	size_type find_last_in (KStringView sHaystack, size_type pos, bool bNot) const;
 #endif
 
+	/// returns the index of the bit for ch (minus the offset) in the 256 bit mask
+	DEKAF2_CONSTEXPR_14
+	static uint16_t MaskBit(uint8_t ch)
+	{
+#if DEKAF2_USE_NIBBLE_SEARCH_TABLES
+		// the mask bytes are the nibble tables of kmemsearch_x86 (on a little
+		// endian CPU, byte n of the mask holds the bits 8n .. 8n+7)
+		return static_cast<uint16_t>(detail::x86::NibbleTableByte(ch) * 8 + ((ch >> 4) & 0x07));
+#else
+		return ch;
+#endif
+	}
+
+	/// returns the char (minus the offset) for a bit index of the 256 bit mask, the reverse of MaskBit()
+	DEKAF2_CONSTEXPR_14
+	static uint8_t MaskChar(uint16_t iBit)
+	{
+#if DEKAF2_USE_NIBBLE_SEARCH_TABLES
+		auto iByte = iBit / 8;
+		return static_cast<uint8_t>(((iByte >> 4) << 7) | ((iBit & 0x07) << 4) | (iByte & 0x0f));
+#else
+		return static_cast<uint8_t>(iBit);
+#endif
+	}
+
+	/// add ch (minus the offset) to the mask
+	DEKAF2_CONSTEXPR_14
+	void SetMaskBit(uint8_t ch)
+	{
+		auto iBit = MaskBit(ch);
+		m_iMask[iBit / 64] |= 1ull << (iBit % 64);
+	}
+
 	/// cache a single-member set in m_iSingleChar so that the find methods
 	/// can dispatch it to the (much faster) single-character search
 	DEKAF2_CONSTEXPR_14
@@ -215,7 +258,7 @@ private:
 			{
 				if (m_iMask[iWord])
 				{
-					m_iSingleChar = static_cast<int16_t>(iWord * 64 + kBitCountRightZero(m_iMask[iWord]) + iOffset);
+					m_iSingleChar = static_cast<int16_t>(MaskChar(static_cast<uint16_t>(iWord * 64 + kBitCountRightZero(m_iMask[iWord]))) + iOffset);
 					break;
 				}
 			}
@@ -346,10 +389,7 @@ KFindSetOfChars::KFindSetOfChars(KStringView sNeedles)
 
 		for (auto Needle : sNeedles)
 		{
-			auto ch = static_cast<uint8_t>(Needle);
-
-			auto iBucket = (ch - iOffset) / 64;
-			m_iMask[iBucket] |= 1ull << (ch - (iOffset + 64 * iBucket));
+			SetMaskBit(static_cast<uint8_t>(static_cast<uint8_t>(Needle) - iOffset));
 		}
 
 		CacheSingleChar(iOffset);
@@ -365,7 +405,7 @@ KFindSetOfChars::KFindSetOfChars(const char* szNeedles) : KFindSetOfChars(KStrin
 
 #else
 
-// NEON byteset branch - no offset value, the mask spans the full 256 bit range.
+// NEON and X86 byteset branch - no offset value, the mask spans the full 256 bit range.
 // Build the mask in a single pass over the C string so we avoid the extra
 // strlen() that the KStringView conversion above would incur; this is the
 // high performance path.
@@ -378,8 +418,7 @@ KFindSetOfChars::KFindSetOfChars(const char* szNeedles)
 		{
 			auto ch = static_cast<unsigned char>(*szNeedles++);
 			if (!ch) break;
-			auto iBucket = ch / 64;
-			m_iMask[iBucket] |= 1ull << (ch - 64 * iBucket);
+			SetMaskBit(ch);
 		}
 
 		CacheSingleChar(0);
@@ -388,7 +427,7 @@ KFindSetOfChars::KFindSetOfChars(const char* szNeedles)
 
 #endif
 
-#if !DEKAF2_HAS_NEON
+#if !DEKAF2_HAS_NEON && !DEKAF2_USE_NIBBLE_SEARCH_TABLES
 
 inline
 KFindSetOfChars::size_type KFindSetOfChars::find_first_in(KStringView sHaystack, const size_type pos) const
@@ -440,11 +479,11 @@ bool KFindSetOfChars::contains(const value_type ch) const
 	if (uch < m_iOffset) return false;
 	uch -= m_iOffset;
 #endif
-	auto bucket = uch / 64;
 #if DEKAF2_USE_COMPRESSED_SEARCH_TABLES_OFFSET
-	if (m_iBuckets <= bucket) return false;
+	if (m_iBuckets <= uch / 64) return false;
 #endif
-	return m_iMask[bucket] & (1ull << (uch - bucket * 64));
+	auto iBit = MaskBit(uch);
+	return m_iMask[iBit / 64] & (1ull << (iBit % 64));
 }
 
 #else // plain tables
@@ -583,14 +583,14 @@ namespace std
 	{
 		using is_transparent = void;
 
-		DEKAF2_CONSTEXPR_14 std::size_t operator()(DEKAF2_PREFIX KStringView s) const noexcept
+		DEKAF2_STD_STRING_HASH_CONSTEXPR_14 std::size_t operator()(DEKAF2_PREFIX KStringView s) const noexcept
 		{
-			return DEKAF2_PREFIX kHash(s.data(), s.size());
+			return DEKAF2_PREFIX kStdStringHash(s.data(), s.size());
 		}
 
-		DEKAF2_CONSTEXPR_14 std::size_t operator()(const char* s) const noexcept
+		DEKAF2_STD_STRING_HASH_CONSTEXPR_14 std::size_t operator()(const char* s) const noexcept
 		{
-			return DEKAF2_PREFIX kHash(s);
+			return DEKAF2_PREFIX kStdStringHash(s);
 		}
 	};
 
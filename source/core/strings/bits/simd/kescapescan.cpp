@@ -0,0 +1,239 @@
+/*
+//
+// DEKAF(tm): Lighter, Faster, Smarter(tm)
+//
+// Copyright (c) 2026, Ridgeware, Inc.
+//
+// +-------------------------------------------------------------------------+
+// | /\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\|
+// |/+---------------------------------------------------------------------+/|
+// |/|                                                                     |/|
+// |\|  ** THIS NOTICE MUST NOT BE REMOVED FROM THE SOURCE CODE MODULE **  |\|
+// |/|                                                                     |/|
+// |\|   OPEN SOURCE LICENSE                                               |\|
+// |/|                                                                     |/|
+// |\|   Permission is hereby granted, free of charge, to any person       |\|
+// |/|   obtaining a copy of this software and associated                  |/|
+// |\|   documentation files (the "Software"), to deal in the              |\|
+// |/|   Software without restriction, including without limitation        |/|
+// |\|   the rights to use, copy, modify, merge, publish,                  |\|
+// |/|   distribute, sublicense, and/or sell copies of the Software,       |/|
+// |\|   and to permit persons to whom the Software is furnished to        |\|
+// |/|   do so, subject to the following conditions:                       |/|
+// |\|                                                                     |\|
+// |/|   The above copyright notice and this permission notice shall       |/|
+// |\|   be included in all copies or substantial portions of the          |\|
+// |/|   Software.                                                         |/|
+// |\|                                                                     |\|
+// |/|   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY         |/|
+// |\|   KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE        |\|
+// |/|   WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR           |/|
+// |\|   PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS        |\|
+// |/|   OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR          |/|
+// |\|   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR        |\|
+// |/|   OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE         |/|
+// |\|   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.            |\|
+// |/|                                                                     |/|
+// |/+---------------------------------------------------------------------+/|
+// |\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/ |
+// +-------------------------------------------------------------------------+
+//
+*/
+
+#include <dekaf2/core/strings/bits/simd/kescapescan.h>
+#include <dekaf2/core/strings/bits/simd/kmemsearch_neon.h>
+#include <dekaf2/core/strings/bits/simd/ksimd.h>
+#include <dekaf2/core/types/kbit.h>
+
+#if DEKAF2_HAS_X86_SIMD_DISPATCH
+	#include <dekaf2/core/strings/bits/simd/kmemsearch_x86.h>
+#elif DEKAF2_HAS_NEON
+	#include <arm_neon.h>
+#endif
+
+DEKAF2_NAMESPACE_BEGIN
+
+namespace detail {
+
+namespace {
+
+/// the signature of all scan kernels - pLo points to the two 16 byte low nibble tables
+using ScanFunc = std::size_t (*)(const uint8_t* pLo, const bool* pTable, const char* pData, std::size_t iSize);
+
+#if !DEKAF2_HAS_X86_SIMD_DISPATCH
+
+//-----------------------------------------------------------------------------
+std::size_t ScanTable(const uint8_t*, const bool* pTable, const char* pData, std::size_t iSize) noexcept
+//-----------------------------------------------------------------------------
+{
+	for (std::size_t iPos = 0; iPos < iSize; ++iPos)
+	{
+		if (pTable[static_cast<unsigned char>(pData[iPos])])
+		{
+			return iPos;
+		}
+	}
+
+	return KEscapeScan::npos;
+
+} // ScanTable
+
+#endif
+
+#if DEKAF2_HAS_X86_SIMD_DISPATCH
+
+//-----------------------------------------------------------------------------
+/// the byteset kernels of kmemsearch_x86 use the same nibble tables, and select
+/// SSSE3, AVX2 or AVX-512BW from the current KSimd level
+std::size_t ScanX86(const uint8_t* pLo, const bool*, const char* pData, std::size_t iSize) noexcept
+//-----------------------------------------------------------------------------
+{
+	auto pFound = x86::kFindByteset(pData, iSize, pLo);
+
+	return pFound ? static_cast<std::size_t>(pFound - pData) : KEscapeScan::npos;
+
+} // ScanX86
+
+#elif DEKAF2_HAS_NEON
+
+//-----------------------------------------------------------------------------
+/// returns a mask with one nibble per input byte, 0xf if the byte is in the set
+inline uint64_t MatchNEON(uint8x16_t In, uint8x16_t LoA, uint8x16_t LoB, uint8x16_t HiA, uint8x16_t HiB)
+//-----------------------------------------------------------------------------
+{
+	auto Lo = vandq_u8(In, vdupq_n_u8(0x0f));
+	auto Hi = vshrq_n_u8(In, 4);
+	auto A  = vandq_u8(vqtbl1q_u8(LoA, Lo), vqtbl1q_u8(HiA, Hi));
+	auto B  = vandq_u8(vqtbl1q_u8(LoB, Lo), vqtbl1q_u8(HiB, Hi));
+	auto M  = vorrq_u8(A, B);
+	auto Ne = vtstq_u8(M, M);
+
+	return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(Ne), 4)), 0);
+
+} // MatchNEON
+
+//-----------------------------------------------------------------------------
+std::size_t ScanNEON(const uint8_t* pLo, const bool* pTable, const char* pData, std::size_t iSize) noexcept
+//-----------------------------------------------------------------------------
+{
+	if (iSize < 16)
+	{
+		return ScanTable(pLo, pTable, pData, iSize);
+	}
+
+	static constexpr uint8_t HiATable[16] { 1, 2, 4, 8, 16, 32, 64, 128, 0, 0, 0, 0, 0, 0, 0, 0 };
+	static constexpr uint8_t HiBTable[16] { 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 4, 8, 16, 32, 64, 128 };
+
+	const auto LoA = vld1q_u8(pLo);
+	const auto LoB = vld1q_u8(pLo + 16);
+	const auto HiA = vld1q_u8(HiATable);
+	const auto HiB = vld1q_u8(HiBTable);
+
+	std::size_t iPos = 0;
+
+	for (; iPos + 16 <= iSize; iPos += 16)
+	{
+		auto In    = vld1q_u8(reinterpret_cast<const uint8_t*>(pData + iPos));
+		auto iMask = MatchNEON(In, LoA, LoB, HiA, HiB);
+
+		if (iMask)
+		{
+			return iPos + kBitCountRightZero(iMask) / 4;
+		}
+	}
+
+	if (iPos < iSize)
+	{
+		// the last block overlaps with bytes that were already found clean
+		iPos       = iSize - 16;
+		auto In    = vld1q_u8(reinterpret_cast<const uint8_t*>(pData + iPos));
+		auto iMask = MatchNEON(In, LoA, LoB, HiA, HiB);
+
+		if (iMask)
+		{
+			return iPos + kBitCountRightZero(iMask) / 4;
+		}
+	}
+
+	return KEscapeScan::npos;
+
+} // ScanNEON
+
+#endif
+
+//-----------------------------------------------------------------------------
+ScanFunc GetKernel()
+//-----------------------------------------------------------------------------
+{
+#if DEKAF2_HAS_X86_SIMD_DISPATCH
+	return ScanX86;
+#elif DEKAF2_HAS_NEON
+	return ScanNEON;
+#else
+	return ScanTable;
+#endif
+
+} // GetKernel
+
+} // end of anonymous namespace
+
+//-----------------------------------------------------------------------------
+KEscapeScan::KEscapeScan(KStringView sChars) noexcept
+//-----------------------------------------------------------------------------
+{
+	for (auto ch : sChars)
+	{
+		Add(static_cast<unsigned char>(ch));
+	}
+
+} // ctor
+
+//-----------------------------------------------------------------------------
+KEscapeScan::KEscapeScan(const bool Table[256], bool bInTable) noexcept
+//-----------------------------------------------------------------------------
+{
+	for (std::size_t ch = 0; ch < 256; ++ch)
+	{
+		if (Table[ch] == bInTable)
+		{
+			Add(static_cast<unsigned char>(ch));
+		}
+	}
+
+} // ctor
+
+//-----------------------------------------------------------------------------
+void KEscapeScan::Add(unsigned char ch) noexcept
+//-----------------------------------------------------------------------------
+{
+	m_Table[ch] = true;
+	m_Lo[ch >> 7][ch & 0x0f] |= static_cast<uint8_t>(1u << ((ch >> 4) & 0x07));
+
+} // Add
+
+//-----------------------------------------------------------------------------
+KEscapeScan::size_type KEscapeScan::FindVectorized(const char* pData, size_type iSize) const noexcept
+//-----------------------------------------------------------------------------
+{
+	return GetKernel()(&m_Lo[0][0], m_Table, pData, iSize);
+
+} // FindVectorized
+
+//-----------------------------------------------------------------------------
+const char* KEscapeScan::GetKernelName() noexcept
+//-----------------------------------------------------------------------------
+{
+#if DEKAF2_HAS_X86_SIMD_DISPATCH
+	// the names of the levels are literals
+	return KSimd::ToString(KSimd::GetLevel()).data();
+#elif DEKAF2_HAS_NEON
+	return "NEON";
+#else
+	return "table";
+#endif
+
+} // GetKernelName
+
+} // end of namespace detail
+
+DEKAF2_NAMESPACE_END
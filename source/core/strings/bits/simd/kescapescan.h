@@ -0,0 +1,156 @@
+/*
+//
+// DEKAF(tm): Lighter, Faster, Smarter(tm)
+//
+// Copyright (c) 2026, Ridgeware, Inc.
+//
+// +-------------------------------------------------------------------------+
+// | /\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\|
+// |/+---------------------------------------------------------------------+/|
+// |/|                                                                     |/|
+// |\|  ** THIS NOTICE MUST NOT BE REMOVED FROM THE SOURCE CODE MODULE **  |\|
+// |/|                                                                     |/|
+// |\|   OPEN SOURCE LICENSE                                               |\|
+// |/|                                                                     |/|
+// |\|   Permission is hereby granted, free of charge, to any person       |\|
+// |/|   obtaining a copy of this software and associated                  |/|
+// |\|   documentation files (the "Software"), to deal in the              |\|
+// |/|   Software without restriction, including without limitation        |/|
+// |\|   the rights to use, copy, modify, merge, publish,                  |\|
+// |/|   distribute, sublicense, and/or sell copies of the Software,       |/|
+// |\|   and to permit persons to whom the Software is furnished to        |\|
+// |/|   do so, subject to the following conditions:                       |/|
+// |\|                                                                     |\|
+// |/|   The above copyright notice and this permission notice shall       |/|
+// |\|   be included in all copies or substantial portions of the          |\|
+// |/|   Software.                                                         |/|
+// |\|                                                                     |\|
+// |/|   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY         |/|
+// |\|   KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE        |\|
+// |/|   WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR           |/|
+// |\|   PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS        |\|
+// |/|   OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR          |/|
+// |\|   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR        |\|
+// |/|   OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE         |/|
+// |\|   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.            |\|
+// |/|                                                                     |/|
+// |/+---------------------------------------------------------------------+/|
+// |\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/ |
+// +-------------------------------------------------------------------------+
+//
+*/
+
+#pragma once
+
+/// @file kescapescan.h
+/// Finds the next byte that needs attention when escaping or unescaping a
+/// string, for an arbitrary set of up to 256 byte values. The encoders for
+/// URLs, HTML and JSON use it to copy the clean runs between two special
+/// bytes in one append instead of testing and appending byte by byte.
+///
+/// The scan uses the nibble lookup technique: the low nibble of each input
+/// byte selects a bit mask from a 16 byte table, the high nibble selects a
+/// bit, and a byte is in the set if both overlap. With a byte shuffle
+/// instruction this tests 16 (SSSE3, NEON), 32 (AVX2) or 64 (AVX-512BW) bytes
+/// per step. On X86 the byteset kernels of kmemsearch_x86 are used, which
+/// follow the instruction set level of KSimd, on ARM64 NEON is always present,
+/// and all other targets use a table loop.
+
+#include <dekaf2/core/init/kdefinitions.h>
+#include <dekaf2/core/strings/kstringview.h>
+#include <cstddef>
+#include <cstdint>
+
+DEKAF2_NAMESPACE_BEGIN
+
+namespace detail {
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+/// a precomputed set of bytes that need escaping or unescaping, with a fast
+/// scan for the first of them in a string
+class DEKAF2_PUBLIC KEscapeScan
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+{
+
+//------
+public:
+//------
+
+	using size_type = std::size_t;
+	static constexpr size_type npos = KStringView::npos;
+
+	/// the empty set - all strings are clean
+	KEscapeScan() = default;
+
+	/// construct from the bytes in sChars
+	KEscapeScan(KStringView sChars) noexcept;
+
+	/// construct from a table of 256 bools, the set contains all bytes ch for which
+	/// Table[ch] == bInTable
+	KEscapeScan(const bool Table[256], bool bInTable) noexcept;
+
+	/// returns true if ch is in the set
+	DEKAF2_NODISCARD
+	bool contains(char ch) const noexcept
+	{
+		return m_Table[static_cast<unsigned char>(ch)];
+	}
+
+	/// returns the position of the first byte of the set in pData[0..iSize), or npos
+	DEKAF2_NODISCARD
+	size_type find_first_in(const char* pData, size_type iSize) const noexcept
+	{
+		// the first bytes are scanned inline - this is faster for short strings
+		// and for densely escaped input, where the next special byte is close
+		auto iInline = (iSize < InlineScan) ? iSize : InlineScan;
+
+		for (size_type iPos = 0; iPos < iInline; ++iPos)
+		{
+			if (contains(pData[iPos]))
+			{
+				return iPos;
+			}
+		}
+
+		if (iSize == iInline)
+		{
+			return npos;
+		}
+
+		auto iFound = FindVectorized(pData + InlineScan, iSize - InlineScan);
+
+		return (iFound == npos) ? npos : iFound + InlineScan;
+	}
+
+	/// returns the position of the first byte of the set in sHaystack, or npos
+	DEKAF2_NODISCARD
+	size_type find_first_in(KStringView sHaystack) const noexcept
+	{
+		return find_first_in(sHaystack.data(), sHaystack.size());
+	}
+
+	/// returns the name of the kernel currently in use, for diagnostics and benchmarks
+	DEKAF2_NODISCARD
+	static const char* GetKernelName() noexcept;
+
+//------
+private:
+//------
+
+	static constexpr size_type InlineScan = 16;
+
+	void Add(unsigned char ch) noexcept;
+
+	DEKAF2_NODISCARD
+	size_type FindVectorized(const char* pData, size_type iSize) const noexcept;
+
+	// m_Lo[0] has the bit masks of the low nibbles for high nibbles 0..7,
+	// m_Lo[1] those for high nibbles 8..15
+	alignas(16) uint8_t m_Lo[2][16] {};
+	bool                m_Table[256] {};
+
+}; // KEscapeScan
+
+} // end of namespace detail
+
+DEKAF2_NAMESPACE_END
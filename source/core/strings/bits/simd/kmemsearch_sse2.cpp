@@ -43,10 +43,15 @@
 
 #if DEKAF2_HAS_SSE2_MEMSEARCH
 
+#include <dekaf2/core/strings/bits/simd/ksimd.h>
 #include <dekaf2/core/types/kbit.h>
 #include <emmintrin.h>
 #include <cstdint>
 
+#if DEKAF2_HAS_X86_SIMD_DISPATCH
+	#include <immintrin.h>
+#endif
+
 DEKAF2_NAMESPACE_BEGIN
 namespace detail {
 namespace sse2   {
@@ -65,6 +70,191 @@ uint32_t MoveMask(__m128i cmp) noexcept
 	return static_cast<uint32_t>(_mm_movemask_epi8(cmp)) & 0xFFFFu;
 }
 
+//-----------------------------------------------------------------------------
+std::size_t FindNotCharScalar(const uint8_t* pBase, std::size_t iScanLen, char needle) noexcept
+//-----------------------------------------------------------------------------
+{
+	for (std::size_t i = 0; i < iScanLen; ++i)
+	{
+		if (pBase[i] != static_cast<uint8_t>(needle))
+		{
+			return i;
+		}
+	}
+
+	return npos;
+
+} // FindNotCharScalar
+
+//-----------------------------------------------------------------------------
+std::size_t RFindNotCharScalar(const uint8_t* pBase, std::size_t iScanLen, char needle) noexcept
+//-----------------------------------------------------------------------------
+{
+	while (iScanLen)
+	{
+		if (pBase[--iScanLen] != static_cast<uint8_t>(needle))
+		{
+			return iScanLen;
+		}
+	}
+
+	return npos;
+
+} // RFindNotCharScalar
+
+#if DEKAF2_HAS_X86_SIMD_DISPATCH
+
+//-----------------------------------------------------------------------------
+/// returns a bit mask with one bit per byte that is not equal to the needle
+__attribute__((target("avx2")))
+inline uint32_t NotEqualAVX2(const uint8_t* p, __m256i vNeedle) noexcept
+//-----------------------------------------------------------------------------
+{
+	__m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+	return ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, vNeedle)));
+
+} // NotEqualAVX2
+
+//-----------------------------------------------------------------------------
+/// needs iScanLen >= 32
+__attribute__((target("avx2")))
+std::size_t FindNotCharAVX2(const uint8_t* pBase, std::size_t iScanLen, char needle) noexcept
+//-----------------------------------------------------------------------------
+{
+	const __m256i vNeedle = _mm256_set1_epi8(needle);
+
+	std::size_t i = 0;
+
+	for (; i + 32 <= iScanLen; i += 32)
+	{
+		if (auto neq_mask = NotEqualAVX2(pBase + i, vNeedle))
+		{
+			return i + static_cast<std::size_t>(kBitCountRightZero(neq_mask));
+		}
+	}
+
+	if (i < iScanLen)
+	{
+		// the last block overlaps with bytes that were already checked
+		i = iScanLen - 32;
+
+		if (auto neq_mask = NotEqualAVX2(pBase + i, vNeedle))
+		{
+			return i + static_cast<std::size_t>(kBitCountRightZero(neq_mask));
+		}
+	}
+
+	return npos;
+
+} // FindNotCharAVX2
+
+//-----------------------------------------------------------------------------
+/// needs iScanLen >= 32
+__attribute__((target("avx2")))
+std::size_t RFindNotCharAVX2(const uint8_t* pBase, std::size_t iScanLen, char needle) noexcept
+//-----------------------------------------------------------------------------
+{
+	const __m256i vNeedle = _mm256_set1_epi8(needle);
+
+	std::size_t n = iScanLen;
+
+	while (n >= 32)
+	{
+		n -= 32;
+
+		if (auto neq_mask = NotEqualAVX2(pBase + n, vNeedle))
+		{
+			return n + 31 - static_cast<std::size_t>(kBitCountLeftZero(neq_mask));
+		}
+	}
+
+	if (n)
+	{
+		// the first block overlaps with bytes that were already checked,
+		// only the lower n bits are new
+		if (auto neq_mask = NotEqualAVX2(pBase, vNeedle) & ((1u << n) - 1))
+		{
+			return 31 - static_cast<std::size_t>(kBitCountLeftZero(neq_mask));
+		}
+	}
+
+	return npos;
+
+} // RFindNotCharAVX2
+
+//-----------------------------------------------------------------------------
+__attribute__((target("avx512f,avx512bw")))
+std::size_t FindNotCharAVX512(const uint8_t* pBase, std::size_t iScanLen, char needle) noexcept
+//-----------------------------------------------------------------------------
+{
+	const __m512i vNeedle = _mm512_set1_epi8(needle);
+
+	std::size_t i = 0;
+
+	for (; i + 64 <= iScanLen; i += 64)
+	{
+		uint64_t neq_mask = _mm512_cmpneq_epi8_mask(_mm512_loadu_si512(pBase + i), vNeedle);
+
+		if (neq_mask)
+		{
+			return i + static_cast<std::size_t>(kBitCountRightZero(neq_mask));
+		}
+	}
+
+	if (i < iScanLen)
+	{
+		// masked loads do not fault on the bytes outside of the mask
+		__mmask64 Valid   = (1ull << (iScanLen - i)) - 1;
+		uint64_t neq_mask = _mm512_mask_cmpneq_epi8_mask(Valid, _mm512_maskz_loadu_epi8(Valid, pBase + i), vNeedle);
+
+		if (neq_mask)
+		{
+			return i + static_cast<std::size_t>(kBitCountRightZero(neq_mask));
+		}
+	}
+
+	return npos;
+
+} // FindNotCharAVX512
+
+//-----------------------------------------------------------------------------
+__attribute__((target("avx512f,avx512bw")))
+std::size_t RFindNotCharAVX512(const uint8_t* pBase, std::size_t iScanLen, char needle) noexcept
+//-----------------------------------------------------------------------------
+{
+	const __m512i vNeedle = _mm512_set1_epi8(needle);
+
+	std::size_t n = iScanLen;
+
+	while (n >= 64)
+	{
+		n -= 64;
+
+		uint64_t neq_mask = _mm512_cmpneq_epi8_mask(_mm512_loadu_si512(pBase + n), vNeedle);
+
+		if (neq_mask)
+		{
+			return n + 63 - static_cast<std::size_t>(kBitCountLeftZero(neq_mask));
+		}
+	}
+
+	if (n)
+	{
+		__mmask64 Valid   = (1ull << n) - 1;
+		uint64_t neq_mask = _mm512_mask_cmpneq_epi8_mask(Valid, _mm512_maskz_loadu_epi8(Valid, pBase), vNeedle);
+
+		if (neq_mask)
+		{
+			return 63 - static_cast<std::size_t>(kBitCountLeftZero(neq_mask));
+		}
+	}
+
+	return npos;
+
+} // RFindNotCharAVX512
+
+#endif // DEKAF2_HAS_X86_SIMD_DISPATCH
+
 } // anon
 
 //-----------------------------------------------------------------------------
@@ -77,6 +267,22 @@ std::size_t kFindNotChar(const char* pData, std::size_t iScanLen, char needle) n
 	}
 
 	const uint8_t* const pBase   = reinterpret_cast<const uint8_t*>(pData);
+
+	auto Level = KSimd::GetLevel();
+
+#if DEKAF2_HAS_X86_SIMD_DISPATCH
+	if (Level >= KSimd::AVX2 && iScanLen >= 32)
+	{
+		return (Level >= KSimd::AVX512BW) ? FindNotCharAVX512(pBase, iScanLen, needle)
+		                                  : FindNotCharAVX2  (pBase, iScanLen, needle);
+	}
+#endif
+
+	if (DEKAF2_UNLIKELY(Level == KSimd::Scalar))
+	{
+		return FindNotCharScalar(pBase, iScanLen, needle);
+	}
+
 	const __m128i        vNeedle = _mm_set1_epi8(static_cast<char>(needle));
 
 	std::size_t i = 0;
@@ -121,6 +327,22 @@ std::size_t kRFindNotChar(const char* pData, std::size_t iScanLen, char needle)
 	}
 
 	const uint8_t* const pBase   = reinterpret_cast<const uint8_t*>(pData);
+
+	auto Level = KSimd::GetLevel();
+
+#if DEKAF2_HAS_X86_SIMD_DISPATCH
+	if (Level >= KSimd::AVX2 && iScanLen >= 32)
+	{
+		return (Level >= KSimd::AVX512BW) ? RFindNotCharAVX512(pBase, iScanLen, needle)
+		                                  : RFindNotCharAVX2  (pBase, iScanLen, needle);
+	}
+#endif
+
+	if (DEKAF2_UNLIKELY(Level == KSimd::Scalar))
+	{
+		return RFindNotCharScalar(pBase, iScanLen, needle);
+	}
+
 	const __m128i        vNeedle = _mm_set1_epi8(static_cast<char>(needle));
 
 	std::size_t n = iScanLen;
@@ -50,7 +50,8 @@
 ///
 /// SSE2 is baseline on every x86_64 CPU and on modern 32-bit MSVC / clang
 /// builds (/arch:SSE2, -msse2), so we enable this path unconditionally
-/// whenever the compiler advertises SSE2 support.
+/// whenever the compiler advertises SSE2 support. Longer scans switch at run
+/// time to AVX2 or AVX-512BW kernels if the CPU has them, see KSimd.
 
 #include <dekaf2/core/init/kdefinitions.h>
 #include <cstddef>
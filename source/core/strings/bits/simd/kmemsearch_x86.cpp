@@ -0,0 +1,735 @@
+/*
+//
+// DEKAF(tm): Lighter, Faster, Smarter(tm)
+//
+// Copyright (c) 2026, Ridgeware, Inc.
+//
+// +-------------------------------------------------------------------------+
+// | /\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\|
+// |/+---------------------------------------------------------------------+/|
+// |/|                                                                     |/|
+// |\|  ** THIS NOTICE MUST NOT BE REMOVED FROM THE SOURCE CODE MODULE **  |\|
+// |/|                                                                     |/|
+// |\|   OPEN SOURCE LICENSE                                               |\|
+// |/|                                                                     |/|
+// |\|   Permission is hereby granted, free of charge, to any person       |\|
+// |/|   obtaining a copy of this software and associated                  |/|
+// |\|   documentation files (the "Software"), to deal in the              |\|
+// |/|   Software without restriction, including without limitation        |/|
+// |\|   the rights to use, copy, modify, merge, publish,                  |\|
+// |/|   distribute, sublicense, and/or sell copies of the Software,       |/|
+// |\|   and to permit persons to whom the Software is furnished to        |\|
+// |/|   do so, subject to the following conditions:                       |/|
+// |\|                                                                     |\|
+// |/|   The above copyright notice and this permission notice shall       |/|
+// |\|   be included in all copies or substantial portions of the          |\|
+// |/|   Software.                                                         |/|
+// |\|                                                                     |\|
+// |/|   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY         |/|
+// |\|   KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE        |\|
+// |/|   WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR           |/|
+// |\|   PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS        |\|
+// |/|   OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR          |/|
+// |\|   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR        |\|
+// |/|   OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE         |/|
+// |\|   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.            |\|
+// |/|                                                                     |/|
+// |/+---------------------------------------------------------------------+/|
+// |\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/ |
+// +-------------------------------------------------------------------------+
+//
+*/
+
+#include <dekaf2/core/strings/bits/simd/kmemsearch_x86.h>
+
+#if DEKAF2_HAS_X86_SIMD_DISPATCH
+
+#include <dekaf2/core/types/kbit.h>
+#include <immintrin.h>
+
+DEKAF2_NAMESPACE_BEGIN
+namespace detail {
+namespace x86    {
+
+namespace {
+
+//-----------------------------------------------------------------------------
+DEKAF2_ALWAYS_INLINE
+bool InSet(const uint8_t* pTables, uint8_t ch) noexcept
+//-----------------------------------------------------------------------------
+{
+	return pTables[NibbleTableByte(ch)] & NibbleTableBit(ch);
+}
+
+//-----------------------------------------------------------------------------
+DEKAF2_ALWAYS_INLINE
+uint8_t ToLower(uint8_t ch) noexcept
+//-----------------------------------------------------------------------------
+{
+	return (static_cast<uint8_t>(ch - 'A') < 26) ? ch | 0x20 : ch;
+}
+
+//-----------------------------------------------------------------------------
+template<bool bNot>
+const char* FindScalar(const char* pHaystack, std::size_t iLen, const uint8_t* pTables) noexcept
+//-----------------------------------------------------------------------------
+{
+	for (std::size_t i = 0; i < iLen; ++i)
+	{
+		if (InSet(pTables, static_cast<uint8_t>(pHaystack[i])) != bNot)
+		{
+			return pHaystack + i;
+		}
+	}
+
+	return nullptr;
+
+} // FindScalar
+
+//-----------------------------------------------------------------------------
+template<bool bNot>
+const char* RFindScalar(const char* pHaystack, std::size_t iLen, const uint8_t* pTables) noexcept
+//-----------------------------------------------------------------------------
+{
+	while (iLen)
+	{
+		if (InSet(pTables, static_cast<uint8_t>(pHaystack[--iLen])) != bNot)
+		{
+			return pHaystack + iLen;
+		}
+	}
+
+	return nullptr;
+
+} // RFindScalar
+
+//-----------------------------------------------------------------------------
+std::size_t MismatchScalar(const char* pLeft, const char* pRight, std::size_t iLen, bool bLowerRight) noexcept
+//-----------------------------------------------------------------------------
+{
+	for (std::size_t i = 0; i < iLen; ++i)
+	{
+		auto chRight = static_cast<uint8_t>(pRight[i]);
+
+		if (ToLower(static_cast<uint8_t>(pLeft[i])) != (bLowerRight ? ToLower(chRight) : chRight))
+		{
+			return i;
+		}
+	}
+
+	return iLen;
+
+} // MismatchScalar
+
+// ----------------------------- 16 bytes ------------------------------------
+
+//-----------------------------------------------------------------------------
+/// the byte set tables for 16 byte vectors
+struct Tables16
+//-----------------------------------------------------------------------------
+{
+	__attribute__((target("ssse3")))
+	Tables16(const uint8_t* pTables) noexcept
+	: LoA    (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pTables)))
+	, LoB    (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pTables + 16)))
+	, HiA    (_mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0))
+	, HiB    (_mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 4, 8, 16, 32, 64, -128))
+	, Nibble (_mm_set1_epi8(0x0f))
+	{
+	}
+
+	/// returns a bit mask with one bit per input byte, set if the byte is in the set (or not, if bNot)
+	template<bool bNot>
+	__attribute__((target("ssse3")))
+	uint32_t Match(const char* p) const noexcept
+	{
+		auto In = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+		auto Lo = _mm_and_si128(In, Nibble);
+		auto Hi = _mm_and_si128(_mm_srli_epi16(In, 4), Nibble);
+		auto A  = _mm_and_si128(_mm_shuffle_epi8(LoA, Lo), _mm_shuffle_epi8(HiA, Hi));
+		auto B  = _mm_and_si128(_mm_shuffle_epi8(LoB, Lo), _mm_shuffle_epi8(HiB, Hi));
+		auto Eq = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_or_si128(A, B), _mm_setzero_si128())));
+
+		return bNot ? Eq : ~Eq & 0xffffu;
+	}
+
+	__m128i LoA;
+	__m128i LoB;
+	__m128i HiA;
+	__m128i HiB;
+	__m128i Nibble;
+
+}; // Tables16
+
+//-----------------------------------------------------------------------------
+/// needs iLen >= 16
+template<bool bNot>
+__attribute__((target("ssse3")))
+const char* FindSSSE3(const char* pHaystack, std::size_t iLen, const uint8_t* pTables) noexcept
+//-----------------------------------------------------------------------------
+{
+	const Tables16 Tables(pTables);
+
+	std::size_t i = 0;
+
+	for (; i + 16 <= iLen; i += 16)
+	{
+		if (auto iMask = Tables.Match<bNot>(pHaystack + i))
+		{
+			return pHaystack + i + kBitCountRightZero(iMask);
+		}
+	}
+
+	if (i < iLen)
+	{
+		// the last block overlaps with bytes that were already checked
+		i = iLen - 16;
+
+		if (auto iMask = Tables.Match<bNot>(pHaystack + i))
+		{
+			return pHaystack + i + kBitCountRightZero(iMask);
+		}
+	}
+
+	return nullptr;
+
+} // FindSSSE3
+
+//-----------------------------------------------------------------------------
+/// needs iLen >= 16
+template<bool bNot>
+__attribute__((target("ssse3")))
+const char* RFindSSSE3(const char* pHaystack, std::size_t iLen, const uint8_t* pTables) noexcept
+//-----------------------------------------------------------------------------
+{
+	const Tables16 Tables(pTables);
+
+	while (iLen >= 16)
+	{
+		iLen -= 16;
+
+		if (auto iMask = Tables.Match<bNot>(pHaystack + iLen))
+		{
+			return pHaystack + iLen + 31 - kBitCountLeftZero(iMask);
+		}
+	}
+
+	if (iLen)
+	{
+		// the first block overlaps with bytes that were already checked
+		if (auto iMask = Tables.Match<bNot>(pHaystack) & ((1u << iLen) - 1))
+		{
+			return pHaystack + 31 - kBitCountLeftZero(iMask);
+		}
+	}
+
+	return nullptr;
+
+} // RFindSSSE3
+
+//-----------------------------------------------------------------------------
+/// converts 'A'..'Z' to lower case
+DEKAF2_ALWAYS_INLINE
+__m128i LowerSSE2(__m128i In) noexcept
+//-----------------------------------------------------------------------------
+{
+	// 'A'..'Z' + 63 are the smallest signed bytes, all below -102
+	auto Upper = _mm_cmplt_epi8(_mm_add_epi8(In, _mm_set1_epi8(63)), _mm_set1_epi8(-102));
+	return _mm_or_si128(In, _mm_and_si128(Upper, _mm_set1_epi8(0x20)));
+
+} // LowerSSE2
+
+//-----------------------------------------------------------------------------
+/// returns a bit mask with one bit per byte, set if the lower cased bytes differ
+DEKAF2_ALWAYS_INLINE
+uint32_t MismatchSSE2(const char* pLeft, const char* pRight, bool bLowerRight) noexcept
+//-----------------------------------------------------------------------------
+{
+	auto Left  = LowerSSE2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pLeft)));
+	auto Right = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRight));
+
+	if (bLowerRight)
+	{
+		Right = LowerSSE2(Right);
+	}
+
+	return ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(Left, Right))) & 0xffffu;
+
+} // MismatchSSE2
+
+//-----------------------------------------------------------------------------
+/// needs iLen >= 16
+std::size_t MismatchSSE2(const char* pLeft, const char* pRight, std::size_t iLen, bool bLowerRight) noexcept
+//-----------------------------------------------------------------------------
+{
+	std::size_t i = 0;
+
+	for (; i + 16 <= iLen; i += 16)
+	{
+		if (auto iMask = MismatchSSE2(pLeft + i, pRight + i, bLowerRight))
+		{
+			return i + kBitCountRightZero(iMask);
+		}
+	}
+
+	if (i < iLen)
+	{
+		i = iLen - 16;
+
+		if (auto iMask = MismatchSSE2(pLeft + i, pRight + i, bLowerRight))
+		{
+			return i + kBitCountRightZero(iMask);
+		}
+	}
+
+	return iLen;
+
+} // MismatchSSE2
+
+// ----------------------------- 32 bytes ------------------------------------
+
+//-----------------------------------------------------------------------------
+/// the byte set tables for 32 byte vectors
+struct Tables32
+//-----------------------------------------------------------------------------
+{
+	// the shuffles work per 128 bit lane, therefore the tables are needed in both lanes
+	__attribute__((target("avx2")))
+	Tables32(const uint8_t* pTables) noexcept
+	: LoA    (_mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pTables))))
+	, LoB    (_mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pTables + 16))))
+	, HiA    (_mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0,
+	                           1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0))
+	, HiB    (_mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 4, 8, 16, 32, 64, -128,
+	                           0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 4, 8, 16, 32, 64, -128))
+	, Nibble (_mm256_set1_epi8(0x0f))
+	{
+	}
+
+	/// returns a bit mask with one bit per input byte, set if the byte is in the set (or not, if bNot)
+	template<bool bNot>
+	__attribute__((target("avx2")))
+	uint32_t Match(const char* p) const noexcept
+	{
+		auto In = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+		auto Lo = _mm256_and_si256(In, Nibble);
+		auto Hi = _mm256_and_si256(_mm256_srli_epi16(In, 4), Nibble);
+		auto A  = _mm256_and_si256(_mm256_shuffle_epi8(LoA, Lo), _mm256_shuffle_epi8(HiA, Hi));
+		auto B  = _mm256_and_si256(_mm256_shuffle_epi8(LoB, Lo), _mm256_shuffle_epi8(HiB, Hi));
+		auto Eq = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_or_si256(A, B), _mm256_setzero_si256())));
+
+		return bNot ? Eq : ~Eq;
+	}
+
+	__m256i LoA;
+	__m256i LoB;
+	__m256i HiA;
+	__m256i HiB;
+	__m256i Nibble;
+
+}; // Tables32
+
+//-----------------------------------------------------------------------------
+/// needs iLen >= 32
+template<bool bNot>
+__attribute__((target("avx2")))
+const char* FindAVX2(const char* pHaystack, std::size_t iLen, const uint8_t* pTables) noexcept
+//-----------------------------------------------------------------------------
+{
+	const Tables32 Tables(pTables);
+
+	std::size_t i = 0;
+
+	for (; i + 32 <= iLen; i += 32)
+	{
+		if (auto iMask = Tables.Match<bNot>(pHaystack + i))
+		{
+			return pHaystack + i + kBitCountRightZero(iMask);
+		}
+	}
+
+	if (i < iLen)
+	{
+		// the last block overlaps with bytes that were already checked
+		i = iLen - 32;
+
+		if (auto iMask = Tables.Match<bNot>(pHaystack + i))
+		{
+			return pHaystack + i + kBitCountRightZero(iMask);
+		}
+	}
+
+	return nullptr;
+
+} // FindAVX2
+
+//-----------------------------------------------------------------------------
+/// needs iLen >= 32
+template<bool bNot>
+__attribute__((target("avx2")))
+const char* RFindAVX2(const char* pHaystack, std::size_t iLen, const uint8_t* pTables) noexcept
+//-----------------------------------------------------------------------------
+{
+	const Tables32 Tables(pTables);
+
+	while (iLen >= 32)
+	{
+		iLen -= 32;
+
+		if (auto iMask = Tables.Match<bNot>(pHaystack + iLen))
+		{
+			return pHaystack + iLen + 31 - kBitCountLeftZero(iMask);
+		}
+	}
+
+	if (iLen)
+	{
+		// the first block overlaps with bytes that were already checked
+		if (auto iMask = Tables.Match<bNot>(pHaystack) & ((1u << iLen) - 1))
+		{
+			return pHaystack + 31 - kBitCountLeftZero(iMask);
+		}
+	}
+
+	return nullptr;
+
+} // RFindAVX2
+
+//-----------------------------------------------------------------------------
+/// converts 'A'..'Z' to lower case
+__attribute__((target("avx2")))
+inline __m256i LowerAVX2(__m256i In) noexcept
+//-----------------------------------------------------------------------------
+{
+	// 'A'..'Z' + 63 are the smallest signed bytes, all below -102
+	auto Upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(-102), _mm256_add_epi8(In, _mm256_set1_epi8(63)));
+	return _mm256_or_si256(In, _mm256_and_si256(Upper, _mm256_set1_epi8(0x20)));
+
+} // LowerAVX2
+
+//-----------------------------------------------------------------------------
+/// returns a bit mask with one bit per byte, set if the lower cased bytes differ
+__attribute__((target("avx2")))
+inline uint32_t MismatchAVX2(const char* pLeft, const char* pRight, bool bLowerRight) noexcept
+//-----------------------------------------------------------------------------
+{
+	auto Left  = LowerAVX2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pLeft)));
+	auto Right = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pRight));
+
+	if (bLowerRight)
+	{
+		Right = LowerAVX2(Right);
+	}
+
+	return ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(Left, Right)));
+
+} // MismatchAVX2
+
+//-----------------------------------------------------------------------------
+/// needs iLen >= 32
+__attribute__((target("avx2")))
+std::size_t MismatchAVX2(const char* pLeft, const char* pRight, std::size_t iLen, bool bLowerRight) noexcept
+//-----------------------------------------------------------------------------
+{
+	std::size_t i = 0;
+
+	for (; i + 32 <= iLen; i += 32)
+	{
+		if (auto iMask = MismatchAVX2(pLeft + i, pRight + i, bLowerRight))
+		{
+			return i + kBitCountRightZero(iMask);
+		}
+	}
+
+	if (i < iLen)
+	{
+		i = iLen - 32;
+
+		if (auto iMask = MismatchAVX2(pLeft + i, pRight + i, bLowerRight))
+		{
+			return i + kBitCountRightZero(iMask);
+		}
+	}
+
+	return iLen;
+
+} // MismatchAVX2
+
+// ----------------------------- 64 bytes ------------------------------------
+
+//-----------------------------------------------------------------------------
+/// the byte set tables for 64 byte vectors
+struct Tables64
+//-----------------------------------------------------------------------------
+{
+	__attribute__((target("avx512f,avx512bw")))
+	Tables64(const uint8_t* pTables) noexcept
+	: LoA    (Broadcast(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pTables))))
+	, LoB    (Broadcast(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pTables + 16))))
+	, HiA    (Broadcast(_mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0)))
+	, HiB    (Broadcast(_mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 4, 8, 16, 32, 64, -128)))
+	, Nibble (_mm512_set1_epi8(0x0f))
+	{
+	}
+
+	/// the shuffles work per 128 bit lane, therefore the tables are needed in all
+	/// lanes - the masked broadcast avoids a false uninitialized warning of gcc 12
+	__attribute__((target("avx512f,avx512bw")))
+	static __m512i Broadcast(__m128i Table) noexcept
+	{
+		return _mm512_mask_broadcast_i32x4(_mm512_setzero_si512(), static_cast<__mmask16>(0xffff), Table);
+	}
+
+	/// returns a bit mask with one bit per input byte in Valid, set if the byte
+	/// is in the set (or not, if bNot) - the masked load does not fault on the
+	/// bytes outside of Valid
+	template<bool bNot>
+	__attribute__((target("avx512f,avx512bw")))
+	uint64_t Match(const char* p, __mmask64 Valid = ~__mmask64(0)) const noexcept
+	{
+		auto In = _mm512_maskz_loadu_epi8(Valid, p);
+		auto Lo = _mm512_and_si512(In, Nibble);
+		auto Hi = _mm512_and_si512(_mm512_srli_epi16(In, 4), Nibble);
+		auto A  = _mm512_and_si512(_mm512_shuffle_epi8(LoA, Lo), _mm512_shuffle_epi8(HiA, Hi));
+		auto B  = _mm512_and_si512(_mm512_shuffle_epi8(LoB, Lo), _mm512_shuffle_epi8(HiB, Hi));
+		auto M  = _mm512_or_si512(A, B);
+
+		return bNot ? _mm512_mask_testn_epi8_mask(Valid, M, M) : _mm512_mask_test_epi8_mask(Valid, M, M);
+	}
+
+	__m512i LoA;
+	__m512i LoB;
+	__m512i HiA;
+	__m512i HiB;
+	__m512i Nibble;
+
+}; // Tables64
+
+//-----------------------------------------------------------------------------
+template<bool bNot>
+__attribute__((target("avx512f,avx512bw")))
+const char* FindAVX512(const char* pHaystack, std::size_t iLen, const uint8_t* pTables) noexcept
+//-----------------------------------------------------------------------------
+{
+	const Tables64 Tables(pTables);
+
+	std::size_t i = 0;
+
+	for (; i + 64 <= iLen; i += 64)
+	{
+		if (auto iMask = Tables.Match<bNot>(pHaystack + i))
+		{
+			return pHaystack + i + kBitCountRightZero(iMask);
+		}
+	}
+
+	if (i < iLen)
+	{
+		if (auto iMask = Tables.Match<bNot>(pHaystack + i, (1ull << (iLen - i)) - 1))
+		{
+			return pHaystack + i + kBitCountRightZero(iMask);
+		}
+	}
+
+	return nullptr;
+
+} // FindAVX512
+
+//-----------------------------------------------------------------------------
+template<bool bNot>
+__attribute__((target("avx512f,avx512bw")))
+const char* RFindAVX512(const char* pHaystack, std::size_t iLen, const uint8_t* pTables) noexcept
+//-----------------------------------------------------------------------------
+{
+	const Tables64 Tables(pTables);
+
+	while (iLen >= 64)
+	{
+		iLen -= 64;
+
+		if (auto iMask = Tables.Match<bNot>(pHaystack + iLen))
+		{
+			return pHaystack + iLen + 63 - kBitCountLeftZero(iMask);
+		}
+	}
+
+	if (iLen)
+	{
+		if (auto iMask = Tables.Match<bNot>(pHaystack, (1ull << iLen) - 1))
+		{
+			return pHaystack + 63 - kBitCountLeftZero(iMask);
+		}
+	}
+
+	return nullptr;
+
+} // RFindAVX512
+
+//-----------------------------------------------------------------------------
+/// converts 'A'..'Z' to lower case
+__attribute__((target("avx512f,avx512bw")))
+inline __m512i LowerAVX512(__m512i In) noexcept
+//-----------------------------------------------------------------------------
+{
+	auto Upper = _mm512_cmplt_epu8_mask(_mm512_sub_epi8(In, _mm512_set1_epi8('A')), _mm512_set1_epi8(26));
+	return _mm512_mask_add_epi8(In, Upper, In, _mm512_set1_epi8(0x20));
+
+} // LowerAVX512
+
+//-----------------------------------------------------------------------------
+/// returns a bit mask with one bit per byte in Valid, set if the lower cased bytes differ
+__attribute__((target("avx512f,avx512bw")))
+inline uint64_t MismatchAVX512(const char* pLeft, const char* pRight, bool bLowerRight, __mmask64 Valid) noexcept
+//-----------------------------------------------------------------------------
+{
+	auto Left  = LowerAVX512(_mm512_maskz_loadu_epi8(Valid, pLeft));
+	auto Right = _mm512_maskz_loadu_epi8(Valid, pRight);
+
+	if (bLowerRight)
+	{
+		Right = LowerAVX512(Right);
+	}
+
+	return _mm512_mask_cmpneq_epi8_mask(Valid, Left, Right);
+
+} // MismatchAVX512
+
+//-----------------------------------------------------------------------------
+__attribute__((target("avx512f,avx512bw")))
+std::size_t MismatchAVX512(const char* pLeft, const char* pRight, std::size_t iLen, bool bLowerRight) noexcept
+//-----------------------------------------------------------------------------
+{
+	std::size_t i = 0;
+
+	for (; i + 64 <= iLen; i += 64)
+	{
+		if (auto iMask = MismatchAVX512(pLeft + i, pRight + i, bLowerRight, ~__mmask64(0)))
+		{
+			return i + kBitCountRightZero(iMask);
+		}
+	}
+
+	if (i < iLen)
+	{
+		if (auto iMask = MismatchAVX512(pLeft + i, pRight + i, bLowerRight, (1ull << (iLen - i)) - 1))
+		{
+			return i + kBitCountRightZero(iMask);
+		}
+	}
+
+	return iLen;
+
+} // MismatchAVX512
+
+//-----------------------------------------------------------------------------
+template<bool bNot>
+const char* Find(const char* pHaystack, std::size_t iLen, const uint8_t* pTables) noexcept
+//-----------------------------------------------------------------------------
+{
+	auto Level = KSimd::GetLevel();
+
+	if (Level >= KSimd::AVX512BW)
+	{
+		return FindAVX512<bNot>(pHaystack, iLen, pTables);
+	}
+
+	if (Level >= KSimd::AVX2 && iLen >= 32)
+	{
+		return FindAVX2<bNot>(pHaystack, iLen, pTables);
+	}
+
+	if (Level >= KSimd::SSSE3 && iLen >= 16)
+	{
+		return FindSSSE3<bNot>(pHaystack, iLen, pTables);
+	}
+
+	return FindScalar<bNot>(pHaystack, iLen, pTables);
+
+} // Find
+
+//-----------------------------------------------------------------------------
+template<bool bNot>
+const char* RFind(const char* pHaystack, std::size_t iLen, const uint8_t* pTables) noexcept
+//-----------------------------------------------------------------------------
+{
+	auto Level = KSimd::GetLevel();
+
+	if (Level >= KSimd::AVX512BW)
+	{
+		return RFindAVX512<bNot>(pHaystack, iLen, pTables);
+	}
+
+	if (Level >= KSimd::AVX2 && iLen >= 32)
+	{
+		return RFindAVX2<bNot>(pHaystack, iLen, pTables);
+	}
+
+	if (Level >= KSimd::SSSE3 && iLen >= 16)
+	{
+		return RFindSSSE3<bNot>(pHaystack, iLen, pTables);
+	}
+
+	return RFindScalar<bNot>(pHaystack, iLen, pTables);
+
+} // RFind
+
+} // end of anonymous namespace
+
+//-----------------------------------------------------------------------------
+const char* kFindByteset(const char* pHaystack, std::size_t iLen, const uint8_t* pTables) noexcept
+//-----------------------------------------------------------------------------
+{
+	return Find<false>(pHaystack, iLen, pTables);
+}
+
+//-----------------------------------------------------------------------------
+const char* kFindBytesetNot(const char* pHaystack, std::size_t iLen, const uint8_t* pTables) noexcept
+//-----------------------------------------------------------------------------
+{
+	return Find<true>(pHaystack, iLen, pTables);
+}
+
+//-----------------------------------------------------------------------------
+const char* kRFindByteset(const char* pHaystack, std::size_t iLen, const uint8_t* pTables) noexcept
+//-----------------------------------------------------------------------------
+{
+	return RFind<false>(pHaystack, iLen, pTables);
+}
+
+//-----------------------------------------------------------------------------
+const char* kRFindBytesetNot(const char* pHaystack, std::size_t iLen, const uint8_t* pTables) noexcept
+//-----------------------------------------------------------------------------
+{
+	return RFind<true>(pHaystack, iLen, pTables);
+}
+
+//-----------------------------------------------------------------------------
+std::size_t kCaselessMismatch(const char* pLeft, const char* pRight, std::size_t iLen, bool bLowerRight) noexcept
+//-----------------------------------------------------------------------------
+{
+	auto Level = KSimd::GetLevel();
+
+	if (Level >= KSimd::AVX512BW)
+	{
+		return MismatchAVX512(pLeft, pRight, iLen, bLowerRight);
+	}
+
+	if (Level >= KSimd::AVX2 && iLen >= 32)
+	{
+		return MismatchAVX2(pLeft, pRight, iLen, bLowerRight);
+	}
+
+	if (Level >= KSimd::SSE2 && iLen >= 16)
+	{
+		return MismatchSSE2(pLeft, pRight, iLen, bLowerRight);
+	}
+
+	return MismatchScalar(pLeft, pRight, iLen, bLowerRight);
+
+} // kCaselessMismatch
+
+} // end of namespace x86
+} // end of namespace detail
+DEKAF2_NAMESPACE_END
+
+#endif // DEKAF2_HAS_X86_SIMD_DISPATCH
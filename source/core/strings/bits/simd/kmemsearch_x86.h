@@ -0,0 +1,123 @@
+/*
+//
+// DEKAF(tm): Lighter, Faster, Smarter(tm)
+//
+// Copyright (c) 2026, Ridgeware, Inc.
+//
+// +-------------------------------------------------------------------------+
+// | /\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\|
+// |/+---------------------------------------------------------------------+/|
+// |/|                                                                     |/|
+// |\|  ** THIS NOTICE MUST NOT BE REMOVED FROM THE SOURCE CODE MODULE **  |\|
+// |/|                                                                     |/|
+// |\|   OPEN SOURCE LICENSE                                               |\|
+// |/|                                                                     |/|
+// |\|   Permission is hereby granted, free of charge, to any person       |\|
+// |/|   obtaining a copy of this software and associated                  |/|
+// |\|   documentation files (the "Software"), to deal in the              |\|
+// |/|   Software without restriction, including without limitation        |/|
+// |\|   the rights to use, copy, modify, merge, publish,                  |\|
+// |/|   distribute, sublicense, and/or sell copies of the Software,       |/|
+// |\|   and to permit persons to whom the Software is furnished to        |\|
+// |/|   do so, subject to the following conditions:                       |/|
+// |\|                                                                     |\|
+// |/|   The above copyright notice and this permission notice shall       |/|
+// |\|   be included in all copies or substantial portions of the          |\|
+// |/|   Software.                                                         |/|
+// |\|                                                                     |\|
+// |/|   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY         |/|
+// |\|   KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE        |\|
+// |/|   WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR           |/|
+// |\|   PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS        |\|
+// |/|   OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR          |/|
+// |\|   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR        |\|
+// |/|   OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE         |/|
+// |\|   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.            |\|
+// |/|                                                                     |/|
+// |/+---------------------------------------------------------------------+/|
+// |\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/ |
+// +-------------------------------------------------------------------------+
+//
+*/
+
+#pragma once
+
+/// @file kmemsearch_x86.h
+/// X86 kernels that are selected at run time from the instruction set level
+/// (see KSimd): the byte set search behind KFindSetOfChars and the first
+/// mismatch of a caseless compare. Each kernel has SSE2 or SSSE3, AVX2 and
+/// AVX-512BW variants and a scalar fallback.
+///
+/// The byte sets use the nibble table layout: 32 bytes, where the low nibble
+/// of a byte value ch selects one of 16 table bytes, the highest bit of ch
+/// selects the first or the second 16 bytes, and bits 4..6 of ch select the
+/// bit in the table byte. A byte shuffle instruction then looks up 16, 32 or
+/// 64 input bytes at once.
+
+#include <dekaf2/core/init/kdefinitions.h>
+#include <dekaf2/core/strings/bits/simd/ksimd.h>
+#include <cstddef>
+#include <cstdint>
+
+#if DEKAF2_HAS_X86_SIMD_DISPATCH
+
+DEKAF2_NAMESPACE_BEGIN
+namespace detail {
+namespace x86    {
+
+/// returns the index of the nibble table byte that holds the bit for ch
+DEKAF2_NODISCARD DEKAF2_CONSTEXPR_14
+inline std::size_t NibbleTableByte(uint8_t ch) noexcept
+{
+	return ((ch >> 7) << 4) | (ch & 0x0f);
+}
+
+/// returns the bit in the nibble table byte for ch
+DEKAF2_NODISCARD DEKAF2_CONSTEXPR_14
+inline uint8_t NibbleTableBit(uint8_t ch) noexcept
+{
+	return static_cast<uint8_t>(1u << ((ch >> 4) & 0x07));
+}
+
+/// Forward scan: find the first byte in haystack[0..iLen) that is a member of
+/// the byte set in the nibble tables pTables.
+/// @param pHaystack start of the haystack
+/// @param iLen      haystack length in bytes
+/// @param pTables   the 32 bytes of nibble tables of the byte set
+/// @return pointer to the first matching byte, or nullptr if none.
+DEKAF2_NODISCARD DEKAF2_PUBLIC
+const char* kFindByteset(const char* pHaystack, std::size_t iLen, const uint8_t* pTables) noexcept;
+
+/// Forward scan: find the first byte in haystack[0..iLen) that is not a member
+/// of the byte set in the nibble tables pTables.
+/// @return pointer to the first non-matching byte, or nullptr if none.
+DEKAF2_NODISCARD DEKAF2_PUBLIC
+const char* kFindBytesetNot(const char* pHaystack, std::size_t iLen, const uint8_t* pTables) noexcept;
+
+/// Backward scan: find the last byte in haystack[0..iLen) that is a member of
+/// the byte set in the nibble tables pTables.
+/// @return pointer to the last matching byte, or nullptr if none.
+DEKAF2_NODISCARD DEKAF2_PUBLIC
+const char* kRFindByteset(const char* pHaystack, std::size_t iLen, const uint8_t* pTables) noexcept;
+
+/// Backward scan: find the last byte in haystack[0..iLen) that is not a member
+/// of the byte set in the nibble tables pTables.
+/// @return pointer to the last non-matching byte, or nullptr if none.
+DEKAF2_NODISCARD DEKAF2_PUBLIC
+const char* kRFindBytesetNot(const char* pHaystack, std::size_t iLen, const uint8_t* pTables) noexcept;
+
+/// Find the first position at which two buffers differ after converting ASCII
+/// upper case letters to lower case.
+/// @param pLeft       the first buffer
+/// @param pRight      the second buffer
+/// @param iLen        the length of both buffers
+/// @param bLowerRight if false, pRight is compared as is, as it is known to be lower case
+/// @return the offset of the first difference, or iLen if both are equal
+DEKAF2_NODISCARD DEKAF2_PUBLIC
+std::size_t kCaselessMismatch(const char* pLeft, const char* pRight, std::size_t iLen, bool bLowerRight) noexcept;
+
+} // end of namespace x86
+} // end of namespace detail
+DEKAF2_NAMESPACE_END
+
+#endif // DEKAF2_HAS_X86_SIMD_DISPATCH
@@ -0,0 +1,218 @@
+/*
+//
+// DEKAF(tm): Lighter, Faster, Smarter(tm)
+//
+// Copyright (c) 2026, Ridgeware, Inc.
+//
+// +-------------------------------------------------------------------------+
+// | /\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\|
+// |/+---------------------------------------------------------------------+/|
+// |/|                                                                     |/|
+// |\|  ** THIS NOTICE MUST NOT BE REMOVED FROM THE SOURCE CODE MODULE **  |\|
+// |/|                                                                     |/|
+// |\|   OPEN SOURCE LICENSE                                               |\|
+// |/|                                                                     |/|
+// |\|   Permission is hereby granted, free of charge, to any person       |\|
+// |/|   obtaining a copy of this software and associated                  |/|
+// |\|   documentation files (the "Software"), to deal in the              |\|
+// |/|   Software without restriction, including without limitation        |/|
+// |\|   the rights to use, copy, modify, merge, publish,                  |\|
+// |/|   distribute, sublicense, and/or sell copies of the Software,       |/|
+// |\|   and to permit persons to whom the Software is furnished to        |\|
+// |/|   do so, subject to the following conditions:                       |/|
+// |\|                                                                     |\|
+// |/|   The above copyright notice and this permission notice shall       |/|
+// |\|   be included in all copies or substantial portions of the          |\|
+// |/|   Software.                                                         |/|
+// |\|                                                                     |\|
+// |/|   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY         |/|
+// |\|   KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE        |\|
+// |/|   WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR           |/|
+// |\|   PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS        |\|
+// |/|   OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR          |/|
+// |\|   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR        |\|
+// |/|   OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE         |/|
+// |\|   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.            |\|
+// |/|                                                                     |/|
+// |/+---------------------------------------------------------------------+/|
+// |\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/ |
+// +-------------------------------------------------------------------------+
+//
+*/
+
+#include <dekaf2/core/strings/bits/simd/ksimd.h>
+#include <dekaf2/core/strings/bits/simd/kutf.h>
+#include <dekaf2/core/strings/bits/simd/kmemsearch_neon.h>
+#include <dekaf2/core/strings/kstringview.h>
+#include <cstdlib>
+
+DEKAF2_NAMESPACE_BEGIN
+
+namespace detail {
+
+namespace {
+
+constexpr KStringView s_LevelNames[]
+{
+	"scalar",
+	"sse2",
+	"ssse3",
+	"sse4.2",
+	"avx2",
+	"avx512",
+	"neon"
+};
+
+//-----------------------------------------------------------------------------
+KSimd::Level DetectCPULevel() noexcept
+//-----------------------------------------------------------------------------
+{
+#if DEKAF2_HAS_X86_SIMD_DISPATCH
+	__builtin_cpu_init();
+
+	if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+	{
+		return KSimd::AVX512BW;
+	}
+
+	if (__builtin_cpu_supports("avx2"))
+	{
+		return KSimd::AVX2;
+	}
+
+	if (__builtin_cpu_supports("sse4.2"))
+	{
+		return KSimd::SSE42;
+	}
+
+	if (__builtin_cpu_supports("ssse3"))
+	{
+		return KSimd::SSSE3;
+	}
+
+	return KSimd::SSE2;
+#elif DEKAF2_HAS_NEON
+	return KSimd::NEON;
+#elif defined(DEKAF2_X86_64)
+	return KSimd::SSE2;
+#else
+	return KSimd::Scalar;
+#endif
+
+} // DetectCPULevel
+
+//-----------------------------------------------------------------------------
+/// the initial level, before the CPU is inspected - this is what the target
+/// guarantees, and all kernels are correct for it
+constexpr KSimd::Level BaseLevel()
+//-----------------------------------------------------------------------------
+{
+#if DEKAF2_HAS_NEON
+	return KSimd::NEON;
+#elif defined(DEKAF2_X86_64)
+	return KSimd::SSE2;
+#else
+	return KSimd::Scalar;
+#endif
+
+} // BaseLevel
+
+} // end of anonymous namespace
+
+// kernels that run during static initialization, before the CPU was
+// inspected, use the base level of the target
+std::atomic<uint8_t> KSimd::s_Level { BaseLevel() };
+
+//-----------------------------------------------------------------------------
+KSimd::Level KSimd::GetCPULevel() noexcept
+//-----------------------------------------------------------------------------
+{
+	static const Level CPULevel = DetectCPULevel();
+	return CPULevel;
+
+} // GetCPULevel
+
+//-----------------------------------------------------------------------------
+KSimd::Level KSimd::Clamp(Level Requested) noexcept
+//-----------------------------------------------------------------------------
+{
+	auto CPULevel = GetCPULevel();
+
+	if (CPULevel == NEON)
+	{
+		// NEON and the X86 levels do not mix
+		return (Requested == Scalar) ? Scalar : NEON;
+	}
+
+	return (Requested > CPULevel) ? CPULevel : Requested;
+
+} // Clamp
+
+//-----------------------------------------------------------------------------
+KSimd::Level KSimd::SetLevel(Level Requested) noexcept
+//-----------------------------------------------------------------------------
+{
+	auto Level = Clamp(Requested);
+
+	s_Level.store(Level, std::memory_order_relaxed);
+
+#if DEKAF2_WITH_SIMDUTF
+	kutf::simd::select_implementation(Level);
+#endif
+
+	return Level;
+
+} // SetLevel
+
+//-----------------------------------------------------------------------------
+KSimd::Level KSimd::SetLevel(KStringView sLevel) noexcept
+//-----------------------------------------------------------------------------
+{
+	for (uint8_t iLevel = 0; iLevel < sizeof(s_LevelNames) / sizeof(s_LevelNames[0]); ++iLevel)
+	{
+		if (sLevel == s_LevelNames[iLevel])
+		{
+			return SetLevel(static_cast<Level>(iLevel));
+		}
+	}
+
+	return GetLevel();
+
+} // SetLevel
+
+//-----------------------------------------------------------------------------
+KStringView KSimd::ToString(Level Which) noexcept
+//-----------------------------------------------------------------------------
+{
+	return (Which < sizeof(s_LevelNames) / sizeof(s_LevelNames[0])) ? s_LevelNames[Which] : KStringView{};
+
+} // ToString
+
+//-----------------------------------------------------------------------------
+bool KSimd::Initialize() noexcept
+//-----------------------------------------------------------------------------
+{
+	// we use getenv() and not kGetEnv() as this runs during static initialization
+	const char* sLevel = std::getenv("DEKAF2_SIMD");
+
+	for (uint8_t iLevel = 0; sLevel && iLevel < sizeof(s_LevelNames) / sizeof(s_LevelNames[0]); ++iLevel)
+	{
+		if (s_LevelNames[iLevel] == sLevel)
+		{
+			SetLevel(static_cast<Level>(iLevel));
+			return true;
+		}
+	}
+
+	// without a request we do not touch simdutf, it selects its kernel itself
+	s_Level.store(GetCPULevel(), std::memory_order_relaxed);
+
+	return true;
+
+} // Initialize
+
+const bool KSimd::s_bInitialized = KSimd::Initialize();
+
+} // end of namespace detail
+
+DEKAF2_NAMESPACE_END
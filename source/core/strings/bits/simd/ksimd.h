@@ -0,0 +1,136 @@
+/*
+//
+// DEKAF(tm): Lighter, Faster, Smarter(tm)
+//
+// Copyright (c) 2026, Ridgeware, Inc.
+//
+// +-------------------------------------------------------------------------+
+// | /\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\|
+// |/+---------------------------------------------------------------------+/|
+// |/|                                                                     |/|
+// |\|  ** THIS NOTICE MUST NOT BE REMOVED FROM THE SOURCE CODE MODULE **  |\|
+// |/|                                                                     |/|
+// |\|   OPEN SOURCE LICENSE                                               |\|
+// |/|                                                                     |/|
+// |\|   Permission is hereby granted, free of charge, to any person       |\|
+// |/|   obtaining a copy of this software and associated                  |/|
+// |\|   documentation files (the "Software"), to deal in the              |\|
+// |/|   Software without restriction, including without limitation        |/|
+// |\|   the rights to use, copy, modify, merge, publish,                  |\|
+// |/|   distribute, sublicense, and/or sell copies of the Software,       |/|
+// |\|   and to permit persons to whom the Software is furnished to        |\|
+// |/|   do so, subject to the following conditions:                       |/|
+// |\|                                                                     |\|
+// |/|   The above copyright notice and this permission notice shall       |/|
+// |\|   be included in all copies or substantial portions of the          |\|
+// |/|   Software.                                                         |/|
+// |\|                                                                     |\|
+// |/|   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY         |/|
+// |\|   KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE        |\|
+// |/|   WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR           |/|
+// |\|   PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS        |\|
+// |/|   OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR          |/|
+// |\|   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR        |\|
+// |/|   OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE         |/|
+// |\|   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.            |\|
+// |/|                                                                     |/|
+// |/+---------------------------------------------------------------------+/|
+// |\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/ |
+// +-------------------------------------------------------------------------+
+//
+*/
+
+#pragma once
+
+/// @file ksimd.h
+/// The instruction set level for the string kernels that are selected at run
+/// time. On X86 the kernels for memsearch, sets of chars, caseless compares,
+/// escape scans and UTF validation are compiled for several instruction sets,
+/// and the best one the CPU supports is used. The level can be lowered by the
+/// environment variable DEKAF2_SIMD (scalar, sse2, ssse3, sse4.2, avx2 or
+/// avx512) at program start, or by KSimd::SetLevel(), to test and benchmark
+/// the other kernels. On ARM64 NEON is selected at compile time.
+
+#include <dekaf2/core/init/kdefinitions.h>
+#include <atomic>
+#include <cstdint>
+
+// the kernels for higher instruction sets are compiled per function with the
+// target attribute, which MSVC does not have
+#if defined(DEKAF2_X86_64) && (defined(DEKAF2_IS_GCC) || defined(DEKAF2_IS_CLANG))
+	#define DEKAF2_HAS_X86_SIMD_DISPATCH 1
+#else
+	#define DEKAF2_HAS_X86_SIMD_DISPATCH 0
+#endif
+
+DEKAF2_NAMESPACE_BEGIN
+
+// this header is reached from kstringview.h through kfindsetofchars.h
+class KStringView;
+
+namespace detail {
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+/// selects the instruction set level of the run time dispatched string kernels
+class DEKAF2_PUBLIC KSimd
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+{
+
+//------
+public:
+//------
+
+	/// the instruction set levels, each one includes the ones below it
+	enum Level : uint8_t
+	{
+		Scalar   = 0, ///< no SIMD at all
+		SSE2     = 1, ///< baseline of every X86-64 CPU
+		SSSE3    = 2, ///< adds byte shuffles
+		SSE42    = 3, ///< adds string compares
+		AVX2     = 4, ///< 32 byte vectors
+		AVX512BW = 5, ///< 64 byte vectors with byte operations and masks
+		NEON     = 6  ///< ARM64, selected at compile time
+	};
+
+	/// returns the level the kernels currently use
+	DEKAF2_NODISCARD
+	static Level GetLevel() noexcept
+	{
+		return static_cast<Level>(s_Level.load(std::memory_order_relaxed));
+	}
+
+	/// returns the highest level this CPU supports
+	DEKAF2_NODISCARD
+	static Level GetCPULevel() noexcept;
+
+	/// sets the level for all kernels, but never higher than GetCPULevel()
+	/// @param Requested the requested level
+	/// @return the level that is used now
+	static Level SetLevel(Level Requested) noexcept;
+
+	/// sets the level for all kernels by its name, see ToString()
+	/// @param sLevel the name of the requested level
+	/// @return the level that is used now, it does not change if sLevel is unknown
+	static Level SetLevel(KStringView sLevel) noexcept;
+
+	/// returns the name of a level, the same as accepted by SetLevel() and DEKAF2_SIMD
+	DEKAF2_NODISCARD
+	static KStringView ToString(Level Which) noexcept;
+
+//------
+private:
+//------
+
+	DEKAF2_NODISCARD
+	static Level Clamp(Level Requested) noexcept;
+
+	static bool Initialize() noexcept;
+
+	static std::atomic<uint8_t> s_Level;
+	static const bool           s_bInitialized;
+
+}; // KSimd
+
+} // end of namespace detail
+
+DEKAF2_NAMESPACE_END
@@ -209,6 +209,42 @@ result validate_utf32_with_errors(const char32_t* buf, std::size_t len) noexcept
 	return ToResult(::simdutf::validate_utf32_with_errors(buf, len));
 }
 
+bool select_implementation(DEKAF2_PREFIX detail::KSimd::Level MaxLevel) noexcept
+{
+	using KSimd = DEKAF2_PREFIX detail::KSimd;
+
+	// the simdutf implementations from best to worst, with the level they need
+	static constexpr struct
+	{
+		const char*  sName;
+		KSimd::Level Needs;
+	}
+	Implementations[]
+	{
+		{ "icelake" , KSimd::AVX512BW },
+		{ "haswell" , KSimd::AVX2     },
+		{ "westmere", KSimd::SSE42    },
+		{ "arm64"   , KSimd::NEON     },
+		{ "fallback", KSimd::Scalar   }
+	};
+
+	for (const auto& Implementation : Implementations)
+	{
+		if (Implementation.Needs <= MaxLevel)
+		{
+			auto* pImplementation = ::simdutf::get_available_implementations()[Implementation.sName];
+
+			if (pImplementation && pImplementation->supported_by_runtime_system())
+			{
+				::simdutf::get_active_implementation() = pImplementation;
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
 } // end of namespace simd
 } // end of namespace kutf
 
@@ -47,6 +47,8 @@
 
 #if DEKAF2_WITH_SIMDUTF
 
+#include <dekaf2/core/strings/bits/simd/ksimd.h>
+
 DEKAF2_NAMESPACE_BEGIN
 
 namespace kutf {
@@ -498,6 +500,15 @@ bool validate_utf32(const char32_t* buf, std::size_t len) noexcept;
 DEKAF2_NODISCARD
 result validate_utf32_with_errors(const char32_t* buf, std::size_t len) noexcept;
 
+/**
+ * Select the best simdutf implementation that needs no instruction set above
+ * MaxLevel and is supported by this CPU. Called by detail::KSimd::SetLevel().
+ *
+ * @param MaxLevel the highest instruction set level to use
+ * @return true if an implementation was selected
+ */
+bool select_implementation(DEKAF2_PREFIX detail::KSimd::Level MaxLevel) noexcept;
+
 } // end of namespace simd
 } // end of namespace kutf
 
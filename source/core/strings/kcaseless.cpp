@@ -41,6 +41,7 @@
 
 #include <dekaf2/core/strings/kcaseless.h>
 #include <dekaf2/core/strings/kstringutils.h>
+#include <dekaf2/core/strings/bits/simd/kmemsearch_x86.h>
 #include <cctype>
 #include <algorithm>
 #include <array>
@@ -86,9 +87,44 @@ static constexpr std::array<unsigned char, 256> toLowcase =
 };
 
 //-----------------------------------------------------------------------------
-template<class Predicate>
+/// returns the position of the first char that differs after lowercasing left
+/// (and right if bLowerRight is true), or iLen if there is none
+KStringView::size_type kCaseMismatch(const char* left, const char* right,
+									 KStringView::size_type iLen,
+									 bool bLowerRight)
+//-----------------------------------------------------------------------------
+{
+#if DEKAF2_HAS_X86_SIMD_DISPATCH
+	// below one vector the call overhead would dominate
+	if (iLen >= 16)
+	{
+		return detail::x86::kCaselessMismatch(left, right, iLen, bLowerRight);
+	}
+#endif
+
+	for (KStringView::size_type pos = 0; pos < iLen; ++pos)
+	{
+		auto lch = toLowcase[static_cast<unsigned char>(left[pos])];
+		auto rch = static_cast<unsigned char>(right[pos]);
+
+		if (bLowerRight)
+		{
+			rch = toLowcase[rch];
+		}
+
+		if (lch != rch)
+		{
+			return pos;
+		}
+	}
+
+	return iLen;
+
+} // kCaseMismatch
+
+//-----------------------------------------------------------------------------
 bool kCaseEqualInt(KStringView left, KStringView right,
-				   Predicate comp,
+				   bool bLowerRight,
 				   bool bAllowShortCircuit)
 //-----------------------------------------------------------------------------
 {
@@ -104,10 +140,7 @@ bool kCaseEqualInt(KStringView left, KStringView right,
 		return true;
 	}
 
-	return std::equal(left.begin(),
-					  left.end(),
-					  right.begin(),
-					  comp);
+	return kCaseMismatch(left.data(), right.data(), len, bLowerRight) == len;
 
 }
 
@@ -118,21 +151,20 @@ int kCaselessCompare(KStringView left, KStringView right)
 //-----------------------------------------------------------------------------
 {
 	auto len = std::min(left.size(), right.size());
+	auto pos = kCaseMismatch(left.data(), right.data(), len, true);
 
-	for (KStringView::size_type pos = 0; pos < len; ++pos)
+	if (pos < len)
 	{
 		auto lch = toLowcase[static_cast<unsigned char>(left[pos])];
 		auto rch = toLowcase[static_cast<unsigned char>(right[pos])];
-		if (lch != rch)
+
+		if (lch < rch)
 		{
-			if (lch < rch)
-			{
-				return -1;
-			}
-			else
-			{
-				return 1;
-			}
+			return -1;
+		}
+		else
+		{
+			return 1;
 		}
 	}
 
@@ -155,21 +187,20 @@ int kCaselessCompareLeft(KStringView left, KStringView right)
 //-----------------------------------------------------------------------------
 {
 	auto len = std::min(left.size(), right.size());
+	auto pos = kCaseMismatch(left.data(), right.data(), len, false);
 
-	for (KStringView::size_type pos = 0; pos < len; ++pos)
+	if (pos < len)
 	{
 		auto lch = toLowcase[static_cast<unsigned char>(left[pos])];
-		auto rch = right[pos];
-		if (lch != rch)
+		auto rch = static_cast<unsigned char>(right[pos]);
+
+		if (lch < rch)
 		{
-			if (lch < rch)
-			{
-				return -1;
-			}
-			else
-			{
-				return 1;
-			}
+			return -1;
+		}
+		else
+		{
+			return 1;
 		}
 	}
 
@@ -191,22 +222,14 @@ int kCaselessCompareLeft(KStringView left, KStringView right)
 bool kCaselessEqual(KStringView left, KStringView right)
 //-----------------------------------------------------------------------------
 {
-	return kCaseEqualInt(left, right, [](const char c1, const char c2)
-	{
-		return toLowcase[static_cast<unsigned char>(c1)]
-				== toLowcase[static_cast<unsigned char>(c2)];
-	}, true);
+	return kCaseEqualInt(left, right, true, true);
 }
 
 //-----------------------------------------------------------------------------
 bool kCaselessEqualLeft(KStringView left, KStringView right)
 //-----------------------------------------------------------------------------
 {
-	return kCaseEqualInt(left, right, [](const char c1, const char c2)
-	{
-		return toLowcase[static_cast<unsigned char>(c1)]
-				== static_cast<unsigned char>(c2);
-	}, false);
+	return kCaseEqualInt(left, right, false, false);
 }
 
 //-----------------------------------------------------------------------------
@@ -214,11 +237,7 @@ bool kCaselessBeginsWith(KStringView left, KStringView right)
 //-----------------------------------------------------------------------------
 {
 	return (left.size() >= right.size())
-			&& kCaseEqualInt(left.Left(right.size()), right, [](const char c1, const char c2)
-	{
-		return toLowcase[static_cast<unsigned char>(c1)]
-				== toLowcase[static_cast<unsigned char>(c2)];
-	}, true);
+			&& kCaseEqualInt(left.Left(right.size()), right, true, true);
 }
 
 //-----------------------------------------------------------------------------
@@ -226,11 +245,7 @@ bool kCaselessEndsWith(KStringView left, KStringView right)
 //-----------------------------------------------------------------------------
 {
 	return (left.size() >= right.size())
-			&& kCaseEqualInt(left.Right(right.size()), right, [](const char c1, const char c2)
-	{
-		return toLowcase[static_cast<unsigned char>(c1)]
-				== toLowcase[static_cast<unsigned char>(c2)];
-	}, true);
+			&& kCaseEqualInt(left.Right(right.size()), right, true, true);
 }
 
 //----------------------------------------------------------------------
@@ -290,11 +305,7 @@ bool kCaselessBeginsWithLeft(KStringView left, KStringView right)
 //-----------------------------------------------------------------------------
 {
 	return (left.size() >= right.size())
-			&& kCaseEqualInt(left.Left(right.size()), right, [](const char c1, const char c2)
-	{
-		return toLowcase[static_cast<unsigned char>(c1)]
-				== static_cast<unsigned char>(c2);
-	}, false);
+			&& kCaseEqualInt(left.Left(right.size()), right, false, false);
 }
 
 //-----------------------------------------------------------------------------
@@ -302,11 +313,7 @@ bool kCaselessEndsWithLeft(KStringView left, KStringView right)
 //-----------------------------------------------------------------------------
 {
 	return (left.size() >= right.size())
-			&& kCaseEqualInt(left.Right(right.size()), right, [](const char c1, const char c2)
-	{
-		return toLowcase[static_cast<unsigned char>(c1)]
-				== static_cast<unsigned char>(c2);
-	}, false);
+			&& kCaseEqualInt(left.Right(right.size()), right, false, false);
 }
 
 //-----------------------------------------------------------------------------
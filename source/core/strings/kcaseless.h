@@ -173,7 +173,7 @@ DEKAF2_CONSTEXPR_14
 std::size_t kCalcCaselessHash(KStringView sv)
 //-----------------------------------------------------------------------------
 {
-	return kCaseHash(sv.data(), sv.size());
+	return kStringCaseHash(sv.data(), sv.size());
 }
 
 //-----------------------------------------------------------------------------
@@ -338,7 +338,7 @@ public:
 	void                    shrink_to_fit()                   { m_rep.shrink_to_fit();       }
 	/// resize the string to n characters without initializing new storage (performance optimization)
 	void                    resize_uninitialized(size_type n);
-	/// returns a hash value for the string content
+	/// returns a hash value for the string content, matching the _hash literal
 	DEKAF2_NODISCARD DEKAF2_CONSTEXPR_STRING
 	std::size_t             Hash()             const;
 	/// returns a case-insensitive hash value for the string content
@@ -2538,17 +2538,17 @@ namespace std
 		// we actually use a KStringView as the parameter, as this avoids
 		// accidentially constructing a KString if coming from a KStringView
 		// or char* in a template that uses KString as elements
-		DEKAF2_CONSTEXPR_14 std::size_t operator()(DEKAF2_PREFIX KStringView sv) const noexcept
+		DEKAF2_STD_STRING_HASH_CONSTEXPR_14 std::size_t operator()(DEKAF2_PREFIX KStringView sv) const noexcept
 		{
-			return DEKAF2_PREFIX kHash(sv.data(), sv.size());
+			return DEKAF2_PREFIX kStdStringHash(sv.data(), sv.size());
 		}
 
 		// and provide an explicit hash function for const char*, as this avoids
 		// counting twice over the char array (KStringView's constructor counts
 		// the size of the array)
-		DEKAF2_CONSTEXPR_14 std::size_t operator()(const char* s) const noexcept
+		DEKAF2_STD_STRING_HASH_CONSTEXPR_14 std::size_t operator()(const char* s) const noexcept
 		{
-			return DEKAF2_PREFIX kHash(s);
+			return DEKAF2_PREFIX kStdStringHash(s);
 		}
 	};
 
@@ -2597,14 +2597,14 @@ DEKAF2_NAMESPACE_END
 DEKAF2_CONSTEXPR_STRING std::size_t DEKAF2_PREFIX KString::Hash() const
 //----------------------------------------------------------------------
 {
-	return std::hash<DEKAF2_PREFIX KString>()(KStringView(*this));
+	return DEKAF2_PREFIX kStringHash(data(), size());
 }
 
 //----------------------------------------------------------------------
 DEKAF2_CONSTEXPR_STRING std::size_t DEKAF2_PREFIX KString::CaseHash() const
 //----------------------------------------------------------------------
 {
-	return DEKAF2_PREFIX kCaseHash(data(), size());
+	return DEKAF2_PREFIX kStringCaseHash(data(), size());
 }
 
 namespace DEKAF2_FORMAT_NAMESPACE {
@@ -1285,7 +1285,8 @@ public:
 	}
 
 	//-----------------------------------------------------------------------------
-	/// nonstandard: output the hash value of instance by calling std::hash() for the type
+	/// nonstandard: output the hash value of instance, matching the _hash literal - unlike
+	/// std::hash() for the type, which may be seeded per process
 	DEKAF2_NODISCARD DEKAF2_CONSTEXPR_14
 	std::size_t Hash() const;
 	//-----------------------------------------------------------------------------
@@ -2032,14 +2033,14 @@ namespace std
 	{
 		using is_transparent = void;
 
-		DEKAF2_CONSTEXPR_14 std::size_t operator()(DEKAF2_PREFIX KStringView s) const noexcept
+		DEKAF2_STD_STRING_HASH_CONSTEXPR_14 std::size_t operator()(DEKAF2_PREFIX KStringView s) const noexcept
 		{
-			return DEKAF2_PREFIX kHash(s.data(), s.size());
+			return DEKAF2_PREFIX kStdStringHash(s.data(), s.size());
 		}
 
-		DEKAF2_CONSTEXPR_14 std::size_t operator()(const char* s) const noexcept
+		DEKAF2_STD_STRING_HASH_CONSTEXPR_14 std::size_t operator()(const char* s) const noexcept
 		{
-			return DEKAF2_PREFIX kHash(s);
+			return DEKAF2_PREFIX kStdStringHash(s);
 		}
 	};
 
@@ -2065,14 +2066,14 @@ DEKAF2_NAMESPACE_END
 DEKAF2_CONSTEXPR_14 DEKAF2_PUBLIC std::size_t DEKAF2_PREFIX KStringView::Hash() const
 //----------------------------------------------------------------------
 {
-	return std::hash<DEKAF2_PREFIX KStringView>()(*this);
+	return DEKAF2_PREFIX kStringHash(data(), size());
 }
 
 //----------------------------------------------------------------------
 DEKAF2_CONSTEXPR_14 DEKAF2_PUBLIC std::size_t DEKAF2_PREFIX KStringView::CaseHash() const
 //----------------------------------------------------------------------
 {
-	return DEKAF2_PREFIX kCaseHash(data(), size());
+	return DEKAF2_PREFIX kStringCaseHash(data(), size());
 }
 
 #include <dekaf2/core/strings/bits/kstringviewz.h>
@@ -185,6 +185,35 @@ struct is_pod
 	  std::is_trivial<T>::value
 > {};
 
+template< class, class = std::void_t<> >
+struct has_transparent_hash : std::false_type { };
+
+// a transparent std::hash<Key> hashes other lookup types without converting them into a Key
+template< class Key >
+struct has_transparent_hash<Key, std::void_t<typename std::hash<Key>::is_transparent>> : std::true_type { };
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+/// hashes lookup keys of other types than Key like std::hash<Key> - as they are if
+/// std::hash<Key> is transparent, else after one explicit conversion into a Key
+template<class Key>
+struct transparent_hash
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+{
+	template<class K,
+	         typename std::enable_if<has_transparent_hash<Key>::value || std::is_same<typename std::decay<K>::type, Key>::value, int>::type = 0>
+	std::size_t operator()(const K& key) const
+	{
+		return std::hash<Key>()(key);
+	}
+
+	template<class K,
+	         typename std::enable_if<!has_transparent_hash<Key>::value && !std::is_same<typename std::decay<K>::type, Key>::value, int>::type = 0>
+	std::size_t operator()(const K& key) const
+	{
+		return std::hash<Key>()(Key(key));
+	}
+};
+
 
 } // of namespace detail
 
@@ -43,7 +43,7 @@
 #pragma once
 
 /// @file khash.h
-/// provides a Fowler-Noll-Vo hash
+/// provides a Fowler-Noll-Vo hash, and a faster wyhash based hash for longer strings
 
 #include <dekaf2/core/init/kdefinitions.h>
 #include <dekaf2/core/types/kctype.h> // for ASCII lowercase conversion
@@ -204,23 +204,213 @@ Hash casehash_constexpr(char c, const char* data, Hash hash) noexcept
 
 }; // fnv1a
 
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+/// A seeded hash after the final version of Wang Yi's wyhash, which processes
+/// 8 to 48 bytes per step instead of one byte like FNV. Input words are read
+/// byte by byte in little endian order, which compilers merge into single
+/// loads - this keeps the hash constexpr and endianess independent. The
+/// casehash() variants lowercase ASCII characters word by word.
+struct wyhash
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+{
+	using Hash = uint64_t;
+
+	static constexpr Hash Secret0     = UINT64_C(0x2d358dccaa6c78a5);
+	static constexpr Hash Secret1     = UINT64_C(0x8bb84b93962eacc9);
+	static constexpr Hash Secret2     = UINT64_C(0x4b33a62ed433d4a3);
+	static constexpr Hash Secret3     = UINT64_C(0x4d5a2da51de1aa47);
+	static constexpr Hash DefaultSeed = UINT64_C(0xa0761d6478bd642f);
+
+static DEKAF2_CONSTEXPR_14
+void mum(Hash& A, Hash& B) noexcept
+{
+#ifdef __SIZEOF_INT128__
+	unsigned __int128 r = A;
+	r *= B;
+	A = static_cast<Hash>(r);
+	B = static_cast<Hash>(r >> 64);
+#else
+	Hash ha = A >> 32, hb = B >> 32, la = static_cast<uint32_t>(A), lb = static_cast<uint32_t>(B);
+	Hash rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32);
+	Hash c  = t < rl;
+	Hash lo = t + (rm1 << 32);
+	c += lo < t;
+	A = lo;
+	B = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+static DEKAF2_CONSTEXPR_14
+Hash mix(Hash A, Hash B) noexcept
+{
+	mum(A, B);
+	return A ^ B;
+}
+
+/// lowercase all ASCII characters of a word in parallel
+static constexpr
+Hash lower(Hash w) noexcept
+{
+	return w | ((~w & UINT64_C(0x8080808080808080)
+	            & (((w & UINT64_C(0x7f7f7f7f7f7f7f7f)) + UINT64_C(0x3f3f3f3f3f3f3f3f))   // >= 'A'
+	            ^  ((w & UINT64_C(0x7f7f7f7f7f7f7f7f)) + UINT64_C(0x2525252525252525)))) // >  'Z'
+	            >> 2);
+}
+
+static constexpr
+Hash byte(const char* p, int iShift) noexcept
+{
+	return static_cast<Hash>(static_cast<unsigned char>(*p)) << iShift;
+}
+
+template<bool bLower>
+static constexpr
+Hash read8(const char* p) noexcept
+{
+	return bLower
+		? lower(byte(p, 0) | byte(p + 1,  8) | byte(p + 2, 16) | byte(p + 3, 24)
+		      | byte(p + 4, 32) | byte(p + 5, 40) | byte(p + 6, 48) | byte(p + 7, 56))
+		:       byte(p, 0) | byte(p + 1,  8) | byte(p + 2, 16) | byte(p + 3, 24)
+		      | byte(p + 4, 32) | byte(p + 5, 40) | byte(p + 6, 48) | byte(p + 7, 56);
+}
+
+template<bool bLower>
+static constexpr
+Hash read4(const char* p) noexcept
+{
+	return bLower
+		? lower(byte(p, 0) | byte(p + 1, 8) | byte(p + 2, 16) | byte(p + 3, 24))
+		:       byte(p, 0) | byte(p + 1, 8) | byte(p + 2, 16) | byte(p + 3, 24);
+}
+
+template<bool bLower>
+static constexpr
+Hash read3(const char* p, std::size_t k) noexcept
+{
+	return bLower
+		? lower((byte(p, 16) | byte(p + (k >> 1), 8) | byte(p + k - 1, 0)))
+		:        byte(p, 16) | byte(p + (k >> 1), 8) | byte(p + k - 1, 0);
+}
+
+template<bool bLower>
+static DEKAF2_CONSTEXPR_14
+Hash calc(const char* p, std::size_t len, Hash seed) noexcept
+{
+	seed ^= mix(seed ^ Secret0, Secret1);
+
+	Hash a { 0 };
+	Hash b { 0 };
+
+	if (DEKAF2_LIKELY(len <= 16))
+	{
+		if (DEKAF2_LIKELY(len >= 4))
+		{
+			a = (read4<bLower>(p) << 32) | read4<bLower>(p + ((len >> 3) << 2));
+			b = (read4<bLower>(p + len - 4) << 32) | read4<bLower>(p + len - 4 - ((len >> 3) << 2));
+		}
+		else if (DEKAF2_LIKELY(len > 0))
+		{
+			a = read3<bLower>(p, len);
+		}
+	}
+	else
+	{
+		std::size_t i = len;
+
+		if (DEKAF2_UNLIKELY(i > 48))
+		{
+			Hash see1 = seed;
+			Hash see2 = seed;
+
+			do
+			{
+				seed = mix(read8<bLower>(p     ) ^ Secret1, read8<bLower>(p +  8) ^ seed);
+				see1 = mix(read8<bLower>(p + 16) ^ Secret2, read8<bLower>(p + 24) ^ see1);
+				see2 = mix(read8<bLower>(p + 32) ^ Secret3, read8<bLower>(p + 40) ^ see2);
+				p += 48;
+				i -= 48;
+			}
+			while (DEKAF2_LIKELY(i > 48));
+
+			seed ^= see1 ^ see2;
+		}
+
+		while (DEKAF2_UNLIKELY(i > 16))
+		{
+			seed = mix(read8<bLower>(p) ^ Secret1, read8<bLower>(p + 8) ^ seed);
+			i -= 16;
+			p += 16;
+		}
+
+		a = read8<bLower>(p + i - 16);
+		b = read8<bLower>(p + i - 8);
+	}
+
+	a ^= Secret1;
+	b ^= seed;
+	mum(a, b);
+
+	return mix(a ^ Secret0 ^ len, b ^ Secret1);
+}
+
+static DEKAF2_CONSTEXPR_14
+Hash hash(const char* data, std::size_t size, Hash seed = DefaultSeed) noexcept
+{
+	return calc<false>(data, size, seed);
+}
+
+static DEKAF2_CONSTEXPR_14
+Hash casehash(const char* data, std::size_t size, Hash seed = DefaultSeed) noexcept
+{
+	return calc<true>(data, size, seed);
+}
+
+static DEKAF2_CONSTEXPR_14
+std::size_t length(const char* data) noexcept
+{
+	std::size_t iSize { 0 };
+	while (data[iSize]) ++iSize;
+	return iSize;
+}
+
+}; // wyhash
+
+//---------------------------------------------------------------------------
+/// returns the seed for kFastHash() and, if built with DEKAF2_USE_FAST_HASH, for
+/// std::hash<KString>: a random value, chosen once per process, which protects hash
+/// tables with keys from untrusted sources against hash flooding. If built with
+/// DEKAF2_FIXED_HASH_SEED it is wyhash::DefaultSeed, for reproducible output.
+DEKAF2_PUBLIC
+wyhash::Hash GetProcessSeed() noexcept;
+//---------------------------------------------------------------------------
+
 template<int iSize = hash::size>
 using Hash = typename hash::fnv1a<iSize>::Hash;
 
 template<int iSize = hash::size>
 constexpr Hash<iSize> kHashBasis = hash::fnv1a<iSize>::Basis;
 
+/// the result type of the string hash selected for std::hash<KString>
+#ifdef DEKAF2_USE_FAST_HASH
+using StringHash = std::size_t;
+#else
+using StringHash = Hash<hash::size>;
+#endif
+
 } // end of namespace hash
 
 inline namespace literals {
 
 //---------------------------------------------------------------------------
-/// literal type for constexpr hash computations, e.g. for switch statements
+/// literal type for constexpr hash computations, e.g. for switch statements - matches
+/// KStringView::Hash() and kStringHash()
 constexpr
-DEKAF2_PREFIX hash::fnv1a<DEKAF2_PREFIX hash::size>::Hash operator""_hash(const char* data, std::size_t size) noexcept
+hash::StringHash operator""_hash(const char* data, std::size_t size) noexcept
 //---------------------------------------------------------------------------
 {
-#ifdef DEKAF2_HAS_CPP_14
+#ifdef DEKAF2_USE_FAST_HASH
+	return size != 0 ? static_cast<std::size_t>(hash::wyhash::hash(data, size)) : 0;
+#elif defined(DEKAF2_HAS_CPP_14)
 	return size != 0 ? hash::fnv1a<DEKAF2_PREFIX hash::size>::hash(data, size, DEKAF2_PREFIX hash::fnv1a<DEKAF2_PREFIX hash::size>::Basis) : 0;
 #else
 	return size != 0 ? hash::fnv1a<DEKAF2_PREFIX hash::size>::hash_constexpr(data, size, DEKAF2_PREFIX hash::fnv1a<DEKAF2_PREFIX hash::size>::Basis) : 0;
@@ -228,12 +418,15 @@ DEKAF2_PREFIX hash::fnv1a<DEKAF2_PREFIX hash::size>::Hash operator""_hash(const
 }
 
 //---------------------------------------------------------------------------
-/// literal type for lowercase constexpr hash computations, e.g. for switch statements
+/// literal type for lowercase constexpr hash computations, e.g. for switch statements - matches
+/// KStringView::CaseHash() and kStringCaseHash()
 constexpr
-DEKAF2_PREFIX hash::fnv1a<DEKAF2_PREFIX hash::size>::Hash operator""_casehash(const char* data, std::size_t size) noexcept
+hash::StringHash operator""_casehash(const char* data, std::size_t size) noexcept
 //---------------------------------------------------------------------------
 {
-#ifdef DEKAF2_HAS_CPP_14
+#ifdef DEKAF2_USE_FAST_HASH
+	return size != 0 ? static_cast<std::size_t>(hash::wyhash::casehash(data, size)) : 0;
+#elif defined(DEKAF2_HAS_CPP_14)
 	return size != 0 ? hash::fnv1a<DEKAF2_PREFIX hash::size>::casehash(data, size, DEKAF2_PREFIX hash::fnv1a<DEKAF2_PREFIX hash::size>::Basis) : 0;
 #else
 	return size != 0 ? hash::fnv1a<DEKAF2_PREFIX hash::size>::casehash_constexpr(data, size, DEKAF2_PREFIX hash::fnv1a<DEKAF2_PREFIX hash::size>::Basis) : 0;
@@ -344,6 +537,123 @@ typename hash::fnv1a<iSize>::Hash kCaseHash(char data, std::size_t hash = hash::
 	return hash::fnv1a<iSize>::casehash(data, hash);
 }
 
+//---------------------------------------------------------------------------
+/// fast seeded hash function for arbitrary data. The default seed is chosen randomly
+/// per process, see hash::GetProcessSeed(), to protect against hash flooding - pass
+/// an explicit seed for hashes that have to be stable across processes, or that have
+/// to be computed at compile time. Returns 0 for empty input, like kHash().
+DEKAF2_CONSTEXPR_14
+hash::wyhash::Hash kFastHash(const char* data, std::size_t size, hash::wyhash::Hash seed = hash::GetProcessSeed()) noexcept
+//---------------------------------------------------------------------------
+{
+	return size != 0 ? hash::wyhash::hash(data, size, seed) : 0;
+}
+
+//---------------------------------------------------------------------------
+/// fast hash function for zero terminated strings, with the seed of the process
+inline
+hash::wyhash::Hash kFastHash(const char* data) noexcept
+//---------------------------------------------------------------------------
+{
+	return kFastHash(data, hash::wyhash::length(data));
+}
+
+//---------------------------------------------------------------------------
+/// fast seeded hash function, converted to ASCII lowercase
+DEKAF2_CONSTEXPR_14
+hash::wyhash::Hash kFastCaseHash(const char* data, std::size_t size, hash::wyhash::Hash seed = hash::GetProcessSeed()) noexcept
+//---------------------------------------------------------------------------
+{
+	return size != 0 ? hash::wyhash::casehash(data, size, seed) : 0;
+}
+
+//---------------------------------------------------------------------------
+/// fast hash function for zero terminated strings, converted to ASCII lowercase,
+/// with the seed of the process
+inline
+hash::wyhash::Hash kFastCaseHash(const char* data) noexcept
+//---------------------------------------------------------------------------
+{
+	return kFastCaseHash(data, hash::wyhash::length(data));
+}
+
+//---------------------------------------------------------------------------
+/// the hash for strings as used by Hash() and the _hash literal: FNV per default, the
+/// fast hash with its fixed default seed if built with DEKAF2_USE_FAST_HASH
+DEKAF2_CONSTEXPR_14
+hash::StringHash kStringHash(const char* data, std::size_t size) noexcept
+//---------------------------------------------------------------------------
+{
+#ifdef DEKAF2_USE_FAST_HASH
+	return static_cast<std::size_t>(kFastHash(data, size, hash::wyhash::DefaultSeed));
+#else
+	return kHash(data, size);
+#endif
+}
+
+//---------------------------------------------------------------------------
+/// the hash for zero terminated strings as used by Hash() and the _hash literal
+DEKAF2_CONSTEXPR_14
+hash::StringHash kStringHash(const char* data) noexcept
+//---------------------------------------------------------------------------
+{
+#ifdef DEKAF2_USE_FAST_HASH
+	return static_cast<std::size_t>(kFastHash(data, hash::wyhash::length(data), hash::wyhash::DefaultSeed));
+#else
+	return kHash(data);
+#endif
+}
+
+// std::hash<KString>, std::hash<KStringView> and std::hash<KStringViewZ> are
+// only constexpr if they do not use the seed of the process
+#ifdef DEKAF2_USE_FAST_HASH
+	#define DEKAF2_STD_STRING_HASH_CONSTEXPR_14
+#else
+	#define DEKAF2_STD_STRING_HASH_CONSTEXPR_14 DEKAF2_CONSTEXPR_14
+#endif
+
+//---------------------------------------------------------------------------
+/// the hash for strings as used by std::hash<KString>, std::hash<KStringView> and
+/// std::hash<KStringViewZ>: FNV per default, the fast hash with the seed of the
+/// process if built with DEKAF2_USE_FAST_HASH
+DEKAF2_STD_STRING_HASH_CONSTEXPR_14
+std::size_t kStdStringHash(const char* data, std::size_t size) noexcept
+//---------------------------------------------------------------------------
+{
+#ifdef DEKAF2_USE_FAST_HASH
+	return static_cast<std::size_t>(kFastHash(data, size));
+#else
+	return kHash(data, size);
+#endif
+}
+
+//---------------------------------------------------------------------------
+/// the hash for zero terminated strings as used by std::hash<KString>
+DEKAF2_STD_STRING_HASH_CONSTEXPR_14
+std::size_t kStdStringHash(const char* data) noexcept
+//---------------------------------------------------------------------------
+{
+#ifdef DEKAF2_USE_FAST_HASH
+	return static_cast<std::size_t>(kFastHash(data));
+#else
+	return kHash(data);
+#endif
+}
+
+//---------------------------------------------------------------------------
+/// the ASCII case insensitive hash for strings as used by CaseHash(), the case insensitive
+/// string types and the _casehash literal
+DEKAF2_CONSTEXPR_14
+hash::StringHash kStringCaseHash(const char* data, std::size_t size) noexcept
+//---------------------------------------------------------------------------
+{
+#ifdef DEKAF2_USE_FAST_HASH
+	return static_cast<std::size_t>(kFastCaseHash(data, size, hash::wyhash::DefaultSeed));
+#else
+	return kCaseHash(data, size);
+#endif
+}
+
 namespace kfrozen {
 
 //---------------------------------------------------------------------------
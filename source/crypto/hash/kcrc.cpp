@@ -42,10 +42,21 @@
 
 #include <dekaf2/crypto/hash/kcrc.h>
 #include <array>
+#include <cstring>
+
+#if defined(DEKAF2_X86_64) && (defined(DEKAF2_IS_GCC) || defined(DEKAF2_IS_CLANG))
+	// PCLMULQDQ and SSE4.2 are compiled per function and selected at run time
+	#define DEKAF2_KCRC_HAS_X86_DISPATCH 1
+	#include <immintrin.h>
+#elif defined(DEKAF2_ARM64) && defined(__ARM_FEATURE_CRC32)
+	// the ARMv8 CRC32 instructions are known to be present at compile time
+	#define DEKAF2_KCRC_HAS_ARM_CRC 1
+	#include <arm_acle.h>
+#endif
 
 DEKAF2_NAMESPACE_BEGIN
 
-// On full C++17 the byte table is a compile-time constant; otherwise it is built
+// On full C++17 the tables are compile-time constants; otherwise they are built
 // exactly once, at first use. A local macro is needed because a block-scope
 // `static` cannot be tagged `inline` (which is what DEKAF2_CONSTEXPR_17 expands
 // to before C++17).
@@ -57,82 +68,515 @@ DEKAF2_NAMESPACE_BEGIN
 
 namespace {
 
-using CRC32Table = std::array<uint32_t, 256>;
+constexpr uint32_t CRC32Poly  = 0xEDB88320u; // reflected 0x04C11DB7
+constexpr uint32_t CRC32CPoly = 0x82F63B78u; // reflected 0x1EDC6F41
+
+/// slicing-by-8: table [0] is the classic byte table, table [k] advances a byte
+/// by k further zero bytes, so that eight input bytes are folded per step
+using SliceTables = std::array<std::array<uint32_t, 256>, 8>;
+
+/// x^(2^n) modulo the polynomial, for n = 0..31, used to combine CRCs
+using PowerTable  = std::array<uint32_t, 64 + 3>; // x^(2^n) for all bit lengths of a 64 bit byte count
+
+/// the function type of all implementations: takes and returns the running
+/// CRC register, that is, the CRC before the final xor-out
+using UpdateFunc  = uint32_t (*)(uint32_t crc, const char* p, std::size_t iSize);
 
 //-----------------------------------------------------------------------------
-// the reflected CRC-32 byte table for polynomial 0xEDB88320 (each entry folds
+// the reflected byte tables for a polynomial (each entry of table [0] folds
 // eight bits at once - the table-driven equivalent of the bitwise kCRC32())
-DEKAF2_KCRC_CONSTEXPR CRC32Table BuildTable()
+DEKAF2_KCRC_CONSTEXPR SliceTables BuildTables(uint32_t iPoly)
 //-----------------------------------------------------------------------------
 {
-	CRC32Table t {};
+	SliceTables t {};
 	for (uint32_t n = 0; n < 256; ++n)
 	{
 		uint32_t c = n;
 		for (int k = 0; k < 8; ++k)
 		{
-			c = (c & 1u) ? ((c >> 1) ^ 0xEDB88320u) : (c >> 1);
+			c = (c & 1u) ? ((c >> 1) ^ iPoly) : (c >> 1);
+		}
+		t[0][n] = c;
+	}
+	for (std::size_t k = 1; k < t.size(); ++k)
+	{
+		for (uint32_t n = 0; n < 256; ++n)
+		{
+			t[k][n] = (t[k-1][n] >> 8) ^ t[0][t[k-1][n] & 0xFFu];
 		}
-		t[n] = c;
 	}
 	return t;
 
-} // BuildTable
+} // BuildTables
 
 //-----------------------------------------------------------------------------
-// the shared table - a compile-time constant (full C++17) or built once at first
-// use; lives in this single translation unit, so it is never emitted per-header
-const CRC32Table& Table()
+// the shared CRC-32 tables - a compile-time constant (full C++17) or built once
+// at first use; lives in this single translation unit, so it is never emitted
+// per-header
+const SliceTables& CRC32Tables()
 //-----------------------------------------------------------------------------
 {
-	static DEKAF2_KCRC_CONSTEXPR CRC32Table s = BuildTable();
+	static DEKAF2_KCRC_CONSTEXPR SliceTables s = BuildTables(CRC32Poly);
 	return s;
 
-} // Table
+} // CRC32Tables
 
-} // anonymous namespace
+//-----------------------------------------------------------------------------
+const SliceTables& CRC32CTables()
+//-----------------------------------------------------------------------------
+{
+	static DEKAF2_KCRC_CONSTEXPR SliceTables s = BuildTables(CRC32CPoly);
+	return s;
+
+} // CRC32CTables
 
 //-----------------------------------------------------------------------------
-bool KCRC32::Update(KStringView sInput)
+inline uint32_t Load32LE(const char* p)
+//-----------------------------------------------------------------------------
+{
+	// assembled bytewise, so the result does not depend on the host byte order
+	// (compilers reduce this to a single load on little endian hosts)
+	auto u = reinterpret_cast<const unsigned char*>(p);
+	return  static_cast<uint32_t>(u[0])
+	     | (static_cast<uint32_t>(u[1]) <<  8)
+	     | (static_cast<uint32_t>(u[2]) << 16)
+	     | (static_cast<uint32_t>(u[3]) << 24);
+
+} // Load32LE
+
+//-----------------------------------------------------------------------------
+// the portable implementation, eight bytes per step
+uint32_t UpdateSlice8(const SliceTables& T, uint32_t crc, const char* p, std::size_t iSize)
 //-----------------------------------------------------------------------------
 {
-	const auto& T   = Table();
-	uint32_t    crc = m_iCRC;
-	for (std::size_t i = 0; i < sInput.size(); ++i)
+	for (; iSize >= 8; iSize -= 8, p += 8)
 	{
-		crc = T[(crc ^ static_cast<uint8_t>(sInput[i])) & 0xFFu] ^ (crc >> 8);
+		uint32_t one = Load32LE(p) ^ crc;
+		uint32_t two = Load32LE(p + 4);
+
+		crc = T[7][ one        & 0xFFu]
+		    ^ T[6][(one >>  8) & 0xFFu]
+		    ^ T[5][(one >> 16) & 0xFFu]
+		    ^ T[4][ one >> 24         ]
+		    ^ T[3][ two        & 0xFFu]
+		    ^ T[2][(two >>  8) & 0xFFu]
+		    ^ T[1][(two >> 16) & 0xFFu]
+		    ^ T[0][ two >> 24         ];
 	}
-	m_iCRC = crc;
-	return true;
 
-} // Update
+	for (; iSize; --iSize)
+	{
+		crc = T[0][(crc ^ static_cast<uint8_t>(*p++)) & 0xFFu] ^ (crc >> 8);
+	}
+
+	return crc;
+
+} // UpdateSlice8
 
 //-----------------------------------------------------------------------------
-bool KCRC32::Update(KInStream& InputStream)
+uint32_t CRC32Slice8(uint32_t crc, const char* p, std::size_t iSize)
+//-----------------------------------------------------------------------------
+{
+	return UpdateSlice8(CRC32Tables(), crc, p, iSize);
+
+} // CRC32Slice8
+
+//-----------------------------------------------------------------------------
+uint32_t CRC32CSlice8(uint32_t crc, const char* p, std::size_t iSize)
+//-----------------------------------------------------------------------------
+{
+	return UpdateSlice8(CRC32CTables(), crc, p, iSize);
+
+} // CRC32CSlice8
+
+#ifdef DEKAF2_KCRC_HAS_X86_DISPATCH
+
+//-----------------------------------------------------------------------------
+// folds the 128 bits of x over y (a lambda would not inherit the target flags)
+__attribute__((target("pclmul,sse4.1")))
+inline __m128i Fold128(__m128i k, __m128i x, __m128i y)
+//-----------------------------------------------------------------------------
+{
+	__m128i lo = _mm_clmulepi64_si128(x, k, 0x00);
+	__m128i hi = _mm_clmulepi64_si128(x, k, 0x11);
+	return _mm_xor_si128(_mm_xor_si128(hi, y), lo);
+
+} // Fold128
+
+//-----------------------------------------------------------------------------
+// CRC-32 by carry-less multiplication: folds four 128 bit lanes in parallel,
+// then reduces to 32 bits with a Barrett reduction (see Intel's white paper
+// "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction").
+// Requires iSize >= 64 and a multiple of 16.
+__attribute__((target("pclmul,sse4.1")))
+uint32_t CRC32FoldPCLMUL(uint32_t crc, const char* p, std::size_t iSize)
+//-----------------------------------------------------------------------------
+{
+	// x^(4*128+32), x^(4*128-32), x^(128+32), x^(128-32), x^64 mod P, and the
+	// Barrett constants P' and mu, all bit reflected
+	const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+	const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+	const __m128i k5k0 = _mm_set_epi64x(0x0000000000, 0x0163cd6124);
+	const __m128i poly = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+	const __m128i mask = _mm_setr_epi32(~0, 0, ~0, 0);
+
+	auto Load = [](const char* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); };
+
+	__m128i x1 = _mm_xor_si128(Load(p), _mm_cvtsi32_si128(static_cast<int>(crc)));
+	__m128i x2 = Load(p + 0x10);
+	__m128i x3 = Load(p + 0x20);
+	__m128i x4 = Load(p + 0x30);
+	__m128i x5;
+
+	p     += 64;
+	iSize -= 64;
+
+	for (; iSize >= 64; iSize -= 64, p += 64)
+	{
+		x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+		__m128i x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+		__m128i x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+		__m128i x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+
+		x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+		x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+		x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+		x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), Load(p       ));
+		x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), Load(p + 0x10));
+		x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), Load(p + 0x20));
+		x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), Load(p + 0x30));
+	}
+
+	// fold the four lanes into one
+	x1 = Fold128(k3k4, x1, x2);
+	x1 = Fold128(k3k4, x1, x3);
+	x1 = Fold128(k3k4, x1, x4);
+
+	// fold the remaining 16 byte blocks
+	for (; iSize >= 16; iSize -= 16, p += 16)
+	{
+		x1 = Fold128(k3k4, x1, Load(p));
+	}
+
+	// fold 128 bits to 64 bits
+	x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+	x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+	x2 = _mm_srli_si128(x1, 4);
+	x1 = _mm_and_si128(x1, mask);
+	x1 = _mm_clmulepi64_si128(x1, k5k0, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+
+	// Barrett reduction to 32 bits
+	x2 = _mm_and_si128(x1, mask);
+	x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+	x2 = _mm_and_si128(x2, mask);
+	x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+
+	return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+
+} // CRC32FoldPCLMUL
+
+//-----------------------------------------------------------------------------
+uint32_t CRC32PCLMUL(uint32_t crc, const char* p, std::size_t iSize)
+//-----------------------------------------------------------------------------
+{
+	if (iSize >= 64)
+	{
+		auto iFold = iSize & ~std::size_t(15);
+		crc    = CRC32FoldPCLMUL(crc, p, iFold);
+		p     += iFold;
+		iSize -= iFold;
+	}
+
+	return CRC32Slice8(crc, p, iSize);
+
+} // CRC32PCLMUL
+
+//-----------------------------------------------------------------------------
+__attribute__((target("sse4.2")))
+uint32_t CRC32CSSE42(uint32_t crc, const char* p, std::size_t iSize)
+//-----------------------------------------------------------------------------
+{
+	uint64_t crc64 = crc;
+
+	for (; iSize >= 8; iSize -= 8, p += 8)
+	{
+		uint64_t iWord;
+		std::memcpy(&iWord, p, sizeof(iWord));
+		crc64 = _mm_crc32_u64(crc64, iWord);
+	}
+
+	crc = static_cast<uint32_t>(crc64);
+
+	for (; iSize; --iSize)
+	{
+		crc = _mm_crc32_u8(crc, static_cast<uint8_t>(*p++));
+	}
+
+	return crc;
+
+} // CRC32CSSE42
+
+#endif // DEKAF2_KCRC_HAS_X86_DISPATCH
+
+#ifdef DEKAF2_KCRC_HAS_ARM_CRC
+
+//-----------------------------------------------------------------------------
+uint32_t CRC32ARM(uint32_t crc, const char* p, std::size_t iSize)
+//-----------------------------------------------------------------------------
+{
+	for (; iSize >= 8; iSize -= 8, p += 8)
+	{
+		uint64_t iWord;
+		std::memcpy(&iWord, p, sizeof(iWord));
+		crc = __crc32d(crc, iWord);
+	}
+
+	for (; iSize; --iSize)
+	{
+		crc = __crc32b(crc, static_cast<uint8_t>(*p++));
+	}
+
+	return crc;
+
+} // CRC32ARM
+
+//-----------------------------------------------------------------------------
+uint32_t CRC32CARM(uint32_t crc, const char* p, std::size_t iSize)
+//-----------------------------------------------------------------------------
+{
+	for (; iSize >= 8; iSize -= 8, p += 8)
+	{
+		uint64_t iWord;
+		std::memcpy(&iWord, p, sizeof(iWord));
+		crc = __crc32cd(crc, iWord);
+	}
+
+	for (; iSize; --iSize)
+	{
+		crc = __crc32cb(crc, static_cast<uint8_t>(*p++));
+	}
+
+	return crc;
+
+} // CRC32CARM
+
+#endif // DEKAF2_KCRC_HAS_ARM_CRC
+
+//-----------------------------------------------------------------------------
+// selects the CRC-32 implementation once, at first use
+UpdateFunc SelectCRC32()
+//-----------------------------------------------------------------------------
+{
+#if defined(DEKAF2_KCRC_HAS_X86_DISPATCH)
+	if (__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1"))
+	{
+		return CRC32PCLMUL;
+	}
+#elif defined(DEKAF2_KCRC_HAS_ARM_CRC)
+	return CRC32ARM;
+#endif
+	return CRC32Slice8;
+
+} // SelectCRC32
+
+//-----------------------------------------------------------------------------
+// selects the CRC-32C implementation once, at first use
+UpdateFunc SelectCRC32C()
+//-----------------------------------------------------------------------------
+{
+#if defined(DEKAF2_KCRC_HAS_X86_DISPATCH)
+	if (__builtin_cpu_supports("sse4.2"))
+	{
+		return CRC32CSSE42;
+	}
+#elif defined(DEKAF2_KCRC_HAS_ARM_CRC)
+	return CRC32CARM;
+#endif
+	return CRC32CSlice8;
+
+} // SelectCRC32C
+
+//-----------------------------------------------------------------------------
+uint32_t UpdateCRC32(uint32_t crc, const char* p, std::size_t iSize)
+//-----------------------------------------------------------------------------
+{
+	static const UpdateFunc Func = SelectCRC32();
+	return Func(crc, p, iSize);
+
+} // UpdateCRC32
+
+//-----------------------------------------------------------------------------
+uint32_t UpdateCRC32C(uint32_t crc, const char* p, std::size_t iSize)
+//-----------------------------------------------------------------------------
+{
+	static const UpdateFunc Func = SelectCRC32C();
+	return Func(crc, p, iSize);
+
+} // UpdateCRC32C
+
+//-----------------------------------------------------------------------------
+// reads a stream in chunks and feeds them to the update function
+uint32_t UpdateStream(UpdateFunc Func, uint32_t crc, KInStream& InputStream)
 //-----------------------------------------------------------------------------
 {
-	const auto& T   = Table();
-	uint32_t    crc = m_iCRC;
 	std::array<char, KDefaultCopyBufSize> Buffer;
 
 	for (;;)
 	{
 		auto iReadChunk = InputStream.Read(Buffer.data(), Buffer.size());
 
-		for (std::size_t i = 0; i < iReadChunk; ++i)
+		crc = Func(crc, Buffer.data(), iReadChunk);
+
+		if (iReadChunk < Buffer.size())
 		{
-			crc = T[(crc ^ static_cast<uint8_t>(Buffer[i])) & 0xFFu] ^ (crc >> 8);
+			return crc;
 		}
+	}
 
-		if (iReadChunk < Buffer.size())
+} // UpdateStream
+
+//-----------------------------------------------------------------------------
+// multiplies two polynomials a and b modulo the (reflected) polynomial
+DEKAF2_CONSTEXPR_14 uint32_t MultModP(uint32_t a, uint32_t b, uint32_t iPoly)
+//-----------------------------------------------------------------------------
+{
+	uint32_t m = 1u << 31;
+	uint32_t p = 0;
+
+	for (;;)
+	{
+		if (a & m)
 		{
-			m_iCRC = crc;
-			return true;
+			p ^= b;
+
+			if ((a & (m - 1)) == 0)
+			{
+				break;
+			}
 		}
+		m >>= 1;
+		b = (b & 1u) ? ((b >> 1) ^ iPoly) : (b >> 1);
+	}
+
+	return p;
+
+} // MultModP
+
+//-----------------------------------------------------------------------------
+DEKAF2_KCRC_CONSTEXPR PowerTable BuildPowers(uint32_t iPoly)
+//-----------------------------------------------------------------------------
+{
+	PowerTable t {};
+	uint32_t p = 1u << 30; // x^1
+	t[0] = p;
+	for (std::size_t n = 1; n < t.size(); ++n)
+	{
+		t[n] = p = MultModP(p, p, iPoly);
 	}
+	return t;
+
+} // BuildPowers
+
+//-----------------------------------------------------------------------------
+const PowerTable& CRC32Powers()
+//-----------------------------------------------------------------------------
+{
+	static DEKAF2_KCRC_CONSTEXPR PowerTable s = BuildPowers(CRC32Poly);
+	return s;
+
+} // CRC32Powers
+
+//-----------------------------------------------------------------------------
+const PowerTable& CRC32CPowers()
+//-----------------------------------------------------------------------------
+{
+	static DEKAF2_KCRC_CONSTEXPR PowerTable s = BuildPowers(CRC32CPoly);
+	return s;
+
+} // CRC32CPowers
+
+//-----------------------------------------------------------------------------
+// the CRC of the concatenation is the first CRC shifted by the length of the
+// second chunk (multiplied by x^(8*len2)) xored with the second CRC
+uint32_t Combine(const PowerTable& Powers, uint32_t iPoly, uint32_t iCRC1, uint32_t iCRC2, uint64_t iLen2)
+//-----------------------------------------------------------------------------
+{
+	uint32_t iShift = 1u << 31; // x^0
+	std::size_t k = 3;          // bytes -> bits
+
+	for (; iLen2; iLen2 >>= 1, ++k)
+	{
+		if (iLen2 & 1u)
+		{
+			iShift = MultModP(Powers[k], iShift, iPoly);
+		}
+	}
+
+	return MultModP(iShift, iCRC1, iPoly) ^ iCRC2;
+
+} // Combine
+
+} // anonymous namespace
+
+//-----------------------------------------------------------------------------
+bool KCRC32::Update(KStringView sInput)
+//-----------------------------------------------------------------------------
+{
+	m_iCRC = UpdateCRC32(m_iCRC, sInput.data(), sInput.size());
+	return true;
 
 } // Update
 
+//-----------------------------------------------------------------------------
+bool KCRC32::Update(KInStream& InputStream)
+//-----------------------------------------------------------------------------
+{
+	m_iCRC = UpdateStream(UpdateCRC32, m_iCRC, InputStream);
+	return true;
+
+} // Update
+
+//-----------------------------------------------------------------------------
+bool KCRC32C::Update(KStringView sInput)
+//-----------------------------------------------------------------------------
+{
+	m_iCRC = UpdateCRC32C(m_iCRC, sInput.data(), sInput.size());
+	return true;
+
+} // Update
+
+//-----------------------------------------------------------------------------
+bool KCRC32C::Update(KInStream& InputStream)
+//-----------------------------------------------------------------------------
+{
+	m_iCRC = UpdateStream(UpdateCRC32C, m_iCRC, InputStream);
+	return true;
+
+} // Update
+
+//-----------------------------------------------------------------------------
+uint32_t kCRC32Combine(uint32_t iCRC1, uint32_t iCRC2, uint64_t iLen2)
+//-----------------------------------------------------------------------------
+{
+	return Combine(CRC32Powers(), CRC32Poly, iCRC1, iCRC2, iLen2);
+
+} // kCRC32Combine
+
+//-----------------------------------------------------------------------------
+uint32_t kCRC32CCombine(uint32_t iCRC1, uint32_t iCRC2, uint64_t iLen2)
+//-----------------------------------------------------------------------------
+{
+	return Combine(CRC32CPowers(), CRC32CPoly, iCRC1, iCRC2, iLen2);
+
+} // kCRC32CCombine
+
 #undef DEKAF2_KCRC_CONSTEXPR
+#undef DEKAF2_KCRC_HAS_X86_DISPATCH
+#undef DEKAF2_KCRC_HAS_ARM_CRC
 
 DEKAF2_NAMESPACE_END
@@ -42,9 +42,43 @@
 
 #include <dekaf2/crypto/hash/khash.h>
 #include <array>
+#include <chrono>
+#include <random>
 
 DEKAF2_NAMESPACE_BEGIN
 
+//---------------------------------------------------------------------------
+hash::wyhash::Hash hash::GetProcessSeed() noexcept
+//---------------------------------------------------------------------------
+{
+#ifdef DEKAF2_FIXED_HASH_SEED
+	return wyhash::DefaultSeed;
+#else
+	// this may be called during static initialization, by the first hashed container,
+	// so do not use anything here that logs or hashes itself
+	static const wyhash::Hash s_iSeed = []() noexcept -> wyhash::Hash
+	{
+		wyhash::Hash iSeed = static_cast<wyhash::Hash>(std::chrono::steady_clock::now().time_since_epoch().count());
+
+		DEKAF2_TRY
+		{
+			std::random_device RandDevice;
+			iSeed ^= static_cast<wyhash::Hash>(RandDevice()) << 32 | RandDevice();
+		}
+		DEKAF2_CATCH (...)
+		{
+			// keep the clock based seed
+		}
+
+		// do not use a weak seed of zero
+		return iSeed ? iSeed : wyhash::DefaultSeed;
+	}();
+
+	return s_iSeed;
+#endif
+
+} // GetProcessSeed
+
 //---------------------------------------------------------------------------
 bool KHash::Update(KStringView::value_type chInput)
 //---------------------------------------------------------------------------
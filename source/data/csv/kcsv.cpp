@@ -42,6 +42,25 @@
 
 #include <dekaf2/data/csv/kcsv.h>
 #include <dekaf2/core/strings/kstringutils.h>
+#include <dekaf2/core/types/kbit.h>
+#include <dekaf2/core/logging/klog.h>
+#include <dekaf2/threading/execution/kparallel.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+#if defined(__SSE2__) || (defined(DEKAF2_IS_MSC) && defined(DEKAF2_X86_64))
+	#define DEKAF2_CSV_SSE2 1
+	#include <emmintrin.h>
+	#if defined(__AVX2__)
+		#define DEKAF2_CSV_AVX2 1
+		#include <immintrin.h>
+	#endif
+#elif defined(DEKAF2_ARM64) && (defined(__ARM_NEON) || defined(_M_ARM64))
+	#define DEKAF2_CSV_NEON 1
+	#include <arm_neon.h>
+#endif
 
 DEKAF2_NAMESPACE_BEGIN
 
@@ -206,4 +225,561 @@ KCSV::STATE KCSV::ReadColumn(KInStream& In, KStringRef& sColumn)
 
 } // ReadColumn
 
+namespace {
+
+//-----------------------------------------------------------------------------
+/// returns a bit mask with one bit set for each of the 64 bytes at pBuf that equals
+/// one of the four chars, bit 0 is the first byte
+uint64_t FindChars64(const char* pBuf, char ch1, char ch2, char ch3, char ch4)
+//-----------------------------------------------------------------------------
+{
+#if defined(DEKAF2_CSV_AVX2)
+
+	const __m256i C1 = _mm256_set1_epi8(ch1);
+	const __m256i C2 = _mm256_set1_epi8(ch2);
+	const __m256i C3 = _mm256_set1_epi8(ch3);
+	const __m256i C4 = _mm256_set1_epi8(ch4);
+
+	auto Mask32 = [&](const char* p) -> uint64_t
+	{
+		auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+		auto m = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, C1), _mm256_cmpeq_epi8(v, C2)),
+		                         _mm256_or_si256(_mm256_cmpeq_epi8(v, C3), _mm256_cmpeq_epi8(v, C4)));
+		return static_cast<uint32_t>(_mm256_movemask_epi8(m));
+	};
+
+	return Mask32(pBuf) | (Mask32(pBuf + 32) << 32);
+
+#elif defined(DEKAF2_CSV_SSE2)
+
+	const __m128i C1 = _mm_set1_epi8(ch1);
+	const __m128i C2 = _mm_set1_epi8(ch2);
+	const __m128i C3 = _mm_set1_epi8(ch3);
+	const __m128i C4 = _mm_set1_epi8(ch4);
+
+	auto Mask16 = [&](const char* p) -> uint64_t
+	{
+		auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+		auto m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, C1), _mm_cmpeq_epi8(v, C2)),
+		                      _mm_or_si128(_mm_cmpeq_epi8(v, C3), _mm_cmpeq_epi8(v, C4)));
+		return static_cast<uint16_t>(_mm_movemask_epi8(m));
+	};
+
+	return Mask16(pBuf) | (Mask16(pBuf + 16) << 16) | (Mask16(pBuf + 32) << 32) | (Mask16(pBuf + 48) << 48);
+
+#elif defined(DEKAF2_CSV_NEON)
+
+	const uint8x16_t C1 = vdupq_n_u8(static_cast<uint8_t>(ch1));
+	const uint8x16_t C2 = vdupq_n_u8(static_cast<uint8_t>(ch2));
+	const uint8x16_t C3 = vdupq_n_u8(static_cast<uint8_t>(ch3));
+	const uint8x16_t C4 = vdupq_n_u8(static_cast<uint8_t>(ch4));
+
+	// NEON has no movemask - weight each matching byte with its bit and add them up per half
+	static constexpr uint8_t Weights[16] { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+	const uint8x16_t W = vld1q_u8(Weights);
+
+	auto Mask16 = [&](const char* p) -> uint64_t
+	{
+		auto v = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+		auto m = vorrq_u8(vorrq_u8(vceqq_u8(v, C1), vceqq_u8(v, C2)),
+		                  vorrq_u8(vceqq_u8(v, C3), vceqq_u8(v, C4)));
+		m = vandq_u8(m, W);
+		return static_cast<uint64_t>(vaddv_u8(vget_low_u8(m))) | (static_cast<uint64_t>(vaddv_u8(vget_high_u8(m))) << 8);
+	};
+
+	return Mask16(pBuf) | (Mask16(pBuf + 16) << 16) | (Mask16(pBuf + 32) << 32) | (Mask16(pBuf + 48) << 48);
+
+#else
+
+	uint64_t iMask { 0 };
+
+	for (std::size_t i = 0; i < 64; ++i)
+	{
+		auto ch = pBuf[i];
+
+		if (ch == ch1 || ch == ch2 || ch == ch3 || ch == ch4)
+		{
+			iMask |= uint64_t(1) << i;
+		}
+	}
+
+	return iMask;
+
+#endif
+
+} // FindChars64
+
+//-----------------------------------------------------------------------------
+/// the same as FindChars64() for less than 64 bytes at the end of the input
+uint64_t FindCharsTail(const char* pBuf, std::size_t iSize, char ch1, char ch2, char ch3, char ch4)
+//-----------------------------------------------------------------------------
+{
+	uint64_t iMask { 0 };
+
+	for (std::size_t i = 0; i < iSize; ++i)
+	{
+		auto ch = pBuf[i];
+
+		if (ch == ch1 || ch == ch2 || ch == ch3 || ch == ch4)
+		{
+			iMask |= uint64_t(1) << i;
+		}
+	}
+
+	return iMask;
+
+} // FindCharsTail
+
+} // end of anonymous namespace
+
+#undef DEKAF2_CSV_SSE2
+#undef DEKAF2_CSV_AVX2
+#undef DEKAF2_CSV_NEON
+
+//-----------------------------------------------------------------------------
+KInCSVBuffer::KInCSVBuffer(KStringView sInput,
+                           char chRecordLimiter,
+                           char chColumnLimiter,
+                           char chFieldLimiter)
+//-----------------------------------------------------------------------------
+: m_sInput   (sInput)
+, m_Limiters { chRecordLimiter, chColumnLimiter, chFieldLimiter }
+// the CR is only special if LF is the record limiter - else we simply search twice for the record limiter
+, m_chCR     (chRecordLimiter == '\n' ? '\r' : chRecordLimiter)
+{
+} // ctor
+
+//-----------------------------------------------------------------------------
+KInCSVBuffer& KInCSVBuffer::SkipBOM()
+//-----------------------------------------------------------------------------
+{
+	auto sRemaining = kSkipUTF8BOM(m_sInput.substr(m_iPos));
+	m_iPos = m_sInput.size() - sRemaining.size();
+	return *this;
+
+} // SkipBOM
+
+//-----------------------------------------------------------------------------
+std::size_t KInCSVBuffer::FindSpecial(std::size_t iPos)
+//-----------------------------------------------------------------------------
+{
+	auto iSize = m_sInput.size();
+
+	while (iPos < iSize)
+	{
+		if (!m_bHaveBlock || iPos < m_iBlock || iPos >= m_iBlock + 64)
+		{
+			// scan the next 64 bytes, starting at iPos
+			auto pBuf    = m_sInput.data() + iPos;
+			m_iBlock     = iPos;
+			m_bHaveBlock = true;
+			m_iBlockMask = (iSize - iPos >= 64)
+			             ? FindChars64  (pBuf,               m_Limiters[RecordLimiter], m_Limiters[ColumnLimiter], m_Limiters[FieldLimiter], m_chCR)
+			             : FindCharsTail(pBuf, iSize - iPos, m_Limiters[RecordLimiter], m_Limiters[ColumnLimiter], m_Limiters[FieldLimiter], m_chCR);
+		}
+
+		auto iMask = m_iBlockMask >> (iPos - m_iBlock);
+
+		if (iMask)
+		{
+			return iPos + kBitCountRightZero(iMask);
+		}
+
+		iPos = m_iBlock + 64;
+	}
+
+	return iSize;
+
+} // FindSpecial
+
+//-----------------------------------------------------------------------------
+KInCSVBuffer::STATE KInCSVBuffer::ReadColumn(Record* Columns)
+//-----------------------------------------------------------------------------
+{
+	auto iSize  = m_sInput.size();
+	auto iStart = m_iPos;
+
+	if (iStart >= iSize)
+	{
+		m_bHitEOF = true;
+		return STATE::EndOfFile;
+	}
+
+	auto pBuf = m_sInput.data();
+	std::size_t iFrom;
+	std::size_t iEnd;
+
+	if (pBuf[iStart] == m_Limiters[FieldLimiter])
+	{
+		// a quoted column, the fast path takes it if the next field limiter closes it
+		auto pQuote = static_cast<const char*>(std::memchr(pBuf + iStart + 1, m_Limiters[FieldLimiter], iSize - iStart - 1));
+
+		if (!pQuote)
+		{
+			return ReadEscapedColumn(iStart, Columns);
+		}
+
+		iFrom = iStart + 1;
+		iEnd  = pQuote - pBuf;
+	}
+	else
+	{
+		// an unquoted column, the fast path takes it if it is not ended by a field limiter
+		iFrom = iStart;
+		iEnd  = FindSpecial(iStart);
+	}
+
+	// the position of the limiter after the column content
+	auto iLimiter = (iFrom == iStart) ? iEnd : iEnd + 1;
+	STATE State;
+
+	if (iLimiter >= iSize)
+	{
+		m_bHitEOF = true;
+		// like KCSV::ReadColumn(), an empty last column signals the end of the input
+		State = (iEnd > iFrom) ? STATE::EndOfRecord : STATE::EndOfFile;
+	}
+	else
+	{
+		auto ch = pBuf[iLimiter++];
+
+		if (ch == m_Limiters[RecordLimiter])
+		{
+			State = STATE::EndOfRecord;
+		}
+		else if (ch == '\r' && m_Limiters[RecordLimiter] == '\n' && iLimiter < iSize)
+		{
+			// the CR is skipped if followed by a record or column limiter
+			ch = pBuf[iLimiter++];
+
+			if (ch == m_Limiters[RecordLimiter])
+			{
+				State = STATE::EndOfRecord;
+			}
+			else if (ch == m_Limiters[ColumnLimiter] && ch != m_Limiters[FieldLimiter] && ch != '\r')
+			{
+				State = STATE::EndOfColumn;
+			}
+			else
+			{
+				return ReadEscapedColumn(iStart, Columns);
+			}
+		}
+		else if (ch == m_Limiters[ColumnLimiter] && ch != m_Limiters[FieldLimiter] && (ch != '\r' || m_Limiters[RecordLimiter] != '\n'))
+		{
+			State = STATE::EndOfColumn;
+		}
+		else
+		{
+			// doubled field limiters, a field limiter inside an unquoted column, or stray CRs
+			return ReadEscapedColumn(iStart, Columns);
+		}
+	}
+
+	m_iPos = std::min(iLimiter, iSize);
+
+	if (Columns && State != STATE::EndOfFile)
+	{
+		Columns->push_back(KStringView(pBuf + iFrom, iEnd - iFrom));
+	}
+
+	return State;
+
+} // ReadColumn
+
+//-----------------------------------------------------------------------------
+KInCSVBuffer::STATE KInCSVBuffer::ReadEscapedColumn(std::size_t iStart, Record* Columns)
+//-----------------------------------------------------------------------------
+{
+	bool bIsStartofColumn     { true  };
+	bool bUseFieldLimiter     { false };
+	bool bLastWasFieldLimiter { false };
+
+	auto iOffset = m_sUnescaped.size();
+
+	auto Finish = [&](STATE State, std::size_t iPos) -> STATE
+	{
+		m_iPos = iPos;
+
+		if (Columns && State != STATE::EndOfFile)
+		{
+			// the unescaped buffer may still reallocate, Read() sets the view at the end of the record
+			m_Escaped.push_back({ Columns->size(), iOffset, m_sUnescaped.size() - iOffset });
+			Columns->push_back(KStringView{});
+		}
+
+		return State;
+	};
+
+	// when only skipping we still count the column size, for the end of input decision
+	std::size_t iSkipped { 0 };
+
+	auto Append = [&](char ch)
+	{
+		if (Columns)
+		{
+			m_sUnescaped += ch;
+		}
+		else
+		{
+			++iSkipped;
+		}
+	};
+
+	for (auto iPos = iStart, iSize = m_sInput.size(); iPos < iSize; ++iPos)
+	{
+		auto ch = m_sInput[iPos];
+
+		if (DEKAF2_UNLIKELY(ch == m_Limiters[RecordLimiter] && (!bUseFieldLimiter || bLastWasFieldLimiter)))
+		{
+			return Finish(STATE::EndOfRecord, iPos + 1);
+		}
+		else if (DEKAF2_UNLIKELY(ch == '\r' && m_Limiters[RecordLimiter] == '\n' && (!bUseFieldLimiter || bLastWasFieldLimiter)))
+		{
+			// skip the CR when LF is the record limiter
+			continue;
+		}
+		else if (DEKAF2_UNLIKELY(ch == m_Limiters[FieldLimiter]))
+		{
+			if (bIsStartofColumn)
+			{
+				bUseFieldLimiter = true;
+				bIsStartofColumn = false;
+			}
+			else if (bLastWasFieldLimiter)
+			{
+				// output one field limiter
+				Append(ch);
+				bLastWasFieldLimiter = false;
+			}
+			else
+			{
+				bLastWasFieldLimiter = true;
+			}
+		}
+		else if (ch == m_Limiters[ColumnLimiter] && (!bUseFieldLimiter || bLastWasFieldLimiter))
+		{
+			return Finish(STATE::EndOfColumn, iPos + 1);
+		}
+		else
+		{
+			bIsStartofColumn = false;
+			Append(ch);
+		}
+	}
+
+	m_bHitEOF = true;
+
+	// return with success if the current column is not empty, otherwise it was the eof
+	return Finish((iSkipped || m_sUnescaped.size() > iOffset) ? STATE::EndOfRecord : STATE::EndOfFile, m_sInput.size());
+
+} // ReadEscapedColumn
+
+//-----------------------------------------------------------------------------
+bool KInCSVBuffer::Read(Record& Columns)
+//-----------------------------------------------------------------------------
+{
+	Columns.clear();
+	m_sUnescaped.clear();
+	m_Escaped.clear();
+
+	STATE State;
+
+	do
+	{
+		State = ReadColumn(&Columns);
+	}
+	while (State == STATE::EndOfColumn);
+
+	for (const auto& Escaped : m_Escaped)
+	{
+		Columns[Escaped.iColumn] = KStringView(m_sUnescaped.data() + Escaped.iStart, Escaped.iSize);
+	}
+
+	return State == STATE::EndOfRecord || !Columns.empty();
+
+} // Read
+
+//-----------------------------------------------------------------------------
+bool KInCSVBuffer::HasCompleteRecords()
+//-----------------------------------------------------------------------------
+{
+	for (;;)
+	{
+		auto State = ReadColumn(nullptr);
+
+		if (m_bHitEOF)
+		{
+			// the last record was not terminated by a record limiter
+			return false;
+		}
+
+		if (State == STATE::EndOfRecord && AtEnd())
+		{
+			return true;
+		}
+	}
+
+} // HasCompleteRecords
+
+//-----------------------------------------------------------------------------
+std::vector<KStringView> KInCSVBuffer::Split(std::size_t iParts, std::size_t iMinPartSize) const
+//-----------------------------------------------------------------------------
+{
+	auto sInput = m_sInput.substr(m_iPos);
+
+	if (!iParts)
+	{
+		iParts = std::thread::hardware_concurrency();
+	}
+
+	iParts = std::min(iParts, sInput.size() / std::max(iMinPartSize, std::size_t(1)));
+
+	if (iParts < 2)
+	{
+		return { sInput };
+	}
+
+	auto pBuf   = sInput.data();
+	auto iSize  = sInput.size();
+	auto iChunk = iSize / iParts;
+
+	// count the field limiters of each chunk in parallel, their parity at a
+	// split point tells if it is inside or outside of a quoted column
+	std::vector<std::size_t> Quotes(iParts);
+
+	{
+		KRunThreads Threads;
+
+		for (std::size_t iPart = 0; iPart < iParts; ++iPart)
+		{
+			Threads.CreateOne([&, iPart]()
+			{
+				auto iFrom = iPart * iChunk;
+				auto iTo   = (iPart + 1 == iParts) ? iSize : iFrom + iChunk;
+				Quotes[iPart] = std::count(pBuf + iFrom, pBuf + iTo, m_Limiters[FieldLimiter]);
+			});
+		}
+	}
+
+	std::vector<KStringView> Parts;
+	std::size_t iStart  { 0 };
+	std::size_t iQuotes { 0 };
+
+	for (std::size_t iPart = 1; iPart < iParts; ++iPart)
+	{
+		iQuotes += Quotes[iPart - 1];
+
+		auto iPos = iPart * iChunk;
+		auto iEnd = iPos + iChunk;
+		bool bInsideQuotes = (iQuotes & 1);
+
+		// find the first record limiter outside of quotes in this chunk
+		for (; iPos < iEnd; ++iPos)
+		{
+			auto ch = pBuf[iPos];
+
+			if (ch == m_Limiters[FieldLimiter])
+			{
+				bInsideQuotes = !bInsideQuotes;
+			}
+			else if (ch == m_Limiters[RecordLimiter] && !bInsideQuotes)
+			{
+				break;
+			}
+		}
+
+		if (iPos < iEnd)
+		{
+			Parts.push_back(sInput.substr(iStart, iPos + 1 - iStart));
+			iStart = iPos + 1;
+		}
+	}
+
+	if (iStart < iSize || Parts.empty())
+	{
+		Parts.push_back(sInput.substr(iStart));
+	}
+
+	return Parts;
+
+} // Split
+
+//-----------------------------------------------------------------------------
+std::size_t KInCSVBuffer::ParallelRead(const Callback& Callback, std::size_t iThreads)
+//-----------------------------------------------------------------------------
+{
+	auto Parts = Split(iThreads);
+
+	if (Parts.size() > 1)
+	{
+		// the split points are only record boundaries if all parts but the last
+		// end exactly with a record, check this before calling back any record
+		std::vector<uint8_t> Complete(Parts.size() - 1, false);
+
+		{
+			KRunThreads Threads;
+
+			for (std::size_t iPart = 0; iPart < Complete.size(); ++iPart)
+			{
+				Threads.CreateOne([&, iPart]()
+				{
+					KInCSVBuffer Part(Parts[iPart], m_Limiters[RecordLimiter], m_Limiters[ColumnLimiter], m_Limiters[FieldLimiter]);
+					Complete[iPart] = Part.HasCompleteRecords();
+				});
+			}
+		}
+
+		if (std::find(Complete.begin(), Complete.end(), false) != Complete.end())
+		{
+			kDebug(2, "unbalanced field limiters, reading sequentially");
+			Parts.erase(Parts.begin() + 1, Parts.end());
+		}
+	}
+
+	std::size_t iRecords { 0 };
+
+	if (Parts.size() < 2)
+	{
+		Record Columns;
+
+		while (Read(Columns))
+		{
+			Callback(Columns, 0);
+			++iRecords;
+		}
+
+		return iRecords;
+	}
+
+	std::atomic<std::size_t> iTotal { 0 };
+
+	{
+		KRunThreads Threads;
+
+		for (std::size_t iPart = 0; iPart < Parts.size(); ++iPart)
+		{
+			Threads.CreateOne([&, iPart]()
+			{
+				KInCSVBuffer Part(Parts[iPart], m_Limiters[RecordLimiter], m_Limiters[ColumnLimiter], m_Limiters[FieldLimiter]);
+				Record Columns;
+				std::size_t iCount { 0 };
+
+				while (Part.Read(Columns))
+				{
+					Callback(Columns, iPart);
+					++iCount;
+				}
+
+				iTotal += iCount;
+			});
+		}
+	}
+
+	m_iPos = m_sInput.size();
+
+	return iTotal;
+
+} // ParallelRead
+
 DEKAF2_NAMESPACE_END
@@ -55,6 +55,7 @@
 #include <dekaf2/data/json/kjson.h>
 #include <vector>
 #include <memory>
+#include <functional>
 
 DEKAF2_NAMESPACE_BEGIN
 
@@ -226,6 +227,123 @@ private:
 
 }; // KCSV
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+/// Fast CSV reader for input that is completely in memory, like a large string
+/// or a KConstMemoryMap (pass its ToView()). Delimiters, field limiters and record
+/// ends are searched 64 bytes at a time with SIMD instructions where available.
+/// The columns of a record are returned as string views into the input, only
+/// columns that need unescaping are copied into an internal buffer. The views
+/// stay valid until the next call to Read(). The parsing semantics are the same
+/// as for KCSV::Read().
+class DEKAF2_PUBLIC KInCSVBuffer
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+{
+
+//------
+public:
+//------
+
+	using Record   = std::vector<KStringView>;
+	/// callback for ParallelRead(), iPart is the index of the input part the record is from
+	using Callback = std::function<void(Record& Columns, std::size_t iPart)>;
+
+	//-----------------------------------------------------------------------------
+	/// construct a CSV reader on a buffer, with record, column and field delimiters (defaulted) -
+	/// the buffer has to stay valid during the lifetime of the reader and the returned records
+	KInCSVBuffer(KStringView sInput,
+	             char chRecordLimiter = '\n',
+	             char chColumnLimiter = ',',
+	             char chFieldLimiter  = '"');
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// skip UTF8 BOM if existing at the current position - call before the first Read()
+	KInCSVBuffer& SkipBOM();
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// read the next record into Columns (which is cleared first), returns false at end of input
+	bool Read(Record& Columns);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// read the next record, returns an empty record at end of input
+	DEKAF2_NODISCARD
+	Record Read()
+	//-----------------------------------------------------------------------------
+	{
+		Record Columns;
+		Read(Columns);
+		return Columns;
+	}
+
+	//-----------------------------------------------------------------------------
+	/// returns true if all input has been read
+	DEKAF2_NODISCARD
+	bool AtEnd() const                  { return m_iPos >= m_sInput.size(); }
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// returns the current read position in the input buffer
+	DEKAF2_NODISCARD
+	std::size_t GetPosition() const     { return m_iPos;                    }
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// split the unread input into at most iParts parts of about equal size, at record
+	/// boundaries that are outside of field limiters. If the input contains unbalanced
+	/// field limiters, the split points may not be record boundaries - ParallelRead()
+	/// checks for this and falls back to sequential reading.
+	/// @param iParts count of wanted parts, 0 = count of CPU cores
+	/// @param iMinPartSize minimum size of one part, to avoid splitting small input
+	DEKAF2_NODISCARD
+	std::vector<KStringView> Split(std::size_t iParts = 0, std::size_t iMinPartSize = 64 * 1024) const;
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// read all unread records with iThreads parallel threads (0 = count of CPU cores). The
+	/// callback is called from the different threads in parallel, but the records of one part
+	/// arrive in input order from one single thread. The callback must not throw.
+	/// Returns the count of read records.
+	std::size_t ParallelRead(const Callback& Callback, std::size_t iThreads = 0);
+	//-----------------------------------------------------------------------------
+
+//------
+private:
+//------
+
+	enum { RecordLimiter = 0, ColumnLimiter = 1, FieldLimiter = 2 };
+	enum class STATE { EndOfRecord, EndOfColumn, EndOfFile };
+
+	/// read one column and append it to Columns, if Columns is nullptr only advance the position
+	STATE ReadColumn(Record* Columns);
+	/// the exact state machine of KCSV::ReadColumn(), for columns that need unescaping
+	STATE ReadEscapedColumn(std::size_t iStart, Record* Columns);
+	/// returns position of the next record, column or field limiter or CR at or after iPos
+	std::size_t FindSpecial(std::size_t iPos);
+	/// checks if the input consists of complete records only
+	bool HasCompleteRecords();
+
+	struct Escaped
+	{
+		std::size_t iColumn;
+		std::size_t iStart;
+		std::size_t iSize;
+	};
+
+	KStringView         m_sInput;
+	std::size_t         m_iPos         { 0 };
+	std::size_t         m_iBlock       { 0 };
+	uint64_t            m_iBlockMask   { 0 };
+	bool                m_bHaveBlock   { false };
+	bool                m_bHitEOF      { false };
+	char                m_Limiters[3];
+	char                m_chCR;
+	KString             m_sUnescaped;
+	std::vector<Escaped> m_Escaped;
+
+}; // KInCSVBuffer
+
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 template<class Record = std::vector<KString>>
 class DEKAF2_PUBLIC KInCSV : protected KCSV
@@ -252,15 +370,16 @@ public:
 	}
 
 	//-----------------------------------------------------------------------------
-	/// construct a CSV reader with string_view, record, column and field delimiters (defaulted)
+	/// construct a CSV reader with string_view, record, column and field delimiters (defaulted) -
+	/// the input is parsed with a KInCSVBuffer and has to stay valid during the lifetime of the reader
 	KInCSV(KStringView sIn,
 		   char chRecordLimiter = '\n',
 		   char chColumnLimiter = ',',
 		   char chFieldLimiter  = '"')
 	//-----------------------------------------------------------------------------
 	:   KCSV(chRecordLimiter, chColumnLimiter, chFieldLimiter)
-	,   m_InStringStream(std::make_unique<KInStringStream>(sIn))
-	,   m_In(*m_InStringStream)
+	,   m_Buffer(std::make_unique<KInCSVBuffer>(sIn, chRecordLimiter, chColumnLimiter, chFieldLimiter))
+	,   m_In(kGetNullInStream())
 	{
 	}
 
@@ -318,7 +437,14 @@ public:
 	KInCSV& SkipBOM()
 	//-----------------------------------------------------------------------------
 	{
-		KCSV::SkipBOM(m_In);
+		if (m_Buffer)
+		{
+			m_Buffer->SkipBOM();
+		}
+		else
+		{
+			KCSV::SkipBOM(m_In);
+		}
 		return *this;
 	}
 
@@ -327,7 +453,7 @@ public:
 	Record Read()
 	//-----------------------------------------------------------------------------
 	{
-		return KCSV::Read<Record>(m_In);
+		return ReadRecord<Record>();
 	}
 
 	//-----------------------------------------------------------------------------
@@ -338,7 +464,7 @@ public:
 	{
 		if (!m_Headers)
 		{
-			SetHeaders(KCSV::Read<StringVector>(m_In));
+			SetHeaders(ReadRecord<StringVector>());
 		}
 
 		return *m_Headers;
@@ -367,7 +493,7 @@ public:
 			if (!m_Headers)
 			{
 				// read first / next line as headers
-				SetHeaders(KCSV::Read<StringVector>(m_In));
+				SetHeaders(ReadRecord<StringVector>());
 			}
 
 			for (auto& Row : *this)
@@ -412,7 +538,32 @@ public:
 protected:
 //------
 
-	std::unique_ptr<KInStringStream> m_InStringStream;
+	//-----------------------------------------------------------------------------
+	/// read the next record either from the buffer or from the stream
+	template<class Columns>
+	Columns ReadRecord()
+	//-----------------------------------------------------------------------------
+	{
+		if (!m_Buffer)
+		{
+			return KCSV::Read<Columns>(m_In);
+		}
+
+		Columns Row;
+
+		if (m_Buffer->Read(m_Columns))
+		{
+			for (auto sColumn : m_Columns)
+			{
+				Row.push_back(KString(sColumn));
+			}
+		}
+
+		return Row;
+	}
+
+	std::unique_ptr<KInCSVBuffer>    m_Buffer;
+	KInCSVBuffer::Record             m_Columns;
 	std::unique_ptr<StringVector>    m_Headers;
 	KInStream&                       m_In;
 
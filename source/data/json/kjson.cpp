@@ -46,6 +46,7 @@
 #include <dekaf2/core/strings/kutf.h>
 #include <dekaf2/core/types/kctype.h>
 #include <dekaf2/core/strings/kstringutils.h>
+#include <dekaf2/core/strings/bits/simd/kescapescan.h>
 #include <dekaf2/io/readwrite/kreader.h>
 #ifndef DEKAF2_WRAPPED_KJSON
 	#include <dekaf2/core/types/kscopeguard.h>
@@ -949,11 +950,40 @@ void Escape (KStringView sInput, KStringRef& sOutput)
 	static constexpr KStringView::value_type BACKSLASH         = 0x5c;
 	static constexpr KStringView::value_type MAX_CONTROL_CHARS = 0x1f;
 
+	// all control characters, the double quote and the backslash
+	static const DEKAF2_PREFIX detail::KEscapeScan s_Scan = []()
+	{
+		bool Table[256] {};
+
+		for (int ch = 0; ch <= MAX_CONTROL_CHARS; ++ch)
+		{
+			Table[ch] = true;
+		}
+
+		Table[static_cast<unsigned char>(DOUBLEQUOTE)] = true;
+		Table[static_cast<unsigned char>(BACKSLASH)]   = true;
+
+		return DEKAF2_PREFIX detail::KEscapeScan(Table, true);
+	}();
+
 	// reserve at least the bare size of sInput in sOutput
 	sOutput.reserve(sOutput.size() + sInput.size());
 
-	for (auto ch : sInput)
+	for (;;)
 	{
+		auto iSpecial = s_Scan.find_first_in(sInput);
+
+		if (iSpecial == KStringView::npos)
+		{
+			sOutput += sInput;
+			break;
+		}
+
+		// copy the clean run in one go
+		sOutput += sInput.substr(0, iSpecial);
+		auto ch  = sInput[iSpecial];
+		sInput.remove_prefix(iSpecial + 1);
+
 		switch (ch)
 		{
 			case BACKSPACE:
@@ -1007,16 +1037,9 @@ void Escape (KStringView sInput, KStringRef& sOutput)
 
 			default:
 			{
-				// escape control characters (0x00..0x1F)
-				if (kutf::CodepointCast(ch) <= MAX_CONTROL_CHARS)
-				{
-					sOutput += "\\u00";
-					sOutput += KString::to_hexstring(kutf::CodepointCast(ch));
-				}
-				else
-				{
-					sOutput += ch;
-				}
+				// escape the remaining control characters (0x00..0x1F)
+				sOutput += "\\u00";
+				sOutput += KString::to_hexstring(kutf::CodepointCast(ch));
 				break;
 			}
 		}
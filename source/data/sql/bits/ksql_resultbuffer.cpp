@@ -0,0 +1,452 @@
+/*
+//
+// DEKAF(tm): Lighter, Faster, Smarter(tm)
+//
+// Copyright (c) 2026, Ridgeware, Inc.
+//
+// +-------------------------------------------------------------------------+
+// | /\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\|
+// |/+---------------------------------------------------------------------+/|
+// |/|                                                                     |/|
+// |\|  ** THIS NOTICE MUST NOT BE REMOVED FROM THE SOURCE CODE MODULE **  |\|
+// |/|                                                                     |/|
+// |\|   OPEN SOURCE LICENSE                                               |\|
+// |/|                                                                     |/|
+// |\|   Permission is hereby granted, free of charge, to any person       |\|
+// |/|   obtaining a copy of this software and associated                  |/|
+// |\|   documentation files (the "Software"), to deal in the              |\|
+// |/|   Software without restriction, including without limitation        |/|
+// |\|   the rights to use, copy, modify, merge, publish,                  |\|
+// |/|   distribute, sublicense, and/or sell copies of the Software,       |/|
+// |\|   and to permit persons to whom the Software is furnished to        |\|
+// |/|   do so, subject to the following conditions:                       |/|
+// |\|                                                                     |\|
+// |/|   The above copyright notice and this permission notice shall       |/|
+// |\|   be included in all copies or substantial portions of the          |\|
+// |/|   Software.                                                         |/|
+// |\|                                                                     |\|
+// |/|   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY         |/|
+// |\|   KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE        |\|
+// |/|   WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR           |/|
+// |\|   PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS        |\|
+// |/|   OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR          |/|
+// |\|   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR        |\|
+// |/|   OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE         |/|
+// |\|   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.            |\|
+// |/|                                                                     |/|
+// |/+---------------------------------------------------------------------+/|
+// |\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/ |
+// +-------------------------------------------------------------------------+
+//
+*/
+
+#include <dekaf2/data/sql/bits/ksql_resultbuffer.h>
+#include <dekaf2/io/readwrite/kreader.h>
+#include <dekaf2/io/readwrite/kwriter.h>
+#include <dekaf2/system/filesystem/kfilesystem.h>
+#include <dekaf2/core/format/kformat.h>
+#include <dekaf2/core/logging/klog.h>
+#include <algorithm>
+
+DEKAF2_NAMESPACE_BEGIN
+
+namespace {
+
+//-----------------------------------------------------------------------------
+/// write iValue as LEB128 varint into pOut, returns count of written bytes
+inline std::size_t EncodeLength(uint64_t iValue, char* pOut)
+//-----------------------------------------------------------------------------
+{
+	std::size_t iCount { 0 };
+
+	while (iValue >= 0x80)
+	{
+		pOut[iCount++] = static_cast<char>(iValue | 0x80);
+		iValue >>= 7;
+	}
+
+	pOut[iCount++] = static_cast<char>(iValue);
+
+	return iCount;
+
+} // EncodeLength
+
+//-----------------------------------------------------------------------------
+/// read a LEB128 varint from p, returns nullptr on overrun
+inline const char* DecodeLength(const char* p, const char* pEnd, uint64_t& iValue)
+//-----------------------------------------------------------------------------
+{
+	iValue = 0;
+
+	for (uint16_t iShift = 0; p < pEnd && iShift < 64; iShift += 7)
+	{
+		auto ch = static_cast<uint8_t>(*p++);
+		iValue |= static_cast<uint64_t>(ch & 0x7f) << iShift;
+
+		if (!(ch & 0x80))
+		{
+			return p;
+		}
+	}
+
+	return nullptr;
+
+} // DecodeLength
+
+} // end of anonymous namespace
+
+//-----------------------------------------------------------------------------
+KSQLResultBuffer::~KSQLResultBuffer()
+//-----------------------------------------------------------------------------
+{
+	clear();
+
+} // dtor
+
+//-----------------------------------------------------------------------------
+KSQLResultBuffer::KSQLResultBuffer(KSQLResultBuffer&& other) noexcept
+//-----------------------------------------------------------------------------
+{
+	*this = std::move(other);
+
+} // move ctor
+
+//-----------------------------------------------------------------------------
+KSQLResultBuffer& KSQLResultBuffer::operator=(KSQLResultBuffer&& other) noexcept
+//-----------------------------------------------------------------------------
+{
+	if (this != &other)
+	{
+		clear();
+
+		// the read block pointer may point into the other instance
+		auto bReadsSpilled = other.m_pBlock == &other.m_sReadBlock;
+
+		m_Blocks         = std::move(other.m_Blocks);
+		m_Row            = std::move(other.m_Row);
+		m_sReadBlock     = std::move(other.m_sReadBlock);
+		m_sSpillFile     = std::move(other.m_sSpillFile);
+		m_sError         = std::move(other.m_sError);
+		m_SpillOut       = std::move(other.m_SpillOut);
+		m_SpillIn        = std::move(other.m_SpillIn);
+		m_pBlock         = bReadsSpilled ? &m_sReadBlock : other.m_pBlock;
+		m_iColumns       = other.m_iColumns;
+		m_iMaxMemory     = other.m_iMaxMemory;
+		m_iMemory        = other.m_iMemory;
+		m_iColumn        = other.m_iColumn;
+		m_iRowStart      = other.m_iRowStart;
+		m_iSpilledBlocks = other.m_iSpilledBlocks;
+		m_iReadBlock     = other.m_iReadBlock;
+		m_iReadPos       = other.m_iReadPos;
+		m_iRows          = other.m_iRows;
+
+		// the spill file now belongs to this instance
+		other.Reset();
+	}
+
+	return *this;
+
+} // move assignment
+
+//-----------------------------------------------------------------------------
+void KSQLResultBuffer::Start(std::size_t iColumns, std::size_t iMaxMemory, KStringView sSpillFile)
+//-----------------------------------------------------------------------------
+{
+	clear();
+
+	m_iColumns   = iColumns;
+	m_iMaxMemory = iMaxMemory;
+	m_sSpillFile = sSpillFile;
+
+} // Start
+
+//-----------------------------------------------------------------------------
+bool KSQLResultBuffer::Add(KStringView sValue)
+//-----------------------------------------------------------------------------
+{
+	char sLength[10];
+	auto iLengthSize = EncodeLength(sValue.size(), sLength);
+	auto iNeeded     = iLengthSize + sValue.size();
+
+	if (DEKAF2_UNLIKELY(m_Blocks.empty() || m_Blocks.back().capacity() - m_Blocks.back().size() < iNeeded))
+	{
+		// all values of a row have to be in the same block - move the
+		// already added values of the current row into the new block
+		KString sNew;
+		std::size_t iPartial { 0 };
+
+		if (!m_Blocks.empty())
+		{
+			iPartial = m_Blocks.back().size() - m_iRowStart;
+		}
+
+		sNew.reserve(std::max(BlockSize, iPartial + iNeeded));
+
+		if (iPartial)
+		{
+			sNew.append(m_Blocks.back().data() + m_iRowStart, iPartial);
+			m_Blocks.back().resize(m_iRowStart);
+		}
+
+		if (!m_Blocks.empty() && m_Blocks.back().empty())
+		{
+			m_iMemory -= m_Blocks.back().capacity();
+			m_Blocks.pop_back();
+		}
+
+		if (m_iMaxMemory && m_iMemory + sNew.capacity() > m_iMaxMemory && !m_Blocks.empty())
+		{
+			if (!SpillBlocks())
+			{
+				return false;
+			}
+		}
+
+		m_iMemory  += sNew.capacity();
+		m_iRowStart = 0;
+		m_Blocks.push_back(std::move(sNew));
+	}
+
+	auto& sBlock = m_Blocks.back();
+	sBlock.append(sLength, iLengthSize);
+	sBlock.append(sValue.data(), sValue.size());
+
+	if (++m_iColumn == m_iColumns)
+	{
+		m_iColumn   = 0;
+		m_iRowStart = sBlock.size();
+		++m_iRows;
+	}
+
+	return true;
+
+} // Add
+
+//-----------------------------------------------------------------------------
+bool KSQLResultBuffer::SpillBlocks()
+//-----------------------------------------------------------------------------
+{
+	if (!m_SpillOut)
+	{
+		if (m_sSpillFile.empty())
+		{
+			return SetError("no spill file name set");
+		}
+
+		kDebug(2, "memory limit of {} bytes reached, spilling into {}", m_iMaxMemory, m_sSpillFile);
+
+		m_SpillOut = std::make_unique<KOutFile>(m_sSpillFile, std::ios::trunc);
+
+		if (!m_SpillOut->Good())
+		{
+			return SetError(kFormat("cannot open spill file for writing: {}", m_sSpillFile));
+		}
+	}
+
+	for (auto& sBlock : m_Blocks)
+	{
+		uint64_t iSize = sBlock.size();
+		m_SpillOut->Write(&iSize, sizeof(iSize));
+		m_SpillOut->Write(sBlock.data(), sBlock.size());
+		m_iMemory -= sBlock.capacity();
+		++m_iSpilledBlocks;
+	}
+
+	m_Blocks.clear();
+
+	if (!m_SpillOut->Good())
+	{
+		return SetError(kFormat("cannot write to spill file: {}", m_sSpillFile));
+	}
+
+	return true;
+
+} // SpillBlocks
+
+//-----------------------------------------------------------------------------
+bool KSQLResultBuffer::Finish()
+//-----------------------------------------------------------------------------
+{
+	if (m_iColumn)
+	{
+		// drop an incomplete last row
+		kDebug(1, "dropping incomplete row with {} of {} columns", m_iColumn, m_iColumns);
+		m_Blocks.back().resize(m_iRowStart);
+		m_iColumn = 0;
+	}
+
+	if (m_SpillOut)
+	{
+		m_SpillOut->Flush();
+
+		bool bGood = m_SpillOut->Good();
+
+		m_SpillOut.reset();
+
+		if (!bGood)
+		{
+			return SetError(kFormat("cannot write to spill file: {}", m_sSpillFile));
+		}
+	}
+
+	return Rewind();
+
+} // Finish
+
+//-----------------------------------------------------------------------------
+bool KSQLResultBuffer::Rewind()
+//-----------------------------------------------------------------------------
+{
+	m_Row.clear();
+	m_pBlock     = nullptr;
+	m_iReadBlock = 0;
+	m_iReadPos   = 0;
+
+	if (m_iSpilledBlocks)
+	{
+		m_SpillIn = std::make_unique<KInFile>(m_sSpillFile);
+
+		if (!m_SpillIn->is_open())
+		{
+			m_SpillIn.reset();
+			return SetError(kFormat("cannot open spill file for reading: {}", m_sSpillFile));
+		}
+	}
+
+	return true;
+
+} // Rewind
+
+//-----------------------------------------------------------------------------
+bool KSQLResultBuffer::LoadBlock()
+//-----------------------------------------------------------------------------
+{
+	for (;;)
+	{
+		if (m_iReadBlock < m_iSpilledBlocks)
+		{
+			uint64_t iSize { 0 };
+
+			if (!m_SpillIn
+				|| m_SpillIn->Read(&iSize, sizeof(iSize)) != sizeof(iSize)
+				|| (m_sReadBlock.resize_uninitialized(iSize), m_SpillIn->Read(m_sReadBlock.data(), iSize) != iSize))
+			{
+				return SetError(kFormat("cannot read from spill file: {}", m_sSpillFile));
+			}
+
+			m_pBlock = &m_sReadBlock;
+		}
+		else
+		{
+			auto iBlock = m_iReadBlock - m_iSpilledBlocks;
+
+			if (iBlock >= m_Blocks.size())
+			{
+				m_pBlock = nullptr;
+				return false;
+			}
+
+			m_pBlock = &m_Blocks[iBlock];
+		}
+
+		++m_iReadBlock;
+		m_iReadPos = 0;
+
+		if (!m_pBlock->empty())
+		{
+			return true;
+		}
+	}
+
+} // LoadBlock
+
+//-----------------------------------------------------------------------------
+bool KSQLResultBuffer::NextRow()
+//-----------------------------------------------------------------------------
+{
+	if (DEKAF2_UNLIKELY(!m_pBlock || m_iReadPos >= m_pBlock->size()))
+	{
+		if (!m_iColumns || !LoadBlock())
+		{
+			m_Row.clear();
+			return false;
+		}
+	}
+
+	m_Row.resize(m_iColumns);
+
+	auto p    = m_pBlock->data() + m_iReadPos;
+	auto pEnd = m_pBlock->data() + m_pBlock->size();
+
+	for (auto& sValue : m_Row)
+	{
+		uint64_t iSize;
+		p = DecodeLength(p, pEnd, iSize);
+
+		if (DEKAF2_UNLIKELY(!p || iSize > static_cast<uint64_t>(pEnd - p)))
+		{
+			m_Row.clear();
+			return SetError("buffered results are corrupted");
+		}
+
+		sValue = KStringView(p, iSize);
+		p += iSize;
+	}
+
+	m_iReadPos = p - m_pBlock->data();
+
+	return true;
+
+} // NextRow
+
+//-----------------------------------------------------------------------------
+void KSQLResultBuffer::clear()
+//-----------------------------------------------------------------------------
+{
+	m_SpillIn.reset();
+	m_SpillOut.reset();
+
+	if (m_iSpilledBlocks && !m_sSpillFile.empty())
+	{
+		kRemoveFile(m_sSpillFile);
+	}
+
+	Reset();
+
+} // clear
+
+//-----------------------------------------------------------------------------
+void KSQLResultBuffer::Reset()
+//-----------------------------------------------------------------------------
+{
+	m_SpillIn.reset();
+	m_SpillOut.reset();
+	m_Blocks.clear();
+	m_Row.clear();
+	m_sReadBlock.clear();
+	m_sSpillFile.clear();
+	m_sError.clear();
+	m_pBlock         = nullptr;
+	m_iColumns       = 0;
+	m_iMaxMemory     = 0;
+	m_iMemory        = 0;
+	m_iColumn        = 0;
+	m_iRowStart      = 0;
+	m_iSpilledBlocks = 0;
+	m_iReadBlock     = 0;
+	m_iReadPos       = 0;
+	m_iRows          = 0;
+
+} // Reset
+
+//-----------------------------------------------------------------------------
+bool KSQLResultBuffer::SetError(KString sError)
+//-----------------------------------------------------------------------------
+{
+	kDebug(1, "{}", sError);
+	m_sError = std::move(sError);
+	return false;
+
+} // SetError
+
+DEKAF2_NAMESPACE_END
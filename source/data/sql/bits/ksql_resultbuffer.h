@@ -0,0 +1,161 @@
+/*
+//
+// DEKAF(tm): Lighter, Faster, Smarter(tm)
+//
+// Copyright (c) 2026, Ridgeware, Inc.
+//
+// +-------------------------------------------------------------------------+
+// | /\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\|
+// |/+---------------------------------------------------------------------+/|
+// |/|                                                                     |/|
+// |\|  ** THIS NOTICE MUST NOT BE REMOVED FROM THE SOURCE CODE MODULE **  |\|
+// |/|                                                                     |/|
+// |\|   OPEN SOURCE LICENSE                                               |\|
+// |/|                                                                     |/|
+// |\|   Permission is hereby granted, free of charge, to any person       |\|
+// |/|   obtaining a copy of this software and associated                  |/|
+// |\|   documentation files (the "Software"), to deal in the              |\|
+// |/|   Software without restriction, including without limitation        |/|
+// |\|   the rights to use, copy, modify, merge, publish,                  |\|
+// |/|   distribute, sublicense, and/or sell copies of the Software,       |/|
+// |\|   and to permit persons to whom the Software is furnished to        |\|
+// |/|   do so, subject to the following conditions:                       |/|
+// |\|                                                                     |\|
+// |/|   The above copyright notice and this permission notice shall       |/|
+// |\|   be included in all copies or substantial portions of the          |\|
+// |/|   Software.                                                         |/|
+// |\|                                                                     |\|
+// |/|   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY         |/|
+// |\|   KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE        |\|
+// |/|   WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR           |/|
+// |\|   PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS        |\|
+// |/|   OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR          |/|
+// |\|   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR        |\|
+// |/|   OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE         |/|
+// |\|   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.            |\|
+// |/|                                                                     |/|
+// |/+---------------------------------------------------------------------+/|
+// |\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/ |
+// +-------------------------------------------------------------------------+
+//
+*/
+
+#pragma once
+
+/// @file ksql_resultbuffer.h
+/// binary in-memory buffer for query results, spilling to a file when growing too large
+
+#include <dekaf2/core/init/kdefinitions.h>
+#include <dekaf2/core/strings/kstring.h>
+#include <dekaf2/core/strings/kstringview.h>
+#include <vector>
+#include <memory>
+#include <cinttypes>
+
+DEKAF2_NAMESPACE_BEGIN
+
+class KInFile;
+class KOutFile;
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+/// Buffers the rows of a query result as length prefixed binary values in a chain of memory
+/// blocks. All columns of a row are stored in the same block, therefore the values of the
+/// current row can be returned as string views into the block, without copying. Once the
+/// used memory exceeds a configurable limit, all full blocks are moved into a binary spill
+/// file, which is read back block by block when iterating. Values are stored unmodified,
+/// binary data and newlines are preserved.
+class DEKAF2_PUBLIC KSQLResultBuffer
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+{
+
+//----------
+public:
+//----------
+
+	/// default memory limit before spilling into a file
+	static constexpr std::size_t DefaultMaxMemory = 64 * 1024 * 1024;
+
+	KSQLResultBuffer() = default;
+	~KSQLResultBuffer();
+
+	KSQLResultBuffer(const KSQLResultBuffer&) = delete;
+	KSQLResultBuffer& operator=(const KSQLResultBuffer&) = delete;
+	KSQLResultBuffer(KSQLResultBuffer&& other) noexcept;
+	KSQLResultBuffer& operator=(KSQLResultBuffer&& other) noexcept;
+
+	/// start a new buffer, deletes all previous content
+	/// @param iColumns the count of columns per row
+	/// @param iMaxMemory the count of bytes to hold in memory before spilling into a file, 0 for no limit
+	/// @param sSpillFile the name of the file to spill into - it will be removed on clear()
+	void        Start         (std::size_t iColumns, std::size_t iMaxMemory, KStringView sSpillFile);
+
+	/// add one value to the current row, after the last column of a row the next row starts
+	/// @return false if the spill file could not be written
+	bool        Add           (KStringView sValue);
+
+	/// finish adding rows, and prepare for reading from the first row on
+	/// @return false if the spill file could not be written or opened for reading
+	bool        Finish        ();
+
+	/// advance to the next row
+	/// @return false if there are no more rows
+	bool        NextRow       ();
+
+	/// returns a value of the current row, valid until the next call of NextRow()
+	/// @param iColumn zero based column index
+	KStringView Get           (std::size_t iColumn) const
+	{
+		return (iColumn < m_Row.size()) ? m_Row[iColumn] : KStringView{};
+	}
+
+	/// restart reading at the first row
+	/// @return false if the spill file cannot be read
+	bool        Rewind        ();
+
+	/// release all memory and remove the spill file
+	void        clear         ();
+
+	/// returns the count of buffered rows
+	uint64_t    GetRowCount   () const { return m_iRows;     }
+
+	/// returns the count of bytes currently held in memory
+	std::size_t GetMemoryUsage() const { return m_iMemory;   }
+
+	/// returns true if blocks have been spilled into a file
+	bool        HasSpilled    () const { return m_iSpilledBlocks > 0; }
+
+	/// returns the last error
+	const KString& GetLastError() const { return m_sError; }
+
+//----------
+private:
+//----------
+
+	static constexpr std::size_t BlockSize = 256 * 1024;
+
+	bool        SpillBlocks   ();
+	bool        LoadBlock     ();
+	bool        SetError      (KString sError);
+	void        Reset         ();
+
+	std::vector<KString>      m_Blocks;
+	std::vector<KStringView>  m_Row;
+	KString                   m_sReadBlock;
+	KString                   m_sSpillFile;
+	KString                   m_sError;
+	std::unique_ptr<KOutFile> m_SpillOut;
+	std::unique_ptr<KInFile>  m_SpillIn;
+	const KString*            m_pBlock         { nullptr };
+	std::size_t               m_iColumns       { 0 };
+	std::size_t               m_iMaxMemory     { 0 };
+	std::size_t               m_iMemory        { 0 };
+	std::size_t               m_iColumn        { 0 };
+	std::size_t               m_iRowStart      { 0 };
+	std::size_t               m_iSpilledBlocks { 0 };
+	std::size_t               m_iReadBlock     { 0 };
+	std::size_t               m_iReadPos       { 0 };
+	uint64_t                  m_iRows          { 0 };
+
+}; // KSQLResultBuffer
+
+DEKAF2_NAMESPACE_END
@@ -69,6 +69,7 @@
 #include <dekaf2/util/cli/kxterm.h>
 #include <dekaf2/system/process/koutshell.h>
 #include <dekaf2/core/format/kformtable.h>
+#include <dekaf2/io/streams/koutstringstream.h>
 #include <dekaf2/data/json/kconfig.h>
 #include <dekaf2/crypto/encoding/kencode.h>
 #include <dekaf2/util/id/kuuid.h>
@@ -274,6 +275,7 @@ constexpr SQLTX g_Translations[] = {
 	// ---------------  ----------------  ----------------  ---------------  --------------  ---------------  ----------------------------  ----------------------------
 };
 
+#ifdef DEKAF2_HAS_ORACLE
 //-----------------------------------------------------------------------------
 static void*  kfree (void* dPointer, const char* sContext = nullptr )
 //-----------------------------------------------------------------------------
@@ -286,6 +288,7 @@ static void*  kfree (void* dPointer, const char* sContext = nullptr )
 	return (nullptr);
 
 } // kfree
+#endif
 
 //-----------------------------------------------------------------------------
 void* kmalloc (size_t iNumBytes, const char* pszContext, bool bClearMemory = true)
@@ -805,7 +808,7 @@ void KSQL::FreeAll (bool bDestructor/*=false*/)
 		kDebug (3, "FreeAll()...");
 		kDebug (3, "  instance cleanup:");
 		kDebug (3, "    m_bConnectionIsOpen        = {}", (m_bConnectionIsOpen) ? "true" : "false");
-		kDebug (3, "    m_bFileIsOpen              = {}", (m_bFileIsOpen) ? "true" : "false");
+		kDebug (3, "    m_BufferedResults          = {} rows, {} bytes in memory", m_BufferedResults.GetRowCount(), m_BufferedResults.GetMemoryUsage());
 		kDebug (3, "    m_bQueryStarted            = {}", (m_bQueryStarted) ? "true" : "false");
 
 		kDebug (3, "  dynamic memory outlook:");
@@ -826,7 +829,6 @@ void KSQL::FreeAll (bool bDestructor/*=false*/)
 #endif
 		kDebug (3, "    m_dOCI8Statement           = {}{}", m_dOCI8Statement, (m_dOCI8Statement) ? " (needs to be freed)" : "");
 #endif
-//		kDebug (3, "    m_dBufferedColArray        = {}{}", m_dBufferedColArray, (m_dBufferedColArray) ? " (needs to be freed)" : "");
 	}
 
 #ifdef DEKAF2_HAS_MYSQL
@@ -4221,12 +4223,9 @@ bool KSQL::BufferResults ()
 
 	RemoveTempResultsFile();
 
-	KOutFile file(GetTempResultsFile());
-	if (!file.Good())
-	{
-		return SetError(kFormat ("BufferResults(): could not buffer results b/c {} could not write to '{}'",
-								 kwhoami(), GetTempResultsFile()));
-	}
+	// rows are buffered in memory, and only spill into the temp results file
+	// when exceeding the memory limit
+	m_BufferedResults.Start(m_iNumColumns, m_iMaxBufferedMemory, GetTempResultsFile());
 
 	m_iNumRowsBuffered = 0;
 
@@ -4247,20 +4246,17 @@ bool KSQL::BufferResults ()
 			++m_iNumRowsBuffered;
 			for (KROW::Index ii=0; ii<m_iNumColumns; ++ii)
 			{
-				KString sColVal;
+				KStringView sColVal;
 				if (m_MYSQLRowLens)
 				{
 					sColVal = KStringView(m_MYSQLRow[ii], m_MYSQLRowLens[ii]);
 				}
-				else
+				else if (m_MYSQLRow[ii])
 				{
-					// fall back to C strcpy
+					// fall back to C strlen
 					sColVal = m_MYSQLRow[ii];
 				}
 
-				// we need to assure that no newlines are in buffered data:
-				sColVal.Replace('\n', 2);  // <-- change them to ^B (warning: this kills binary columns, it should be switched to an escaping format)
-
 				if (sColVal.size() > 50)
 				{
 					kDebug (3, "  buffered: row[{}]col[{}]: strlen()={}", m_iNumRowsBuffered, ii+1, sColVal.size());
@@ -4270,8 +4266,10 @@ bool KSQL::BufferResults ()
 					kDebug (3, "  buffered: row[{}]col[{}]: '{}'", m_iNumRowsBuffered, ii+1, sColVal);
 				}
 
-				file.FormatLine ("{}|{}|{}", m_iNumRowsBuffered, ii+1, sColVal.size());
-				file.FormatLine ("{}\n", sColVal);
+				if (!m_BufferedResults.Add (sColVal))
+				{
+					return SetError(kFormat ("BufferResults(): {}", m_BufferedResults.GetLastError()));
+				}
 			}
 		}
 		break;
@@ -4329,15 +4327,10 @@ bool KSQL::BufferResults ()
 				{
 					kDebug (3, "  buffered: row[{}]col[{}]: '{}'", m_iNumRowsBuffered, ii+1, m_dColInfo[ii].dszValue.get());
 				}
-				// we need to assure that no newlines are in buffered data:
-				char* spot = strchr (m_dColInfo[ii].dszValue.get(), '\n');
-				while (spot)
+				if (!m_BufferedResults.Add (m_dColInfo[ii].dszValue ? m_dColInfo[ii].dszValue.get() : ""))
 				{
-					*spot = 2; // <-- change them to ^B
-					spot = strchr (spot+1, '\n');
+					return SetError(kFormat ("BufferResults(): {}", m_BufferedResults.GetLastError()));
 				}
-				kPrint (fp, "{}|{}|{}\n", m_iNumRowsBuffered, ii+1, strlen(m_dColInfo[ii].dszValue.get()));
-				kPrint (fp, "{}\n", m_dColInfo[ii].dszValue ? m_dColInfo[ii].dszValue.get() : "");
 			}
 		}
 		break;
@@ -4377,15 +4370,10 @@ bool KSQL::BufferResults ()
 					kDebug (3, "  buffered: row[{}]col[{}]: '{}'", m_iNumRowsBuffered, ii+1, m_dColInfo[ii].dszValue.get());
 				}
 
-				// we need to assure that no newlines are in buffered data:
-				char* spot = strchr (m_dColInfo[ii].dszValue.get(), '\n');
-				while (spot)
+				if (!m_BufferedResults.Add (m_dColInfo[ii].dszValue ? m_dColInfo[ii].dszValue.get() : ""))
 				{
-					*spot = 2; // <-- change them to ^B
-					spot = strchr (spot+1, '\n');
+					return SetError(kFormat ("BufferResults(): {}", m_BufferedResults.GetLastError()));
 				}
-				kPrint (fp, "{}|{}|{}\n", m_iNumRowsBuffered, ii+1, strlen(m_dColInfo[ii].dszValue.get()));
-				kPrint (fp, "{}\n", m_dColInfo[ii].dszValue ? m_dColInfo[ii].dszValue.get() : "");
 			}
 		}
 		break;
@@ -4405,9 +4393,7 @@ bool KSQL::BufferResults ()
 
 				for (KROW::Index ii = 0; ii < m_iNumColumns; ++ii)
 				{
-					KString sColVal = Row.Get<KString>(static_cast<KSQLite::Row::ColIndex>(ii + 1));
-
-					sColVal.Replace('\n', 2);
+					KStringView sColVal = Row.GetRawView(static_cast<KSQLite::Row::ColIndex>(ii + 1));
 
 					if (sColVal.size() > 50)
 					{
@@ -4418,8 +4404,10 @@ bool KSQL::BufferResults ()
 						kDebug (3, "  buffered: row[{}]col[{}]: '{}'", m_iNumRowsBuffered, ii+1, sColVal);
 					}
 
-					file.FormatLine ("{}|{}|{}", m_iNumRowsBuffered, ii+1, sColVal.size());
-					file.FormatLine ("{}\n", sColVal);
+					if (!m_BufferedResults.Add (sColVal))
+					{
+						return SetError(kFormat ("BufferResults(): {}", m_BufferedResults.GetLastError()));
+					}
 				}
 			}
 		}
@@ -4438,15 +4426,14 @@ bool KSQL::BufferResults ()
 
 				for (KROW::Index ii = 0; ii < m_iNumColumns; ++ii)
 				{
-					KString sColVal;
+					KStringView sColVal;
 
 					if (!PQgetisnull(m_PostgreSQL->Result, iRow, static_cast<int>(ii)))
 					{
-						sColVal = PQgetvalue(m_PostgreSQL->Result, iRow, static_cast<int>(ii));
+						sColVal = KStringView(PQgetvalue (m_PostgreSQL->Result, iRow, static_cast<int>(ii)),
+						                      PQgetlength(m_PostgreSQL->Result, iRow, static_cast<int>(ii)));
 					}
 
-					sColVal.Replace('\n', 2);
-
 					if (sColVal.size() > 50)
 					{
 						kDebug (3, "  buffered: row[{}]col[{}]: strlen()={}", m_iNumRowsBuffered, ii+1, sColVal.size());
@@ -4456,8 +4443,10 @@ bool KSQL::BufferResults ()
 						kDebug (3, "  buffered: row[{}]col[{}]: '{}'", m_iNumRowsBuffered, ii+1, sColVal);
 					}
 
-					file.FormatLine ("{}|{}|{}", m_iNumRowsBuffered, ii+1, sColVal.size());
-					file.FormatLine ("{}\n", sColVal);
+					if (!m_BufferedResults.Add (sColVal))
+					{
+						return SetError(kFormat ("BufferResults(): {}", m_BufferedResults.GetLastError()));
+					}
 				}
 			}
 		}
@@ -4475,23 +4464,16 @@ bool KSQL::BufferResults ()
 		kCrashExit (CRASHCODE_DEKAFUSAGE);
 	}
 
-#if DEKAF2_IS_WINDOWS
-	auto errcode = fopen_s (&m_bpBufferedResults, GetTempResultsFile().c_str(), "r");
-	if (errcode)
+	if (!m_BufferedResults.Finish())
 	{
-		return SetError(strerror(errcode));
+		return SetError(kFormat ("BufferResults(): {}", m_BufferedResults.GetLastError()));
 	}
-#else
-	m_bpBufferedResults = fopen (GetTempResultsFile().c_str(), "re");
-#endif
-	if (!m_bpBufferedResults)
+
+	if (m_BufferedResults.HasSpilled())
 	{
-		return SetError(kFormat ("BufferResults(): bizarre: {} could not read from '{}', right after creating it.",
-								 kwhoami(), GetTempResultsFile()));
+		kDebug (2, "buffered {} rows, spilled into '{}'", m_iNumRowsBuffered, GetTempResultsFile());
 	}
 
-	m_bFileIsOpen = true;
-
     #ifdef DEKAF2_HAS_MYSQL
 	if (m_dMYSQLResult)
 	{
@@ -4501,8 +4483,8 @@ bool KSQL::BufferResults ()
 	}
 	#endif
 
-	// Note: results set is freed, fp is open, query is still open,
-	// and all results will now be drawn from the tmp file
+	// Note: results set is freed, query is still open,
+	// and all results will now be drawn from the buffer
 
 	return (true);
 
@@ -4520,7 +4502,7 @@ bool KSQL::NextRow ()
 	}
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-	// F_BufferResults: results were placed in a tmp file
+	// F_BufferResults: results were placed in a buffer
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 	if (DEKAF2_LIKELY(!IsFlag(F_BufferResults)))
 	{
@@ -4701,120 +4683,24 @@ bool KSQL::NextRow ()
 	else
 	{
 		// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-		// results were placed in a tmp file
+		// results were placed in a buffer
 		// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 		kDebug (4, "fetching buffered row...");
 
-		if (!m_bFileIsOpen)
-		{
-			return SetError("NextRow(): BUG: results are supposed to be buffered but m_bFileIsOpen says false.");
-		}
-		else if (!m_bpBufferedResults)
+		if (!m_BufferedResults.NextRow())
 		{
-			return SetError("NextRow(): BUG: results are supposed to be buffered but m_bpBufferedResults is nullptr!!");
-		}
-
-		FreeBufferedColArray (/*fValuesOnly=*/true); // <-- from last row
-
-		if (!m_dBufferedColArray)
-		{
-			m_dBufferedColArray = (char**) kmalloc (m_iNumColumns * sizeof(char*), "KSQL:NextRow()"); // <-- array of char* ptrs
-			for (KROW::Index ii=0; ii<m_iNumColumns; ++ii)
+			if (!m_BufferedResults.GetLastError().empty())
 			{
-				m_dBufferedColArray[ii] = nullptr;
+				return SetError(kFormat ("NextRow(): {}", m_BufferedResults.GetLastError()));
 			}
+
+			kDebug (4, "end of buffered results");
+			return (false);  // <-- no more rows
 		}
 
 		++m_iRowNum;
 
-		char szStatLine[25+1];
-		for (KROW::Index ii=0; ii<m_iNumColumns; ++ii)
-		{
-			// first line is a sanity check and the strlen() of data size:
-			bool bOK = (fgets (szStatLine, 25+1, m_bpBufferedResults) != nullptr);
-
-			if (!bOK && !ii)
-			{
-				kDebug (4, "end of buffered results: fgets() returned nullptr");
-				return (false);  // <-- no more rows
-			}
-
-			else if (!bOK)
-			{
-				return SetError("NextRow(): ran out of lines in buffered results file.");
-			}
-
-			if (szStatLine[strlen(szStatLine)-1] != '\n')
-			{
-				return SetError(kFormat ("NextRow(): buffered results corrupted stat line for row={}, col={}: '{}'",
-										 m_iRowNum, ii+1, szStatLine));
-			}
-
-			szStatLine[strlen(szStatLine)-1] = 0; // <-- trim the newline
-
-			// row|col|strlen
-			KStack<KStringView> Parts;
-			if (kSplit (Parts, szStatLine, '|') != 3)
-			{
-				return SetError(kFormat ("NextRow(): buffered results corrupted stat line for row={}, col={}: '{}'",
-										 m_iRowNum, ii+1, szStatLine));
-			}
-
-			uint64_t iCheckRowNum = Parts[0].UInt64();
-			uint64_t iCheckColNum = Parts[1].UInt64();
-			uint64_t iDataLen     = Parts[2].UInt64();
-
-			// sanity check the row and col (if we somehow got out of synch, all hell would break loose):
-			if ((iCheckRowNum != m_iRowNum) || (iCheckColNum != ii+1))
-			{
-				if (IsFlag(F_IgnoreSQLErrors))
-				{
-					kDebug (GetDebugLevel(), "CheckRowNum = {} [should be {}]", iCheckRowNum, m_iRowNum);
-					kDebug (GetDebugLevel(), "CheckColNum = {} [should be {}]", iCheckColNum, ii+1);
-				}
-				else
-				{
-					kWarning ("CheckRowNum = {} [should be {}]", iCheckRowNum, m_iRowNum);
-					kWarning ("CheckColNum = {} [should be {}]", iCheckColNum, ii+1);
-				}
-				return SetError(kFormat ("NextRow(): buffered results stat line out of sync for row={}, col={}",
-										 m_iRowNum, ii+1));
-			}
-
-			if (iDataLen > 50)
-			{
-				kDebug (4, "  from-buffer: row[{}]col[{}]: strlen()={}", m_iRowNum, ii+1, iDataLen);
-			}
-			else
-			{
-				kDebug (4, "  from-buffer: row[{}]col[{}]: '{}'", m_iRowNum, ii+1, szStatLine);
-			}
-
-			// now we know how big the data value is, so we can malloc for it:
-			// fyi: tack on a few bytes for newline and NIL...
-			m_dBufferedColArray[ii] = (char*) kmalloc (iDataLen+3, "KSQL:NextRow");
-
-			// second line is the data value (could be one HUGE line of gobbly gook):
-			bOK = (fgets (m_dBufferedColArray[ii], static_cast<int>(iDataLen+2), m_bpBufferedResults) != nullptr);
-
-			// sanity check: there should be a newline at exactly value[iDataLen]:
-			if (!bOK || ((m_dBufferedColArray[ii])[iDataLen] != '\n'))
-			{
-				return SetError(kFormat ("NextRow(): buffered results corrupted data line for row={}, col={}",
-										 m_iRowNum, ii+1));
-			}
-
-			(m_dBufferedColArray[ii])[iDataLen] = 0;  // <-- trim the newline
-
-			// now change the newlines that were in the actual data back to normal:
-			char* spot = strchr (m_dBufferedColArray[ii], 2); // ^B -> ^J
-			while (spot)
-			{
-				*spot = '\n'; // <-- change them back
-				spot = strchr (spot+1, 2);
-			}
-		}
-		return (true); // <-- we got a row out of buffer file
+		return (true); // <-- we got a row out of the buffer
 	}
 
 	// we never get here..
@@ -4931,44 +4817,6 @@ bool KSQL::LoadColumnLayout(KROW& Row, KStringView sColumns)
 
 } // LoadColumnLayout
 
-//-----------------------------------------------------------------------------
-void KSQL::FreeBufferedColArray (bool fValuesOnly/*=false*/)
-//-----------------------------------------------------------------------------
-{
-	//kDebug (3, "{}...", m_dBufferedColArray);
-
-	// FYI: the m_dBufferedColArray is only used with the F_BufferResults flag
-	// FYI: there is nothing database specific in this member function
-
-	if (!m_dBufferedColArray)
-	{
-		return;
-	}
-
-	//kDebugMemory (3, (const char*)m_dBufferedColArray, 0);
-
-	for (KROW::Index ii=0; ii<m_iNumColumns; ++ii)
-	{
-		if (m_dBufferedColArray[ii])
-		{
-			//kDebug (3, "  free(m_dBufferedColArray[ii]= {}[{}] = {})", m_dBufferedColArray, ii, m_dBufferedColArray+ii);
-			kfree (m_dBufferedColArray[ii], "KSQL:FreeBufferedColArray[ii]");  // <-- frees the result of strdup() in NextRow()
-			m_dBufferedColArray[ii] = nullptr;
-		}
-	}
-
-	if (fValuesOnly)
-	{
-		return;
-	}
-
-	//kDebug (3, "  free(m_dBufferedColArray = {})", m_dBufferedColArray);
-	kfree (m_dBufferedColArray, "KSQL:m_dBufferedColArray");  // <-- frees the result of malloc() in NextRow()
-
-	m_dBufferedColArray = nullptr;
-
-} // FreeBufferedColArray
-
 //-----------------------------------------------------------------------------
 KROW KSQL::SingleRawQuery (KSQLString sSQL, Flags iFlags/*=0*/, KStringView sAPI/*="SingleRawQuery"*/)
 //-----------------------------------------------------------------------------
@@ -5059,32 +4907,11 @@ bool KSQL::ResetBuffer ()
 		return SetError ("ResetBuffer(): F_BufferResults flag needs to be set *before* query is run.");
 	}
 
-	if (m_bFileIsOpen)
+	if (!m_BufferedResults.Rewind())
 	{
-		if (m_bpBufferedResults)
-		{
-			fclose (m_bpBufferedResults);
-		}
-		m_bpBufferedResults = nullptr;
-		m_bFileIsOpen = false;
-	}
-
-#ifdef DEKAF2_IS_WINDOWS
-	auto errcode = fopen_s (&m_bpBufferedResults, GetTempResultsFile().c_str(), "r");
-	if (errcode)
-	{
-		return SetError(strerror(errcode));
-	}
-#else
-	m_bpBufferedResults = fopen (GetTempResultsFile().c_str(), "re");
-#endif
-	if (!m_bpBufferedResults)
-	{
-		return SetError(kFormat ("ResetBuffer(): bizarre: {} could not read from '{}'.",
-								 kwhoami(), GetTempResultsFile()));
+		return SetError(kFormat ("ResetBuffer(): {}", m_BufferedResults.GetLastError()));
 	}
 
-	m_bFileIsOpen = true;
 	m_iRowNum     = 0;     // <-- this needs to start over (like we are re-running the query)
 
 	return (true);
@@ -5153,19 +4980,7 @@ void KSQL::EndQuery (bool bDestructor/*=false*/)
 	// - - - - - - - - - - - - - - - - - - - - - - - -
 	// my own results buffering cleanup
 	// - - - - - - - - - - - - - - - - - - - - - - - -
-	if (m_bFileIsOpen)
-	{
-		if (!bDestructor)
-		{
-			kDebug (3, "  fclose (m_bpBufferedResults)...");
-		}
-		if (m_bpBufferedResults)
-		{
-			fclose (m_bpBufferedResults);
-			m_bpBufferedResults = nullptr;
-		}
-		m_bFileIsOpen = false;
-	}
+	m_BufferedResults.clear();
 
 	RemoveTempResultsFile();
 
@@ -5176,8 +4991,6 @@ void KSQL::EndQuery (bool bDestructor/*=false*/)
 	m_iOCI8FirstRowStat = 0;
 #endif
 
-	FreeBufferedColArray ();
-
 	m_bQueryStarted = false;
 
 } // KSQL::EndQuery
@@ -5244,7 +5057,7 @@ KStringView KSQL::Get (KROW::Index iOneBasedColNum, bool fTrimRight/*=true*/)
 
 	if (IsFlag (F_BufferResults))
 	{
-		sRtnValue = m_dBufferedColArray[iOneBasedColNum-1];
+		sRtnValue = m_BufferedResults.Get(iOneBasedColNum-1);
 	}
 	else
 	{
@@ -8384,10 +8197,44 @@ KString KSQL::QueryOpenRows (OutputFormat iFormat/*=ASCII*/, std::size_t* piNumR
 	kDebug (2, "...");
 
 	KString sResult;
+	KOutStringStream Out(sResult);
+
+	auto iNumRows = OutputOpenRows (Out, iFormat);
 
-	KFormTable Table(sResult);
+	if (piNumRows)
+	{
+		*piNumRows = iNumRows;
+	}
+
+	return sResult;
+
+} // QueryOpenRows
+
+//-----------------------------------------------------------------------------
+std::size_t KSQL::OutputQuery (const KSQLString& sSQL, KOutStream& Out, OutputFormat iFormat/*=ASCII*/)
+//-----------------------------------------------------------------------------
+{
+	kDebug (2, "...");
+
+	if (!ExecRawQuery (sSQL, GetFlags(), "OutputQuery"))
+	{
+		return 0;
+	}
+
+	return OutputOpenRows (Out, iFormat);
+
+} // OutputQuery
+
+//-----------------------------------------------------------------------------
+std::size_t KSQL::OutputOpenRows (KOutStream& Out, OutputFormat iFormat/*=ASCII*/)
+//-----------------------------------------------------------------------------
+{
+	kDebug (2, "...");
+
+	KFormTable Table(Out);
 	Table.SetStyle(iFormat);
 	Table.SetMaxColWidth(800);
+	// one KROW for all rows - NextRow() only updates its values
 	KROW Row;
 
 	if (Table.WantDryMode())
@@ -8403,7 +8250,7 @@ KString KSQL::QueryOpenRows (OutputFormat iFormat/*=ASCII*/, std::size_t* piNumR
 
 		EndQuery ();
 		// the query already ran once, so do not re-check for the select keyword
-		ExecLastRawQuery (Flags(GetFlags() | F_IgnoreSelectKeyword), "QueryOpenRows");
+		ExecLastRawQuery (Flags(GetFlags() | F_IgnoreSelectKeyword), "OutputOpenRows");
 	}
 
 	// for a weird reason gcc 11.5 crashes here with ctlib when iterating
@@ -8414,16 +8261,19 @@ KString KSQL::QueryOpenRows (OutputFormat iFormat/*=ASCII*/, std::size_t* piNumR
 		Table.PrintRow(Row);
 	}
 
-	if (piNumRows)
-	{
-		*piNumRows = Table.GetPrintedRows();
-	}
+	auto iNumRows = Table.GetPrintedRows();
 
 	Table.Close();
 
-	return sResult;
+	if (!iNumRows && iFormat == OutputFormat::JSON)
+	{
+		// an empty result is still a valid JSON array
+		Out.Write("[]");
+	}
 
-} // QueryOpenRows
+	return iNumRows;
+
+} // OutputOpenRows
 
 //-----------------------------------------------------------------------------
 bool KSQL::BeginTransaction (KStringView sOptions/*=""*/)
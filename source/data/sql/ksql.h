@@ -49,6 +49,7 @@
 #include <dekaf2/core/strings/kstring.h>
 #include <dekaf2/core/strings/kstringview.h>
 #include <dekaf2/data/sql/krow.h>
+#include <dekaf2/data/sql/bits/ksql_resultbuffer.h>
 #include <dekaf2/data/json/kjson.h>
 #include <dekaf2/containers/associative/kcache.h>
 #include <dekaf2/core/errors/kexception.h>
@@ -633,6 +634,11 @@ public:
 	bool           LoadColumnLayout(KROW& Row, KStringView sColumns = KStringView{});
 	uint64_t       GetNumBuffered ()         { return (m_iNumRowsBuffered); }
 	bool           ResetBuffer    ();
+	/// set the count of bytes of buffered results (F_BufferResults) that are held in memory
+	/// before further rows are spilled into a temp file, 0 for no limit - default is 64 MB
+	void           SetBufferedResultsMemoryLimit (std::size_t iMaxMemory) { m_iMaxBufferedMemory = iMaxMemory; }
+	/// returns the count of bytes of buffered results that are held in memory before spilling into a temp file
+	std::size_t    GetBufferedResultsMemoryLimit () const { return m_iMaxBufferedMemory; }
 
     #ifdef DEKAF2_HAS_ORACLE
 	// Oracle/OCI variable binding support:
@@ -747,8 +753,8 @@ public:
 	const KString& ConnectSummary () const;
 	const KString& GetTempDir()    const { return (m_sTempDir);        }
 
-	/// this tmp file is used to hold buffered results (if flag F_BufferResults is set). Always only
-	/// access its name through these functions!
+	/// this tmp file is used to hold buffered results (if flag F_BufferResults is set) once they exceed
+	/// the memory limit. Always only access its name through these functions!
 	const KString& GetTempResultsFile();
 	void ClearTempResultsFile() { m_sNeverReadMeDirectlyTmpResultsFile.clear(); }
 	void RemoveTempResultsFile();
@@ -860,6 +866,14 @@ public:
 	KString     QueryAllRows (const KSQLString& sSQL, OutputFormat iFormat=OutputFormat::ASCII, std::size_t* piNumRows=NULL);
 	/// format all rows of the currently open query and return them as a string
 	KString     QueryOpenRows (OutputFormat iFormat=OutputFormat::ASCII, std::size_t* piNumRows=NULL);
+	/// run a query and stream all rows in the given format into Out, row by row. The memory use does
+	/// not depend on the count of rows - but the box formats (ASCII etc.) run the query twice, first
+	/// to measure the column widths
+	/// @return the count of output rows
+	std::size_t OutputQuery  (const KSQLString& sSQL, KOutStream& Out, OutputFormat iFormat=OutputFormat::ASCII);
+	/// stream all rows of the currently open query in the given format into Out, row by row
+	/// @return the count of output rows
+	std::size_t OutputOpenRows (KOutStream& Out, OutputFormat iFormat=OutputFormat::ASCII);
 
 	void   DisableRetries() { m_bDisableRetries = true;  }
 	void   EnableRetries()  { m_bDisableRetries = false; }
@@ -1727,9 +1741,8 @@ private:
 	std::unique_ptr<KPostgreSQLState> m_PostgreSQL;
 #endif
 
-	FILE*      m_bpBufferedResults { nullptr };
+	KSQLResultBuffer m_BufferedResults;
 	bool       m_bConnectionIsOpen { false };
-	bool       m_bFileIsOpen { false };
 	bool       m_bQueryStarted { false };
 	bool       m_bMayThrow { false };
 	KString    m_sDBC;
@@ -1741,7 +1754,7 @@ private:
 	uint64_t   m_iLastInsertID { 0 };
 	mutable uint64_t m_iConnectHash { 0 };
 	ConnectionID m_iConnectionID { 0 };
-	char**     m_dBufferedColArray { nullptr };
+	std::size_t m_iMaxBufferedMemory { KSQLResultBuffer::DefaultMaxMemory };
 	KString    m_sErrorPrefix;
 	bool       m_bDisableRetries { false };
 	bool       m_bReuseRows { true };
@@ -1759,7 +1772,6 @@ private:
 
 	bool  BufferResults ();
 	void  FreeAll (bool bDestructor=false);
-	void  FreeBufferedColArray (bool fValuesOnly=false);
 	void  InvalidateConnectHash () const { m_iConnectHash = 0; }
 	void  FormatConnectSummary () const;
 	/// modifies sError if connection was lost due to a connection kill request, else retains old message
@@ -0,0 +1,610 @@
+/*
+//
+// DEKAF(tm): Lighter, Faster, Smarter(tm)
+//
+// Copyright (c) 2026, Ridgeware, Inc.
+//
+// +-------------------------------------------------------------------------+
+// | /\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\|
+// |/+---------------------------------------------------------------------+/|
+// |/|                                                                     |/|
+// |\|  ** THIS NOTICE MUST NOT BE REMOVED FROM THE SOURCE CODE MODULE **  |\|
+// |/|                                                                     |/|
+// |\|   OPEN SOURCE LICENSE                                               |\|
+// |/|                                                                     |/|
+// |\|   Permission is hereby granted, free of charge, to any person       |\|
+// |/|   obtaining a copy of this software and associated                  |/|
+// |\|   documentation files (the "Software"), to deal in the              |\|
+// |/|   Software without restriction, including without limitation        |/|
+// |\|   the rights to use, copy, modify, merge, publish,                  |\|
+// |/|   distribute, sublicense, and/or sell copies of the Software,       |/|
+// |\|   and to permit persons to whom the Software is furnished to        |\|
+// |/|   do so, subject to the following conditions:                       |/|
+// |\|                                                                     |\|
+// |/|   The above copyright notice and this permission notice shall       |/|
+// |\|   be included in all copies or substantial portions of the          |\|
+// |/|   Software.                                                         |/|
+// |\|                                                                     |\|
+// |/|   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY         |/|
+// |\|   KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE        |\|
+// |/|   WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR           |/|
+// |\|   PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS        |\|
+// |/|   OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR          |/|
+// |\|   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR        |\|
+// |/|   OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE         |/|
+// |\|   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.            |\|
+// |/|                                                                     |/|
+// |/+---------------------------------------------------------------------+/|
+// |\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/ |
+// +-------------------------------------------------------------------------+
+//
+*/
+
+#include <dekaf2/data/sql/ksqlpool.h>
+#include <dekaf2/threading/execution/kthreads.h>
+#include <dekaf2/core/logging/klog.h>
+#include <dekaf2/core/format/kformat.h>
+#include <algorithm>
+
+DEKAF2_NAMESPACE_BEGIN
+
+//-----------------------------------------------------------------------------
+KSQLPool::Connection& KSQLPool::Connection::operator=(Connection&& other) noexcept
+//-----------------------------------------------------------------------------
+{
+	if (this != &other)
+	{
+		Release();
+		m_Pool       = other.m_Pool;
+		m_DB         = std::move(other.m_DB);
+		other.m_Pool = nullptr;
+	}
+
+	return *this;
+
+} // Connection::operator=
+
+//-----------------------------------------------------------------------------
+void KSQLPool::Connection::Release()
+//-----------------------------------------------------------------------------
+{
+	if (m_Pool && m_DB)
+	{
+		m_Pool->Return(std::move(m_DB), false);
+	}
+
+	m_Pool = nullptr;
+	m_DB.reset();
+
+} // Connection::Release
+
+//-----------------------------------------------------------------------------
+void KSQLPool::Connection::Discard()
+//-----------------------------------------------------------------------------
+{
+	if (m_Pool && m_DB)
+	{
+		m_Pool->Return(std::move(m_DB), true);
+	}
+
+	m_Pool = nullptr;
+	m_DB.reset();
+
+} // Connection::Discard
+
+//-----------------------------------------------------------------------------
+KSQLPool::KSQLPool(KStringViewZ sDBC, Options Options)
+//-----------------------------------------------------------------------------
+: m_sDBC(sDBC)
+, m_Options(std::move(Options))
+{
+	if (!m_Prototype.LoadConnect(m_sDBC))
+	{
+		SetError(m_Prototype.GetLastError());
+	}
+
+	StartMaintenance();
+
+} // ctor
+
+//-----------------------------------------------------------------------------
+KSQLPool::KSQLPool(KSQL& Prototype, Options Options)
+//-----------------------------------------------------------------------------
+: m_sDBC(Prototype.GetDBC())
+, m_Options(std::move(Options))
+{
+	m_Prototype.SetConnect(Prototype);
+	StartMaintenance();
+
+} // ctor
+
+//-----------------------------------------------------------------------------
+KSQLPool::~KSQLPool()
+//-----------------------------------------------------------------------------
+{
+	if (m_Maintenance)
+	{
+		{
+			std::lock_guard<std::mutex> Lock(m_Mutex);
+			m_bStop = true;
+		}
+
+		m_Wakeup.notify_all();
+		m_Maintenance->join();
+	}
+
+	if (m_Stats.iBorrowed)
+	{
+		kWarning("{} connections still borrowed from pool for {}", m_Stats.iBorrowed, m_Prototype.ConnectSummary());
+	}
+
+} // dtor
+
+//-----------------------------------------------------------------------------
+void KSQLPool::StartMaintenance()
+//-----------------------------------------------------------------------------
+{
+	m_Options.iMaxConnections = std::max(m_Options.iMaxConnections, std::size_t(1));
+	m_Options.iMinIdle        = std::min(m_Options.iMinIdle, m_Options.iMaxConnections);
+	m_Stats.iMaxConnections   = m_Options.iMaxConnections;
+
+	if (m_Options.Maintenance > KDuration::zero())
+	{
+		m_Maintenance = std::make_unique<std::thread>(kMakeThread(&KSQLPool::Maintenance, this));
+	}
+
+} // StartMaintenance
+
+//-----------------------------------------------------------------------------
+void KSQLPool::SetError(KString sError)
+//-----------------------------------------------------------------------------
+{
+	kDebug(1, sError);
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	m_sLastError = std::move(sError);
+
+} // SetError
+
+//-----------------------------------------------------------------------------
+KString KSQLPool::GetLastError() const
+//-----------------------------------------------------------------------------
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	return m_sLastError;
+
+} // GetLastError
+
+//-----------------------------------------------------------------------------
+bool KSQLPool::Reconnect(KSQL& DB)
+//-----------------------------------------------------------------------------
+{
+	DB.CloseConnection();
+
+	if (!DB.OpenConnection(m_Options.ConnectionTimeout))
+	{
+		SetError(DB.GetLastError());
+		return false;
+	}
+
+	if (m_Options.OnConnect && !m_Options.OnConnect(DB))
+	{
+		SetError(kFormat("OnConnect callback failed for {}", DB.ConnectSummary()));
+		DB.CloseConnection();
+		return false;
+	}
+
+	return true;
+
+} // Reconnect
+
+//-----------------------------------------------------------------------------
+std::unique_ptr<KSQL> KSQLPool::Connect()
+//-----------------------------------------------------------------------------
+{
+	auto DB = std::make_unique<KSQL>();
+
+	// the prototype is never changed after construction, concurrent reads are safe
+	DB->SetConnect(m_Prototype);
+
+	bool bOK = Reconnect(*DB);
+
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+
+	if (!bOK)
+	{
+		++m_Stats.iConnectErrors;
+		return nullptr;
+	}
+
+	++m_Stats.iConnects;
+
+	return DB;
+
+} // Connect
+
+//-----------------------------------------------------------------------------
+bool KSQLPool::Validate(KSQL& DB)
+//-----------------------------------------------------------------------------
+{
+	if (!DB.IsConnectionOpen())
+	{
+		return false;
+	}
+
+	bool bOK = DB.ExecRawQuery(m_Options.sValidationQuery, KSQL::F_IgnoreSQLErrors, "Validate");
+	DB.EndQuery();
+
+	return bOK;
+
+} // Validate
+
+//-----------------------------------------------------------------------------
+KSQLPool::Connection KSQLPool::Get()
+//-----------------------------------------------------------------------------
+{
+	KStopTime Waited;
+	auto tTimeout = KSteadyTime::now() + m_Options.MaxWait;
+	bool bWaited  = false;
+	KDuration RetryDelay = chrono::milliseconds(10);
+
+	std::unique_lock<std::mutex> Lock(m_Mutex);
+
+	// a failed connect is retried with growing delays until MaxWait is exhausted -
+	// returns false if no time is left
+	auto WaitForRetry = [&]() -> bool
+	{
+		auto tNow = KSteadyTime::now();
+
+		if (tNow >= tTimeout)
+		{
+			return false;
+		}
+
+		bWaited = true;
+		// a returned connection wakes us up early
+		m_Available.wait_until(Lock, std::min(tNow + RetryDelay, tTimeout));
+		RetryDelay = std::min<KDuration>(RetryDelay * 2, chrono::seconds(1));
+
+		return true;
+	};
+
+	for (;;)
+	{
+		std::unique_ptr<KSQL> DB;
+		bool bValidate  = false;
+		bool bReconnect = false;
+
+		if (!m_Idle.empty())
+		{
+			// LIFO - the most recently used connection is the least likely to have timed out
+			auto& Last = m_Idle.back();
+			bValidate  = (KSteadyTime::now() - Last.tSince) >= m_Options.ValidateAfterIdle;
+			DB         = std::move(Last.DB);
+			m_Idle.pop_back();
+			++m_Stats.iBorrowed;
+		}
+		else if (m_Stats.iBorrowed + m_Lost.size() + m_iReserved < m_Options.iMaxConnections)
+		{
+			++m_iReserved;
+			Lock.unlock();
+			DB = Connect();
+			Lock.lock();
+			--m_iReserved;
+
+			if (!DB)
+			{
+				// let other waiters retry
+				m_Available.notify_one();
+
+				if (!WaitForRetry())
+				{
+					return {};
+				}
+
+				continue;
+			}
+
+			++m_Stats.iBorrowed;
+		}
+		else if (!m_Lost.empty())
+		{
+			// all connections are taken or lost, do not wait for the background thread
+			DB         = std::move(m_Lost.back());
+			m_Lost.pop_back();
+			bReconnect = true;
+			++m_Stats.iBorrowed;
+		}
+		else
+		{
+			bWaited = true;
+
+			if (m_Available.wait_until(Lock, tTimeout) == std::cv_status::timeout
+				&& m_Idle.empty()
+				&& m_Stats.iBorrowed + m_Lost.size() + m_iReserved >= m_Options.iMaxConnections)
+			{
+				++m_Stats.iTimeouts;
+				m_sLastError = kFormat("timeout after {} waiting for a free connection, {} connections in use", Waited.elapsed(), m_Stats.iBorrowed);
+				kDebug(1, m_sLastError);
+				return {};
+			}
+
+			continue;
+		}
+
+		if (bValidate || bReconnect)
+		{
+			if (bValidate) ++m_Stats.iValidations;
+			Lock.unlock();
+
+			bool bValid = bValidate && Validate(*DB);
+			bool bOK    = bValid || Reconnect(*DB);
+
+			Lock.lock();
+
+			if (!bValid)
+			{
+				if (bValidate) ++m_Stats.iInvalid;
+				if (bOK)       ++m_Stats.iConnects;
+				else           ++m_Stats.iConnectErrors;
+			}
+
+			if (!bOK)
+			{
+				--m_Stats.iBorrowed;
+
+				if (bReconnect)
+				{
+					// the database seems to be down, wait a little before the next attempt
+					m_Lost.push_back(std::move(DB));
+
+					if (!WaitForRetry())
+					{
+						return {};
+					}
+
+					continue;
+				}
+
+				if (m_Maintenance)
+				{
+					// have the background thread reconnect it
+					m_Lost.push_back(std::move(DB));
+					m_Wakeup.notify_one();
+				}
+				else
+				{
+					Lock.unlock();
+					DB.reset();
+					Lock.lock();
+				}
+
+				continue;
+			}
+		}
+
+		auto tWaited = Waited.elapsed();
+
+		++m_Stats.iGets;
+		if (bWaited) ++m_Stats.iWaits;
+		m_Stats.TotalWait += tWaited;
+		m_Stats.LongestWait = std::max(m_Stats.LongestWait, tWaited);
+		m_Stats.iPeakBorrowed = std::max(m_Stats.iPeakBorrowed, m_Stats.iBorrowed);
+
+		return Connection(this, std::move(DB));
+	}
+
+} // Get
+
+//-----------------------------------------------------------------------------
+void KSQLPool::Return(std::unique_ptr<KSQL> DB, bool bDiscard)
+//-----------------------------------------------------------------------------
+{
+	if (!bDiscard)
+	{
+		// free any open result set before somebody else gets the connection
+		DB->EndQuery();
+	}
+
+	bool bIsOpen = DB->IsConnectionOpen();
+
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+
+		--m_Stats.iBorrowed;
+
+		if (!bDiscard && bIsOpen)
+		{
+			m_Idle.push_back({ std::move(DB), KSteadyTime::now() });
+		}
+		else if (!bDiscard && m_Maintenance)
+		{
+			m_Lost.push_back(std::move(DB));
+			m_Wakeup.notify_one();
+		}
+	}
+
+	m_Available.notify_one();
+
+	// a discarded connection gets closed outside of the lock
+	DB.reset();
+
+} // Return
+
+//-----------------------------------------------------------------------------
+void KSQLPool::Maintenance()
+//-----------------------------------------------------------------------------
+{
+	kDebug(2, "starting maintenance for {}", m_Prototype.ConnectSummary());
+
+	std::unique_lock<std::mutex> Lock(m_Mutex);
+
+	while (!m_bStop)
+	{
+		m_Wakeup.wait_for(Lock, m_Options.Maintenance);
+
+		if (m_bStop)
+		{
+			break;
+		}
+
+		// close connections idle for too long - the oldest are at the front
+		std::vector<Idle> Expired;
+		auto tExpire = KSteadyTime::now() - m_Options.MaxIdleTime;
+
+		while (m_Idle.size() > m_Options.iMinIdle && m_Idle.front().tSince < tExpire)
+		{
+			Expired.push_back(std::move(m_Idle.front()));
+			m_Idle.pop_front();
+		}
+
+		m_Stats.iExpired += Expired.size();
+
+		// reconnect lost connections
+		auto Lost = std::move(m_Lost);
+		m_Lost.clear();
+		m_iReserved += Lost.size();
+
+		// top up to the minimum count of idle connections
+		std::size_t iTopUp = 0;
+
+		if (m_Idle.size() + Lost.size() < m_Options.iMinIdle)
+		{
+			iTopUp = std::min(m_Options.iMinIdle - m_Idle.size() - Lost.size(),
+			                  m_Options.iMaxConnections - std::min(m_Options.iMaxConnections, m_Stats.iBorrowed + m_iReserved));
+			m_iReserved += iTopUp;
+		}
+
+		if (Expired.empty() && Lost.empty() && !iTopUp)
+		{
+			continue;
+		}
+
+		Lock.unlock();
+
+		Expired.clear();
+
+		std::vector<std::unique_ptr<KSQL>> Reconnected;
+		std::vector<std::unique_ptr<KSQL>> Failed;
+
+		for (auto& DB : Lost)
+		{
+			if (Reconnect(*DB))
+			{
+				Reconnected.push_back(std::move(DB));
+			}
+			else
+			{
+				Failed.push_back(std::move(DB));
+			}
+		}
+
+		for (std::size_t i = 0; i < iTopUp; ++i)
+		{
+			auto DB = Connect();
+			if (!DB) break;
+			Reconnected.push_back(std::move(DB));
+		}
+
+		Lock.lock();
+
+		m_iReserved            -= Lost.size() + iTopUp;
+		m_Stats.iConnects      += Lost.size() - Failed.size();
+		m_Stats.iConnectErrors += Failed.size();
+
+		auto tNow = KSteadyTime::now();
+
+		for (auto& DB : Reconnected)
+		{
+			// at the front, they were not used recently
+			m_Idle.push_front(Idle { std::move(DB), tNow });
+		}
+
+		for (auto& DB : Failed)
+		{
+			m_Lost.push_back(std::move(DB));
+		}
+
+		m_Available.notify_all();
+	}
+
+	kDebug(2, "stopping maintenance for {}", m_Prototype.ConnectSummary());
+
+} // Maintenance
+
+//-----------------------------------------------------------------------------
+KSQLPool::Stats KSQLPool::GetStats() const
+//-----------------------------------------------------------------------------
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+
+	auto Stats          = m_Stats;
+	Stats.iIdle         = m_Idle.size();
+	Stats.iReconnecting = m_Lost.size();
+
+	return Stats;
+
+} // GetStats
+
+//-----------------------------------------------------------------------------
+void KSQLPool::clear()
+//-----------------------------------------------------------------------------
+{
+	std::deque<Idle> Closing;
+
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		Closing.swap(m_Idle);
+	}
+
+	// the connections get closed outside of the lock
+
+} // clear
+
+//-----------------------------------------------------------------------------
+KSQLPool& KSQLPools::GetPool(KStringViewZ sDBC)
+//-----------------------------------------------------------------------------
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+
+	auto it = m_Pools.find(sDBC);
+
+	if (it == m_Pools.end())
+	{
+		it = m_Pools.emplace(KString(sDBC), std::make_unique<KSQLPool>(sDBC, m_Options)).first;
+	}
+
+	return *it->second;
+
+} // GetPool
+
+//-----------------------------------------------------------------------------
+KMap<KString, KSQLPool::Stats> KSQLPools::GetStats() const
+//-----------------------------------------------------------------------------
+{
+	KMap<KString, KSQLPool::Stats> Stats;
+
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+
+	for (const auto& Pool : m_Pools)
+	{
+		Stats.emplace(Pool.first, Pool.second->GetStats());
+	}
+
+	return Stats;
+
+} // GetStats
+
+//-----------------------------------------------------------------------------
+void KSQLPools::clear()
+//-----------------------------------------------------------------------------
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+
+	for (auto& Pool : m_Pools)
+	{
+		Pool.second->clear();
+	}
+
+} // clear
+
+DEKAF2_NAMESPACE_END
@@ -0,0 +1,294 @@
+/*
+//
+// DEKAF(tm): Lighter, Faster, Smarter(tm)
+//
+// Copyright (c) 2026, Ridgeware, Inc.
+//
+// +-------------------------------------------------------------------------+
+// | /\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\|
+// |/+---------------------------------------------------------------------+/|
+// |/|                                                                     |/|
+// |\|  ** THIS NOTICE MUST NOT BE REMOVED FROM THE SOURCE CODE MODULE **  |\|
+// |/|                                                                     |/|
+// |\|   OPEN SOURCE LICENSE                                               |\|
+// |/|                                                                     |/|
+// |\|   Permission is hereby granted, free of charge, to any person       |\|
+// |/|   obtaining a copy of this software and associated                  |/|
+// |\|   documentation files (the "Software"), to deal in the              |\|
+// |/|   Software without restriction, including without limitation        |/|
+// |\|   the rights to use, copy, modify, merge, publish,                  |\|
+// |/|   distribute, sublicense, and/or sell copies of the Software,       |/|
+// |\|   and to permit persons to whom the Software is furnished to        |\|
+// |/|   do so, subject to the following conditions:                       |/|
+// |\|                                                                     |\|
+// |/|   The above copyright notice and this permission notice shall       |/|
+// |\|   be included in all copies or substantial portions of the          |\|
+// |/|   Software.                                                         |/|
+// |\|                                                                     |\|
+// |/|   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY         |/|
+// |\|   KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE        |\|
+// |/|   WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR           |/|
+// |\|   PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS        |\|
+// |/|   OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR          |/|
+// |\|   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR        |\|
+// |/|   OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE         |/|
+// |\|   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.            |\|
+// |/|                                                                     |/|
+// |/+---------------------------------------------------------------------+/|
+// |\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/ |
+// +-------------------------------------------------------------------------+
+//
+*/
+
+#pragma once
+
+/// @file ksqlpool.h
+/// thread safe pools of KSQL connections
+
+#include <dekaf2/core/init/kdefinitions.h>
+#include <dekaf2/core/strings/kstring.h>
+#include <dekaf2/core/strings/kstringview.h>
+#include <dekaf2/data/sql/ksql.h>
+#include <dekaf2/time/duration/kduration.h>
+#include <dekaf2/containers/associative/kassociative.h>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <functional>
+#include <vector>
+#include <deque>
+
+DEKAF2_NAMESPACE_BEGIN
+
+/// @addtogroup data_sql
+/// @{
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+/// A thread safe pool of connections to one database. Connections are borrowed
+/// with Get(), and return into the pool when the returned handle goes out of scope.
+/// Connections that were idle for some time are validated lazily when borrowed,
+/// connections that were lost are reconnected by a background thread, and
+/// connections idle for too long are closed. The KSQL instances, and with them
+/// the statement cache of their backend, survive across borrows.
+/// ```
+/// KSQLPool Pool("/etc/myapp/db.dbc");
+///
+/// auto db = Pool.Get();
+///
+/// if (db && db->ExecQuery("select id, name from user where age > {}", 21))
+/// {
+///     for (auto& row : *db) { ... }
+/// }
+/// ```
+class DEKAF2_PUBLIC KSQLPool
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+{
+
+//----------
+public:
+//----------
+
+	//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+	/// pool configuration
+	struct Options
+	//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+	{
+		/// max count of connections, borrowed and idle
+		std::size_t   iMaxConnections   { 20 };
+		/// count of idle connections kept open by the background thread, even when idle for longer than MaxIdleTime
+		std::size_t   iMinIdle          { 0 };
+		/// max time to wait for a free connection in Get()
+		KDuration     MaxWait           { chrono::seconds(10) };
+		/// idle connections are closed after this time
+		KDuration     MaxIdleTime       { chrono::minutes(5) };
+		/// connections idle for this time are validated before being handed out, 0 = always validate
+		KDuration     ValidateAfterIdle { chrono::seconds(30) };
+		/// interval of the background thread for reconnects and idle checks, 0 = no background thread
+		KDuration     Maintenance       { chrono::seconds(5) };
+		/// timeout for new connections
+		KDuration     ConnectionTimeout { KSQL::DefaultConnectionTimeout };
+		/// the query used to validate a connection - has to be a string literal
+		const char*   sValidationQuery  { "select 1" };
+		/// called after each (re)connect, e.g. to set flags or session variables - return false to fail the connection
+		std::function<bool(KSQL&)> OnConnect;
+	};
+
+	//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+	/// pool diagnostics
+	struct Stats
+	//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+	{
+		std::size_t   iBorrowed         { 0 }; ///< currently borrowed connections
+		std::size_t   iIdle             { 0 }; ///< currently idle connections
+		std::size_t   iReconnecting     { 0 }; ///< lost connections waiting for the background reconnect
+		std::size_t   iMaxConnections   { 0 }; ///< configured maximum
+		std::size_t   iPeakBorrowed     { 0 }; ///< highest count of concurrently borrowed connections
+		uint64_t      iGets             { 0 }; ///< count of successful Get() calls
+		uint64_t      iWaits            { 0 }; ///< count of Get() calls that had to wait for a connection
+		uint64_t      iTimeouts         { 0 }; ///< count of Get() calls that timed out
+		uint64_t      iConnects         { 0 }; ///< count of opened connections
+		uint64_t      iConnectErrors    { 0 }; ///< count of failed connection attempts
+		uint64_t      iValidations      { 0 }; ///< count of validations of idle connections
+		uint64_t      iInvalid          { 0 }; ///< count of validations that failed
+		uint64_t      iExpired          { 0 }; ///< count of connections closed after being idle too long
+		KDuration     TotalWait;               ///< accumulated wait time in Get()
+		KDuration     LongestWait;             ///< longest wait time in Get()
+
+		/// returns the average wait time of Get()
+		KDuration     AverageWait() const { return iGets ? KDuration(TotalWait / iGets) : KDuration(); }
+		/// returns the occupancy in percent of the max connections
+		double        Occupancy  () const { return iMaxConnections ? 100.0 * iBorrowed / iMaxConnections : 0.0; }
+	};
+
+	//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+	/// a borrowed connection, returns into the pool at destruction
+	class DEKAF2_PUBLIC Connection
+	//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+	{
+
+	//----------
+	public:
+	//----------
+
+		Connection() = default;
+		Connection(Connection&& other) noexcept
+		: m_Pool(other.m_Pool), m_DB(std::move(other.m_DB))
+		{
+			other.m_Pool = nullptr;
+		}
+		Connection& operator=(Connection&& other) noexcept;
+		Connection(const Connection&) = delete;
+		Connection& operator=(const Connection&) = delete;
+		~Connection() { Release(); }
+
+		/// returns true if this is a valid connection
+		explicit operator bool() const { return m_DB != nullptr;  }
+		KSQL*    get()           const { return m_DB.get();       }
+		KSQL*    operator->()    const { return m_DB.get();       }
+		KSQL&    operator*()     const { return *m_DB;            }
+
+		/// return the connection into the pool before the end of scope
+		void     Release();
+		/// close the connection instead of returning it into the pool, e.g.
+		/// after changing flags or session settings that should not leak to other users
+		void     Discard();
+
+	//----------
+	private:
+	//----------
+
+		friend class KSQLPool;
+
+		Connection(KSQLPool* Pool, std::unique_ptr<KSQL> DB)
+		: m_Pool(Pool), m_DB(std::move(DB))
+		{
+		}
+
+		KSQLPool*             m_Pool { nullptr };
+		std::unique_ptr<KSQL> m_DB;
+
+	}; // Connection
+
+	/// construct a pool for the connection parameters of a DBC file
+	KSQLPool(KStringViewZ sDBC, Options Options);
+	/// construct a pool for the connection parameters of a DBC file, with default options
+	KSQLPool(KStringViewZ sDBC) : KSQLPool(sDBC, Options()) {}
+	/// construct a pool for the connection parameters of Prototype
+	KSQLPool(KSQL& Prototype, Options Options);
+	/// construct a pool for the connection parameters of Prototype, with default options
+	KSQLPool(KSQL& Prototype) : KSQLPool(Prototype, Options()) {}
+	~KSQLPool();
+
+	KSQLPool(const KSQLPool&) = delete;
+	KSQLPool& operator=(const KSQLPool&) = delete;
+
+	/// borrow a connection, waits up to Options.MaxWait if all connections are borrowed,
+	/// and retries failed connects until then
+	/// @return the connection, test with operator bool - on failure GetLastError() tells why
+	Connection     Get          ();
+
+	/// returns the pool diagnostics
+	Stats          GetStats     () const;
+
+	/// close all idle connections
+	void           clear        ();
+
+	/// returns the DBC the pool was created from, may be empty
+	const KString& GetDBC       () const { return m_sDBC;  }
+
+	/// returns the last error
+	KString        GetLastError () const;
+
+//----------
+private:
+//----------
+
+	struct Idle
+	{
+		std::unique_ptr<KSQL> DB;
+		KSteadyTime           tSince;
+	};
+
+	void                  Return       (std::unique_ptr<KSQL> DB, bool bDiscard);
+	std::unique_ptr<KSQL> Connect      ();
+	bool                  Reconnect    (KSQL& DB);
+	bool                  Validate     (KSQL& DB);
+	void                  SetError     (KString sError);
+	void                  StartMaintenance();
+	void                  Maintenance  ();
+
+	KSQL                               m_Prototype;
+	KString                            m_sDBC;
+	Options                            m_Options;
+	mutable std::mutex                 m_Mutex;
+	std::condition_variable            m_Available;
+	std::condition_variable            m_Wakeup;
+	std::deque<Idle>                   m_Idle;
+	std::vector<std::unique_ptr<KSQL>> m_Lost;
+	Stats                              m_Stats;
+	KString                            m_sLastError;
+	std::size_t                        m_iReserved { 0 };
+	bool                               m_bStop     { false };
+	std::unique_ptr<std::thread>       m_Maintenance;
+
+}; // KSQLPool
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+/// a thread safe collection of KSQLPools, keyed by their DBC
+class DEKAF2_PUBLIC KSQLPools
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+{
+
+//----------
+public:
+//----------
+
+	/// @param Options the options for every new pool
+	KSQLPools(KSQLPool::Options Options = {}) : m_Options(std::move(Options)) {}
+
+	/// returns the pool for sDBC, creates it if not yet existing
+	KSQLPool&             GetPool (KStringViewZ sDBC);
+
+	/// borrow a connection from the pool for sDBC
+	KSQLPool::Connection  Get     (KStringViewZ sDBC) { return GetPool(sDBC).Get(); }
+
+	/// returns the diagnostics of all pools, keyed by DBC
+	KMap<KString, KSQLPool::Stats> GetStats() const;
+
+	/// close all idle connections of all pools
+	void                  clear   ();
+
+//----------
+private:
+//----------
+
+	KSQLPool::Options                              m_Options;
+	mutable std::mutex                             m_Mutex;
+	KMap<KString, std::unique_ptr<KSQLPool>>       m_Pools;
+
+}; // KSQLPools
+
+/// @}
+
+DEKAF2_NAMESPACE_END
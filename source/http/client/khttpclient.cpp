@@ -315,6 +315,7 @@ KHTTPClient::KHTTPClient(std::unique_ptr<KIOStreamSocket> stream)
 KHTTPClient::~KHTTPClient()
 //-----------------------------------------------------------------------------
 {
+	ReleaseConnection();
 	// we call Disconnect() to make sure the http2 object is destructed before
 	// the connection object (as the former references the latter)
 	Disconnect();
@@ -325,6 +326,9 @@ KHTTPClient::~KHTTPClient()
 bool KHTTPClient::Connect(std::unique_ptr<KIOStreamSocket> Connection)
 //-----------------------------------------------------------------------------
 {
+	// hand a previous connection over to the pool before we reset the response
+	ReleaseConnection();
+
 	ClearError();
 
 	// clear the response object, otherwise a previous
@@ -520,6 +524,27 @@ bool KHTTPClient::Connect(const KURL& url)
 		}
 	}
 
+	if (m_bUseConnectionPool && url.Protocol != url::KProtocol::UNIX)
+	{
+		auto& Pool = KHTTPConnectionPool::getInstance();
+
+		auto Connection = Pool.Get(url, m_StreamOptions);
+		bool bFromPool  = Connection != nullptr;
+
+		if (!bFromPool)
+		{
+			Connection = Pool.Create(url, m_StreamOptions);
+		}
+
+		bool bConnected = Connect(std::move(Connection));
+
+		// only direct connections go back to the pool
+		m_bPoolable           = true;
+		m_bConnectionFromPool = bFromPool;
+
+		return bConnected;
+	}
+
 	return Connect(KIOStreamSocket::Create(url, false, m_StreamOptions));
 
 } // Connect
@@ -642,6 +667,28 @@ bool KHTTPClient::Connect(const KURL& url, const KURL& Proxy)
 
 } // Connect
 
+//-----------------------------------------------------------------------------
+void KHTTPClient::ReleaseConnection()
+//-----------------------------------------------------------------------------
+{
+	if (m_bPoolable     &&
+	    m_bKeepAlive    &&
+	    m_Connection    &&
+	    m_Connection->Good() &&
+	    // HTTP/2 and HTTP/3 connections carry session state we cannot hand over
+	    (Request.GetHTTPVersion() & (KHTTPVersion::http2 | KHTTPVersion::http3)) == 0 &&
+	    // the next user must not see the rest of our response
+	    Response.IsInputConsumed())
+	{
+		kDebug(3, "returning connection to {} to the pool", m_Connection->GetEndPoint());
+		KHTTPConnectionPool::getInstance().Put(std::move(m_Connection), m_StreamOptions);
+	}
+
+	m_bPoolable           = false;
+	m_bConnectionFromPool = false;
+
+} // ReleaseConnection
+
 //-----------------------------------------------------------------------------
 bool KHTTPClient::Disconnect()
 //-----------------------------------------------------------------------------
@@ -1190,6 +1237,9 @@ bool KHTTPClient::Parse()
 		return SetNetworkError(true, m_Connection->HasError() ? m_Connection->GetLastError() : Response.GetLastError() );
 	}
 
+	// we got a response, this connection was alive
+	m_bConnectionFromPool = false;
+
 	// make sure also a network read error triggers a meaningful status
 	// code / string (Response.Good() calls Response.Fail() and ensures this)
 	if (!Response.Good()    &&
@@ -1376,6 +1426,13 @@ bool KHTTPClient::SetNetworkError(bool bRead, KStringViewZ sError)
 
 	m_bKeepAlive = false;
 
+	if (m_bConnectionFromPool && m_Connection)
+	{
+		// the server probably closed this and other idle connections
+		KHTTPConnectionPool::getInstance().SetStale(*m_Connection, m_StreamOptions);
+		m_bConnectionFromPool = false;
+	}
+
 	return SetError(sError);
 
 } // SetNetworkError
@@ -47,6 +47,7 @@
 #include <dekaf2/core/strings/kstring.h>
 #include <dekaf2/core/strings/kstringview.h>
 #include <dekaf2/net/util/kiostreamsocket.h>
+#include <dekaf2/http/client/khttpconnectionpool.h>
 #include <dekaf2/http/protocol/khttp_response.h>
 #include <dekaf2/http/protocol/khttp_request.h>
 #include <dekaf2/http/protocol/khttp_method.h>
@@ -494,6 +495,17 @@ public:
 		return *this;
 	}
 
+	//-----------------------------------------------------------------------------
+	/// Share idle keep-alive connections with other clients through the process wide
+	/// KHTTPConnectionPool? Default is KHTTPConnectionPool::GetUseByDefault(). Must be set
+	/// before connection.
+	self& UseConnectionPool(bool bYes = true)
+	//-----------------------------------------------------------------------------
+	{
+		m_bUseConnectionPool = bYes;
+		return *this;
+	}
+
 	//-----------------------------------------------------------------------------
 	/// Allows to manually configure a host header that is not derived from the
 	/// connected URL
@@ -561,6 +573,15 @@ protected:
 	bool AlreadyConnected(const KTCPEndPoint& EndPoint) const;
 	//-----------------------------------------------------------------------------
 
+	//-----------------------------------------------------------------------------
+	/// Returns true if the connection was taken from the connection pool and did not
+	/// yet receive a response - it may have been closed by the server just before use
+	bool IsPooledConnection() const
+	//-----------------------------------------------------------------------------
+	{
+		return m_bConnectionFromPool;
+	}
+
 	//-----------------------------------------------------------------------------
 	/// Returns true if url is not exempt from proxying through the comma delimited
 	/// sNoProxy list. A leading dot means that only the end of the strings are
@@ -598,6 +619,11 @@ private:
 	DEKAF2_PRIVATE bool SetupAutomaticHeaders(KStringView* svPostData, KInStream* PostDataStream, std::size_t iBodySize, const KMIME& Mime);
 	//-----------------------------------------------------------------------------
 
+	//-----------------------------------------------------------------------------
+	/// returns a reusable connection to the connection pool
+	DEKAF2_PRIVATE void ReleaseConnection();
+	//-----------------------------------------------------------------------------
+
 	static KTCPEndPoint s_EmptyEndpoint;
 
 #if DEKAF2_HAS_NGHTTP2
@@ -662,6 +688,9 @@ private:
 	bool               m_bUseHTTPProxyProtocol { false };
 	bool               m_bKeepAlive            { true  };
 	bool               m_bHaveHostSet          { false };
+	bool               m_bUseConnectionPool    { KHTTPConnectionPool::GetUseByDefault() };
+	bool               m_bPoolable             { false };
+	bool               m_bConnectionFromPool   { false };
 
 //------
 public:
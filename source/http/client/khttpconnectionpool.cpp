@@ -0,0 +1,372 @@
+/*
+//
+// DEKAF(tm): Lighter, Faster, Smarter(tm)
+//
+// Copyright (c) 2026, Ridgeware, Inc.
+//
+// +-------------------------------------------------------------------------+
+// | /\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\|
+// |/+---------------------------------------------------------------------+/|
+// |/|                                                                     |/|
+// |\|  ** THIS NOTICE MUST NOT BE REMOVED FROM THE SOURCE CODE MODULE **  |\|
+// |/|                                                                     |/|
+// |\|   OPEN SOURCE LICENSE                                               |\|
+// |/|                                                                     |/|
+// |\|   Permission is hereby granted, free of charge, to any person       |\|
+// |/|   obtaining a copy of this software and associated                  |/|
+// |\|   documentation files (the "Software"), to deal in the              |\|
+// |/|   Software without restriction, including without limitation        |/|
+// |\|   the rights to use, copy, modify, merge, publish,                  |\|
+// |/|   distribute, sublicense, and/or sell copies of the Software,       |/|
+// |\|   and to permit persons to whom the Software is furnished to        |\|
+// |/|   do so, subject to the following conditions:                       |/|
+// |\|                                                                     |\|
+// |/|   The above copyright notice and this permission notice shall       |/|
+// |\|   be included in all copies or substantial portions of the          |\|
+// |/|   Software.                                                         |/|
+// |\|                                                                     |\|
+// |/|   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY         |/|
+// |\|   KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE        |\|
+// |/|   WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR           |/|
+// |\|   PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS        |\|
+// |/|   OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR          |/|
+// |\|   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR        |\|
+// |/|   OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE         |/|
+// |\|   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.            |\|
+// |/|                                                                     |/|
+// |/+---------------------------------------------------------------------+/|
+// |\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/ |
+// +-------------------------------------------------------------------------+
+//
+*/
+
+#include <dekaf2/http/client/khttpconnectionpool.h>
+#include <dekaf2/core/logging/klog.h>
+#include <algorithm>
+
+DEKAF2_NAMESPACE_BEGIN
+
+std::atomic<bool> KHTTPConnectionPool::s_bUseByDefault { false };
+
+//-----------------------------------------------------------------------------
+KHTTPConnectionPool& KHTTPConnectionPool::getInstance()
+//-----------------------------------------------------------------------------
+{
+	static KHTTPConnectionPool s_Pool;
+	return s_Pool;
+
+} // getInstance
+
+//-----------------------------------------------------------------------------
+bool KHTTPConnectionPool::IsTLS(const KURL& URL)
+//-----------------------------------------------------------------------------
+{
+	// the same decision as in KIOStreamSocket::Create()
+	return URL.Protocol.WrapInTLS() ||
+	       (URL.Protocol == url::KProtocol::UNDEFINED && url::KProtocol::WrapInTLS(KTCPEndPoint(URL).Port.get()));
+
+} // IsTLS
+
+//-----------------------------------------------------------------------------
+bool KHTTPConnectionPool::IsAlive(KIOStreamSocket& Socket)
+//-----------------------------------------------------------------------------
+{
+	if (!Socket.Good() || Socket.IsDisconnecting())
+	{
+		return false;
+	}
+
+	// an idle HTTP/1.1 connection must not be readable: if it is, the server either
+	// closed it, or there is unread data from the last response
+	return Socket.CheckIfReady(POLLIN, KDuration::zero(), false) == 0;
+
+} // IsAlive
+
+//-----------------------------------------------------------------------------
+void KHTTPConnectionPool::Expire(KSteadyTime tNow, Trash& Closed)
+//-----------------------------------------------------------------------------
+{
+	// the oldest connections are at the front
+	auto it = std::find_if(m_Idle.begin(), m_Idle.end(), [&](const Idle& Entry)
+	{
+		return tNow - Entry.Since < m_MaxIdleTime;
+	});
+
+	for (auto e = m_Idle.begin(); e != it; ++e)
+	{
+		Closed.push_back(std::move(e->Socket));
+		++m_Statistics.iExpired;
+	}
+
+	m_Idle.erase(m_Idle.begin(), it);
+
+} // Expire
+
+//-----------------------------------------------------------------------------
+void KHTTPConnectionPool::Drop(const Key& IdleKey, Trash& Closed)
+//-----------------------------------------------------------------------------
+{
+	auto it = std::remove_if(m_Idle.begin(), m_Idle.end(), [&](Idle& Entry)
+	{
+		if (Entry.IdleKey == IdleKey)
+		{
+			Closed.push_back(std::move(Entry.Socket));
+			return true;
+		}
+		return false;
+	});
+
+	m_Idle.erase(it, m_Idle.end());
+
+} // Drop
+
+//-----------------------------------------------------------------------------
+std::unique_ptr<KIOStreamSocket> KHTTPConnectionPool::Get(const KURL& URL, const KStreamOptions& Options)
+//-----------------------------------------------------------------------------
+{
+	Key IdleKey(KTCPEndPoint(URL), IsTLS(URL), Options);
+	// close connections only after unlocking - a TLS shutdown writes to the network
+	Trash Closed;
+
+	for (;;)
+	{
+		Connection Socket;
+
+		{
+			std::lock_guard<std::mutex> Lock(m_Mutex);
+
+			Expire(KSteadyTime::now(), Closed);
+
+			// take the youngest connection, it is the least likely to be closed by the server
+			auto it = std::find_if(m_Idle.rbegin(), m_Idle.rend(), [&](const Idle& Entry)
+			{
+				return Entry.IdleKey == IdleKey;
+			});
+
+			if (it == m_Idle.rend())
+			{
+				++m_Statistics.iMisses;
+				return nullptr;
+			}
+
+			Socket = std::move(it->Socket);
+			m_Idle.erase(std::next(it).base());
+		}
+
+		if (IsAlive(*Socket))
+		{
+			kDebug(2, "reusing pooled connection to {}", IdleKey.EndPoint);
+			Socket->SetTimeout(Options.GetTimeout());
+
+			std::lock_guard<std::mutex> Lock(m_Mutex);
+			++m_Statistics.iHits;
+
+			return Socket;
+		}
+
+		kDebug(2, "pooled connection to {} was closed", IdleKey.EndPoint);
+		Closed.push_back(std::move(Socket));
+
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		++m_Statistics.iStale;
+	}
+
+} // Get
+
+//-----------------------------------------------------------------------------
+std::unique_ptr<KIOStreamSocket> KHTTPConnectionPool::Create(const KURL& URL, const KStreamOptions& Options)
+//-----------------------------------------------------------------------------
+{
+	auto Socket = KIOStreamSocket::Create(URL, false, Options);
+
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+
+	++m_Statistics.iConnects;
+
+	if (Socket && Socket->IsTLS())
+	{
+		++m_Statistics.iHandshakes;
+	}
+
+	return Socket;
+
+} // Create
+
+//-----------------------------------------------------------------------------
+bool KHTTPConnectionPool::Put(std::unique_ptr<KIOStreamSocket> Socket, const KStreamOptions& Options)
+//-----------------------------------------------------------------------------
+{
+	if (!Socket || !Socket->Good())
+	{
+		return false;
+	}
+
+	Key IdleKey(Socket->GetEndPoint(), Socket->IsTLS(), Options);
+	Trash Closed;
+	auto tNow = KSteadyTime::now();
+
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+
+	if (!m_iMaxIdlePerHost || !m_iMaxIdleTotal)
+	{
+		Closed.push_back(std::move(Socket));
+		return false;
+	}
+
+	Expire(tNow, Closed);
+
+	auto iForHost = std::count_if(m_Idle.begin(), m_Idle.end(), [&](const Idle& Entry)
+	{
+		return Entry.IdleKey == IdleKey;
+	});
+
+	if (static_cast<std::size_t>(iForHost) >= m_iMaxIdlePerHost)
+	{
+		// drop the oldest connection to this endpoint
+		auto it = std::find_if(m_Idle.begin(), m_Idle.end(), [&](const Idle& Entry)
+		{
+			return Entry.IdleKey == IdleKey;
+		});
+
+		Closed.push_back(std::move(it->Socket));
+		m_Idle.erase(it);
+		++m_Statistics.iEvicted;
+	}
+	else if (m_Idle.size() >= m_iMaxIdleTotal)
+	{
+		// drop the oldest connection overall
+		Closed.push_back(std::move(m_Idle.front().Socket));
+		m_Idle.erase(m_Idle.begin());
+		++m_Statistics.iEvicted;
+	}
+
+	m_Idle.push_back(Idle { std::move(IdleKey), tNow, std::move(Socket) });
+	++m_Statistics.iReturned;
+
+	return true;
+
+} // Put
+
+//-----------------------------------------------------------------------------
+void KHTTPConnectionPool::SetStale(const KIOStreamSocket& Socket, const KStreamOptions& Options)
+//-----------------------------------------------------------------------------
+{
+	Key IdleKey(Socket.GetEndPoint(), Socket.IsTLS(), Options);
+	Trash Closed;
+
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+
+	++m_Statistics.iStale;
+	Drop(IdleKey, Closed);
+
+} // SetStale
+
+//-----------------------------------------------------------------------------
+void KHTTPConnectionPool::clear()
+//-----------------------------------------------------------------------------
+{
+	std::vector<Idle> Closed;
+
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+
+	Closed.swap(m_Idle);
+
+} // clear
+
+//-----------------------------------------------------------------------------
+KHTTPConnectionPool& KHTTPConnectionPool::SetMaxIdlePerHost(std::size_t iMaxIdle)
+//-----------------------------------------------------------------------------
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	m_iMaxIdlePerHost = iMaxIdle;
+	return *this;
+
+} // SetMaxIdlePerHost
+
+//-----------------------------------------------------------------------------
+std::size_t KHTTPConnectionPool::GetMaxIdlePerHost() const
+//-----------------------------------------------------------------------------
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	return m_iMaxIdlePerHost;
+
+} // GetMaxIdlePerHost
+
+//-----------------------------------------------------------------------------
+KHTTPConnectionPool& KHTTPConnectionPool::SetMaxIdleTotal(std::size_t iMaxIdle)
+//-----------------------------------------------------------------------------
+{
+	Trash Closed;
+
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+
+	m_iMaxIdleTotal = iMaxIdle;
+
+	while (m_Idle.size() > m_iMaxIdleTotal)
+	{
+		Closed.push_back(std::move(m_Idle.front().Socket));
+		m_Idle.erase(m_Idle.begin());
+		++m_Statistics.iEvicted;
+	}
+
+	return *this;
+
+} // SetMaxIdleTotal
+
+//-----------------------------------------------------------------------------
+std::size_t KHTTPConnectionPool::GetMaxIdleTotal() const
+//-----------------------------------------------------------------------------
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	return m_iMaxIdleTotal;
+
+} // GetMaxIdleTotal
+
+//-----------------------------------------------------------------------------
+KHTTPConnectionPool& KHTTPConnectionPool::SetMaxIdleTime(KDuration MaxIdleTime)
+//-----------------------------------------------------------------------------
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	m_MaxIdleTime = MaxIdleTime;
+	return *this;
+
+} // SetMaxIdleTime
+
+//-----------------------------------------------------------------------------
+KDuration KHTTPConnectionPool::GetMaxIdleTime() const
+//-----------------------------------------------------------------------------
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	return m_MaxIdleTime;
+
+} // GetMaxIdleTime
+
+//-----------------------------------------------------------------------------
+KHTTPConnectionPool::Statistics KHTTPConnectionPool::GetStatistics() const
+//-----------------------------------------------------------------------------
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+
+	auto Stats  = m_Statistics;
+	Stats.iIdle = m_Idle.size();
+
+	return Stats;
+
+} // GetStatistics
+
+//-----------------------------------------------------------------------------
+void KHTTPConnectionPool::ResetStatistics()
+//-----------------------------------------------------------------------------
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	m_Statistics = Statistics();
+
+} // ResetStatistics
+
+#if DEKAF2_REPEAT_CONSTEXPR_VARIABLE
+constexpr std::size_t KHTTPConnectionPool::DefaultMaxIdlePerHost;
+constexpr std::size_t KHTTPConnectionPool::DefaultMaxIdleTotal;
+constexpr uint16_t    KHTTPConnectionPool::ConnectionOptions;
+#endif
+
+DEKAF2_NAMESPACE_END
@@ -0,0 +1,265 @@
+/*
+//
+// DEKAF(tm): Lighter, Faster, Smarter(tm)
+//
+// Copyright (c) 2026, Ridgeware, Inc.
+//
+// +-------------------------------------------------------------------------+
+// | /\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\|
+// |/+---------------------------------------------------------------------+/|
+// |/|                                                                     |/|
+// |\|  ** THIS NOTICE MUST NOT BE REMOVED FROM THE SOURCE CODE MODULE **  |\|
+// |/|                                                                     |/|
+// |\|   OPEN SOURCE LICENSE                                               |\|
+// |/|                                                                     |/|
+// |\|   Permission is hereby granted, free of charge, to any person       |\|
+// |/|   obtaining a copy of this software and associated                  |/|
+// |\|   documentation files (the "Software"), to deal in the              |\|
+// |/|   Software without restriction, including without limitation        |/|
+// |\|   the rights to use, copy, modify, merge, publish,                  |\|
+// |/|   distribute, sublicense, and/or sell copies of the Software,       |/|
+// |\|   and to permit persons to whom the Software is furnished to        |\|
+// |/|   do so, subject to the following conditions:                       |/|
+// |\|                                                                     |\|
+// |/|   The above copyright notice and this permission notice shall       |/|
+// |\|   be included in all copies or substantial portions of the          |\|
+// |/|   Software.                                                         |/|
+// |\|                                                                     |\|
+// |/|   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY         |/|
+// |\|   KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE        |\|
+// |/|   WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR           |/|
+// |\|   PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS        |\|
+// |/|   OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR          |/|
+// |\|   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR        |\|
+// |/|   OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE         |/|
+// |\|   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.            |\|
+// |/|                                                                     |/|
+// |/+---------------------------------------------------------------------+/|
+// |\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/ |
+// +-------------------------------------------------------------------------+
+//
+*/
+
+#pragma once
+
+/// @file khttpconnectionpool.h
+/// process wide pool of idle keep-alive HTTP connections
+
+#include <dekaf2/core/init/kdefinitions.h>
+#include <dekaf2/net/util/kiostreamsocket.h>
+#include <dekaf2/net/util/kstreamoptions.h>
+#include <dekaf2/time/duration/kduration.h>
+#include <dekaf2/web/url/kurl.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+DEKAF2_NAMESPACE_BEGIN
+
+/// @addtogroup http_client
+/// @{
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+/// A process wide pool of idle HTTP/1.1 keep-alive connections, shared by all KHTTPClient
+/// instances that opted in with KHTTPClient::UseConnectionPool() (or by default after a call
+/// to SetUseByDefault(true)). A client that is destructed or connects elsewhere returns its
+/// connection to the pool, and a new client to the same scheme, host, port and TLS options
+/// takes it from there instead of paying for a new TCP and TLS setup.
+///
+/// Connections are returned only if the server allowed keep-alive and the last response was
+/// read completely. They are checked for liveness before reuse - a connection the server has
+/// closed meanwhile is discarded. HTTP/2 and HTTP/3 connections, proxied connections and
+/// unix sockets are never pooled.
+class DEKAF2_PUBLIC KHTTPConnectionPool
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+{
+
+//------
+public:
+//------
+
+	using self = KHTTPConnectionPool;
+
+	/// pool counters, see GetStatistics()
+	struct Statistics
+	{
+		std::size_t iHits       { 0 }; ///< connections taken from the pool
+		std::size_t iMisses     { 0 }; ///< requests that found no idle connection
+		std::size_t iStale      { 0 }; ///< idle connections found closed by the server
+		std::size_t iExpired    { 0 }; ///< idle connections dropped after GetMaxIdleTime()
+		std::size_t iEvicted    { 0 }; ///< idle connections dropped for the per host or total limits
+		std::size_t iReturned   { 0 }; ///< connections put into the pool
+		std::size_t iConnects   { 0 }; ///< new connections set up through the pool
+		std::size_t iHandshakes { 0 }; ///< new TLS connections, each one with a full handshake
+		std::size_t iIdle       { 0 }; ///< current count of idle connections
+
+		/// returns the share of hits from all requests for a connection, 0 ... 1
+		double GetHitRate() const
+		{
+			return (iHits + iMisses) ? double(iHits) / double(iHits + iMisses) : 0.0;
+		}
+	};
+
+	static constexpr std::size_t DefaultMaxIdlePerHost {  8 };
+	static constexpr std::size_t DefaultMaxIdleTotal   { 64 };
+
+	//-----------------------------------------------------------------------------
+	/// returns the process wide pool
+	static self& getInstance();
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// shall new KHTTPClient instances use the pool (default false)?
+	static void SetUseByDefault(bool bYesNo) { s_bUseByDefault = bYesNo; }
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// do new KHTTPClient instances use the pool?
+	static bool GetUseByDefault() { return s_bUseByDefault; }
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// returns an idle connection to the endpoint of URL, set up with the same options, or nullptr
+	std::unique_ptr<KIOStreamSocket> Get(const KURL& URL, const KStreamOptions& Options);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// creates a new connection to the endpoint of URL, and counts it in the statistics
+	std::unique_ptr<KIOStreamSocket> Create(const KURL& URL, const KStreamOptions& Options);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// puts an idle connection into the pool, Options have to be the ones the connection was
+	/// created with - returns false if the connection was not accepted (and is closed)
+	bool Put(std::unique_ptr<KIOStreamSocket> Connection, const KStreamOptions& Options);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// call when a connection from the pool failed on its first request - the server
+	/// probably closed it, and all other idle connections to it, just before use. Drops
+	/// the idle connections to that endpoint.
+	void SetStale(const KIOStreamSocket& Connection, const KStreamOptions& Options);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// closes all idle connections
+	void clear();
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// set the maximum count of idle connections per endpoint and options
+	self& SetMaxIdlePerHost(std::size_t iMaxIdle);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// get the maximum count of idle connections per endpoint and options
+	std::size_t GetMaxIdlePerHost() const;
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// set the maximum count of idle connections over all endpoints
+	self& SetMaxIdleTotal(std::size_t iMaxIdle);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// get the maximum count of idle connections over all endpoints
+	std::size_t GetMaxIdleTotal() const;
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// set the maximum time a connection stays idle in the pool - keep it below the
+	/// keep-alive timeout of the servers (default 30 seconds)
+	self& SetMaxIdleTime(KDuration MaxIdleTime);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// get the maximum time a connection stays idle in the pool
+	KDuration GetMaxIdleTime() const;
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// returns a snapshot of the pool counters
+	Statistics GetStatistics() const;
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// resets the pool counters
+	void ResetStatistics();
+	//-----------------------------------------------------------------------------
+
+//------
+private:
+//------
+
+	using Connection = std::unique_ptr<KIOStreamSocket>;
+	using Trash      = std::vector<Connection>;
+
+	/// the options that make a difference for the connection setup
+	static constexpr uint16_t ConnectionOptions = KStreamOptions::VerifyCert
+	                                            | KStreamOptions::RequestHTTP2
+	                                            | KStreamOptions::FallBackToHTTP1
+	                                            | KStreamOptions::RequestHTTP3
+	                                            | KStreamOptions::ForceIPv4
+	                                            | KStreamOptions::ForceIPv6;
+
+	struct Key
+	{
+		Key(KTCPEndPoint _EndPoint, bool _bIsTLS, const KStreamOptions& Options)
+		: EndPoint(std::move(_EndPoint))
+		, iOptions(Options.Get() & ConnectionOptions)
+		, bIsTLS(_bIsTLS)
+		{
+		}
+
+		bool operator==(const Key& other) const
+		{
+			return iOptions == other.iOptions && bIsTLS == other.bIsTLS && EndPoint == other.EndPoint;
+		}
+
+		KTCPEndPoint EndPoint;
+		uint16_t     iOptions;
+		bool         bIsTLS;
+	};
+
+	struct Idle
+	{
+		Key          IdleKey;
+		KSteadyTime  Since;
+		Connection   Socket;
+	};
+
+	//-----------------------------------------------------------------------------
+	/// moves expired connections into the trash, needs the lock
+	void Expire(KSteadyTime tNow, Trash& Closed);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// moves all connections of Key into the trash, needs the lock
+	void Drop(const Key& IdleKey, Trash& Closed);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// returns true if the idle connection is still usable
+	static bool IsAlive(KIOStreamSocket& Socket);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	static bool IsTLS(const KURL& URL);
+	//-----------------------------------------------------------------------------
+
+	static std::atomic<bool> s_bUseByDefault;
+
+	mutable std::mutex       m_Mutex;
+	/// idle connections, the oldest first
+	std::vector<Idle>        m_Idle;
+	std::size_t              m_iMaxIdlePerHost { DefaultMaxIdlePerHost };
+	std::size_t              m_iMaxIdleTotal   { DefaultMaxIdleTotal   };
+	KDuration                m_MaxIdleTime     { chrono::seconds(30) };
+	Statistics               m_Statistics;
+
+}; // KHTTPConnectionPool
+
+/// @}
+
+DEKAF2_NAMESPACE_END
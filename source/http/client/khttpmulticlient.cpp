@@ -0,0 +1,645 @@
+/*
+//
+// DEKAF(tm): Lighter, Faster, Smarter(tm)
+//
+// Copyright (c) 2026, Ridgeware, Inc.
+//
+// +-------------------------------------------------------------------------+
+// | /\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\|
+// |/+---------------------------------------------------------------------+/|
+// |/|                                                                     |/|
+// |\|  ** THIS NOTICE MUST NOT BE REMOVED FROM THE SOURCE CODE MODULE **  |\|
+// |/|                                                                     |/|
+// |\|   OPEN SOURCE LICENSE                                               |\|
+// |/|                                                                     |/|
+// |\|   Permission is hereby granted, free of charge, to any person       |\|
+// |/|   obtaining a copy of this software and associated                  |/|
+// |\|   documentation files (the "Software"), to deal in the              |\|
+// |/|   Software without restriction, including without limitation        |/|
+// |\|   the rights to use, copy, modify, merge, publish,                  |\|
+// |/|   distribute, sublicense, and/or sell copies of the Software,       |/|
+// |\|   and to permit persons to whom the Software is furnished to        |\|
+// |/|   do so, subject to the following conditions:                       |/|
+// |\|                                                                     |\|
+// |/|   The above copyright notice and this permission notice shall       |/|
+// |\|   be included in all copies or substantial portions of the          |\|
+// |/|   Software.                                                         |/|
+// |\|                                                                     |\|
+// |/|   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY         |/|
+// |\|   KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE        |\|
+// |/|   WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR           |/|
+// |\|   PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS        |\|
+// |/|   OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR          |/|
+// |\|   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR        |\|
+// |/|   OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE         |/|
+// |\|   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.            |\|
+// |/|                                                                     |/|
+// |/+---------------------------------------------------------------------+/|
+// |\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/ |
+// +-------------------------------------------------------------------------+
+//
+*/
+
+#include <dekaf2/http/client/khttpmulticlient.h>
+#include <dekaf2/http/client/kwebclient.h>
+#include <dekaf2/http/server/khttperror.h>
+#include <dekaf2/core/format/kformat.h>
+#include <dekaf2/core/logging/klog.h>
+#include <dekaf2/system/os/ksystem.h>
+#include <dekaf2/threading/execution/kthreads.h>
+
+#if DEKAF2_HAS_NGHTTP2
+	#include <dekaf2/http/protocol/khttp2.h>
+	#include <dekaf2/io/pipes/kdataconsumer.h>
+	#include <dekaf2/io/pipes/kdataprovider.h>
+	#include <dekaf2/net/tls/ktlsstream.h>
+	#include <array>
+	#include <unordered_map>
+#endif
+
+DEKAF2_NAMESPACE_BEGIN
+
+//-----------------------------------------------------------------------------
+KHTTPMultiClient::KHTTPMultiClient(KURL URL, KHTTPStreamOptions Options, std::size_t iMaxHTTP1Connections)
+//-----------------------------------------------------------------------------
+: m_URL(std::move(URL))
+, m_Options(Options)
+, m_iMaxHTTP1Connections(iMaxHTTP1Connections ? iMaxHTTP1Connections : 1)
+{
+#if !DEKAF2_HAS_NGHTTP2
+	// we cannot speak HTTP/2 - do not offer it in the TLS negotiation
+	m_Options.Unset(KStreamOptions::RequestHTTP2);
+#endif
+	// HTTP/3 is not multiplexed (yet)
+	m_Options.Unset(KStreamOptions::RequestHTTP3);
+
+} // ctor
+
+//-----------------------------------------------------------------------------
+KHTTPMultiClient::~KHTTPMultiClient()
+//-----------------------------------------------------------------------------
+{
+	std::vector<std::thread> Threads;
+
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		m_bShutdown = true;
+		// no new threads get started after this point
+		Threads.swap(m_Threads);
+	}
+
+	FailQueued("client is shutting down");
+
+	m_NewWork.notify_all();
+	m_WakeUp.Wake();
+
+	for (auto& Thread : Threads)
+	{
+		// running requests are completed
+		Thread.join();
+	}
+
+} // dtor
+
+//-----------------------------------------------------------------------------
+KHTTPVersion KHTTPMultiClient::GetHTTPVersion() const
+//-----------------------------------------------------------------------------
+{
+	switch (m_Protocol)
+	{
+		case HTTP1:   return KHTTPVersion::http11;
+		case HTTP2:   return KHTTPVersion::http2;
+		case Unknown: break;
+	}
+
+	return KHTTPVersion::none;
+
+} // GetHTTPVersion
+
+//-----------------------------------------------------------------------------
+void KHTTPMultiClient::Submit(Request request, Callback callback)
+//-----------------------------------------------------------------------------
+{
+	auto pExchange  = std::make_unique<Exchange>();
+	pExchange->Req  = std::move(request);
+	pExchange->CB   = std::move(callback);
+
+	auto& URL = pExchange->Req.URL;
+
+	if (URL.Domain.empty())
+	{
+		URL.Protocol = m_URL.Protocol;
+		URL.Domain   = m_URL.Domain;
+		URL.Port     = m_URL.Port;
+	}
+	else if (URL.Protocol != m_URL.Protocol || !(KTCPEndPoint(URL) == KTCPEndPoint(m_URL)))
+	{
+		pExchange->Resp.SetError(kFormat("request URL {} does not match the authority of this client: {}", URL, m_URL));
+		Complete(std::move(pExchange));
+		return;
+	}
+
+	std::unique_lock<std::mutex> Lock(m_Mutex);
+
+	if (m_bShutdown)
+	{
+		Lock.unlock();
+		pExchange->Resp.SetError("client is shutting down");
+		Complete(std::move(pExchange));
+		return;
+	}
+
+	Enqueue(std::move(pExchange));
+
+} // Submit
+
+//-----------------------------------------------------------------------------
+std::future<KHTTPMultiClient::Response> KHTTPMultiClient::Submit(Request request)
+//-----------------------------------------------------------------------------
+{
+	auto Promise = std::make_shared<std::promise<Response>>();
+	auto Future  = Promise->get_future();
+
+	Submit(std::move(request), [Promise](Response response)
+	{
+		Promise->set_value(std::move(response));
+	});
+
+	return Future;
+
+} // Submit
+
+//-----------------------------------------------------------------------------
+void KHTTPMultiClient::Enqueue(ExchangePtr pExchange)
+//-----------------------------------------------------------------------------
+{
+	m_Queue.push_back(std::move(pExchange));
+
+	switch (m_Protocol)
+	{
+		case Unknown:
+		case HTTP2:
+			if (m_Threads.empty())
+			{
+				m_Threads.push_back(kMakeThread(&KHTTPMultiClient::Connector, this));
+			}
+			else
+			{
+				// the connector either waits for work, or polls the HTTP/2 connection
+				m_NewWork.notify_one();
+				m_WakeUp.Wake();
+			}
+			break;
+
+		case HTTP1:
+			m_NewWork.notify_one();
+			StartWorkers();
+			break;
+	}
+
+} // Enqueue
+
+//-----------------------------------------------------------------------------
+KHTTPMultiClient::ExchangePtr KHTTPMultiClient::Dequeue()
+//-----------------------------------------------------------------------------
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+
+	if (m_Queue.empty())
+	{
+		return nullptr;
+	}
+
+	auto pExchange = std::move(m_Queue.front());
+	m_Queue.pop_front();
+
+	return pExchange;
+
+} // Dequeue
+
+//-----------------------------------------------------------------------------
+void KHTTPMultiClient::Requeue(ExchangePtr pExchange)
+//-----------------------------------------------------------------------------
+{
+	std::unique_lock<std::mutex> Lock(m_Mutex);
+
+	if (m_bShutdown)
+	{
+		// the callback may call Submit() - do not hold the lock
+		Lock.unlock();
+		pExchange->Resp.SetError("client is shutting down");
+		Complete(std::move(pExchange));
+		return;
+	}
+
+	m_Queue.push_front(std::move(pExchange));
+
+} // Requeue
+
+//-----------------------------------------------------------------------------
+void KHTTPMultiClient::StartWorkers()
+//-----------------------------------------------------------------------------
+{
+	while (!m_bShutdown && m_Queue.size() > m_iIdle && m_Threads.size() < m_iMaxHTTP1Connections)
+	{
+		// a new thread counts as idle until it picks up its first request
+		++m_iIdle;
+		m_Threads.push_back(kMakeThread([this]() { RunHTTP1(nullptr); }));
+	}
+
+} // StartWorkers
+
+//-----------------------------------------------------------------------------
+void KHTTPMultiClient::Complete(ExchangePtr pExchange)
+//-----------------------------------------------------------------------------
+{
+	if (pExchange->CB)
+	{
+		DEKAF2_TRY
+		{
+			pExchange->CB(std::move(pExchange->Resp));
+		}
+		DEKAF2_CATCH (const std::exception& ex)
+		{
+			kException(ex);
+		}
+	}
+
+} // Complete
+
+//-----------------------------------------------------------------------------
+void KHTTPMultiClient::FailQueued(KStringViewZ sError)
+//-----------------------------------------------------------------------------
+{
+	std::deque<ExchangePtr> Queue;
+
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		Queue.swap(m_Queue);
+	}
+
+	for (auto& pExchange : Queue)
+	{
+		pExchange->Resp.SetError(sError);
+		Complete(std::move(pExchange));
+	}
+
+} // FailQueued
+
+//-----------------------------------------------------------------------------
+void KHTTPMultiClient::Connector()
+//-----------------------------------------------------------------------------
+{
+	kSetThreadName("khttpmulti");
+
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> Lock(m_Mutex);
+			m_NewWork.wait(Lock, [this]() { return m_bShutdown || !m_Queue.empty(); });
+
+			if (m_bShutdown)
+			{
+				return;
+			}
+		}
+
+		auto Connection = KIOStreamSocket::Create(m_URL, false, m_Options);
+
+		if (!Connection || !Connection->Good())
+		{
+			FailQueued(Connection ? KStringViewZ(Connection->GetLastError()) : KStringViewZ("cannot connect"));
+			continue;
+		}
+
+#if DEKAF2_HAS_NGHTTP2
+		if (m_Options.IsSet(KStreamOptions::RequestHTTP2))
+		{
+			auto TLSStream = dynamic_cast<KTLSStream*>(Connection.get());
+
+			if (TLSStream)
+			{
+				// force the handshake right now, we need the ALPN result
+				if (Connection->StartManualTLSHandshake())
+				{
+					if (Connection->GetALPN() == "h2")
+					{
+						kDebug(2, "multiplexing requests to {} over HTTP/2", m_URL.Domain);
+						m_Protocol = HTTP2;
+						RunHTTP2(*TLSStream);
+						// the connection ended - reconnect when new requests come in
+						continue;
+					}
+
+					if (!m_Options.IsSet(KStreamOptions::FallBackToHTTP1))
+					{
+						FailQueued("wanted a HTTP/2 connection, but got only HTTP/1.1");
+						continue;
+					}
+				}
+				else if (TLSStream->ShouldRetryWithHTTP1())
+				{
+					// remove the HTTP/2 option, it harms the connection setup - the
+					// HTTP/1.1 client connects again on its own
+					m_Options.Unset(KStreamOptions::RequestHTTP2);
+					Connection.reset();
+				}
+				else
+				{
+					FailQueued(Connection->GetLastError());
+					continue;
+				}
+			}
+		}
+#endif
+
+		kDebug(2, "sending requests to {} over up to {} HTTP/1.1 connections", m_URL.Domain, m_iMaxHTTP1Connections);
+
+		{
+			std::lock_guard<std::mutex> Lock(m_Mutex);
+			m_Protocol = HTTP1;
+			// this thread continues as the first HTTP/1.1 worker
+			++m_iIdle;
+			StartWorkers();
+		}
+
+		RunHTTP1(std::move(Connection));
+
+		return;
+	}
+
+} // Connector
+
+//-----------------------------------------------------------------------------
+void KHTTPMultiClient::RunHTTP1(std::unique_ptr<KIOStreamSocket> Connection)
+//-----------------------------------------------------------------------------
+{
+	kSetThreadName("khttpmulti");
+
+	KHTTPStreamOptions Options(m_Options);
+	Options.Unset(KStreamOptions::RequestHTTP2);
+
+	KWebClient Client(Options);
+
+	if (Connection)
+	{
+		// KWebClient hides the connection setup, but we reuse the probe connection
+		static_cast<KHTTPClient&>(Client).Connect(std::move(Connection));
+	}
+
+	for (;;)
+	{
+		ExchangePtr pExchange;
+
+		{
+			std::unique_lock<std::mutex> Lock(m_Mutex);
+			m_NewWork.wait(Lock, [this]() { return m_bShutdown || !m_Queue.empty(); });
+
+			if (m_Queue.empty())
+			{
+				// shutdown
+				--m_iIdle;
+				return;
+			}
+
+			pExchange = std::move(m_Queue.front());
+			m_Queue.pop_front();
+			--m_iIdle;
+		}
+
+		auto& Req  = pExchange->Req;
+		auto& Resp = pExchange->Resp;
+
+		Client.clear();
+
+		for (const auto& Header : Req.Headers)
+		{
+			Client.AddHeader(Header.first, Header.second);
+		}
+
+		Resp.sBody = Client.HttpRequest(Req.URL, Req.Method, Req.sBody, Req.MIME);
+		static_cast<KHTTPResponseHeaders&>(Resp) = Client.Response;
+
+		if (Client.HasError() && (!Resp.GetStatusCode() || Resp.GetStatusCode() == KHTTPError::H5xx_READTIMEOUT))
+		{
+			// a transport error, not a HTTP status
+			Resp.SetError(Client.GetLastError());
+		}
+
+		Complete(std::move(pExchange));
+
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		++m_iIdle;
+	}
+
+} // RunHTTP1
+
+#if DEKAF2_HAS_NGHTTP2
+
+//-----------------------------------------------------------------------------
+void KHTTPMultiClient::RunHTTP2(KTLSStream& TLSStream)
+//-----------------------------------------------------------------------------
+{
+	khttp2::MultiStreamSession Session(TLSStream, true);
+
+	struct ActiveExchange
+	{
+		ExchangePtr pExchange;
+		KSteadyTime tDeadline; // the stream timeout counts per stream, from its start
+	};
+
+	std::unordered_map<khttp2::Stream::ID, ActiveExchange> Active;
+	std::array<char, 16 * 1024> Buffer;
+	KString sError;
+	bool bDraining { false };
+
+	if (Session.HasError())
+	{
+		sError = Session.GetLastError();
+		bDraining = true;
+	}
+
+	while (sError.empty())
+	{
+		if (!bDraining)
+		{
+			// start new streams up to the limit of the server
+			auto iMaxStreams = std::min(Session.GetMaxConcurrentStreams(), m_iMaxHTTP2Streams.load(std::memory_order_relaxed));
+
+			while (Active.size() < iMaxStreams)
+			{
+				auto pExchange = Dequeue();
+
+				if (!pExchange)
+				{
+					break;
+				}
+
+				auto& Req = pExchange->Req;
+
+				std::unique_ptr<KDataProvider> SendData;
+
+				if (!Req.sBody.empty())
+				{
+					if (!Req.Headers.contains(KHTTPHeader::CONTENT_TYPE))
+					{
+						Req.Headers.Set(KHTTPHeader::CONTENT_TYPE, Req.MIME.Serialize());
+					}
+
+					Req.Headers.Set(KHTTPHeader::CONTENT_LENGTH, KString::to_string(Req.sBody.size()));
+
+					SendData = std::make_unique<KViewProvider>(Req.sBody);
+				}
+
+				auto StreamID = Session.CanStartStreams()
+				              ? Session.NewStream(Req.URL,
+				                                  Req.Method,
+				                                  Req,
+				                                  std::move(SendData),
+				                                  pExchange->Resp,
+				                                  std::make_unique<KStringConsumer>(pExchange->Resp.sBody))
+				              : -1;
+
+				if (StreamID < 0)
+				{
+					// the server sent a GOAWAY - let the running streams end, and
+					// start this one on a new connection
+					kDebug(2, "cannot start new streams on this connection: {}", Session.GetLastError());
+					Requeue(std::move(pExchange));
+					bDraining = true;
+					break;
+				}
+
+				Active.emplace(StreamID, ActiveExchange { std::move(pExchange), KSteadyTime::now() + m_Options.GetTimeout() });
+			}
+		}
+
+		if (!Session.Send())
+		{
+			sError = Session.GetLastError();
+			break;
+		}
+
+		if (Active.empty() && (bDraining || m_bShutdown || !Session.IsAlive()))
+		{
+			break;
+		}
+
+		// check the buffers of the TLS stream first, then wait on the socket
+		// and on new requests
+		bool bReadable = TLSStream.CheckIfReady(POLLIN, KDuration::zero(), false) > 0;
+
+		if (!bReadable)
+		{
+			// wake-ups for new requests must not restart the wait of the
+			// running streams - poll only until the earliest stream deadline
+			auto Timeout = m_Options.GetTimeout();
+
+			if (!Active.empty())
+			{
+				auto tDeadline = KSteadyTime::max();
+
+				for (const auto& it : Active)
+				{
+					tDeadline = std::min(tDeadline, it.second.tDeadline);
+				}
+
+				auto tNow = KSteadyTime::now();
+				Timeout   = (tDeadline > tNow) ? KDuration(tDeadline - tNow) : KDuration::zero();
+			}
+
+			std::array<pollfd, 2> fds;
+			fds[0].fd     = TLSStream.GetNativeSocket();
+			fds[0].events = POLLIN;
+			fds[1].fd     = m_WakeUp.GetFD();
+			fds[1].events = POLLIN;
+
+			auto iResult = kPoll(KSpan<pollfd>(fds.data(), fds.size()), Timeout);
+
+			if (iResult < 0)
+			{
+				sError = kFormat("poll error: {}", strerror(-iResult));
+				break;
+			}
+
+			if (fds[1].revents)
+			{
+				m_WakeUp.Clear();
+			}
+
+			if (iResult == 0 && !Active.empty())
+			{
+				// a stream reached its deadline - we cannot abandon a single stream while
+				// its data still arrives, so we give up the connection
+				sError = kFormat("timeout after {} waiting for the response", m_Options.GetTimeout());
+				break;
+			}
+
+			bReadable = fds[0].revents != 0;
+		}
+
+		if (bReadable)
+		{
+			auto iRead = TLSStream.direct_read_some(Buffer.data(), Buffer.size());
+
+			if (iRead <= 0)
+			{
+				sError = "connection closed by server";
+				break;
+			}
+
+			if (!Session.Receive(Buffer.data(), iRead))
+			{
+				sError = Session.GetLastError();
+				break;
+			}
+
+			for (const auto& Closed : Session.TakeClosedStreams())
+			{
+				auto it = Active.find(Closed.first);
+
+				if (it == Active.end())
+				{
+					continue;
+				}
+
+				auto& Resp = it->second.pExchange->Resp;
+
+				if (Closed.second)
+				{
+					Resp.SetError(kFormat("HTTP/2 stream error: {}", khttp2::MultiStreamSession::TranslateStreamError(Closed.second)));
+				}
+				else if (!Resp.GetStatusCode())
+				{
+					Resp.SetError("stream closed without a response");
+				}
+
+				auto pExchange = std::move(it->second.pExchange);
+				Active.erase(it);
+
+				Complete(std::move(pExchange));
+			}
+		}
+	}
+
+	if (!sError.empty())
+	{
+		kDebug(1, "HTTP/2 connection to {} failed: {}", m_URL.Domain, sError);
+	}
+
+	for (auto& it : Active)
+	{
+		it.second.pExchange->Resp.SetError(sError.empty() ? KStringViewZ("connection closed") : KStringViewZ(sError));
+		Complete(std::move(it.second.pExchange));
+	}
+
+} // RunHTTP2
+
+#endif // DEKAF2_HAS_NGHTTP2
+
+#if DEKAF2_REPEAT_CONSTEXPR_VARIABLE
+constexpr std::size_t KHTTPMultiClient::DefaultHTTP1Connections;
+constexpr std::size_t KHTTPMultiClient::DefaultHTTP2Streams;
+#endif
+
+DEKAF2_NAMESPACE_END
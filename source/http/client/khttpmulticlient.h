@@ -0,0 +1,305 @@
+/*
+//
+// DEKAF(tm): Lighter, Faster, Smarter(tm)
+//
+// Copyright (c) 2026, Ridgeware, Inc.
+//
+// +-------------------------------------------------------------------------+
+// | /\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\|
+// |/+---------------------------------------------------------------------+/|
+// |/|                                                                     |/|
+// |\|  ** THIS NOTICE MUST NOT BE REMOVED FROM THE SOURCE CODE MODULE **  |\|
+// |/|                                                                     |/|
+// |\|   OPEN SOURCE LICENSE                                               |\|
+// |/|                                                                     |/|
+// |\|   Permission is hereby granted, free of charge, to any person       |\|
+// |/|   obtaining a copy of this software and associated                  |/|
+// |\|   documentation files (the "Software"), to deal in the              |\|
+// |/|   Software without restriction, including without limitation        |/|
+// |\|   the rights to use, copy, modify, merge, publish,                  |\|
+// |/|   distribute, sublicense, and/or sell copies of the Software,       |/|
+// |\|   and to permit persons to whom the Software is furnished to        |\|
+// |/|   do so, subject to the following conditions:                       |/|
+// |\|                                                                     |\|
+// |/|   The above copyright notice and this permission notice shall       |/|
+// |\|   be included in all copies or substantial portions of the          |\|
+// |/|   Software.                                                         |/|
+// |\|                                                                     |\|
+// |/|   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY         |/|
+// |\|   KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE        |\|
+// |/|   WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR           |/|
+// |\|   PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS        |\|
+// |/|   OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR          |/|
+// |\|   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR        |\|
+// |/|   OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE         |/|
+// |\|   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.            |\|
+// |/|                                                                     |/|
+// |/+---------------------------------------------------------------------+/|
+// |\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/ |
+// +-------------------------------------------------------------------------+
+//
+*/
+
+#pragma once
+
+/// @file khttpmulticlient.h
+/// HTTP client for many concurrent requests to one authority
+
+#include <dekaf2/core/init/kdefinitions.h>
+#include <dekaf2/core/strings/kstring.h>
+#include <dekaf2/core/errors/kerror.h>
+#include <dekaf2/http/protocol/khttp_header.h>
+#include <dekaf2/http/protocol/khttp_method.h>
+#include <dekaf2/http/protocol/khttp_response.h>
+#include <dekaf2/http/protocol/khttp_version.h>
+#include <dekaf2/net/util/kiostreamsocket.h>
+#include <dekaf2/net/util/kpoll.h>
+#include <dekaf2/net/util/kstreamoptions.h>
+#include <dekaf2/web/url/kmime.h>
+#include <dekaf2/web/url/kurl.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef DEKAF2_IS_WINDOWS
+	// Windows has a DELETE macro in winnt.h which interferes with
+	// dekaf2::KHTTPMethod::DELETE (macros are evil!)
+	#ifdef DELETE
+		#undef DELETE
+	#endif
+#endif
+
+DEKAF2_NAMESPACE_BEGIN
+
+class KTLSStream;
+
+/// @addtogroup http_client
+/// @{
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+/// HTTP client that runs many requests to one authority (scheme, host and port) concurrently,
+/// for fan-out calls to a backend. Requests are submitted without blocking, and their responses
+/// are returned through futures or callbacks.
+///
+/// When the server negotiates HTTP/2, all requests are multiplexed as streams over one single TLS
+/// connection, honoring the server's limit for concurrent streams - further requests wait in a queue.
+/// Otherwise the client falls back to a pool of up to iMaxHTTP1Connections keep-alive HTTP/1.1
+/// connections. HTTP/3 is not yet multiplexed, the RequestHTTP3 option is ignored.
+///
+/// The connections are set up lazily with the first request, by background threads that also call
+/// the response callbacks - callbacks should therefore return quickly.
+class DEKAF2_PUBLIC KHTTPMultiClient
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+{
+
+//------
+public:
+//------
+
+	using self = KHTTPMultiClient;
+
+	//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+	/// one request - the headers are added to the automatic request headers
+	class Request : public KHTTPHeaders
+	//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+	{
+
+	//------
+	public:
+	//------
+
+		Request() = default;
+		/// construct from URL, method and body - the URL may omit scheme, host and port,
+		/// they are then taken from the client's authority
+		Request(KURL _URL, KHTTPMethod _Method = KHTTPMethod::GET, KString _sBody = KString{}, KMIME _MIME = KMIME::JSON)
+		: URL(std::move(_URL))
+		, Method(_Method)
+		, sBody(std::move(_sBody))
+		, MIME(std::move(_MIME))
+		{
+		}
+
+		/// the request URL
+		KURL        URL;
+		/// the request method
+		KHTTPMethod Method { KHTTPMethod::GET };
+		/// the request body
+		KString     sBody;
+		/// the MIME type of the request body
+		KMIME       MIME   { KMIME::JSON };
+
+	}; // Request
+
+	//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+	/// the response to one request - check HasError() for transport errors, GetStatusCode() for the HTTP status
+	class Response : public KHTTPResponseHeaders
+	//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+	{
+
+		friend class KHTTPMultiClient;
+
+	//------
+	public:
+	//------
+
+		/// returns true if there was no transport error and the HTTP status code is a 2xx code
+		bool HttpSuccess() const { return !HasError() && Good(); }
+
+		/// the response body
+		KString sBody;
+
+	}; // Response
+
+	using Callback = std::function<void(Response)>;
+
+	/// the default maximum of concurrent HTTP/1.1 connections
+	static constexpr std::size_t DefaultHTTP1Connections { 6   };
+	/// the default maximum of concurrent HTTP/2 streams, further restricted by the server's setting
+	static constexpr std::size_t DefaultHTTP2Streams     { 100 };
+
+	//-----------------------------------------------------------------------------
+	/// construct a client for the authority of URL (scheme, host and port)
+	/// @param URL the authority for all requests, other URL components are ignored
+	/// @param Options the stream options - set RequestHTTP2 (the default for HTTP) to multiplex requests over HTTP/2,
+	/// the stream timeout also limits the wait for a response
+	/// @param iMaxHTTP1Connections the maximum of connections if the server does not speak HTTP/2
+	KHTTPMultiClient(KURL URL,
+	                 KHTTPStreamOptions Options = KHTTPStreamOptions{},
+	                 std::size_t iMaxHTTP1Connections = DefaultHTTP1Connections);
+	//-----------------------------------------------------------------------------
+
+	KHTTPMultiClient(const KHTTPMultiClient&) = delete;
+	KHTTPMultiClient& operator=(const KHTTPMultiClient&) = delete;
+
+	//-----------------------------------------------------------------------------
+	/// fails all requests that have not yet been started, and waits for the running ones
+	~KHTTPMultiClient();
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// submit a request, returns immediately. The callback is called from a background thread
+	/// once the response is complete or has failed.
+	void Submit(Request request, Callback callback);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// submit a request, returns immediately with a future for the response
+	std::future<Response> Submit(Request request);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// submit a GET request for the path and query of URL, returns immediately with a future for the response
+	std::future<Response> Get(KURL URL)
+	//-----------------------------------------------------------------------------
+	{
+		return Submit(Request(std::move(URL)));
+	}
+
+	//-----------------------------------------------------------------------------
+	/// submit a POST request for the path and query of URL, returns immediately with a future for the response
+	std::future<Response> Post(KURL URL, KString sBody, KMIME MIME = KMIME::JSON)
+	//-----------------------------------------------------------------------------
+	{
+		return Submit(Request(std::move(URL), KHTTPMethod::POST, std::move(sBody), std::move(MIME)));
+	}
+
+	//-----------------------------------------------------------------------------
+	/// returns the negotiated HTTP version, or KHTTPVersion::none before the first connection
+	KHTTPVersion GetHTTPVersion() const;
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// limit the number of concurrent HTTP/2 streams below the server's limit - must be set before the first request
+	self& SetMaxHTTP2Streams(std::size_t iMaxStreams)
+	//-----------------------------------------------------------------------------
+	{
+		m_iMaxHTTP2Streams.store(iMaxStreams ? iMaxStreams : 1, std::memory_order_relaxed);
+		return *this;
+	}
+
+//------
+private:
+//------
+
+	enum Protocol : uint8_t { Unknown, HTTP1, HTTP2 };
+
+	struct Exchange
+	{
+		Request  Req;
+		Response Resp;
+		Callback CB;
+	};
+
+	using ExchangePtr = std::unique_ptr<Exchange>;
+
+	//-----------------------------------------------------------------------------
+	/// add an exchange to the queue, and start a thread if needed - m_Mutex must be locked
+	void Enqueue(ExchangePtr Exchange);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// returns the next queued exchange, or nullptr
+	ExchangePtr Dequeue();
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// put an exchange that could not be started back to the front of the queue
+	void Requeue(ExchangePtr Exchange);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// start HTTP/1.1 threads for the queued exchanges - m_Mutex must be locked
+	void StartWorkers();
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// call the callback of a completed exchange
+	static void Complete(ExchangePtr Exchange);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// fail all queued exchanges with sError
+	void FailQueued(KStringViewZ sError);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// the first thread: connects, negotiates the protocol, and runs HTTP/2 or the first HTTP/1.1 connection
+	void Connector();
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// runs one HTTP/1.1 connection, starting with Connection if not null
+	void RunHTTP1(std::unique_ptr<KIOStreamSocket> Connection);
+	//-----------------------------------------------------------------------------
+
+#if DEKAF2_HAS_NGHTTP2
+	//-----------------------------------------------------------------------------
+	/// runs the HTTP/2 session on TLSStream until the connection ends, or until the client shuts down
+	void RunHTTP2(KTLSStream& TLSStream);
+	//-----------------------------------------------------------------------------
+#endif
+
+	KURL                              m_URL;
+	KHTTPStreamOptions                m_Options;
+	std::size_t                       m_iMaxHTTP1Connections;
+	std::atomic<std::size_t>          m_iMaxHTTP2Streams { DefaultHTTP2Streams }; // read by the connector thread
+	KPollInterruptor                  m_WakeUp;
+	std::mutex                        m_Mutex;
+	std::condition_variable           m_NewWork;
+	std::deque<ExchangePtr>           m_Queue;
+	std::vector<std::thread>          m_Threads;
+	std::size_t                       m_iIdle     { 0       };
+	std::atomic<Protocol>             m_Protocol  { Unknown };
+	std::atomic<bool>                 m_bShutdown { false   };
+
+}; // KHTTPMultiClient
+
+/// @}
+
+DEKAF2_NAMESPACE_END
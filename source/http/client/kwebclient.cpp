@@ -135,6 +135,10 @@ bool KWebClient::HttpRequest2Host (KOutStream& OutStream, const KURL& HostURL, K
 		{
 			ConnectTime.halt();
 
+			// an idle connection from the connection pool can be closed by the
+			// server just like our own keepalive connection
+			bReuseConnection = bReuseConnection || IsPooledConnection();
+
 			if (Resource(RequestURL, RequestMethod))
 			{
 				if (m_bAcceptCookies)
@@ -198,7 +198,7 @@ public:
 	}
 
 	//-----------------------------------------------------------------------------
-	/// Allow connection retry for closed keepalive connections?
+	/// Allow connection retry for closed keepalive connections (also for those from the connection pool)?
 	self& AllowConnectionRetry(bool bAllowOneRetry = true)
 	//-----------------------------------------------------------------------------
 	{
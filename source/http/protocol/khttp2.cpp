@@ -504,6 +504,60 @@ bool Session::DeleteStream(Stream::ID StreamID)
 
 } // DeleteStream
 
+//-----------------------------------------------------------------------------
+std::vector<Session::ClosedStream> Session::TakeClosedStreams()
+//-----------------------------------------------------------------------------
+{
+	std::vector<ClosedStream> Closed;
+
+	Closed.swap(m_ClosedStreams);
+
+	for (const auto& Stream : Closed)
+	{
+		DeleteStream(Stream.first);
+	}
+
+	return Closed;
+
+} // TakeClosedStreams
+
+//-----------------------------------------------------------------------------
+std::size_t Session::GetMaxConcurrentStreams() const
+//-----------------------------------------------------------------------------
+{
+	if (!m_Session)
+	{
+		return 0;
+	}
+
+	return nghttp2_session_get_remote_settings(m_Session, NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS);
+
+} // GetMaxConcurrentStreams
+
+//-----------------------------------------------------------------------------
+bool Session::CanStartStreams() const
+//-----------------------------------------------------------------------------
+{
+	return m_Session && nghttp2_session_check_request_allowed(m_Session) != 0;
+
+} // CanStartStreams
+
+//-----------------------------------------------------------------------------
+bool Session::IsAlive() const
+//-----------------------------------------------------------------------------
+{
+	return m_Session && (nghttp2_session_want_read(m_Session) || nghttp2_session_want_write(m_Session));
+
+} // IsAlive
+
+//-----------------------------------------------------------------------------
+KStringView Session::TranslateStreamError(uint32_t iErrorCode)
+//-----------------------------------------------------------------------------
+{
+	return nghttp2_http2_strerror(iErrorCode);
+
+} // TranslateStreamError
+
 //-----------------------------------------------------------------------------
 nghttp2_ssize Session::OnReceive (KBuffer data, int flags)
 //-----------------------------------------------------------------------------
@@ -706,6 +760,15 @@ int Session::OnStreamClose (Stream::ID stream_id, uint32_t error_code)
 		return NGHTTP2_PROTOCOL_ERROR;
 	}
 
+	auto Stream = GetStream(stream_id);
+
+	if (Stream && Stream->HasDataConsumer())
+	{
+		// nobody reads this stream with ReadData(), it is complete now -
+		// it gets deleted outside of the nghttp2 callbacks
+		m_ClosedStreams.emplace_back(stream_id, error_code);
+	}
+
 	return NGHTTP2_NO_ERROR;
 
 } // OnStreamClose
@@ -968,6 +1031,9 @@ bool Session::Run()
 		{
 			return false;
 		}
+
+		// remove the streams that are complete
+		TakeClosedStreams();
 	}
 
 } // Run
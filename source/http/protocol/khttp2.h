@@ -62,6 +62,8 @@
 #include <dekaf2/io/pipes/kdataconsumer.h>
 #include <cstdint>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 // forward declarations into nghttp2 types
 struct nghttp2_session;
@@ -120,6 +122,8 @@ public:
 	const KBuffer& GetReceiveBuffer  () const         { return m_RXBuffer;         }
 	/// the stream was closed, set the IsClosed flag, and if set, call the DataConsumer callback
 	void          Close              ();
+	/// returns true if the response data of this stream goes into a DataConsumer
+	bool          HasDataConsumer    () const         { return m_DataConsumer != nullptr; }
 	/// return the close flag
 	bool          IsClosed           () const         { return m_bIsClosed;        }
 	/// add incoming data to this stream - this is a method normally called by the Session class upon reception
@@ -177,10 +181,31 @@ public:
 	/// after adding streams, run the data pump here until Run() returns false
 	bool Run();
 
+	/// returns the number of open streams
+	std::size_t GetStreamCount() const { return m_Streams.size(); }
+
+	/// returns the maximum number of concurrent streams the peer permits
+	std::size_t GetMaxConcurrentStreams() const;
+
+	/// returns false once no new streams can be started on this session, e.g. after the peer sent a GOAWAY
+	bool CanStartStreams() const;
+
+	/// returns false once the session neither wants to read nor to write anymore - it can then be closed
+	bool IsAlive() const;
+
+	/// returns a description for a HTTP/2 error code
+	static KStringView TranslateStreamError(uint32_t iErrorCode);
+
 //----------
 protected:
 //----------
 
+	using ClosedStream = std::pair<Stream::ID, uint32_t>;
+
+	/// returns the streams with a DataConsumer that were closed since the last call, together with their HTTP/2
+	/// error code (0 for a regular end of stream), and deletes them from the session
+	std::vector<ClosedStream> TakeClosedStreams();
+
 	Stream::ID NewRequest (Stream Stream,
 	                       const KHTTPHeaders& RequestHeaders,
 	                       std::unique_ptr<KDataProvider> SendData);
@@ -227,6 +252,7 @@ private:
 
 	nghttp2_session* m_Session { nullptr };
 	std::unordered_map<Stream::ID, Stream> m_Streams;
+	std::vector<ClosedStream>              m_ClosedStreams;
 	KString          m_sAuthority; // the common authority for all Streams managed by this Session
 
 }; // Session
@@ -270,6 +296,40 @@ protected:
 
 }; // SingleStreamSession
 
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+/// A session that multiplexes many concurrent streams, with an external data pump: the owner reads from the
+/// TLS stream when it becomes readable, and hands the data to Receive(). Responses are delivered into the
+/// DataConsumer objects of the streams, and TakeClosedStreams() reports the finished ones.
+class DEKAF2_PUBLIC MultiStreamSession : protected Session
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+{
+
+//----------
+public:
+//----------
+
+	using Session::Session;
+	using Session::SetError;
+	using Session::GetLastError;
+	using Session::CopyLastError;
+	using Session::HasError;
+	using Session::NewStream;
+	using Session::GetStreamCount;
+	using Session::GetMaxConcurrentStreams;
+	using Session::CanStartStreams;
+	using Session::IsAlive;
+	using Session::TranslateStreamError;
+	using Session::ClosedStream;
+	using Session::TakeClosedStreams;
+
+	/// send all frames that are ready to be sent, like the headers and data of new streams
+	bool Send    ()                                   { return SessionSend(); }
+
+	/// hand data that was read from the TLS stream to the session, and send all frames that became ready
+	bool Receive (const void* data, std::size_t len)  { return Received(data, len); }
+
+}; // MultiStreamSession
+
 } // end of namespace khttp2
 
 
@@ -490,6 +490,26 @@ public:
 		}
 	}
 
+	//-----------------------------------------------------------------------------
+	/// returns the same hash as KHTTPHeader(sHeader).Hash(), without constructing
+	/// a header and a lowercase copy of an unknown header name
+	DEKAF2_KHTTP_HEADER_CONSTEXPR_14
+	static std::size_t Hash(KStringView sHeader)
+	//-----------------------------------------------------------------------------
+	{
+		auto header = Parse(sHeader);
+
+		if (header == OTHER)
+		{
+			// the lowercase hash equals the hash of the lowercase copy
+			return sHeader.CaseHash();
+		}
+		else
+		{
+			return kHash(static_cast<char>(header));
+		}
+	}
+
 	//-----------------------------------------------------------------------------
 	DEKAF2_KHTTP_HEADER_CONSTEXPR_14
 	friend bool operator==(const KHTTPHeader& left, const KHTTPHeader& right)
@@ -923,11 +943,22 @@ namespace std
 	/// provide a std::hash for KHTTPHeader
 	template<> struct hash<DEKAF2_PREFIX KHTTPHeader>
 	{
+		// header names are hashed without constructing a KHTTPHeader
+		using is_transparent = void;
+
 		DEKAF2_KHTTP_HEADER_CONSTEXPR_14
 		std::size_t operator()(const DEKAF2_PREFIX KHTTPHeader& header) const noexcept
 		{
 			return header.Hash();
 		}
+
+		template<typename T,
+		         typename std::enable_if<DEKAF2_PREFIX detail::is_kstringview_assignable<const T&, true>::value == true, int>::type = 0>
+		DEKAF2_KHTTP_HEADER_CONSTEXPR_14
+		std::size_t operator()(const T& sHeader) const noexcept
+		{
+			return DEKAF2_PREFIX KHTTPHeader::Hash(DEKAF2_PREFIX KStringView(sHeader));
+		}
 	};
 
 } // end of namespace std
@@ -962,7 +993,7 @@ public:
 	static std::size_t constexpr MAX_LINELENGTH  { 8 * 1024 };
 	static std::size_t constexpr MAX_HEADERCOUNT { 500      };
 
-	using KHeaderMap = KProps<KHTTPHeader, KString, /*Sequential =*/ true, /*Unique =*/ false>; // case insensitive map for header info
+	using KHeaderMap = KSmallProps<KHTTPHeader, KString, /*Sequential =*/ true, /*Unique =*/ false>; // case insensitive map for header info
 
 	//-----------------------------------------------------------------------------
 	/// parses from Stream into headers
@@ -42,6 +42,7 @@
 #include <dekaf2/http/server/khttppath.h>
 #include <dekaf2/core/strings/ksplit.h>
 #include <dekaf2/core/logging/klog.h>
+#include <algorithm>
 
 DEKAF2_NAMESPACE_BEGIN
 
@@ -130,6 +131,183 @@ KHTTPAnalyzedPath::KHTTPAnalyzedPath(KString _sRoute)
 	
 } // KHTTPAnalyzedPath
 
+namespace {
+
+//-----------------------------------------------------------------------------
+inline bool IsParameter(KStringView sPart)
+//-----------------------------------------------------------------------------
+{
+	return !sPart.empty() && (sPart.front() == ':' || sPart.front() == '=');
+}
+
+} // end of anonymous namespace
+
+//-----------------------------------------------------------------------------
+void KHTTPRouteIndex::Add(std::size_t iRoute, const KHTTPAnalyzedPath& Route, bool bPartwise, bool bWithParameters)
+//-----------------------------------------------------------------------------
+{
+	if (!bPartwise)
+	{
+		// a plain route, compared as a string - with a wildcard at the end its
+		// sRoute already has the trailing /* removed
+		auto& Routes = (Route.m_bHasWildCardAtEnd) ? m_Prefix : m_Exact;
+		Routes[KStringView(Route.sRoute).Hash()].push_back(iRoute);
+		return;
+	}
+
+	if (m_Nodes.empty())
+	{
+		m_Nodes.emplace_back();
+	}
+
+	const auto& Parts = Route.vURLParts;
+
+	// with parameters, a path may end before the route does, as long as
+	// only parameters remain - find the first of those trailing parameters
+	auto iOptionalFrom = Parts.size();
+
+	if (bWithParameters)
+	{
+		while (iOptionalFrom > 0 && IsParameter(Parts[iOptionalFrom - 1]))
+		{
+			--iOptionalFrom;
+		}
+	}
+
+	std::size_t iNode { 0 };
+
+	for (std::size_t iPart = 0; iPart < Parts.size(); ++iPart)
+	{
+		const auto& sPart = Parts[iPart];
+		std::size_t iChild;
+
+		if (sPart == "*" || (bWithParameters && IsParameter(sPart)))
+		{
+			iChild = m_Nodes[iNode].iAny;
+
+			if (iChild == npos)
+			{
+				iChild = m_Nodes.size();
+				m_Nodes[iNode].iAny = iChild;
+				m_Nodes.emplace_back();
+			}
+		}
+		else
+		{
+			auto iHash = KStringView(sPart).Hash();
+			auto it    = m_Nodes[iNode].Literals.find(iHash);
+
+			if (it == m_Nodes[iNode].Literals.end())
+			{
+				iChild = m_Nodes.size();
+				m_Nodes[iNode].Literals.emplace(iHash, iChild);
+				m_Nodes.emplace_back();
+			}
+			else
+			{
+				iChild = it->second;
+			}
+		}
+
+		iNode = iChild;
+
+		// an empty path never matches a partwise route, therefore the
+		// root never gets a route
+		if (iPart + 1 >= iOptionalFrom)
+		{
+			m_Nodes[iNode].Routes.push_back(iRoute);
+		}
+	}
+
+} // Add
+
+//-----------------------------------------------------------------------------
+void KHTTPRouteIndex::Collect(const KHTTPPath::URLParts& Parts, std::size_t iPart, std::size_t iNode, Candidates& Found) const
+//-----------------------------------------------------------------------------
+{
+	const auto& Node = m_Nodes[iNode];
+
+	if (iPart == Parts.size())
+	{
+		Found.insert(Found.end(), Node.Routes.begin(), Node.Routes.end());
+		return;
+	}
+
+	if (!Node.Literals.empty())
+	{
+		auto it = Node.Literals.find(KStringView(Parts[iPart]).Hash());
+
+		if (it != Node.Literals.end())
+		{
+			Collect(Parts, iPart + 1, it->second, Found);
+		}
+	}
+
+	if (Node.iAny != npos)
+	{
+		Collect(Parts, iPart + 1, Node.iAny, Found);
+	}
+
+} // Collect
+
+//-----------------------------------------------------------------------------
+void KHTTPRouteIndex::FindCandidates(const KHTTPPath& Path, Candidates& Found) const
+//-----------------------------------------------------------------------------
+{
+	Found.clear();
+
+	KStringView sPath = Path.sRoute;
+
+	if (!m_Exact.empty())
+	{
+		auto it = m_Exact.find(sPath.Hash());
+
+		if (it != m_Exact.end())
+		{
+			Found.insert(Found.end(), it->second.begin(), it->second.end());
+		}
+	}
+
+	if (!m_Prefix.empty())
+	{
+		// a wildcard route matches all paths that start with it, up to a part boundary
+		for (std::size_t iSize = 0; iSize <= sPath.size(); ++iSize)
+		{
+			if (iSize == sPath.size() || sPath[iSize] == '/')
+			{
+				auto it = m_Prefix.find(sPath.substr(0, iSize).Hash());
+
+				if (it != m_Prefix.end())
+				{
+					Found.insert(Found.end(), it->second.begin(), it->second.end());
+				}
+			}
+		}
+	}
+
+	if (!m_Nodes.empty() && !Path.vURLParts.empty())
+	{
+		Collect(Path.vURLParts, 0, 0, Found);
+	}
+
+	if (Found.size() > 1)
+	{
+		std::sort(Found.begin(), Found.end());
+		Found.erase(std::unique(Found.begin(), Found.end()), Found.end());
+	}
+
+} // FindCandidates
+
+//-----------------------------------------------------------------------------
+void KHTTPRouteIndex::clear()
+//-----------------------------------------------------------------------------
+{
+	m_Exact.clear();
+	m_Prefix.clear();
+	m_Nodes.clear();
+
+} // clear
+
 } // end of namespace detail
 
 
@@ -42,6 +42,7 @@
 #pragma once
 
 #include <vector>
+#include <unordered_map>
 #include <dekaf2/core/strings/kstring.h>
 #include <dekaf2/core/strings/kstringview.h>
 #include <dekaf2/time/duration/kduration.h>
@@ -130,6 +131,74 @@ public:
 
 }; // KHTTPAnalyzedPath
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+/// A compiled index over a table of analyzed paths, to avoid a linear scan over all
+/// routes for each request. Plain routes are found by a hash lookup of the full path
+/// or of its prefixes, routes with wildcard fragments or parameters by a segment trie.
+/// The index only preselects: it returns the table positions of all routes that may
+/// match, in ascending order - the caller then runs the route's own Matches() on them,
+/// which keeps the first-match precedence and all method checks of the linear scan.
+class DEKAF2_PUBLIC KHTTPRouteIndex
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+{
+
+//------
+public:
+//------
+
+	using Candidates = std::vector<std::size_t>;
+
+	//-----------------------------------------------------------------------------
+	/// Add a route to the index
+	/// @param iRoute the position of the route in the route table
+	/// @param Route the route
+	/// @param bPartwise true if the route is matched part by part, false if it is matched
+	/// as a plain string (with an optional wildcard at the end)
+	/// @param bWithParameters true if parts starting with : or = are parameters, which
+	/// match any part, and may be missing at the end of the path
+	void Add(std::size_t iRoute, const KHTTPAnalyzedPath& Route, bool bPartwise, bool bWithParameters);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// Collect the positions of all routes that may match the path
+	/// @param Path the request path
+	/// @param Found receives the route positions in ascending order, is cleared first
+	void FindCandidates(const KHTTPPath& Path, Candidates& Found) const;
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// Remove all routes from the index
+	void clear();
+	//-----------------------------------------------------------------------------
+
+//------
+private:
+//------
+
+	static constexpr std::size_t npos = std::size_t(-1);
+
+	struct Node
+	{
+		std::unordered_map<std::size_t, std::size_t> Literals; ///< part hash -> child node
+		std::size_t                                  iAny { npos }; ///< child for wildcards and parameters
+		Candidates                                   Routes;   ///< routes that match a path ending here
+	};
+
+	using HashedRoutes = std::unordered_map<std::size_t, Candidates>;
+
+	//-----------------------------------------------------------------------------
+	DEKAF2_PRIVATE
+	void Collect(const KHTTPPath::URLParts& Parts, std::size_t iPart, std::size_t iNode, Candidates& Found) const;
+	//-----------------------------------------------------------------------------
+
+	// all keys are hashes: a collision only adds a candidate, which is then
+	// rejected by the route's Matches()
+	HashedRoutes      m_Exact;   ///< plain routes
+	HashedRoutes      m_Prefix;  ///< plain routes with a wildcard at the end
+	std::vector<Node> m_Nodes;   ///< the segment trie, the first node is the root
+
+}; // KHTTPRouteIndex
+
 } // end of namespace detail
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
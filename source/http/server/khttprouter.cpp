@@ -171,6 +171,7 @@ void KHTTPRoute::WebServer(KHTTPRouter& HTTP)
 bool KHTTPRoutes::AddRoute(KHTTPRoute _Route)
 //-----------------------------------------------------------------------------
 {
+	m_Index.Add(m_Routes.size(), _Route, _Route.m_bHasWildCardFragment, false);
 	m_Routes.push_back(std::move(_Route));
 	return true;
 
@@ -189,6 +190,7 @@ void KHTTPRoutes::clear()
 //-----------------------------------------------------------------------------
 {
 	m_Routes.clear();
+	m_Index.clear();
 	m_DefaultRoute.Callback = nullptr;
 
 } // clear
@@ -199,8 +201,15 @@ const KHTTPRoute& KHTTPRoutes::FindRoute(const KHTTPPath& Path) const
 {
 	kDebug (2, "looking up: {}" , Path.sRoute);
 
-	for (const auto& it : m_Routes)
+	// the index preselects the routes that could match the path, in the order
+	// of their registration
+	detail::KHTTPRouteIndex::Candidates Candidates;
+	m_Index.FindCandidates(Path, Candidates);
+
+	for (auto iRoute : Candidates)
 	{
+		const auto& it = m_Routes[iRoute];
+
 		kDebug (3, "evaluating: {}", it.sRoute);
 		if (it.Matches(Path))
 		{
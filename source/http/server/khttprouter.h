@@ -150,7 +150,8 @@ private:
 	using Routes = std::vector<KHTTPRoute>;
 
 	Routes     m_Routes;
-	KHTTPRoute m_DefaultRoute;
+	detail::KHTTPRouteIndex m_Index;
+	KHTTPRoute m_DefaultRoute { KString{}, KString{}, nullptr };
 
 }; // KHTTPRoutes
 
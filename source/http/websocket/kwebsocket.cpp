@@ -51,6 +51,20 @@
 #include <dekaf2/core/strings/ksplit.h>
 #include <zlib.h>
 #include <algorithm>
+#include <array>
+#include <cstring>
+
+#if defined(__SSE2__) || (defined(DEKAF2_IS_MSC) && defined(DEKAF2_X86_64))
+	#define DEKAF2_WEBSOCKET_SSE2 1
+	#include <emmintrin.h>
+	#if defined(__AVX2__)
+		#define DEKAF2_WEBSOCKET_AVX2 1
+		#include <immintrin.h>
+	#endif
+#elif defined(DEKAF2_ARM64) && (defined(__ARM_NEON) || defined(_M_ARM64))
+	#define DEKAF2_WEBSOCKET_NEON 1
+	#include <arm_neon.h>
+#endif
 
 DEKAF2_NAMESPACE_BEGIN
 namespace {
@@ -69,6 +83,91 @@ uint8_t ClampWindowBits(uint8_t iBits)
 	return iBits;
 }
 
+// XOR a buffer in place with the 4 byte masking key (RFC 6455 section 5.3). All
+// block sizes are multiples of 4, so the mask stays in phase from block to block
+// down to the byte-wise tail.
+void ApplyMask(uint8_t* pBuf, std::size_t iSize, uint32_t iMaskingKey)
+{
+	// the mask in wire order, repeated to fill 8 bytes
+	const std::array<uint8_t, 8> Pattern
+	{
+		static_cast<uint8_t>(iMaskingKey >> 24),
+		static_cast<uint8_t>(iMaskingKey >> 16),
+		static_cast<uint8_t>(iMaskingKey >>  8),
+		static_cast<uint8_t>(iMaskingKey >>  0),
+		static_cast<uint8_t>(iMaskingKey >> 24),
+		static_cast<uint8_t>(iMaskingKey >> 16),
+		static_cast<uint8_t>(iMaskingKey >>  8),
+		static_cast<uint8_t>(iMaskingKey >>  0)
+	};
+
+	uint64_t iMask64;
+	std::memcpy(&iMask64, Pattern.data(), sizeof(iMask64));
+
+#ifdef DEKAF2_WEBSOCKET_AVX2
+	const __m256i Mask256 = _mm256_set1_epi64x(static_cast<int64_t>(iMask64));
+
+	for (; iSize >= 64; iSize -= 64, pBuf += 64)
+	{
+		auto p = reinterpret_cast<__m256i*>(pBuf);
+		_mm256_storeu_si256(p    , _mm256_xor_si256(_mm256_loadu_si256(p    ), Mask256));
+		_mm256_storeu_si256(p + 1, _mm256_xor_si256(_mm256_loadu_si256(p + 1), Mask256));
+	}
+#endif
+
+#ifdef DEKAF2_WEBSOCKET_SSE2
+	const __m128i Mask128 = _mm_set1_epi64x(static_cast<int64_t>(iMask64));
+
+	for (; iSize >= 64; iSize -= 64, pBuf += 64)
+	{
+		auto p = reinterpret_cast<__m128i*>(pBuf);
+		_mm_storeu_si128(p    , _mm_xor_si128(_mm_loadu_si128(p    ), Mask128));
+		_mm_storeu_si128(p + 1, _mm_xor_si128(_mm_loadu_si128(p + 1), Mask128));
+		_mm_storeu_si128(p + 2, _mm_xor_si128(_mm_loadu_si128(p + 2), Mask128));
+		_mm_storeu_si128(p + 3, _mm_xor_si128(_mm_loadu_si128(p + 3), Mask128));
+	}
+
+	for (; iSize >= 16; iSize -= 16, pBuf += 16)
+	{
+		auto p = reinterpret_cast<__m128i*>(pBuf);
+		_mm_storeu_si128(p, _mm_xor_si128(_mm_loadu_si128(p), Mask128));
+	}
+#elif defined(DEKAF2_WEBSOCKET_NEON)
+	const uint8x16_t Mask128 = vreinterpretq_u8_u64(vdupq_n_u64(iMask64));
+
+	for (; iSize >= 64; iSize -= 64, pBuf += 64)
+	{
+		vst1q_u8(pBuf     , veorq_u8(vld1q_u8(pBuf     ), Mask128));
+		vst1q_u8(pBuf + 16, veorq_u8(vld1q_u8(pBuf + 16), Mask128));
+		vst1q_u8(pBuf + 32, veorq_u8(vld1q_u8(pBuf + 32), Mask128));
+		vst1q_u8(pBuf + 48, veorq_u8(vld1q_u8(pBuf + 48), Mask128));
+	}
+
+	for (; iSize >= 16; iSize -= 16, pBuf += 16)
+	{
+		vst1q_u8(pBuf, veorq_u8(vld1q_u8(pBuf), Mask128));
+	}
+#endif
+
+	for (; iSize >= 8; iSize -= 8, pBuf += 8)
+	{
+		uint64_t iWord;
+		std::memcpy(&iWord, pBuf, sizeof(iWord));
+		iWord ^= iMask64;
+		std::memcpy(pBuf, &iWord, sizeof(iWord));
+	}
+
+	for (std::size_t i = 0; i < iSize; ++i)
+	{
+		pBuf[i] ^= Pattern[i];
+	}
+
+} // ApplyMask
+
+#undef DEKAF2_WEBSOCKET_SSE2
+#undef DEKAF2_WEBSOCKET_AVX2
+#undef DEKAF2_WEBSOCKET_NEON
+
 } // end of anonymous namespace
 
 //:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -390,6 +489,106 @@ void KWebSocket::FrameHeader::SetOpcodeAndFin(FrameType Opcode, bool bIsFin)
 
 } // SetOpcode
 
+//-----------------------------------------------------------------------------
+void KWebSocket::FrameHeader::AdjustPayloadLen()
+//-----------------------------------------------------------------------------
+{
+	// if we have an encoder we first read the whole payload to decode it
+	// and later split it in preamble and data, if needed
+	if (!m_bHaveEncoder && (m_Opcode == FrameType::Text || m_Opcode == FrameType::Binary))
+	{
+		auto iPreambleSize = GetPreambleSize();
+
+		if (m_iPayloadLen >= iPreambleSize)
+		{
+			m_iPayloadLen -= iPreambleSize;
+		}
+		else
+		{
+			kDebug(1, "preamble len {} > payload len {}", iPreambleSize, m_iPayloadLen);
+			m_iPayloadLen = 0;
+		}
+	}
+
+} // AdjustPayloadLen
+
+//-----------------------------------------------------------------------------
+std::size_t KWebSocket::FrameHeader::GetHeaderSize(uint8_t iSecondByte)
+//-----------------------------------------------------------------------------
+{
+	std::size_t iSize = 2;
+
+	switch (iSecondByte & 0x7f)
+	{
+		case 126: iSize += 2; break;
+		case 127: iSize += 8; break;
+		default:              break;
+	}
+
+	if (iSecondByte & 0x80)
+	{
+		// the masking key
+		iSize += 4;
+	}
+
+	return iSize;
+
+} // GetHeaderSize
+
+//-----------------------------------------------------------------------------
+std::size_t KWebSocket::FrameHeader::DecodeHeader(KStringView sBuffer)
+//-----------------------------------------------------------------------------
+{
+	// see Decode(uint8_t) for the header layout
+	if (sBuffer.size() < 2)
+	{
+		return 0;
+	}
+
+	auto p = reinterpret_cast<const uint8_t*>(sBuffer.data());
+
+	auto iHeaderSize = GetHeaderSize(p[1]);
+
+	if (sBuffer.size() < iHeaderSize)
+	{
+		return 0;
+	}
+
+	m_bIsFin      = (p[0] & 0x80);
+	m_iExtension  = (p[0] & 0x70) >> 4;
+	m_Opcode      = static_cast<FrameType>((p[0] & 0x0f));
+	m_bMask       = (p[1] & 0x80);
+	m_iPayloadLen = (p[1] & 0x7f);
+
+	p += 2;
+
+	if (m_iPayloadLen >= 126)
+	{
+		auto iBytes   = (m_iPayloadLen == 126) ? 2 : 8;
+		m_iPayloadLen = 0;
+
+		for (int i = 0; i < iBytes; ++i)
+		{
+			m_iPayloadLen <<= 8;
+			m_iPayloadLen  |= *p++;
+		}
+	}
+
+	if (m_bMask)
+	{
+		m_iMaskingKey = (static_cast<uint32_t>(p[0]) << 24)
+		              | (static_cast<uint32_t>(p[1]) << 16)
+		              | (static_cast<uint32_t>(p[2]) <<  8)
+		              | (static_cast<uint32_t>(p[3]) <<  0);
+	}
+
+	m_iFramePos = 0;
+	AdjustPayloadLen();
+
+	return iHeaderSize;
+
+} // DecodeHeader
+
 //-----------------------------------------------------------------------------
 bool KWebSocket::FrameHeader::Decode(uint8_t byte)
 //-----------------------------------------------------------------------------
@@ -417,26 +616,6 @@ bool KWebSocket::FrameHeader::Decode(uint8_t byte)
 
  */
 
-	auto AdjustLen = [this]()
-	{
-		// if we have an encoder we first read the whole payload to decode it
-		// and later split it in preamble and data, if needed
-		if (!m_bHaveEncoder && (m_Opcode == FrameType::Text || m_Opcode == FrameType::Binary))
-		{
-			auto iPreambleSize = GetPreambleSize();
-
-			if (m_iPayloadLen >= iPreambleSize)
-			{
-				m_iPayloadLen -= iPreambleSize;
-			}
-			else
-			{
-				kDebug(1, "preamble len {} > payload len {}", iPreambleSize, m_iPayloadLen);
-				m_iPayloadLen = 0;
-			}
-		}
-	};
-
 	switch (m_iFramePos & 0x7f)
 	{
 		case 0: // the start
@@ -455,7 +634,7 @@ bool KWebSocket::FrameHeader::Decode(uint8_t byte)
 				{
 					// we're done
 					m_iFramePos = 0;
-					AdjustLen();
+					AdjustPayloadLen();
 					return true;
 				}
 				else
@@ -489,7 +668,7 @@ bool KWebSocket::FrameHeader::Decode(uint8_t byte)
 				{
 					// we're done
 					m_iFramePos = 0;
-					AdjustLen();
+					AdjustPayloadLen();
 					return true;
 				}
 				else
@@ -517,7 +696,7 @@ bool KWebSocket::FrameHeader::Decode(uint8_t byte)
 			{
 				// we're done
 				m_iFramePos = 0;
-				AdjustLen();
+				AdjustPayloadLen();
 				return true;
 			}
 			break;
@@ -537,7 +716,7 @@ bool KWebSocket::FrameHeader::Decode(uint8_t byte)
 			m_iMaskingKey  |= byte;
 			// we're done
 			m_iFramePos = 0;
-			AdjustLen();
+			AdjustPayloadLen();
 			return true;
 
 		default:
@@ -553,18 +732,24 @@ bool KWebSocket::FrameHeader::Decode(uint8_t byte)
 bool KWebSocket::FrameHeader::Read(KInStream& Stream)
 //-----------------------------------------------------------------------------
 {
-	for (;;)
+	// read the fixed part of the header, which tells the size of the rest,
+	// then read the rest in one go and decode the whole header at once
+	std::array<char, 14> Header;
+
+	if (Stream.Read(Header.data(), 2) != 2)
 	{
-		if (!Stream.Good())
-		{
-			return false;
-		}
-		if (Decode(Stream.Read()))
-		{
-			return true;
-		}
+		return false;
+	}
+
+	auto iHeaderSize = GetHeaderSize(static_cast<uint8_t>(Header[1]));
+
+	if (iHeaderSize > 2 && Stream.Read(Header.data() + 2, iHeaderSize - 2) != iHeaderSize - 2)
+	{
+		return false;
 	}
 
+	return DecodeHeader(KStringView(Header.data(), iHeaderSize)) == iHeaderSize;
+
 } // Read
 
 //-----------------------------------------------------------------------------
@@ -713,44 +898,7 @@ void KWebSocket::FrameHeader::XOR(void* pBuffer, std::size_t iSize) const
 	{
 		kDebug(3, "applying mask {:#08x} on buffer of size {}", m_iMaskingKey, iSize);
 
-		std::array<uint8_t, 4> Mask
-		{
-			static_cast<uint8_t>(m_iMaskingKey >> 24),
-			static_cast<uint8_t>(m_iMaskingKey >> 16),
-			static_cast<uint8_t>(m_iMaskingKey >>  8),
-			static_cast<uint8_t>(m_iMaskingKey >>  0)
-		};
-
-		uint8_t* pBuf = static_cast<uint8_t*>(pBuffer);
-
-		for (; iSize >= 4; iSize -= 4)
-		{
-			*pBuf++ ^= Mask[0];
-			*pBuf++ ^= Mask[1];
-			*pBuf++ ^= Mask[2];
-			*pBuf++ ^= Mask[3];
-		}
-
-		switch (iSize)
-		{
-			case 3:
-				*pBuf++ ^= Mask[0];
-				*pBuf++ ^= Mask[1];
-				*pBuf++ ^= Mask[2];
-				break;
-
-			case 2:
-				*pBuf++ ^= Mask[0];
-				*pBuf++ ^= Mask[1];
-				break;
-
-			case 1:
-				*pBuf++ ^= Mask[0];
-				break;
-
-			default:
-				break;
-		}
+		ApplyMask(static_cast<uint8_t*>(pBuffer), iSize, m_iMaskingKey);
 	}
 
 } // XOR
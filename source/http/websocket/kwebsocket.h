@@ -246,6 +246,13 @@ public:
 		/// decode a websocket frame header step by step
 		/// @return false until full header has been decoded
 		bool        Decode          (uint8_t byte);
+		/// decode a complete websocket frame header in one step
+		/// @param sBuffer a buffer starting with the frame header, may also contain the payload
+		/// @return the size of the decoded header, or 0 if the buffer does not hold the full header yet
+		std::size_t DecodeHeader    (KStringView sBuffer);
+		/// @return the full size of a frame header (2 to 14 bytes), computed from its second byte
+		static
+		std::size_t GetHeaderSize   (uint8_t iSecondByte);
 		/// @return a string with the serialized header
 		KString     Serialize       ()             const;
 		/// @return the frame type (Text, Binary, Ping, Pong, Continuation, Close)
@@ -324,6 +331,9 @@ public:
 	private:
 	//----------
 
+		/// subtracts the preamble size from the payload length, if the preamble is read separately
+		void      AdjustPayloadLen  ();
+
 		uint64_t  m_iPayloadLen     { 0 };
 		uint32_t  m_iMaskingKey     { 0 };
 		uint16_t  m_iStatusCode     { 0 }; // will be set with a Close frame
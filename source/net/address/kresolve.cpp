@@ -42,9 +42,14 @@
 
 #include <dekaf2/net/address/kresolve.h>
 #include <dekaf2/net/address/kipaddress.h>
+#include <dekaf2/net/address/kresolvercache.h>
 #include <dekaf2/net/tcp/bits/kasio.h>
 #include <dekaf2/net/util/kiostreamsocket.h>
+#include <dekaf2/io/readwrite/kreader.h>
 #include <dekaf2/core/logging/klog.h>
+#include <deque>
+#include <memory>
+#include <shared_mutex>
 #include <unordered_map>
 
 DEKAF2_NAMESPACE_BEGIN
@@ -53,7 +58,121 @@ namespace KResolve {
 
 namespace {
 
-std::unordered_map<KString, std::pair<KString, bool>> g_KnownHosts;
+struct KnownHost
+{
+	const KString* pIPv4       { nullptr };
+	const KString* pIPv6       { nullptr };
+	bool           bLastIsIPv6 { false   };
+};
+
+struct KnownHosts
+{
+	std::shared_mutex                      Mutex;
+	std::unordered_map<KString, KnownHost> Hosts;
+	/// append only - GetKnownHostAddress() returns views on the addresses,
+	/// therefore they are never moved or freed
+	std::deque<KString>                    Addresses;
+};
+
+//-----------------------------------------------------------------------------
+KnownHosts& GetKnownHosts()
+//-----------------------------------------------------------------------------
+{
+	static KnownHosts s_KnownHosts;
+	return s_KnownHosts;
+
+} // GetKnownHosts
+
+//-----------------------------------------------------------------------------
+bool AddKnownHost(KStringView sHostname, KStringView sIPAddress, bool bReplace)
+//-----------------------------------------------------------------------------
+{
+	bool bIsIPv6 { false };
+
+	if (kIsIPv6Address(sIPAddress, true))
+	{
+		// this is an ip v6 numeric address - get rid of the []
+		sIPAddress = sIPAddress.ToView(1, sIPAddress.size() - 2);
+		bIsIPv6 = true;
+	}
+	else if (kIsIPv6Address(sIPAddress, false))
+	{
+		bIsIPv6 = true;
+	}
+
+	auto& Known = GetKnownHosts();
+
+	std::unique_lock<std::shared_mutex> Lock(Known.Mutex);
+
+	auto& Host     = Known.Hosts[sHostname];
+	auto& pAddress = bIsIPv6 ? Host.pIPv6 : Host.pIPv4;
+
+	if (pAddress && (!bReplace || *pAddress == sIPAddress))
+	{
+		return false;
+	}
+
+	Known.Addresses.push_back(sIPAddress);
+
+	pAddress         = &Known.Addresses.back();
+	Host.bLastIsIPv6 = bIsIPv6;
+
+	kDebug(2, "added known host: {} -> {}", sHostname, sIPAddress);
+
+	return true;
+
+} // AddKnownHost
+
+//-----------------------------------------------------------------------------
+/// strips the [] from numeric IPv6 addresses, and maps known hosts to their addresses
+KStringView GetQueryName(KStringView sHostname, KStreamOptions::Family Family)
+//-----------------------------------------------------------------------------
+{
+	if (kIsIPv6Address(sHostname, true))
+	{
+		// this is an ip v6 numeric address - get rid of the []
+		return sHostname.ToView(1, sHostname.size() - 2);
+	}
+
+	return GetKnownHostAddress(sHostname, Family);
+
+} // GetQueryName
+
+//-----------------------------------------------------------------------------
+/// returns true if the name shall be resolved through the resolver cache
+bool UseResolverCache(KStringView sHostname)
+//-----------------------------------------------------------------------------
+{
+	// numeric addresses need no lookup
+	return KResolverCache::getInstance().IsEnabled()
+	    && !kIsIPv4Address(sHostname)
+	    && !kIsIPv6Address(sHostname, false);
+
+} // UseResolverCache
+
+//-----------------------------------------------------------------------------
+template<class Protocol, class Results>
+Results CreateCachedQuery(
+	KStringView sHostname,
+	uint16_t iPort,
+	KStreamOptions::Family Family,
+	boost::system::error_code& ec
+)
+//-----------------------------------------------------------------------------
+{
+	auto IPs = KResolverCache::getInstance().Get(sHostname, Family, ec);
+
+	std::vector<typename Protocol::endpoint> Endpoints;
+	Endpoints.reserve(IPs.size());
+
+	for (auto& IP : IPs)
+	{
+		Endpoints.emplace_back(IP, iPort);
+	}
+
+	return Results::create(Endpoints.begin(), Endpoints.end(), std::string(sHostname), KString::to_string(iPort));
+
+} // CreateCachedQuery
 
 //-----------------------------------------------------------------------------
 resolver_results_tcp_type
@@ -68,8 +187,6 @@ CreateTCPQuery(
 {
 	boost::asio::ip::tcp::resolver Resolver(IOService);
 
-	sHostname = GetKnownHostAddress(sHostname, Family);
-
 	if (Family == KStreamOptions::Family::Any)
 	{
 #ifdef DEKAF2_CLASSIC_ASIO
@@ -147,8 +264,6 @@ CreateUDPQuery(
 {
 	boost::asio::ip::udp::resolver Resolver(IOService);
 
-	sHostname = GetKnownHostAddress(sHostname, Family);
-
 	if (Family == KStreamOptions::Family::Any)
 	{
 #ifdef DEKAF2_CLASSIC_ASIO
@@ -228,15 +343,11 @@ ResolveTCP(
 {
 	kDebug (3, "resolving domain {}", sHostname);
 
-	KStringView sIPAddress;
+	auto sName = GetQueryName(sHostname, Family);
 
-	if (kIsIPv6Address(sHostname, true))
-	{
-		// this is an ip v6 numeric address - get rid of the []
-		sIPAddress = sHostname.ToView(1, sHostname.size() - 2);
-	}
-
-	auto Hosts = CreateTCPQuery(IOService, sIPAddress.empty() ? sHostname : sIPAddress, KString::to_string(iPort), Family, ec);
+	auto Hosts = UseResolverCache(sName)
+	           ? CreateCachedQuery<boost::asio::ip::tcp, resolver_results_tcp_type>(sName, iPort, Family, ec)
+	           : CreateTCPQuery(IOService, sName, KString::to_string(iPort), Family, ec);
 
 #ifdef DEKAF2_WITH_KLOG
 	if (kWouldLog(2))
@@ -277,15 +388,11 @@ ResolveUDP(
 {
 	kDebug (3, "resolving domain {}", sHostname);
 
-	KStringView sIPAddress;
+	auto sName = GetQueryName(sHostname, Family);
 
-	if (kIsIPv6Address(sHostname, true))
-	{
-		// this is an ip v6 numeric address - get rid of the []
-		sIPAddress = sHostname.ToView(1, sHostname.size() - 2);
-	}
-
-	auto Hosts = CreateUDPQuery(IOService, sIPAddress.empty() ? sHostname : sIPAddress, KString::to_string(iPort), Family, ec);
+	auto Hosts = UseResolverCache(sName)
+	           ? CreateCachedQuery<boost::asio::ip::udp, resolver_results_udp_type>(sName, iPort, Family, ec)
+	           : CreateUDPQuery(IOService, sName, KString::to_string(iPort), Family, ec);
 
 #ifdef DEKAF2_WITH_KLOG
 	if (kWouldLog(2))
@@ -456,50 +563,312 @@ KString PrintResolvedAddress(const resolver_endpoint_tcp_type& endpoint)
 void AddKnownHostAddress(KStringView sHostname, KStringView sIPAddress)
 //-----------------------------------------------------------------------------
 {
-	bool bIsIPv6 { false };
+	AddKnownHost(sHostname, sIPAddress, true);
 
-	if (kIsIPv6Address(sIPAddress, true))
+} // AddKnownHostAddress
+
+//-----------------------------------------------------------------------------
+KStringView GetKnownHostAddress(KStringView sHostname, KStreamOptions::Family Family)
+//-----------------------------------------------------------------------------
+{
+	auto& Known = GetKnownHosts();
+
+	std::shared_lock<std::shared_mutex> Lock(Known.Mutex);
+
+	auto it = Known.Hosts.find(sHostname);
+
+	if (it != Known.Hosts.end())
 	{
-		// this is an ip v6 numeric address - get rid of the []
-		sIPAddress = sIPAddress.ToView(1, sIPAddress.size() - 2);
-		bIsIPv6 = true;
+		const KString* pAddress { nullptr };
+
+		switch (Family)
+		{
+			case KStreamOptions::Family::Any:
+				pAddress = it->second.bLastIsIPv6 ? it->second.pIPv6 : it->second.pIPv4;
+				break;
+
+			case KStreamOptions::Family::IPv4:
+				pAddress = it->second.pIPv4;
+				break;
+
+			case KStreamOptions::Family::IPv6:
+				pAddress = it->second.pIPv6;
+				break;
+		}
+
+		if (pAddress)
+		{
+			kDebug(2, "resolving from known hosts: {} -> {}", sHostname, *pAddress);
+			return *pAddress;
+		}
 	}
-	else if (kIsIPv6Address(sIPAddress, false))
+
+	return sHostname;
+
+} // GetKnownHostAddress
+
+//-----------------------------------------------------------------------------
+std::size_t LoadKnownHosts(KStringViewZ sFileName)
+//-----------------------------------------------------------------------------
+{
+	KInFile InFile(sFileName);
+
+	if (!InFile.is_open())
 	{
-		bIsIPv6 = true;
+		kDebug(1, "cannot open hosts file: {}", sFileName);
+		return 0;
 	}
 
-	auto p = g_KnownHosts.insert({ sHostname, { sIPAddress, bIsIPv6 } });
+	std::size_t iAdded { 0 };
 
-	if (!p.second)
+	for (auto& sLine : InFile)
 	{
-		p.first->second = { sIPAddress, bIsIPv6 };
+		auto iComment = sLine.find('#');
+
+		if (iComment != KString::npos)
+		{
+			sLine.erase(iComment);
+		}
+
+		sLine.Replace('\t', ' ');
+
+		// address, followed by one or more host names
+		auto Fields = sLine.Split(' ');
+
+		if (Fields.size() < 2)
+		{
+			continue;
+		}
+
+		if (!kIsIPv4Address(Fields[0]) && !kIsIPv6Address(Fields[0], false))
+		{
+			kDebug(2, "invalid address in hosts file {}: {}", sFileName, Fields[0]);
+			continue;
+		}
+
+		for (std::size_t i = 1; i < Fields.size(); ++i)
+		{
+			if (AddKnownHost(Fields[i], Fields[0], false))
+			{
+				++iAdded;
+			}
+		}
 	}
 
-	kDebug(2, "added known host: {} -> {}", sHostname, sIPAddress);
+	kDebug(2, "added {} known hosts from {}", iAdded, sFileName);
 
-} // AddKnownHostAddress
+	return iAdded;
 
-//-----------------------------------------------------------------------------
-KStringView GetKnownHostAddress(KStringView sHostname, KStreamOptions::Family Family)
-//-----------------------------------------------------------------------------
+} // LoadKnownHosts
+
+#if !(DEKAF2_CLASSIC_ASIO)
+namespace {
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+/// the state of one happy eyeballs connect, kept alive by its pending handlers
+class HappyEyeballs : public std::enable_shared_from_this<HappyEyeballs>
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 {
-	auto it = g_KnownHosts.find(sHostname);
 
-	if (it != g_KnownHosts.end())
+//------
+public:
+//------
+
+	using endpoint_type = boost::asio::ip::tcp::endpoint;
+	using socket_type   = boost::asio::ip::tcp::socket;
+
+	//-----------------------------------------------------------------------------
+	HappyEyeballs(tcp_socket_type& Socket, const resolver_results_tcp_type& Hosts, connect_handler_type Handler, KDuration AttemptDelay)
+	//-----------------------------------------------------------------------------
+	: m_Socket       (Socket)
+	, m_Delay        (Socket.get_executor())
+	, m_Deadline     (Socket.get_executor())
+	, m_Handler      (std::move(Handler))
+	, m_AttemptDelay (AttemptDelay)
 	{
-		if ( Family == KStreamOptions::Family::Any ||
-			(Family == KStreamOptions::Family::IPv4 && !it->second.second) ||
-			(Family == KStreamOptions::Family::IPv4 &&  it->second.second))
+		// interleave the address families, starting with the family of the first address
+		std::vector<endpoint_type> First, Second;
+
+		for (const auto& Host : Hosts)
+		{
+			auto& Family = (First.empty() || First.front().address().is_v6() == Host.endpoint().address().is_v6()) ? First : Second;
+			Family.push_back(Host.endpoint());
+		}
+
+		m_Endpoints.reserve(First.size() + Second.size());
+
+		for (std::size_t i = 0; i < std::max(First.size(), Second.size()); ++i)
 		{
-			kDebug(2, "resolving from known hosts: {} -> {}", sHostname, it->second.first);
-			return it->second.first;
+			if (i < First.size ()) m_Endpoints.push_back(First [i]);
+			if (i < Second.size()) m_Endpoints.push_back(Second[i]);
 		}
+
+		m_Attempts.resize(m_Endpoints.size());
 	}
 
-	return sHostname;
+	//-----------------------------------------------------------------------------
+	void Start(KDuration Timeout)
+	//-----------------------------------------------------------------------------
+	{
+		if (m_Endpoints.empty())
+		{
+			// like boost::asio::async_connect(), never call the handler from within the initiation
+			boost::asio::post(m_Socket.get_executor(), [self = shared_from_this()]()
+			{
+				self->Finish(boost::asio::error::not_found);
+			});
+			return;
+		}
 
-} // GetKnownHostAddress
+		if (Timeout > KDuration::zero())
+		{
+			m_Deadline.expires_after(Timeout.milliseconds());
+			m_Deadline.async_wait([self = shared_from_this()](const boost::system::error_code& ec)
+			{
+				if (!ec && !self->m_bDone)
+				{
+					kDebug(2, "connect timeout, canceling {} pending attempts", self->m_iPending);
+					self->Finish(boost::asio::error::timed_out);
+				}
+			});
+		}
+
+		StartNext();
+	}
+
+//------
+private:
+//------
+
+	//-----------------------------------------------------------------------------
+	void StartNext()
+	//-----------------------------------------------------------------------------
+	{
+		if (m_iNext >= m_Endpoints.size())
+		{
+			return;
+		}
+
+		auto i = m_iNext++;
+
+		kDebug(3, "connection attempt {} to {}", i + 1, PrintResolvedAddress(m_Endpoints[i]));
+
+		m_Attempts[i] = std::make_unique<socket_type>(m_Socket.get_executor());
+		++m_iPending;
+
+		m_Attempts[i]->async_connect(m_Endpoints[i], [self = shared_from_this(), i](const boost::system::error_code& ec)
+		{
+			self->Connected(i, ec);
+		});
+
+		if (m_iNext < m_Endpoints.size())
+		{
+			// start the next attempt in parallel if this one takes too long -
+			// setting the expiry cancels the wait for the previous attempt
+			m_Delay.expires_after(m_AttemptDelay.milliseconds());
+			m_Delay.async_wait([self = shared_from_this()](const boost::system::error_code& ec)
+			{
+				if (!ec && !self->m_bDone)
+				{
+					self->StartNext();
+				}
+			});
+		}
+	}
+
+	//-----------------------------------------------------------------------------
+	void Connected(std::size_t i, const boost::system::error_code& ec)
+	//-----------------------------------------------------------------------------
+	{
+		--m_iPending;
+
+		if (m_bDone)
+		{
+			// a late attempt, already closed
+			return;
+		}
+
+		if (!ec)
+		{
+			boost::system::error_code ignored;
+			m_Socket.close(ignored);
+			m_Socket = std::move(*m_Attempts[i]);
+			Finish(ec, m_Endpoints[i]);
+			return;
+		}
+
+		kDebug(2, "cannot connect to {}: {}", PrintResolvedAddress(m_Endpoints[i]), ec.message());
+
+		m_ec = ec;
+		m_Attempts[i].reset();
+
+		if (m_iNext < m_Endpoints.size())
+		{
+			// do not wait for the attempt delay after a failure
+			StartNext();
+		}
+		else if (!m_iPending)
+		{
+			Finish(m_ec);
+		}
+	}
+
+	//-----------------------------------------------------------------------------
+	void Finish(const boost::system::error_code& ec, const endpoint_type& Endpoint = endpoint_type{})
+	//-----------------------------------------------------------------------------
+	{
+		m_bDone = true;
+
+		m_Delay.cancel();
+		m_Deadline.cancel();
+
+		for (auto& Attempt : m_Attempts)
+		{
+			if (Attempt)
+			{
+				boost::system::error_code ignored;
+				Attempt->close(ignored);
+			}
+		}
+
+		m_Handler(ec, Endpoint);
+	}
+
+	tcp_socket_type&                          m_Socket;
+	std::vector<endpoint_type>                m_Endpoints;
+	std::vector<std::unique_ptr<socket_type>> m_Attempts;
+	boost::asio::steady_timer                 m_Delay;
+	boost::asio::steady_timer                 m_Deadline;
+	connect_handler_type                      m_Handler;
+	boost::system::error_code                 m_ec;
+	KDuration                                 m_AttemptDelay;
+	std::size_t                               m_iNext    { 0 };
+	std::size_t                               m_iPending { 0 };
+	bool                                      m_bDone    { false };
+
+}; // HappyEyeballs
+
+} // end of anonymous namespace
+#endif
+
+//-----------------------------------------------------------------------------
+void AsyncConnect(
+	tcp_socket_type& Socket,
+	const resolver_results_tcp_type& Hosts,
+	KDuration Timeout,
+	connect_handler_type Handler,
+	KDuration AttemptDelay
+)
+//-----------------------------------------------------------------------------
+{
+#if (DEKAF2_CLASSIC_ASIO)
+	// classic asio connects sequentially, and the caller's timer limits the time
+	boost::asio::async_connect(Socket, Hosts, std::move(Handler));
+#else
+	std::make_shared<HappyEyeballs>(Socket, Hosts, std::move(Handler), AttemptDelay)->Start(Timeout);
+#endif
+
+} // AsyncConnect
 
 } // end of namespace KResolve
 
@@ -50,6 +50,8 @@
 #include <dekaf2/core/strings/bits/kstringviewz.h>
 #include <dekaf2/net/tcp/bits/kasio.h>
 #include <dekaf2/net/util/kstreamoptions.h>
+#include <dekaf2/time/duration/kduration.h>
+#include <functional>
 
 DEKAF2_NAMESPACE_BEGIN
 
@@ -108,8 +110,8 @@ namespace KResolve {
 #endif
 	);
 
-	/// add a hostname and its address to the list of known hosts (like /etc/hosts)
-	/// -this function is not thread safe, use it at init of program
+	/// add a hostname and its address to the list of known hosts (like /etc/hosts) - a host
+	/// can have one IPv4 and one IPv6 address, a new address replaces the one of the same family
 	void
 	AddKnownHostAddress(
 		KStringView sHostname,
@@ -118,7 +120,8 @@ namespace KResolve {
 
 	/// search for a hostname and its address in the list of known hosts (like /etc/hosts)
 	/// @param sHostname the hostname to look up
-	/// @param Family the address family searched for
+	/// @param Family the address family searched for - for Family::Any the address added last
+	/// is returned
 	/// @return the resolved IP address or the original hostname
 	KStringView
 	GetKnownHostAddress(
@@ -126,6 +129,44 @@ namespace KResolve {
 		KStreamOptions::Family Family
 	);
 
+	/// add all entries of a file in the format of /etc/hosts to the list of known hosts - the
+	/// first address of a family wins for a name, like in the system resolver
+	/// @param sFileName the hosts file
+	/// @return the count of added host names, or 0 if the file could not be read
+	std::size_t
+	LoadKnownHosts(
+		KStringViewZ sFileName
+	);
+
+#if (DEKAF2_CLASSIC_ASIO)
+	using tcp_socket_type      = boost::asio::basic_socket<boost::asio::ip::tcp, boost::asio::stream_socket_service<boost::asio::ip::tcp>>;
+	using connect_handler_type = std::function<void(const boost::system::error_code&, resolver_endpoint_tcp_type)>;
+#else
+	using tcp_socket_type      = boost::asio::basic_socket<boost::asio::ip::tcp>;
+	using connect_handler_type = std::function<void(const boost::system::error_code&, const resolver_endpoint_tcp_type&)>;
+#endif
+
+	/// connect a socket asynchronously to one of the resolved hosts, with "happy eyeballs"
+	/// (RFC 8305): the addresses are tried alternating between IPv6 and IPv4, starting with
+	/// the family of the first one, and if a connection attempt did not complete after
+	/// AttemptDelay the next one is started in parallel. The first established connection
+	/// wins, all others are closed. The handler is called from within the io_service of the
+	/// socket, with the connected endpoint, or with a default endpoint on error.
+	/// @param Socket the socket to connect
+	/// @param Hosts the resolved addresses, as returned by ResolveTCP()
+	/// @param Timeout the time after which all attempts are canceled with a timed_out error,
+	/// or zero for no timeout
+	/// @param Handler the completion handler
+	/// @param AttemptDelay the time to wait for an attempt before starting the next one in parallel
+	void
+	AsyncConnect(
+		tcp_socket_type& Socket,
+		const resolver_results_tcp_type& Hosts,
+		KDuration Timeout,
+		connect_handler_type Handler,
+		KDuration AttemptDelay = chrono::milliseconds(250)
+	);
+
 } // end of namespace KResolve
 
 /// Resolve the given hostname into either/or IPv4 IP addresses or IPv6 addresses.
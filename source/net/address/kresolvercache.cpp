@@ -0,0 +1,554 @@
+/*
+//
+// DEKAF(tm): Lighter, Faster, Smarter(tm)
+//
+// Copyright (c) 2026, Ridgeware, Inc.
+//
+// +-------------------------------------------------------------------------+
+// | /\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\|
+// |/+---------------------------------------------------------------------+/|
+// |/|                                                                     |/|
+// |\|  ** THIS NOTICE MUST NOT BE REMOVED FROM THE SOURCE CODE MODULE **  |\|
+// |/|                                                                     |/|
+// |\|   OPEN SOURCE LICENSE                                               |\|
+// |/|                                                                     |/|
+// |\|   Permission is hereby granted, free of charge, to any person       |\|
+// |/|   obtaining a copy of this software and associated                  |/|
+// |\|   documentation files (the "Software"), to deal in the              |\|
+// |/|   Software without restriction, including without limitation        |/|
+// |\|   the rights to use, copy, modify, merge, publish,                  |\|
+// |/|   distribute, sublicense, and/or sell copies of the Software,       |/|
+// |\|   and to permit persons to whom the Software is furnished to        |\|
+// |/|   do so, subject to the following conditions:                       |/|
+// |\|                                                                     |\|
+// |/|   The above copyright notice and this permission notice shall       |/|
+// |\|   be included in all copies or substantial portions of the          |\|
+// |/|   Software.                                                         |/|
+// |\|                                                                     |\|
+// |/|   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY         |/|
+// |\|   KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE        |\|
+// |/|   WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR           |/|
+// |\|   PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS        |\|
+// |/|   OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR          |/|
+// |\|   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR        |\|
+// |/|   OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE         |/|
+// |\|   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.            |\|
+// |/|                                                                     |/|
+// |/+---------------------------------------------------------------------+/|
+// |\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/ |
+// +-------------------------------------------------------------------------+
+//
+*/
+
+#include <dekaf2/net/address/kresolvercache.h>
+#include <dekaf2/threading/execution/kthreadpool.h>
+#include <dekaf2/core/logging/klog.h>
+#include <algorithm>
+
+DEKAF2_NAMESPACE_BEGIN
+
+//-----------------------------------------------------------------------------
+KResolverCache::KResolverCache()
+//-----------------------------------------------------------------------------
+{
+} // ctor
+
+//-----------------------------------------------------------------------------
+KResolverCache::~KResolverCache()
+//-----------------------------------------------------------------------------
+{
+	// join the refresh threads before the entries go away
+	m_Pool.reset();
+
+} // dtor
+
+//-----------------------------------------------------------------------------
+KResolverCache& KResolverCache::getInstance()
+//-----------------------------------------------------------------------------
+{
+	static KResolverCache s_Cache;
+	return s_Cache;
+
+} // getInstance
+
+//-----------------------------------------------------------------------------
+KString KResolverCache::CreateKey(KStringView sHostname, Family family)
+//-----------------------------------------------------------------------------
+{
+	// host names are case insensitive
+	KString sKey = sHostname.ToLowerASCII();
+	sKey += '/';
+	sKey += KString::to_string(static_cast<uint16_t>(family));
+	return sKey;
+
+} // CreateKey
+
+//-----------------------------------------------------------------------------
+KResolverCache::Addresses KResolverCache::SystemLookup(KStringView sHostname, Family family, boost::system::error_code& ec)
+//-----------------------------------------------------------------------------
+{
+	Addresses IPs;
+
+	boost::asio::io_service IOService;
+	boost::asio::ip::tcp::resolver Resolver(IOService);
+
+#ifdef DEKAF2_CLASSIC_ASIO
+	auto it = (family == Family::Any)
+		? Resolver.resolve(boost::asio::ip::tcp::resolver::query(std::string(sHostname), "0"), ec)
+		: Resolver.resolve(boost::asio::ip::tcp::resolver::query(
+			family == Family::IPv4 ? boost::asio::ip::tcp::v4() : boost::asio::ip::tcp::v6(),
+			std::string(sHostname), "0"), ec);
+	decltype(it) ie;
+#else
+	auto Hosts = (family == Family::Any)
+		? Resolver.resolve(std::string(sHostname), "0", ec)
+		: Resolver.resolve(family == Family::IPv4 ? boost::asio::ip::tcp::v4() : boost::asio::ip::tcp::v6(),
+		                   std::string(sHostname), "0", ec);
+	auto it = Hosts.begin();
+	auto ie = Hosts.end();
+#endif
+
+	for (; it != ie; ++it)
+	{
+		auto IP = it->endpoint().address();
+
+		// getaddrinfo returns one result per socket type - we only need the addresses
+		if (std::find(IPs.begin(), IPs.end(), IP) == IPs.end())
+		{
+			IPs.push_back(std::move(IP));
+		}
+	}
+
+	if (IPs.empty() && !ec)
+	{
+		ec = boost::asio::error::host_not_found;
+	}
+
+	return IPs;
+
+} // SystemLookup
+
+//-----------------------------------------------------------------------------
+KResolverCache::Result KResolverCache::Load(KStringView sHostname, Family family)
+//-----------------------------------------------------------------------------
+{
+	Lookup LookupFunc;
+
+	{
+		std::shared_lock<std::shared_mutex> Lock(m_Mutex);
+		LookupFunc = m_Lookup;
+	}
+
+	Result Found;
+
+	try
+	{
+		Found.IPs = LookupFunc ? LookupFunc(sHostname, family, Found.ec)
+		                       : SystemLookup(sHostname, family, Found.ec);
+	}
+	catch (const std::exception& ex)
+	{
+		kDebug(1, "lookup of {} failed: {}", sHostname, ex.what());
+		Found.IPs.clear();
+		Found.ec = boost::asio::error::host_not_found;
+	}
+
+	if (Found.IPs.empty() && !Found.ec)
+	{
+		Found.ec = boost::asio::error::host_not_found;
+	}
+
+	kDebug(3, "looked up {}: {}", sHostname, Found.ec ? KString(Found.ec.message()) : kFormat("{} addresses", Found.IPs.size()));
+
+	return Found;
+
+} // Load
+
+//-----------------------------------------------------------------------------
+void KResolverCache::Store(const KString& sKey, Result Found, KSteadyTime tNow)
+//-----------------------------------------------------------------------------
+{
+	Entry NewEntry;
+
+	if (Found.ec)
+	{
+		if (m_NegativeTimeToLive <= KDuration::zero())
+		{
+			m_Entries.erase(sKey);
+			return;
+		}
+
+		NewEntry.tExpires = tNow + m_NegativeTimeToLive;
+		// failed lookups are not refreshed, they expire
+		NewEntry.tRefresh = NewEntry.tExpires;
+	}
+	else
+	{
+		if (m_TimeToLive <= KDuration::zero())
+		{
+			m_Entries.erase(sKey);
+			return;
+		}
+
+		NewEntry.tExpires = tNow + m_TimeToLive;
+		NewEntry.tRefresh = (m_RefreshAhead > KDuration::zero() && m_RefreshAhead < m_TimeToLive)
+		                  ? NewEntry.tExpires - m_RefreshAhead
+		                  : NewEntry.tExpires;
+	}
+
+	NewEntry.Found = std::move(Found);
+
+	m_Entries[sKey] = std::move(NewEntry);
+
+	if (m_Entries.size() > m_iMaxEntries)
+	{
+		Evict(tNow);
+	}
+
+} // Store
+
+//-----------------------------------------------------------------------------
+void KResolverCache::Evict(KSteadyTime tNow)
+//-----------------------------------------------------------------------------
+{
+	for (auto it = m_Entries.begin(); it != m_Entries.end();)
+	{
+		if (it->second.tExpires <= tNow && !it->second.bRefreshing)
+		{
+			it = m_Entries.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+
+	while (m_Entries.size() > m_iMaxEntries)
+	{
+		auto Oldest = std::min_element(m_Entries.begin(), m_Entries.end(), [](const auto& left, const auto& right)
+		{
+			return left.second.tExpires < right.second.tExpires;
+		});
+
+		m_Entries.erase(Oldest);
+		++m_Counters.iEvictions;
+	}
+
+} // Evict
+
+//-----------------------------------------------------------------------------
+KResolverCache::Addresses KResolverCache::Hit(const Entry& entry, boost::system::error_code& ec)
+//-----------------------------------------------------------------------------
+{
+	if (entry.Found.ec)
+	{
+		++m_Counters.iNegativeHits;
+	}
+	else
+	{
+		++m_Counters.iHits;
+	}
+
+	ec = entry.Found.ec;
+	return entry.Found.IPs;
+
+} // Hit
+
+//-----------------------------------------------------------------------------
+void KResolverCache::Refresh(KString sKey, KString sHostname, Family family)
+//-----------------------------------------------------------------------------
+{
+	++m_Counters.iRefreshes;
+
+	std::size_t iGeneration { 0 };
+
+	{
+		std::shared_lock<std::shared_mutex> Lock(m_Mutex);
+		iGeneration = m_iGeneration;
+	}
+
+	auto Found = Load(sHostname, family);
+
+	std::unique_lock<std::shared_mutex> Lock(m_Mutex);
+
+	auto it = m_Entries.find(sKey);
+
+	if (it == m_Entries.end() || iGeneration != m_iGeneration)
+	{
+		// invalidated meanwhile
+		return;
+	}
+
+	if (Found.ec)
+	{
+		// keep the addresses until they expire, the next hit retries
+		kDebug(2, "refresh of {} failed, keeping the cached addresses: {}", sHostname, Found.ec.message());
+		it->second.bRefreshing = false;
+	}
+	else
+	{
+		Store(sKey, std::move(Found), KSteadyTime::now());
+	}
+
+} // Refresh
+
+//-----------------------------------------------------------------------------
+KResolverCache::Addresses KResolverCache::Get(KStringView sHostname, Family family, boost::system::error_code& ec)
+//-----------------------------------------------------------------------------
+{
+	ec.clear();
+
+	auto sKey = CreateKey(sHostname, family);
+	auto tNow = KSteadyTime::now();
+
+	{
+		std::shared_lock<std::shared_mutex> Lock(m_Mutex);
+
+		auto it = m_Entries.find(sKey);
+
+		if (it != m_Entries.end() && it->second.tExpires > tNow &&
+			(tNow < it->second.tRefresh || it->second.bRefreshing))
+		{
+			return Hit(it->second, ec);
+		}
+	}
+
+	std::promise<Result>       Promise;
+	std::shared_future<Result> Future;
+	std::size_t                iGeneration { 0 };
+
+	{
+		std::unique_lock<std::shared_mutex> Lock(m_Mutex);
+
+		// check again, the name may have been loaded meanwhile
+		auto it = m_Entries.find(sKey);
+
+		if (it != m_Entries.end() && it->second.tExpires > tNow)
+		{
+			if (tNow >= it->second.tRefresh && !it->second.bRefreshing)
+			{
+				// serve the cached addresses, and look them up again in the background
+				it->second.bRefreshing = true;
+
+				if (!m_Pool)
+				{
+					m_Pool = std::make_unique<KThreadPool>(2, "resolver", KThreadPool::PrestartNone, KThreadPool::ShrinkOne);
+				}
+
+				m_Pool->push([this, sKey, sName = KString(sHostname), family]()
+				{
+					Refresh(sKey, sName, family);
+				});
+			}
+
+			return Hit(it->second, ec);
+		}
+
+		auto pending = m_Loading.find(sKey);
+
+		if (pending != m_Loading.end())
+		{
+			++m_Counters.iCoalesced;
+			Future = pending->second;
+		}
+		else
+		{
+			++m_Counters.iMisses;
+			m_Loading.emplace(sKey, Promise.get_future().share());
+			iGeneration = m_iGeneration;
+		}
+	}
+
+	if (Future.valid())
+	{
+		// another thread looks up this name - wait for it
+		const auto& Found = Future.get();
+		ec = Found.ec;
+		return Found.IPs;
+	}
+
+	auto Found = Load(sHostname, family);
+
+	{
+		std::unique_lock<std::shared_mutex> Lock(m_Mutex);
+
+		m_Loading.erase(sKey);
+
+		if (iGeneration == m_iGeneration)
+		{
+			Store(sKey, Found, KSteadyTime::now());
+		}
+	}
+
+	Promise.set_value(Found);
+
+	ec = Found.ec;
+	return std::move(Found.IPs);
+
+} // Get
+
+//-----------------------------------------------------------------------------
+bool KResolverCache::Invalidate(KStringView sHostname)
+//-----------------------------------------------------------------------------
+{
+	std::size_t iErased { 0 };
+
+	std::unique_lock<std::shared_mutex> Lock(m_Mutex);
+
+	for (auto family : { Family::Any, Family::IPv4, Family::IPv6 })
+	{
+		iErased += m_Entries.erase(CreateKey(sHostname, family));
+	}
+
+	++m_iGeneration;
+
+	return iErased > 0;
+
+} // Invalidate
+
+//-----------------------------------------------------------------------------
+void KResolverCache::clear()
+//-----------------------------------------------------------------------------
+{
+	std::unique_lock<std::shared_mutex> Lock(m_Mutex);
+
+	m_Entries.clear();
+	++m_iGeneration;
+
+} // clear
+
+//-----------------------------------------------------------------------------
+KResolverCache& KResolverCache::SetLookup(Lookup LookupFunc)
+//-----------------------------------------------------------------------------
+{
+	std::unique_lock<std::shared_mutex> Lock(m_Mutex);
+
+	m_Lookup = std::move(LookupFunc);
+	m_Entries.clear();
+	++m_iGeneration;
+
+	return *this;
+
+} // SetLookup
+
+//-----------------------------------------------------------------------------
+KResolverCache& KResolverCache::SetTimeToLive(KDuration TimeToLive)
+//-----------------------------------------------------------------------------
+{
+	std::unique_lock<std::shared_mutex> Lock(m_Mutex);
+	m_TimeToLive = TimeToLive;
+	return *this;
+
+} // SetTimeToLive
+
+//-----------------------------------------------------------------------------
+KDuration KResolverCache::GetTimeToLive() const
+//-----------------------------------------------------------------------------
+{
+	std::shared_lock<std::shared_mutex> Lock(m_Mutex);
+	return m_TimeToLive;
+
+} // GetTimeToLive
+
+//-----------------------------------------------------------------------------
+KResolverCache& KResolverCache::SetNegativeTimeToLive(KDuration TimeToLive)
+//-----------------------------------------------------------------------------
+{
+	std::unique_lock<std::shared_mutex> Lock(m_Mutex);
+	m_NegativeTimeToLive = TimeToLive;
+	return *this;
+
+} // SetNegativeTimeToLive
+
+//-----------------------------------------------------------------------------
+KDuration KResolverCache::GetNegativeTimeToLive() const
+//-----------------------------------------------------------------------------
+{
+	std::shared_lock<std::shared_mutex> Lock(m_Mutex);
+	return m_NegativeTimeToLive;
+
+} // GetNegativeTimeToLive
+
+//-----------------------------------------------------------------------------
+KResolverCache& KResolverCache::SetRefreshAhead(KDuration RefreshAhead)
+//-----------------------------------------------------------------------------
+{
+	std::unique_lock<std::shared_mutex> Lock(m_Mutex);
+	m_RefreshAhead = RefreshAhead;
+	return *this;
+
+} // SetRefreshAhead
+
+//-----------------------------------------------------------------------------
+KDuration KResolverCache::GetRefreshAhead() const
+//-----------------------------------------------------------------------------
+{
+	std::shared_lock<std::shared_mutex> Lock(m_Mutex);
+	return m_RefreshAhead;
+
+} // GetRefreshAhead
+
+//-----------------------------------------------------------------------------
+KResolverCache& KResolverCache::SetMaxEntries(std::size_t iMaxEntries)
+//-----------------------------------------------------------------------------
+{
+	std::unique_lock<std::shared_mutex> Lock(m_Mutex);
+
+	m_iMaxEntries = std::max(iMaxEntries, std::size_t(1));
+
+	if (m_Entries.size() > m_iMaxEntries)
+	{
+		Evict(KSteadyTime::now());
+	}
+
+	return *this;
+
+} // SetMaxEntries
+
+//-----------------------------------------------------------------------------
+std::size_t KResolverCache::GetMaxEntries() const
+//-----------------------------------------------------------------------------
+{
+	std::shared_lock<std::shared_mutex> Lock(m_Mutex);
+	return m_iMaxEntries;
+
+} // GetMaxEntries
+
+//-----------------------------------------------------------------------------
+KResolverCache::Statistics KResolverCache::GetStatistics() const
+//-----------------------------------------------------------------------------
+{
+	Statistics Stats;
+
+	Stats.iHits         = m_Counters.iHits;
+	Stats.iNegativeHits = m_Counters.iNegativeHits;
+	Stats.iMisses       = m_Counters.iMisses;
+	Stats.iCoalesced    = m_Counters.iCoalesced;
+	Stats.iRefreshes    = m_Counters.iRefreshes;
+	Stats.iEvictions    = m_Counters.iEvictions;
+
+	std::shared_lock<std::shared_mutex> Lock(m_Mutex);
+	Stats.iEntries      = m_Entries.size();
+
+	return Stats;
+
+} // GetStatistics
+
+//-----------------------------------------------------------------------------
+void KResolverCache::ResetStatistics()
+//-----------------------------------------------------------------------------
+{
+	m_Counters.iHits         = 0;
+	m_Counters.iNegativeHits = 0;
+	m_Counters.iMisses       = 0;
+	m_Counters.iCoalesced    = 0;
+	m_Counters.iRefreshes    = 0;
+	m_Counters.iEvictions    = 0;
+
+} // ResetStatistics
+
+#if DEKAF2_REPEAT_CONSTEXPR_VARIABLE
+constexpr std::size_t KResolverCache::DefaultMaxEntries;
+#endif
+
+DEKAF2_NAMESPACE_END
@@ -0,0 +1,299 @@
+/*
+//
+// DEKAF(tm): Lighter, Faster, Smarter(tm)
+//
+// Copyright (c) 2026, Ridgeware, Inc.
+//
+// +-------------------------------------------------------------------------+
+// | /\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\|
+// |/+---------------------------------------------------------------------+/|
+// |/|                                                                     |/|
+// |\|  ** THIS NOTICE MUST NOT BE REMOVED FROM THE SOURCE CODE MODULE **  |\|
+// |/|                                                                     |/|
+// |\|   OPEN SOURCE LICENSE                                               |\|
+// |/|                                                                     |/|
+// |\|   Permission is hereby granted, free of charge, to any person       |\|
+// |/|   obtaining a copy of this software and associated                  |/|
+// |\|   documentation files (the "Software"), to deal in the              |\|
+// |/|   Software without restriction, including without limitation        |/|
+// |\|   the rights to use, copy, modify, merge, publish,                  |\|
+// |/|   distribute, sublicense, and/or sell copies of the Software,       |/|
+// |\|   and to permit persons to whom the Software is furnished to        |\|
+// |/|   do so, subject to the following conditions:                       |/|
+// |\|                                                                     |\|
+// |/|   The above copyright notice and this permission notice shall       |/|
+// |\|   be included in all copies or substantial portions of the          |\|
+// |/|   Software.                                                         |/|
+// |\|                                                                     |\|
+// |/|   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY         |/|
+// |\|   KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE        |\|
+// |/|   WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR           |/|
+// |\|   PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS        |\|
+// |/|   OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR          |/|
+// |\|   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR        |\|
+// |/|   OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE         |/|
+// |\|   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.            |\|
+// |/|                                                                     |/|
+// |/+---------------------------------------------------------------------+/|
+// |\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/ |
+// +-------------------------------------------------------------------------+
+//
+*/
+
+#pragma once
+
+/// @file kresolvercache.h
+/// process wide cache for host name lookups
+
+#include <dekaf2/core/init/kdefinitions.h>
+#include <dekaf2/core/strings/kstring.h>
+#include <dekaf2/core/strings/kstringview.h>
+#include <dekaf2/net/tcp/bits/kasio.h>
+#include <dekaf2/net/util/kstreamoptions.h>
+#include <dekaf2/time/duration/kduration.h>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+DEKAF2_NAMESPACE_BEGIN
+
+/// @addtogroup net_address
+/// @{
+
+class KThreadPool;
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+/// A process wide, thread safe cache for host name lookups, used by KResolve::ResolveTCP()
+/// and KResolve::ResolveUDP(), and with them by all stream connects and kResolveHost().
+///
+/// Found addresses are kept for GetTimeToLive(), failed lookups for GetNegativeTimeToLive().
+/// A hit within GetRefreshAhead() before the expiry of an entry refreshes it in the background,
+/// so that frequently used names never block a caller on the resolver. Concurrent misses for
+/// the same name run only one lookup, all other callers wait for its result.
+///
+/// The system resolver does not expose the time to live of the DNS records, therefore the
+/// times are configured, not taken from the answer. For tests, the lookup function can be
+/// replaced with SetLookup().
+class DEKAF2_PUBLIC KResolverCache
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+{
+
+//------
+public:
+//------
+
+	using self      = KResolverCache;
+	using Family    = KStreamOptions::Family;
+	using Addresses = std::vector<boost::asio::ip::address>;
+	/// the lookup function, returns the addresses of sHostname or sets ec
+	using Lookup    = std::function<Addresses(KStringView sHostname, Family family, boost::system::error_code& ec)>;
+
+	/// cache counters, see GetStatistics()
+	struct Statistics
+	{
+		std::size_t iHits         { 0 }; ///< names found in the cache
+		std::size_t iNegativeHits { 0 }; ///< failed lookups found in the cache
+		std::size_t iMisses       { 0 }; ///< names that had to be looked up
+		std::size_t iCoalesced    { 0 }; ///< callers that waited for a concurrent lookup of the same name
+		std::size_t iRefreshes    { 0 }; ///< background lookups for entries close to their expiry
+		std::size_t iEvictions    { 0 }; ///< entries removed to stay below GetMaxEntries()
+		std::size_t iEntries      { 0 }; ///< current count of cached names
+
+		/// returns the share of hits (including negative hits) from all requests, 0 ... 1
+		double GetHitRate() const
+		{
+			auto iFound = iHits + iNegativeHits;
+			return (iFound + iMisses + iCoalesced) ? double(iFound) / double(iFound + iMisses + iCoalesced) : 0.0;
+		}
+	};
+
+	static constexpr std::size_t DefaultMaxEntries { 1000 };
+
+	//-----------------------------------------------------------------------------
+	KResolverCache();
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	~KResolverCache();
+	//-----------------------------------------------------------------------------
+
+	KResolverCache(const KResolverCache&) = delete;
+	KResolverCache& operator=(const KResolverCache&) = delete;
+
+	//-----------------------------------------------------------------------------
+	/// returns the process wide cache
+	static self& getInstance();
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// returns the addresses for sHostname, from the cache or from a new lookup
+	/// @param sHostname the host name to look up - numeric addresses should not be given
+	/// @param family the address family searched for
+	/// @param ec is set if the name could not be resolved
+	/// @return the found addresses, or an empty vector on error
+	Addresses Get(KStringView sHostname, Family family, boost::system::error_code& ec);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// removes a name from the cache, for all address families - returns true if it was found
+	bool Invalidate(KStringView sHostname);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// removes all names from the cache
+	void clear();
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// enable or disable the cache (default enabled) - a disabled cache is not used by KResolve
+	self& Enable(bool bYesNo = true) { m_bEnabled = bYesNo; return *this; }
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// is the cache enabled?
+	bool IsEnabled() const { return m_bEnabled; }
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// set a lookup function other than the system resolver, e.g. for tests - an empty
+	/// function restores the system resolver. Clears the cache.
+	self& SetLookup(Lookup LookupFunc);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// set the time found addresses are kept (default 60 seconds)
+	self& SetTimeToLive(KDuration TimeToLive);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// get the time found addresses are kept
+	KDuration GetTimeToLive() const;
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// set the time failed lookups are kept (default 5 seconds) - zero disables negative caching
+	self& SetNegativeTimeToLive(KDuration TimeToLive);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// get the time failed lookups are kept
+	KDuration GetNegativeTimeToLive() const;
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// set the time before the expiry of an entry in which a hit triggers a background
+	/// refresh (default 15 seconds) - zero disables the refresh
+	self& SetRefreshAhead(KDuration RefreshAhead);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// get the time before the expiry of an entry in which a hit triggers a background refresh
+	KDuration GetRefreshAhead() const;
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// set the maximum count of cached names
+	self& SetMaxEntries(std::size_t iMaxEntries);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// get the maximum count of cached names
+	std::size_t GetMaxEntries() const;
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// returns a snapshot of the cache counters
+	Statistics GetStatistics() const;
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// resets the cache counters
+	void ResetStatistics();
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// the system resolver, the default lookup function
+	static Addresses SystemLookup(KStringView sHostname, Family family, boost::system::error_code& ec);
+	//-----------------------------------------------------------------------------
+
+//------
+private:
+//------
+
+	struct Result
+	{
+		Addresses                 IPs;
+		boost::system::error_code ec;
+	};
+
+	struct Entry
+	{
+		Result                    Found;
+		KSteadyTime               tExpires;
+		KSteadyTime               tRefresh;
+		bool                      bRefreshing { false };
+	};
+
+	struct Counters
+	{
+		std::atomic<std::size_t>  iHits         { 0 };
+		std::atomic<std::size_t>  iNegativeHits { 0 };
+		std::atomic<std::size_t>  iMisses       { 0 };
+		std::atomic<std::size_t>  iCoalesced    { 0 };
+		std::atomic<std::size_t>  iRefreshes    { 0 };
+		std::atomic<std::size_t>  iEvictions    { 0 };
+	};
+
+	//-----------------------------------------------------------------------------
+	static KString CreateKey(KStringView sHostname, Family family);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// runs the lookup function outside of the lock
+	Result Load(KStringView sHostname, Family family);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// stores a lookup result, needs the unique lock
+	void Store(const KString& sKey, Result Found, KSteadyTime tNow);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// removes expired entries, and the oldest ones above the size limit, needs the unique lock
+	void Evict(KSteadyTime tNow);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// refreshes an entry in the background
+	void Refresh(KString sKey, KString sHostname, Family family);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// copies the found addresses into the return value, and counts the hit
+	Addresses Hit(const Entry& entry, boost::system::error_code& ec);
+	//-----------------------------------------------------------------------------
+
+	mutable std::shared_mutex                                  m_Mutex;
+	std::unordered_map<KString, Entry>                         m_Entries;
+	std::unordered_map<KString, std::shared_future<Result>>    m_Loading;
+	Lookup                                                     m_Lookup;
+	KDuration                                                  m_TimeToLive         { chrono::seconds(60) };
+	KDuration                                                  m_NegativeTimeToLive { chrono::seconds(5)  };
+	KDuration                                                  m_RefreshAhead       { chrono::seconds(15) };
+	std::size_t                                                m_iMaxEntries        { DefaultMaxEntries   };
+	/// incremented by clear() and Invalidate(), lookups started before are not stored
+	std::size_t                                                m_iGeneration        { 0 };
+	Counters                                                   m_Counters;
+	std::atomic<bool>                                          m_bEnabled           { true };
+	/// runs the background refreshes, created on first use
+	std::unique_ptr<KThreadPool>                               m_Pool;
+
+}; // KResolverCache
+
+/// @}
+
+DEKAF2_NAMESPACE_END
@@ -526,6 +526,14 @@ bool KQuicStream::Connect(const KTCPEndPoint& Endpoint, KStreamOptions Options)
 		return SetError(kFormat("failed to set SNI hostname: {}", sHostname));
 	}
 
+	if (GetContext().GetRole() == boost::asio::ssl::stream_base::client)
+	{
+		// offer the session of a previous connection to this endpoint, see KTLSStream::Connect()
+		m_TLSContext.SetClientSession(GetNativeTLSHandle(),
+		                              kFormat("{}:{}{}", sHostname, Endpoint.Port.get(),
+		                                      Options.IsSet(KStreamOptions::VerifyCert) ? "" : ":noverify"));
+	}
+
 	if (!Good() || GetNativeSocket() < 0)
 	{
 		return false;
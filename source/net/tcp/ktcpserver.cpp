@@ -90,6 +90,14 @@
 #include <dekaf2/crypto/rsa/krsacert.h>
 #include <dekaf2/net/address/knetworkinterface.h>
 #include <dekaf2/net/address/kipaddress.h>
+#include <dekaf2/net/util/kpoll.h>
+#include <unordered_map>
+#include <array>
+
+#if !DEKAF2_IS_WINDOWS
+	#include <sys/types.h>
+	#include <sys/socket.h>
+#endif
 
 DEKAF2_NAMESPACE_BEGIN
 
@@ -148,6 +156,384 @@ static KString BuildSANString(SelfSignedCertSANPolicy Policy, const std::vector<
 
 } // BuildSANString
 
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+/// Holds the idle connections of an event-driven KTCPServer. A parked connection
+/// is registered with a KPoll for one trigger - when its next request head is
+/// readable the poll thread takes it out of the registry and hands it to a worker
+/// of the server's thread pool, which then owns it exclusively until it either
+/// parks it again or closes it. Closing a served connection therefore never
+/// touches the poll set.
+class KTCPServer::Reactor
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+{
+
+//----------
+public:
+//----------
+
+	//-----------------------------------------------------------------------------
+	Reactor(KTCPServer& Server)
+	//-----------------------------------------------------------------------------
+	: m_Server(Server)
+	, m_Poll(chrono::milliseconds(500), true)
+	{
+		auto sPoolName = m_Server.m_ThreadPool.get_thread_name();
+
+		if (!sPoolName.empty())
+		{
+			m_Poll.SetThreadName(kFormat("{}:reactor", sPoolName));
+		}
+	}
+
+	//-----------------------------------------------------------------------------
+	~Reactor()
+	//-----------------------------------------------------------------------------
+	{
+		Stop();
+	}
+
+	//-----------------------------------------------------------------------------
+	/// (re)allow parking after a Stop()
+	void Start()
+	//-----------------------------------------------------------------------------
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		m_bStopped = false;
+	}
+
+	//-----------------------------------------------------------------------------
+	/// park a connection until its next request head is readable
+	/// @param Stream the connection
+	/// @param Parameters the session state returned by the previous EventSession() call,
+	/// empty for a new connection
+	void Park(std::unique_ptr<KIOStreamSocket> Stream, param_t Parameters)
+	//-----------------------------------------------------------------------------
+	{
+		auto fd = Stream->GetNativeSocket();
+
+		{
+			std::lock_guard<std::mutex> Lock(m_Mutex);
+
+			if (!m_bStopped)
+			{
+				Connection& Conn = m_Parked[fd];
+				Conn.Stream      = std::move(Stream);
+				Conn.Parameters  = std::move(Parameters);
+				Conn.Idle.clear();
+
+				KPoll::Parameters Parms;
+				Parms.iEvents  = POLLIN;
+				Parms.bOnce    = true;
+				Parms.Callback = [this](int fd, uint16_t iEvents, std::size_t)
+				{
+					Triggered(fd, iEvents);
+				};
+
+				// register under our lock, so that Sweep() cannot expire the
+				// connection before it is part of the poll set
+				m_Poll.Add(fd, std::move(Parms));
+
+				return;
+			}
+		}
+
+		// the reactor is stopped
+		m_Server.CloseConnection(*Stream);
+
+	} // Park
+
+	//-----------------------------------------------------------------------------
+	/// close connections that idled for too long, and re-check connections that
+	/// wait for the remainder of their request head - called periodically
+	void Sweep()
+	//-----------------------------------------------------------------------------
+	{
+		std::vector<std::pair<int, Connection>> Expired;
+		std::vector<std::pair<int, Connection>> Ready;
+
+		{
+			std::lock_guard<std::mutex> Lock(m_Mutex);
+
+			bool bCheckIdle = m_LastIdleCheck.elapsed() >= chrono::seconds(1);
+
+			if (bCheckIdle)
+			{
+				m_LastIdleCheck.clear();
+			}
+
+			for (auto it = m_Parked.begin(); it != m_Parked.end();)
+			{
+				if (it->second.bWaitForHead)
+				{
+					// this connection is not registered with the poll set
+					if (IsHeadComplete(it->first, it->second))
+					{
+						Ready.emplace_back(it->first, std::move(it->second));
+						it = m_Parked.erase(it);
+						continue;
+					}
+				}
+				else if (bCheckIdle && it->second.Idle.elapsed() > m_Server.m_IdleTimeout)
+				{
+					Expired.emplace_back(it->first, std::move(it->second));
+					it = m_Parked.erase(it);
+					continue;
+				}
+
+				++it;
+			}
+		}
+
+		for (auto& Conn : Expired)
+		{
+			kDebug(3, "closing connection after {} idle time", m_Server.m_IdleTimeout);
+			// remove the fd from the poll set before its number can be reused
+			m_Poll.Remove(Conn.first);
+			m_Server.CloseConnection(*Conn.second.Stream);
+		}
+
+		for (auto& Conn : Ready)
+		{
+			Serve(std::move(Conn.second));
+		}
+
+	} // Sweep
+
+	//-----------------------------------------------------------------------------
+	/// close all parked connections and stop the poll thread
+	void Stop()
+	//-----------------------------------------------------------------------------
+	{
+		std::unordered_map<int, Connection> Parked;
+
+		{
+			std::lock_guard<std::mutex> Lock(m_Mutex);
+			m_bStopped = true;
+			Parked.swap(m_Parked);
+		}
+
+		m_Poll.Stop();
+
+		for (auto& Conn : Parked)
+		{
+			m_Poll.Remove(Conn.first);
+			m_Server.CloseConnection(*Conn.second.Stream);
+		}
+
+	} // Stop
+
+	//-----------------------------------------------------------------------------
+	/// @return count of parked connections
+	std::size_t size() const
+	//-----------------------------------------------------------------------------
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		return m_Parked.size();
+	}
+
+//----------
+private:
+//----------
+
+	//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+	struct Connection
+	//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+	{
+		std::unique_ptr<KIOStreamSocket> Stream;
+		param_t   Parameters;
+		KStopTime Idle;                          ///< start of the idle time
+		KStopTime WaitForHead { KStopTime::Halted }; ///< start of the wait for the remainder of a request head
+		bool      bWaitForHead { false };        ///< out of the poll set, Sweep() re-checks the head
+	};
+
+	//-----------------------------------------------------------------------------
+	/// called by the poll thread - the fd is already out of the poll set
+	void Triggered(int fd, uint16_t iEvents)
+	//-----------------------------------------------------------------------------
+	{
+		Connection Conn;
+
+		{
+			std::lock_guard<std::mutex> Lock(m_Mutex);
+
+			auto it = m_Parked.find(fd);
+
+			if (it == m_Parked.end())
+			{
+				// closed meanwhile by Sweep() or Stop()
+				return;
+			}
+
+			if ((iEvents & (POLLERR | POLLHUP | POLLNVAL)) == 0 && !IsHeadComplete(fd, it->second))
+			{
+				// wait for more data, Sweep() checks again
+				return;
+			}
+
+			Conn = std::move(it->second);
+			m_Parked.erase(it);
+		}
+
+		Serve(std::move(Conn));
+
+	} // Triggered
+
+	//-----------------------------------------------------------------------------
+	/// peek into the socket and ask the server if the request head is complete - sets
+	/// the connection to wait for more data if not. Called with locked mutex.
+	bool IsHeadComplete(int fd, Connection& Conn)
+	//-----------------------------------------------------------------------------
+	{
+		if (Conn.Stream->IsTLS())
+		{
+			// we cannot look into encrypted data - TLS records arrive in one piece
+			// anyway for all practical purposes
+			return true;
+		}
+
+		std::array<char, 4096> Buffer;
+
+		// the socket is readable (or was, when the data arrived), therefore a peek does not block
+		auto iPeeked = ::recv(fd, Buffer.data(), static_cast<int>(Buffer.size()), MSG_PEEK);
+
+		if (iPeeked <= 0 || static_cast<std::size_t>(iPeeked) >= Buffer.size())
+		{
+			// closed, error, or too much data to judge - let a worker find out
+			return true;
+		}
+
+		if (m_Server.IsRequestHeadComplete(KStringView(Buffer.data(), static_cast<std::size_t>(iPeeked))))
+		{
+			return true;
+		}
+
+		if (!Conn.bWaitForHead)
+		{
+			Conn.bWaitForHead = true;
+			Conn.WaitForHead.clear();
+		}
+		else if (Conn.WaitForHead.elapsed() > m_Server.GetTimeout())
+		{
+			// do not wait longer than the I/O timeout - a worker will time out the
+			// connection as in threaded mode
+			return true;
+		}
+
+		return false;
+
+	} // IsHeadComplete
+
+	//-----------------------------------------------------------------------------
+	/// hand a connection with a readable request to a worker
+	void Serve(Connection Conn)
+	//-----------------------------------------------------------------------------
+	{
+		// a shared_ptr keeps the lambda copyable, and carries the connection
+		// safely through C++11 builds as well
+		auto pConn = std::make_shared<Connection>(std::move(Conn));
+
+		m_Server.m_ThreadPool.push([this, pConn]()
+		{
+			if (m_Server.RunEventSession(pConn->Stream, pConn->Parameters))
+			{
+				Park(std::move(pConn->Stream), std::move(pConn->Parameters));
+			}
+		});
+
+	} // Serve
+
+	KTCPServer&        m_Server;
+	KPoll              m_Poll;
+	mutable std::mutex m_Mutex;
+	std::unordered_map<int, Connection> m_Parked;
+	KStopTime          m_LastIdleCheck;
+	bool               m_bStopped { false };
+
+}; // Reactor
+
+//-----------------------------------------------------------------------------
+void KTCPServer::Dispatch(std::unique_ptr<KIOStreamSocket> stream, std::size_t iShard)
+//-----------------------------------------------------------------------------
+{
+	if (m_Reactor)
+	{
+		PrepareConnection(*stream);
+		// a new connection waits in the reactor for its first request
+		m_Reactor->Park(std::move(stream), param_t());
+		return;
+	}
+
+	// shard 0 uses the main pool, the other shards their own pools if configured
+	auto& Pool = (iShard > 0 && iShard <= m_ShardPools.size()) ? *m_ShardPools[iShard - 1] : m_ThreadPool;
+
+#if !DEKAF2_HAS_CPP_14 || DEKAF2_CLASSIC_ASIO
+	auto* Stream = stream.release();
+	Pool.push([ this, Stream ]() mutable
+	{
+		std::unique_ptr<KIOStreamSocket> moved_stream { Stream };
+		RunSession(moved_stream);
+	});
+#else
+	Pool.push([ this, moved_stream = std::move(stream) ]() mutable
+	{
+		RunSession(moved_stream);
+	});
+#endif
+
+} // Dispatch
+
+//-----------------------------------------------------------------------------
+std::size_t KTCPServer::GetParkedConnections() const
+//-----------------------------------------------------------------------------
+{
+	return m_Reactor ? m_Reactor->size() : 0;
+
+} // GetParkedConnections
+
+//-----------------------------------------------------------------------------
+void KTCPServer::SetAcceptShards(uint16_t iShards, bool bShardThreadPools)
+//-----------------------------------------------------------------------------
+{
+#ifndef SO_REUSEPORT
+	if (iShards > 1)
+	{
+		kDebug(1, "SO_REUSEPORT is not supported on this platform, using one listener");
+		iShards = 1;
+	}
+#endif
+
+	m_iAcceptShards     = std::max(iShards, uint16_t(1));
+	m_bShardThreadPools = bShardThreadPools;
+	m_ShardAccepts      = std::vector<std::atomic<std::size_t>>(m_iAcceptShards);
+
+} // SetAcceptShards
+
+//-----------------------------------------------------------------------------
+void KTCPServer::StartIdleSweep()
+//-----------------------------------------------------------------------------
+{
+	// the sweep runs in the IO thread - it expires idle connections, and re-checks
+	// partial request heads, which are out of the poll set to avoid a busy loop
+#if DEKAF2_CLASSIC_ASIO
+	m_IdleSweepTimer->expires_from_now(boost::posix_time::milliseconds(50));
+#else
+	m_IdleSweepTimer->expires_after(chrono::milliseconds(50));
+#endif
+
+	m_IdleSweepTimer->async_wait([this](const boost::system::error_code& ec)
+	{
+		if (ec || IsShuttingDown() || !m_Reactor)
+		{
+			return;
+		}
+
+		m_Reactor->Sweep();
+
+		StartIdleSweep();
+	});
+
+} // StartIdleSweep
+
 //-----------------------------------------------------------------------------
 // deprecated signature
 bool KTCPServer::Accepted(KStream& stream, KStringView sRemoteEndPoint)
@@ -218,32 +604,84 @@ void KTCPServer::Session(std::unique_ptr<KIOStreamSocket>& stream)
 } // Session
  
 //-----------------------------------------------------------------------------
-void KTCPServer::RunSession(std::unique_ptr<KIOStreamSocket>& stream)
+bool KTCPServer::EventSession(std::unique_ptr<KIOStreamSocket>& stream, param_t& parameters)
 //-----------------------------------------------------------------------------
 {
-	// make sure we adjust this thread's log level to the global log level,
-	// even when running repeatedly over a long time
-	KLog::getInstance().SyncLevel();
+	// a server that does not implement rounds runs its full session once
+	Session(stream);
 
+	return false;
+
+} // EventSession
+
+//-----------------------------------------------------------------------------
+bool KTCPServer::IsRequestHeadComplete(KStringView sPeeked) const
+//-----------------------------------------------------------------------------
+{
+	return sPeeked.contains('\n');
+
+} // IsRequestHeadComplete
+
+//-----------------------------------------------------------------------------
+void KTCPServer::PrepareConnection(KIOStreamSocket& stream)
+//-----------------------------------------------------------------------------
+{
 #ifdef DEKAF2_HAS_UNIX_SOCKETS
 	if (!m_iPort)
 	{
 		kDebug(3, "handling new unix socket connection from {}",
-		          stream->GetEndPointAddress());
+		          stream.GetEndPointAddress());
 	}
 	else
 #endif // DEKAF2_HAS_UNIX_SOCKETS
 	{
 		kDebug(3, "handling new TCP connection from {} on port {}",
-		          stream->GetEndPointAddress(),
+		          stream.GetEndPointAddress(),
 		          m_iPort);
 
 		// apply configured socket options (keepalive, drop timeout) to the accepted
 		// connection - options left at their defaults apply nothing. Not for unix
 		// domain sockets, they have no TCP options.
-		m_StreamOptions.ApplySocketOptions(stream->GetNativeSocket(), true);
+		m_StreamOptions.ApplySocketOptions(stream.GetNativeSocket(), true);
 	}
 
+} // PrepareConnection
+
+//-----------------------------------------------------------------------------
+void KTCPServer::CloseConnection(KIOStreamSocket& stream)
+//-----------------------------------------------------------------------------
+{
+#ifdef DEKAF2_HAS_UNIX_SOCKETS
+	if (!m_iPort)
+	{
+		kDebug(3, "closing unix socket connection with {}",
+		          stream.GetEndPointAddress());
+	}
+	else
+#endif // DEKAF2_HAS_UNIX_SOCKETS
+	{
+		kDebug(3, "closing TCP connection with {} on port {}",
+		          stream.GetEndPointAddress(),
+		          m_iPort);
+	}
+
+	// the thread pool keeps the object alive until it is
+	// overwritten in round-robin, therefore we have to call
+	// Disconnect explicitly now to shut down the connection
+	stream.Disconnect();
+
+} // CloseConnection
+
+//-----------------------------------------------------------------------------
+void KTCPServer::RunSession(std::unique_ptr<KIOStreamSocket>& stream)
+//-----------------------------------------------------------------------------
+{
+	// make sure we adjust this thread's log level to the global log level,
+	// even when running repeatedly over a long time
+	KLog::getInstance().SyncLevel();
+
+	PrepareConnection(*stream);
+
 	DEKAF2_TRY
 	{
 		// run the actual Session code protected by
@@ -276,26 +714,77 @@ void KTCPServer::RunSession(std::unique_ptr<KIOStreamSocket>& stream)
 		return;
 	}
 
-#ifdef DEKAF2_HAS_UNIX_SOCKETS
-	if (!m_iPort)
+	CloseConnection(*stream);
+
+} // RunSession
+
+//-----------------------------------------------------------------------------
+bool KTCPServer::RunEventSession(std::unique_ptr<KIOStreamSocket>& stream, param_t& parameters)
+//-----------------------------------------------------------------------------
+{
+	KLog::getInstance().SyncLevel();
+
+	bool bKeep { false };
+
+	DEKAF2_TRY
 	{
-		kDebug(3, "closing unix socket connection with {}",
-		          stream->GetEndPointAddress());
+		for (;;)
+		{
+			bKeep = EventSession(stream, parameters);
+
+			if (!bKeep || !stream || IsShuttingDown() || !stream->Good())
+			{
+				break;
+			}
+
+			// data that is already buffered in the stream or TLS layers would not
+			// wake the reactor - serve it right here, as would a pipelining client
+			// that sent its next request before we responded
+			if (!stream->IsReadReady(KDuration::zero()))
+			{
+				break;
+			}
+
+			kDebug(3, "more input is ready, staying with the connection");
+		}
 	}
-	else
-#endif // DEKAF2_HAS_UNIX_SOCKETS
+
+	DEKAF2_CATCH(const std::exception& ex)
 	{
-		kDebug(3, "closing TCP connection with {} on port {}",
-		          stream->GetEndPointAddress(),
-		          m_iPort);
+		bKeep = false;
+		kDebug(1, ex.what());
 	}
 
-	// the thread pool keeps the object alive until it is
-	// overwritten in round-robin, therefore we have to call
-	// Disconnect explicitly now to shut down the connection
-	stream->Disconnect();
+	DEKAF2_CATCH(const boost::exception& ex)
+	{
+		bKeep = false;
+#ifndef DEKAF2_IS_MSC
+		kDebug(1, boost::diagnostic_information(ex));
+#endif
+	}
 
-} // RunSession
+	DEKAF2_CATCH(...)
+	{
+		bKeep = false;
+		kWarning("unknown exception");
+	}
+
+	if (!stream)
+	{
+		// the stream got moved or reset - just return
+		return false;
+	}
+
+	if (bKeep && !IsShuttingDown() && stream->Good())
+	{
+		return true;
+	}
+
+	CloseConnection(*stream);
+
+	return false;
+
+} // RunEventSession
 
 //-----------------------------------------------------------------------------
 // static
@@ -488,6 +977,21 @@ bool KTCPServer::SetACME(std::vector<KString> Domains, KString sContact, KString
 bool KTCPServer::SetupTCPAcceptors()
 //-----------------------------------------------------------------------------
 {
+	// every additional shard gets a fresh io_context - one that was stopped by
+	// a previous Stop() may still hold the handlers of the old listeners
+	m_ShardIO.clear();
+
+	for (uint16_t iShard = 1; iShard < m_iAcceptShards; ++iShard)
+	{
+		m_ShardIO.push_back(std::make_unique<boost::asio::io_service>());
+	}
+
+	// and the accept counters start again at zero
+	for (auto& iAccepts : m_ShardAccepts)
+	{
+		iAccepts.store(0, std::memory_order_relaxed);
+	}
+
 	bool bTryIPv6 = m_bStartIPv6;
 	bool bNeedIPv4 = m_bStartIPv4;
 
@@ -518,8 +1022,11 @@ bool KTCPServer::SetupTCPAcceptors()
 			kDebug(2, "opening {} listener on {}:{}", IsTLS() ? "TLS" : "TCP", m_sBindAddress, m_iPort);
 
 			tcp::endpoint local_endpoint(Address, m_iPort);
-			auto acceptor = std::make_shared<tcp::acceptor>(m_asio, local_endpoint, true); // true means reuse_addr
-			m_TCPAcceptors.push_back(std::move(acceptor));
+
+			for (uint16_t iShard = 0; iShard < m_iAcceptShards; ++iShard)
+			{
+				m_TCPAcceptors.push_back(OpenTCPAcceptor(local_endpoint, iShard));
+			}
 		}
 		DEKAF2_CATCH(const std::exception& e)
 		{
@@ -534,7 +1041,7 @@ bool KTCPServer::SetupTCPAcceptors()
 			kDebug(2, "opening {} listener on port {}, asking for dual stack", IsTLS() ? "TLS" : "TCP", m_iPort);
 
 			tcp::endpoint local_endpoint(tcp::v6(), m_iPort);
-			auto acceptor = std::make_shared<tcp::acceptor>(m_asio, local_endpoint, true); // true means reuse_addr
+			auto acceptor = OpenTCPAcceptor(local_endpoint, 0);
 
 			boost::asio::ip::v6_only v6_only(false);
 			acceptor->get_option(v6_only);
@@ -550,6 +1057,11 @@ bool KTCPServer::SetupTCPAcceptors()
 			}
 
 			m_TCPAcceptors.push_back(std::move(acceptor));
+
+			for (uint16_t iShard = 1; iShard < m_iAcceptShards; ++iShard)
+			{
+				m_TCPAcceptors.push_back(OpenTCPAcceptor(local_endpoint, iShard));
+			}
 		}
 		DEKAF2_CATCH(const std::exception& e)
 		{
@@ -577,8 +1089,11 @@ bool KTCPServer::SetupTCPAcceptors()
 		kDebug(2, "opening {} listener on port {}, asking for IPv4 only", IsTLS() ? "TLS" : "TCP", m_iPort);
 
 		tcp::endpoint local_endpoint(tcp::v4(), m_iPort);
-		auto acceptor = std::make_shared<tcp::acceptor>(m_asio, local_endpoint, true); // true means reuse_addr
-		m_TCPAcceptors.push_back(std::move(acceptor));
+
+		for (uint16_t iShard = 0; iShard < m_iAcceptShards; ++iShard)
+		{
+			m_TCPAcceptors.push_back(OpenTCPAcceptor(local_endpoint, iShard));
+		}
 	}
 
 	if (m_TCPAcceptors.empty())
@@ -586,10 +1101,11 @@ bool KTCPServer::SetupTCPAcceptors()
 		return SetError(kFormat("could not open any listener for port {}", m_iPort));
 	}
 
-	// post an async_accept for each acceptor
-	for (auto& acceptor : m_TCPAcceptors)
+	// post an async_accept for each acceptor - every address has m_iAcceptShards
+	// consecutive acceptors, one per shard
+	for (std::size_t i = 0; i < m_TCPAcceptors.size(); ++i)
 	{
-		StartTCPAccept(acceptor);
+		StartTCPAccept(m_TCPAcceptors[i], i % m_iAcceptShards);
 	}
 
 	return true;
@@ -597,7 +1113,40 @@ bool KTCPServer::SetupTCPAcceptors()
 } // SetupTCPAcceptors
 
 //-----------------------------------------------------------------------------
-void KTCPServer::StartTCPAccept(std::shared_ptr<tcp::acceptor> acceptor)
+boost::asio::io_service& KTCPServer::GetShardIO(std::size_t iShard)
+//-----------------------------------------------------------------------------
+{
+	return (iShard > 0 && iShard <= m_ShardIO.size()) ? *m_ShardIO[iShard - 1] : m_asio;
+
+} // GetShardIO
+
+//-----------------------------------------------------------------------------
+std::shared_ptr<tcp::acceptor> KTCPServer::OpenTCPAcceptor(const tcp::endpoint& Endpoint, std::size_t iShard)
+//-----------------------------------------------------------------------------
+{
+	if (m_iAcceptShards < 2)
+	{
+		return std::make_shared<tcp::acceptor>(m_asio, Endpoint, true); // true means reuse_addr
+	}
+
+	// the listeners of all shards bind to the same endpoint - this needs
+	// SO_REUSEPORT to be set before bind()
+	auto acceptor = std::make_shared<tcp::acceptor>(GetShardIO(iShard));
+
+	acceptor->open(Endpoint.protocol());
+	acceptor->set_option(tcp::acceptor::reuse_address(true));
+#ifdef SO_REUSEPORT
+	acceptor->set_option(boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>(true));
+#endif
+	acceptor->bind(Endpoint);
+	acceptor->listen();
+
+	return acceptor;
+
+} // OpenTCPAcceptor
+
+//-----------------------------------------------------------------------------
+void KTCPServer::StartTCPAccept(std::shared_ptr<tcp::acceptor> acceptor, std::size_t iShard)
 //-----------------------------------------------------------------------------
 {
 	// Ownership model for the pre-allocated stream:
@@ -626,9 +1175,9 @@ void KTCPServer::StartTCPAccept(std::shared_ptr<tcp::acceptor> acceptor)
 
 		acceptor->async_accept(socket,
 #if !DEKAF2_HAS_CPP_14 || DEKAF2_CLASSIC_ASIO
-			[this, acceptor, pStream](boost::system::error_code ec)
+			[this, acceptor, iShard, pStream](boost::system::error_code ec)
 #else
-			[this, acceptor, stream = std::move(stream_base)](boost::system::error_code ec) mutable
+			[this, acceptor, iShard, stream = std::move(stream_base)](boost::system::error_code ec) mutable
 #endif
 		{
 #if !DEKAF2_HAS_CPP_14 || DEKAF2_CLASSIC_ASIO
@@ -667,23 +1216,16 @@ void KTCPServer::StartTCPAccept(std::shared_ptr<tcp::acceptor> acceptor)
 
 				stream->SetNoDelay(true);
 
-#if !DEKAF2_HAS_CPP_14 || DEKAF2_CLASSIC_ASIO
-				auto* Stream = stream.release();
-				m_ThreadPool.push([ this, Stream ]() mutable
-				{
-					std::unique_ptr<KIOStreamSocket> moved_stream { Stream };
-					RunSession(moved_stream);
-				});
-#else
-				m_ThreadPool.push([ this, moved_stream = std::move(stream) ]() mutable
+				if (iShard < m_ShardAccepts.size())
 				{
-					RunSession(moved_stream);
-				});
-#endif
+					++m_ShardAccepts[iShard];
+				}
+
+				Dispatch(std::move(stream), iShard);
 			}
 
 			// chain the next accept
-			StartTCPAccept(acceptor);
+			StartTCPAccept(acceptor, iShard);
 		});
 	}
 	else
@@ -698,9 +1240,9 @@ void KTCPServer::StartTCPAccept(std::shared_ptr<tcp::acceptor> acceptor)
 
 		acceptor->async_accept(socket,
 #if !DEKAF2_HAS_CPP_14 || DEKAF2_CLASSIC_ASIO
-			[this, acceptor, pStream](boost::system::error_code ec)
+			[this, acceptor, iShard, pStream](boost::system::error_code ec)
 #else
-			[this, acceptor, stream = std::move(stream_base)](boost::system::error_code ec) mutable
+			[this, acceptor, iShard, stream = std::move(stream_base)](boost::system::error_code ec) mutable
 #endif
 		{
 #if !DEKAF2_HAS_CPP_14 || DEKAF2_CLASSIC_ASIO
@@ -739,23 +1281,16 @@ void KTCPServer::StartTCPAccept(std::shared_ptr<tcp::acceptor> acceptor)
 
 				stream->SetNoDelay(true);
 
-#if !DEKAF2_HAS_CPP_14 || DEKAF2_CLASSIC_ASIO
-				auto* Stream = stream.release();
-				m_ThreadPool.push([ this, Stream ]() mutable
-				{
-					std::unique_ptr<KIOStreamSocket> moved_stream { Stream };
-					RunSession(moved_stream);
-				});
-#else
-				m_ThreadPool.push([ this, moved_stream = std::move(stream) ]() mutable
+				if (iShard < m_ShardAccepts.size())
 				{
-					RunSession(moved_stream);
-				});
-#endif
+					++m_ShardAccepts[iShard];
+				}
+
+				Dispatch(std::move(stream), iShard);
 			}
 
 			// chain the next accept
-			StartTCPAccept(acceptor);
+			StartTCPAccept(acceptor, iShard);
 		});
 	}
 
@@ -848,19 +1383,7 @@ void KTCPServer::StartUnixAccept(std::shared_ptr<boost::asio::local::stream_prot
 			// down convert the type to a KIOStreamSocket*
 			std::unique_ptr<KIOStreamSocket> stream = std::move(unixstream);
 
-#if !DEKAF2_HAS_CPP_14 || DEKAF2_CLASSIC_ASIO
-			auto* Stream = stream.release();
-			m_ThreadPool.push([ this, Stream ]() mutable
-			{
-				std::unique_ptr<KIOStreamSocket> moved_stream { Stream };
-				RunSession(moved_stream);
-			});
-#else
-			m_ThreadPool.push([ this, moved_stream = std::move(stream) ]() mutable
-			{
-				RunSession(moved_stream);
-			});
-#endif
+			Dispatch(std::move(stream));
 		}
 
 		// chain the next accept
@@ -872,10 +1395,35 @@ void KTCPServer::StartUnixAccept(std::shared_ptr<boost::asio::local::stream_prot
 
 //-----------------------------------------------------------------------------
 /// Return server diagnostics like idle threads, total requests, uptime
-KThreadPool::Diagnostics KTCPServer::GetDiagnostics() const
+KTCPServer::Diagnostics KTCPServer::GetDiagnostics() const
 //-----------------------------------------------------------------------------
 {
-	return m_ThreadPool.get_diagnostics();
+	Diagnostics Diag;
+
+	static_cast<KThreadPool::Diagnostics&>(Diag) = m_ThreadPool.get_diagnostics();
+
+	for (const auto& Pool : m_ShardPools)
+	{
+		auto Shard = Pool->get_diagnostics();
+
+		Diag.iMaxThreadsEver  += Shard.iMaxThreadsEver;
+		Diag.iMaxThreads      += Shard.iMaxThreads;
+		Diag.iTotalThreads    += Shard.iTotalThreads;
+		Diag.iIdleThreads     += Shard.iIdleThreads;
+		Diag.iUsedThreads     += Shard.iUsedThreads;
+		Diag.iTotalTasks      += Shard.iTotalTasks;
+		Diag.iMaxWaitingTasks += Shard.iMaxWaitingTasks;
+		Diag.iWaitingTasks    += Shard.iWaitingTasks;
+	}
+
+	Diag.ShardAccepts.reserve(m_ShardAccepts.size());
+
+	for (const auto& iAccepts : m_ShardAccepts)
+	{
+		Diag.ShardAccepts.push_back(iAccepts.load(std::memory_order_relaxed));
+	}
+
+	return Diag;
 
 } // GetDiagnostics
 
@@ -883,6 +1431,14 @@ KThreadPool::Diagnostics KTCPServer::GetDiagnostics() const
 void KTCPServer::RegisterShutdownCallback(KThreadPool::ShutdownCallback callback)
 //-----------------------------------------------------------------------------
 {
+	// keep a copy for the shard pools, which are created by Start()
+	m_ShutdownCallback = callback;
+
+	for (auto& Pool : m_ShardPools)
+	{
+		Pool->register_shutdown_callback(callback);
+	}
+
 	m_ThreadPool.register_shutdown_callback(std::move(callback));
 
 } // RegisterShutdownCallback
@@ -983,12 +1539,47 @@ bool KTCPServer::RunServer()
 			}
 		}
 
+		if (m_Reactor)
+		{
+			m_IdleSweepTimer = std::make_unique<sweep_timer_type>(m_asio);
+			StartIdleSweep();
+		}
+
 		// mark as started before notifying waiters
 		++m_iStarted;
 		m_StartedUp.notify_all();
 
 		kDebug(2, "server is running");
 
+		// with several listener shards, every additional shard runs its accept loop
+		// on its own io_context and thread - Stop() stops and joins them
+		if (!m_TCPAcceptors.empty())
+		{
+			auto sPoolName = m_ThreadPool.get_thread_name();
+
+			for (std::size_t iShard = 1; iShard <= m_ShardIO.size(); ++iShard)
+			{
+				auto& ShardIO = *m_ShardIO[iShard - 1];
+
+				m_ShardIOThreads.push_back(kMakeThread([&ShardIO, iShard, sPoolName]()
+				{
+					if (!sPoolName.empty())
+					{
+						kSetThreadName(kFormat("{}:io{}", sPoolName, iShard));
+					}
+
+					DEKAF2_TRY
+					{
+						ShardIO.run();
+					}
+					DEKAF2_CATCH(const std::exception& e)
+					{
+						kDebug(1, "exception in IO thread {}: {}", iShard, e.what());
+					}
+				}));
+			}
+		}
+
 		// run the io_context - this blocks until stop() is called
 		// or all async operations complete
 		m_asio.run();
@@ -1040,6 +1631,44 @@ bool KTCPServer::Start(KDuration Timeout, bool bBlock)
 		return false;
 	}
 
+	if (m_bEventDriven)
+	{
+		if (!m_Reactor)
+		{
+			m_Reactor = std::make_unique<Reactor>(*this);
+		}
+		else
+		{
+			// restart after a previous Stop()
+			m_Reactor->Start();
+		}
+	}
+
+	// the shard pools split the configured threads of the main pool, which serves shard 0
+	if (m_iAcceptShards > 1 && m_bShardThreadPools && !m_bEventDriven && m_ShardPools.empty())
+	{
+		std::size_t iMaxThreads = m_iMaxThreads ? m_iMaxThreads : std::thread::hardware_concurrency();
+		std::size_t iPerShard   = std::max((iMaxThreads + m_iAcceptShards - 1) / m_iAcceptShards, std::size_t(1));
+
+		m_ThreadPool.resize(iPerShard, m_Growth, m_Shrink);
+
+		auto sPoolName = m_ThreadPool.get_thread_name();
+
+		for (uint16_t iShard = 1; iShard < m_iAcceptShards; ++iShard)
+		{
+			auto Pool = std::make_unique<KThreadPool>(iPerShard,
+			                                          sPoolName.empty() ? KString{} : kFormat("{}.{}", sPoolName, iShard),
+			                                          m_Growth,
+			                                          m_Shrink);
+			if (m_ShutdownCallback)
+			{
+				Pool->register_shutdown_callback(m_ShutdownCallback);
+			}
+
+			m_ShardPools.push_back(std::move(Pool));
+		}
+	}
+
 	// start ACME certificate management - the first order runs in the background
 	// once the server is listening, until then the cert from SetupTLSContext serves
 	if (m_AcmeManager && !m_AcmeManager->Start(*m_TLSContext))
@@ -1111,6 +1740,7 @@ bool KTCPServer::Stop()
 			m_IOThread->join();
 		}
 		m_IOThread.reset();
+		StopShardIO();
 		m_bQuit = false;
 		return true;
 	}
@@ -1194,6 +1824,24 @@ bool KTCPServer::Stop()
 		m_IOThread->join();
 	}
 	m_IOThread.reset();
+	m_IdleSweepTimer.reset();
+
+	StopShardIO();
+
+	// the shard pools finish their running sessions and get recreated by the next Start()
+	for (auto& Pool : m_ShardPools)
+	{
+		Pool->stop();
+	}
+	m_ShardPools.clear();
+
+	if (m_Reactor)
+	{
+		// close all idle connections - connections currently served by a worker
+		// get closed when their round ends. The reactor itself stays alive until
+		// destruction, as workers may still hand back connections.
+		m_Reactor->Stop();
+	}
 
 	// release the TLS context
 	m_TLSContext.reset();
@@ -1205,6 +1853,26 @@ bool KTCPServer::Stop()
 } // Stop
 
 
+//-----------------------------------------------------------------------------
+void KTCPServer::StopShardIO()
+//-----------------------------------------------------------------------------
+{
+	for (auto& ShardIO : m_ShardIO)
+	{
+		ShardIO->stop();
+	}
+
+	for (auto& Thread : m_ShardIOThreads)
+	{
+		if (Thread.joinable())
+		{
+			Thread.join();
+		}
+	}
+	m_ShardIOThreads.clear();
+
+} // StopShardIO
+
 //-----------------------------------------------------------------------------
 bool KTCPServer::RegisterShutdownWithSignals(const std::vector<int>& Signals)
 //-----------------------------------------------------------------------------
@@ -1271,6 +1939,9 @@ KTCPServer::KTCPServer(
 //-----------------------------------------------------------------------------
 	: m_ThreadPool(iMaxThreads, sPoolThreadName, Growth, Shrink)
 	, m_iPort(iPort)
+	, m_iMaxThreads(iMaxThreads)
+	, m_Growth(Growth)
+	, m_Shrink(Shrink)
 	, m_bIsTLS(bTLS)
 	, m_bStoreNewCerts(bStoreNewCerts)
 {
@@ -1289,6 +1960,9 @@ KTCPServer::KTCPServer(
 	: m_ThreadPool(iMaxThreads, sPoolThreadName, Growth, Shrink)
 	, m_sSocketFile(sSocketFile)
 	, m_iPort(0)
+	, m_iMaxThreads(iMaxThreads)
+	, m_Growth(Growth)
+	, m_Shrink(Shrink)
 {
 }
 #endif
@@ -81,6 +81,8 @@
 #include <dekaf2/core/errors/kerror.h>
 #include <cinttypes>
 #include <thread>
+#include <atomic>
+#include <vector>
 #include <future>
 #include <mutex>
 #include <condition_variable>
@@ -305,6 +307,60 @@ public:
 		m_StreamOptions = Options;
 	}
 
+	//-----------------------------------------------------------------------------
+	/// Switch to event-driven connection handling. Idle connections are then not held by
+	/// a worker thread, but parked in a reactor thread (a KPoll watching their sockets). A
+	/// connection is handed to a worker only when its next request head is readable, and
+	/// returned to the reactor when EventSession() finishes - a small, fixed count of
+	/// worker threads can then serve a large count of mostly idle keep-alive clients.
+	/// Call before Start().
+	/// @param bYesNo switch event-driven mode on or off (default is off)
+	/// @param IdleTimeout parked connections without a new request for longer than this
+	/// duration are closed, defaults to 60 seconds
+	void SetEventDriven(bool bYesNo, KDuration IdleTimeout = chrono::seconds(60))
+	//-----------------------------------------------------------------------------
+	{
+		m_bEventDriven = bYesNo;
+		m_IdleTimeout  = IdleTimeout;
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Returns true if the server is configured for event-driven connection handling
+	bool IsEventDriven() const
+	//-----------------------------------------------------------------------------
+	{
+		return m_bEventDriven;
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Returns the count of idle connections currently parked in the reactor - always 0
+	/// if the server is not event-driven
+	std::size_t GetParkedConnections() const;
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// Open several listening sockets per address with SO_REUSEPORT, each with its own
+	/// accept loop, served by iShards IO threads - the kernel then distributes new
+	/// connections among the listeners. This helps with heavy connection churn, when a
+	/// single acceptor becomes the bottleneck. Note that with SO_REUSEPORT other processes
+	/// of the same user may bind to the port as well. Ignored for unix sockets and on
+	/// platforms without SO_REUSEPORT. Call before Start().
+	/// @param iShards count of listeners per address, 1 (the default) opens one listener
+	/// without SO_REUSEPORT
+	/// @param bShardThreadPools if true, each shard hands its connections to its own thread
+	/// pool, and the configured max thread count is split evenly among the pools. Not used
+	/// in event-driven mode, where the reactor dispatches to one pool.
+	void SetAcceptShards(uint16_t iShards, bool bShardThreadPools = false);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// Returns the count of listeners per address, see SetAcceptShards()
+	uint16_t GetAcceptShards() const
+	//-----------------------------------------------------------------------------
+	{
+		return m_iAcceptShards;
+	}
+
 	//-----------------------------------------------------------------------------
 	/// Start the server
 	/// @param Timeout Timeout for I/O operations (default 15 seconds)
@@ -339,9 +395,18 @@ public:
 	bool RegisterShutdownWithSignals(const std::vector<int>& Signals);
 	//-----------------------------------------------------------------------------
 
+	//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+	/// server diagnostics - the thread pool values are summed up over all shard pools
+	struct Diagnostics : public KThreadPool::Diagnostics
+	//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+	{
+		std::vector<std::size_t> ShardAccepts; ///< accepted connections per listener shard, see SetAcceptShards()
+
+	}; // Diagnostics
+
 	//-----------------------------------------------------------------------------
 	/// Return server diagnostics like idle threads, total requests, uptime
-	KThreadPool::Diagnostics GetDiagnostics() const;
+	Diagnostics GetDiagnostics() const;
 	//-----------------------------------------------------------------------------
 
 	//-----------------------------------------------------------------------------
@@ -383,6 +448,30 @@ protected:
 	virtual void Session(std::unique_ptr<KIOStreamSocket>& stream);
 	//-----------------------------------------------------------------------------
 
+	//-----------------------------------------------------------------------------
+	/// Virtual hook for event-driven mode (see SetEventDriven()), called in a worker
+	/// thread each time a request head is readable on the connection. Handle the
+	/// readable request(s) without waiting for further ones, then return true to park
+	/// the connection in the reactor until the next request arrives, or false to close
+	/// it. Resetting or moving the stream ends the server's ownership of the connection.
+	/// The default runs Session() and closes the connection afterwards.
+	/// @param stream the connection
+	/// @param parameters empty on the first call for a connection - set it to carry
+	/// state from one call to the next, it is destroyed when the connection closes
+	/// @return true to keep the connection, false to close it
+	virtual bool EventSession(std::unique_ptr<KIOStreamSocket>& stream, param_t& parameters);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// Virtual hook for event-driven mode, called in the reactor thread with the data
+	/// that is already readable on a parked, unencrypted connection (not consumed). Return
+	/// false to wait for more data before a worker gets the connection. The default tests
+	/// for a complete line, as read by the line based Request() hook.
+	/// @param sPeeked the readable data, may be truncated to a few kilobytes
+	/// @return true if the request head is complete
+	virtual bool IsRequestHeadComplete(KStringView sPeeked) const;
+	//-----------------------------------------------------------------------------
+
 	//-----------------------------------------------------------------------------
 	/// Virtual hook that is called immediately after accepting a new stream.
 	/// Default does nothing. Could be used to set stream parameters. If
@@ -474,7 +563,25 @@ private:
 
 	//-----------------------------------------------------------------------------
 	DEKAF2_PRIVATE
-	void StartTCPAccept(std::shared_ptr<boost::asio::ip::tcp::acceptor> acceptor);
+	void StartTCPAccept(std::shared_ptr<boost::asio::ip::tcp::acceptor> acceptor, std::size_t iShard);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// open one listener on the io_context of shard iShard, with SO_REUSEPORT if more than one shard is configured - throws on error
+	DEKAF2_PRIVATE
+	std::shared_ptr<boost::asio::ip::tcp::acceptor> OpenTCPAcceptor(const boost::asio::ip::tcp::endpoint& Endpoint, std::size_t iShard);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// returns the io_context that runs the accept loop of shard iShard
+	DEKAF2_PRIVATE
+	boost::asio::io_service& GetShardIO(std::size_t iShard);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// stop the io_contexts of the additional accept shards and join their threads
+	DEKAF2_PRIVATE
+	void StopShardIO();
 	//-----------------------------------------------------------------------------
 
 #ifdef DEKAF2_HAS_UNIX_SOCKETS
@@ -494,6 +601,36 @@ private:
 	void RunSession(std::unique_ptr<KIOStreamSocket>& stream);
 	//-----------------------------------------------------------------------------
 
+	//-----------------------------------------------------------------------------
+	DEKAF2_PRIVATE
+	bool RunEventSession(std::unique_ptr<KIOStreamSocket>& stream, param_t& parameters);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// hand a freshly accepted connection to a worker, or in event-driven mode to the reactor
+	DEKAF2_PRIVATE
+	void Dispatch(std::unique_ptr<KIOStreamSocket> stream, std::size_t iShard = 0);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// log a new connection and apply the configured socket options
+	DEKAF2_PRIVATE
+	void PrepareConnection(KIOStreamSocket& stream);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// log and disconnect a connection
+	DEKAF2_PRIVATE
+	void CloseConnection(KIOStreamSocket& stream);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	DEKAF2_PRIVATE
+	void StartIdleSweep();
+	//-----------------------------------------------------------------------------
+
+	class Reactor;
+
 	//-----------------------------------------------------------------------------
 	DEKAF2_PRIVATE
 	bool RunServer();
@@ -501,6 +638,10 @@ private:
 
 	boost::asio::io_service                   m_asio;
 	std::unique_ptr<std::thread>              m_IOThread;
+	// shard 0 accepts on m_asio, shards 1..n-1 each on their own io_context and thread
+	std::vector<std::unique_ptr<boost::asio::io_service>>
+	                                          m_ShardIO;
+	std::vector<std::thread>                  m_ShardIOThreads;
 	std::vector<std::shared_ptr<boost::asio::ip::tcp::acceptor>>
 	                                          m_TCPAcceptors;
 #ifdef DEKAF2_HAS_UNIX_SOCKETS
@@ -509,11 +650,21 @@ private:
 #endif
 	std::unique_ptr<KTLSContext>              m_TLSContext;
 	std::unique_ptr<KAcmeManager>             m_AcmeManager;
+	std::unique_ptr<Reactor>                  m_Reactor;
+#if DEKAF2_CLASSIC_ASIO
+	using sweep_timer_type = boost::asio::deadline_timer;
+#else
+	using sweep_timer_type = boost::asio::steady_timer;
+#endif
+	std::unique_ptr<sweep_timer_type>         m_IdleSweepTimer;
 	std::mutex                                m_StartupMutex;
 	std::condition_variable                   m_StartedUp;
 
 	std::vector<int>  m_RegisteredSignals;
 	KThreadPool       m_ThreadPool;
+	std::vector<std::unique_ptr<KThreadPool>> m_ShardPools;
+	std::vector<std::atomic<std::size_t>>     m_ShardAccepts;
+	KThreadPool::ShutdownCallback             m_ShutdownCallback;
 #ifdef DEKAF2_HAS_UNIX_SOCKETS
 	KString           m_sSocketFile;
 #endif
@@ -526,7 +677,12 @@ private:
 	std::future<int>  m_ResultAsFuture;
 	std::atomic<int>  m_iStarted              {     0 };
 	uint16_t          m_iPort                 {     0 };
+	uint16_t          m_iMaxThreads           {     0 };
+	uint16_t          m_iAcceptShards         {     1 };
+	KThreadPool::GrowthPolicy m_Growth        { KThreadPool::PrestartSome };
+	KThreadPool::ShrinkPolicy m_Shrink        { KThreadPool::ShrinkSome };
 	KDuration         m_Timeout               { KStreamOptions::GetDefaultTimeout() };
+	KDuration         m_IdleTimeout           { chrono::seconds(60) };
 	KStreamOptions    m_StreamOptions;
 	KHTTPVersion      m_HTTPVersion           { KHTTPVersion::none };
 	std::atomic<bool> m_bQuit                 { false };
@@ -534,6 +690,8 @@ private:
 	bool              m_bStartIPv6            {  true };
 	bool              m_bIsTLS                { false };
 	bool              m_bStoreNewCerts        {  true };
+	bool              m_bEventDriven          { false };
+	bool              m_bShardThreadPools     { false };
 	SelfSignedCertSANPolicy    m_SANPolicy     { SelfSignedCertSANPolicy::AllLocalNets };
 	std::vector<KString>       m_SANDomains;
 
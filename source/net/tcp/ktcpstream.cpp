@@ -249,12 +249,12 @@ bool KTCPStream::Connect(const KTCPEndPoint& Endpoint, KStreamOptions Options)
 
 	if (Good())
 	{
-		boost::asio::async_connect(GetTCPSocket(), hosts,
-		                           [&](const boost::system::error_code& ec,
+		KResolve::AsyncConnect(GetTCPSocket(), hosts, m_Stream.Timeout,
+		                       [&](const boost::system::error_code& ec,
 #if (DEKAF2_CLASSIC_ASIO)
-			                           KResolve::resolver_endpoint_tcp_type endpoint)
+			                       KResolve::resolver_endpoint_tcp_type endpoint)
 #else
-			                           const KResolve::resolver_endpoint_tcp_type& endpoint)
+			                       const KResolve::resolver_endpoint_tcp_type& endpoint)
 #endif
 		{
 			m_Stream.sEndpoint  = KResolve::PrintResolvedAddress(endpoint);
@@ -44,6 +44,17 @@
 #include <dekaf2/core/types/kfrozen.h>
 #include <openssl/opensslv.h>
 #include <openssl/ssl.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <openssl/x509.h>
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L && !defined(LIBRESSL_VERSION_NUMBER)
+	#include <openssl/core_names.h>
+	#include <openssl/params.h>
+#else
+	#include <openssl/hmac.h>
+#endif
+#include <cstring>
+#include <ctime>
 
 #if OPENSSL_VERSION_NUMBER >= 0x10101000L && !defined(LIBRESSL_VERSION_NUMBER)
 	#define DEKAF2_HAS_TLS_CLIENT_HELLO_CB 1
@@ -72,6 +83,60 @@ int GetALPNExDataIndex()
 
 } // GetALPNExDataIndex
 
+//-----------------------------------------------------------------------------
+// index for the KTLSContext owning an SSL_CTX, for the callbacks without a user argument
+int GetContextExDataIndex()
+//-----------------------------------------------------------------------------
+{
+	static int s_iIndex = ::SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+
+	return s_iIndex;
+
+} // GetContextExDataIndex
+
+//-----------------------------------------------------------------------------
+// index for the KTLSContext that accepted a connection, stored as SSL ex_data
+// before an SNI context switch - like OpenSSL's session_ctx it keeps serving
+// the session tickets of the connection
+int GetSessionContextExDataIndex()
+//-----------------------------------------------------------------------------
+{
+	static int s_iIndex = ::SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+
+	return s_iIndex;
+
+} // GetSessionContextExDataIndex
+
+//-----------------------------------------------------------------------------
+// index for the client session cache key stored as SSL ex_data
+int GetSessionKeyExDataIndex()
+//-----------------------------------------------------------------------------
+{
+	static int s_iIndex = ::SSL_get_ex_new_index(0, nullptr, nullptr, nullptr,
+	[](void*, void* ptr, CRYPTO_EX_DATA*, int, long, void*)
+	{
+		delete static_cast<KString*>(ptr);
+	});
+
+	return s_iIndex;
+
+} // GetSessionKeyExDataIndex
+
+//-----------------------------------------------------------------------------
+bool IsResumable(const ::SSL_SESSION* Session)
+//-----------------------------------------------------------------------------
+{
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L && !defined(LIBRESSL_VERSION_NUMBER)
+	if (!::SSL_SESSION_is_resumable(Session))
+	{
+		return false;
+	}
+#endif
+
+	return ::SSL_SESSION_get_time(Session) + ::SSL_SESSION_get_timeout(Session) > std::time(nullptr);
+
+} // IsResumable
+
 //-----------------------------------------------------------------------------
 // SNI hostnames are case insensitive, and may carry a trailing root dot
 KString NormalizeSNIName(KStringView sHostname)
@@ -304,12 +369,42 @@ bool KTLSContext::SetDefaults()
 
 	if (!sVerifyPath.empty())
 	{
-		return SetAdditionalTLSVerifyPath(sVerifyPath);
+		if (!SetAdditionalTLSVerifyPath(sVerifyPath))
+		{
+			return false;
+		}
 	}
 
 #endif
-	// when adding more code after the endif here,
-	// modify the return condition above to only return on false
+
+	auto* Ctx = m_Context.native_handle();
+
+	// the session callbacks find this object through the SSL_CTX
+	::SSL_CTX_set_ex_data(Ctx, GetContextExDataIndex(), this);
+
+	if (GetRole() == boost::asio::ssl::stream_base::server)
+	{
+		// replaced by a certificate digest once a certificate is set, see SetSessionIDContext()
+		static constexpr KStringView s_sSessionIDContext = "dekaf2";
+
+		::SSL_CTX_set_session_id_context(Ctx,
+		                                 reinterpret_cast<const unsigned char*>(s_sSessionIDContext.data()),
+		                                 static_cast<unsigned int>(s_sSessionIDContext.size()));
+
+		// use our own, rotating ticket keys instead of the static per context keys of OpenSSL
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L && !defined(LIBRESSL_VERSION_NUMBER)
+		::SSL_CTX_set_tlsext_ticket_key_evp_cb(Ctx, &TicketKeyCallback);
+#else
+		SSL_CTX_set_tlsext_ticket_key_cb(Ctx, &TicketKeyCallback);
+#endif
+	}
+	else
+	{
+		// OpenSSL's internal client cache is not keyed by endpoint - we keep our own
+		::SSL_CTX_set_session_cache_mode(Ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+		::SSL_CTX_sess_set_new_cb(Ctx, &NewSessionCallback);
+	}
+
 	return true;
 
 } // SetDefaults
@@ -546,6 +641,7 @@ int KTLSContext::ClientHelloCallback(ssl_st* ssl, int* al, void* arg)
 		if (Context)
 		{
 			kDebug(3, "switching TLS context for SNI host {}", Hello.sServerName);
+			::SSL_set_ex_data(ssl, GetSessionContextExDataIndex(), self);
 			::SSL_set_SSL_CTX(ssl, Context->m_Context.native_handle());
 		}
 	}
@@ -578,6 +674,7 @@ int KTLSContext::ServerNameCallback(ssl_st* ssl, int* al, void* arg)
 		if (Context)
 		{
 			kDebug(3, "switching TLS context for SNI host {}", Hello.sServerName);
+			::SSL_set_ex_data(ssl, GetSessionContextExDataIndex(), self);
 			::SSL_set_SSL_CTX(ssl, Context->m_Context.native_handle());
 		}
 	}
@@ -624,7 +721,8 @@ bool KTLSContext::LoadTLSCertificates(KStringViewZ sCert, KStringViewZ sKey, KSt
 	}
 
 	kDebug(2, "TLS certificates successfully {}", "loaded");
-	return true;
+
+	return SetSessionIDContext();
 
 } // LoadTLSCertificates
 
@@ -671,7 +769,8 @@ bool KTLSContext::SetTLSCertificates(KStringView sCert, KStringView sKey, KStrin
 	}
 
 	kDebug(2, "TLS certificates successfully {}", "set");
-	return true;
+
+	return SetSessionIDContext();
 
 #endif
 
@@ -989,5 +1088,470 @@ bool KTLSContext::SetALPNRaw(KStringView sALPN)
 
 } // SetALPNRaw
 
-DEKAF2_NAMESPACE_END
+//-----------------------------------------------------------------------------
+bool KTLSContext::SetSessionIDContext()
+//-----------------------------------------------------------------------------
+{
+	if (GetRole() != boost::asio::ssl::stream_base::server)
+	{
+		return true;
+	}
+
+	// sessions are only resumed by contexts with the same session id context - using
+	// the certificate digest keeps a session granted for one SNI host from being
+	// resumed for another one, while all servers of a cluster agree on the value
+	auto* Cert = ::SSL_CTX_get0_certificate(m_Context.native_handle());
+
+	if (!Cert)
+	{
+		return true;
+	}
+
+	unsigned char Digest[EVP_MAX_MD_SIZE];
+	unsigned int  iDigest { 0 };
+
+	if (!::X509_digest(Cert, ::EVP_sha256(), Digest, &iDigest))
+	{
+		return SetError("cannot compute the certificate digest");
+	}
+
+	if (!::SSL_CTX_set_session_id_context(m_Context.native_handle(), Digest,
+	                                      std::min(iDigest, static_cast<unsigned int>(SSL_MAX_SID_CTX_LENGTH))))
+	{
+		return SetError("cannot set the session id context");
+	}
+
+	return true;
+
+} // SetSessionIDContext
+
+//-----------------------------------------------------------------------------
+bool KTLSContext::SetSessionCache(std::size_t iMaxSessions, KDuration Timeout)
+//-----------------------------------------------------------------------------
+{
+	auto* Ctx = m_Context.native_handle();
 
+	if (GetRole() == boost::asio::ssl::stream_base::server)
+	{
+		if (iMaxSessions)
+		{
+			::SSL_CTX_set_session_cache_mode(Ctx, SSL_SESS_CACHE_SERVER);
+			::SSL_CTX_sess_set_cache_size(Ctx, static_cast<long>(iMaxSessions));
+		}
+		else
+		{
+			// also stop lookups of sessions that are already cached
+			::SSL_CTX_set_session_cache_mode(Ctx, SSL_SESS_CACHE_OFF | SSL_SESS_CACHE_NO_INTERNAL);
+		}
+
+		::SSL_CTX_set_timeout(Ctx, static_cast<long>(Timeout.seconds().count()));
+
+		return true;
+	}
+
+	auto Sessions = m_ClientSessions.unique();
+
+	Sessions->iMaxSessions = iMaxSessions;
+
+	if (iMaxSessions)
+	{
+		::SSL_CTX_set_session_cache_mode(Ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+
+		while (Sessions->Sessions.size() > iMaxSessions)
+		{
+			Sessions->Sessions.erase(Sessions->Sessions.begin());
+		}
+	}
+	else
+	{
+		::SSL_CTX_set_session_cache_mode(Ctx, SSL_SESS_CACHE_OFF);
+		Sessions->Sessions.clear();
+	}
+
+	return true;
+
+} // SetSessionCache
+
+//-----------------------------------------------------------------------------
+bool KTLSContext::SetSessionTickets(bool bEnable)
+//-----------------------------------------------------------------------------
+{
+	if (GetRole() != boost::asio::ssl::stream_base::server)
+	{
+		return SetError("session tickets are configured on server contexts");
+	}
+
+	if (bEnable)
+	{
+		::SSL_CTX_clear_options(m_Context.native_handle(), SSL_OP_NO_TICKET);
+	}
+	else
+	{
+		::SSL_CTX_set_options(m_Context.native_handle(), SSL_OP_NO_TICKET);
+	}
+
+	return true;
+
+} // SetSessionTickets
+
+//-----------------------------------------------------------------------------
+void KTLSContext::AddTicketKey(TicketKeys& Keys, const TicketKey& Key)
+//-----------------------------------------------------------------------------
+{
+	Keys.Keys.insert(Keys.Keys.begin(), Key);
+
+	if (Keys.Keys.size() > Keys.iKeepPrevious + 1)
+	{
+		Keys.Keys.resize(Keys.iKeepPrevious + 1);
+	}
+
+	Keys.tRotated = KSteadyTime::now();
+
+} // AddTicketKey
+
+//-----------------------------------------------------------------------------
+bool KTLSContext::SetSessionTicketKeyRotation(KDuration Interval, std::size_t iKeepPrevious)
+//-----------------------------------------------------------------------------
+{
+	if (GetRole() != boost::asio::ssl::stream_base::server)
+	{
+		return SetError("session tickets are configured on server contexts");
+	}
+
+	auto Keys = m_TicketKeys.unique();
+
+	Keys->Interval      = Interval;
+	Keys->iKeepPrevious = iKeepPrevious;
+
+	if (Keys->Keys.size() > iKeepPrevious + 1)
+	{
+		Keys->Keys.resize(iKeepPrevious + 1);
+	}
+
+	return true;
+
+} // SetSessionTicketKeyRotation
+
+//-----------------------------------------------------------------------------
+bool KTLSContext::RotateSessionTicketKey()
+//-----------------------------------------------------------------------------
+{
+	if (GetRole() != boost::asio::ssl::stream_base::server)
+	{
+		return SetError("session tickets are configured on server contexts");
+	}
+
+	TicketKey Key;
+
+	if (::RAND_bytes(reinterpret_cast<unsigned char*>(&Key), sizeof(Key)) != 1)
+	{
+		return SetError("cannot generate a session ticket key");
+	}
+
+	AddTicketKey(m_TicketKeys.unique().get(), Key);
+
+	kDebug(2, "rotated the session ticket key");
+
+	return true;
+
+} // RotateSessionTicketKey
+
+//-----------------------------------------------------------------------------
+bool KTLSContext::AddSessionTicketKey(KStringView sKey)
+//-----------------------------------------------------------------------------
+{
+	if (GetRole() != boost::asio::ssl::stream_base::server)
+	{
+		return SetError("session tickets are configured on server contexts");
+	}
+
+	TicketKey Key;
+
+	if (sKey.size() != sizeof(Key))
+	{
+		return SetError(kFormat("a session ticket key needs {} bytes, got {}", sizeof(Key), sKey.size()));
+	}
+
+	std::memcpy(&Key, sKey.data(), sizeof(Key));
+
+	auto Keys = m_TicketKeys.unique();
+
+	Keys->Interval = KDuration::zero();
+	AddTicketKey(Keys.get(), Key);
+
+	return true;
+
+} // AddSessionTicketKey
+
+//-----------------------------------------------------------------------------
+int KTLSContext::GetTicketKey(const unsigned char* pName, bool bEncrypt, TicketKey& Key)
+//-----------------------------------------------------------------------------
+{
+	auto Find = [&](const TicketKeys& Keys) -> int
+	{
+		if (bEncrypt)
+		{
+			if (Keys.Keys.empty())
+			{
+				return 0;
+			}
+
+			Key = Keys.Keys.front();
+			return 1;
+		}
+
+		for (std::size_t i = 0; i < Keys.Keys.size(); ++i)
+		{
+			if (!std::memcmp(Keys.Keys[i].Name, pName, sizeof(Key.Name)))
+			{
+				Key = Keys.Keys[i];
+				return i == 0 ? 1 : 2;
+			}
+		}
+
+		return 0;
+	};
+
+	auto NeedsRotation = [](const TicketKeys& Keys)
+	{
+		return Keys.Keys.empty()
+		    || (Keys.Interval > KDuration::zero() && KSteadyTime::now() - Keys.tRotated >= Keys.Interval);
+	};
+
+	{
+		auto Keys = m_TicketKeys.shared();
+
+		if (!NeedsRotation(Keys.get()))
+		{
+			return Find(Keys.get());
+		}
+	}
+
+	auto Keys = m_TicketKeys.unique();
+
+	// check again, another thread may have rotated in between
+	if (NeedsRotation(Keys.get()))
+	{
+		TicketKey NewKey;
+
+		if (::RAND_bytes(reinterpret_cast<unsigned char*>(&NewKey), sizeof(NewKey)) == 1)
+		{
+			kDebug(2, "rotating the session ticket key");
+			AddTicketKey(Keys.get(), NewKey);
+		}
+	}
+
+	return Find(Keys.get());
+
+} // GetTicketKey
+
+//-----------------------------------------------------------------------------
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L && !defined(LIBRESSL_VERSION_NUMBER)
+int KTLSContext::TicketKeyCallback(ssl_st* ssl, unsigned char* pName, unsigned char* pIV,
+                                   evp_cipher_ctx_st* pCipher, evp_mac_ctx_st* pHMAC, int iEncrypt)
+#else
+int KTLSContext::TicketKeyCallback(ssl_st* ssl, unsigned char* pName, unsigned char* pIV,
+                                   evp_cipher_ctx_st* pCipher, hmac_ctx_st* pHMAC, int iEncrypt)
+#endif
+//-----------------------------------------------------------------------------
+{
+	// the tickets belong to the context that accepted the connection, not to the
+	// one selected by SNI dispatch
+	auto* self = static_cast<KTLSContext*>(::SSL_get_ex_data(ssl, GetSessionContextExDataIndex()));
+
+	if (!self)
+	{
+		self = static_cast<KTLSContext*>(::SSL_CTX_get_ex_data(::SSL_get_SSL_CTX(ssl), GetContextExDataIndex()));
+	}
+
+	if (!self)
+	{
+		return iEncrypt ? -1 : 0;
+	}
+
+	TicketKey Key;
+
+	auto iResult = self->GetTicketKey(pName, iEncrypt != 0, Key);
+
+	if (!iResult)
+	{
+		// for decryption this means a full handshake
+		return iEncrypt ? -1 : 0;
+	}
+
+	if (iEncrypt)
+	{
+		std::memcpy(pName, Key.Name, sizeof(Key.Name));
+
+		if (::RAND_bytes(pIV, ::EVP_CIPHER_iv_length(::EVP_aes_256_cbc())) != 1 ||
+		    !::EVP_EncryptInit_ex(pCipher, ::EVP_aes_256_cbc(), nullptr, Key.AESKey, pIV))
+		{
+			return -1;
+		}
+	}
+	else if (!::EVP_DecryptInit_ex(pCipher, ::EVP_aes_256_cbc(), nullptr, Key.AESKey, pIV))
+	{
+		return -1;
+	}
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L && !defined(LIBRESSL_VERSION_NUMBER)
+	char sDigest[] = "SHA256";
+
+	::OSSL_PARAM Params[]
+	{
+		::OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY, Key.HMACSecret, sizeof(Key.HMACSecret)),
+		::OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, sDigest, 0),
+		::OSSL_PARAM_construct_end()
+	};
+
+	if (!::EVP_MAC_CTX_set_params(pHMAC, Params))
+	{
+		return -1;
+	}
+#else
+	if (!::HMAC_Init_ex(pHMAC, Key.HMACSecret, sizeof(Key.HMACSecret), ::EVP_sha256(), nullptr))
+	{
+		return -1;
+	}
+#endif
+
+	// 2 asks OpenSSL to renew a ticket encrypted with an older key
+	return iResult;
+
+} // TicketKeyCallback
+
+//-----------------------------------------------------------------------------
+void KTLSContext::SessionFree::operator()(ssl_session_st* Session) const
+//-----------------------------------------------------------------------------
+{
+	::SSL_SESSION_free(Session);
+}
+
+//-----------------------------------------------------------------------------
+bool KTLSContext::SetClientSession(ssl_st* ssl, KStringView sSessionKey)
+//-----------------------------------------------------------------------------
+{
+	if (!ssl || GetRole() != boost::asio::ssl::stream_base::client)
+	{
+		return false;
+	}
+
+	auto* sKey = new KString(sSessionKey);
+	auto* sOld = static_cast<KString*>(::SSL_get_ex_data(ssl, GetSessionKeyExDataIndex()));
+
+	if (!::SSL_set_ex_data(ssl, GetSessionKeyExDataIndex(), sKey))
+	{
+		delete sKey;
+		return false;
+	}
+
+	delete sOld;
+
+	auto Sessions = m_ClientSessions.shared();
+
+	auto it = Sessions->Sessions.find(*sKey);
+
+	if (it == Sessions->Sessions.end() || !IsResumable(it->second.get()))
+	{
+		return false;
+	}
+
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L && !defined(LIBRESSL_VERSION_NUMBER)
+	// the connection modifies the session it resumes, and a TLS 1.3 server does not
+	// always send a new ticket on resumption - offer a copy to keep the cached one
+	// usable for the next connection
+	SessionPtr Session(::SSL_SESSION_dup(it->second.get()));
+#else
+	auto* Session = it->second.get();
+#endif
+
+	// SSL_set_session() takes its own reference
+	if (!Session || ::SSL_set_session(ssl, &*Session) != 1)
+	{
+		return false;
+	}
+
+	kDebug(3, "offering a cached TLS session for {}", *sKey);
+
+	return true;
+
+} // SetClientSession
+
+//-----------------------------------------------------------------------------
+void KTLSContext::ClearClientSessions()
+//-----------------------------------------------------------------------------
+{
+	m_ClientSessions.unique()->Sessions.clear();
+
+} // ClearClientSessions
+
+//-----------------------------------------------------------------------------
+int KTLSContext::NewSessionCallback(ssl_st* ssl, ssl_session_st* session)
+//-----------------------------------------------------------------------------
+{
+	auto* sKey = static_cast<const KString*>(::SSL_get_ex_data(ssl, GetSessionKeyExDataIndex()));
+	auto* self = static_cast<KTLSContext*>(::SSL_CTX_get_ex_data(::SSL_get_SSL_CTX(ssl), GetContextExDataIndex()));
+
+	if (!sKey || !self || !IsResumable(session))
+	{
+		// we did not take the reference
+		return 0;
+	}
+
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L && !defined(LIBRESSL_VERSION_NUMBER)
+	// OpenSSL marks the session of a connection that is closed without a TLS shutdown
+	// as not resumable, which is the rule for dropped keep-alive connections - keep an
+	// independent copy instead of a reference to the connection's session
+	SessionPtr Session(::SSL_SESSION_dup(session));
+	int iTaken = 0;
+#else
+	SessionPtr Session(session);
+	int iTaken = 1;
+#endif
+
+	if (!Session)
+	{
+		return 0;
+	}
+
+	auto Sessions = self->m_ClientSessions.unique();
+
+	if (!Sessions->iMaxSessions)
+	{
+		return iTaken;
+	}
+
+	auto it = Sessions->Sessions.find(*sKey);
+
+	if (it != Sessions->Sessions.end())
+	{
+		// with TLS 1.3 the server may send more than one ticket - keep the newest
+		it->second = std::move(Session);
+		return iTaken;
+	}
+
+	if (Sessions->Sessions.size() >= Sessions->iMaxSessions)
+	{
+		// make room: drop the oldest session
+		auto Oldest = Sessions->Sessions.begin();
+
+		for (auto Cur = Oldest; Cur != Sessions->Sessions.end(); ++Cur)
+		{
+			if (::SSL_SESSION_get_time(Cur->second.get()) < ::SSL_SESSION_get_time(Oldest->second.get()))
+			{
+				Oldest = Cur;
+			}
+		}
+
+		Sessions->Sessions.erase(Oldest);
+	}
+
+	Sessions->Sessions.emplace(*sKey, std::move(Session));
+
+	kDebug(3, "cached a TLS session for {}", *sKey);
+
+	return iTaken;
+
+} // NewSessionCallback
+
+DEKAF2_NAMESPACE_END
@@ -49,12 +49,17 @@
 #include <dekaf2/net/util/kstreamoptions.h>
 #include <dekaf2/core/errors/kerror.h>
 #include <dekaf2/threading/primitives/kthreadsafe.h>
+#include <dekaf2/time/duration/kduration.h>
 #include <functional>
 #include <memory>
 #include <unordered_map>
 #include <vector>
 
 struct ssl_st;
+struct ssl_session_st;
+struct evp_cipher_ctx_st;
+struct evp_mac_ctx_st;
+struct hmac_ctx_st;
 
 DEKAF2_NAMESPACE_BEGIN
 
@@ -199,6 +204,62 @@ public:
 	bool SetAllowHTTP2(bool bAlsoAllowHTTP1 = true);
 	//-----------------------------------------------------------------------------
 
+	//-----------------------------------------------------------------------------
+	/// Server: set up the stateful session cache, which serves TLS 1.2 session ids, and
+	/// TLS 1.3 resumption when session tickets are switched off. The cache is shared with
+	/// all SNI contexts, a session is however only resumed with the certificate it was
+	/// created with.
+	/// Client: set up the per-endpoint session cache that lets reconnects to the same
+	/// endpoint do an abbreviated handshake. Enabled with 256 sessions by default.
+	/// @param iMaxSessions the maximum count of cached sessions, 0 switches the cache off
+	/// @param Timeout server only: the lifetime of cached sessions and of session tickets
+	bool SetSessionCache(std::size_t iMaxSessions, KDuration Timeout = chrono::minutes(5));
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// Server: switch stateless session tickets on or off - on by default. SNI contexts
+	/// follow the setting of the context that accepted the connection.
+	bool SetSessionTickets(bool bEnable);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// Server: set the rotation of the session ticket keys. New tickets are encrypted with
+	/// a fresh random key every Interval, and iKeepPrevious older keys still decrypt tickets
+	/// (a handshake resumed with an older key gets a new ticket). The default is one hour,
+	/// keeping one previous key.
+	/// @param Interval the rotation interval, zero switches automatic rotation off
+	/// @param iKeepPrevious the count of older keys that are still accepted
+	bool SetSessionTicketKeyRotation(KDuration Interval, std::size_t iKeepPrevious = 1);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// Server: immediately switch to a new random session ticket key
+	bool RotateSessionTicketKey();
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// Server: make sKey the current session ticket key, e.g. to share keys between the
+	/// servers of a cluster. Switches automatic rotation off - call again with the next
+	/// key to rotate.
+	/// @param sKey 80 bytes of random data: 16 bytes key name, 32 bytes HMAC secret,
+	/// 32 bytes AES key (the format of nginx' ssl_session_ticket_key files)
+	bool AddSessionTicketKey(KStringView sKey);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// Client: offer the session cached for sSessionKey on the connection ssl, and cache
+	/// the session the server grants on ssl under the same key. Call before the handshake.
+	/// KTLSStream and KQuicStream do this on Connect(), using host, port and verification
+	/// mode as the key.
+	/// @returns true if a cached session was offered
+	bool SetClientSession(ssl_st* ssl, KStringView sSessionKey);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// Client: remove all sessions from the per-endpoint session cache
+	void ClearClientSessions();
+	//-----------------------------------------------------------------------------
+
 	//-----------------------------------------------------------------------------
 	boost::asio::ssl::context& GetContext()
 	//-----------------------------------------------------------------------------
@@ -229,6 +290,12 @@ private:
 	bool SetALPNRaw(KStringView sALPN);
 	//-----------------------------------------------------------------------------
 
+	//-----------------------------------------------------------------------------
+	/// bind sessions to the certificate of this context
+	DEKAF2_PRIVATE
+	bool SetSessionIDContext();
+	//-----------------------------------------------------------------------------
+
 	//-----------------------------------------------------------------------------
 	DEKAF2_PRIVATE
 	std::string PasswordCallback(std::size_t max_length, boost::asio::ssl::context::password_purpose purpose) const;
@@ -265,6 +332,65 @@ private:
 	                              const unsigned char* in, unsigned int inlen, void* arg);
 	//-----------------------------------------------------------------------------
 
+	//-----------------------------------------------------------------------------
+	// client side: takes a new session into the per-endpoint cache
+	DEKAF2_PRIVATE
+	static int NewSessionCallback(ssl_st* ssl, ssl_session_st* session);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	// server side session ticket encryption and decryption
+	DEKAF2_PRIVATE
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L && !defined(LIBRESSL_VERSION_NUMBER)
+	static int TicketKeyCallback(ssl_st* ssl, unsigned char* pName, unsigned char* pIV,
+	                             evp_cipher_ctx_st* pCipher, evp_mac_ctx_st* pHMAC, int iEncrypt);
+#else
+	static int TicketKeyCallback(ssl_st* ssl, unsigned char* pName, unsigned char* pIV,
+	                             evp_cipher_ctx_st* pCipher, hmac_ctx_st* pHMAC, int iEncrypt);
+#endif
+	//-----------------------------------------------------------------------------
+
+	struct TicketKey
+	{
+		unsigned char Name[16];
+		unsigned char HMACSecret[32];
+		unsigned char AESKey[32];
+	};
+
+	struct TicketKeys
+	{
+		std::vector<TicketKey> Keys; // newest first
+		KSteadyTime            tRotated;
+		KDuration              Interval      { chrono::hours(1) };
+		std::size_t            iKeepPrevious { 1 };
+	};
+
+	//-----------------------------------------------------------------------------
+	/// add Key as the current ticket key, and drop keys beyond the ones to keep
+	DEKAF2_PRIVATE
+	static void AddTicketKey(TicketKeys& Keys, const TicketKey& Key);
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// for encryption, get the current key, for decryption the key with name pName
+	/// @returns 0 if no key was found, 1 for the current key, 2 for an older key
+	DEKAF2_PRIVATE
+	int GetTicketKey(const unsigned char* pName, bool bEncrypt, TicketKey& Key);
+	//-----------------------------------------------------------------------------
+
+	struct SessionFree
+	{
+		void operator()(ssl_session_st* Session) const;
+	};
+
+	using SessionPtr = std::unique_ptr<ssl_session_st, SessionFree>;
+
+	struct ClientSessions
+	{
+		std::unordered_map<KString, SessionPtr> Sessions;
+		std::size_t iMaxSessions { 256 };
+	};
+
 	struct SNIDispatch
 	{
 		std::unordered_map<KString, std::shared_ptr<KTLSContext>> Hosts;
@@ -279,6 +405,8 @@ private:
 	boost::asio::ssl::stream_base::handshake_type m_Role;
 	std::string m_sPassword;
 	KThreadSafe<SNIDispatch> m_SNIDispatch;
+	KThreadSafe<TicketKeys> m_TicketKeys;
+	KThreadSafe<ClientSessions> m_ClientSessions;
 
 }; // KTLSContext
 
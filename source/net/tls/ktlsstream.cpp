@@ -133,9 +133,10 @@ bool KTLSStream::Handshake()
 #ifdef DEKAF2_WITH_KLOG
 	if (DEKAF2_UNLIKELY(kWouldLog(2)))
 	{
-		kDebug (3, "TLS handshake successful, rx/tx {}/{} bytes",
+		kDebug (3, "TLS handshake successful, rx/tx {}/{} bytes{}",
 		       ::BIO_number_read(::SSL_get_rbio(ssl)),
-		       ::BIO_number_written(::SSL_get_wbio(ssl)));
+		       ::BIO_number_written(::SSL_get_wbio(ssl)),
+		       ::SSL_session_reused(ssl) ? ", session resumed" : "");
 
 		auto cipher = ::SSL_get_current_cipher(ssl);
 		kDebug(2, "TLS version: {}, cipher: {}",
@@ -539,12 +540,22 @@ bool KTLSStream::Connect(const KTCPEndPoint& Endpoint, KStreamOptions Options)
 			return SetError(kFormat("failed to set SNI hostname: {}", sHostname));
 		}
 
-		boost::asio::async_connect(GetTCPSocket(), hosts,
-		                           [&](const boost::system::error_code& ec,
+		if (GetContext().GetRole() == boost::asio::ssl::stream_base::client)
+		{
+			// offer the session of a previous connection to this endpoint for an abbreviated
+			// handshake - a resumed session skips the certificate check, therefore verified
+			// and unverified connections do not share sessions
+			m_Stream.TLSContext.SetClientSession(GetNativeTLSHandle(),
+			                                     kFormat("{}:{}{}", sHostname, Endpoint.Port.get(),
+			                                             m_StreamOptions.IsSet(KStreamOptions::VerifyCert) ? "" : ":noverify"));
+		}
+
+		KResolve::AsyncConnect(GetTCPSocket(), hosts, m_Stream.Timeout,
+		                       [&](const boost::system::error_code& ec,
 #if (DEKAF2_CLASSIC_ASIO)
-		                               KResolve::resolver_endpoint_tcp_type endpoint)
+		                           KResolve::resolver_endpoint_tcp_type endpoint)
 #else
-		                               const KResolve::resolver_endpoint_tcp_type& endpoint)
+		                           const KResolve::resolver_endpoint_tcp_type& endpoint)
 #endif
 		{
 			m_Stream.sEndpoint  = KResolve::PrintResolvedAddress(endpoint);
@@ -565,6 +576,14 @@ bool KTLSStream::Connect(const KTCPEndPoint& Endpoint, KStreamOptions Options)
 
 	Options.ApplySocketOptions(GetNativeSocket(), true);
 
+	if (GetContext().GetRole() == boost::asio::ssl::stream_base::client)
+	{
+		// after a resumed TLS 1.3 handshake the server has nothing to send until it sees
+		// the first request - with Nagle, that request waits for the delayed ACK of our
+		// Finished message
+		SetNoDelay(true);
+	}
+
 	kDebug(2, "connected to {}: {}", "endpoint", GetEndPointAddress());
 
 	return true;
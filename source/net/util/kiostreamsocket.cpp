@@ -49,6 +49,10 @@
 #include <dekaf2/net/util/kpoll.h>
 #include <openssl/ssl.h>
 
+#if DEKAF2_IS_LINUX
+	#include <sys/sendfile.h>
+#endif
+
 DEKAF2_NAMESPACE_BEGIN
 
 //-----------------------------------------------------------------------------
@@ -261,6 +265,84 @@ int KIOStreamSocket::CheckIfReadyRaw(int what, KDuration Timeout, bool bTimeoutI
 
 } // CheckIfReadyRaw
 
+//-----------------------------------------------------------------------------
+bool KIOStreamSocket::CanSendFile()
+//-----------------------------------------------------------------------------
+{
+#if DEKAF2_IS_LINUX
+	// streams around a std::iostream have no native socket
+	return !IsTLS() && GetNativeSocket() >= 0;
+#else
+	return false;
+#endif
+
+} // CanSendFile
+
+//-----------------------------------------------------------------------------
+std::size_t KIOStreamSocket::SendFile(int iFileDescriptor, uint64_t iOffset, std::size_t iCount)
+//-----------------------------------------------------------------------------
+{
+#if DEKAF2_IS_LINUX
+	if (!CanSendFile())
+	{
+		SetError("sendfile() is not possible on this stream");
+		return 0;
+	}
+
+	// everything buffered in the stream has to go out before the file content
+	if (!Flush().Good())
+	{
+		SetError("cannot flush the stream before sendfile()");
+		return 0;
+	}
+
+	auto        iSocket = GetNativeSocket();
+	off_t       iPos    = static_cast<off_t>(iOffset);
+	std::size_t iSent   = 0;
+
+	while (iSent < iCount)
+	{
+		// the kernel sends at most 0x7ffff000 bytes per call
+		auto iResult = ::sendfile(iSocket, iFileDescriptor, &iPos, std::min(iCount - iSent, std::size_t(0x7ffff000)));
+
+		if (iResult > 0)
+		{
+			iSent += static_cast<std::size_t>(iResult);
+		}
+		else if (iResult == 0)
+		{
+			SetError(kFormat("file ended {} bytes before the expected size", iCount - iSent));
+			break;
+		}
+		else if (errno == EAGAIN || errno == EWOULDBLOCK)
+		{
+			// the socket is non-blocking (asio sets it so) - wait until it drained
+			if (!CheckIfReadyRaw(POLLOUT, GetTimeout(), true))
+			{
+				break;
+			}
+		}
+		else if (errno != EINTR)
+		{
+			SetErrnoError("sendfile() failed: ");
+			break;
+		}
+	}
+
+	if (iSent < iCount)
+	{
+		// the peer cannot make sense of the remaining stream anymore
+		ostream().setstate(std::ios::badbit);
+	}
+
+	return iSent;
+#else
+	SetError("sendfile() is not supported on this platform");
+	return 0;
+#endif
+
+} // SendFile
+
 //-----------------------------------------------------------------------------
 bool KIOStreamSocket::StartManualTLSHandshake()
 //-----------------------------------------------------------------------------
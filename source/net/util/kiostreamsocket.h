@@ -205,6 +205,19 @@ public:
 	/// Get the I/O timeout
 	KDuration GetTimeout() const { return m_Timeout; }
 
+	/// can this stream send files with SendFile(), directly from a file descriptor into the socket? True
+	/// for plain TCP and unix stream sockets on Linux, false for TLS streams and on other platforms
+	bool CanSendFile();
+
+	/// Send a part of a file directly from its file descriptor into the socket, without copying it through
+	/// user space (Linux sendfile()). Pending output of the stream is flushed first. Check CanSendFile()
+	/// before calling this.
+	/// @param iFileDescriptor an open file descriptor of a regular file
+	/// @param iOffset the start position in the file
+	/// @param iCount the count of bytes to send
+	/// @return the count of sent bytes, less than iCount on error, timeout, or a truncated file
+	std::size_t SendFile(int iFileDescriptor, uint64_t iOffset, std::size_t iCount);
+
 	/// std::iostream interface to open a stream. Delegates to Connect()
 	/// @param Endpoint
 	/// KTCPEndPoint as the server to connect to - can be constructed from
@@ -252,25 +252,26 @@ void KPoll::Add(int fd, Parameters Parms)
 		// a fresh entry is armed by default
 		Parms.bArmed = true;
 
-#ifdef __cpp_lib_map_try_emplace
-		m_FileDescriptors.insert_or_assign(fd, std::move(Parms));
-#else
 		auto it = m_FileDescriptors.find(fd);
 
 		if (it != m_FileDescriptors.end())
 		{
-			it->second = std::move(Parms);
+			// the event mask may have changed - rebuild the poll vector
+			it->second  = std::move(Parms);
+			m_bModified = true;
 		}
 		else
 		{
+			// a new fd is appended to the poll vector the same way as a re-armed
+			// one, without a full rebuild - this keeps frequent Add() calls with
+			// bOnce cheap for large poll sets
 			m_FileDescriptors.emplace(fd, std::move(Parms));
+			m_ArmQueue.push_back(fd);
+			m_bArmPending = true;
 		}
-#endif
 
 		kDebug(2, "added file descriptor {}", fd);
 
-		m_bModified = true;
-
 		if (!m_Thread && m_bAutoStart)
 		{
 			StartLocked();
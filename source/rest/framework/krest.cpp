@@ -58,32 +58,86 @@ void KREST::Options::SetConnectionLimit(uint16_t iMaxConnectionsPerKey)
 	ConnectionLimiter = std::make_shared<KConnectionLimiter>(iMaxConnectionsPerKey);
 }
 
+//-----------------------------------------------------------------------------
+bool KREST::RESTServer::AcquireConnectionSlot (KIOStreamSocket& Stream, KConnectionLimiter::Guard& ConnectionGuard)
+//-----------------------------------------------------------------------------
+{
+	if (m_Options.ConnectionLimiter)
+	{
+		auto sRemoteIP = Stream.GetEndPointAddress().Serialize();
+
+		ConnectionGuard = m_Options.ConnectionLimiter->Acquire(sRemoteIP);
+
+		if (!ConnectionGuard)
+		{
+			kDebug(1, "rejecting connection from {}: {}", sRemoteIP, m_Options.ConnectionLimiter->GetLastError());
+			return false;
+		}
+	}
+
+	return true;
+
+} // AcquireConnectionSlot
+
 //-----------------------------------------------------------------------------
 void KREST::RESTServer::Session (std::unique_ptr<KIOStreamSocket>& Stream)
 //-----------------------------------------------------------------------------
 {
 	// per-IP connection limiting - acquire a slot before doing anything else.
 	// the RAII guard releases the slot when this function returns.
-	auto sRemoteIP = Stream->GetEndPointAddress().Serialize();
-
 	KConnectionLimiter::Guard ConnectionGuard;
 
-	if (m_Options.ConnectionLimiter)
+	if (!AcquireConnectionSlot(*Stream, ConnectionGuard))
 	{
-		ConnectionGuard = m_Options.ConnectionLimiter->Acquire(sRemoteIP);
+		return;
+	}
 
-		if (!ConnectionGuard)
+	Serve(Stream, nullptr);
+
+} // Session
+
+//-----------------------------------------------------------------------------
+bool KREST::RESTServer::EventSession (std::unique_ptr<KIOStreamSocket>& Stream, param_t& Parameters)
+//-----------------------------------------------------------------------------
+{
+	if (!Parameters)
+	{
+		// first request on this connection - the per-IP connection slot stays
+		// with the connection while it is parked between requests
+		auto ConnectionParms = std::make_unique<ConnectionParameters>();
+
+		if (!AcquireConnectionSlot(*Stream, ConnectionParms->ConnectionGuard))
 		{
-			kDebug(1, "rejecting connection from {}: {}", sRemoteIP, m_Options.ConnectionLimiter->GetLastError());
-			return;
+			return false;
 		}
+
+		Parameters = std::move(ConnectionParms);
 	}
 
+	return Serve(Stream, &static_cast<ConnectionParameters*>(Parameters.get())->State);
+
+} // EventSession
+
+//-----------------------------------------------------------------------------
+bool KREST::RESTServer::IsRequestHeadComplete (KStringView sPeeked) const
+//-----------------------------------------------------------------------------
+{
+	// the HTTP request head ends with an empty line - we also accept a bare LF
+	// as line end, as the header parser does
+	return sPeeked.contains("\r\n\r\n") || sPeeked.contains("\n\n");
+
+} // IsRequestHeadComplete
+
+//-----------------------------------------------------------------------------
+bool KREST::RESTServer::Serve (std::unique_ptr<KIOStreamSocket>& Stream, KRESTServer::ConnectionState* State)
+//-----------------------------------------------------------------------------
+{
 	KRESTServer RESTServer(m_Routes, m_Options);
 
 	// keep a pointer of the stream socket for REST routes that may want to
 	// interact directly with the socket
 	RESTServer.SetStreamSocket(*Stream);
+	RESTServer.SetSingleRequest(State);
 
 	// keep a local copy of the socket for KSocketWatch
 	auto nativeSocket = Stream->GetNativeSocket();
@@ -147,10 +201,12 @@ void KREST::RESTServer::Session (std::unique_ptr<KIOStreamSocket>& Stream)
 		m_Options.TrustedProxies
 	);
 
-	RESTServer.Execute();
+	bool bKeepAlive = RESTServer.Execute() && RESTServer.GetKeepalive();
 
 	if (RESTServer.SwitchToWebSocket())
 	{
+		bKeepAlive = false;
+
 		// the client requests a switch to the websocket protocol
 		if (RESTServer.GetWebSocketHandler())
 		{
@@ -189,7 +245,9 @@ void KREST::RESTServer::Session (std::unique_ptr<KIOStreamSocket>& Stream)
 		}
 	}
 
-} // Session
+	return bKeepAlive;
+
+} // Serve
 
 //-----------------------------------------------------------------------------
 KREST::~KREST()
@@ -378,6 +436,8 @@ bool KREST::ExecuteRequest(const Options& Options, const KRESTRoutes& Routes)
 
 				m_Server->SetStreamOptions(Options.StreamOptions);
 				m_Server->SetBindAddress(Options.sBindAddress);
+				m_Server->SetEventDriven(Options.bEventDriven, chrono::seconds(Options.iIdleTimeout));
+				m_Server->SetAcceptShards(Options.iAcceptShards, Options.bShardThreadPools);
 
 				m_Server->RegisterShutdownWithSignals(Options.RegisterSignalsForShutdown);
 				m_Server->RegisterShutdownCallback(m_ShutdownCallback);
@@ -413,6 +473,7 @@ bool KREST::ExecuteRequest(const Options& Options, const KRESTRoutes& Routes)
 																 Options.Shrink,
 																 "rest");
 
+				m_Server->SetEventDriven(Options.bEventDriven, chrono::seconds(Options.iIdleTimeout));
 				m_Server->RegisterShutdownWithSignals(Options.RegisterSignalsForShutdown);
 				m_Server->RegisterShutdownCallback(m_ShutdownCallback);
 
@@ -680,10 +741,10 @@ bool KREST::Good() const
 } // Good
 
 //-----------------------------------------------------------------------------
-KThreadPool::Diagnostics KREST::GetDiagnostics() const
+KTCPServer::Diagnostics KREST::GetDiagnostics() const
 //-----------------------------------------------------------------------------
 {
-	return m_Server ? m_Server->GetDiagnostics() : KThreadPool::Diagnostics{};
+	return m_Server ? m_Server->GetDiagnostics() : KTCPServer::Diagnostics{};
 
 } // GetDiagnostics
 
@@ -117,6 +117,20 @@ public:
 		/// max worker threads (default 50). One connection uses one worker thread.
 		/// If there are no idle worker threads, the connection request is put in an rx wait queue.
 		uint16_t iMaxConnections { 50 };
+		/// event-driven connection handling (default off): idle keep-alive connections do not hold
+		/// a worker thread, but wait in a reactor until their next request head is readable - then
+		/// iMaxConnections limits the requests in process, not the open connections. See
+		/// KTCPServer::SetEventDriven()
+		bool bEventDriven { false };
+		/// in event-driven mode, close connections that did not send a new request within this
+		/// many seconds (default 60)
+		uint16_t iIdleTimeout { 60 };
+		/// count of listeners per address for TCP servers (default 1) - more than one opens them
+		/// with SO_REUSEPORT and lets the kernel distribute new connections. See
+		/// KTCPServer::SetAcceptShards()
+		uint16_t iAcceptShards { 1 };
+		/// with more than one accept shard, give each shard its own worker thread pool
+		bool bShardThreadPools { false };
 		/// Growth policy for creation of new worker threads
 		KThreadPool::GrowthPolicy Growth { KThreadPool::PrestartSome };
 		/// Shrink policy for removal of idle worker threads
@@ -219,7 +233,7 @@ public:
 	bool Good() const;
 	/// get diagnostics when running with a TCP server
 	DEKAF2_NODISCARD
-	KThreadPool::Diagnostics GetDiagnostics() const;
+	KTCPServer::Diagnostics GetDiagnostics() const;
 	/// Returns the TLS context of a running HTTP server started with Execute(),
 	/// e.g. to configure SNI dispatch or attach an ACME manager. Returns nullptr
 	/// before Execute(), for non-TLS servers, and for non-server modes.
@@ -274,10 +288,39 @@ private:
 		void Session (std::unique_ptr<KIOStreamSocket>& Stream) override final;
 		//-----------------------------------------------------------------------------
 
+		//-----------------------------------------------------------------------------
+		bool EventSession (std::unique_ptr<KIOStreamSocket>& Stream, param_t& Parameters) override final;
+		//-----------------------------------------------------------------------------
+
+		//-----------------------------------------------------------------------------
+		bool IsRequestHeadComplete (KStringView sPeeked) const override final;
+		//-----------------------------------------------------------------------------
+
 	//----------
 	protected:
 	//----------
 
+		//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+		/// state that stays with a connection between the requests in event-driven mode
+		struct ConnectionParameters : public Parameters
+		//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+		{
+			KConnectionLimiter::Guard    ConnectionGuard;
+			KRESTServer::ConnectionState State;
+		};
+
+		//-----------------------------------------------------------------------------
+		/// acquire the per-IP connection slot, if connection limiting is configured
+		bool AcquireConnectionSlot (KIOStreamSocket& Stream, KConnectionLimiter::Guard& ConnectionGuard);
+		//-----------------------------------------------------------------------------
+
+		//-----------------------------------------------------------------------------
+		/// serve the request(s) of one connection
+		/// @param State the state of the connection, if not null return after the first request
+		/// @return true if the connection may be kept alive
+		bool Serve (std::unique_ptr<KIOStreamSocket>& Stream, KRESTServer::ConnectionState* State);
+		//-----------------------------------------------------------------------------
+
 		const KREST::Options& m_Options;
 		const KRESTRoutes&    m_Routes;
 		KSocketWatch&         m_SocketWatch;
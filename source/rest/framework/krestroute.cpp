@@ -335,6 +335,7 @@ KRESTRoutes::KRESTRoutes(KRESTRoute::RESTCallback DefaultRoute, KString sDocumen
 void KRESTRoutes::AddRoute(KRESTRoute _Route)
 //-----------------------------------------------------------------------------
 {
+	m_Index.Add(m_Routes.size(), _Route, _Route.m_bHasParameters || _Route.m_bHasWildCardFragment, true);
 	m_Routes.push_back(std::move(_Route));
 
 } // AddRoute
@@ -385,7 +386,7 @@ void KRESTRoutes::AddWebServer(KString sWWWDir, KString sRoute, KWebServerPermis
 	kDebug(2, "route : {}\nwww   : {}\nconfig: {}", sRoute, sWWWDir, jConfig.dump());
 
 	// register a single catch-all route (empty method matches any) - the permission check happens at request time
-	m_Routes.push_back(KRESTRoute(KHTTPMethod{KHTTPMethod::INVALID}, false, std::move(sRoute), std::move(sWWWDir), *this, &KRESTRoutes::WebServer, std::move(jConfig)));
+	AddRoute(KRESTRoute(KHTTPMethod{KHTTPMethod::INVALID}, false, std::move(sRoute), std::move(sWWWDir), *this, &KRESTRoutes::WebServer, std::move(jConfig)));
 
 } // AddWebServer
 
@@ -406,7 +407,7 @@ void KRESTRoutes::AddWebDAV(KString sWWWDir, KString sRoute, KWebServerPermissio
 	kDebug(2, "WebDAV route : {}\nwww          : {}\nconfig       : {}", sRoute, sWWWDir, jConfig.dump());
 
 	// register a single catch-all route (empty method matches any) - the permission check happens at request time
-	m_Routes.push_back(KRESTRoute(KHTTPMethod{KHTTPMethod::INVALID}, KRESTRoute::Options{KRESTRoute::Options::WEBDAV}, std::move(sRoute), std::move(sWWWDir), *this, &KRESTRoutes::WebDAVHandler, std::move(jConfig)));
+	AddRoute(KRESTRoute(KHTTPMethod{KHTTPMethod::INVALID}, KRESTRoute::Options{KRESTRoute::Options::WEBDAV}, std::move(sRoute), std::move(sWWWDir), *this, &KRESTRoutes::WebDAVHandler, std::move(jConfig)));
 
 } // AddWebDAV
 
@@ -494,6 +495,7 @@ void KRESTRoutes::clear()
 //-----------------------------------------------------------------------------
 {
 	m_Routes.clear();
+	m_Index.clear();
 	m_Rewrites.clear();
 	m_DefaultRoute.Callback = nullptr;
 
@@ -526,9 +528,14 @@ std::size_t KRESTRoutes::RegexMatchPath(KStringRef& sPath, const Rewrites& Rewri
 bool KRESTRoutes::CheckForWrongMethod(const KRESTPath& Path) const
 //-----------------------------------------------------------------------------
 {
+	detail::KHTTPRouteIndex::Candidates Candidates;
+	m_Index.FindCandidates(Path, Candidates);
+
 	// check if we only missed a route because of a wrong request method
-	for (const auto& it : m_Routes)
+	for (auto iRoute : Candidates)
 	{
+		const auto& it = m_Routes[iRoute];
+
 		// do not test if method was empty (= all would have matched) or OPTIONS
 		if (!it.Method.empty() && (it.Method != KHTTPMethod::OPTIONS))
 		{
@@ -555,9 +562,16 @@ const KRESTRoute& KRESTRoutes::FindRoute(const KRESTPath& Path, Parameters& Para
 
 	kDebug (2, "looking up: {} {}{}" , Path.Method.Serialize(), Path.sRoute, bIsWebSocket ? " (websocket)" : "");
 
+	// the index preselects the routes that could match the path, in the order
+	// of their registration
+	detail::KHTTPRouteIndex::Candidates Candidates;
+	m_Index.FindCandidates(Path, Candidates);
+
 	// check for a matching route
-	for (const auto& it : m_Routes)
+	for (auto iRoute : Candidates)
 	{
+		const auto& it = m_Routes[iRoute];
+
 		kDebug (3, "evaluating: {:<7} {}{}" , it.Method.Serialize(), it.sRoute, bIsWebSocket ? " (websocket)" : "");
 		if (it.Matches(Path, &Params, true, true, bIsWebSocket))
 		{
@@ -714,7 +728,11 @@ void KRESTRoutes::WebServer(KRESTServer& HTTP)
 			}
 			else
 			{
-				HTTP.SetStreamToOutput(WebServer.GetStreamForReading(), WebServer.GetFileSize());
+				// sends the file zero copy if the connection permits
+				if (!HTTP.SetFileRangeToOutput(WebServer.GetFileSystemPath(), WebServer.GetFileStart(), WebServer.GetFileSize()))
+				{
+					throw KHTTPError { KHTTPError::H4xx_NOTFOUND, "file not found" };
+				}
 			}
 			break;
 		}
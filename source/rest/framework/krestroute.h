@@ -723,6 +723,7 @@ private:
 	//-----------------------------------------------------------------------------
 
 	Routes     m_Routes;
+	detail::KHTTPRouteIndex m_Index;
 	Rewrites   m_Rewrites;
 	Redirects  m_Redirects;
 	KRESTRoute m_DefaultRoute;
@@ -60,6 +60,11 @@
 #include <dekaf2/core/types/kscopeguard.h>
 #include <utility>
 
+#if DEKAF2_IS_UNIX
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
 DEKAF2_NAMESPACE_BEGIN
 
 //-----------------------------------------------------------------------------
@@ -737,11 +742,20 @@ bool KRESTServer::Execute()
 
 	try
 	{
-		m_iRound = 0;
 		// per-connection state for NO_REPEAT_LOG suppression. NOT touched by
 		// clear() between keepalive rounds — the suppression depends on
 		// persisting the marker across rounds within the same connection.
-		m_pLastLoggedRoute = nullptr;
+		// In single request mode both continue from the previous request.
+		if (m_pConnectionState)
+		{
+			m_iRound           = m_pConnectionState->iRound;
+			m_pLastLoggedRoute = m_pConnectionState->pLastLoggedRoute;
+		}
+		else
+		{
+			m_iRound           = 0;
+			m_pLastLoggedRoute = nullptr;
+		}
 
 		for (;;)
 		{
@@ -776,16 +790,17 @@ bool KRESTServer::Execute()
 				m_iRequestHeaderLength = InputCounter.Count();
 			}
 
-			if (m_iRound == 0)
+			if (!m_Timers)
 			{
-				// check if we have to start the timers
+				// check if we have to start the timers (in the first round, or in
+				// each round in single request mode)
 				if (!m_Options.TimerHeader.empty() || m_Options.TimingCallback)
 				{
 					m_Timers = std::make_unique<KStopDurations>();
 					m_Timers->reserve(Timer::SEND + 1);
 				}
 			}
-			else if (m_Timers)
+			else
 			{
 				// we can only start the timer after the input header
 				// parsing completes, as otherwise we would also count
@@ -1135,6 +1150,14 @@ bool KRESTServer::Execute()
 				return true;
 			}
 
+			if (m_pConnectionState)
+			{
+				// the caller waits for the next request itself
+				m_pConnectionState->iRound           = m_iRound + 1;
+				m_pConnectionState->pLastLoggedRoute = m_pLastLoggedRoute;
+				return true;
+			}
+
 			// increase keepalive round explicitly here, not before..
 			++m_iRound;
 		}
@@ -1194,6 +1217,7 @@ bool KRESTServer::SetStreamToOutput(std::unique_ptr<KInStream> Stream, std::size
 	}
 
 	m_Stream = std::move(Stream);
+	m_sFileToOutput.clear();
 	m_iContentLength = iContentLength;
 	if (!bAllowCompression) m_bResponseCompression = false;
 
@@ -1201,6 +1225,101 @@ bool KRESTServer::SetStreamToOutput(std::unique_ptr<KInStream> Stream, std::size
 
 } // SetStreamToOutput
 
+//-----------------------------------------------------------------------------
+bool KRESTServer::SetFileRangeToOutput(KStringViewZ sFile, uint64_t iStart, std::size_t iSize, bool bAllowCompression)
+//-----------------------------------------------------------------------------
+{
+	auto iFileSize = kFileSize(sFile);
+
+	if (iFileSize == npos)
+	{
+		kDebug(1, "file does not exist: {}", sFile);
+		return false;
+	}
+
+	if (iStart > iFileSize || iSize > iFileSize - iStart)
+	{
+		kDebug(1, "range {}+{} exceeds file size {}: {}", iStart, iSize, iFileSize, sFile);
+		return false;
+	}
+
+	m_Stream.reset();
+	m_sFileToOutput      = sFile;
+	m_iFileToOutputStart = iStart;
+	m_iContentLength     = iSize;
+	if (!bAllowCompression) m_bResponseCompression = false;
+
+	return true;
+
+} // SetFileRangeToOutput
+
+//-----------------------------------------------------------------------------
+void KRESTServer::WriteFileToOutput(KInFile& File)
+//-----------------------------------------------------------------------------
+{
+	// the headers announced the content length already - if we cannot deliver all of
+	// it the client could not tell the truncated body from the next response, hence
+	// we have to close the connection
+#if DEKAF2_IS_UNIX
+	// zero copy is only possible if the body goes unaltered into a plain socket
+	if (m_StreamSocket
+		&& m_StreamSocket->CanSendFile()
+		&& &Response.UnfilteredStream() == static_cast<KOutStream*>(m_StreamSocket)
+		&& !Response.HasChunking()
+		&& !Response.Headers.contains(KHTTPHeader::CONTENT_ENCODING))
+	{
+		auto iFD = ::open(m_sFileToOutput.c_str(), O_RDONLY | O_CLOEXEC);
+
+		if (iFD >= 0)
+		{
+			kDebug(3, "sendfile {} bytes from {}", m_iContentLength, m_sFileToOutput);
+
+			// flush the headers, then send the file from the kernel side
+			Response.Flush();
+
+			auto iSent = m_StreamSocket->SendFile(iFD, m_iFileToOutputStart, m_iContentLength);
+
+			::close(iFD);
+
+			m_iTXBytes += iSent;
+
+			if (iSent != m_iContentLength)
+			{
+				kDebug(1, "sent only {} of {} bytes: {}", iSent, m_iContentLength, m_StreamSocket->GetLastError());
+				m_bKeepAlive = false;
+			}
+
+			return;
+		}
+
+		kDebug(1, "cannot open file for sendfile, streaming it instead: {}", m_sFileToOutput);
+	}
+#endif
+
+	// stream through the output filters, with a buffer large enough to cut
+	// down the count of reads, writes and TLS records
+	constexpr std::size_t iBufferSize = 256 * 1024;
+	auto Buffer    = std::make_unique<char[]>(iBufferSize);
+	auto iToSend   = m_iContentLength;
+
+	kDebug(3, "stream {} bytes from {}", iToSend, m_sFileToOutput);
+
+	while (iToSend)
+	{
+		auto iRead = File.Read(Buffer.get(), std::min(iToSend, iBufferSize));
+
+		if (!iRead || Write(KStringView(Buffer.get(), iRead)) != iRead)
+		{
+			kDebug(1, "sent only {} of {} bytes", m_iContentLength - iToSend, m_iContentLength);
+			m_bKeepAlive = false;
+			break;
+		}
+
+		iToSend -= iRead;
+	}
+
+} // WriteFileToOutput
+
 //-----------------------------------------------------------------------------
 bool KRESTServer::SetFileToOutput(KStringViewZ sFile, bool bAllowCompression, bool bCheckMIMEType)
 //-----------------------------------------------------------------------------
@@ -1219,7 +1338,7 @@ bool KRESTServer::SetFileToOutput(KStringViewZ sFile, bool bAllowCompression, bo
 	}
 
 	kDebug(2, "open file: {}", sFile);
-	return SetStreamToOutput(std::make_unique<KInFile>(sFile), iContentLength, bAllowCompression);
+	return SetFileRangeToOutput(sFile, 0, iContentLength, bAllowCompression);
 
 } // SetFileToOutput
 
@@ -1320,6 +1439,37 @@ void KRESTServer::Stream(bool bAllowCompressionIfPossible, bool bWriteHeaders)
 
 } // Stream
 
+//-----------------------------------------------------------------------------
+void KRESTServer::StreamOutput(KStringView sContentType, const std::function<void(KOutStream&)>& Writer, bool bAllowCompressionIfPossible)
+//-----------------------------------------------------------------------------
+{
+	if (!sContentType.empty())
+	{
+		Response.Headers.Set(KHTTPHeader::CONTENT_TYPE, sContentType);
+	}
+
+	// we do not know the size of the body in advance
+	m_iContentLength = npos;
+	Response.Headers.Remove(KHTTPHeader::CONTENT_LENGTH);
+
+	if (Request.GetHTTPVersion() == KHTTPVersion::http11)
+	{
+		Response.Headers.Set(KHTTPHeader::TRANSFER_ENCODING, "chunked");
+	}
+	else
+	{
+		// the end of the body is signaled by closing the connection
+		m_bKeepAlive = false;
+	}
+
+	Stream(bAllowCompressionIfPossible, true);
+
+	Writer(Response.FilteredStream());
+
+	Response.Flush();
+
+} // StreamOutput
+
 //-----------------------------------------------------------------------------
 void KRESTServer::Output()
 //-----------------------------------------------------------------------------
@@ -1332,6 +1482,28 @@ void KRESTServer::Output()
 
 	ThrowIfDisconnected();
 
+	std::unique_ptr<KInFile> FileToOutput;
+
+	if (!m_sFileToOutput.empty())
+	{
+		// open the file before the headers go out, so that an unreadable file
+		// turns into an error response and not into a truncated one
+		FileToOutput = std::make_unique<KInFile>(m_sFileToOutput);
+
+		if (!FileToOutput->is_open() || (m_iFileToOutputStart && !FileToOutput->SetReadPosition(m_iFileToOutputStart)))
+		{
+			// do not send the start of the file for a range that starts later
+			throw KHTTPError { KHTTPError::H5xx_ERROR, kFormat("cannot read file: {}", m_sFileToOutput) };
+		}
+
+		if (m_Options.Out != HTTP)
+		{
+			// only the HTTP output sends files directly - all others read them as a stream
+			m_Stream = std::move(FileToOutput);
+			m_sFileToOutput.clear();
+		}
+	}
+
 	// with bEmitEmptyJsonContainers a handler that sets an empty array or object
 	// gets it serialized as [] or {} - only a never touched json.tx (null)
 	// produces no body. Without the option any empty json.tx produces no body.
@@ -1344,11 +1516,12 @@ void KRESTServer::Output()
 	// because for compressed output we would switch to chunked output, which would output
 	// some bytes even for empty bodies - which e.g. in case of websocket upgrades would
 	// cause browsers other than Firefox to choke.
-	bool bOutputContent = !m_sRawOutput.empty() ||
-	                       m_Stream             ||
-	                      !m_sMessage.empty()   ||
-	                       bHaveJsonToEmit()    ||
-	                      !xml.tx.empty()       ||
+	bool bOutputContent = !m_sRawOutput.empty()    ||
+	                       m_Stream                ||
+	                      !m_sFileToOutput.empty() ||
+	                      !m_sMessage.empty()      ||
+	                       bHaveJsonToEmit()       ||
+	                      !xml.tx.empty()          ||
 	                      (m_JsonLogger && !m_JsonLogger->empty() && !m_Options.KLogHeader.empty());
 
 	// do not create a response body for 101, 202 and 3xxs, or if no output anyway
@@ -1392,7 +1565,7 @@ void KRESTServer::Output()
 
 				m_iContentLength = sContent.length();
 			}
-			else if (DEKAF2_LIKELY(m_Stream == nullptr))
+			else if (DEKAF2_LIKELY(m_Stream == nullptr && m_sFileToOutput.empty()))
 			{
 				// the content:
 				if (!m_sMessage.empty())
@@ -1476,6 +1649,10 @@ void KRESTServer::Output()
 						Write (*m_Stream, m_iContentLength);
 					}
 				}
+				else if (FileToOutput)
+				{
+					WriteFileToOutput(*FileToOutput);
+				}
 				else
 				{
 					if (kWouldLog(4))
@@ -1707,6 +1884,7 @@ void KRESTServer::ErrorHandler(const std::exception& ex, bool bKeepAlive)
 	m_sMessage.clear();
 	m_sRawOutput.clear();
 	m_Stream.reset();
+	m_sFileToOutput.clear();
 	xml.tx.clear();
 
 	KJSON CleanJSON;
@@ -2053,6 +2231,8 @@ void KRESTServer::clear()
 	m_sMessage.clear();
 	m_sRawOutput.clear();
 	m_Stream.reset();
+	m_sFileToOutput.clear();
+	m_iFileToOutputStart   = 0;
 	m_iTXBytes             = 0;
 	m_iContentLength       = npos;
 	m_iRequestHeaderLength = 0;
@@ -50,6 +50,7 @@
 #include <dekaf2/time/duration/kduration.h>
 #include <dekaf2/crypto/auth/kopenid.h>
 #include <dekaf2/system/filesystem/kfilesystem.h>
+#include <dekaf2/io/readwrite/kreader.h>
 #include <dekaf2/net/util/kpoll.h>
 #include <dekaf2/http/server/khttplog.h>
 #include <dekaf2/http/websocket/kwebsocket.h>
@@ -320,6 +321,18 @@ public:
 	bool SetFileToOutput(KStringViewZ sFile, bool bAllowCompression = true, bool bCheckMIMEType = false);
 	//-----------------------------------------------------------------------------
 
+	//-----------------------------------------------------------------------------
+	/// set a range of a file to output (mutually exclusive to other output types). On plain TCP connections
+	/// with neither compression nor chunking the file is sent zero copy from the file into the socket with
+	/// sendfile(), otherwise it is streamed through a large buffer
+	/// @param sFile the filename of the file to output
+	/// @param iStart the first byte of the file to output
+	/// @param iSize the count of bytes to output from iStart on
+	/// @param bAllowCompression set to false to suppress transfer compression for this response
+	/// @return true if the file exists and the range is inside of it, false otherwise
+	bool SetFileRangeToOutput(KStringViewZ sFile, uint64_t iStart, std::size_t iSize, bool bAllowCompression = true);
+	//-----------------------------------------------------------------------------
+
 	//-----------------------------------------------------------------------------
 	/// set stream to output (mutually exclusive to other output types)
 	/// @param Stream an open stream to read from
@@ -574,6 +587,29 @@ public:
 		return m_bKeepAlive;
 	}
 
+	//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+	/// the state of a connection that is carried between the requests in single request mode
+	struct ConnectionState
+	//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+	{
+		const KRESTRoute* pLastLoggedRoute { nullptr }; ///< the last route written to the access log, for NO_REPEAT_LOG
+		uint16_t          iRound           { 0 };       ///< the count of previous requests on the connection
+	};
+
+	//-----------------------------------------------------------------------------
+	/// Let Execute() return after each request instead of waiting for the next one on a
+	/// keep-alive connection - GetKeepalive() then tells if the connection may serve another
+	/// request. Used by event-driven servers, which park idle connections in a reactor
+	/// instead of blocking a thread in the keep-alive read.
+	/// @param State the state of the connection, which keeps the keep-alive round count and
+	/// the access log suppression between the calls, or nullptr to serve all requests of the
+	/// connection in one call (the default)
+	void SetSingleRequest(ConnectionState* State)
+	//-----------------------------------------------------------------------------
+	{
+		m_pConnectionState = State;
+	}
+
 	//-----------------------------------------------------------------------------
 	/// @return the duration of a request until the last byte was sent
 	DEKAF2_NODISCARD
@@ -599,6 +635,17 @@ public:
 	void Stream(bool bAllowCompressionIfPossible, bool bWriteHeaders = true);
 	//-----------------------------------------------------------------------------
 
+	//-----------------------------------------------------------------------------
+	/// switch to streaming output with a body of unknown size, and let Writer write the body into the
+	/// output stream - e.g. with KSQL::OutputQuery() for large query results. On HTTP/1.1 the body is
+	/// sent with chunked transfer encoding, so that the connection can be kept alive, on HTTP/1.0 the
+	/// connection gets closed at the end of the body. The memory use is independent of the body size.
+	/// @param sContentType the Content-Type of the body, or empty to keep the current one
+	/// @param Writer callback that writes the body into the stream it gets as its argument
+	/// @param bAllowCompressionIfPossible switch compression on if possible
+	void StreamOutput(KStringView sContentType, const std::function<void(KOutStream&)>& Writer, bool bAllowCompressionIfPossible = true);
+	//-----------------------------------------------------------------------------
+
 	//-----------------------------------------------------------------------------
 	/// sets a callback that is called (once) after generating the response for the current request, directly before the
 	/// general logging.
@@ -817,6 +864,12 @@ protected:
 	void Output();
 	//-----------------------------------------------------------------------------
 
+	//-----------------------------------------------------------------------------
+	/// output the file set with SetFileRangeToOutput(), called by Output() with the
+	/// file already opened and positioned at the start of the range
+	void WriteFileToOutput(KInFile& File);
+	//-----------------------------------------------------------------------------
+
 	//-----------------------------------------------------------------------------
 	/// generate error output
 	/// @param ex the exception with the error status
@@ -874,6 +927,8 @@ private:
 	KString     m_sMessage;
 	KString     m_sRawOutput;
 	std::unique_ptr<KInStream> m_Stream; // stream that shall be sent
+	KString     m_sFileToOutput;         // file that shall be sent, from m_iFileToOutputStart on for m_iContentLength bytes
+	uint64_t    m_iFileToOutputStart { 0 };
 	std::size_t m_iTXBytes;              // size of sent headers and content, after compression
 	std::size_t m_iContentLength;        // content length for stream output (before compression)
 	std::size_t m_iRequestHeaderLength;  // size of received query and headers
@@ -913,6 +968,7 @@ private:
 #endif
 	};
 	bool m_bIsDisconnected { false };
+	ConnectionState* m_pConnectionState { nullptr }; // set in single request mode
 
 
 }; // KRESTServer
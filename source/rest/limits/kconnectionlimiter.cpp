@@ -42,17 +42,20 @@
 #include <dekaf2/rest/limits/kconnectionlimiter.h>
 #include <dekaf2/core/logging/klog.h>
 #include <dekaf2/core/format/kformat.h>
+#include <algorithm>
 
 DEKAF2_NAMESPACE_BEGIN
 
 //-----------------------------------------------------------------------------
-KConnectionLimiter::KConnectionLimiter(uint16_t iMaxConnectionsPerKey)
+KConnectionLimiter::KConnectionLimiter(uint16_t iMaxConnectionsPerKey, uint16_t iShards)
 //-----------------------------------------------------------------------------
 : m_iMaxConnections(iMaxConnectionsPerKey)
 {
 	if (m_iMaxConnections > 0)
 	{
-		kDebug(2, "connection limiter enabled: max {} per key", m_iMaxConnections);
+		m_Shards = std::vector<Shard>(std::max(iShards, uint16_t(1)));
+
+		kDebug(2, "connection limiter enabled: max {} per key, {} shards", m_iMaxConnections, m_Shards.size());
 	}
 
 } // ctor
@@ -61,26 +64,39 @@ KConnectionLimiter::KConnectionLimiter(uint16_t iMaxConnectionsPerKey)
 KConnectionLimiter::Guard KConnectionLimiter::AcquireImpl(KStringView sKey)
 //-----------------------------------------------------------------------------
 {
-	std::lock_guard<std::mutex> Lock(m_Mutex);
-
-	auto it = m_Connections.find(sKey);
+	auto&    shard = GetShard(sKey);
+	uint16_t iCount;
 
-	if (it == m_Connections.end())
 	{
-		// new key: insert with count 1
-		m_Connections.emplace(KString(sKey), uint16_t(1));
-		return Guard(this, KString(sKey), true);
+		std::lock_guard<std::mutex> Lock(shard.Mutex);
+
+		auto it = shard.Connections.find(sKey);
+
+		if (it == shard.Connections.end())
+		{
+			// new key: insert with count 1
+			shard.Connections.emplace(KString(sKey), uint16_t(1));
+			return Guard(this, KString(sKey), true);
+		}
+
+		if (it->second < m_iMaxConnections)
+		{
+			++(it->second);
+			return Guard(this, KString(sKey), true);
+		}
+
+		iCount = it->second;
 	}
 
-	if (it->second >= m_iMaxConnections)
+	kDebug(1, "connection limit exceeded for {} ({}/{})", sKey, iCount, m_iMaxConnections);
+
 	{
-		kDebug(1, "connection limit exceeded for {} ({}/{})", sKey, it->second, m_iMaxConnections);
-		SetError(kFormat("connection limit exceeded ({}/{})", it->second, m_iMaxConnections));
-		return Guard(nullptr, KString{}, false);
+		// the shards do not serialize the error anymore
+		std::lock_guard<std::mutex> Lock(m_ErrorMutex);
+		SetError(kFormat("connection limit exceeded ({}/{})", iCount, m_iMaxConnections));
 	}
 
-	++(it->second);
-	return Guard(this, KString(sKey), true);
+	return Guard(nullptr, KString{}, false);
 
 } // AcquireImpl
 
@@ -88,11 +104,13 @@ KConnectionLimiter::Guard KConnectionLimiter::AcquireImpl(KStringView sKey)
 void KConnectionLimiter::ReleaseImpl(const KString& sKey)
 //-----------------------------------------------------------------------------
 {
-	std::lock_guard<std::mutex> Lock(m_Mutex);
+	auto& shard = GetShard(sKey);
 
-	auto it = m_Connections.find(sKey);
+	std::lock_guard<std::mutex> Lock(shard.Mutex);
 
-	if (it == m_Connections.end())
+	auto it = shard.Connections.find(sKey);
+
+	if (it == shard.Connections.end())
 	{
 		kDebug(1, "connection limiter: release for unknown key {}", sKey);
 		return;
@@ -100,7 +118,7 @@ void KConnectionLimiter::ReleaseImpl(const KString& sKey)
 
 	if (--(it->second) == 0)
 	{
-		m_Connections.erase(it);
+		shard.Connections.erase(it);
 	}
 
 } // ReleaseImpl
@@ -122,8 +140,15 @@ void KConnectionLimiter::Guard::Release()
 std::size_t KConnectionLimiter::GetKeyCount() const
 //-----------------------------------------------------------------------------
 {
-	std::lock_guard<std::mutex> Lock(m_Mutex);
-	return m_Connections.size();
+	std::size_t iCount = 0;
+
+	for (const auto& shard : m_Shards)
+	{
+		std::lock_guard<std::mutex> Lock(shard.Mutex);
+		iCount += shard.Connections.size();
+	}
+
+	return iCount;
 
 } // GetKeyCount
 
@@ -131,11 +156,18 @@ std::size_t KConnectionLimiter::GetKeyCount() const
 uint16_t KConnectionLimiter::GetConnectionCount(KStringView sKey) const
 //-----------------------------------------------------------------------------
 {
-	std::lock_guard<std::mutex> Lock(m_Mutex);
+	if (m_Shards.empty())
+	{
+		return 0;
+	}
 
-	auto it = m_Connections.find(sKey);
+	auto& shard = GetShard(sKey);
 
-	if (it != m_Connections.end())
+	std::lock_guard<std::mutex> Lock(shard.Mutex);
+
+	auto it = shard.Connections.find(sKey);
+
+	if (it != shard.Connections.end())
 	{
 		return it->second;
 	}
@@ -148,13 +180,16 @@ uint16_t KConnectionLimiter::GetConnectionCount(KStringView sKey) const
 std::size_t KConnectionLimiter::GetTotalConnections() const
 //-----------------------------------------------------------------------------
 {
-	std::lock_guard<std::mutex> Lock(m_Mutex);
-
 	std::size_t iTotal = 0;
 
-	for (const auto& pair : m_Connections)
+	for (const auto& shard : m_Shards)
 	{
-		iTotal += pair.second;
+		std::lock_guard<std::mutex> Lock(shard.Mutex);
+
+		for (const auto& pair : shard.Connections)
+		{
+			iTotal += pair.second;
+		}
 	}
 
 	return iTotal;
@@ -50,6 +50,7 @@
 #include <dekaf2/core/errors/kerror.h>
 #include <dekaf2/containers/associative/kassociative.h>
 #include <mutex>
+#include <vector>
 
 DEKAF2_NAMESPACE_BEGIN
 
@@ -62,7 +63,9 @@ class KConnectionLimiter;
 /// Per-key concurrent connection limiter. Thread-safe. When iMaxConnections
 /// is 0 (the default), the limiter is completely disabled and Acquire() is
 /// a no-op with zero cost. Returns an RAII Guard that automatically releases
-/// the connection slot on destruction.
+/// the connection slot on destruction. The keys are spread over hash-striped
+/// shards, each with its own lock, so that acquiring slots for different keys
+/// does not serialize all connections on one mutex.
 class DEKAF2_PUBLIC KConnectionLimiter : public KErrorBase
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 {
@@ -140,12 +143,19 @@ public:
 
 	}; // Guard
 
+	/// the default count of shards
+	static constexpr uint16_t DefaultShards = 16;
+
 	/// default constructor - limiter is disabled (zero cost)
 	KConnectionLimiter() = default;
 
 	/// construct an active connection limiter
 	/// @param iMaxConnectionsPerKey maximum concurrent connections per key
-	KConnectionLimiter(uint16_t iMaxConnectionsPerKey);
+	/// @param iShards count of hash-striped shards for the keys, defaults to 16
+	KConnectionLimiter(uint16_t iMaxConnectionsPerKey, uint16_t iShards = DefaultShards);
+
+	KConnectionLimiter(const KConnectionLimiter&) = delete;
+	KConnectionLimiter& operator=(const KConnectionLimiter&) = delete;
 
 	/// check if this limiter is enabled
 	DEKAF2_NODISCARD
@@ -175,17 +185,32 @@ public:
 	DEKAF2_NODISCARD
 	std::size_t GetTotalConnections() const;
 
+	/// @return the number of shards
+	DEKAF2_NODISCARD
+	std::size_t GetShardCount() const { return m_Shards.size(); }
+
 //------
 private:
 //------
 
 	friend class Guard;
 
-	Guard AcquireImpl(KStringView sKey);
-	void  ReleaseImpl(const KString& sKey);
+	struct alignas(64) Shard
+	{
+		mutable std::mutex               Mutex;
+		KUnorderedMap<KString, uint16_t> Connections;
+	};
+
+	Guard  AcquireImpl(KStringView sKey);
+	void   ReleaseImpl(const KString& sKey);
+
+	DEKAF2_NODISCARD
+	Shard&       GetShard(KStringView sKey)       { return m_Shards[sKey.Hash() % m_Shards.size()]; }
+	DEKAF2_NODISCARD
+	const Shard& GetShard(KStringView sKey) const { return m_Shards[sKey.Hash() % m_Shards.size()]; }
 
-	mutable std::mutex             m_Mutex;
-	KUnorderedMap<KString, uint16_t> m_Connections;
+	std::vector<Shard>             m_Shards;
+	std::mutex                     m_ErrorMutex;
 	uint16_t                       m_iMaxConnections { 0 };
 
 }; // KConnectionLimiter
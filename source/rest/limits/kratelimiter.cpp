@@ -40,73 +40,149 @@
 */
 
 #include <dekaf2/rest/limits/kratelimiter.h>
+#include <dekaf2/core/init/dekaf2.h>
 #include <dekaf2/core/logging/klog.h>
 #include <dekaf2/core/format/kformat.h>
+#include <algorithm>
+#include <cmath>
 
 DEKAF2_NAMESPACE_BEGIN
 
 static constexpr KDuration s_CleanupInterval = chrono::seconds(60);
 static constexpr KDuration s_StaleTimeout    = chrono::seconds(60);
 
+namespace {
+
 //-----------------------------------------------------------------------------
-KRateLimiter::KRateLimiter(double dRequestsPerSecond, uint16_t iBurstSize)
+inline int64_t ToNanoseconds(KSteadyTime tTime)
 //-----------------------------------------------------------------------------
-: m_tLastCleanup(KSteadyTime::now())
-, m_dRate(dRequestsPerSecond)
-, m_iBurstSize(iBurstSize)
 {
-	if (m_dRate > 0 && m_iBurstSize < 1)
-	{
-		m_iBurstSize = 1;
-	}
+	return chrono::duration_cast<chrono::nanoseconds>(tTime.time_since_epoch()).count();
+}
 
+} // end of anonymous namespace
+
+//-----------------------------------------------------------------------------
+KRateLimiter::KRateLimiter(double dRequestsPerSecond, uint16_t iBurstSize, uint16_t iShards, bool bBackgroundCleanup)
+//-----------------------------------------------------------------------------
+: m_dRate(dRequestsPerSecond)
+, m_iBurstSize(iBurstSize)
+{
 	if (m_dRate > 0)
 	{
-		kDebug(2, "rate limiter enabled: {:.1f} req/s, burst {}", m_dRate, m_iBurstSize);
+		if (m_iBurstSize < 1)
+		{
+			m_iBurstSize = 1;
+		}
+
+		m_iInterval  = static_cast<int64_t>(std::llround(1000000000.0 / m_dRate));
+		m_iTolerance = m_iInterval * (m_iBurstSize - 1);
+		m_Shards     = std::vector<Shard>(std::max(iShards, uint16_t(1)));
+
+		if (bBackgroundCleanup)
+		{
+			// clean one shard per tick, so that each shard is visited once per cleanup interval
+			m_CleanupTimerID = Dekaf::getInstance().GetTimer().CallEvery(
+				s_CleanupInterval / m_Shards.size(),
+				[this](KUnixTime)
+				{
+					CleanupShard(m_Shards[m_iNextCleanup++ % m_Shards.size()], ToNanoseconds(KSteadyTime::now()));
+				},
+				/*bOwnThread=*/true);
+		}
+
+		kDebug(2, "rate limiter enabled: {:.1f} req/s, burst {}, {} shards", m_dRate, m_iBurstSize, m_Shards.size());
 	}
 
 } // ctor
 
 //-----------------------------------------------------------------------------
-bool KRateLimiter::CheckImpl(KStringView sKey, KSteadyTime tNow)
+KRateLimiter::~KRateLimiter()
 //-----------------------------------------------------------------------------
 {
-	std::lock_guard<std::mutex> Lock(m_Mutex);
+	if (m_CleanupTimerID != KTimer::InvalidID)
+	{
+		// waits for a cleanup in flight
+		Dekaf::getInstance().GetTimer().Cancel(m_CleanupTimerID);
+	}
 
-	CleanupIfNeeded(tNow);
+} // dtor
 
-	auto it = m_Buckets.find(sKey);
+//-----------------------------------------------------------------------------
+bool KRateLimiter::Consume(Bucket& bucket, int64_t iNow) const
+//-----------------------------------------------------------------------------
+{
+	auto iTAT = bucket.iTAT.load(std::memory_order_relaxed);
 
-	if (it == m_Buckets.end())
+	for (;;)
 	{
-		// new client: start with full burst minus one (this request)
-		it = m_Buckets.emplace(KString(sKey), Bucket { static_cast<double>(m_iBurstSize) - 1.0, tNow }).first;
-		return true;
+		if (iTAT - iNow > m_iTolerance)
+		{
+			// no token left
+			return false;
+		}
+
+		// an empty bucket refills from now on, a partially filled one from its last arrival time
+		auto iNewTAT = std::max(iTAT, iNow) + m_iInterval;
+
+		if (bucket.iTAT.compare_exchange_weak(iTAT, iNewTAT, std::memory_order_relaxed))
+		{
+			return true;
+		}
 	}
 
-	auto& bucket = it->second;
+} // Consume
+
+//-----------------------------------------------------------------------------
+bool KRateLimiter::CheckImpl(KStringView sKey, KSteadyTime tNow)
+//-----------------------------------------------------------------------------
+{
+	auto  iNow     = ToNanoseconds(tNow);
+	auto& shard    = GetShard(sKey);
+	bool  bAllowed = false;
+	bool  bFound   = false;
+
+	{
+		// the common case: a known key - the lookup only needs a shared lock
+		std::shared_lock<std::shared_mutex> Lock(shard.Mutex);
 
-	// refill tokens based on elapsed time
-	auto tElapsed = tNow - bucket.tLastRefill;
-	double dElapsedSeconds = chrono::duration_cast<chrono::microseconds>(tElapsed).count() / 1000000.0;
+		auto it = shard.Buckets.find(sKey);
 
-	if (dElapsedSeconds > 0)
+		if (it != shard.Buckets.end())
+		{
+			bFound   = true;
+			bAllowed = Consume(it->second, iNow);
+		}
+	}
+
+	if (!bFound)
 	{
-		bucket.dTokens = std::min(static_cast<double>(m_iBurstSize),
-		                          bucket.dTokens + dElapsedSeconds * m_dRate);
-		bucket.tLastRefill = tNow;
+		std::unique_lock<std::shared_mutex> Lock(shard.Mutex);
+
+		// check again, another thread may have inserted the key meanwhile
+		auto it = shard.Buckets.find(sKey);
+
+		if (it == shard.Buckets.end())
+		{
+			// new client: start with full burst minus one (this request)
+			shard.Buckets.emplace(KString(sKey), Bucket(iNow + m_iInterval));
+			return true;
+		}
+
+		bAllowed = Consume(it->second, iNow);
 	}
 
-	// try to consume one token
-	if (bucket.dTokens >= 1.0)
+	if (bAllowed)
 	{
-		bucket.dTokens -= 1.0;
 		return true;
 	}
 
 	// rate limit exceeded
 	kDebug(1, "rate limit exceeded for {}", sKey);
 
+	// the shards do not serialize the error anymore
+	std::lock_guard<std::mutex> Lock(m_ErrorMutex);
+
 	return SetError(kFormat("rate limit exceeded ({:.0f} req/s)", m_dRate));
 
 } // CheckImpl
@@ -115,8 +191,15 @@ bool KRateLimiter::CheckImpl(KStringView sKey, KSteadyTime tNow)
 std::size_t KRateLimiter::GetBucketCount() const
 //-----------------------------------------------------------------------------
 {
-	std::lock_guard<std::mutex> Lock(m_Mutex);
-	return m_Buckets.size();
+	std::size_t iCount { 0 };
+
+	for (const auto& shard : m_Shards)
+	{
+		std::shared_lock<std::shared_mutex> Lock(shard.Mutex);
+		iCount += shard.Buckets.size();
+	}
+
+	return iCount;
 
 } // GetBucketCount
 
@@ -124,31 +207,31 @@ std::size_t KRateLimiter::GetBucketCount() const
 void KRateLimiter::Cleanup(KSteadyTime tNow)
 //-----------------------------------------------------------------------------
 {
-	std::lock_guard<std::mutex> Lock(m_Mutex);
-	CleanupIfNeeded(tNow);
+	auto iNow = ToNanoseconds(tNow);
+
+	for (auto& shard : m_Shards)
+	{
+		CleanupShard(shard, iNow);
+	}
 
 } // Cleanup
 
 //-----------------------------------------------------------------------------
-void KRateLimiter::CleanupIfNeeded(KSteadyTime tNow)
+void KRateLimiter::CleanupShard(Shard& shard, int64_t iNow)
 //-----------------------------------------------------------------------------
 {
-	// caller must hold m_Mutex
-
-	if (tNow - m_tLastCleanup < s_CleanupInterval)
-	{
-		return;
-	}
+	// a bucket is stale once it has been full for longer than the stale timeout
+	auto iStale = iNow - chrono::duration_cast<chrono::nanoseconds>(s_StaleTimeout).count();
 
-	m_tLastCleanup = tNow;
+	std::unique_lock<std::shared_mutex> Lock(shard.Mutex);
 
-	auto iSizeBefore = m_Buckets.size();
+	auto iSizeBefore = shard.Buckets.size();
 
-	for (auto it = m_Buckets.begin(); it != m_Buckets.end(); )
+	for (auto it = shard.Buckets.begin(); it != shard.Buckets.end(); )
 	{
-		if (tNow - it->second.tLastRefill > s_StaleTimeout)
+		if (it->second.iTAT.load(std::memory_order_relaxed) < iStale)
 		{
-			it = m_Buckets.erase(it);
+			it = shard.Buckets.erase(it);
 		}
 		else
 		{
@@ -156,13 +239,13 @@ void KRateLimiter::CleanupIfNeeded(KSteadyTime tNow)
 		}
 	}
 
-	auto iRemoved = iSizeBefore - m_Buckets.size();
+	auto iRemoved = iSizeBefore - shard.Buckets.size();
 
 	if (iRemoved > 0)
 	{
-		kDebug(3, "cleaned up {} stale rate limit buckets, {} remaining", iRemoved, m_Buckets.size());
+		kDebug(3, "cleaned up {} stale rate limit buckets, {} remaining in shard", iRemoved, shard.Buckets.size());
 	}
 
-} // CleanupIfNeeded
+} // CleanupShard
 
 DEKAF2_NAMESPACE_END
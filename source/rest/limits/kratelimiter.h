@@ -45,12 +45,16 @@
 /// Token bucket rate limiter for request throttling
 
 #include <dekaf2/core/init/kdefinitions.h>
+#include <dekaf2/core/init/kcompatibility.h>
 #include <dekaf2/core/strings/kstring.h>
 #include <dekaf2/core/strings/kstringview.h>
 #include <dekaf2/time/duration/kduration.h>
+#include <dekaf2/time/duration/ktimer.h>
 #include <dekaf2/core/errors/kerror.h>
 #include <dekaf2/containers/associative/kassociative.h>
+#include <atomic>
 #include <mutex>
+#include <vector>
 
 DEKAF2_NAMESPACE_BEGIN
 
@@ -62,6 +66,11 @@ DEKAF2_NAMESPACE_BEGIN
 /// the limiter is completely disabled and Check() is a no-op with zero cost.
 /// By default, Check() returns false and sets an error message when a client
 /// exceeds its rate limit. With SetThrowOnError(true), it throws instead.
+/// The keys are spread over hash-striped shards, each with its own lock. The
+/// token bucket of a known key is updated lock-free (a single compare-and-swap
+/// on its theoretical arrival time), the shard lock is only held shared for the
+/// lookup, and exclusively for inserting new keys and for the cleanup of stale
+/// keys, which runs shard by shard on the Dekaf timer, not in the request path.
 class DEKAF2_PUBLIC KRateLimiter : public KErrorBase
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 {
@@ -70,13 +79,24 @@ class DEKAF2_PUBLIC KRateLimiter : public KErrorBase
 public:
 //------
 
+	/// the default count of shards
+	static constexpr uint16_t DefaultShards = 16;
+
 	/// default constructor - rate limiter is disabled (zero cost)
 	KRateLimiter() = default;
 
 	/// construct an active rate limiter
 	/// @param dRequestsPerSecond maximum sustained request rate per key
 	/// @param iBurstSize maximum burst capacity (tokens). Must be >= 1 when rate > 0.
-	KRateLimiter(double dRequestsPerSecond, uint16_t iBurstSize = 10);
+	/// @param iShards count of hash-striped shards for the keys, defaults to 16
+	/// @param bBackgroundCleanup if true (default), stale keys are removed periodically
+	/// on the Dekaf timer, else only by explicit calls to Cleanup()
+	KRateLimiter(double dRequestsPerSecond, uint16_t iBurstSize = 10, uint16_t iShards = DefaultShards, bool bBackgroundCleanup = true);
+
+	~KRateLimiter();
+
+	KRateLimiter(const KRateLimiter&) = delete;
+	KRateLimiter& operator=(const KRateLimiter&) = delete;
 
 	/// check if this rate limiter is enabled
 	DEKAF2_NODISCARD
@@ -110,7 +130,11 @@ public:
 	DEKAF2_NODISCARD
 	std::size_t GetBucketCount() const;
 
-	/// manually trigger cleanup of stale buckets
+	/// return the number of shards
+	DEKAF2_NODISCARD
+	std::size_t GetShardCount() const { return m_Shards.size(); }
+
+	/// manually trigger cleanup of stale buckets in all shards
 	/// @param tNow the current time
 	void Cleanup(KSteadyTime tNow);
 
@@ -118,20 +142,37 @@ public:
 private:
 //------
 
+	// the token bucket is kept as its "theoretical arrival time" (GCRA): a request
+	// is allowed as long as this time does not run more than the burst tolerance
+	// ahead of now, and each allowed request advances it by one emission interval
 	struct Bucket
 	{
-		double      dTokens;
-		KSteadyTime tLastRefill;
+		Bucket(int64_t iTAT) noexcept : iTAT(iTAT) {}
+		// only used when inserting into the map, before the bucket is shared
+		Bucket(Bucket&& other) noexcept : iTAT(other.iTAT.load(std::memory_order_relaxed)) {}
+
+		std::atomic<int64_t> iTAT;
 	};
 
-	bool CheckImpl(KStringView sKey, KSteadyTime tNow);
-	void CleanupIfNeeded(KSteadyTime tNow);
+	struct alignas(64) Shard
+	{
+		mutable std::shared_mutex      Mutex;
+		KUnorderedMap<KString, Bucket> Buckets;
+	};
 
-	mutable std::mutex m_Mutex;
-	KUnorderedMap<KString, Bucket>  m_Buckets;
-	KSteadyTime m_tLastCleanup;
-	double      m_dRate      { 0 };  // tokens per second
-	uint16_t    m_iBurstSize { 0 };  // max tokens (burst capacity)
+	bool   CheckImpl     (KStringView sKey, KSteadyTime tNow);
+	bool   Consume       (Bucket& bucket, int64_t iNow) const;
+	Shard& GetShard      (KStringView sKey) { return m_Shards[sKey.Hash() % m_Shards.size()]; }
+	void   CleanupShard  (Shard& shard, int64_t iNow);
+
+	std::vector<Shard>       m_Shards;
+	std::mutex               m_ErrorMutex;
+	std::atomic<std::size_t> m_iNextCleanup    { 0 };
+	KTimer::ID_t             m_CleanupTimerID  { KTimer::InvalidID };
+	double                   m_dRate           { 0 };  // tokens per second
+	int64_t                  m_iInterval       { 0 };  // nanoseconds per token
+	int64_t                  m_iTolerance      { 0 };  // nanoseconds of burst
+	uint16_t                 m_iBurstSize      { 0 };  // max tokens (burst capacity)
 
 }; // KRateLimiter
 
@@ -130,12 +130,16 @@ public:
 	/// returns file size, may be shorter than full file size in result of range requests
 	DEKAF2_NODISCARD
 	uint64_t GetFileSize() const { return m_iFileSize; }
+	/// returns the start position of the output in the file, may be > 0 in result of range requests
+	DEKAF2_NODISCARD
+	uint64_t GetFileStart() const { return m_iFileStart; }
 	/// returns file stream pointer to output file
 	DEKAF2_NODISCARD
 	std::unique_ptr<KInStream> GetStreamForReading() { return KFileServer::GetStreamForReading(m_iFileStart); }
 	/// returns true if this is a valid upload request
 	bool IsValid() const { return m_bIsValid; }
 
+	using KFileServer::GetFileSystemPath;
 	using KFileServer::GetMIMEType;
 	using KFileServer::IsAdHocIndex;
 	using KFileServer::GetAdHocIndex;
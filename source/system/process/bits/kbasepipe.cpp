@@ -97,11 +97,6 @@ bool KBasePipe::Open(KString sCommand, KStringViewZ sShell, OpenMode Mode, const
 
 	kDebug(2, "executing: {}", sCommand);
 
-	// we need to do the object allocations in the parent
-	// process as otherwise leak detectors would claim the
-	// child has lost allocated memory (as the child would
-	// never run the destructor)
-
 	std::vector<const char*> argV;
 
 	if (sShell.empty())
@@ -119,74 +114,46 @@ bool KBasePipe::Open(KString sCommand, KStringViewZ sShell, OpenMode Mode, const
 	// terminate with nullptr
 	argV.push_back(nullptr);
 
-	// create a child
-	switch (m_pid = ::fork())
+	// spawn the child: its stdin is the read end of the write pipe, its stdout
+	// the write end of the read pipe, and SIGPIPE is enabled. The additional
+	// environment variables are added to the ones inherited from the parent.
+	// posix_spawn() does not copy the page tables of the parent, and does not
+	// run any code of ours in the child.
+	m_pid = detail::kSpawn(argV.data(),
+	                       (m_Mode & PipeWrite) ? m_writePdes[0] : -1,
+	                       (m_Mode & PipeRead)  ? m_readPdes[1]  : -1,
+	                       KStringViewZ{},
+	                       Environment,
+	                       true);
+
+	if (m_pid < 0)
 	{
-		case -1: /* error */
+		auto iError = errno;
+
+		if (iError == ENOENT || iError == EACCES || iError == ENOEXEC)
+		{
+			kDebug(1, "cannot execute '{}': {}", sCommand, ::strerror(iError));
+			// this is what the shell would have returned
+			m_iExitCode = DEKAF2_POPEN_COMMAND_NOT_FOUND;
+		}
+		else
 		{
-			kWarning("cannot fork '{}': {}", sCommand, ::strerror(errno));
-
-			// could not create the child
-			if (m_Mode & PipeRead)
-			{
-				CloseAndResetFileDescriptor(m_readPdes[0]);
-				// the other side gets closed anyway in the regular parent code
-			}
-
-			if (m_Mode & PipeWrite)
-			{
-				CloseAndResetFileDescriptor(m_writePdes[1]);
-				// the other side gets closed anyway in the regular parent code
-			}
-
-			m_pid = 0;
-			break;
+			kWarning("cannot spawn '{}': {}", sCommand, ::strerror(iError));
+			m_iExitCode = iError;
 		}
 
-		case 0: /* child */
+		// could not create the child
+		for (auto& fd : m_readPdes)
 		{
-			detail::kCloseOwnFilesForExec(false, m_readPdes, 4);
-
-			// enable SIGPIPE!
-			::signal(SIGPIPE, SIG_DFL);
-
-			if (m_Mode & PipeWrite)
-			{
-				// Bind to Child's stdin
-				CloseAndResetFileDescriptor(m_writePdes[1]);
-				if (m_writePdes[0] != ::fileno(stdin))
-				{
-					::dup2(m_writePdes[0], ::fileno(stdin));
-					CloseAndResetFileDescriptor(m_writePdes[0]);
-				}
-			}
-
-			if (m_Mode & PipeRead)
-			{
-				// Bind Child's stdout
-				CloseAndResetFileDescriptor(m_readPdes[0]);
-				if (m_readPdes[1] != ::fileno(stdout))
-				{
-					::dup2(m_readPdes[1], ::fileno(stdout));
-					CloseAndResetFileDescriptor(m_readPdes[1]);
-				}
-			}
-
-			// set additional environment variables. execvpe() is a GNU extension
-			// and cannot be used on MacOS or Windows.
-			// also note that we do not replace the parent's environment, instead
-			// we inherit it
-			kSetEnv(Environment);
-
-			// execute the command
-			::execvp(argV[0], const_cast<char* const*>(argV.data()));
-
-			::_exit(DEKAF2_POPEN_COMMAND_NOT_FOUND);
+			CloseAndResetFileDescriptor(fd);
 		}
 
+		m_pid = 0;
+
+		return false;
 	}
 
-	// only parent gets here
+	// close the ends of the pipes that are used by the child
 
 	if (m_Mode & PipeRead)
 	{
@@ -48,6 +48,8 @@
 #include <dekaf2/core/strings/kstring.h>
 #include <dekaf2/core/logging/klog.h>
 #include <dekaf2/core/strings/ksplit.h>
+#include <dekaf2/core/format/kformat.h>
+#include <dekaf2/core/types/kctype.h>
 #include <dekaf2/time/duration/kduration.h>
 #include <dekaf2/system/os/ksignals.h>
 #include <dekaf2/core/init/kcompatibility.h>
@@ -57,8 +59,29 @@
 #include <fcntl.h>
 #include <signal.h>
 #include <dirent.h>
+#include <spawn.h>
 #include <cstdlib>
 
+#ifdef DEKAF2_IS_OSX
+	#include <crt_externs.h>
+	#define environ (*_NSGetEnviron())
+#else
+	extern char** environ;
+#endif
+
+// the non-portable file actions of posix_spawn() that we use when available
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 34))
+	#define DEKAF2_KSPAWN_HAS_CLOSEFROM 1
+	#define DEKAF2_KSPAWN_HAS_CHDIR 1
+#elif defined(__GLIBC__) && (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 29)
+	#define DEKAF2_KSPAWN_HAS_CHDIR 1
+#elif defined(__FreeBSD__) && defined(__FreeBSD_version) && __FreeBSD_version >= 1301000
+	#define DEKAF2_KSPAWN_HAS_CLOSEFROM 1
+	#define DEKAF2_KSPAWN_HAS_CHDIR 1
+#elif defined(DEKAF2_IS_OSX)
+	#define DEKAF2_KSPAWN_HAS_CHDIR 1
+#endif
+
 DEKAF2_NAMESPACE_BEGIN
 
 namespace detail {
@@ -140,6 +163,266 @@ void kCloseOwnFilesForExec(bool bIncludeStandardIO, int Exempt[], size_t iExempt
 
 } // kCloseOwnFilesForExec
 
+namespace {
+
+//-----------------------------------------------------------------------------
+/// the environment for a spawned child: the one of this process, with the changes from Environment
+class SpawnEnvironment
+//-----------------------------------------------------------------------------
+{
+
+//------
+public:
+//------
+
+	SpawnEnvironment(const std::vector<std::pair<KString, KString>>& Environment)
+	{
+		if (Environment.empty())
+		{
+			return;
+		}
+
+		// a later setting of the same variable wins, as it would with kSetEnv()
+		auto IsOverwritten = [&Environment](KStringView sName, std::size_t iFrom) -> bool
+		{
+			for (auto i = iFrom; i < Environment.size(); ++i)
+			{
+				if (Environment[i].first == sName)
+				{
+					return true;
+				}
+			}
+			return false;
+		};
+
+		for (char** pVar = environ; pVar && *pVar; ++pVar)
+		{
+			KStringView sVar(*pVar);
+
+			if (!IsOverwritten(sVar.substr(0, sVar.find('=')), 0))
+			{
+				m_Vars.push_back(*pVar);
+			}
+		}
+
+		m_Strings.reserve(Environment.size());
+
+		for (std::size_t i = 0; i < Environment.size(); ++i)
+		{
+			const auto& Var = Environment[i];
+
+			// an empty value removes the variable
+			if (!Var.second.empty() && !IsOverwritten(Var.first, i + 1))
+			{
+				m_Strings.push_back(kFormat("{}={}", Var.first, Var.second));
+				m_Vars.push_back(m_Strings.back().data());
+			}
+		}
+
+		m_Vars.push_back(nullptr);
+	}
+
+	/// returns the environment in the form that exec and posix_spawn expect
+	char* const* Get() const
+	{
+		return m_Vars.empty() ? environ : m_Vars.data();
+	}
+
+//------
+private:
+//------
+
+	std::vector<KString> m_Strings;
+	std::vector<char*>   m_Vars;
+
+}; // SpawnEnvironment
+
+#if !defined(DEKAF2_KSPAWN_HAS_CLOSEFROM) && !defined(DEKAF2_IS_OSX)
+//-----------------------------------------------------------------------------
+/// add a close action for all file descriptors >= 3 that would survive the exec
+void AddCloseOwnFiles(posix_spawn_file_actions_t& Actions)
+//-----------------------------------------------------------------------------
+{
+	auto AddClose = [&Actions](int fd)
+	{
+		auto iFlags = ::fcntl(fd, F_GETFD);
+
+		if (iFlags >= 0 && !(iFlags & FD_CLOEXEC))
+		{
+			::posix_spawn_file_actions_addclose(&Actions, fd);
+		}
+	};
+
+	auto* dir = opendir("/proc/self/fd");
+
+	if (dir)
+	{
+		auto iDirFD = ::dirfd(dir);
+
+		for (;;)
+		{
+			dirent* entry = readdir(dir);
+
+			if (!entry)
+			{
+				break;
+			}
+
+			KStringView sFileDescriptor(entry->d_name);
+
+			if (!sFileDescriptor.empty() && KASCII::kIsDigit(sFileDescriptor.front()))
+			{
+				int fd = sFileDescriptor.Int32();
+
+				if (fd >= 3 && fd != iDirFD)
+				{
+					AddClose(fd);
+				}
+			}
+		}
+
+		closedir(dir);
+	}
+	else
+	{
+		// just do a loop
+		for (int fd = 3; fd < 1024; ++fd)
+		{
+			AddClose(fd);
+		}
+	}
+
+} // AddCloseOwnFiles
+#endif
+
+} // end of anonymous namespace
+
+//-----------------------------------------------------------------------------
+pid_t kSpawn(const char* const argV[],
+             int iStdIn,
+             int iStdOut,
+             KStringViewZ sChangeDirectory,
+             const std::vector<std::pair<KString, KString>>& Environment,
+             bool bDefaultSIGPIPE)
+//-----------------------------------------------------------------------------
+{
+	if (!argV || !argV[0])
+	{
+		errno = EINVAL;
+		return -1;
+	}
+
+#ifndef DEKAF2_KSPAWN_HAS_CHDIR
+	if (!sChangeDirectory.empty())
+	{
+		errno = ENOTSUP;
+		return -1;
+	}
+#endif
+
+	// build the environment before spawning, the child cannot allocate
+	SpawnEnvironment Env(Environment);
+
+	pid_t pid    { -1 };
+	int   iError {  0 };
+
+	// without a closefrom action, the files to close are listed right before the spawn -
+	// if another thread closes one of them in between, the spawn fails with EBADF and
+	// we list them again
+	for (int iAttempt = 0; iAttempt < 5; ++iAttempt)
+	{
+		posix_spawn_file_actions_t Actions;
+		posix_spawnattr_t Attributes;
+
+		if ((iError = ::posix_spawn_file_actions_init(&Actions)))
+		{
+			break;
+		}
+
+		if ((iError = ::posix_spawnattr_init(&Attributes)))
+		{
+			::posix_spawn_file_actions_destroy(&Actions);
+			break;
+		}
+
+		short iFlags { 0 };
+
+		if (bDefaultSIGPIPE)
+		{
+			sigset_t Default;
+			sigemptyset(&Default);
+			sigaddset(&Default, SIGPIPE);
+			::posix_spawnattr_setsigdefault(&Attributes, &Default);
+			iFlags |= POSIX_SPAWN_SETSIGDEF;
+		}
+
+		if (iStdIn >= 0 && iStdIn != STDIN_FILENO)
+		{
+			::posix_spawn_file_actions_adddup2(&Actions, iStdIn, STDIN_FILENO);
+		}
+
+		if (iStdOut >= 0 && iStdOut != STDOUT_FILENO)
+		{
+			::posix_spawn_file_actions_adddup2(&Actions, iStdOut, STDOUT_FILENO);
+		}
+
+#ifdef DEKAF2_KSPAWN_HAS_CHDIR
+		if (!sChangeDirectory.empty())
+		{
+			::posix_spawn_file_actions_addchdir_np(&Actions, sChangeDirectory.c_str());
+		}
+#endif
+
+		// close all our other files in the child - the original pipe descriptors
+		// are closed as well, as the actions are executed in order
+#ifdef DEKAF2_KSPAWN_HAS_CLOSEFROM
+		::posix_spawn_file_actions_addclosefrom_np(&Actions, 3);
+#elif defined(DEKAF2_IS_OSX)
+		// all descriptors that are not explicitly inherited or dup2'ed are closed
+		iFlags |= POSIX_SPAWN_CLOEXEC_DEFAULT;
+
+		for (int fd = 0; fd < 3; ++fd)
+		{
+			if ((fd != STDIN_FILENO  || iStdIn  < 0) &&
+				(fd != STDOUT_FILENO || iStdOut < 0))
+			{
+				::posix_spawn_file_actions_addinherit_np(&Actions, fd);
+			}
+		}
+#else
+		// as the last action, to keep the window for other threads small
+		AddCloseOwnFiles(Actions);
+#endif
+
+		::posix_spawnattr_setflags(&Attributes, iFlags);
+
+		iError = ::posix_spawnp(&pid, argV[0], &Actions, &Attributes, const_cast<char* const*>(argV), Env.Get());
+
+		::posix_spawnattr_destroy(&Attributes);
+		::posix_spawn_file_actions_destroy(&Actions);
+
+#if !defined(DEKAF2_KSPAWN_HAS_CLOSEFROM) && !defined(DEKAF2_IS_OSX)
+		if (iError == EBADF)
+		{
+			kDebug(2, "a file to close was closed by another thread, retrying the spawn");
+			continue;
+		}
+#endif
+		break;
+	}
+
+	if (iError)
+	{
+		errno = iError;
+		return -1;
+	}
+
+	kDebug(2, "new pid: {}", pid);
+
+	return pid;
+
+} // kSpawn
+
 //-----------------------------------------------------------------------------
 void kDaemonize(bool bChangeDir)
 //-----------------------------------------------------------------------------
@@ -314,6 +597,25 @@ bool KChildProcess::Start(KString sCommand, KStringViewZ sChangeDirectory, bool
 	// execvp() needs a final nullptr in the array
 	cArgs.push_back(nullptr);
 
+	if (!bDaemonized)
+	{
+		// no code has to run in the child before exec, so we do not need to fork
+		auto pid = detail::kSpawn(cArgs.data(), -1, -1, sChangeDirectory);
+
+		if (pid > 0)
+		{
+			m_child = pid;
+			return true;
+		}
+
+		if (errno != ENOTSUP)
+		{
+			return SetErrnoError("posix_spawn(): ");
+		}
+
+		// this platform cannot change the directory of a spawned child - fork instead
+	}
+
 	pid_t pid;
 
 	if ((pid = fork()))
@@ -492,7 +794,7 @@ bool KChildProcess::Join(KDuration Timeout)
 			}
 
 		} while (!success
-				 && Timeout < Timer.elapsed());
+				 && Timer.elapsed() < Timeout);
 	}
 
 	if (success)
@@ -571,4 +873,7 @@ KChildProcess::~KChildProcess()
 
 DEKAF2_NAMESPACE_END
 
+#undef DEKAF2_KSPAWN_HAS_CLOSEFROM
+#undef DEKAF2_KSPAWN_HAS_CHDIR
+
 #endif // of !DEKAF2_IS_WINDOWS
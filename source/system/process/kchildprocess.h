@@ -53,6 +53,7 @@
 #include <dekaf2/time/duration/kduration.h>
 #include <dekaf2/core/strings/kstring.h>
 #include <dekaf2/core/errors/kerror.h>
+#include <vector>
 
 DEKAF2_NAMESPACE_BEGIN
 
@@ -83,6 +84,30 @@ DEKAF2_PUBLIC
 void kCloseOwnFilesForExec(bool bIncludeStandardIO, int Exempt[] = nullptr, size_t iExemptSize = 0);
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+/// Start a new process with posix_spawnp(). This does not copy the page tables
+/// of the parent (glibc and musl use vfork semantics, BSD and macOS have a
+/// native spawn), and no code of this process runs in the child, so no
+/// background threads need to be paused and no locks can be inherited in a
+/// locked state. The child inherits the environment of the parent. Its other
+/// file descriptors are closed before exec, like with kCloseOwnFilesForExec(false).
+/// @param argV the command and its arguments, terminated by a nullptr
+/// @param iStdIn file descriptor that becomes the child's stdin, or -1 to inherit stdin
+/// @param iStdOut file descriptor that becomes the child's stdout, or -1 to inherit stdout
+/// @param sChangeDirectory directory to change to before exec, or empty
+/// @param Environment additional environment variables for the child, an empty value removes a variable
+/// @param bDefaultSIGPIPE if true, the child gets the default SIGPIPE handler, even if this process ignores SIGPIPE
+/// @return the pid of the child, or -1 with errno set. errno is ENOTSUP if sChangeDirectory
+/// is not empty and the platform cannot change the directory in a spawned child
+DEKAF2_PUBLIC
+pid_t kSpawn(const char* const argV[],
+             int iStdIn = -1,
+             int iStdOut = -1,
+             KStringViewZ sChangeDirectory = KStringViewZ{},
+             const std::vector<std::pair<KString, KString>>& Environment = {},
+             bool bDefaultSIGPIPE = false);
+//-----------------------------------------------------------------------------
+
 } // end of namespace detail
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -113,7 +138,8 @@ public:
 	~KChildProcess();
 
 	/// Start a child with sCommand, change to sChangeDirectory, and detach
-	/// from terminal if bDaemonized is true
+	/// from terminal if bDaemonized is true. A child that is not daemonized is
+	/// started with posix_spawn(), without forking this process.
 	bool Start(KString sCommand,
 			   KStringViewZ sChangeDirectory = KStringViewZ{},
 			   bool bDaemonized = false);
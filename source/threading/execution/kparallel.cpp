@@ -40,6 +40,8 @@
 */
 
 #include <dekaf2/threading/execution/kparallel.h>
+#include <deque>
+#include <exception>
 
 DEKAF2_NAMESPACE_BEGIN
 
@@ -82,5 +84,325 @@ std::thread::id KRunThreads::Store(std::thread thread)
 
 } // Store
 
+namespace {
+
+// set for the workers, and for the calling thread while it participates in a job
+thread_local bool s_bInsideJob { false };
+
+} // end of anonymous namespace
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+struct KParallelScheduler::Job
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+{
+	struct Range
+	{
+		std::size_t iFrom;
+		std::size_t iTo;
+	};
+
+	// one per participating thread, aligned to avoid false sharing of the mutexes
+	struct alignas(64) Queue
+	{
+		std::mutex        Mutex;
+		std::deque<Range> Ranges;
+	};
+
+	Job(const Body& Work, std::size_t iSlots, std::size_t iGrain)
+	: Work(Work)
+	, Queues(iSlots)
+	, iGrain(iGrain)
+	{
+	}
+
+	const Body&              Work;
+	std::vector<Queue>       Queues;
+	std::size_t              iGrain;
+	std::atomic<std::size_t> iDone     { 0 };
+	std::size_t              iNextSlot { 1 }; // slot 0 is the calling thread, protected by m_Mutex
+	std::atomic<bool>        bAbort    { false };
+	std::size_t              iActive   { 0 }; // workers inside the job, protected by m_Mutex
+	std::mutex               ExceptionMutex;
+	std::exception_ptr       Exception;
+
+}; // Job
+
+//-----------------------------------------------------------------------------
+KParallelScheduler& KParallelScheduler::getInstance()
+//-----------------------------------------------------------------------------
+{
+	// on single core machines we still start one worker, to keep the code paths the same
+	static KParallelScheduler Scheduler(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+	return Scheduler;
+
+} // getInstance
+
+//-----------------------------------------------------------------------------
+KParallelScheduler::KParallelScheduler(std::size_t iWorkers)
+//-----------------------------------------------------------------------------
+{
+	for (std::size_t i = 0; i < iWorkers; ++i)
+	{
+		m_Workers.push_back(kMakeThread([this, i]()
+		{
+			kSetThreadName(kFormat("scheduler:{}", i));
+			WorkerLoop();
+		}));
+	}
+
+} // ctor
+
+//-----------------------------------------------------------------------------
+KParallelScheduler::~KParallelScheduler()
+//-----------------------------------------------------------------------------
+{
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		m_bStop = true;
+	}
+
+	m_NewJob.notify_all();
+
+	for (auto& Worker : m_Workers)
+	{
+		if (Worker.joinable())
+		{
+			Worker.join();
+		}
+	}
+
+} // dtor
+
+//-----------------------------------------------------------------------------
+bool KParallelScheduler::InsideJob()
+//-----------------------------------------------------------------------------
+{
+	return s_bInsideJob;
+
+} // InsideJob
+
+//-----------------------------------------------------------------------------
+KParallelScheduler::Job* KParallelScheduler::FindOpenJob()
+//-----------------------------------------------------------------------------
+{
+	// the oldest job first, so that it finishes before younger jobs get help
+	for (auto* Current : m_Jobs)
+	{
+		if (Current->iNextSlot < Current->Queues.size())
+		{
+			return Current;
+		}
+	}
+
+	return nullptr;
+
+} // FindOpenJob
+
+//-----------------------------------------------------------------------------
+void KParallelScheduler::WorkerLoop()
+//-----------------------------------------------------------------------------
+{
+	s_bInsideJob = true;
+
+	std::unique_lock<std::mutex> Lock(m_Mutex);
+
+	for (;;)
+	{
+		Job* Current { nullptr };
+
+		m_NewJob.wait(Lock, [&]()
+		{
+			return m_bStop || (Current = FindOpenJob()) != nullptr;
+		});
+
+		if (m_bStop)
+		{
+			return;
+		}
+
+		auto iSlot = Current->iNextSlot++;
+
+		// the calling thread waits until all workers have left the job
+		++Current->iActive;
+
+		Lock.unlock();
+		Participate(*Current, iSlot, nullptr);
+		Lock.lock();
+
+		if (--Current->iActive == 0)
+		{
+			m_JobDone.notify_all();
+		}
+	}
+
+} // WorkerLoop
+
+//-----------------------------------------------------------------------------
+void KParallelScheduler::Participate(Job& Current, std::size_t iSlot, const Progress* Progress)
+//-----------------------------------------------------------------------------
+{
+	auto& Own    = Current.Queues[iSlot];
+	auto  iSlots = Current.Queues.size();
+
+	for (;;)
+	{
+		Job::Range Range;
+		bool bFound { false };
+
+		{
+			// take the most recently pushed, smallest range from our own deque
+			std::lock_guard<std::mutex> Lock(Own.Mutex);
+
+			if (!Own.Ranges.empty())
+			{
+				Range = Own.Ranges.back();
+				Own.Ranges.pop_back();
+				bFound = true;
+			}
+		}
+
+		// else steal the oldest, largest range from another deque
+		for (std::size_t i = 1; !bFound && i < iSlots; ++i)
+		{
+			auto& Victim = Current.Queues[(iSlot + i) % iSlots];
+
+			std::lock_guard<std::mutex> Lock(Victim.Mutex);
+
+			if (!Victim.Ranges.empty())
+			{
+				Range = Victim.Ranges.front();
+				Victim.Ranges.pop_front();
+				bFound = true;
+			}
+		}
+
+		if (!bFound || Current.bAbort)
+		{
+			// the remaining ranges are in work by the other threads
+			return;
+		}
+
+		// split lazily: push back upper halves until the range is down to the grain size
+		while (Range.iTo - Range.iFrom > Current.iGrain)
+		{
+			auto iMid = Range.iFrom + (Range.iTo - Range.iFrom) / 2;
+
+			std::lock_guard<std::mutex> Lock(Own.Mutex);
+			Own.Ranges.push_back({ iMid, Range.iTo });
+			Range.iTo = iMid;
+		}
+
+		DEKAF2_TRY
+		{
+			Current.Work(Range.iFrom, Range.iTo);
+		}
+		DEKAF2_CATCH(...)
+		{
+			std::lock_guard<std::mutex> Lock(Current.ExceptionMutex);
+
+			if (!Current.Exception)
+			{
+				Current.Exception = std::current_exception();
+			}
+
+			Current.bAbort = true;
+			return;
+		}
+
+		auto iDone = Current.iDone += Range.iTo - Range.iFrom;
+
+		if (Progress)
+		{
+			(*Progress)(iDone);
+		}
+	}
+
+} // Participate
+
+//-----------------------------------------------------------------------------
+void KParallelScheduler::Run(std::size_t     iSize,
+                             const Body&     Body,
+                             std::size_t     iMaxThreads,
+                             std::size_t     iGrain,
+                             const Progress& Progress)
+//-----------------------------------------------------------------------------
+{
+	if (!iSize)
+	{
+		return;
+	}
+
+	auto iSlots = MaxThreads();
+
+	if (iMaxThreads && iMaxThreads < iSlots)
+	{
+		iSlots = iMaxThreads;
+	}
+
+	if (iGrain)
+	{
+		// not more threads than subranges
+		iSlots = std::min(iSlots, (iSize + iGrain - 1) / iGrain);
+	}
+	else
+	{
+		// adaptive: about 32 subranges per thread, the stealing balances the rest
+		iSlots = std::min(iSlots, iSize);
+		iGrain = std::max(iSize / (iSlots * 32), std::size_t(1));
+	}
+
+	if (iSlots < 2 || s_bInsideJob)
+	{
+		// a nested job, or not worth to wake other threads
+		Body(0, iSize);
+
+		if (Progress)
+		{
+			Progress(iSize);
+		}
+
+		return;
+	}
+
+	// jobs of different threads run concurrently, each on its own set of queues,
+	// and share the workers
+	Job Current(Body, iSlots, iGrain);
+
+	// start with an even distribution over all threads
+	for (std::size_t iSlot = 0; iSlot < iSlots; ++iSlot)
+	{
+		Current.Queues[iSlot].Ranges.push_back({ iSize * iSlot / iSlots, iSize * (iSlot + 1) / iSlots });
+	}
+
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		m_Jobs.push_back(&Current);
+	}
+
+	m_NewJob.notify_all();
+
+	s_bInsideJob = true;
+	Participate(Current, 0, Progress ? &Progress : nullptr);
+	s_bInsideJob = false;
+
+	{
+		std::unique_lock<std::mutex> Lock(m_Mutex);
+		// workers that did not yet pick up the job will not see it anymore
+		m_Jobs.erase(std::find(m_Jobs.begin(), m_Jobs.end(), &Current));
+		m_JobDone.wait(Lock, [&Current]() { return Current.iActive == 0; });
+	}
+
+	if (Current.Exception)
+	{
+		std::rethrow_exception(Current.Exception);
+	}
+
+	if (Progress)
+	{
+		Progress(iSize);
+	}
+
+} // Run
+
 DEKAF2_NAMESPACE_END
 
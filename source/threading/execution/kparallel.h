@@ -52,9 +52,14 @@
 #include <dekaf2/system/os/ksystem.h>
 #include <algorithm>
 #include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <iterator>
+#include <mutex>
 #include <thread>
 #include <utility>
 #include <unordered_map>
+#include <vector>
 
 DEKAF2_NAMESPACE_BEGIN
 
@@ -171,8 +176,105 @@ private:
 
 }; // KRunThreads
 
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+/// A persistent, process wide work stealing scheduler for the parallel algorithms
+/// kParallelFor(), kParallelTransform(), kParallelReduce(), kParallelSort() and
+/// kParallelForEach(). It starts its worker threads on first use and keeps them
+/// waiting for the next job. A job is an index range that is first divided evenly
+/// over the participating threads, each of them with its own deque of subranges.
+/// A thread halves its current range, pushing the upper half to the back of its
+/// deque, until it is down to the grain size, and processes that. When its own
+/// deque is empty, it steals from the front of the other deques, which holds the
+/// largest remaining ranges. The calling thread participates in its job.
+///
+/// Only one job runs at a time, concurrent callers wait for the running job. Jobs
+/// started from inside a running job are executed serially by the calling thread.
+class DEKAF2_PUBLIC KParallelScheduler
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+{
+
+//----------
+public:
+//----------
+
+	/// the work function, called with a subrange [iFrom, iTo)
+	using Body     = std::function<void(std::size_t iFrom, std::size_t iTo)>;
+	/// the progress function, called only from the thread that started the job, with the count of processed elements
+	using Progress = std::function<void(std::size_t iDone)>;
+
+	//-----------------------------------------------------------------------------
+	/// returns the process wide scheduler
+	static KParallelScheduler& getInstance();
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// stops and joins the worker threads
+	~KParallelScheduler();
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// returns the maximum count of threads for one job, including the calling thread
+	DEKAF2_NODISCARD
+	std::size_t MaxThreads() const { return m_Workers.size() + 1; }
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// returns true if the current thread is executing a job of the scheduler
+	DEKAF2_NODISCARD
+	static bool InsideJob();
+	//-----------------------------------------------------------------------------
+
+	//-----------------------------------------------------------------------------
+	/// run Body over the range [0, iSize), in subranges of at least iGrain elements
+	/// (0 = automatic), on at most iMaxThreads threads (0 = all). Returns when the whole
+	/// range is processed. If Body throws, the remaining subranges are skipped and the
+	/// first exception is rethrown in the calling thread.
+	void Run(std::size_t     iSize,
+	         const Body&     Body,
+	         std::size_t     iMaxThreads = 0,
+	         std::size_t     iGrain      = 0,
+	         const Progress& Progress    = nullptr);
+	//-----------------------------------------------------------------------------
+
+//----------
+private:
+//----------
+
+	struct Job;
+
+	KParallelScheduler(std::size_t iWorkers);
+
+	Job*        FindOpenJob();
+	void        WorkerLoop ();
+	static void Participate(Job& Current, std::size_t iSlot, const Progress* Progress);
+
+	std::vector<std::thread> m_Workers;
+	std::vector<Job*>        m_Jobs;  // the running jobs, protected by m_Mutex
+	std::mutex               m_Mutex;
+	std::condition_variable  m_NewJob;
+	std::condition_variable  m_JobDone;
+	bool                     m_bStop  { false };
+
+}; // KParallelScheduler
+
 namespace detail {
 
+//-----------------------------------------------------------------------------
+/// adapts a KBAR like progress printer to the progress callback of KParallelScheduler
+template<typename Progress>
+KParallelScheduler::Progress MakeProgressCallback(Progress& p)
+//-----------------------------------------------------------------------------
+{
+	return [&p, iReported = std::size_t(0)](std::size_t iDone) mutable
+	{
+		if (iDone > iReported)
+		{
+			p.Move(iDone - iReported);
+			iReported = iDone;
+		}
+	};
+}
+
 //:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 /// minimum prototype for a progress printer (this one does not output anything - use e.g. KBAR for
 /// terminal output)
@@ -188,11 +290,69 @@ public:
 
 }; // KParallelForEachNoProgressPrinter
 
+//-----------------------------------------------------------------------------
+/// the iterator category of Iterator, or std::input_iterator_tag if Iterator does not
+/// declare one (like KSQL::iterator) - those are then advanced under a lock
+template<typename Iterator, typename = std::void_t<>>
+struct ParallelIteratorCategory
+//-----------------------------------------------------------------------------
+{
+	using type = std::input_iterator_tag;
+};
+
+template<typename Iterator>
+struct ParallelIteratorCategory<Iterator, std::void_t<typename std::iterator_traits<Iterator>::iterator_category>>
+{
+	using type = typename std::iterator_traits<Iterator>::iterator_category;
+};
+
+//-----------------------------------------------------------------------------
+/// runs kParallelForEach() on the scheduler for random access iterators, as long as
+/// not more threads are requested than the scheduler has (e.g. for blocking work)
+template<typename Iterator, typename Func, typename Progress>
+bool ParallelForEachScheduled(std::size_t iSize, Iterator first, Func& f, std::size_t iMaxThreads, Progress& p, std::random_access_iterator_tag)
+//-----------------------------------------------------------------------------
+{
+	auto& Scheduler = KParallelScheduler::getInstance();
+
+	if (iMaxThreads > Scheduler.MaxThreads())
+	{
+		return false;
+	}
+
+	using Difference = typename std::iterator_traits<Iterator>::difference_type;
+
+	Scheduler.Run(iSize, [&f, first](std::size_t iFrom, std::size_t iTo)
+	{
+		auto it  = first + static_cast<Difference>(iFrom);
+		auto end = first + static_cast<Difference>(iTo);
+
+		for (; it != end; ++it)
+		{
+			f(*it);
+		}
+
+	}, iMaxThreads, 0, MakeProgressCallback(p));
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+/// other iterators cannot be split into ranges, they are advanced under a lock
+template<typename Iterator, typename Func, typename Progress>
+bool ParallelForEachScheduled(std::size_t iSize, Iterator first, Func& f, std::size_t iMaxThreads, Progress& p, std::input_iterator_tag)
+//-----------------------------------------------------------------------------
+{
+	return false;
+}
+
 } // namespace detail
 
 //-----------------------------------------------------------------------------
 /// Iterate with parallel threads over all elements of a range. Expects the size
-/// of the range as the first element.
+/// of the range as the first element. Random access ranges are processed by the
+/// threads of the KParallelScheduler, unless more threads are requested than it
+/// has. Other ranges are processed by new threads that advance a shared iterator.
 /// @param iSize size of the iterable range
 /// @param first iterator on the first element
 /// @param last iterator past the last element
@@ -227,7 +387,7 @@ void kParallelForEach(std::size_t iSize,
 				f(*it);
 			}
 		}
-		else
+		else if (!detail::ParallelForEachScheduled(iSize, first, f, iMaxThreads, p, typename detail::ParallelIteratorCategory<InputIterator>::type()))
 		{
 			std::mutex m_IterMutex;
 
@@ -367,6 +527,243 @@ void kParallelForEach(Container& c,
 }
 
 
+//-----------------------------------------------------------------------------
+/// Call f(i) with parallel threads of the KParallelScheduler for each index i in [iBegin, iEnd).
+/// The range is split adaptively, so this is suited for millions of small work items as well
+/// as for fewer larger ones.
+/// @param iBegin first index
+/// @param iEnd index past the last
+/// @param f functor to call with the index
+/// @param iMaxThreads number of threads to use at most, 0/default = all threads of the scheduler
+/// @param p progress output class, defaults to dummy printer. Use e.g. KBAR for real output to a terminal
+template<typename Func,
+         typename Progress = detail::KParallelForEachNoProgressPrinter>
+void kParallelFor(std::size_t iBegin, std::size_t iEnd,
+                  Func&& f,
+                  std::size_t iMaxThreads = 0,
+                  Progress&& p = detail::KParallelForEachNoProgressPrinter())
+//-----------------------------------------------------------------------------
+{
+	if (iEnd <= iBegin)
+	{
+		return;
+	}
+
+	p.Start(iEnd - iBegin);
+
+	KParallelScheduler::getInstance().Run(iEnd - iBegin, [&f, iBegin](std::size_t iFrom, std::size_t iTo)
+	{
+		for (auto i = iBegin + iFrom, iLast = iBegin + iTo; i < iLast; ++i)
+		{
+			f(i);
+		}
+
+	}, iMaxThreads, 0, detail::MakeProgressCallback(p));
+
+	p.Finish();
+
+} // kParallelFor
+
+//-----------------------------------------------------------------------------
+/// Transform all elements of a random access range with parallel threads of the KParallelScheduler,
+/// like std::transform(). The output range has to have room for all elements.
+/// @param first iterator on the first element
+/// @param last iterator past the last element
+/// @param d_first iterator on the first element of the output range
+/// @param f functor to call with a reference on one element of the range, returning the output value
+/// @param iMaxThreads number of threads to use at most, 0/default = all threads of the scheduler
+/// @param p progress output class, defaults to dummy printer. Use e.g. KBAR for real output to a terminal
+/// @return iterator past the last element of the output range
+template<typename RandomIt,
+         typename OutputIt,
+         typename Func,
+         typename Progress = detail::KParallelForEachNoProgressPrinter>
+OutputIt kParallelTransform(RandomIt first, RandomIt last,
+                            OutputIt d_first,
+                            Func&& f,
+                            std::size_t iMaxThreads = 0,
+                            Progress&& p = detail::KParallelForEachNoProgressPrinter())
+//-----------------------------------------------------------------------------
+{
+	auto iSize = static_cast<std::size_t>(std::distance(first, last));
+
+	if (!iSize)
+	{
+		return d_first;
+	}
+
+	using InDiff  = typename std::iterator_traits<RandomIt>::difference_type;
+	using OutDiff = typename std::iterator_traits<OutputIt>::difference_type;
+
+	p.Start(iSize);
+
+	KParallelScheduler::getInstance().Run(iSize, [&f, first, d_first](std::size_t iFrom, std::size_t iTo)
+	{
+		auto it  = first   + static_cast<InDiff >(iFrom);
+		auto end = first   + static_cast<InDiff >(iTo);
+		auto out = d_first + static_cast<OutDiff>(iFrom);
+
+		for (; it != end; ++it, ++out)
+		{
+			*out = f(*it);
+		}
+
+	}, iMaxThreads, 0, detail::MakeProgressCallback(p));
+
+	p.Finish();
+
+	return d_first + static_cast<OutDiff>(iSize);
+
+} // kParallelTransform
+
+//-----------------------------------------------------------------------------
+/// Reduce all elements of a random access range with parallel threads of the KParallelScheduler,
+/// like std::reduce(). The operation has to be associative, but need not be commutative: the
+/// partial results of the subranges are combined in the order of the range.
+/// @param first iterator on the first element
+/// @param last iterator past the last element
+/// @param init the initial value
+/// @param op the binary operation, called with (T, element) or (T, T)
+/// @param iMaxThreads number of threads to use at most, 0/default = all threads of the scheduler
+/// @param p progress output class, defaults to dummy printer. Use e.g. KBAR for real output to a terminal
+/// @return the reduced value
+template<typename RandomIt,
+         typename T,
+         typename BinaryOp = std::plus<>,
+         typename Progress = detail::KParallelForEachNoProgressPrinter>
+T kParallelReduce(RandomIt first, RandomIt last,
+                  T init,
+                  BinaryOp op = BinaryOp(),
+                  std::size_t iMaxThreads = 0,
+                  Progress&& p = detail::KParallelForEachNoProgressPrinter())
+//-----------------------------------------------------------------------------
+{
+	auto iSize = static_cast<std::size_t>(std::distance(first, last));
+
+	if (!iSize)
+	{
+		return init;
+	}
+
+	using Difference = typename std::iterator_traits<RandomIt>::difference_type;
+
+	// the partial results with the start index of their subrange
+	std::vector<std::pair<std::size_t, T>> Partials;
+	std::mutex PartialsMutex;
+
+	p.Start(iSize);
+
+	KParallelScheduler::getInstance().Run(iSize, [&](std::size_t iFrom, std::size_t iTo)
+	{
+		auto it  = first + static_cast<Difference>(iFrom);
+		auto end = first + static_cast<Difference>(iTo);
+
+		T Partial = *it;
+
+		for (++it; it != end; ++it)
+		{
+			Partial = op(std::move(Partial), *it);
+		}
+
+		std::lock_guard<std::mutex> Lock(PartialsMutex);
+		Partials.emplace_back(iFrom, std::move(Partial));
+
+	}, iMaxThreads, 0, detail::MakeProgressCallback(p));
+
+	p.Finish();
+
+	std::sort(Partials.begin(), Partials.end(), [](const std::pair<std::size_t, T>& left, const std::pair<std::size_t, T>& right)
+	{
+		return left.first < right.first;
+	});
+
+	for (auto& Partial : Partials)
+	{
+		init = op(std::move(init), std::move(Partial.second));
+	}
+
+	return init;
+
+} // kParallelReduce
+
+//-----------------------------------------------------------------------------
+/// Sort a random access range with parallel threads of the KParallelScheduler, like std::sort().
+/// The range is split into one block per thread, the blocks are sorted in parallel and then merged
+/// pairwise in parallel rounds. Small ranges are sorted with std::sort() directly.
+/// @param first iterator on the first element
+/// @param last iterator past the last element
+/// @param comp the compare function
+/// @param iMaxThreads number of threads to use at most, 0/default = all threads of the scheduler
+template<typename RandomIt,
+         typename Compare = std::less<>>
+void kParallelSort(RandomIt first, RandomIt last,
+                   Compare comp = Compare(),
+                   std::size_t iMaxThreads = 0)
+//-----------------------------------------------------------------------------
+{
+	auto iSize = static_cast<std::size_t>(std::distance(first, last));
+
+	auto& Scheduler = KParallelScheduler::getInstance();
+
+	if (!iMaxThreads || iMaxThreads > Scheduler.MaxThreads())
+	{
+		iMaxThreads = Scheduler.MaxThreads();
+	}
+
+	// below this size per block the thread overhead is higher than the gain
+	static constexpr std::size_t iMinBlockSize = 8 * 1024;
+
+	auto iBlocks = std::min(iMaxThreads, iSize / iMinBlockSize);
+
+	if (iBlocks < 2 || KParallelScheduler::InsideJob())
+	{
+		std::sort(first, last, comp);
+		return;
+	}
+
+	using Difference = typename std::iterator_traits<RandomIt>::difference_type;
+
+	// the block boundaries
+	std::vector<RandomIt> Bounds;
+
+	for (std::size_t i = 0; i <= iBlocks; ++i)
+	{
+		Bounds.push_back(first + static_cast<Difference>(iSize * i / iBlocks));
+	}
+
+	Scheduler.Run(iBlocks, [&](std::size_t iFrom, std::size_t iTo)
+	{
+		for (auto i = iFrom; i < iTo; ++i)
+		{
+			std::sort(Bounds[i], Bounds[i + 1], comp);
+		}
+
+	}, iBlocks, 1);
+
+	// merge neighbouring blocks, doubling the block width in each round
+	for (std::size_t iWidth = 1; iWidth < iBlocks; iWidth *= 2)
+	{
+		auto iMerges = (iBlocks + 2 * iWidth - 1) / (2 * iWidth);
+
+		Scheduler.Run(iMerges, [&](std::size_t iFrom, std::size_t iTo)
+		{
+			for (auto i = iFrom; i < iTo; ++i)
+			{
+				auto iLeft  = i * 2 * iWidth;
+				auto iMid   = std::min(iLeft + iWidth, iBlocks);
+				auto iRight = std::min(iLeft + 2 * iWidth, iBlocks);
+
+				if (iMid < iRight)
+				{
+					std::inplace_merge(Bounds[iLeft], Bounds[iMid], Bounds[iRight], comp);
+				}
+			}
+
+		}, iMerges, 1);
+	}
+
+} // kParallelSort
+
 /// @}
 
 DEKAF2_NAMESPACE_END
@@ -44,6 +44,7 @@
 #include <dekaf2/core/init/dekaf2.h>
 #include <dekaf2/system/os/ksystem.h>
 #include <dekaf2/threading/execution/kthreads.h>
+#include <dekaf2/threading/execution/kthreadpool.h>
 #include <dekaf2/core/logging/klog.h>
 
 DEKAF2_NAMESPACE_BEGIN
@@ -54,34 +55,16 @@ namespace {
 // so that Cancel() from inside a callback does not wait for itself
 thread_local const void* tls_pRunningControl = nullptr;
 
-} // end of anonymous namespace
-
-//---------------------------------------------------------------------------
-KTimer::InFlight::InFlight(std::shared_ptr<Flight> pFlight)
-//---------------------------------------------------------------------------
-: m_pFlight(std::move(pFlight))
-{
-	std::lock_guard<std::mutex> Lock(m_pFlight->Mutex);
-	++m_pFlight->iInFlight;
-
-} // ctor InFlight
+// the resolution of the timer wheel
+using TickDuration = std::chrono::milliseconds;
 
-//---------------------------------------------------------------------------
-KTimer::InFlight::~InFlight()
-//---------------------------------------------------------------------------
-{
-	std::lock_guard<std::mutex> Lock(m_pFlight->Mutex);
-	--m_pFlight->iInFlight;
-	// notify before unlock - the woken destructor may destroy the KTimer,
-	// this object only shares ownership of the flight control
-	m_pFlight->CVDone.notify_all();
-
-} // dtor InFlight
+} // end of anonymous namespace
 
 //---------------------------------------------------------------------------
-KTimer::KTimer(KDuration MaxIdle)
+KTimer::KTimer(KDuration MaxIdle, std::size_t iMaxThreads)
 //---------------------------------------------------------------------------
 : m_MaxIdle(MaxIdle)
+, m_iMaxThreads(iMaxThreads ? iMaxThreads : 1)
 , m_bShutdown(false)
 {
 } // ctor
@@ -94,10 +77,15 @@ KTimer::~KTimer()
 	// and this is already a dead instance
 	if (!m_bShutdown)
 	{
-		// signal the thread to shutdown
-		m_bShutdown = true;
-		// and release if paused
-		m_bPause = false;
+		{
+			// signal the thread to shutdown - under the lock, so that the
+			// wake up cannot get lost
+			std::lock_guard<std::mutex> Lock(m_Mutex);
+			m_bShutdown = true;
+			// and release if paused
+			m_bPause = false;
+			m_WakeUp.notify_all();
+		}
 
 		// make sure we are not right in initialization of a new thread
 		std::lock_guard<std::mutex> Lock(m_ThreadCreationMutex);
@@ -109,10 +97,12 @@ KTimer::~KTimer()
 			kDebug(2, "joined timer thread");
 		}
 
-		// wait for callbacks that still run in their own (detached) threads -
-		// no new ones can start, the timing thread is gone
-		std::unique_lock<std::mutex> FlightLock(m_Flight->Mutex);
-		m_Flight->CVDone.wait(FlightLock, [this]{ return m_Flight->iInFlight == 0; });
+		if (m_Pool)
+		{
+			// run the callbacks that were already dispatched and wait for
+			// them - no new ones can come, the timing thread is gone
+			m_Pool->stop();
+		}
 	}
 
 } // dtor
@@ -130,14 +120,54 @@ void KTimer::CleanupChildAfterFork()
 	// deliberate post-fork cleanup hack - there is no conforming way to
 	// abandon a std::thread that no longer exists in the child process.
 	memset(reinterpret_cast<void*>(&m_TimingThread), 0, sizeof(m_TimingThread));
-	// callback threads did not survive the fork either - start with a clean
-	// flight count so a later destruction does not wait forever
-	m_Flight = std::make_shared<Flight>();
+	// the threads of the callback pool did not survive the fork either, and
+	// the pool would wait for them forever - abandon it
+	m_Pool.release();
 
 } // CleanupChildAfterFork
 
 //---------------------------------------------------------------------------
-KTimer::ID_t KTimer::AddTimer(Timer timer)
+KTimerWheel::Tick KTimer::ToTick(SteadyClock::time_point tp, bool bRoundUp) const
+//---------------------------------------------------------------------------
+{
+	if (tp <= m_Start)
+	{
+		return 0;
+	}
+
+	auto iTicks = std::chrono::duration_cast<TickDuration>(tp - m_Start).count();
+
+	if (bRoundUp && m_Start + TickDuration(iTicks) < tp)
+	{
+		++iTicks;
+	}
+
+	return static_cast<KTimerWheel::Tick>(iTicks);
+
+} // ToTick
+
+//---------------------------------------------------------------------------
+void KTimer::Schedule(Timer& timer, KDuration ExpiresIn)
+//---------------------------------------------------------------------------
+{
+	auto tNow = SteadyClock::now();
+	// a timepoint far in the future would overflow the steady clock
+	auto iExpires = (ExpiresIn > Infinite)
+		? ToTick(tNow, false) + static_cast<KTimerWheel::Tick>(std::chrono::duration_cast<TickDuration>(Infinite).count())
+		: ToTick(tNow + std::chrono::duration_cast<SteadyClock::duration>(ExpiresIn), true);
+
+	m_Wheel.Add(timer, iExpires);
+
+	if (iExpires < m_iWakeTick)
+	{
+		// the timing thread sleeps beyond the new deadline
+		m_WakeUp.notify_one();
+	}
+
+} // Schedule
+
+//---------------------------------------------------------------------------
+KTimer::ID_t KTimer::AddTimer(Timer timer, KDuration ExpiresIn)
 //---------------------------------------------------------------------------
 {
 	std::lock_guard<std::mutex> Lock(m_ThreadCreationMutex);
@@ -152,14 +182,14 @@ KTimer::ID_t KTimer::AddTimer(Timer timer)
 	ID_t ID;
 
 	{
-		auto Timers = m_Timers.unique();
+		std::lock_guard<std::mutex> TimersLock(m_Mutex);
 
-		auto ret = Timers->emplace(timer.ID, std::move(timer));
+		auto ret = m_Timers.emplace(timer.ID, std::move(timer));
 
 		if (ret.second)
 		{
 			ID = ret.first->second.ID;
-			m_bAddedTimer = true;
+			Schedule(ret.first->second, ExpiresIn);
 		}
 		else
 		{
@@ -169,7 +199,7 @@ KTimer::ID_t KTimer::AddTimer(Timer timer)
 
 	if (!m_TimingThread)
 	{
-		m_TimingThread = std::make_unique<std::thread>(kMakeThread(&KTimer::TimingLoop, this, m_MaxIdle));
+		m_TimingThread = std::make_unique<std::thread>(kMakeThread(&KTimer::TimingLoop, this));
 	}
 
 	return ID;
@@ -185,7 +215,7 @@ KTimer::ID_t KTimer::CallEvery(KDuration interval, Callback CB, bool bOwnThread)
 		return InvalidID;
 	}
 
-	return AddTimer(Timer(interval, std::move(CB), bOwnThread, false));
+	return AddTimer(Timer(interval, std::move(CB), bOwnThread, false), interval);
 
 } // CallEvery
 
@@ -193,7 +223,7 @@ KTimer::ID_t KTimer::CallEvery(KDuration interval, Callback CB, bool bOwnThread)
 KTimer::ID_t KTimer::CallOnce(KUnixTime timepoint, Callback CB, bool bOwnThread)
 //---------------------------------------------------------------------------
 {
-	return AddTimer(Timer(timepoint, std::move(CB), bOwnThread));
+	return AddTimer(Timer(std::move(CB), bOwnThread), timepoint - KUnixTime::now());
 
 } // CallOnce
 
@@ -201,7 +231,7 @@ KTimer::ID_t KTimer::CallOnce(KUnixTime timepoint, Callback CB, bool bOwnThread)
 KTimer::ID_t KTimer::CallOnce(KDuration interval, Callback CB, bool bOwnThread)
 //---------------------------------------------------------------------------
 {
-	return AddTimer(Timer(interval, std::move(CB), bOwnThread, true));
+	return AddTimer(Timer(interval, std::move(CB), bOwnThread, true), interval);
 
 } // CallOnce
 
@@ -226,11 +256,11 @@ bool KTimer::Cancel(ID_t ID)
 	std::shared_ptr<struct Control> pControl;
 
 	{
-		auto Timers = m_Timers.unique();
+		std::lock_guard<std::mutex> Lock(m_Mutex);
 
-		auto it = Timers->find(ID);
+		auto it = m_Timers.find(ID);
 
-		if (it == Timers->end())
+		if (it == m_Timers.end())
 		{
 			// ID not known for this timer
 			return false;
@@ -238,7 +268,8 @@ bool KTimer::Cancel(ID_t ID)
 
 		pControl = std::move(it->second.Control);
 
-		Timers->erase(it);
+		m_Wheel.Remove(it->second);
+		m_Timers.erase(it);
 	}
 
 	if (pControl)
@@ -267,11 +298,11 @@ bool KTimer::Cancel(ID_t ID)
 bool KTimer::Restart(ID_t ID)
 //---------------------------------------------------------------------------
 {
-	auto Timers = m_Timers.unique();
+	std::lock_guard<std::mutex> Lock(m_Mutex);
 
-	auto it = Timers->find(ID);
+	auto it = m_Timers.find(ID);
 
-	if (it == Timers->end())
+	if (it == m_Timers.end())
 	{
 		// ID not known for this timer
 		return false;
@@ -282,9 +313,7 @@ bool KTimer::Restart(ID_t ID)
 		return false;
 	}
 
-	it->second.ExpiresAt = KUnixTime::now() + it->second.Interval;
-
-	m_bAddedTimer = true;
+	Schedule(it->second, it->second.Interval);
 
 	return true;
 
@@ -294,11 +323,11 @@ bool KTimer::Restart(ID_t ID)
 bool KTimer::Restart(ID_t ID, KDuration interval)
 //---------------------------------------------------------------------------
 {
-	auto Timers = m_Timers.unique();
+	std::lock_guard<std::mutex> Lock(m_Mutex);
 
-	auto it = Timers->find(ID);
+	auto it = m_Timers.find(ID);
 
-	if (it == Timers->end())
+	if (it == m_Timers.end())
 	{
 		// ID not known for this timer
 		return false;
@@ -309,10 +338,9 @@ bool KTimer::Restart(ID_t ID, KDuration interval)
 		return false;
 	}
 
-	it->second.Interval  = interval;
-	it->second.ExpiresAt = KUnixTime::now() + it->second.Interval;
+	it->second.Interval = interval;
 
-	m_bAddedTimer = true;
+	Schedule(it->second, it->second.Interval);
 
 	return true;
 
@@ -322,11 +350,11 @@ bool KTimer::Restart(ID_t ID, KDuration interval)
 bool KTimer::Restart(ID_t ID, KUnixTime timepoint)
 //---------------------------------------------------------------------------
 {
-	auto Timers = m_Timers.unique();
+	std::lock_guard<std::mutex> Lock(m_Mutex);
 
-	auto it = Timers->find(ID);
+	auto it = m_Timers.find(ID);
 
-	if (it == Timers->end())
+	if (it == m_Timers.end())
 	{
 		// ID not known for this timer
 		return false;
@@ -337,9 +365,7 @@ bool KTimer::Restart(ID_t ID, KUnixTime timepoint)
 		return false;
 	}
 
-	it->second.ExpiresAt = timepoint;
-
-	m_bAddedTimer = true;
+	Schedule(it->second, timepoint - KUnixTime::now());
 
 	return true;
 
@@ -393,23 +419,26 @@ void KTimer::RunGuarded(const Callback& CB, KUnixTime Tp, Control& Ctrl)
 } // RunGuarded
 
 //---------------------------------------------------------------------------
-void KTimer::RunDue(const Timer& timer, KUnixTime Tp)
+void KTimer::RunDue(Due& Due, KUnixTime Tp)
 //---------------------------------------------------------------------------
 {
-	if ((timer.Flags & OwnThread) == OwnThread)
+	if ((Due.Flags & OwnThread) == OwnThread)
 	{
-		// raise the flight count before the thread exists, so that the
-		// destructor cannot miss it - the thread drops it at exit
-		auto pInFlight = std::make_shared<InFlight>(m_Flight);
+		if (!m_Pool)
+		{
+			// only the timing thread dispatches, and the destructor joins it
+			// before it touches the pool
+			m_Pool = std::make_unique<KThreadPool>(m_iMaxThreads, "ktimer", KThreadPool::PrestartNone, KThreadPool::ShrinkOne);
+		}
 
-		kMakeThread([CB = timer.CB, Tp, pControl = timer.Control, pInFlight]()
+		m_Pool->push([CB = std::move(Due.CB), Tp, pControl = std::move(Due.Control)]()
 		{
 			RunGuarded(CB, Tp, *pControl);
-		}).detach();
+		});
 	}
 	else
 	{
-		RunGuarded(timer.CB, Tp, *timer.Control);
+		RunGuarded(Due.CB, Tp, *Due.Control);
 	}
 
 } // RunDue
@@ -424,6 +453,12 @@ void KTimer::Pause()
 
 	if (m_TimingThread)
 	{
+		{
+			// wake the timing thread up, it may sleep until its next event
+			std::lock_guard<std::mutex> TimersLock(m_Mutex);
+			m_WakeUp.notify_all();
+		}
+
 		do
 		{
 			std::this_thread::sleep_for(m_MaxIdle / 4);
@@ -449,11 +484,16 @@ void KTimer::Resume()
 	{
 		m_bIsPaused = false;
 	}
+	else
+	{
+		std::lock_guard<std::mutex> TimersLock(m_Mutex);
+		m_WakeUp.notify_all();
+	}
 
 } // Resume
 
 //---------------------------------------------------------------------------
-void KTimer::TimingLoop(KDuration MaxIdle)
+void KTimer::TimingLoop()
 //---------------------------------------------------------------------------
 {
 	// name this thread for debugging tools like ps, top, or gdb
@@ -463,151 +503,123 @@ void KTimer::TimingLoop(KDuration MaxIdle)
 	// the signal handler thread had not been started at init of dekaf2)
 	kBlockAllSignals();
 
-	// return immediately if this thread was created after the instance
-	// was shutdown
-	if (m_bShutdown) return;
-
-	kDebug(2, "new timer thread started with max idle {}", MaxIdle);
+	kDebug(2, "new timer thread started with max idle {}", m_MaxIdle);
 
-	auto      tNow       = KUnixTime::now();
-	KUnixTime tNext      = tNow + MaxIdle;
-	KUnixTime tNextTimer = tNow + Infinite;
+	auto iMaxIdle = static_cast<KTimerWheel::Tick>(std::max(std::chrono::duration_cast<TickDuration>(m_MaxIdle).count(), TickDuration::rep(1)));
 
-	// find closest deadline
-	{
-		auto Timers = m_Timers.shared();
+	std::vector<Due>    DueTimers;
+	// the repeating timers with the tick at which they expired
+	std::vector<std::pair<Timer*, KTimerWheel::Tick>> Repeating;
 
-		for (auto& it : Timers.get())
-		{
-			if (it.second.ExpiresAt < tNextTimer)
-			{
-				tNextTimer = it.second.ExpiresAt;
-			}
-		}
-	}
-
-	std::vector<Timer> DueTimers;
-	std::vector<ID_t>  CancelledCallbacks;
-	uint16_t           iLooped { 0 };
+	std::unique_lock<std::mutex> Lock(m_Mutex);
 
 	for (;;)
 	{
-//		kDebug(4, "next deadline in {}", tNext - tNow);
-		for (;;)
-		{
-			if (tNext > tNextTimer)
-			{
-				tNext = tNextTimer;
-			}
-
-			std::this_thread::sleep_until(tNext);
+		// exit immediately if class or program are ended
+		if (m_bShutdown || Dekaf::IsShutDown()) return;
 
-			// exit immediately if class or program are ended
-			if (m_bShutdown || Dekaf::IsShutDown()) return;
+		// pause until resume?
+		if (m_bPause)
+		{
+			// park without holding the mutex and without waiting on m_WakeUp - Dekaf::Fork()
+			// pauses us, and the child would inherit a locked mutex or a condition variable
+			// with a waiter that never returns, and hang when destroying them
+			Lock.unlock();
 
-			// pause until resume?
-			if (m_bPause)
+			for (;;)
 			{
 				m_bIsPaused = true;
 
 				do
 				{
-					std::this_thread::sleep_for(chrono::milliseconds(100));
-
-					// exit immediately if class or program are ended
-					if (m_bShutdown || Dekaf::IsShutDown()) return;
+					std::this_thread::sleep_for(chrono::milliseconds(10));
 				}
-				while (m_bPause);
+				while (m_bPause && !m_bShutdown && !Dekaf::IsShutDown());
 
 				m_bIsPaused = false;
-			}
 
-			if (++iLooped > 10)
-			{
-				// sync to real time after max 10 unsynced rounds
-				iLooped = 0;
-				tNow    = KUnixTime::now();
-				tNext   = tNow;
+				// a Pause() that still saw us parked relies on us staying parked
+				if (!m_bPause || m_bShutdown || Dekaf::IsShutDown()) break;
 			}
 
-			// do we have an expired timer?
-			if (tNext >= tNextTimer) break;
-
-			// or a new timer added?
-			if (m_bAddedTimer) break;
-
-			// else prepare for next sleep
-			tNext += MaxIdle;
+			Lock.lock();
+			continue;
 		}
 
-		// enable logging in this thread, the global instance of
-		// KTimer is started long before any option parsing
-		KLog::SyncLevel();
+		m_bIsPaused = false;
 
-		if (iLooped > 1)
-		{
-			// only query real time if not just done above,
-			// or in last loop
-			tNow   = KUnixTime::now();
-			tNext  = tNow;
-		}
-		tNext     += MaxIdle;
-		tNextTimer = tNow + Infinite;
+		auto iNow = ToTick(SteadyClock::now(), false);
 
+		m_Wheel.Advance(iNow, [&](KTimerWheel::Node& Node)
 		{
-			auto Timers = m_Timers.unique();
+			auto& Timer = static_cast<struct Timer&>(Node);
 
-			// reset flag
-			m_bAddedTimer = false;
+			DueTimers.push_back(Due { Timer.CB, Timer.Control, Timer.Flags });
 
-			// check all timers for their expiration date
-			for (auto& it : Timers.get())
+			if ((Timer.Flags & Once) == Once)
+			{
+				// remove this timer
+				kDebug(2, "remove one-time timer {}", Timer.ID);
+				m_Timers.erase(Timer.ID);
+			}
+			else
 			{
-				auto& Timer = it.second;
+				// reinsert it after the wheel reached the current tick, or
+				// a short interval would expire repeatedly when catching up
+				Repeating.push_back({ &Timer, Timer.GetExpiration() });
+			}
+		});
 
-				if (Timer.ExpiresAt <= tNow)
-				{
-					DueTimers.push_back(Timer);
-
-					if ((Timer.Flags & Once) == Once)
-					{
-						// remove this timer
-						CancelledCallbacks.push_back(Timer.ID);
-					}
-					else
-					{
-						// calculate next expiration
-						Timer.ExpiresAt  = tNow + Timer.Interval;
-					}
-				}
+		for (auto& Repeat : Repeating)
+		{
+			auto* pTimer    = Repeat.first;
+			auto  iInterval = std::max(ToTick(m_Start + std::chrono::duration_cast<SteadyClock::duration>(pTimer->Interval), true), KTimerWheel::Tick(1));
+			// count the next expiration from the previous one, not from now, or
+			// the timer would drift by the latency of each wake up
+			auto  iExpires  = Repeat.second + iInterval;
 
-				// check for closest deadline
-				if (Timer.ExpiresAt < tNextTimer)
-				{
-					tNextTimer = Timer.ExpiresAt;
-				}
+			if (iExpires <= iNow)
+			{
+				// skip the periods that were missed instead of firing them all at once
+				iExpires += ((iNow - iExpires) / iInterval + 1) * iInterval;
 			}
 
-			for (auto ID : CancelledCallbacks)
+			m_Wheel.Add(*pTimer, iExpires);
+		}
+
+		Repeating.clear();
+
+		if (!DueTimers.empty())
+		{
+			Lock.unlock();
+
+			// enable logging in this thread, the global instance of
+			// KTimer is started long before any option parsing
+			KLog::SyncLevel();
+
+			// now call all due callbacks
+			auto Tp = KUnixTime::now();
+
+			for (auto& Due : DueTimers)
 			{
-				kDebug(2, "remove one-time timer {}", ID);
-				Timers->erase(ID);
+				if (m_bShutdown) break;
+				RunDue(Due, Tp);
 			}
-			
-			CancelledCallbacks.clear();
 
-		} // end of scope for unique lock
+			// and delete the temporary vector
+			DueTimers.clear();
 
-		if (m_bShutdown) return;
+			Lock.lock();
 
-		// now call all due callbacks
-		for (auto& Due : DueTimers)
-		{
-			RunDue(Due, tNow);
+			// callbacks in this thread may have taken a while, check the clock again
+			continue;
 		}
 
-		// and delete the temporary vector
-		DueTimers.clear();
+		// sleep until the next event of the wheel, but not longer than max idle,
+		// a new timer with an earlier deadline wakes us up
+		m_iWakeTick = std::min(m_Wheel.NextEvent(), iNow + iMaxIdle);
+		m_WakeUp.wait_until(Lock, m_Start + TickDuration(m_iWakeTick));
+		m_iWakeTick = 0;
 	}
 
 } // TimingLoop
@@ -633,6 +645,7 @@ KTimer::ID_t KTimer::GetNextID()
 #if DEKAF2_REPEAT_CONSTEXPR_VARIABLE
 constexpr KDuration     KTimer::Infinite;
 constexpr KTimer::ID_t  KTimer::InvalidID;
+constexpr std::size_t   KTimer::DefaultThreads;
 #endif
 
 
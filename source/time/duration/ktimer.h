@@ -43,8 +43,8 @@
 #pragma once
 
 #include <dekaf2/core/init/kdefinitions.h>
-#include <dekaf2/threading/primitives/kthreadsafe.h>
 #include <dekaf2/time/clock/ktime.h>
+#include <dekaf2/time/duration/ktimerwheel.h>
 #include <chrono>
 #include <memory>
 #include <thread>
@@ -59,16 +59,24 @@
 
 DEKAF2_NAMESPACE_BEGIN
 
+class KThreadPool;
+
 /// @addtogroup time_duration
 /// @{
 
 //:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 /// KTimer can be used to call functions both repeatedly after a fixed
 /// time interval or once after expiration of a time interval, or at
-/// a fixed time point. It can take up to 50 milliseconds (or, actually,
-/// the MaxIdle time given at construction) until a new timer is started,
-/// but from then on repeat intervals can be as short as needed, down
-/// to micro- (MacOS) or nanoseconds (Linux).
+/// a fixed time point. The timers are kept in a hierarchical timer wheel
+/// (see KTimerWheel) with a resolution of one millisecond, so adding,
+/// restarting and cancelling a timer is O(1) also with hundreds of
+/// thousands of live timers. The timing thread wakes up right away when a
+/// timer is added that expires before its current wake-up time. Callbacks
+/// that shall not run in the timing thread are dispatched onto a thread
+/// pool that grows on demand up to the size given at construction.
+/// Timers never fire early, but may fire up to a millisecond late (plus
+/// the scheduling latency), and intervals below one millisecond are
+/// rounded up to it.
 /// KTimer does not start a timing thread until a timer is started.
 /// Cancel() and the destructor synchronize with callbacks in flight: after
 /// they returned, no callback of the cancelled timer (resp. of this KTimer)
@@ -91,11 +99,16 @@ public:
 	static constexpr ID_t InvalidID { 0 };
 	static constexpr KDuration Infinite { chrono::years(100) };
 
+	/// the default for the maximum number of threads that run callbacks
+	static constexpr std::size_t DefaultThreads { 16 };
+
 	//---------------------------------------------------------------------------
 	/// create a new KTimer instance
-	/// @param MaxIdle the maximum wait time until a new timer loop is started - new timers are only
-	/// integrated when a new loop iteration starts - defaults to 50 milliseconds
-	KTimer(KDuration MaxIdle = std::chrono::milliseconds(50));
+	/// @param MaxIdle the maximum time the timing thread sleeps without checking for
+	/// a shutdown of the program - defaults to 50 milliseconds
+	/// @param iMaxThreads the maximum number of threads of the pool that runs the
+	/// callbacks that are not called in the timing thread - defaults to 16
+	KTimer(KDuration MaxIdle = std::chrono::milliseconds(50), std::size_t iMaxThreads = DefaultThreads);
 	//---------------------------------------------------------------------------
 
 	//---------------------------------------------------------------------------
@@ -135,7 +148,7 @@ public:
 	/// nonblocking: calls cb every interval in a separate thread.
 	/// @param interval duration to wait between two calls of the callback
 	/// @param CB the callback to call
-	/// @param bOwnThread if true (default), the callback is called in a thread of its own, else it
+	/// @param bOwnThread if true (default), the callback is called in a thread of the callback pool, else it
 	/// is called in the main timer loop thread and must return fastly and without blocking
 	/// @return if unequal InvalidID a handle that can be used
 	/// to remove the callback (cancel the timer)
@@ -147,7 +160,7 @@ public:
 	/// @param timepoint a timepoint at which the callback is called. The callback will also be called
 	/// if the timepoint lies in the past
 	/// @param CB the callback to call
-	/// @param bOwnThread if true (default), the callback is called in a thread of its own, else it
+	/// @param bOwnThread if true (default), the callback is called in a thread of the callback pool, else it
 	/// is called in the main timer loop thread and must return fastly and without blocking
 	/// @return if unequal InvalidID a handle that can be used
 	/// to remove the callback (cancel the timer)
@@ -159,7 +172,7 @@ public:
 	/// @param interval duration to wait from now on at which the callback is called. The callback will also be called
 	/// if the duration is negative.
 	/// @param CB the callback to call
-	/// @param bOwnThread if true (default), the callback is called in a thread of its own, else it
+	/// @param bOwnThread if true (default), the callback is called in a thread of the callback pool, else it
 	/// is called in the main timer loop thread and must return fastly and without blocking
 	/// @return if unequal InvalidID a handle that can be used
 	/// to remove the callback (cancel the timer)
@@ -323,23 +336,39 @@ private:
 		return DurationT { (d.count() < 0) ? -d.count() : d.count() };
 	}
 
+	using SteadyClock = std::chrono::steady_clock;
+
 	//---------------------------------------------------------------------------
 	DEKAF2_PRIVATE
-	void TimingLoop(KDuration MaxIdle);
+	void TimingLoop();
 	//---------------------------------------------------------------------------
 
 	struct Timer;
 	struct Control;
+	struct Due;
+
+	//---------------------------------------------------------------------------
+	DEKAF2_PRIVATE
+	ID_t AddTimer(Timer timer, KDuration ExpiresIn);
+	//---------------------------------------------------------------------------
 
 	//---------------------------------------------------------------------------
 	DEKAF2_PRIVATE
-	ID_t AddTimer(Timer timer);
+	/// (re)insert a timer into the wheel and wake up the timing thread if it
+	/// now expires before the thread would wake up - m_Mutex must be locked
+	void Schedule(Timer& timer, KDuration ExpiresIn);
 	//---------------------------------------------------------------------------
 
 	//---------------------------------------------------------------------------
 	DEKAF2_PRIVATE
-	/// run one due timer - directly, or detached in its own thread
-	void RunDue(const Timer& timer, KUnixTime Tp);
+	/// returns the tick of the wheel for a time point
+	KTimerWheel::Tick ToTick(SteadyClock::time_point tp, bool bRoundUp) const;
+	//---------------------------------------------------------------------------
+
+	//---------------------------------------------------------------------------
+	DEKAF2_PRIVATE
+	/// run one due timer - directly, or in the callback pool
+	void RunDue(Due& Due, KUnixTime Tp);
 	//---------------------------------------------------------------------------
 
 	//---------------------------------------------------------------------------
@@ -363,7 +392,7 @@ private:
 	{
 		None      = 0,
 		Once      = 1 << 0, // this timer shall be run only once
-		OwnThread = 1 << 1, // the callback shall be called in its own thread
+		OwnThread = 1 << 1, // the callback shall be called in the callback pool
 	};
 
 	//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -380,52 +409,25 @@ private:
 	}; // Control
 
 	//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
-	/// counts callbacks running in their own (detached) threads, so that the
-	/// destructor can wait for them - shared so it outlives the KTimer
-	struct Flight
-	//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
-	{
-		std::mutex              Mutex;
-		std::condition_variable CVDone;
-		std::size_t             iInFlight { 0 };
-
-	}; // Flight
-
-	//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
-	/// keeps the flight count raised from before its thread is created until
-	/// the thread drops its copy at exit
-	class InFlight
-	//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
-	{
-	public:
-		InFlight(std::shared_ptr<Flight> pFlight);
-		~InFlight();
-	private:
-		std::shared_ptr<Flight> m_pFlight;
-
-	}; // InFlight
-
-	//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
-	struct Timer
+	/// a timer in the wheel - the nodes of the timer map do not move, so the
+	/// wheel can link them directly
+	struct Timer : public KTimerWheel::Node
 	//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 	{
 		Timer() = default;
-		Timer(KUnixTime timepoint, Callback CB, bool bOwnThread)
-		: ExpiresAt(timepoint)
-		, CB(std::move(CB))
+		Timer(Callback CB, bool bOwnThread)
+		: CB(std::move(CB))
 		, Flags(bOwnThread ? static_cast<enum Flags>(OwnThread | Once) : Once)
 		{
 		}
 		Timer(KDuration interval,  Callback CB, bool bOwnThread, bool bOnce)
-		: ExpiresAt(KUnixTime::now() + interval)
-		, Interval(interval)
+		: Interval(interval)
 		, CB(std::move(CB))
 		, Flags(static_cast<enum Flags>((bOwnThread ? OwnThread : None) | (bOnce ? Once : None)))
 		{
 		}
 
 		ID_t          ID       { InvalidID         };
-		KUnixTime     ExpiresAt;
 		KDuration     Interval { KDuration::zero() };
 		Callback      CB       { nullptr           };
 		enum Flags    Flags    { None              };
@@ -433,16 +435,33 @@ private:
 		std::shared_ptr<struct Control> Control;
 	};
 
+	//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+	/// what is needed to run the callback of an expired timer outside of the lock
+	struct Due
+	//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+	{
+		Callback                        CB;
+		std::shared_ptr<struct Control> Control;
+		enum Flags                      Flags;
+	};
+
 	KDuration                          m_MaxIdle;
+	std::size_t                        m_iMaxThreads;
+	SteadyClock::time_point            m_Start             { SteadyClock::now() };
 	std::mutex                         m_ThreadCreationMutex;
 	std::unique_ptr<std::thread>       m_TimingThread;
+	std::unique_ptr<KThreadPool>       m_Pool;
 	std::atomic<bool>                  m_bShutdown         { false };
 	std::atomic<bool>                  m_bPause            { false };
 	std::atomic<bool>                  m_bIsPaused         { false };
-	std::atomic<bool>                  m_bAddedTimer       { false };
-	std::shared_ptr<Flight>            m_Flight            { std::make_shared<Flight>() };
 
-	KThreadSafe<std::unordered_map<ID_t, Timer>> m_Timers;
+	// protects the members below
+	std::mutex                         m_Mutex;
+	std::condition_variable            m_WakeUp;
+	std::unordered_map<ID_t, Timer>    m_Timers;
+	KTimerWheel                        m_Wheel;
+	// the tick the timing thread sleeps until, 0 while it is awake
+	KTimerWheel::Tick                  m_iWakeTick         { 0 };
 
 }; // KTimer
 
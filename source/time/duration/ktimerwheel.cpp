@@ -0,0 +1,259 @@
+/*
+//
+// DEKAF(tm): Lighter, Faster, Smarter(tm)
+//
+// Copyright (c) 2026, Ridgeware, Inc.
+//
+// +-------------------------------------------------------------------------+
+// | /\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\|
+// |/+---------------------------------------------------------------------+/|
+// |/|                                                                     |/|
+// |\|  ** THIS NOTICE MUST NOT BE REMOVED FROM THE SOURCE CODE MODULE **  |\|
+// |/|                                                                     |/|
+// |\|   OPEN SOURCE LICENSE                                               |\|
+// |/|                                                                     |/|
+// |\|   Permission is hereby granted, free of charge, to any person       |\|
+// |/|   obtaining a copy of this software and associated                  |/|
+// |\|   documentation files (the "Software"), to deal in the              |\|
+// |/|   Software without restriction, including without limitation        |/|
+// |\|   the rights to use, copy, modify, merge, publish,                  |\|
+// |/|   distribute, sublicense, and/or sell copies of the Software,       |/|
+// |\|   and to permit persons to whom the Software is furnished to        |\|
+// |/|   do so, subject to the following conditions:                       |/|
+// |\|                                                                     |\|
+// |/|   The above copyright notice and this permission notice shall       |/|
+// |\|   be included in all copies or substantial portions of the          |\|
+// |/|   Software.                                                         |/|
+// |\|                                                                     |\|
+// |/|   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY         |/|
+// |\|   KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE        |\|
+// |/|   WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR           |/|
+// |\|   PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS        |\|
+// |/|   OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR          |/|
+// |\|   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR        |\|
+// |/|   OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE         |/|
+// |\|   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.            |\|
+// |/|                                                                     |/|
+// |/+---------------------------------------------------------------------+/|
+// |\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/ |
+// +-------------------------------------------------------------------------+
+//
+*/
+
+#include <dekaf2/time/duration/ktimerwheel.h>
+#include <dekaf2/core/types/kbit.h>
+
+DEKAF2_NAMESPACE_BEGIN
+
+//---------------------------------------------------------------------------
+void KTimerWheel::Link(Node*& pHead, Node& node, uint8_t iLevel, uint8_t iSlot) noexcept
+//---------------------------------------------------------------------------
+{
+	node.m_iLevel = iLevel;
+	node.m_iSlot  = iSlot;
+	node.m_pPrev  = nullptr;
+	node.m_pNext  = pHead;
+
+	if (pHead)
+	{
+		pHead->m_pPrev = &node;
+	}
+
+	pHead = &node;
+	++m_iSize;
+
+} // Link
+
+//---------------------------------------------------------------------------
+KTimerWheel::Node*& KTimerWheel::Head(const Node& node) noexcept
+//---------------------------------------------------------------------------
+{
+	switch (node.m_iLevel)
+	{
+		case Overflow:
+			return m_pOverflow;
+
+		case Due:
+			return m_pDue;
+
+		default:
+			return m_Slots[node.m_iLevel][node.m_iSlot];
+	}
+
+} // Head
+
+//---------------------------------------------------------------------------
+void KTimerWheel::Unlink(Node& node) noexcept
+//---------------------------------------------------------------------------
+{
+	if (node.m_pPrev)
+	{
+		node.m_pPrev->m_pNext = node.m_pNext;
+	}
+	else
+	{
+		auto& pHead = Head(node);
+
+		pHead = node.m_pNext;
+
+		if (!pHead && node.m_iLevel < Levels)
+		{
+			m_Occupied[node.m_iLevel] &= ~(uint64_t(1) << node.m_iSlot);
+		}
+	}
+
+	if (node.m_pNext)
+	{
+		node.m_pNext->m_pPrev = node.m_pPrev;
+	}
+
+	node.m_pPrev  = nullptr;
+	node.m_pNext  = nullptr;
+	node.m_iLevel = Unlinked;
+	--m_iSize;
+
+} // Unlink
+
+//---------------------------------------------------------------------------
+void KTimerWheel::Add(Node& node, Tick iExpires) noexcept
+//---------------------------------------------------------------------------
+{
+	if (node.IsLinked())
+	{
+		Unlink(node);
+	}
+
+	node.m_iExpires = iExpires;
+
+	if (iExpires <= m_iNow)
+	{
+		Link(m_pDue, node, Due, 0);
+		return;
+	}
+
+	// the level is given by the highest bit group in which the
+	// expiration differs from the current tick
+	auto iLevel = (std::numeric_limits<Tick>::digits - 1 - kBitCountLeftZero(iExpires ^ m_iNow)) / SlotBits;
+
+	if (iLevel >= Levels)
+	{
+		Link(m_pOverflow, node, Overflow, 0);
+		return;
+	}
+
+	auto iSlot = static_cast<uint8_t>((iExpires >> (iLevel * SlotBits)) & (Slots - 1));
+
+	Link(m_Slots[iLevel][iSlot], node, static_cast<uint8_t>(iLevel), iSlot);
+	m_Occupied[iLevel] |= uint64_t(1) << iSlot;
+
+} // Add
+
+//---------------------------------------------------------------------------
+void KTimerWheel::Remove(Node& node) noexcept
+//---------------------------------------------------------------------------
+{
+	if (node.IsLinked())
+	{
+		Unlink(node);
+	}
+
+} // Remove
+
+//---------------------------------------------------------------------------
+KTimerWheel::Tick KTimerWheel::NextEvent() const noexcept
+//---------------------------------------------------------------------------
+{
+	if (m_pDue)
+	{
+		return m_iNow;
+	}
+
+	Tick iNext = NoEvent;
+
+	// all occupied slots of a level lie after its current slot, and the
+	// first occupied slot of a lower level always comes before the one of
+	// a higher level - therefore the lowest occupied level has the answer
+	for (uint8_t iLevel = 0; iLevel < Levels; ++iLevel)
+	{
+		if (m_Occupied[iLevel])
+		{
+			auto iShift = iLevel * SlotBits;
+			auto iSlot  = kBitCountRightZero(m_Occupied[iLevel]);
+			// the start of the block of this level the current tick is in
+			auto iBlock = (m_iNow >> (iShift + SlotBits)) << (iShift + SlotBits);
+
+			return iBlock | (Tick(iSlot) << iShift);
+		}
+	}
+
+	if (m_pOverflow)
+	{
+		// the overflow list is reinserted when the top level wraps
+		iNext = ((m_iNow >> (Levels * SlotBits)) + 1) << (Levels * SlotBits);
+	}
+
+	return iNext;
+
+} // NextEvent
+
+//---------------------------------------------------------------------------
+void KTimerWheel::Reinsert(Node* pHead) noexcept
+//---------------------------------------------------------------------------
+{
+	while (pHead)
+	{
+		auto* pNode = pHead;
+		pHead = pNode->m_pNext;
+		// the list has already been detached, only fix the count
+		pNode->m_iLevel = Unlinked;
+		--m_iSize;
+		Add(*pNode, pNode->m_iExpires);
+	}
+
+} // Reinsert
+
+//---------------------------------------------------------------------------
+void KTimerWheel::Step(Tick iTick) noexcept
+//---------------------------------------------------------------------------
+{
+	m_iNow = iTick;
+
+	if ((iTick & ((Tick(1) << (Levels * SlotBits)) - 1)) == 0)
+	{
+		auto* pHead = m_pOverflow;
+		m_pOverflow = nullptr;
+		Reinsert(pHead);
+	}
+
+	// cascade from the top, the nodes of a higher level may end up in a
+	// slot of a lower level that also starts now
+	for (uint8_t iLevel = Levels; iLevel-- > 0;)
+	{
+		auto iShift = iLevel * SlotBits;
+
+		if (iLevel && (iTick & ((Tick(1) << iShift) - 1)) != 0)
+		{
+			// not at the start of a slot of this level
+			continue;
+		}
+
+		auto iSlot = static_cast<uint8_t>((iTick >> iShift) & (Slots - 1));
+
+		if (m_Occupied[iLevel] & (uint64_t(1) << iSlot))
+		{
+			auto* pHead = m_Slots[iLevel][iSlot];
+			m_Slots[iLevel][iSlot] = nullptr;
+			m_Occupied[iLevel] &= ~(uint64_t(1) << iSlot);
+			// all nodes of the current level 0 slot expire now and go
+			// into the due list, the others move down
+			Reinsert(pHead);
+		}
+	}
+
+} // Step
+
+#if DEKAF2_REPEAT_CONSTEXPR_VARIABLE
+constexpr KTimerWheel::Tick KTimerWheel::NoEvent;
+#endif
+
+DEKAF2_NAMESPACE_END
@@ -0,0 +1,228 @@
+/*
+//
+// DEKAF(tm): Lighter, Faster, Smarter(tm)
+//
+// Copyright (c) 2026, Ridgeware, Inc.
+//
+// +-------------------------------------------------------------------------+
+// | /\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\|
+// |/+---------------------------------------------------------------------+/|
+// |/|                                                                     |/|
+// |\|  ** THIS NOTICE MUST NOT BE REMOVED FROM THE SOURCE CODE MODULE **  |\|
+// |/|                                                                     |/|
+// |\|   OPEN SOURCE LICENSE                                               |\|
+// |/|                                                                     |/|
+// |\|   Permission is hereby granted, free of charge, to any person       |\|
+// |/|   obtaining a copy of this software and associated                  |/|
+// |\|   documentation files (the "Software"), to deal in the              |\|
+// |/|   Software without restriction, including without limitation        |/|
+// |\|   the rights to use, copy, modify, merge, publish,                  |\|
+// |/|   distribute, sublicense, and/or sell copies of the Software,       |/|
+// |\|   and to permit persons to whom the Software is furnished to        |\|
+// |/|   do so, subject to the following conditions:                       |/|
+// |\|                                                                     |\|
+// |/|   The above copyright notice and this permission notice shall       |/|
+// |\|   be included in all copies or substantial portions of the          |\|
+// |/|   Software.                                                         |/|
+// |\|                                                                     |\|
+// |/|   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY         |/|
+// |\|   KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE        |\|
+// |/|   WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR           |/|
+// |\|   PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS        |\|
+// |/|   OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR          |/|
+// |\|   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR        |\|
+// |/|   OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE         |/|
+// |\|   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.            |\|
+// |/|                                                                     |/|
+// |/+---------------------------------------------------------------------+/|
+// |\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/ |
+// +-------------------------------------------------------------------------+
+//
+*/
+
+#pragma once
+
+/// @file ktimerwheel.h
+/// hierarchical timer wheel with O(1) add and remove
+
+#include <dekaf2/core/init/kdefinitions.h>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+DEKAF2_NAMESPACE_BEGIN
+
+/// @addtogroup time_duration
+/// @{
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+/// A hierarchical timer wheel that keeps many timers ordered by their
+/// expiration tick, with O(1) Add() and Remove(). Time is counted in abstract
+/// ticks; it is the caller's task to map them to a clock (KTimer uses one
+/// millisecond per tick).
+///
+/// The wheel has Levels levels of 64 slots each. A timer is stored on the
+/// lowest level on which its expiration tick shares all higher bits with the
+/// current tick, in the slot given by its bits on that level. When the
+/// current tick reaches the start of an occupied slot of a higher level, the
+/// timers of that slot are moved down (cascaded). One bit mask per level
+/// tells which slots are occupied, so Advance() jumps directly to the next
+/// tick at which something happens instead of stepping through empty ticks.
+/// Timers beyond the range of the top level (2^36 ticks) wait in an overflow
+/// list until the top level wraps.
+///
+/// The timers are intrusive: derive them from KTimerWheel::Node. The wheel
+/// does not own them, and is not thread safe.
+class DEKAF2_PUBLIC KTimerWheel
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+{
+
+//----------
+public:
+//----------
+
+	using Tick = uint64_t;
+
+	/// returned by NextEvent() if no timer is pending
+	static constexpr Tick NoEvent = std::numeric_limits<Tick>::max();
+
+	//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+	/// the base class for timers in the wheel - a copy is never linked
+	class Node
+	//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+	{
+		friend class KTimerWheel;
+
+	//----------
+	public:
+	//----------
+
+		Node() = default;
+		Node(const Node&) noexcept {}
+		Node& operator=(const Node&) noexcept { return *this; }
+
+		/// returns true if this node is currently in a wheel
+		DEKAF2_NODISCARD
+		bool IsLinked() const noexcept { return m_iLevel != Unlinked; }
+
+		/// returns the expiration tick of this node, only valid while it is linked, and
+		/// in the OnExpired callback of Advance() for the node that expired
+		DEKAF2_NODISCARD
+		Tick GetExpiration() const noexcept { return m_iExpires; }
+
+	//----------
+	private:
+	//----------
+
+		Node*   m_pPrev    { nullptr  };
+		Node*   m_pNext    { nullptr  };
+		Tick    m_iExpires { 0        };
+		uint8_t m_iLevel   { Unlinked };
+		uint8_t m_iSlot    { 0        };
+
+	}; // Node
+
+	/// construct a wheel with the current tick iNow
+	KTimerWheel(Tick iNow = 0) noexcept : m_iNow(iNow) {}
+
+	KTimerWheel(const KTimerWheel&) = delete;
+	KTimerWheel& operator=(const KTimerWheel&) = delete;
+
+	/// add a node that expires at iExpires - a node that is already linked is moved.
+	/// A node with an expiration tick that is not after the current tick is due at
+	/// the next Advance()
+	void Add(Node& node, Tick iExpires) noexcept;
+
+	/// remove a node from the wheel, does nothing if it is not linked
+	void Remove(Node& node) noexcept;
+
+	/// returns the current tick
+	DEKAF2_NODISCARD
+	Tick Now() const noexcept { return m_iNow; }
+
+	/// returns the number of linked nodes
+	DEKAF2_NODISCARD
+	std::size_t size() const noexcept { return m_iSize; }
+
+	/// returns true if no node is linked
+	DEKAF2_NODISCARD
+	bool empty() const noexcept { return !m_iSize; }
+
+	/// returns the next tick at which Advance() has work to do (a node expires, or
+	/// nodes have to be cascaded), or NoEvent if the wheel is empty. Nodes do not
+	/// necessarily expire at that tick, but none expires before it.
+	DEKAF2_NODISCARD
+	Tick NextEvent() const noexcept;
+
+	/// advance the current tick to iTo and call OnExpired(Node&) for every node
+	/// that expires until then, in order of expiration. The node is already
+	/// unlinked when OnExpired is called, which may add or remove nodes, or
+	/// destroy the expired one. Nodes that OnExpired adds with an expiration up
+	/// to iTo expire in the same call.
+	template<class Func>
+	void Advance(Tick iTo, Func&& OnExpired)
+	{
+		for (;;)
+		{
+			while (m_pDue)
+			{
+				auto* pNode = m_pDue;
+				Unlink(*pNode);
+				OnExpired(*pNode);
+			}
+
+			auto iEvent = NextEvent();
+
+			if (iEvent > iTo)
+			{
+				break;
+			}
+
+			Step(iEvent);
+		}
+
+		if (iTo > m_iNow)
+		{
+			m_iNow = iTo;
+		}
+	}
+
+//----------
+private:
+//----------
+
+	static constexpr uint8_t  Levels    = 6;
+	static constexpr uint8_t  SlotBits  = 6;
+	static constexpr uint8_t  Slots     = 1 << SlotBits;
+	static constexpr uint8_t  Overflow  = Levels;
+	static constexpr uint8_t  Due       = Levels + 1;
+	static constexpr uint8_t  Unlinked  = 0xff;
+
+	/// set the current tick to iTick, which must be the result of NextEvent(),
+	/// and move the nodes of that tick down or into the due list
+	void Step(Tick iTick) noexcept;
+
+	/// link the node into the list with the head pHead
+	void Link(Node*& pHead, Node& node, uint8_t iLevel, uint8_t iSlot) noexcept;
+
+	/// unlink the node from its list
+	void Unlink(Node& node) noexcept;
+
+	/// move all nodes of the list pHead into their new place
+	void Reinsert(Node* pHead) noexcept;
+
+	/// returns the head of the list the node is linked into
+	Node*& Head(const Node& node) noexcept;
+
+	Node*       m_Slots[Levels][Slots] {};
+	uint64_t    m_Occupied[Levels]     {};
+	Node*       m_pOverflow            { nullptr };
+	Node*       m_pDue                 { nullptr };
+	Tick        m_iNow                 { 0 };
+	std::size_t m_iSize                { 0 };
+
+}; // KTimerWheel
+
+/// @}
+
+DEKAF2_NAMESPACE_END
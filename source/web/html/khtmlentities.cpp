@@ -43,6 +43,7 @@
 
 #include <dekaf2/web/html/khtmlentities.h>
 #include <dekaf2/core/strings/kutf.h>
+#include <dekaf2/core/strings/bits/simd/kescapescan.h>
 #include <dekaf2/core/strings/kstringutils.h>
 #include <dekaf2/core/types/kctype.h>
 #include <dekaf2/io/readwrite/kwrite.h>
@@ -86,35 +87,65 @@ void KHTMLEntity::ToMandatoryEntity(uint32_t ch, KStringRef& sOut)
 
 } // kMandatoryEntity
 
+namespace {
+
+//-----------------------------------------------------------------------------
+/// the characters that always have to be encoded
+const detail::KEscapeScan& MandatoryScan()
+//-----------------------------------------------------------------------------
+{
+	static const detail::KEscapeScan s_Scan("\"&'<>");
+	return s_Scan;
+
+} // MandatoryScan
+
+//-----------------------------------------------------------------------------
+/// returns the entity for one of the mandatory characters
+KStringView MandatoryEntity(char ch)
+//-----------------------------------------------------------------------------
+{
+	switch (ch)
+	{
+		case '"':
+			return "&quot;";
+		case '&':
+			return "&amp;";
+		case '\'':
+			return "&apos;";
+		case '<':
+			return "&lt;";
+		case '>':
+			return "&gt;";
+		default:
+			return {};
+	}
+
+} // MandatoryEntity
+
+} // end of anonymous namespace
+
 //-----------------------------------------------------------------------------
 void KHTMLEntity::AppendMandatory(KStringRef& sAppendTo, KStringView sIn)
 //-----------------------------------------------------------------------------
 {
 	sAppendTo.reserve(sAppendTo.size() + (sIn.size() * 5 / 4));
 
-	for (auto ch : sIn)
+	const auto& Scan = MandatoryScan();
+
+	for (;;)
 	{
-		switch (ch)
+		auto iSpecial = Scan.find_first_in(sIn);
+
+		if (iSpecial == KStringView::npos)
 		{
-			case '"':
-				sAppendTo += "&quot;";
-				break;
-			case '&':
-				sAppendTo += "&amp;";
-				break;
-			case '\'':
-				sAppendTo += "&apos;";
-				break;
-			case '<':
-				sAppendTo += "&lt;";
-				break;
-			case '>':
-				sAppendTo += "&gt;";
-				break;
-			default:
-				sAppendTo += ch;
-				break;
+			sAppendTo += sIn;
+			break;
 		}
+
+		// copy the clean run in one go
+		sAppendTo += sIn.substr(0, iSpecial);
+		sAppendTo += MandatoryEntity(sIn[iSpecial]);
+		sIn.remove_prefix(iSpecial + 1);
 	}
 
 } // AppendMandatory
@@ -123,29 +154,23 @@ void KHTMLEntity::AppendMandatory(KStringRef& sAppendTo, KStringView sIn)
 void KHTMLEntity::EncodeMandatory(std::ostream& Out, KStringView sIn)
 //-----------------------------------------------------------------------------
 {
-	for (auto ch : sIn)
+	const auto& Scan = MandatoryScan();
+
+	for (;;)
 	{
-		switch (ch)
+		auto iSpecial = Scan.find_first_in(sIn);
+
+		if (iSpecial == KStringView::npos)
 		{
-			case '"':
-				kWrite(Out, "&quot;");
-				break;
-			case '&':
-				kWrite(Out, "&amp;");
-				break;
-			case '\'':
-				kWrite(Out, "&apos;");
-				break;
-			case '<':
-				kWrite(Out, "&lt;");
-				break;
-			case '>':
-				kWrite(Out, "&gt;");
-				break;
-			default:
-				kWrite(Out, ch);
-				break;
+			kWrite(Out, sIn.data(), sIn.size());
+			break;
 		}
+
+		// write the clean run in one go
+		kWrite(Out, sIn.data(), iSpecial);
+		auto sEntity = MandatoryEntity(sIn[iSpecial]);
+		kWrite(Out, sEntity.data(), sEntity.size());
+		sIn.remove_prefix(iSpecial + 1);
 	}
 
 } // EncodeMandatory
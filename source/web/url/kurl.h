@@ -79,7 +79,7 @@ namespace detail {
 /// URLEncodedString
 /// URLEncodedQuery
 /// URLEncodedUInt
-/// @tparam Storage the storage class, URLEncodedString, URLEncodedQuery (KProps), or URLEncodedUInt
+/// @tparam Storage the storage class, URLEncodedString, URLEncodedQuery (KSmallProps), or URLEncodedUInt
 /// @tparam Component  the URL component type
 /// @tparam StartToken the start token, one of @:/;?#
 /// @tparam RemoveStartSeparator whether to remove the start token when parsing
@@ -70,6 +70,9 @@ const char* KUrlEncodingTables::s_sExcludes[] =
 
 bool* KUrlEncodingTables::EncodingTable[TABLECOUNT];
 bool KUrlEncodingTables::Tables[INT_TABLECOUNT][256];
+const KEscapeScan* KUrlEncodingTables::EncodingScan[TABLECOUNT];
+KEscapeScan KUrlEncodingTables::Scans[INT_TABLECOUNT];
+KEscapeScan KUrlEncodingTables::s_DecodeScan;
 
 //-----------------------------------------------------------------------------
 KUrlEncodingTables::KUrlEncodingTables() noexcept
@@ -100,15 +103,28 @@ KUrlEncodingTables::KUrlEncodingTables() noexcept
 		}
 	}
 
+	// the scans search for the bytes that are not excluded from encoding
+	for (auto table = 0; table < INT_TABLECOUNT; ++table)
+	{
+		Scans[table] = KEscapeScan(Tables[table], false);
+	}
+
 	// now set up the pointers into these tables, as some are shared..
 	for (auto table = static_cast<int>(URIPart::Protocol); table < static_cast<int>(URIPart::Path); ++table)
 	{
 		EncodingTable[table] = Tables[0];
+		EncodingScan [table] = &Scans[0];
 	}
 
 	EncodingTable[static_cast<int>(URIPart::Path)]     = Tables[1];
 	EncodingTable[static_cast<int>(URIPart::Query)]    = Tables[2];
 	EncodingTable[static_cast<int>(URIPart::Fragment)] = Tables[2];
+
+	EncodingScan [static_cast<int>(URIPart::Path)]     = &Scans[1];
+	EncodingScan [static_cast<int>(URIPart::Query)]    = &Scans[2];
+	EncodingScan [static_cast<int>(URIPart::Fragment)] = &Scans[2];
+
+	s_DecodeScan = KEscapeScan("%+");
 }
 
 } // end of namespace detail
@@ -133,10 +149,11 @@ template void kUrlDecode(KStringRef& sDecode, bool pPlusAsSpace = false);
 template void kUrlDecode(const KStringView& sSource, KStringRef& sTarget, bool bPlusAsSpace = false);
 template KString kUrlDecode(const KStringView& sSource, bool bPlusAsSpace = false);
 template void kUrlEncode (const KStringView& sSource, KStringRef& sTarget, const bool excludeTable[256], bool bSpaceAsPlus = false);
+template void kUrlEncode (const KStringView& sSource, KStringRef& sTarget, const detail::KEscapeScan& Scan, bool bSpaceAsPlus = false);
 
 template class KURLEncoded<uint16_t>;
 template class KURLEncoded<KString>;
-template class KURLEncoded<KProps<KString, KString>, '&', '='>;
+template class KURLEncoded<KSmallProps<KString, KString>, '&', '='>;
 #endif // of DEKAF2_IS_MSC
 
 DEKAF2_NAMESPACE_END
@@ -47,6 +47,7 @@
 
 #include <dekaf2/core/strings/kstringview.h>
 #include <dekaf2/core/strings/kstring.h>
+#include <dekaf2/core/strings/bits/simd/kescapescan.h>
 #include <dekaf2/containers/associative/kprops.h>
 #include <dekaf2/core/types/ktemplate.h>
 #include <dekaf2/io/readwrite/kwriter.h>
@@ -98,6 +99,22 @@ public:
 		return MyInstance.getTableInt(part);
 	}
 
+	//-----------------------------------------------------------------------------
+	/// returns the set of bytes that have to be percent encoded for part
+	static inline const KEscapeScan& getScan(URIPart part)
+	//-----------------------------------------------------------------------------
+	{
+		return *MyInstance.getScanInt(part);
+	}
+
+	//-----------------------------------------------------------------------------
+	/// returns the set of bytes that have to be decoded if a + sign is decoded as space
+	static inline const KEscapeScan& getDecodeScan()
+	//-----------------------------------------------------------------------------
+	{
+		return s_DecodeScan;
+	}
+
 //------
 protected:
 //------
@@ -110,12 +127,23 @@ protected:
 		return EncodingTable[which];
 	}
 
+	//-----------------------------------------------------------------------------
+	inline const KEscapeScan* getScanInt(URIPart part)
+	//-----------------------------------------------------------------------------
+	{
+		std::size_t which = std::min(static_cast<std::size_t>(part), static_cast<std::size_t>(TABLECOUNT - 1));
+		return EncodingScan[which];
+	}
+
 	static constexpr int INT_TABLECOUNT = 3;
 	static constexpr int TABLECOUNT = 8;
 	static KUrlEncodingTables MyInstance;
 	static const char* s_sExcludes[];
 	static bool* EncodingTable[TABLECOUNT];
 	static bool Tables[INT_TABLECOUNT][256];
+	static const KEscapeScan* EncodingScan[TABLECOUNT];
+	static KEscapeScan Scans[INT_TABLECOUNT];
+	static KEscapeScan s_DecodeScan;
 };
 
 } // end of namespace detail
@@ -138,7 +166,17 @@ void kUrlDecode (String& sDecode, bool bPlusAsSpace = false)
 {
 	if (!sDecode.empty())
 	{
-		auto insert  = sDecode.begin();
+		// skip the clean prefix, nothing has to be moved there
+		auto iSpecial = (bPlusAsSpace)
+		              ? detail::KUrlEncodingTables::getDecodeScan().find_first_in(sDecode.data(), sDecode.size())
+		              : KStringView(sDecode.data(), sDecode.size()).find('%');
+
+		if (iSpecial == KStringView::npos)
+		{
+			return;
+		}
+
+		auto insert  = sDecode.begin() + iSpecial;
 		auto current = insert;
 		auto end     = sDecode.end();
 
@@ -182,55 +220,70 @@ void kUrlDecode (const StringView& sSource, String& sTarget, bool bPlusAsSpace =
 {
 	if (sSource.empty()) return;
 
-	// ----- fast path --------------------------------------------------------
 	// The common case in URL parsing (Domain, Path, Fragment) has no escapes
-	// at all, so we can skip the byte-by-byte copy loop and do a single
-	// bulk append. We only enable this fast path when `bPlusAsSpace` is
-	// false: for the Query component `+` is legitimate encoded data in
-	// typically short values where a SIMD-size `find_first_of("%+")` costs
-	// more than the byte-by-byte loop itself.
-	typename StringView::size_type iSpecial = 0;
-	if (!bPlusAsSpace)
-	{
-		iSpecial = sSource.find(typename StringView::value_type('%'));
-		if (iSpecial == StringView::npos)
-		{
-			// nothing to decode - one append, done
-			sTarget.append(sSource.data(), sSource.size());
-			return;
-		}
-	}
-	// ------------------------------------------------------------------------
+	// at all, and most other values have only a few of them. We therefore
+	// search for the next byte that needs decoding and copy the clean run
+	// before it in one append. Without bPlusAsSpace the only such byte is
+	// '%', for which memchr() is the fastest search.
+	const auto& Scan = detail::KUrlEncodingTables::getDecodeScan();
+	auto pData       = sSource.data();
+	auto iSize       = sSource.size();
 
-	sTarget.reserve (sTarget.size() + sSource.size());
-	// copy the clean prefix (if any) in one shot, then fall through to the
-	// character-by-character loop for the remaining bytes
-	if (iSpecial > 0)
+	auto FindSpecial = [&]() -> std::size_t
 	{
-		sTarget.append(sSource.data(), iSpecial);
+		return (bPlusAsSpace)
+		     ? Scan.find_first_in(pData, iSize)
+		     : KStringView(pData, iSize).find('%');
+	};
+
+	auto iSpecial = FindSpecial();
+
+	if (iSpecial == KStringView::npos)
+	{
+		// nothing to decode - one append, done
+		sTarget.append(pData, iSize);
+		return;
 	}
-	auto current = sSource.begin() + iSpecial;
-	auto end     = sSource.end();
 
-	while (current < end)
+	sTarget.reserve (sTarget.size() + iSize);
+
+	for (;;)
 	{
-		if (*current == '+')
-		{
-			sTarget    += bPlusAsSpace ? ' ' : *current;
-			++current;
-		}
-		else if (*current == '%'
-			&& end - current > 2
-			&& KASCII::kIsXDigit(*(current + 1))
-			&& KASCII::kIsXDigit(*(current + 2)))
+		sTarget.append(pData, iSpecial);
+		pData += iSpecial;
+		iSize -= iSpecial;
+
+		// decode all immediately following special bytes without a new scan,
+		// that is much faster for heavily encoded input like non-ASCII text
+		do
 		{
-			auto iValue = detail::kx2c(*(current + 1), *(current + 2));
-			sTarget    += static_cast<typename String::value_type>(iValue);
-			current    += 3;
+			if (*pData == '%'
+				&& iSize > 2
+				&& KASCII::kIsXDigit(pData[1])
+				&& KASCII::kIsXDigit(pData[2]))
+			{
+				auto iValue = detail::kx2c(pData[1], pData[2]);
+				sTarget    += static_cast<typename String::value_type>(iValue);
+				pData      += 3;
+				iSize      -= 3;
+			}
+			else
+			{
+				// a '+' (which can only be found with bPlusAsSpace), or a '%' that
+				// is not followed by two hex digits
+				sTarget    += (*pData == '+') ? ' ' : *pData;
+				++pData;
+				--iSize;
+			}
 		}
-		else
+		while (iSize && (*pData == '%' || (bPlusAsSpace && *pData == '+')));
+
+		iSpecial = FindSpecial();
+
+		if (iSpecial == KStringView::npos)
 		{
-			sTarget    += *current++;
+			sTarget.append(pData, iSize);
+			break;
 		}
 	}
 
@@ -291,6 +344,66 @@ void kUrlEncode (const StringView& sSource, String& sTarget, const bool excludeT
 	}
 }
 
+//-----------------------------------------------------------------------------
+/// percent-encodes string, searching for the bytes to encode with a precomputed scan
+/// @param sSource the unencoded input string
+/// @param sTarget the encoded output string
+/// @param Scan the set of bytes that have to be percent encoded
+/// @param bSpaceAsPlus if true, a space will be translated as + sign, default is false
+template<class String, class StringView>
+DEKAF2_PUBLIC
+void kUrlEncode (const StringView& sSource, String& sTarget, const detail::KEscapeScan& Scan, bool bSpaceAsPlus = false)
+//-----------------------------------------------------------------------------
+{
+	static constexpr char sxDigit[] = "0123456789ABCDEF";
+
+	auto pData = sSource.data();
+	auto iSize = sSource.size();
+
+	// Pre-allocate to prevent potential multiple re-allocations.
+	sTarget.reserve (sTarget.size () + iSize);
+
+	for (;;)
+	{
+		auto iSpecial = Scan.find_first_in(pData, iSize);
+
+		if (iSpecial == detail::KEscapeScan::npos)
+		{
+			sTarget.append(pData, iSize);
+			break;
+		}
+
+		// copy the clean run in one go
+		sTarget.append(pData, iSpecial);
+		pData += iSpecial;
+		iSize -= iSpecial;
+
+		// encode all immediately following bytes of the set without a new scan,
+		// that is much faster for heavily encoded input like non-ASCII text
+		do
+		{
+			auto ch = static_cast<unsigned char>(*pData++);
+			--iSize;
+
+			if (ch == ' ' && bSpaceAsPlus)
+			{
+				// it is only in the query part of a URL that
+				// spaces _may_ be represented as +, but they do not
+				// have to..
+				sTarget += '+';
+			}
+			else
+			{
+				sTarget += '%';
+				sTarget += sxDigit[(ch >> 4) & 0x0f];
+				sTarget += sxDigit[(ch     ) & 0x0f];
+			}
+		}
+		while (iSize && Scan.contains(*pData));
+	}
+
+} // kUrlEncode
+
 //-----------------------------------------------------------------------------
 /// percent-decode in place
 /// @param sTarget the input/output string
@@ -327,7 +440,7 @@ DEKAF2_PUBLIC
 void kUrlEncode (KStringView sSource, String& sTarget, URIPart encoding = URIPart::Protocol)
 //-----------------------------------------------------------------------------
 {
-	kUrlEncode(sSource, sTarget, detail::KUrlEncodingTables::getTable(encoding), encoding == URIPart::Query);
+	kUrlEncode(sSource, sTarget, detail::KUrlEncodingTables::getScan(encoding), encoding == URIPart::Query);
 }
 
 //-----------------------------------------------------------------------------
@@ -680,15 +793,16 @@ extern template void kUrlDecode(KStringRef& sDecode, bool pPlusAsSpace = false);
 extern template void kUrlDecode(const KStringView& sSource, KStringRef& sTarget, bool bPlusAsSpace = false);
 extern template KString kUrlDecode(const KStringView& sSource, bool bPlusAsSpace = false);
 extern template void kUrlEncode (const KStringView& sSource, KStringRef& sTarget, const bool excludeTable[256], bool bSpaceAsPlus = false);
+extern template void kUrlEncode (const KStringView& sSource, KStringRef& sTarget, const detail::KEscapeScan& Scan, bool bSpaceAsPlus = false);
 
 extern template class KURLEncoded<uint16_t>;
 extern template class KURLEncoded<KString>;
-extern template class KURLEncoded<KProps<KString, KString, true, false>, '&', '='>;
+extern template class KURLEncoded<KSmallProps<KString, KString, true, false>, '&', '='>;
 #endif // of DEKAF2_IS_MSC
 
 using URLEncodedUInt   = KURLEncoded<uint16_t>;
 using URLEncodedString = KURLEncoded<KString>;
-using URLEncodedQuery  = KURLEncoded<KProps<KString, KString, /*Sequential=*/true, /*Unique=*/false>, '&', '='>;
+using URLEncodedQuery  = KURLEncoded<KSmallProps<KString, KString, /*Sequential=*/true, /*Unique=*/false>, '&', '='>;
 
 
 /// @}
@@ -3,6 +3,9 @@
 #include <dekaf2/containers/associative/kcache.h>
 #include <dekaf2/io/readwrite/kwriter.h>
 #include <dekaf2/threading/execution/kparallel.h>
+#include <dekaf2/core/format/kformat.h>
+#include <atomic>
+#include <thread>
 #include <vector>
 
 using namespace dekaf2;
@@ -226,3 +229,166 @@ TEST_CASE("KSharedCache")
 		CHECK ( (s4 == "3210987654321098765432109876543210987654") );
 	}
 }
+
+namespace {
+
+struct CountingLoader
+{
+	template<class K>
+	KString operator()(K&& key, std::atomic<int>& iLoads, KDuration Delay = KDuration::zero())
+	{
+		++iLoads;
+
+		if (Delay > KDuration::zero())
+		{
+			std::this_thread::sleep_for(Delay);
+		}
+
+		return Loader()(std::forward<K>(key));
+	}
+};
+
+} // end of anonymous namespace
+
+TEST_CASE("KConcurrentCache")
+{
+	SECTION("Get Set Find Erase")
+	{
+		KConcurrentCache<KString, KString, Loader> MyCache(100, 4);
+
+		CHECK ( MyCache.GetSegmentCount() == 4 );
+		CHECK ( MyCache.empty() );
+		CHECK ( *MyCache.Get("abcdefg") == "gfedcba" );
+		CHECK ( *MyCache.Get("abcdefg") == "gfedcba" );
+		CHECK ( *MyCache["bbcdefg"] == "gfedcbb" );
+		CHECK ( MyCache.size() == 2 );
+
+		MyCache.Set("abcdefg", "replaced");
+		CHECK ( *MyCache.Find("abcdefg") == "replaced" );
+		CHECK ( MyCache.Find("unknown")->empty() );
+
+		CHECK ( MyCache.Erase("abcdefg") == true  );
+		CHECK ( MyCache.Erase("abcdefg") == false );
+		CHECK ( MyCache.size() == 1 );
+
+		auto Stats = MyCache.GetStats();
+		CHECK ( Stats.iMisses == 2 );
+		CHECK ( Stats.iHits   == 2 );
+
+		MyCache.clear();
+		CHECK ( MyCache.empty() );
+	}
+
+	SECTION("Heterogeneous lookup")
+	{
+		KConcurrentCache<KString, KString, Loader> MyCache(100, 16);
+
+		MyCache.Set(KString("abcdefg"), "stored");
+
+		// all lookup types select the segment of the stored KString
+		CHECK ( *MyCache.Find(KStringView("abcdefg")) == "stored" );
+		CHECK ( *MyCache.Find("abcdefg")              == "stored" );
+		CHECK ( *MyCache.Get(std::string("abcdefg"))  == "stored" );
+		CHECK ( MyCache.GetStats().iHits == 3 );
+
+		// a non-transparent hash converts the lookup key once
+		CHECK ( detail::transparent_hash<std::string>()(KStringView("abc")) == std::hash<std::string>()("abc") );
+		CHECK ( detail::transparent_hash<KString>()(KStringView("abc"))     == std::hash<KString>()("abc")     );
+	}
+
+	SECTION("Overflow")
+	{
+		KConcurrentCache<KString, KString, Loader> MyCache(8, 2);
+
+		std::vector<KConcurrentCache<KString, KString, Loader>::value_type> Values;
+
+		for (int i = 0; i < 100; ++i)
+		{
+			Values.push_back(MyCache.Get(kFormat("key{}", i)));
+		}
+
+		CHECK ( MyCache.size() <= 8 );
+		CHECK ( MyCache.GetStats().iEvictions == 100 - MyCache.size() );
+		// evicted values are still valid for their holders
+		CHECK ( *Values[0] == "0yek" );
+
+		MyCache.SetMaxSize(2);
+		CHECK ( MyCache.size() <= 2 );
+	}
+
+	SECTION("Second chance")
+	{
+		// one segment with two slots
+		KConcurrentCache<KString, KString, Loader> MyCache(2, 1);
+
+		MyCache.Get("a");
+		MyCache.Get("b");
+		// referencing "a" protects it from the next eviction
+		MyCache.Get("a");
+		MyCache.Get("c");
+
+		CHECK ( !MyCache.Find("a")->empty() );
+		CHECK (  MyCache.Find("b")->empty() );
+		CHECK ( !MyCache.Find("c")->empty() );
+	}
+
+	SECTION("Load coalescing")
+	{
+		KConcurrentCache<KString, KString, CountingLoader> MyCache;
+
+		std::atomic<int>      iLoads  { 0 };
+		std::atomic<uint32_t> iErrors { 0 };
+
+		KRunThreads(20).Create([&]()
+		{
+			if (*MyCache.Get("abcdefg", iLoads, chrono::milliseconds(100)) != "gfedcba") { ++iErrors; }
+		});
+
+		CHECK ( iErrors == 0 );
+		CHECK ( iLoads  == 1 );
+
+		auto Stats = MyCache.GetStats();
+		CHECK ( Stats.iMisses == 1 );
+		CHECK ( Stats.iHits + Stats.iCoalesced == 19 );
+	}
+
+	SECTION("Time to live")
+	{
+		KConcurrentCache<KString, KString, CountingLoader> MyCache(100, 4, chrono::milliseconds(50));
+
+		std::atomic<int> iLoads { 0 };
+
+		CHECK ( *MyCache.Get("abcdefg", iLoads) == "gfedcba" );
+		CHECK ( *MyCache.Get("abcdefg", iLoads) == "gfedcba" );
+		CHECK ( iLoads == 1 );
+
+		std::this_thread::sleep_for(chrono::milliseconds(60));
+
+		CHECK ( MyCache.Find("abcdefg")->empty() );
+		CHECK ( *MyCache.Get("abcdefg", iLoads) == "gfedcba" );
+		CHECK ( iLoads == 2 );
+		CHECK ( MyCache.GetStats().iExpirations == 1 );
+	}
+
+	SECTION("MT with overflow")
+	{
+		KConcurrentCache<KString, KString, Loader> MyCache(4, 2);
+
+		std::atomic<uint32_t> iErrors { 0 };
+
+		KRunThreads(20).Create([&iErrors,&MyCache]()
+		{
+			for (int i = 0; i < 500; ++i)
+			{
+				if (*MyCache.Get("abcdefg") != "gfedcba") { ++iErrors; }
+				if (*MyCache.Get("abccefg") != "gfeccba") { ++iErrors; }
+				if (*MyCache.Get("bbcdefg") != "gfedcbb") { ++iErrors; }
+				if (*MyCache.Get("bbcdeff") != "ffedcbb") { ++iErrors; }
+				if (*MyCache.Get("bbcdefe") != "efedcbb") { ++iErrors; }
+			}
+		});
+
+		CHECK ( iErrors == 0 );
+		CHECK ( MyCache.size() <= 4 );
+	}
+}
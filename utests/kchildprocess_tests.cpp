@@ -6,9 +6,18 @@
 #include <dekaf2/core/init/dekaf2.h>
 #include <dekaf2/core/logging/klog.h>
 #include <dekaf2/system/os/ksystem.h>
+#include <dekaf2/system/filesystem/kfilesystem.h>
+#include <dekaf2/io/readwrite/kreader.h>
+#include <dekaf2/time/duration/ktimer.h>
 
 #ifndef DEKAF2_IS_WINDOWS
 
+#include <sys/wait.h>
+#include <signal.h>
+#include <unistd.h>
+#include <atomic>
+#include <thread>
+
 using namespace dekaf2;
 
 int chtest1(int argc, char** argv)
@@ -27,4 +36,189 @@ TEST_CASE("KChildProcess")
 	CHECK ( Child.GetExitStatus() == 7 );
 }
 
+TEST_CASE("KChildProcess with a running timer")
+{
+	// keep the timing thread of the default timer busy while forking
+	auto& Timer = Dekaf::getInstance().GetTimer();
+	auto  ID    = Timer.CallEvery(chrono::milliseconds(5), [](KUnixTime) {}, false);
+
+	KChildProcess Child;
+	CHECK ( Child.Fork(chtest1) );
+
+	// the child must not hang when it replaces the inherited timer
+	bool bJoined = Child.Join(chrono::seconds(10));
+	CHECK ( bJoined );
+
+	if (!bJoined)
+	{
+		::kill(Child.GetChildPID(), SIGKILL);
+		Child.Join();
+	}
+
+	CHECK ( Child.GetExitStatus() == 7 );
+	CHECK ( Timer.Cancel(ID) );
+}
+
+#ifdef DEKAF2_WITH_KLOG
+int chtest_async(int argc, char** argv)
+{
+	// more lines than the queue of the parent can hold
+	for (int i = 0; i < 200; ++i)
+	{
+		kDebug(1, "fork-async child {}", i);
+	}
+
+	return KLog::getInstance().IsAsync() ? 9 : 8;
+}
+
+TEST_CASE("KChildProcess with asynchronous logging")
+{
+	auto& Log        = KLog::getInstance();
+	KString sOldLog  = Log.GetDebugLog();
+	auto iOldLevel   = Log.GetLevel();
+
+	KTempDir TempDir;
+	KString sLogFile = kFormat("{}{}fork.log", TempDir.Name(), kDirSep);
+
+	CHECK ( Log.SetDebugLog(sLogFile) );
+	Log.SetLevel(1);
+	Log.SetAsync(true, 64, KLog::AsyncOverflow::Block);
+
+	// keep the log busy while forking
+	std::atomic<bool> bStop { false };
+
+	std::thread Logger([&bStop]()
+	{
+		KLog::SyncLevel();
+
+		while (!bStop)
+		{
+			kDebug(1, "fork-async parent");
+		}
+	});
+
+	KChildProcess Child;
+	CHECK ( Child.Fork(chtest_async) );
+
+	// the child must neither block on the queue nor on the log mutex
+	bool bJoined = Child.Join(chrono::seconds(10));
+	CHECK ( bJoined );
+
+	if (!bJoined)
+	{
+		::kill(Child.GetChildPID(), SIGKILL);
+		Child.Join();
+	}
+
+	bStop = true;
+	Logger.join();
+
+	CHECK ( Child.GetExitStatus() == 8 );
+	CHECK ( Log.IsAsync() );
+
+	Log.SetAsync(false);
+	Log.SetLevel(iOldLevel);
+	Log.SetDebugLog(sOldLog);
+
+	auto sContent = kReadAll(sLogFile);
+
+	CHECK ( sContent.contains("fork-async child 199") );
+}
+#endif
+
+TEST_CASE("KChildProcess Start")
+{
+	SECTION("Start")
+	{
+		KChildProcess Child;
+		CHECK ( Child.Start("sh -c 'exit 5'") );
+		CHECK ( Child.Join()                   );
+		CHECK ( Child.GetExitStatus() == 5     );
+	}
+
+	SECTION("Start in directory")
+	{
+		KChildProcess Child;
+		CHECK ( Child.Start("sh -c 'test \"$(pwd)\" = /'", "/") );
+		CHECK ( Child.Join()                                    );
+		CHECK ( Child.GetExitStatus() == 0                      );
+	}
+
+	SECTION("Start not found")
+	{
+		KChildProcess Child;
+		CHECK ( Child.Start("/this/command/does/not/exist") == false );
+	}
+}
+
+TEST_CASE("kSpawn")
+{
+	int fds[2];
+	REQUIRE ( ::pipe(fds) == 0 );
+
+	const char* argV[] = { "sh", "-c", "echo \"$KSPAWN_TEST\"-\"$HOME\"", nullptr };
+
+	auto pid = detail::kSpawn(argV, -1, fds[1], KStringViewZ{}, { { "KSPAWN_TEST", "hello" }, { "HOME", "" } });
+	::close(fds[1]);
+	REQUIRE ( pid > 0 );
+
+	KString sOut;
+	char buf[100];
+	for (;;)
+	{
+		auto iRead = ::read(fds[0], buf, sizeof(buf));
+		if (iRead <= 0) break;
+		sOut.append(buf, iRead);
+	}
+	::close(fds[0]);
+
+	int iStatus;
+	CHECK ( ::waitpid(pid, &iStatus, 0) == pid );
+	CHECK ( WIFEXITED(iStatus)                 );
+	CHECK ( WEXITSTATUS(iStatus) == 0          );
+	CHECK ( sOut == "hello-\n"                 );
+}
+
+TEST_CASE("kSpawn while other threads close files")
+{
+	std::atomic<bool> bStop { false };
+
+	// open and close inheritable files all the time
+	std::thread Churn([&bStop]()
+	{
+		while (!bStop)
+		{
+			int fds[2];
+
+			if (::pipe(fds) == 0)
+			{
+				::close(fds[0]);
+				::close(fds[1]);
+			}
+		}
+	});
+
+	const char* argV[] = { "true", nullptr };
+
+	std::size_t iSpawned { 0 };
+
+	for (int i = 0; i < 50; ++i)
+	{
+		auto pid = detail::kSpawn(argV, -1, -1, KStringViewZ{}, {});
+
+		if (pid > 0)
+		{
+			int iStatus;
+			::waitpid(pid, &iStatus, 0);
+			++iSpawned;
+		}
+	}
+
+	bStop = true;
+	Churn.join();
+
+	// a file closed between listing and spawning must not abort the spawn
+	CHECK ( iSpawned == 50 );
+}
+
 #endif
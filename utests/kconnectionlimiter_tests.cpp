@@ -2,6 +2,9 @@
 
 #include <dekaf2/rest/limits/kconnectionlimiter.h>
 #include <dekaf2/core/errors/kexception.h>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 using namespace dekaf2;
 
@@ -142,4 +145,41 @@ TEST_CASE("KConnectionLimiter")
 		CHECK ( limiter.GetTotalConnections() == 3 );
 		CHECK ( limiter.GetKeyCount() == 2 );
 	}
+
+	SECTION("concurrent acquire and release")
+	{
+		KConnectionLimiter limiter(4, 8);
+		CHECK ( limiter.GetShardCount() == 8 );
+		std::atomic<int> iMax { 0 };
+		std::atomic<int> iActive { 0 };
+		std::vector<std::thread> Threads;
+
+		for (int t = 0; t < 8; ++t)
+		{
+			Threads.emplace_back([&]()
+			{
+				for (int i = 0; i < 1000; ++i)
+				{
+					auto Guard = limiter.Acquire("10.0.0.1");
+
+					if (Guard)
+					{
+						auto iNow = ++iActive;
+						auto iPrev = iMax.load();
+						while (iNow > iPrev && !iMax.compare_exchange_weak(iPrev, iNow)) {}
+						--iActive;
+					}
+				}
+			});
+		}
+
+		for (auto& Thread : Threads)
+		{
+			Thread.join();
+		}
+
+		CHECK ( iMax <= 4 );
+		CHECK ( limiter.GetTotalConnections() == 0 );
+		CHECK ( limiter.GetKeyCount() == 0 );
+	}
 }
@@ -85,4 +85,94 @@ TEST_CASE("KCRC")
 		}
 		CHECK( Incremental.CRC() == KCRC32(sWhole).CRC() );
 	}
+
+	// the accelerated paths fold 16, 64, or 8 bytes at once and hand the rest to
+	// the tables - check all lengths around these boundaries at unaligned starts
+	SECTION("accelerated KCRC32 is bit-identical to kCRC32")
+	{
+		KString sData;
+		for (int i = 0; i < 70000; ++i) sData += static_cast<KString::value_type>((i * 131 + (i >> 7)) & 0xFF);
+
+		for (std::size_t iOffset = 0; iOffset < 8; ++iOffset)
+		{
+			for (std::size_t iLen = 0; iLen <= 300; ++iLen)
+			{
+				KStringView sPart(sData.data() + iOffset, iLen);
+				INFO ( "offset " << iOffset << " length " << iLen );
+				CHECK( KCRC32(sPart).CRC() == kCRC32(sPart) );
+			}
+		}
+
+		CHECK( KCRC32(sData).CRC() == kCRC32(sData) );
+		CHECK( KCRC32(KStringView(sData).substr(3)).CRC() == kCRC32(KStringView(sData).substr(3)) );
+	}
+
+	SECTION("KCRC32C")
+	{
+		CHECK( KCRC32C("").CRC()          == 0x00000000u );
+		CHECK( KCRC32C("123456789").CRC() == 0xE3069283u ); // the canonical CRC-32C check value
+		CHECK( KCRC32C(KString(32, '\0')).CRC() == 0x8A9136AAu ); // RFC 3720 B.4
+		CHECK( KCRC32C(KString(32, '\xff')).CRC() == 0x62A8AB43u );
+
+		static_assert(kCRC32C("123456789") == 0xE3069283u, "");
+
+		KCRC32C crc1("abcdefg");
+		crc1 += "hijklm";
+		crc1("nopq");
+		crc1.Update("rstuvw");
+		KCRC32C crc2("abcdefghijklmnopqrstuvw");
+		CHECK( crc2() == crc1() );
+		CHECK( crc1() != KCRC32("abcdefghijklmnopqrstuvw").CRC() );
+		crc1.clear();
+		CHECK( crc1() == 0 );
+
+		KString sData;
+		for (int i = 0; i < 5000; ++i) sData += static_cast<KString::value_type>((i * 61 + 7) & 0xFF);
+
+		for (std::size_t iOffset = 0; iOffset < 8; ++iOffset)
+		{
+			for (std::size_t iLen = 0; iLen <= 100; ++iLen)
+			{
+				KStringView sPart(sData.data() + iOffset, iLen);
+				INFO ( "offset " << iOffset << " length " << iLen );
+				CHECK( KCRC32C(sPart).CRC() == kCRC32C(sPart) );
+			}
+		}
+
+		CHECK( KCRC32C(sData).CRC() == kCRC32C(sData) );
+	}
+
+	SECTION("combine")
+	{
+		KString sData;
+		for (int i = 0; i < 3000; ++i) sData += static_cast<KString::value_type>((i * 17 + (i >> 3)) & 0xFF);
+		KStringView sAll(sData);
+
+		for (std::size_t iSplit : { 0, 1, 7, 64, 100, 1024, 2999, 3000 })
+		{
+			INFO ( "split at " << iSplit );
+			auto sLeft  = sAll.substr(0, iSplit);
+			auto sRight = sAll.substr(iSplit);
+
+			CHECK( kCRC32Combine (KCRC32 (sLeft).CRC(), KCRC32 (sRight).CRC(), sRight.size()) == KCRC32 (sAll).CRC() );
+			CHECK( kCRC32CCombine(KCRC32C(sLeft).CRC(), KCRC32C(sRight).CRC(), sRight.size()) == KCRC32C(sAll).CRC() );
+		}
+	}
+
+	SECTION("combine large lengths")
+	{
+		// combining is associative - this checks lengths above 512 MiB (2^32 bits)
+		// without hashing that much data
+		uint32_t a = kCRC32 ("first" ), b = kCRC32 ("second"), c = kCRC32 ("third");
+		uint32_t d = kCRC32C("first" ), e = kCRC32C("second"), f = kCRC32C("third");
+
+		for (uint64_t iLen1 : { uint64_t(1) << 28, (uint64_t(1) << 29) + 3, uint64_t(5) << 30, uint64_t(3) << 40 })
+		{
+			uint64_t iLen2 = iLen1 + 12345;
+			INFO ( "length " << iLen1 );
+
+			CHECK( kCRC32Combine (kCRC32Combine (a, b, iLen1), c, iLen2) == kCRC32Combine (a, kCRC32Combine (b, c, iLen2), iLen1 + iLen2) );
+			CHECK( kCRC32CCombine(kCRC32CCombine(d, e, iLen1), f, iLen2) == kCRC32CCombine(d, kCRC32CCombine(e, f, iLen2), iLen1 + iLen2) );
+		}
+	}
 }
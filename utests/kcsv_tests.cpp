@@ -1,10 +1,91 @@
 #include "catch.hpp"
 #include <dekaf2/data/csv/kcsv.h>
 #include <dekaf2/containers/sequential/kstack.h>
+#include <dekaf2/core/format/kformat.h>
 #include <vector>
+#include <random>
 
 using namespace dekaf2;
 
+namespace {
+
+using Records = std::vector<std::vector<KString>>;
+
+// the reference: read all records with the stream parser
+Records ReadWithStream(KStringView sInput, char chRecord = '\n', char chColumn = ',', char chField = '"')
+{
+	Records Result;
+	KInStringStream iss(sInput);
+	KCSV CSV(chRecord, chColumn, chField);
+
+	for (;;)
+	{
+		std::vector<KString> Record;
+
+		if (!CSV.Read(iss, Record))
+		{
+			break;
+		}
+
+		Result.push_back(std::move(Record));
+	}
+
+	return Result;
+}
+
+Records ReadWithBuffer(KStringView sInput, char chRecord = '\n', char chColumn = ',', char chField = '"')
+{
+	Records Result;
+	KInCSVBuffer CSV(sInput, chRecord, chColumn, chField);
+	KInCSVBuffer::Record Record;
+
+	while (CSV.Read(Record))
+	{
+		Result.emplace_back(Record.begin(), Record.end());
+	}
+
+	return Result;
+}
+
+// random input with many limiters, to hit all the corner cases of the parser
+KString RandomCSV(std::mt19937& Random, std::size_t iMaxSize, KStringView sAlphabet)
+{
+	KString sInput;
+	auto iSize = std::uniform_int_distribution<std::size_t>(0, iMaxSize)(Random);
+	std::uniform_int_distribution<std::size_t> Char(0, sAlphabet.size() - 1);
+
+	for (std::size_t i = 0; i < iSize; ++i)
+	{
+		sInput += sAlphabet[Char(Random)];
+	}
+
+	return sInput;
+}
+
+// collects the records of a parallel read in input order
+std::size_t ReadParallel(KInCSVBuffer& CSV, std::size_t iThreads, Records& Result)
+{
+	// the records of each part arrive in order, in one thread
+	std::vector<Records> PartRecords(iThreads);
+
+	auto iRecords = CSV.ParallelRead([&](KInCSVBuffer::Record& Record, std::size_t iPart)
+	{
+		PartRecords[iPart].emplace_back(Record.begin(), Record.end());
+	}, iThreads);
+
+	for (auto& Part : PartRecords)
+	{
+		for (auto& Record : Part)
+		{
+			Result.push_back(std::move(Record));
+		}
+	}
+
+	return iRecords;
+}
+
+} // end of anonymous namespace
+
 TEST_CASE("KCSV")
 {
 	SECTION("Vectors")
@@ -250,4 +331,94 @@ TEST_CASE("KCSV")
 		CSV.Write({"Oranges", "Apples", "Bananas", "Pineapples"});
 		CHECK ( sOut == "\xEF\xBB\xBFOranges,Apples,Bananas,Pineapples\r\n" );
 	}
+
+	SECTION("KInCSVBuffer random input")
+	{
+		std::mt19937 Random(4711);
+
+		for (int i = 0; i < 3000; ++i)
+		{
+			auto sInput = RandomCSV(Random, (i % 3) ? 40 : 300, "ab,,\"\"\r\n\n");
+			INFO ( kEscapeForLogging(sInput) );
+			CHECK ( ReadWithBuffer(sInput) == ReadWithStream(sInput) );
+		}
+
+		for (int i = 0; i < 1000; ++i)
+		{
+			// other limiters, and a CR that is not special
+			auto sInput = RandomCSV(Random, (i % 3) ? 40 : 300, "ab;;''||\r");
+			INFO ( kEscapeForLogging(sInput) );
+			CHECK ( ReadWithBuffer(sInput, '|', ';', '\'') == ReadWithStream(sInput, '|', ';', '\'') );
+		}
+	}
+
+	SECTION("KInCSVBuffer views")
+	{
+		KStringView sInput = "plain,\"quoted, with comma\",\"esc\"\"aped\"\r\nnext,\"line\r\nbreak\"";
+		KInCSVBuffer CSV(sInput);
+		KInCSVBuffer::Record Record;
+
+		REQUIRE ( CSV.Read(Record) );
+		REQUIRE ( Record.size() == 3 );
+		CHECK ( Record[0] == "plain" );
+		CHECK ( Record[1] == "quoted, with comma" );
+		CHECK ( Record[2] == "esc\"aped" );
+		// only the escaped column is copied
+		CHECK ( Record[0].data() >= sInput.data() );
+		CHECK ( Record[1].data() <  sInput.data() + sInput.size() );
+		CHECK ( (Record[2].data() < sInput.data() || Record[2].data() >= sInput.data() + sInput.size()) );
+
+		REQUIRE ( CSV.Read(Record) );
+		REQUIRE ( Record.size() == 2 );
+		CHECK ( Record[0] == "next" );
+		CHECK ( Record[1] == "line\r\nbreak" );
+		CHECK ( CSV.AtEnd() );
+		CHECK ( CSV.Read(Record) == false );
+	}
+
+	SECTION("KInCSVBuffer parallel")
+	{
+		KString sInput;
+		KOutCSV Out(sInput);
+
+		for (std::size_t i = 0; i < 20000; ++i)
+		{
+			Out.Write(std::vector<KString> { kFormat("{}", i), "some text", "with, comma", "with \"quotes\"", "with\r\nline break" });
+		}
+
+		auto Expected = ReadWithStream(sInput);
+		REQUIRE ( Expected.size() == 20000 );
+
+		KInCSVBuffer CSV(sInput);
+		auto Parts = CSV.Split(4, 1024);
+		CHECK ( Parts.size() == 4 );
+
+		std::size_t iTotal { 0 };
+
+		for (auto& sPart : Parts)
+		{
+			iTotal += sPart.size();
+		}
+
+		CHECK ( iTotal == sInput.size() );
+
+		Records Result;
+		auto iRecords = ReadParallel(CSV, 4, Result);
+
+		CHECK ( iRecords == Expected.size() );
+		CHECK ( CSV.AtEnd() );
+		CHECK ( Result == Expected );
+
+		// an unbalanced field limiter at the start inverts the quote parity at all
+		// split points, the parallel read still has to return the sequential result
+		sInput.insert(0, "\"");
+		Expected = ReadWithStream(sInput);
+
+		KInCSVBuffer Unbalanced(sInput);
+		Result.clear();
+		iRecords = ReadParallel(Unbalanced, 4, Result);
+
+		CHECK ( iRecords == Expected.size() );
+		CHECK ( Result == Expected );
+	}
 }
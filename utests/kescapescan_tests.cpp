@@ -0,0 +1,143 @@
+#include "catch.hpp"
+
+#include <dekaf2/core/strings/bits/simd/kescapescan.h>
+#include <dekaf2/core/strings/kstring.h>
+#include <dekaf2/web/url/kurlencode.h>
+#include <dekaf2/web/html/khtmlentities.h>
+#include <dekaf2/data/json/kjson.h>
+#include <random>
+
+using namespace dekaf2;
+
+namespace {
+
+//-----------------------------------------------------------------------------
+std::size_t ScalarFind(KStringView sHaystack, const bool Table[256])
+//-----------------------------------------------------------------------------
+{
+	for (std::size_t i = 0; i < sHaystack.size(); ++i)
+	{
+		if (Table[static_cast<unsigned char>(sHaystack[i])])
+		{
+			return i;
+		}
+	}
+
+	return KStringView::npos;
+}
+
+} // end of anonymous namespace
+
+TEST_CASE("KEscapeScan")
+{
+	INFO ( detail::KEscapeScan::GetKernelName() );
+
+	SECTION("find_first_in")
+	{
+		detail::KEscapeScan Scan("\"&'<>");
+
+		CHECK ( Scan.find_first_in(""                         ) == KStringView::npos );
+		CHECK ( Scan.find_first_in("<"                        ) == 0 );
+		CHECK ( Scan.find_first_in("abc"                      ) == KStringView::npos );
+		CHECK ( Scan.find_first_in("abc&"                     ) == 3 );
+		CHECK ( Scan.find_first_in("0123456789abcde>"         ) == 15 );
+		CHECK ( Scan.find_first_in("0123456789abcdef>"        ) == 16 );
+		CHECK ( Scan.find_first_in("0123456789abcdef0123456'" ) == 23 );
+		CHECK ( Scan.find_first_in("0123456789abcdef0123456789abcdef0123456789abcdef\"") == 48 );
+		CHECK ( Scan.find_first_in("0123456789abcdef0123456789abcdef0123456789abcdefg" ) == KStringView::npos );
+		CHECK ( Scan.contains('&') );
+		CHECK ( Scan.contains('a') == false );
+	}
+
+	SECTION("empty set")
+	{
+		detail::KEscapeScan Scan;
+		KString sAll;
+
+		for (int ch = 0; ch < 256; ++ch)
+		{
+			sAll += static_cast<char>(ch);
+		}
+
+		CHECK ( Scan.find_first_in(sAll) == KStringView::npos );
+	}
+
+	SECTION("all single bytes")
+	{
+		// each byte value once at every position of a 70 byte buffer, which covers
+		// the full blocks and the overlapping last block of all kernels
+		KString sBuffer(70, '\x7f');
+
+		for (int ch = 0; ch < 256; ++ch)
+		{
+			if (ch == 0x7f) continue;
+
+			char Needle[1] { static_cast<char>(ch) };
+			detail::KEscapeScan Scan(KStringView(Needle, 1));
+
+			for (std::size_t iPos = 0; iPos < sBuffer.size(); ++iPos)
+			{
+				sBuffer[iPos] = static_cast<char>(ch);
+				CHECK ( Scan.find_first_in(sBuffer) == iPos );
+				sBuffer[iPos] = '\x7f';
+			}
+
+			CHECK ( Scan.find_first_in(sBuffer) == KStringView::npos );
+		}
+	}
+
+	SECTION("random sets and strings")
+	{
+		std::mt19937 Random(4711);
+
+		for (int iRound = 0; iRound < 200; ++iRound)
+		{
+			bool Table[256] {};
+			auto iDensity = Random() % 64 + 1;
+
+			for (int ch = 0; ch < 256; ++ch)
+			{
+				Table[ch] = (Random() % 256) < iDensity;
+			}
+
+			detail::KEscapeScan Scan(Table, true);
+			detail::KEscapeScan Inverse(Table, false);
+
+			KString sInput;
+			auto iSize = Random() % 200;
+
+			for (std::size_t i = 0; i < iSize; ++i)
+			{
+				sInput += static_cast<char>(Random());
+			}
+
+			for (std::size_t iStart = 0; iStart <= sInput.size(); iStart += 7)
+			{
+				KStringView sPart(sInput.data() + iStart, sInput.size() - iStart);
+				CHECK ( Scan.find_first_in(sPart) == ScalarFind(sPart, Table) );
+
+				bool Inverted[256];
+
+				for (int ch = 0; ch < 256; ++ch)
+				{
+					Inverted[ch] = !Table[ch];
+				}
+
+				CHECK ( Inverse.find_first_in(sPart) == ScalarFind(sPart, Inverted) );
+			}
+		}
+	}
+
+	SECTION("encoders with long clean runs")
+	{
+		KString sClean(100, 'a');
+
+		CHECK ( kUrlEncode(sClean + " " + sClean + "\xc3\xbc\xc3\xb6", URIPart::Query)
+		        == sClean + "+" + sClean + "%C3%BC%C3%B6" );
+		CHECK ( kUrlEncode(sClean + "/?" + sClean, URIPart::Path) == sClean + "/%3F" + sClean );
+		CHECK ( kUrlDecode(sClean + "+%41%zz" + sClean, true) == sClean + " A%zz" + sClean );
+		CHECK ( kUrlDecode(sClean + "+%41%zz" + sClean, false) == sClean + "+A%zz" + sClean );
+		CHECK ( KHTMLEntity::EncodeMandatory(sClean + "<&>" + sClean + "'\"") == sClean + "&lt;&amp;&gt;" + sClean + "&apos;&quot;" );
+		CHECK ( kjson::Escape(sClean + "\"\\\n\x01" + sClean) == sClean + "\\\"\\\\\\n\\u0001" + sClean );
+	}
+}
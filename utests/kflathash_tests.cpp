@@ -0,0 +1,220 @@
+#include "catch.hpp"
+
+#include <dekaf2/containers/associative/kflathash.h>
+#include <dekaf2/core/strings/kstring.h>
+#include <dekaf2/core/format/kformat.h>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using namespace dekaf2;
+
+TEST_CASE("KFlatHash")
+{
+	SECTION("KFlatHashSet")
+	{
+		KFlatHashSet<KString> set;
+		CHECK ( set.empty() );
+		CHECK ( set.find("key1") == set.end() );
+		CHECK ( set.begin() == set.end() );
+		set.insert("key1");
+		set.insert("key1");
+		set.insert("key2");
+		set.insert("key3");
+		set.emplace("key4");
+		CHECK ( set.size() == 4 );
+		CHECK ( set.find("key1") != set.end() );
+		CHECK ( set.find("key2") != set.end() );
+		CHECK ( set.find("key3") != set.end() );
+		CHECK ( set.find("key4") != set.end() );
+		CHECK ( set.find("key5") == set.end() );
+		CHECK ( set.find("key2"_ksv) != set.end() );
+		CHECK ( set.find("key3"_ksz) != set.end() );
+		CHECK ( set.find("key4"_ks ) != set.end() );
+		CHECK ( set.contains("key1"_ksv) );
+		CHECK ( set.count("key5") == 0 );
+		CHECK ( set.erase("key1"_ksv) == 1 );
+		CHECK ( set.erase("key1"_ksv) == 0 );
+		CHECK ( set.size() == 3 );
+		CHECK ( std::distance(set.begin(), set.end()) == 3 );
+	}
+
+	SECTION("KFlatHashMap")
+	{
+		KFlatHashMap<KString, KString> map;
+		map.insert({"key1", "value1"});
+		map.insert({"key1", "value11"});
+		map.insert({"key2", "value2"});
+		map.insert({"key3", "value3"});
+		map.emplace("key4", "value4");
+		CHECK ( map.size() == 4 );
+		CHECK ( map.find("key1")->second == "value1" );
+		CHECK ( map.find("key2")->second == "value2" );
+		CHECK ( map.find("key3")->second == "value3" );
+		CHECK ( map.find("key4")->second == "value4" );
+		CHECK ( map.find("key2"_ksv)->second == "value2" );
+		CHECK ( map.find("key3"_ksz)->second == "value3" );
+		CHECK ( map.find("key4"_ks )->second == "value4" );
+
+		map.find("key1"_ksv)->second = "changed";
+		CHECK ( map["key1"_ksv] == "changed" );
+
+		auto r = map.try_emplace("key5"_ksv, "value5");
+		CHECK ( r.second );
+		CHECK ( r.first->first == "key5" );
+		r = map.try_emplace("key5"_ksv, "value55");
+		CHECK ( r.second == false );
+		CHECK ( r.first->second == "value5" );
+
+		r = map.insert_or_assign("key5"_ksv, "value55");
+		CHECK ( r.second == false );
+		CHECK ( map["key5"] == "value55" );
+
+		map["key6"_ksv] = "value6";
+		CHECK ( map.size() == 6 );
+		CHECK ( map["key6"] == "value6" );
+
+		const auto& cmap = map;
+		CHECK ( cmap["key7"] == "" );
+		CHECK ( cmap.size() == 6 );
+		CHECK ( cmap.contains("key6") );
+		CHECK ( !cmap.contains("key7") );
+	}
+
+	SECTION("initializer list, copy and move")
+	{
+		KFlatHashMap<KString, int> map
+		{
+			{ "one"  , 1 },
+			{ "two"  , 2 },
+			{ "three", 3 }
+		};
+
+		CHECK ( map.size() == 3 );
+
+		auto copy = map;
+		CHECK ( copy == map );
+		copy["four"] = 4;
+		CHECK ( copy != map );
+		CHECK ( copy.size() == 4 );
+		CHECK ( map.size() == 3 );
+
+		auto moved = std::move(copy);
+		CHECK ( moved.size() == 4 );
+		CHECK ( copy.empty() );
+		CHECK ( copy.find("four") == copy.end() );
+		copy["five"] = 5;
+		CHECK ( copy.size() == 1 );
+
+		moved.swap(copy);
+		CHECK ( moved.size() == 1 );
+		CHECK ( copy.size() == 4 );
+		CHECK ( copy["four"] == 4 );
+
+		copy.clear();
+		CHECK ( copy.empty() );
+		CHECK ( copy.begin() == copy.end() );
+		CHECK ( copy.bucket_count() > 0 );
+		copy.rehash(0);
+		CHECK ( copy.bucket_count() == 0 );
+	}
+
+	SECTION("erase while iterating")
+	{
+		KFlatHashMap<int, int> map;
+
+		for (int i = 0; i < 1000; ++i)
+		{
+			map[i] = i * 2;
+		}
+
+		for (auto it = map.begin(); it != map.end();)
+		{
+			if (it->first % 3 == 0)
+			{
+				it = map.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+
+		CHECK ( map.size() == 666 );
+
+		for (int i = 0; i < 1000; ++i)
+		{
+			CHECK ( map.contains(i) == (i % 3 != 0) );
+		}
+	}
+
+	SECTION("reserve")
+	{
+		KFlatHashSet<int> set;
+		set.reserve(1000);
+		auto iBuckets = set.bucket_count();
+		CHECK ( iBuckets >= 1000 );
+
+		for (int i = 0; i < 1000; ++i)
+		{
+			set.insert(i);
+		}
+
+		CHECK ( set.bucket_count() == iBuckets );
+		CHECK ( set.load_factor() <= set.max_load_factor() );
+	}
+
+	SECTION("random compare with std::unordered_map")
+	{
+		std::mt19937 Random(4711);
+		std::uniform_int_distribution<int> Keys(0, 2000);
+		std::uniform_int_distribution<int> Action(0, 2);
+
+		KFlatHashMap<KString, int> map;
+		std::unordered_map<KString, int> ref;
+
+		for (int i = 0; i < 100000; ++i)
+		{
+			auto sKey = kFormat("key{}", Keys(Random));
+
+			switch (Action(Random))
+			{
+				case 0:
+					map[sKey] = i;
+					ref[sKey] = i;
+					break;
+
+				case 1:
+					CHECK ( map.erase(sKey.ToView()) == ref.erase(sKey) );
+					break;
+
+				case 2:
+				{
+					auto it1 = map.find(sKey.ToView());
+					auto it2 = ref.find(sKey);
+					REQUIRE ( (it1 == map.end()) == (it2 == ref.end()) );
+
+					if (it2 != ref.end())
+					{
+						CHECK ( it1->second == it2->second );
+					}
+					break;
+				}
+			}
+
+			REQUIRE ( map.size() == ref.size() );
+		}
+
+		std::size_t iCount { 0 };
+
+		for (const auto& it : map)
+		{
+			auto it2 = ref.find(it.first);
+			REQUIRE ( it2 != ref.end() );
+			CHECK ( it.second == it2->second );
+			++iCount;
+		}
+
+		CHECK ( iCount == ref.size() );
+	}
+}
@@ -3,6 +3,8 @@
 #include <dekaf2/core/strings/kstringview.h>
 #include <dekaf2/core/strings/kcaseless.h>
 #include <dekaf2/core/strings/kcasestring.h>
+#include <dekaf2/core/format/kformat.h>
+#include <set>
 
 
 
@@ -11,6 +13,8 @@ using namespace dekaf2;
 
 TEST_CASE("KHash")
 {
+#ifndef DEKAF2_USE_FAST_HASH
+	// these are the FNV values - with the fast hash, KStringView::Hash() uses wyhash
 	SECTION("Values")
 	{
 		KStringView sv;
@@ -45,6 +49,7 @@ TEST_CASE("KHash")
 			CHECK ( sv.Hash() == UINT32_C(1372156989) );
 		}
 	}
+#endif
 
 	SECTION("Literals")
 	{
@@ -62,7 +67,11 @@ TEST_CASE("KHash")
 		auto i3 = "hällo"_hash;
 
 		CHECK ( i1 == i2 );
+#ifndef DEKAF2_USE_FAST_HASH
 		CHECK ( i2 == i3 );
+#else
+		CHECK ( kStringHash("hällo") == i3 );
+#endif
 
 		KStringView sHello("hällo");
 
@@ -176,8 +185,11 @@ TEST_CASE("KHash")
 		hash += "bcdefg";
 		KString sStr("hijklmn");
 		hash += sStr;
+#ifndef DEKAF2_USE_FAST_HASH
 		CHECK (hash.Hash() == "abcdefghijklmn"_hash );
 		CHECK (hash.Hash() == KStringView("abcdefghijklmn").Hash() );
+#endif
+		CHECK (hash.Hash() == kHash("abcdefghijklmn") );
 		hash.clear();
 		hash += "";
 		sStr = "";
@@ -194,8 +206,11 @@ TEST_CASE("KHash")
 		hash += "bcDEfg";
 		KString sStr("hijKlmn");
 		hash += sStr;
+#ifndef DEKAF2_USE_FAST_HASH
 		CHECK (hash.Hash() == "abcdefghijklmn"_hash );
 		CHECK (hash.Hash() == KStringView("abcdefghijklmn").Hash() );
+#endif
+		CHECK (hash.Hash() == kHash("abcdefghijklmn") );
 		hash.clear();
 		hash += "";
 		sStr = "";
@@ -205,4 +220,84 @@ TEST_CASE("KHash")
 		CHECK (hash.Hash() == KStringView("").Hash() );
 	}
 
+	SECTION("kFastHash")
+	{
+		CHECK ( kFastHash("", 0) == 0 );
+		CHECK ( kFastHash("")    == 0 );
+
+		// all branches of the length dispatch, and the case insensitive variant
+		KString sUpper;
+		KString sLower;
+
+		for (std::size_t iLen = 0; iLen < 200; ++iLen)
+		{
+			INFO ( iLen );
+			CHECK ( kFastHash(sLower.data(), sLower.size())     == kFastHash(sLower.c_str()) );
+			CHECK ( kFastCaseHash(sUpper.data(), sUpper.size()) == kFastHash(sLower.data(), sLower.size()) );
+			CHECK ( kFastCaseHash(sLower.data(), sLower.size()) == kFastHash(sLower.data(), sLower.size()) );
+
+			if (iLen)
+			{
+				CHECK ( kFastHash(sUpper.data(), sUpper.size()) != kFastHash(sLower.data(), sLower.size()) );
+				CHECK ( kFastHash(sLower.data(), sLower.size(), 1) != kFastHash(sLower.data(), sLower.size(), 2) );
+			}
+
+			sUpper += static_cast<char>('A' + iLen % 26);
+			sLower += static_cast<char>('a' + iLen % 26);
+		}
+
+		// non-ASCII and the characters around the ASCII upper case range are not changed
+		KStringView sNoCase { "@[`{\xc3\x84\xc3\xa4\x80\xff@[`{\xc3\x84\xc3\xa4\x80\xff" };
+		CHECK ( kFastCaseHash(sNoCase.data(), sNoCase.size()) == kFastHash(sNoCase.data(), sNoCase.size()) );
+
+		// no collisions on a set of similar keys
+		std::set<uint64_t> Hashes;
+
+		for (int i = 0; i < 100000; ++i)
+		{
+			auto sKey = kFormat("/api/v1/user/{}/profile", i);
+			Hashes.insert(kFastHash(sKey.data(), sKey.size()));
+		}
+
+		CHECK ( Hashes.size() == 100000 );
+
+#ifdef DEKAF2_HAS_CPP_14
+		// compile time hashes need an explicit seed
+		constexpr KStringView sConst { "a constexpr literal that is longer than 48 bytes, to use all steps" };
+		constexpr auto iConst = kFastHash(sConst.data(), sConst.size(), hash::wyhash::DefaultSeed);
+		KString sRuntime { sConst };
+		CHECK ( iConst == kFastHash(sRuntime.data(), sRuntime.size(), hash::wyhash::DefaultSeed) );
+		constexpr KStringView sConstCase { "A Literal" };
+		constexpr auto iConstCase = kFastCaseHash(sConstCase.data(), sConstCase.size(), hash::wyhash::DefaultSeed);
+		CHECK ( iConstCase == kFastHash("a literal", 9, hash::wyhash::DefaultSeed) );
+#endif
+
+		// the default seed is chosen once per process
+		CHECK ( hash::GetProcessSeed() == hash::GetProcessSeed() );
+		CHECK ( kFastHash("a key") == kFastHash("a key", 5, hash::GetProcessSeed()) );
+#ifdef DEKAF2_FIXED_HASH_SEED
+		CHECK ( hash::GetProcessSeed() == hash::wyhash::DefaultSeed );
+#else
+		CHECK ( hash::GetProcessSeed() != hash::wyhash::DefaultSeed );
+#endif
+	}
+
+	SECTION("kStringHash")
+	{
+		KStringView sHello { "Hello World, this is a somewhat longer string" };
+
+		CHECK ( sHello.Hash()        == kStringHash(sHello.data(), sHello.size()) );
+		CHECK ( KString(sHello).Hash() == sHello.Hash() );
+		CHECK ( sHello.CaseHash()    == kStringCaseHash(sHello.data(), sHello.size()) );
+#ifdef DEKAF2_USE_FAST_HASH
+		// std::hash uses the seed of the process, Hash() the fixed seed of the _hash literal
+		CHECK ( std::hash<KString>()("Hello World, this is a somewhat longer string") == kFastHash(sHello.data(), sHello.size()) );
+#else
+		CHECK ( std::hash<KString>()("Hello World, this is a somewhat longer string") == sHello.Hash() );
+#endif
+		CHECK ( std::hash<KString>()("Hello World, this is a somewhat longer string") == std::hash<KStringView>()(sHello) );
+		CHECK ( KCaseStringView("Hello World, this is a somewhat longer string").Hash() == sHello.CaseHash() );
+		CHECK ( "Hello World, this is a somewhat longer string"_hash == sHello.Hash() );
+		CHECK ( "HELLO WORLD, this is a somewhat longer string"_casehash == sHello.CaseHash() );
+	}
 }
@@ -79,6 +79,15 @@ TEST_CASE("KHTTPHeader")
 		CHECK ( Header1 == "non-standard-header" );
 		CHECK ( Header1 != KHTTPHeader::X_FORWARDED_FOR );
 
+		// the transparent hash of header names matches the hash of the constructed header
+		std::hash<KHTTPHeader> Hasher;
+		CHECK ( Hasher("non-STANDARD-header")              == Header1.Hash() );
+		CHECK ( Hasher("non-standard-header"_ksv)          == Header1.Hash() );
+		CHECK ( Hasher(std::string("Non-Standard-Header")) == Header1.Hash() );
+		CHECK ( Hasher("AuThorization"_ks)                 == Header2.Hash() );
+		CHECK ( Hasher("")                                 == KHTTPHeader("").Hash() );
+		CHECK ( Hasher(KHTTPHeader::CONTENT_TYPE)          == Header3.Hash() );
+
 		KHTTPClient Client;
 		Client.AddHeader("key", "value");
 		Client.AddHeader("key"_ks, "value"_ks);
@@ -237,3 +246,42 @@ TEST_CASE("KHTTPHeaders::ParseContentLength")
 	CHECK ( H::ParseContentLength("18446744073709551616") == -1 ); // 2^64 (would wrap to 0)
 	CHECK ( H::ParseContentLength("99999999999999999999999999") == -1 );
 }
+
+TEST_CASE("KHTTPHeaders::KHeaderMap")
+{
+	KHTTPHeaders::KHeaderMap Headers;
+
+	Headers.Add(KHTTPHeader::HOST, "example.com");
+	Headers.Add("x-custom", "1");
+	Headers.Add(KHTTPHeader::SET_COOKIE, "a=1");
+	Headers.Add("set-cookie", "b=2");
+
+	CHECK ( Headers.size() == 4 );
+	CHECK ( Headers.Get("Host") == "example.com" );
+	CHECK ( Headers.Get("X-CUSTOM"_ksv) == "1" );
+	CHECK ( Headers.Get(KHTTPHeader("X-Custom")) == "1" );
+	CHECK ( Headers.Count(KHTTPHeader::SET_COOKIE) == 2 );
+	CHECK ( Headers.begin()->first == KHTTPHeader::HOST );
+
+	// grow beyond the linear search, the index has to find the same elements
+	for (int i = 0; i < 40; ++i)
+	{
+		Headers.Add(kFormat("X-Header-{}", i), kFormat("{}", i));
+	}
+
+	CHECK ( Headers.size() == 44 );
+	CHECK ( Headers.Get("x-header-27") == "27" );
+	CHECK ( Headers.Get("HOST") == "example.com" );
+	CHECK ( Headers.Count("Set-Cookie") == 2 );
+
+	auto Range = Headers.equal_range(KHTTPHeader::SET_COOKIE);
+	REQUIRE ( Range.first != Range.second );
+	// like KProps, the last inserted element comes first
+	CHECK ( Range.first->second == "b=2" );
+	CHECK ( (++Range.first)->second == "a=1" );
+
+	CHECK ( Headers.Remove("set-cookie") == 2 );
+	CHECK ( Headers.size() == 42 );
+	CHECK ( Headers.Get("x-header-39") == "39" );
+	CHECK ( !Headers.contains(KHTTPHeader::SET_COOKIE) );
+}
@@ -0,0 +1,162 @@
+#include "catch.hpp"
+
+#include <dekaf2/http/client/khttpconnectionpool.h>
+#include <dekaf2/http/client/kwebclient.h>
+#include <dekaf2/core/strings/kstring.h>
+#include <dekaf2/system/os/ksystem.h>
+#include <dekaf2/rest/framework/krest.h>
+
+#ifndef DEKAF2_IS_WINDOWS
+
+using namespace dekaf2;
+
+namespace {
+
+void pool_test(KRESTServer& REST)
+{
+	REST.SetRawOutput("pooled");
+	REST.SetStatus(200);
+}
+
+KString PooledGet(KStringView sURL)
+{
+	KWebClient HTTP;
+	HTTP.UseConnectionPool();
+	return HTTP.Get(sURL);
+}
+
+} // end of anonymous namespace
+
+TEST_CASE("KHTTPConnectionPool")
+{
+	constexpr KRESTRoutes::FunctionTable RTable[]
+	{
+		{ "GET", false, "/pool", pool_test, KRESTRoute::PLAIN },
+	};
+
+	KRESTRoutes Routes;
+	Routes.AddFunctionTable(RTable);
+
+	KREST::Options Options;
+	Options.Type      = KREST::HTTP;
+	Options.iPort     = 7683;
+	// idle keep-alive connections are closed by the server after one second
+	Options.iTimeout  = 1;
+	Options.bPollForDisconnect = false;
+	Options.bBlocking = false;
+	Options.bCreateEphemeralCert = false;
+
+	KREST REST;
+	REST.Execute(Options, Routes);
+
+	auto& Pool = KHTTPConnectionPool::getInstance();
+	Pool.clear();
+	Pool.ResetStatistics();
+
+	SECTION("reuse")
+	{
+		for (int i = 0; i < 5; ++i)
+		{
+			CHECK ( PooledGet("http://localhost:7683/pool") == "pooled" );
+		}
+
+		auto Stats = Pool.GetStatistics();
+		CHECK ( Stats.iConnects   == 1 );
+		CHECK ( Stats.iHandshakes == 0 );
+		CHECK ( Stats.iMisses     == 1 );
+		CHECK ( Stats.iHits       == 4 );
+		CHECK ( Stats.iReturned   == 5 );
+		CHECK ( Stats.iIdle       == 1 );
+		CHECK ( Stats.GetHitRate() == 0.8 );
+
+		{
+			// not opted in
+			KWebClient HTTP;
+			CHECK ( HTTP.Get("http://localhost:7683/pool") == "pooled" );
+		}
+
+		CHECK ( Pool.GetStatistics().iConnects == 1 );
+		CHECK ( Pool.GetStatistics().iReturned == 5 );
+
+		KHTTPConnectionPool::SetUseByDefault(true);
+
+		{
+			KWebClient HTTP;
+			CHECK ( HTTP.Get("http://localhost:7683/pool") == "pooled" );
+			// a second request on the same client keeps its connection
+			CHECK ( HTTP.Get("http://localhost:7683/pool") == "pooled" );
+		}
+
+		KHTTPConnectionPool::SetUseByDefault(false);
+
+		Stats = Pool.GetStatistics();
+		CHECK ( Stats.iConnects == 1 );
+		CHECK ( Stats.iHits     == 5 );
+		CHECK ( Stats.iReturned == 6 );
+
+		Pool.clear();
+		CHECK ( Pool.GetStatistics().iIdle == 0 );
+	}
+
+	SECTION("limits")
+	{
+		Pool.SetMaxIdlePerHost(2);
+
+		{
+			KWebClient HTTP1, HTTP2, HTTP3;
+
+			for (auto* HTTP : { &HTTP1, &HTTP2, &HTTP3 })
+			{
+				HTTP->UseConnectionPool();
+				CHECK ( HTTP->Get("http://localhost:7683/pool") == "pooled" );
+			}
+
+			// a different key for the same host
+			KWebClient HTTP4;
+			HTTP4.UseConnectionPool().SetVerifyCerts(true);
+			CHECK ( HTTP4.Get("http://localhost:7683/pool") == "pooled" );
+		}
+
+		auto Stats = Pool.GetStatistics();
+		CHECK ( Stats.iConnects == 4 );
+		CHECK ( Stats.iEvicted  == 1 );
+		CHECK ( Stats.iIdle     == 3 );
+
+		Pool.SetMaxIdleTotal(1);
+		CHECK ( Pool.GetStatistics().iIdle    == 1 );
+		CHECK ( Pool.GetStatistics().iEvicted == 3 );
+
+		Pool.SetMaxIdlePerHost(KHTTPConnectionPool::DefaultMaxIdlePerHost);
+		Pool.SetMaxIdleTotal(KHTTPConnectionPool::DefaultMaxIdleTotal);
+		Pool.clear();
+	}
+
+	SECTION("expired and stale")
+	{
+		auto MaxIdleTime = Pool.GetMaxIdleTime();
+		Pool.SetMaxIdleTime(chrono::milliseconds(50));
+
+		CHECK ( PooledGet("http://localhost:7683/pool") == "pooled" );
+		kSleep(chrono::milliseconds(100));
+		CHECK ( PooledGet("http://localhost:7683/pool") == "pooled" );
+
+		auto Stats = Pool.GetStatistics();
+		CHECK ( Stats.iExpired  == 1 );
+		CHECK ( Stats.iConnects == 2 );
+
+		Pool.SetMaxIdleTime(MaxIdleTime);
+
+		// let the server close the idle connection
+		kSleep(chrono::milliseconds(1500));
+		CHECK ( PooledGet("http://localhost:7683/pool") == "pooled" );
+
+		Stats = Pool.GetStatistics();
+		CHECK ( Stats.iStale    == 1 );
+		CHECK ( Stats.iHits     == 0 );
+		CHECK ( Stats.iConnects == 3 );
+
+		Pool.clear();
+	}
+}
+
+#endif // DEKAF2_IS_WINDOWS
@@ -0,0 +1,413 @@
+#include "catch.hpp"
+
+#include <dekaf2/http/client/khttpmulticlient.h>
+#include <dekaf2/core/strings/kstring.h>
+#include <dekaf2/system/os/ksystem.h>
+#include <dekaf2/rest/framework/krest.h>
+#include <atomic>
+#include <vector>
+
+#if DEKAF2_HAS_NGHTTP2
+	#include <dekaf2/net/tcp/ktcpserver.h>
+	#include <dekaf2/net/tls/ktlscontext.h>
+	#include <array>
+	#include <cstring>
+	#include <map>
+	#define NGHTTP2_NO_SSIZE_T 1
+	#include <nghttp2/nghttp2.h>
+	#if (NGHTTP2_VERSION_NUM < 0x013d00)
+		#define DEKAF2_OLD_NGHTTP2_VERSION 1
+	#endif
+#endif
+
+#ifndef DEKAF2_IS_WINDOWS
+
+using namespace dekaf2;
+
+namespace {
+
+std::atomic<int> g_iRunning { 0 };
+std::atomic<int> g_iMaxRunning { 0 };
+
+void multi_echo(KRESTServer& REST)
+{
+	auto iRunning = ++g_iRunning;
+	auto iMax     = g_iMaxRunning.load();
+
+	while (iRunning > iMax && !g_iMaxRunning.compare_exchange_weak(iMax, iRunning)) {}
+
+	// make the requests overlap
+	kSleep(chrono::milliseconds(100));
+
+	REST.SetRawOutput(kFormat("{}:{}", REST.Request.Headers.Get(KHTTPHeader("x-id")), REST.GetRequestBody()));
+	REST.SetStatus(200);
+
+	--g_iRunning;
+}
+
+#if DEKAF2_HAS_NGHTTP2
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+/// a minimal HTTP/2 server that answers each request with "<x-id>:<body>",
+/// except requests for /stall, which are never answered
+class KHTTP2TestServer : public KTCPServer
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+{
+
+public:
+
+	using KTCPServer::KTCPServer;
+
+protected:
+
+#if DEKAF2_OLD_NGHTTP2_VERSION
+	using ReadResult   = ssize_t;
+	using DataProvider = nghttp2_data_provider;
+#else
+	using ReadResult   = nghttp2_ssize;
+	using DataProvider = nghttp2_data_provider2;
+#endif
+
+	struct StreamData
+	{
+		KString     sPath;
+		KString     sID;
+		KString     sBody;
+		KString     sResponse;
+		std::size_t iSent { 0 };
+	};
+
+	using Streams = std::map<int32_t, StreamData>;
+
+	static int OnHeader(nghttp2_session*, const nghttp2_frame* frame,
+	                    const uint8_t* name, size_t namelen, const uint8_t* value, size_t valuelen,
+	                    uint8_t, void* user_data)
+	{
+		if (frame->hd.type == NGHTTP2_HEADERS)
+		{
+			auto& Stream = (*static_cast<Streams*>(user_data))[frame->hd.stream_id];
+
+			KStringView sName (reinterpret_cast<const char*>(name ), namelen );
+			KStringView sValue(reinterpret_cast<const char*>(value), valuelen);
+
+			if      (sName == ":path") Stream.sPath = sValue;
+			else if (sName == "x-id" ) Stream.sID   = sValue;
+		}
+
+		return 0;
+	}
+
+	static int OnDataChunk(nghttp2_session*, uint8_t, int32_t stream_id, const uint8_t* data, size_t len, void* user_data)
+	{
+		(*static_cast<Streams*>(user_data))[stream_id].sBody.append(reinterpret_cast<const char*>(data), len);
+		return 0;
+	}
+
+	static ReadResult ReadBody(nghttp2_session*, int32_t stream_id, uint8_t* buf, size_t length,
+	                           uint32_t* data_flags, nghttp2_data_source*, void* user_data)
+	{
+		auto& Stream = (*static_cast<Streams*>(user_data))[stream_id];
+		auto  iCopy  = std::min(length, Stream.sResponse.size() - Stream.iSent);
+
+		std::memcpy(buf, Stream.sResponse.data() + Stream.iSent, iCopy);
+		Stream.iSent += iCopy;
+
+		if (Stream.iSent == Stream.sResponse.size())
+		{
+			*data_flags |= NGHTTP2_DATA_FLAG_EOF;
+		}
+
+		return static_cast<ReadResult>(iCopy);
+	}
+
+	static int OnFrameRecv(nghttp2_session* session, const nghttp2_frame* frame, void* user_data)
+	{
+		if ((frame->hd.type == NGHTTP2_HEADERS || frame->hd.type == NGHTTP2_DATA)
+			&& (frame->hd.flags & NGHTTP2_FLAG_END_STREAM))
+		{
+			auto& Stream = (*static_cast<Streams*>(user_data))[frame->hd.stream_id];
+
+			if (Stream.sPath == "/stall")
+			{
+				return 0;
+			}
+
+			Stream.sResponse = kFormat("{}:{}", Stream.sID, Stream.sBody);
+
+			static constexpr KStringView sStatus { ":status" };
+			static constexpr KStringView s200    { "200"     };
+
+			nghttp2_nv Header;
+			Header.name     = reinterpret_cast<uint8_t*>(const_cast<char*>(sStatus.data()));
+			Header.namelen  = sStatus.size();
+			Header.value    = reinterpret_cast<uint8_t*>(const_cast<char*>(s200.data()));
+			Header.valuelen = s200.size();
+			Header.flags    = NGHTTP2_NV_FLAG_NONE;
+
+			DataProvider Data;
+			Data.source.ptr    = nullptr;
+			Data.read_callback = ReadBody;
+
+#if DEKAF2_OLD_NGHTTP2_VERSION
+			nghttp2_submit_response (session, frame->hd.stream_id, &Header, 1, &Data);
+#else
+			nghttp2_submit_response2(session, frame->hd.stream_id, &Header, 1, &Data);
+#endif
+		}
+
+		return 0;
+	}
+
+	virtual void Session(std::unique_ptr<KIOStreamSocket>& Stream) override
+	{
+		Streams AllStreams;
+
+		nghttp2_session_callbacks* Callbacks { nullptr };
+		nghttp2_session_callbacks_new(&Callbacks);
+		nghttp2_session_callbacks_set_on_header_callback         (Callbacks, OnHeader   );
+		nghttp2_session_callbacks_set_on_data_chunk_recv_callback(Callbacks, OnDataChunk);
+		nghttp2_session_callbacks_set_on_frame_recv_callback     (Callbacks, OnFrameRecv);
+
+		nghttp2_session* pSession { nullptr };
+		nghttp2_session_server_new(&pSession, Callbacks, &AllStreams);
+		nghttp2_session_callbacks_del(Callbacks);
+
+		// permit only a few concurrent streams, so that the client has to queue
+		nghttp2_settings_entry Settings { NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS, 4 };
+		nghttp2_submit_settings(pSession, NGHTTP2_FLAG_NONE, &Settings, 1);
+
+		std::array<char, 16 * 1024> Buffer;
+
+		for (;;)
+		{
+			for (;;)
+			{
+				const uint8_t* pSend { nullptr };
+#if DEKAF2_OLD_NGHTTP2_VERSION
+				auto iSend = nghttp2_session_mem_send (pSession, &pSend);
+#else
+				auto iSend = nghttp2_session_mem_send2(pSession, &pSend);
+#endif
+				if (iSend <= 0)
+				{
+					break;
+				}
+
+				Stream->Write(pSend, static_cast<std::size_t>(iSend));
+			}
+
+			Stream->Flush();
+
+			auto iRead = Stream->direct_read_some(Buffer.data(), Buffer.size());
+
+			if (iRead <= 0)
+			{
+				break;
+			}
+
+#if DEKAF2_OLD_NGHTTP2_VERSION
+			auto iResult = nghttp2_session_mem_recv (pSession, reinterpret_cast<const uint8_t*>(Buffer.data()), static_cast<std::size_t>(iRead));
+#else
+			auto iResult = nghttp2_session_mem_recv2(pSession, reinterpret_cast<const uint8_t*>(Buffer.data()), static_cast<std::size_t>(iRead));
+#endif
+			if (iResult < 0)
+			{
+				break;
+			}
+		}
+
+		nghttp2_session_del(pSession);
+	}
+
+}; // KHTTP2TestServer
+
+#endif // DEKAF2_HAS_NGHTTP2
+
+} // end of anonymous namespace
+
+TEST_CASE("KHTTPMultiClient")
+{
+	constexpr KRESTRoutes::FunctionTable RTable[]
+	{
+		{ "GET",  false, "/echo", multi_echo, KRESTRoute::PLAIN },
+		{ "POST", false, "/echo", multi_echo, KRESTRoute::PLAIN },
+	};
+
+	KRESTRoutes Routes;
+	Routes.AddFunctionTable(RTable);
+
+	KREST::Options Options;
+	Options.Type      = KREST::HTTP;
+	Options.iPort     = 7681;
+	Options.bPollForDisconnect = false;
+	Options.bBlocking = false;
+	Options.bCreateEphemeralCert = false;
+
+	KREST REST;
+	REST.Execute(Options, Routes);
+
+	SECTION("futures")
+	{
+		g_iMaxRunning = 0;
+
+		KHTTPMultiClient Client("http://localhost:7681", {}, 4);
+
+		CHECK ( Client.GetHTTPVersion() == KHTTPVersion::none );
+
+		std::vector<std::future<KHTTPMultiClient::Response>> Futures;
+
+		for (int i = 0; i < 8; ++i)
+		{
+			KHTTPMultiClient::Request Request("/echo", KHTTPMethod::POST, kFormat("body {}", i), KMIME::TEXT_PLAIN);
+			Request.Headers.Add(KHTTPHeader("x-id"), KString::to_string(i));
+			Futures.push_back(Client.Submit(std::move(Request)));
+		}
+
+		for (int i = 0; i < 8; ++i)
+		{
+			auto Response = Futures[i].get();
+			INFO ( Response.GetLastError() );
+			CHECK ( Response.HttpSuccess() );
+			CHECK ( Response.GetStatusCode() == 200 );
+			CHECK ( Response.sBody == kFormat("{}:body {}", i, i) );
+		}
+
+		CHECK ( Client.GetHTTPVersion() == KHTTPVersion::http11 );
+		CHECK ( g_iMaxRunning > 1 );
+		CHECK ( g_iMaxRunning <= 4 );
+	}
+
+	SECTION("callbacks")
+	{
+		KHTTPMultiClient Client("http://localhost:7681");
+
+		std::atomic<int> iSuccess { 0 };
+
+		{
+			std::promise<void> Done;
+			std::atomic<int>   iOpen { 3 };
+
+			for (int i = 0; i < 3; ++i)
+			{
+				Client.Submit(KHTTPMultiClient::Request("http://localhost:7681/echo"), [&](KHTTPMultiClient::Response Response)
+				{
+					if (Response.HttpSuccess() && Response.sBody == ":") ++iSuccess;
+					if (--iOpen == 0) Done.set_value();
+				});
+			}
+
+			Done.get_future().wait();
+		}
+
+		CHECK ( iSuccess == 3 );
+
+		auto Response = Client.Get("/nothing/here").get();
+		CHECK ( Response.GetStatusCode() == 404 );
+		CHECK ( Response.HasError() == false );
+		CHECK ( Response.HttpSuccess() == false );
+	}
+
+	SECTION("errors")
+	{
+		KHTTPMultiClient Client("http://localhost:7681");
+
+		auto Response = Client.Get("http://localhost:7682/echo").get();
+		CHECK ( Response.HasError() );
+		CHECK ( Response.HttpSuccess() == false );
+
+		KHTTPMultiClient Unreachable("http://localhost:7682");
+		Response = Unreachable.Get("/echo").get();
+		CHECK ( Response.HasError() );
+		CHECK ( Response.GetStatusCode() == 0 );
+	}
+
+	SECTION("shutdown")
+	{
+		std::vector<std::future<KHTTPMultiClient::Response>> Futures;
+
+		{
+			KHTTPMultiClient Client("http://localhost:7681", {}, 1);
+
+			for (int i = 0; i < 5; ++i)
+			{
+				Futures.push_back(Client.Get("/echo"));
+			}
+		}
+
+		std::size_t iFailed { 0 };
+
+		for (auto& Future : Futures)
+		{
+			// all futures are ready after the destruction of the client
+			REQUIRE ( Future.wait_for(std::chrono::seconds(0)) == std::future_status::ready );
+
+			if (Future.get().HasError()) ++iFailed;
+		}
+
+		CHECK ( iFailed > 0 );
+	}
+}
+
+#if DEKAF2_HAS_NGHTTP2
+
+TEST_CASE("KHTTPMultiClient HTTP/2")
+{
+	KHTTP2TestServer Server(7683, true, 4);
+	Server.SetBindAddress("127.0.0.1");
+
+	REQUIRE ( Server.Start(chrono::seconds(5), false) );
+	REQUIRE ( Server.GetTLSContext() );
+	Server.GetTLSContext()->SetALPN("h2");
+
+	SECTION("multiplexing")
+	{
+		KHTTPMultiClient Client("https://127.0.0.1:7683");
+
+		std::vector<std::future<KHTTPMultiClient::Response>> Futures;
+
+		// more requests than the server permits concurrent streams
+		for (int i = 0; i < 20; ++i)
+		{
+			KHTTPMultiClient::Request Request("/echo", KHTTPMethod::POST, kFormat("body {}", i), KMIME::TEXT_PLAIN);
+			Request.Headers.Add(KHTTPHeader("x-id"), KString::to_string(i));
+			Futures.push_back(Client.Submit(std::move(Request)));
+		}
+
+		for (int i = 0; i < 20; ++i)
+		{
+			auto Response = Futures[i].get();
+			INFO ( Response.GetLastError() );
+			CHECK ( Response.HttpSuccess() );
+			CHECK ( Response.sBody == kFormat("{}:body {}", i, i) );
+		}
+
+		CHECK ( Client.GetHTTPVersion() == KHTTPVersion::http2 );
+	}
+
+	SECTION("stalled stream")
+	{
+		KHTTPMultiClient Client("https://127.0.0.1:7683", KHTTPStreamOptions(chrono::seconds(1)));
+
+		auto Stalled = Client.Get("/stall");
+
+		// new requests wake up the connection thread, but must not extend
+		// the deadline of the stalled stream
+		KStopTime Timer;
+
+		while (Stalled.wait_for(std::chrono::milliseconds(100)) != std::future_status::ready
+		       && Timer.elapsed() < chrono::seconds(5))
+		{
+			Client.Get("/echo");
+		}
+
+		REQUIRE ( Stalled.wait_for(std::chrono::seconds(0)) == std::future_status::ready );
+		CHECK   ( Stalled.get().HasError() );
+		CHECK   ( Timer.elapsed() < chrono::seconds(3) );
+	}
+
+	Server.Stop();
+}
+
+#endif // DEKAF2_HAS_NGHTTP2
+
+#endif // DEKAF2_IS_WINDOWS
@@ -2,6 +2,10 @@
 
 #include <dekaf2/core/logging/klog.h>
 #include <dekaf2/core/strings/kstring.h>
+#include <dekaf2/io/readwrite/kreader.h>
+#include <dekaf2/system/filesystem/kfilesystem.h>
+#include <thread>
+#include <vector>
 
 using namespace dekaf2;
 
@@ -28,4 +32,100 @@ TEST_CASE("KLog") {
 		CHECK ( KLog::getInstance().GetName().empty() == true );
 #endif
 	}
+
+#ifdef DEKAF2_WITH_KLOG
+	SECTION("asynchronous logging")
+	{
+		auto& Log        = KLog::getInstance();
+		KString sOldLog  = Log.GetDebugLog();
+		auto iOldLevel   = Log.GetLevel();
+
+		KTempDir TempDir;
+		KString sLogFile = kFormat("{}{}async.log", TempDir.Name(), kDirSep);
+
+		CHECK ( Log.SetDebugLog(sLogFile) );
+		Log.SetLevel(1);
+		Log.SetAsync(true, 64, KLog::AsyncOverflow::Block);
+		CHECK ( Log.IsAsync() );
+
+		constexpr std::size_t iThreads { 4   };
+		constexpr std::size_t iLines   { 500 };
+
+		std::vector<std::thread> Threads;
+
+		for (std::size_t t = 0; t < iThreads; ++t)
+		{
+			Threads.emplace_back([t]()
+			{
+				KLog::SyncLevel();
+
+				for (std::size_t i = 0; i < iLines; ++i)
+				{
+					kDebug(1, "async-test {} {}", t, i);
+				}
+			});
+		}
+
+		for (auto& Thread : Threads)
+		{
+			Thread.join();
+		}
+
+		CHECK ( Log.Flush() );
+		Log.SetAsync(false);
+		CHECK ( Log.IsAsync() == false );
+		CHECK ( Log.GetDroppedLines() == 0 );
+
+		kDebug(1, "async-test sync");
+
+		Log.SetLevel(iOldLevel);
+		Log.SetDebugLog(sOldLog);
+
+		auto sContent = kReadAll(sLogFile);
+		std::size_t iCount { 0 };
+
+		for (std::size_t iPos = 0; (iPos = sContent.find("async-test ", iPos)) != KString::npos; ++iPos)
+		{
+			++iCount;
+		}
+
+		CHECK ( iCount == iThreads * iLines + 1 );
+		CHECK ( sContent.contains("async-test 3 499") );
+		// the synchronous line comes last
+		CHECK ( sContent.rfind("async-test sync") > sContent.rfind("async-test 0 499") );
+	}
+
+	SECTION("flush on crash")
+	{
+		auto& Log        = KLog::getInstance();
+		KString sOldLog  = Log.GetDebugLog();
+		auto iOldLevel   = Log.GetLevel();
+
+		KTempDir TempDir;
+		KString sLogFile = kFormat("{}{}crash.log", TempDir.Name(), kDirSep);
+
+		CHECK ( Log.SetDebugLog(sLogFile) );
+		Log.SetLevel(1);
+		Log.SetAsync(true, 1024, KLog::AsyncOverflow::Block);
+
+		for (std::size_t i = 0; i < 500; ++i)
+		{
+			kDebug(1, "crash-test {}", i);
+		}
+
+		// does not lock, but polls until the queue is written
+		Log.FlushOnCrash();
+		CHECK ( Log.IsAsync() == false );
+
+		kDebug(1, "crash-test sync");
+
+		Log.SetLevel(iOldLevel);
+		Log.SetDebugLog(sOldLog);
+
+		auto sContent = kReadAll(sLogFile);
+
+		CHECK ( sContent.contains("crash-test 499") );
+		CHECK ( sContent.rfind("crash-test sync") > sContent.rfind("crash-test 499") );
+	}
+#endif
 }
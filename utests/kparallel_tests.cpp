@@ -4,6 +4,10 @@
 #include <dekaf2/core/strings/kstring.h>
 #include <dekaf2/system/os/ksystem.h>
 #include <dekaf2/core/format/kbar.h>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
 
 using namespace dekaf2;
 
@@ -20,6 +24,18 @@ struct Foo
 	}
 };
 
+// counts the progress, must only be called from one thread
+struct CountingProgress
+{
+	void Start  (std::size_t iMax)       { iExpected = iMax;   }
+	void Move   (std::size_t iDelta = 1) { iMoved += iDelta;   }
+	void Finish ()                       { bFinished = true;   }
+
+	std::size_t iExpected { 0 };
+	std::size_t iMoved    { 0 };
+	bool        bFinished { false };
+};
+
 }
 
 TEST_CASE("KParallel")
@@ -63,5 +79,191 @@ TEST_CASE("KParallel")
 		}, 0, KBAR());
 	}
 
-}
+	SECTION("kParallelFor")
+	{
+		std::vector<uint8_t> Visited(1000000, 0);
+		CountingProgress Progress;
+
+		kParallelFor(0, Visited.size(), [&Visited](std::size_t i)
+		{
+			++Visited[i];
+
+		}, 0, Progress);
+
+		CHECK ( std::count(Visited.begin(), Visited.end(), 1) == 1000000 );
+		CHECK ( Progress.iExpected == 1000000 );
+		CHECK ( Progress.iMoved    == 1000000 );
+		CHECK ( Progress.bFinished );
+
+		std::atomic<std::size_t> iSum { 0 };
+
+		kParallelFor(10, 20, [&iSum](std::size_t i)
+		{
+			iSum += i;
+		});
+
+		CHECK ( iSum == 145 );
+
+		// nothing to do
+		kParallelFor(5, 5, [](std::size_t i)
+		{
+			FAIL ( "called" );
+		});
+	}
+
+	SECTION("kParallelFor nested and exceptions")
+	{
+		std::atomic<std::size_t> iCount { 0 };
+
+		kParallelFor(0, 100, [&iCount](std::size_t)
+		{
+			// runs serially in the calling thread
+			kParallelFor(0, 100, [&iCount](std::size_t)
+			{
+				++iCount;
+			});
+		});
+
+		CHECK ( iCount == 10000 );
+
+		CHECK_THROWS_AS ( kParallelFor(0, 100000, [](std::size_t i)
+		{
+			if (i == 77777)
+			{
+				throw std::runtime_error("failed");
+			}
+		}), const std::runtime_error& );
+
+		// the scheduler is still usable
+		iCount = 0;
+
+		kParallelFor(0, 1000, [&iCount](std::size_t)
+		{
+			++iCount;
+		});
+
+		CHECK ( iCount == 1000 );
+	}
+
+	SECTION("kParallelFor concurrent jobs")
+	{
+		// jobs started from different threads run side by side on the scheduler
+		std::atomic<std::size_t> iCount { 0 };
+		std::vector<std::thread> Threads;
+
+		for (int t = 0; t < 4; ++t)
+		{
+			Threads.push_back(std::thread([&iCount]()
+			{
+				for (int r = 0; r < 20; ++r)
+				{
+					kParallelFor(0, 10000, [&iCount](std::size_t)
+					{
+						++iCount;
+					});
+				}
+			}));
+		}
+
+		for (auto& Thread : Threads)
+		{
+			Thread.join();
+		}
 
+		CHECK ( iCount == 4 * 20 * 10000 );
+	}
+
+	SECTION("kParallelForEach random access")
+	{
+		std::vector<std::size_t> vec(100000);
+		std::iota(vec.begin(), vec.end(), 0);
+
+		kParallelForEach(vec, [](std::size_t& value)
+		{
+			value *= 2;
+
+		}, 0);
+
+		for (std::size_t i = 0; i < vec.size(); ++i)
+		{
+			if (vec[i] != i * 2)
+			{
+				CHECK ( vec[i] == i * 2 );
+				break;
+			}
+		}
+	}
+
+	SECTION("kParallelTransform")
+	{
+		std::vector<int> In(200000);
+		std::iota(In.begin(), In.end(), 0);
+		std::vector<long> Out(In.size());
+
+		auto it = kParallelTransform(In.begin(), In.end(), Out.begin(), [](int i) { return long(i) * 3; });
+
+		CHECK ( it == Out.end() );
+
+		for (std::size_t i = 0; i < Out.size(); ++i)
+		{
+			if (Out[i] != long(i) * 3)
+			{
+				CHECK ( Out[i] == long(i) * 3 );
+				break;
+			}
+		}
+	}
+
+	SECTION("kParallelReduce")
+	{
+		std::vector<uint64_t> vec(1000000);
+		std::iota(vec.begin(), vec.end(), 1);
+
+		CHECK ( kParallelReduce(vec.begin(), vec.end(), uint64_t(0)) == uint64_t(1000000) * 1000001 / 2 );
+		CHECK ( kParallelReduce(vec.begin(), vec.begin(), uint64_t(42)) == 42 );
+
+		// not commutative: the order has to be kept
+		std::vector<KString> Words;
+		KString sExpected;
+
+		for (int i = 0; i < 5000; ++i)
+		{
+			Words.push_back(kFormat("{},", i));
+			sExpected += Words.back();
+		}
+
+		auto sResult = kParallelReduce(Words.begin(), Words.end(), KString("start:"), [](KString sLeft, const KString& sRight)
+		{
+			return sLeft + sRight;
+		});
+
+		CHECK ( sResult == "start:" + sExpected );
+	}
+
+	SECTION("kParallelSort")
+	{
+		std::mt19937 Random(1234);
+
+		for (auto iSize : { 0, 1, 100, 50000, 333333 })
+		{
+			std::vector<uint32_t> vec(iSize);
+
+			for (auto& i : vec)
+			{
+				i = Random();
+			}
+
+			auto Expected = vec;
+			std::sort(Expected.begin(), Expected.end());
+
+			kParallelSort(vec.begin(), vec.end());
+			CHECK ( vec == Expected );
+
+			std::sort(Expected.begin(), Expected.end(), std::greater<uint32_t>());
+
+			kParallelSort(vec.begin(), vec.end(), std::greater<uint32_t>(), 3);
+			CHECK ( vec == Expected );
+		}
+	}
+
+}
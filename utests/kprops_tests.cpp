@@ -3,10 +3,12 @@
 #include <dekaf2/containers/associative/kprops.h>
 #include <dekaf2/core/strings/kstring.h>
 #include <dekaf2/core/init/kcompatibility.h>
+#include <dekaf2/core/format/kformat.h>
 #include <dekaf2/io/streams/kinstringstream.h>
 #include <dekaf2/system/filesystem/kfilesystem.h>
 #include <unordered_map>
 #include <map>
+#include <vector>
 using namespace dekaf2;
 
 namespace {
@@ -860,3 +862,109 @@ test=xyz
 	}
 
 }
+
+TEST_CASE("KSmallProps")
+{
+	SECTION("Sequential KSmallProps with <KString, KString>")
+	{
+		KSmallProps<KString, KString> data;
+
+		data.Add("hello", "bonjour");
+		data.Add("test", "toast");
+		data.Add("hello", "bonjour");
+		data.Add("color", "black");
+		data.Add("color", "blue");
+		data.Add("color", "red");
+
+		CHECK ( data.size() == 6 );
+		CHECK ( data[0].first  == "hello" );
+		CHECK ( data[1].first  == "test"  );
+		CHECK ( data[4].second == "blue"  );
+		CHECK ( data["color"_ksv] == "red" );
+		CHECK ( data.Count("color") == 3 );
+		CHECK ( data.IsMulti("color") );
+		CHECK ( !data.IsMulti("test") );
+
+		auto range = data.GetMulti("color");
+		CHECK ( std::distance(range.first, range.second) == 3 );
+		CHECK ( range.first->second == "red" );
+
+		data.Set("color", "blue", "yellow");
+		CHECK ( data[3].second == "black"  );
+		CHECK ( data[4].second == "yellow" );
+		CHECK ( data[5].second == "red"    );
+
+		data.Set("color", "white");
+		CHECK ( data[3].second == "white" );
+		CHECK ( data[5].second == "white" );
+
+		CHECK ( data.Remove("hello") == 2 );
+		CHECK ( data.size() == 4 );
+		CHECK ( data[0].first == "test" );
+		CHECK ( data["hello"] == "" );
+		CHECK ( data.size() == 5 );
+		CHECK ( data[4].first == "hello" );
+	}
+
+	SECTION("Sequential unique KSmallProps")
+	{
+		KSmallProps<KString, KString, true, true> data { { "a", "1" }, { "b", "2" } };
+
+		CHECK ( data.Add("a", "3")->second == "3" );
+		CHECK ( data.insert({ "b", "4" }).second == false );
+		CHECK ( data.size() == 2 );
+		CHECK ( data.Get("a") == "3" );
+		CHECK ( data.Get("b") == "2" );
+		CHECK ( data.Count("a") == 1 );
+		CHECK ( data.erase("a") == 1 );
+		CHECK ( data.erase("a") == 0 );
+		CHECK ( data.size() == 1 );
+	}
+
+	SECTION("compare with KProps, below and above the linear search limit")
+	{
+		KProps<KString, KString>      props;
+		KSmallProps<KString, KString> small;
+
+		for (int iRound = 0; iRound < 3; ++iRound)
+		{
+			for (int i = 0; i < 100; ++i)
+			{
+				auto sKey   = kFormat("key{}", i % 37);
+				auto sValue = kFormat("value{}", i);
+
+				props.Add(sKey, sValue);
+				small.Add(sKey, sValue);
+
+				if (i % 11 == 10)
+				{
+					auto sRemove = kFormat("key{}", (i * 7) % 37);
+					CHECK ( props.Remove(sRemove) == small.Remove(sRemove) );
+				}
+
+				REQUIRE ( props.size() == small.size() );
+				CHECK ( std::equal(props.begin(), props.end(), small.begin()) );
+			}
+
+			for (int i = 0; i < 40; ++i)
+			{
+				auto sKey = kFormat("key{}", i);
+				CHECK ( props.Count(sKey) == small.Count(sKey) );
+				CHECK ( props.Get(sKey)   == small.Get(sKey)   );
+
+				auto r1 = props.equal_range(sKey);
+				auto r2 = small.equal_range(sKey);
+				std::vector<KString> v1, v2;
+				for (auto it = r1.first; it != r1.second; ++it) v1.push_back(it->second);
+				for (auto it = r2.first; it != r2.second; ++it) v2.push_back(it->second);
+				CHECK ( v1 == v2 );
+			}
+
+			if (iRound == 1)
+			{
+				props.clear();
+				small.clear();
+			}
+		}
+	}
+}
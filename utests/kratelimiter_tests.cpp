@@ -3,6 +3,10 @@
 #include <dekaf2/rest/limits/kratelimiter.h>
 #include <dekaf2/core/errors/kexception.h>
 #include <dekaf2/time/duration/kduration.h>
+#include <dekaf2/core/format/kformat.h>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 using namespace dekaf2;
 
@@ -138,4 +142,52 @@ TEST_CASE("KRateLimiter")
 		CHECK ( limiter.Check("10.0.0.1", tLater) == true  );
 		CHECK ( limiter.Check("10.0.0.1", tLater) == false );
 	}
+
+	SECTION("shards")
+	{
+		KRateLimiter limiter(10.0, 2, 4, false);
+		CHECK ( limiter.GetShardCount() == 4 );
+		auto tNow = KSteadyTime::now();
+
+		for (int i = 0; i < 100; ++i)
+		{
+			CHECK ( limiter.Check(kFormat("10.0.0.{}", i), tNow) == true );
+		}
+
+		CHECK ( limiter.GetBucketCount() == 100 );
+
+		limiter.Cleanup(tNow + KDuration(chrono::seconds(120)));
+		CHECK ( limiter.GetBucketCount() == 0 );
+	}
+
+	SECTION("concurrent checks never exceed the burst")
+	{
+		// 1 req/s, burst of 50 - within the test runtime only the burst is allowed
+		KRateLimiter limiter(1.0, 50);
+		auto tNow = KSteadyTime::now();
+		std::atomic<int> iAllowed { 0 };
+		std::vector<std::thread> Threads;
+
+		for (int t = 0; t < 8; ++t)
+		{
+			Threads.emplace_back([&]()
+			{
+				for (int i = 0; i < 100; ++i)
+				{
+					if (limiter.Check("10.0.0.1", tNow))
+					{
+						++iAllowed;
+					}
+				}
+			});
+		}
+
+		for (auto& Thread : Threads)
+		{
+			Thread.join();
+		}
+
+		CHECK ( iAllowed == 50 );
+		CHECK ( limiter.GetBucketCount() == 1 );
+	}
 }
@@ -0,0 +1,334 @@
+#include "catch.hpp"
+
+#include <dekaf2/net/address/kresolvercache.h>
+#include <dekaf2/net/address/kresolve.h>
+#include <dekaf2/net/tcp/ktcpserver.h>
+#include <dekaf2/net/tcp/ktcpstream.h>
+#include <dekaf2/system/filesystem/kfilesystem.h>
+#include <dekaf2/time/duration/kduration.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace dekaf2;
+
+namespace {
+
+using Addresses = KResolverCache::Addresses;
+
+//-----------------------------------------------------------------------------
+/// a stub resolver with a fixed zone, counting its lookups
+struct StubDNS
+//-----------------------------------------------------------------------------
+{
+	Addresses operator()(KStringView sHostname, KResolverCache::Family, boost::system::error_code& ec)
+	{
+		++iLookups;
+
+		if (Delay > KDuration::zero())
+		{
+			std::this_thread::sleep_for(Delay);
+		}
+
+		if (sHostname == "bad.test")
+		{
+			ec = boost::asio::error::host_not_found;
+			return {};
+		}
+
+		return IPs;
+	}
+
+	Addresses                IPs      { boost::asio::ip::make_address("192.0.2.1"), boost::asio::ip::make_address("2001:db8::1") };
+	KDuration                Delay;
+	std::atomic<std::size_t> iLookups { 0 };
+};
+
+class KEchoServer : public KTCPServer
+{
+
+public:
+
+	using KTCPServer::KTCPServer;
+
+protected:
+
+	virtual bool Accepted(std::unique_ptr<KIOStreamSocket>& stream) override
+	{
+		stream->SetReaderRightTrim("\r\n");
+		stream->SetWriterEndOfLine("\r\n");
+		return true;
+	}
+
+	virtual KString Request(KStringRef& sLine, Parameters& parameters) override
+	{
+		// one echo per connection
+		parameters.terminate = true;
+		return sLine + "\r\n";
+	}
+
+}; // KEchoServer
+
+} // end of anonymous namespace
+
+TEST_CASE("KResolverCache")
+{
+	StubDNS Stub;
+	KResolverCache Cache;
+	Cache.SetLookup([&Stub](KStringView sHostname, KResolverCache::Family Family, boost::system::error_code& ec)
+	{
+		return Stub(sHostname, Family, ec);
+	});
+
+	boost::system::error_code ec;
+
+	SECTION("hits")
+	{
+		CHECK ( Cache.Get("www.test", KStreamOptions::Family::Any, ec) == Stub.IPs );
+		CHECK ( !ec );
+		CHECK ( Cache.Get("WWW.Test", KStreamOptions::Family::Any, ec) == Stub.IPs );
+		CHECK ( Stub.iLookups == 1 );
+		// another family is another entry
+		Cache.Get("www.test", KStreamOptions::Family::IPv4, ec);
+		CHECK ( Stub.iLookups == 2 );
+
+		auto Stats = Cache.GetStatistics();
+		CHECK ( Stats.iHits    == 1 );
+		CHECK ( Stats.iMisses  == 2 );
+		CHECK ( Stats.iEntries == 2 );
+
+		CHECK ( Cache.Invalidate("www.test") == true  );
+		CHECK ( Cache.Invalidate("www.test") == false );
+		CHECK ( Cache.GetStatistics().iEntries == 0 );
+		Cache.Get("www.test", KStreamOptions::Family::Any, ec);
+		CHECK ( Stub.iLookups == 3 );
+	}
+
+	SECTION("negative caching")
+	{
+		CHECK ( Cache.Get("bad.test", KStreamOptions::Family::Any, ec).empty() );
+		CHECK ( ec == boost::asio::error::host_not_found );
+		ec.clear();
+		CHECK ( Cache.Get("bad.test", KStreamOptions::Family::Any, ec).empty() );
+		CHECK ( ec == boost::asio::error::host_not_found );
+		CHECK ( Stub.iLookups == 1 );
+		CHECK ( Cache.GetStatistics().iNegativeHits == 1 );
+
+		Cache.SetNegativeTimeToLive(KDuration::zero());
+		CHECK ( Cache.Invalidate("bad.test") );
+		Cache.Get("bad.test", KStreamOptions::Family::Any, ec);
+		Cache.Get("bad.test", KStreamOptions::Family::Any, ec);
+		CHECK ( Stub.iLookups == 3 );
+	}
+
+	SECTION("expiry")
+	{
+		Cache.SetTimeToLive(chrono::milliseconds(50));
+		Cache.SetRefreshAhead(KDuration::zero());
+		Cache.Get("www.test", KStreamOptions::Family::Any, ec);
+		Cache.Get("www.test", KStreamOptions::Family::Any, ec);
+		CHECK ( Stub.iLookups == 1 );
+		std::this_thread::sleep_for(chrono::milliseconds(80));
+		Cache.Get("www.test", KStreamOptions::Family::Any, ec);
+		CHECK ( Stub.iLookups == 2 );
+	}
+
+	SECTION("refresh ahead")
+	{
+		Cache.SetTimeToLive(chrono::seconds(2));
+		Cache.SetRefreshAhead(chrono::milliseconds(1950));
+		Cache.Get("www.test", KStreamOptions::Family::Any, ec);
+		std::this_thread::sleep_for(chrono::milliseconds(100));
+
+		// served from the cache, refreshed in the background
+		Stub.Delay = chrono::milliseconds(100);
+		KStopTime Timer;
+		CHECK ( Cache.Get("www.test", KStreamOptions::Family::Any, ec) == Stub.IPs );
+		CHECK ( Timer.elapsed() < chrono::milliseconds(100) );
+
+		for (int i = 0; i < 100 && Cache.GetStatistics().iRefreshes == 0; ++i)
+		{
+			std::this_thread::sleep_for(chrono::milliseconds(10));
+		}
+
+		// a refresh in progress is not started again
+		Cache.Get("www.test", KStreamOptions::Family::Any, ec);
+
+		for (int i = 0; i < 100 && Stub.iLookups < 2; ++i)
+		{
+			std::this_thread::sleep_for(chrono::milliseconds(10));
+		}
+
+		CHECK ( Stub.iLookups == 2 );
+		CHECK ( Cache.GetStatistics().iRefreshes == 1 );
+		CHECK ( Cache.GetStatistics().iHits      == 2 );
+	}
+
+	SECTION("coalescing")
+	{
+		Stub.Delay = chrono::milliseconds(200);
+
+		std::vector<std::thread> Threads;
+		std::atomic<std::size_t> iFound { 0 };
+
+		for (int i = 0; i < 8; ++i)
+		{
+			Threads.emplace_back([&Cache, &Stub, &iFound]()
+			{
+				boost::system::error_code ec;
+
+				if (Cache.Get("www.test", KStreamOptions::Family::Any, ec) == Stub.IPs)
+				{
+					++iFound;
+				}
+			});
+		}
+
+		for (auto& Thread : Threads)
+		{
+			Thread.join();
+		}
+
+		auto Stats = Cache.GetStatistics();
+		CHECK ( iFound         == 8 );
+		CHECK ( Stub.iLookups  == 1 );
+		CHECK ( Stats.iMisses  == 1 );
+		CHECK ( Stats.iMisses + Stats.iCoalesced + Stats.iHits == 8 );
+	}
+
+	SECTION("max entries")
+	{
+		Cache.SetMaxEntries(2);
+		Cache.Get("a.test", KStreamOptions::Family::Any, ec);
+		Cache.Get("b.test", KStreamOptions::Family::Any, ec);
+		Cache.Get("c.test", KStreamOptions::Family::Any, ec);
+
+		auto Stats = Cache.GetStatistics();
+		CHECK ( Stats.iEntries   == 2 );
+		CHECK ( Stats.iEvictions == 1 );
+		CHECK ( Stats.GetHitRate() == 0.0 );
+
+		Cache.clear();
+		CHECK ( Cache.GetStatistics().iEntries == 0 );
+	}
+}
+
+TEST_CASE("KResolve")
+{
+	auto& Cache = KResolverCache::getInstance();
+
+	SECTION("hosts file")
+	{
+		KTempDir Tmp;
+		auto sFile = kFormat("{}{}hosts", Tmp.Name(), kDirSep);
+
+		REQUIRE ( kWriteFile(sFile,
+			"# a local hosts file\n"
+			"127.0.0.1\tfirst.hosts.test first\n"
+			"::1         first.hosts.test # IPv6\n"
+			"192.0.2.7   first.hosts.test\n"
+			"not-an-ip   second.hosts.test\n"
+			"\n"
+			"2001:db8::7 second.hosts.test\n") );
+
+		CHECK ( KResolve::LoadKnownHosts(sFile) == 4 );
+		CHECK ( KResolve::LoadKnownHosts(kFormat("{}{}missing", Tmp.Name(), kDirSep)) == 0 );
+
+		CHECK ( KResolve::GetKnownHostAddress("first.hosts.test" , KStreamOptions::Family::IPv4) == "127.0.0.1"   );
+		CHECK ( KResolve::GetKnownHostAddress("first.hosts.test" , KStreamOptions::Family::IPv6) == "::1"         );
+		CHECK ( KResolve::GetKnownHostAddress("first"            , KStreamOptions::Family::Any ) == "127.0.0.1"   );
+		CHECK ( KResolve::GetKnownHostAddress("second.hosts.test", KStreamOptions::Family::Any ) == "2001:db8::7" );
+		CHECK ( KResolve::GetKnownHostAddress("second.hosts.test", KStreamOptions::Family::IPv4) == "second.hosts.test" );
+
+		// without a family the address added last wins
+		CHECK ( kResolveHost("first.hosts.test") == "::1" );
+
+		// AddKnownHostAddress() replaces
+		KResolve::AddKnownHostAddress("first", "[::1]");
+		CHECK ( KResolve::GetKnownHostAddress("first", KStreamOptions::Family::Any ) == "::1"       );
+		CHECK ( KResolve::GetKnownHostAddress("first", KStreamOptions::Family::IPv4) == "127.0.0.1" );
+	}
+
+	SECTION("cached lookups")
+	{
+		StubDNS Stub;
+
+		Cache.SetLookup([&Stub](KStringView sHostname, KResolverCache::Family Family, boost::system::error_code& ec)
+		{
+			return Stub(sHostname, Family, ec);
+		});
+
+		auto IPs = kResolveHostToList("www.test");
+		REQUIRE ( IPs.size() == 2 );
+		CHECK ( IPs[0] == "192.0.2.1"   );
+		CHECK ( IPs[1] == "2001:db8::1" );
+		CHECK ( kResolveHostIPV6("www.test") == "2001:db8::1" );
+		CHECK ( Stub.iLookups == 1 );
+		CHECK ( kResolveHost("bad.test").empty() );
+		CHECK ( kResolveHost("bad.test").empty() );
+		CHECK ( Stub.iLookups == 2 );
+		// numeric addresses bypass the cache
+		CHECK ( kResolveHost("127.0.0.1") == "127.0.0.1" );
+		CHECK ( Stub.iLookups == 2 );
+
+		Cache.SetLookup(nullptr);
+	}
+
+	SECTION("happy eyeballs")
+	{
+		KEchoServer Server(7684, false);
+		Server.SetBindAddress("127.0.0.1");
+		REQUIRE ( Server.Start(chrono::seconds(5), false) == true );
+
+		StubDNS Stub;
+
+		Cache.SetLookup([&Stub](KStringView sHostname, KResolverCache::Family Family, boost::system::error_code& ec)
+		{
+			return Stub(sHostname, Family, ec);
+		});
+
+		// the server does not listen on IPv6, the connect falls back to IPv4
+		Stub.IPs = { boost::asio::ip::make_address("::1"), boost::asio::ip::make_address("127.0.0.1") };
+
+		{
+			KTCPStream Stream(KTCPEndPoint("eyeballs.test:7684"), KStreamOptions(chrono::seconds(5)));
+			REQUIRE ( Stream.Good() );
+			CHECK ( Stream.GetEndPointAddress().Serialize() == "127.0.0.1:7684" );
+			Stream.SetReaderRightTrim("\r\n");
+			Stream.SetWriterEndOfLine("\r\n");
+			Stream.WriteLine("hello").Flush();
+			KString sLine;
+			CHECK ( Stream.ReadLine(sLine) );
+			CHECK ( sLine == "hello" );
+		}
+
+		// an unroutable address that may hang does not delay the connect
+		// by more than the attempt delay
+		Cache.clear();
+		Stub.IPs = { boost::asio::ip::make_address("10.255.255.1"), boost::asio::ip::make_address("127.0.0.1") };
+
+		{
+			KStopTime Timer;
+			KTCPStream Stream(KTCPEndPoint("eyeballs.test:7684"), KStreamOptions(chrono::seconds(10)));
+			CHECK ( Stream.Good() );
+			CHECK ( Timer.elapsed() < chrono::seconds(3) );
+		}
+
+		// all addresses fail
+		Cache.clear();
+		Stub.IPs = { boost::asio::ip::make_address("::1"), boost::asio::ip::make_address("127.0.0.1") };
+
+		{
+			KTCPStream Stream(KTCPEndPoint("eyeballs.test:7685"), KStreamOptions(chrono::seconds(5)));
+			CHECK ( Stream.Good() == false );
+		}
+
+		// unknown names fail
+		{
+			KTCPStream Stream(KTCPEndPoint("bad.test:7684"), KStreamOptions(chrono::seconds(5)));
+			CHECK ( Stream.Good() == false );
+		}
+
+		Cache.SetLookup(nullptr);
+	}
+}
@@ -3,6 +3,8 @@
 #include <dekaf2/rest/framework/krest.h>
 #include <dekaf2/http/server/khttperror.h>
 #include <dekaf2/rest/framework/krestclient.h>
+#include <dekaf2/http/client/kwebclient.h>
+#include <dekaf2/system/filesystem/kfilesystem.h>
 
 using namespace dekaf2;
 
@@ -506,6 +508,91 @@ TEST_CASE("KREST")
 		}
 	}
 
+	SECTION("HTTP event-driven keepalive")
+	{
+		KRESTRoutes Routes;
+
+		uint16_t iCalledTest { 0 };
+
+		Routes.AddRoute({ KHTTPMethod::GET, false, "/test", [&](KRESTServer& http)
+		{
+			++iCalledTest;
+			http.json.tx["response"] = "hello world";
+		}});
+
+		Routes.AddRoute({ KHTTPMethod::GET, false, "/round", [&](KRESTServer& http)
+		{
+			http.json.tx["round"] = http.GetKeepaliveRound();
+		}});
+
+		KREST::Options Options;
+		Options.Type            = KREST::HTTP;
+		Options.iPort           = 30308;
+		Options.bBlocking       = false;
+		Options.bEventDriven    = true;
+		// one worker thread has to serve both clients, which is only
+		// possible if idle connections do not hold it
+		Options.iMaxConnections = 1;
+		// the rounds have to be counted over the requests of a connection
+		Options.iMaxKeepaliveRounds = 3;
+		Options.bCreateEphemeralCert = false;
+
+		KREST REST;
+
+		if (!REST.Execute(Options, Routes))
+		{
+			CHECK ( REST.Error() == "" );
+		}
+		else
+		{
+			KHTTPError ec;
+			KJsonRestClient Client1("http://localhost:30308");
+			Client1.RequestCompression(false);
+			Client1.AllowConnectionRetry(false);
+			KJsonRestClient Client2("http://localhost:30308");
+			Client2.RequestCompression(false);
+			Client2.AllowConnectionRetry(false);
+
+			auto jResult = Client1.Get("test").SetError(ec).Request();
+
+			CHECK (ec.value()   == 0  );
+			CHECK (ec.message() == "" );
+			CHECK (iCalledTest  == 1  );
+			CHECK (jResult["response"] == "hello world");
+
+			jResult = Client2.Get("test").SetError(ec).Request();
+
+			CHECK (ec.value()   == 0  );
+			CHECK (ec.message() == "" );
+			CHECK (iCalledTest  == 2  );
+
+			jResult = Client1.Get("test").SetError(ec).Request();
+
+			CHECK (ec.value()   == 0  );
+			CHECK (ec.message() == "" );
+			CHECK (iCalledTest  == 3  );
+
+			jResult = Client2.Get("test").SetError(ec).Request();
+
+			CHECK (ec.value()   == 0  );
+			CHECK (ec.message() == "" );
+			CHECK (iCalledTest  == 4  );
+
+			KJsonRestClient Client3("http://localhost:30308");
+			Client3.RequestCompression(false);
+			Client3.AllowConnectionRetry(false);
+
+			// the server closes the connection after the third request
+			for (uint16_t iRound : { 0, 1, 2, 0 })
+			{
+				jResult = Client3.Get("round").SetError(ec).Request();
+
+				CHECK (ec.value()       == 0      );
+				CHECK (jResult["round"] == iRound );
+			}
+		}
+	}
+
 	SECTION("HTTP bind address")
 	{
 		KRESTRoutes Routes;
@@ -557,4 +644,136 @@ TEST_CASE("KREST")
 		CHECK ( BadREST.Execute(BadOptions, Routes) == false );
 	}
 
+	SECTION("HTTP file delivery")
+	{
+		// larger than the streaming buffer, to test the loop
+		KString sContent;
+		for (std::size_t i = 0; sContent.size() < 600 * 1024; ++i)
+		{
+			sContent += kFormat("line {} of the file delivery test\n", i);
+		}
+
+		KTempDir WebRoot;
+		{
+			KOutFile OutFile(kFormat("{}/data.txt", WebRoot.Name()));
+			CHECK ( OutFile.is_open() );
+			OutFile.Write(sContent);
+		}
+
+		KRESTRoutes Routes;
+		Routes.AddRoute({ KHTTPMethod::GET, false, "/web/*", WebRoot.Name(), Routes, &KRESTRoutes::WebServer });
+		Routes.AddRoute({ KHTTPMethod::GET, false, "/vanished", [&](KRESTServer& http)
+		{
+			auto sFile = kFormat("{}/vanished.txt", WebRoot.Name());
+			kWriteFile(sFile, sContent);
+			http.SetFileToOutput(sFile);
+			// the file is gone before the response is written
+			kRemoveFile(sFile);
+		}});
+
+		KREST::Options Options;
+		Options.Type         = KREST::HTTP;
+		Options.iPort        = 30309;
+		Options.bBlocking    = false;
+		Options.bCreateEphemeralCert = false;
+
+		KREST REST;
+
+		if (!REST.Execute(Options, Routes))
+		{
+			CHECK ( REST.Error() == "" );
+		}
+		else
+		{
+			{
+				// uncompressed, sent zero copy where supported
+				KWebClient Client;
+				Client.RequestCompression(false);
+				Client.AllowConnectionRetry(false);
+
+				auto sBody = Client.Get("http://127.0.0.1:30309/web/data.txt");
+				CHECK ( Client.GetStatusCode() == 200 );
+				CHECK ( sBody.size() == sContent.size() );
+				CHECK ( sBody == sContent );
+
+				// a range from the middle of the file, on the same connection
+				Client.AddHeader(KHTTPHeader::RANGE, "bytes=300000-500001");
+				sBody = Client.Get("http://127.0.0.1:30309/web/data.txt");
+				CHECK ( Client.GetStatusCode() == 206 );
+				CHECK ( sBody == sContent.ToView(300000, 200002) );
+
+				// an unreadable file is an error, not an empty or truncated 200
+				sBody = Client.Get("http://127.0.0.1:30309/vanished");
+				CHECK ( Client.GetStatusCode() == 500 );
+				CHECK ( sBody != sContent );
+			}
+			{
+				// compressed, streamed through the filters
+				KWebClient Client;
+				Client.RequestCompression(true);
+				Client.AllowConnectionRetry(false);
+
+				auto sBody = Client.Get("http://127.0.0.1:30309/web/data.txt");
+				CHECK ( Client.GetStatusCode() == 200 );
+				CHECK ( sBody.size() == sContent.size() );
+				CHECK ( sBody == sContent );
+			}
+		}
+	}
+
+	SECTION("HTTP streamed output")
+	{
+		KString sContent;
+		for (std::size_t i = 0; i < 20000; ++i)
+		{
+			sContent += kFormat("row {} of the streamed output\n", i);
+		}
+
+		KRESTRoutes Routes;
+		Routes.AddRoute({ KHTTPMethod::GET, false, "/stream", [&](KRESTServer& HTTP)
+		{
+			HTTP.StreamOutput(KMIME::TEXT_UTF8, [&](KOutStream& Out)
+			{
+				for (std::size_t i = 0; i < 20000; ++i)
+				{
+					Out.Write(kFormat("row {} of the streamed output\n", i));
+				}
+			});
+		}});
+
+		KREST::Options Options;
+		Options.Type         = KREST::HTTP;
+		Options.iPort        = 30310;
+		Options.bBlocking    = false;
+		Options.bCreateEphemeralCert = false;
+
+		KREST REST;
+
+		if (!REST.Execute(Options, Routes))
+		{
+			CHECK ( REST.Error() == "" );
+		}
+		else
+		{
+			for (auto bCompression : { false, true })
+			{
+				INFO ( bCompression );
+
+				KWebClient Client;
+				Client.RequestCompression(bCompression);
+				Client.AllowConnectionRetry(false);
+
+				// twice on the same connection, which needs a properly terminated body
+				for (int i = 0; i < 2; ++i)
+				{
+					auto sBody = Client.Get("http://127.0.0.1:30310/stream");
+					CHECK ( Client.GetStatusCode() == 200 );
+					CHECK ( Client.Response.Headers.Get(KHTTPHeader::TRANSFER_ENCODING) == "chunked" );
+					CHECK ( sBody.size() == sContent.size() );
+					CHECK ( sBody == sContent );
+				}
+			}
+		}
+	}
+
 }
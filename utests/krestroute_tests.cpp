@@ -0,0 +1,176 @@
+#include "catch.hpp"
+
+#include <dekaf2/rest/framework/krestroute.h>
+#include <dekaf2/http/server/khttprouter.h>
+#include <dekaf2/http/server/khttperror.h>
+#include <vector>
+
+using namespace dekaf2;
+
+namespace {
+
+std::vector<std::pair<KHTTPMethod, KStringView>> RouteDefs
+{
+	{ KHTTPMethod::GET   , "/"                        },
+	{ KHTTPMethod::GET   , "/help"                    },
+	{ KHTTPMethod::POST  , "/help"                    },
+	{ KHTTPMethod::GET   , "/user/:id"                },
+	{ KHTTPMethod::GET   , "/user/me"                 },
+	{ KHTTPMethod::GET   , "/user/:id/address/=type"  },
+	{ KHTTPMethod::PUT   , "/user/:id/*"              },
+	{ KHTTPMethod::GET   , "/docs/*"                  },
+	{ KHTTPMethod{}      , "/docs/api/*"              },
+	{ KHTTPMethod::GET   , "/files/*/raw"             },
+	{ KHTTPMethod::DELETE, "/files/:name"             },
+	{ KHTTPMethod{}      , "/any"                     },
+	{ KHTTPMethod::GET   , "/*"                       },
+};
+
+std::vector<std::pair<KHTTPMethod, KStringView>> PathDefs
+{
+	{ KHTTPMethod::GET   , "/"                        },
+	{ KHTTPMethod::GET   , ""                         },
+	{ KHTTPMethod::GET   , "/help"                    },
+	{ KHTTPMethod::POST  , "/help"                    },
+	{ KHTTPMethod::HEAD  , "/help"                    },
+	{ KHTTPMethod::DELETE, "/help"                    },
+	{ KHTTPMethod::GET   , "/helpme"                  },
+	{ KHTTPMethod::GET   , "/user/me"                 },
+	{ KHTTPMethod::GET   , "/user/42"                 },
+	{ KHTTPMethod::GET   , "/user"                    },
+	{ KHTTPMethod::GET   , "/user/42/address"         },
+	{ KHTTPMethod::GET   , "/user/42/address/home"    },
+	{ KHTTPMethod::GET   , "/user/42/address/home/x"  },
+	{ KHTTPMethod::PUT   , "/user/42/avatar"          },
+	{ KHTTPMethod::PUT   , "/user/42/avatar/large"    },
+	{ KHTTPMethod::GET   , "/docs"                    },
+	{ KHTTPMethod::GET   , "/docs/"                   },
+	{ KHTTPMethod::GET   , "/docs/intro.html"         },
+	{ KHTTPMethod::POST  , "/docs/api/v1/index.html"  },
+	{ KHTTPMethod::GET   , "/docsearch"               },
+	{ KHTTPMethod::GET   , "/files/abc/raw"           },
+	{ KHTTPMethod::GET   , "/files/abc/cooked"        },
+	{ KHTTPMethod::DELETE, "/files/abc"               },
+	{ KHTTPMethod::PROPFIND, "/any"                   },
+	{ KHTTPMethod::PATCH , "/any"                     },
+	{ KHTTPMethod::GET   , "/unknown/deep/path"       },
+};
+
+} // end of anonymous namespace
+
+TEST_CASE("KRESTRoutes")
+{
+	SECTION("route index keeps first match order")
+	{
+		KRESTRoutes Routes;
+		std::vector<KRESTRoute> Linear;
+
+		for (const auto& Def : RouteDefs)
+		{
+			Routes.AddRoute(KRESTRoute(Def.first, false, Def.second, KString{}, [](KRESTServer&){}));
+			Linear.push_back(KRESTRoute(Def.first, false, Def.second, KString{}, [](KRESTServer&){}));
+		}
+
+		for (const auto& Def : PathDefs)
+		{
+			KRESTPath Path(Def.first, Def.second);
+			INFO ( Def.first.Serialize() << " " << Def.second );
+
+			// the former linear scan
+			std::size_t iExpected { KRESTRoutes::npos };
+			KRESTRoutes::Parameters ExpectedParams;
+
+			for (std::size_t i = 0; i < Linear.size(); ++i)
+			{
+				if (Linear[i].Matches(Path, &ExpectedParams, true, true, false))
+				{
+					iExpected = i;
+					break;
+				}
+			}
+
+			std::size_t iFound { KRESTRoutes::npos };
+			KRESTRoutes::Parameters Params;
+
+			try
+			{
+				iFound = Routes.GetRouteIndex(Routes.FindRoute(Path, Params, false, false));
+			}
+			catch (const KHTTPError&)
+			{
+			}
+
+			CHECK ( iFound == iExpected );
+
+			if (iExpected != KRESTRoutes::npos && Linear[iExpected].m_bHasParameters)
+			{
+				CHECK ( Params == ExpectedParams );
+			}
+		}
+	}
+
+	SECTION("parameters")
+	{
+		KRESTRoutes Routes;
+
+		for (const auto& Def : RouteDefs)
+		{
+			Routes.AddRoute(KRESTRoute(Def.first, false, Def.second, KString{}, [](KRESTServer&){}));
+		}
+
+		// the parameters point into the path
+		KRESTPath Path(KHTTPMethod::GET, "/user/42/address/home");
+		KRESTRoutes::Parameters Params;
+		auto& Route = Routes.FindRoute(Path, Params, false, false);
+
+		CHECK ( Route.sRoute == "/user/:id/address/=type" );
+		REQUIRE ( Params.size() == 2 );
+		CHECK ( Params[0].second == "42"   );
+		CHECK ( Params[1].first  == "type" );
+		CHECK ( Params[1].second == "home" );
+	}
+
+	SECTION("wrong method")
+	{
+		KRESTRoutes Routes;
+		Routes.AddRoute(KRESTRoute(KHTTPMethod::GET, false, "/only/get", KString{}, [](KRESTServer&){}));
+
+		KRESTRoutes::Parameters Params;
+
+		CHECK ( Routes.CheckForWrongMethod(KRESTPath(KHTTPMethod::POST, "/only/get")) == true  );
+		CHECK ( Routes.CheckForWrongMethod(KRESTPath(KHTTPMethod::POST, "/only/put")) == false );
+		CHECK_THROWS_AS ( Routes.FindRoute(KRESTPath(KHTTPMethod::POST, "/only/get"), Params, false, true), const KHTTPError& );
+	}
+
+	SECTION("clear")
+	{
+		KRESTRoutes Routes;
+		Routes.AddRoute(KRESTRoute(KHTTPMethod::GET, false, "/a", KString{}, [](KRESTServer&){}));
+		Routes.clear();
+		Routes.AddRoute(KRESTRoute(KHTTPMethod::GET, false, "/b", KString{}, [](KRESTServer&){}));
+
+		KRESTRoutes::Parameters Params;
+		CHECK_THROWS_AS ( Routes.FindRoute(KRESTPath(KHTTPMethod::GET, "/a"), Params, false, false), const KHTTPError& );
+		CHECK ( Routes.FindRoute(KRESTPath(KHTTPMethod::GET, "/b"), Params, false, false).sRoute == "/b" );
+	}
+}
+
+TEST_CASE("KHTTPRoutes")
+{
+	KHTTPRoutes Routes;
+
+	Routes.AddRoute(KHTTPRoute("/static/*"     , "", [](KHTTPRouter&){}));
+	Routes.AddRoute(KHTTPRoute("/static/index" , "", [](KHTTPRouter&){}));
+	Routes.AddRoute(KHTTPRoute("/img/*/small"  , "", [](KHTTPRouter&){}));
+	Routes.AddRoute(KHTTPRoute("/:literal"     , "", [](KHTTPRouter&){}));
+
+	// the wildcard route was added first and wins
+	CHECK ( Routes.FindRoute(KHTTPPath("/static/index")).sRoute == "/static" );
+	CHECK ( Routes.FindRoute(KHTTPPath("/static"      )).sRoute == "/static" );
+	CHECK ( Routes.FindRoute(KHTTPPath("/img/cat/small")).sRoute == "/img/*/small" );
+	// plain HTTP routes know no parameters
+	CHECK ( Routes.FindRoute(KHTTPPath("/:literal"    )).sRoute == "/:literal" );
+	CHECK_THROWS_AS ( Routes.FindRoute(KHTTPPath("/img/cat/big")), const KHTTPError& );
+	CHECK_THROWS_AS ( Routes.FindRoute(KHTTPPath("/staticfile" )), const KHTTPError& );
+	CHECK_THROWS_AS ( Routes.FindRoute(KHTTPPath("/anything"   )), const KHTTPError& );
+}
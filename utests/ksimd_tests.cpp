@@ -0,0 +1,169 @@
+#include "catch.hpp"
+
+#include <dekaf2/core/strings/bits/simd/ksimd.h>
+#include <dekaf2/core/strings/bits/simd/kescapescan.h>
+#include <dekaf2/core/strings/kstring.h>
+#include <dekaf2/core/strings/kstringview.h>
+#include <dekaf2/core/strings/kcaseless.h>
+#include <dekaf2/core/strings/kutf.h>
+#include <random>
+#include <vector>
+
+using namespace dekaf2;
+
+namespace {
+
+using KSimd = detail::KSimd;
+
+//-----------------------------------------------------------------------------
+/// returns all levels this CPU supports, from Scalar up
+std::vector<KSimd::Level> SupportedLevels()
+//-----------------------------------------------------------------------------
+{
+	std::vector<KSimd::Level> Levels;
+
+	if (KSimd::GetCPULevel() == KSimd::NEON)
+	{
+		Levels.push_back(KSimd::Scalar);
+		Levels.push_back(KSimd::NEON);
+	}
+	else
+	{
+		for (uint8_t i = KSimd::Scalar; i <= KSimd::GetCPULevel(); ++i)
+		{
+			Levels.push_back(static_cast<KSimd::Level>(i));
+		}
+	}
+
+	return Levels;
+}
+
+//-----------------------------------------------------------------------------
+std::size_t ScalarFind(KStringView sHaystack, KStringView sSet, bool bNot, bool bLast)
+//-----------------------------------------------------------------------------
+{
+	for (std::size_t i = 0; i < sHaystack.size(); ++i)
+	{
+		auto iPos = bLast ? sHaystack.size() - 1 - i : i;
+
+		if ((sSet.find(sHaystack[iPos]) != KStringView::npos) != bNot)
+		{
+			return iPos;
+		}
+	}
+
+	return KStringView::npos;
+}
+
+//-----------------------------------------------------------------------------
+int Sign(int i)
+//-----------------------------------------------------------------------------
+{
+	return (i > 0) - (i < 0);
+}
+
+} // end of anonymous namespace
+
+TEST_CASE("KSimd")
+{
+	const auto StartLevel = KSimd::GetLevel();
+
+	SECTION("levels")
+	{
+		CHECK ( KSimd::GetLevel() <= KSimd::GetCPULevel() );
+		CHECK ( KSimd::SetLevel(KSimd::Scalar) == KSimd::Scalar );
+		CHECK ( KSimd::GetLevel() == KSimd::Scalar );
+		CHECK ( KSimd::SetLevel(KSimd::AVX512BW) <= KSimd::GetCPULevel() );
+		CHECK ( KSimd::SetLevel("scalar") == KSimd::Scalar );
+		CHECK ( KSimd::SetLevel("no such level") == KSimd::Scalar );
+		CHECK ( KSimd::SetLevel(KSimd::ToString(KSimd::GetCPULevel())) == KSimd::GetCPULevel() );
+		CHECK ( KSimd::ToString(KSimd::Scalar  ) == "scalar" );
+		CHECK ( KSimd::ToString(KSimd::SSE42   ) == "sse4.2" );
+		CHECK ( KSimd::ToString(KSimd::AVX512BW) == "avx512" );
+
+		if (KSimd::GetCPULevel() != KSimd::NEON)
+		{
+			CHECK ( KSimd::GetCPULevel() >= KSimd::SSE2 );
+			CHECK ( KSimd::SetLevel(KSimd::SSE2) == KSimd::SSE2 );
+		}
+	}
+
+	SECTION("kernels against scalar results")
+	{
+		std::mt19937 Random(42);
+
+		// a small alphabet produces many hits, the high bytes and NUL test the
+		// second half of the nibble tables and the signedness of char
+		static constexpr KStringView Alphabet("abcXYZ \t,;\0\x7f\x80\xc3\xa9\xff", 16);
+
+		std::vector<KString> Haystacks;
+		std::vector<KString> Sets { "", ",", " \t", "abc;", KString(Alphabet.substr(10)), KString(Alphabet) };
+
+		for (std::size_t iLen : { 0, 1, 7, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 257 })
+		{
+			for (int iRepeat = 0; iRepeat < 4; ++iRepeat)
+			{
+				KString sHaystack;
+
+				// runs of the same char make the not-in searches go further
+				auto chRun = Alphabet[Random() % Alphabet.size()];
+
+				for (std::size_t i = 0; i < iLen; ++i)
+				{
+					sHaystack += (Random() % 8) ? chRun : Alphabet[Random() % Alphabet.size()];
+				}
+
+				Haystacks.push_back(std::move(sHaystack));
+			}
+		}
+
+		for (auto Level : SupportedLevels())
+		{
+			INFO ( KSimd::ToString(KSimd::SetLevel(Level)) );
+
+			for (const auto& sHaystack : Haystacks)
+			{
+				INFO ( sHaystack.size() );
+
+				for (char ch : { 'a', ' ', '\0', '\xff' })
+				{
+					CHECK ( kFindNot (sHaystack, ch) == ScalarFind(sHaystack, KStringView(&ch, 1), true, false) );
+					CHECK ( kRFindNot(sHaystack, ch) == ScalarFind(sHaystack, KStringView(&ch, 1), true, true ) );
+				}
+
+				for (const auto& sSet : Sets)
+				{
+					KFindSetOfChars     Set(KStringView(sSet.data(), sSet.size()));
+					detail::KEscapeScan Scan(sSet);
+
+					INFO ( sSet.size() );
+					CHECK ( Set.find_first_in    (sHaystack) == ScalarFind(sHaystack, sSet, false, false) );
+					CHECK ( Set.find_first_not_in(sHaystack) == ScalarFind(sHaystack, sSet, true , false) );
+					CHECK ( Set.find_last_in     (sHaystack) == ScalarFind(sHaystack, sSet, false, true ) );
+					CHECK ( Set.find_last_not_in (sHaystack) == ScalarFind(sHaystack, sSet, true , true ) );
+					CHECK ( Scan.find_first_in   (sHaystack) == ScalarFind(sHaystack, sSet, false, false) );
+				}
+
+				auto sUpper = sHaystack.ToUpperASCII();
+				auto sLower = sHaystack.ToLowerASCII();
+				auto sOther = sLower;
+
+				if (!sOther.empty())
+				{
+					sOther[Random() % sOther.size()] = '!';
+				}
+
+				CHECK ( kCaselessEqual    (sHaystack, sUpper) );
+				CHECK ( kCaselessEqualLeft(sUpper   , sLower) );
+				CHECK ( kCaselessCompare  (sUpper   , sLower) == 0 );
+				CHECK ( Sign(kCaselessCompare    (sHaystack, sOther)) == Sign(sLower.compare(sOther)) );
+				CHECK ( Sign(kCaselessCompareLeft(sHaystack, sOther)) == Sign(sLower.compare(sOther)) );
+				CHECK ( kCaselessEqual(sHaystack, sOther) == (sLower == sOther) );
+				CHECK ( kutf::Valid(sHaystack) == (kutf::Invalid(sHaystack) == std::size_t(-1)) );
+			}
+		}
+	}
+
+	KSimd::SetLevel(StartLevel);
+	CHECK ( KSimd::GetLevel() == StartLevel );
+}
@@ -43,6 +43,7 @@
 #include "catch.hpp"
 #include <dekaf2/data/sql/ksql.h>
 #include <dekaf2/data/json/kjson.h>
+#include <dekaf2/io/streams/koutstringstream.h>
 #include <dekaf2/core/strings/kstring.h>
 #include <dekaf2/threading/execution/kparallel.h>
 
@@ -836,6 +837,122 @@ TEST_CASE("KSQL-SQLite3")
 		REQUIRE ( db.NextRow() );
 		CHECK   ( db.Get(1).Int32() == 1 );
 	}
+
+	SECTION("Buffered results")
+	{
+		KTempDir TempDir;
+
+		KSQL db;
+		db.SetDBType(KSQL::DBT::SQLITE3);
+		db.SetDBName(sDBFile);
+		db.SetTempDir(TempDir.Name());
+		REQUIRE ( db.OpenConnection() );
+
+		db.SetFlags(KSQL::F_IgnoreSQLErrors);
+		db.ExecSQL("drop table if exists TEST_BUFFER");
+		db.SetFlags(KSQL::F_None);
+
+		REQUIRE ( db.ExecSQL("create table TEST_BUFFER (id integer primary key, name text null, big text null)") );
+
+		constexpr int iRows = 2000;
+		KString sBig(300, 'x');
+
+		REQUIRE ( db.BeginTransaction() );
+		for (int i = 1; i <= iRows; ++i)
+		{
+			// newlines have to survive the buffering
+			REQUIRE ( db.ExecSQL("insert into TEST_BUFFER (id,name,big) values ({},'line-{}' || char(10) || 'next','{}')",
+			                     i, i, (i % 7) ? sBig : KString{}) );
+		}
+		REQUIRE ( db.CommitTransaction() );
+
+		auto ReadAll = [&](KSQL& db) -> int
+		{
+			int iRow = 0;
+			while (db.NextRow())
+			{
+				++iRow;
+				if (db.Get(1).Int32() != iRow
+					|| db.Get(2, false) != kFormat("line-{}\nnext", iRow)
+					|| db.Get(3, false) != ((iRow % 7) ? sBig : KString{}))
+				{
+					break;
+				}
+			}
+			return iRow;
+		};
+
+		for (auto iLimit : { std::size_t(KSQLResultBuffer::DefaultMaxMemory), std::size_t(1) })
+		{
+			INFO ( iLimit );
+			db.SetBufferedResultsMemoryLimit(iLimit);
+			db.SetFlags(KSQL::F_BufferResults);
+
+			REQUIRE ( db.ExecQuery("select id, name, big from TEST_BUFFER order by id") );
+			CHECK   ( db.GetNumBuffered() == iRows );
+			CHECK   ( ReadAll(db) == iRows );
+			CHECK   ( db.GetLastError() == "" );
+
+			// spilled only with the small limit
+			CHECK   ( kFileExists(db.GetTempResultsFile()) == (iLimit == 1) );
+
+			REQUIRE ( db.ResetBuffer() );
+			CHECK   ( ReadAll(db) == iRows );
+
+			db.EndQuery();
+			CHECK   ( !kFileExists(db.GetTempResultsFile()) );
+			db.SetFlags(KSQL::F_None);
+		}
+	}
+
+	SECTION("Streaming output")
+	{
+		KSQL db;
+		db.SetDBType(KSQL::DBT::SQLITE3);
+		db.SetDBName(sDBFile);
+		REQUIRE ( db.OpenConnection() );
+
+		db.SetFlags(KSQL::F_IgnoreSQLErrors);
+		db.ExecSQL("drop table if exists TEST_STREAM");
+		db.SetFlags(KSQL::F_None);
+
+		REQUIRE ( db.ExecSQL("create table TEST_STREAM (id integer primary key, name text null)") );
+
+		REQUIRE ( db.BeginTransaction() );
+		for (int i = 1; i <= 100; ++i)
+		{
+			REQUIRE ( db.ExecSQL("insert into TEST_STREAM (id,name) values ({},'name \"{}\", {}')", i, i, i) );
+		}
+		REQUIRE ( db.CommitTransaction() );
+
+		for (auto Format : { KSQL::OutputFormat::ASCII, KSQL::OutputFormat::JSON, KSQL::OutputFormat::NDJSON,
+		                     KSQL::OutputFormat::CSV, KSQL::OutputFormat::HTML })
+		{
+			INFO ( Format );
+
+			std::size_t iRows { 0 };
+			auto sExpected = db.QueryAllRows("select id, name from TEST_STREAM order by id", Format, &iRows);
+			CHECK ( iRows == 100 );
+
+			KString sStreamed;
+			KOutStringStream Out(sStreamed);
+			CHECK ( db.OutputQuery("select id, name from TEST_STREAM order by id", Out, Format) == 100 );
+			CHECK ( sStreamed == sExpected );
+		}
+
+		KString sJSON;
+		KOutStringStream Out(sJSON);
+		CHECK ( db.OutputQuery("select id, name from TEST_STREAM order by id", Out, KSQL::OutputFormat::JSON) == 100 );
+
+		auto json = kjson::Parse(sJSON);
+		REQUIRE ( json.is_array() );
+		CHECK   ( json.size() == 100 );
+		CHECK   ( json[99]["name"] == "name \"100\", 100" );
+
+		sJSON.clear();
+		CHECK ( db.OutputQuery("select id, name from TEST_STREAM where id > 1000", Out, KSQL::OutputFormat::JSON) == 0 );
+		CHECK ( sJSON == "[]" );
+	}
 }
 
 #endif
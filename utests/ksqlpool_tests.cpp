@@ -0,0 +1,332 @@
+#include "catch.hpp"
+
+#include <dekaf2/data/sql/ksqlpool.h>
+
+#ifdef DEKAF2_HAS_SQLITE3
+
+#include <dekaf2/system/filesystem/kfilesystem.h>
+#include <dekaf2/threading/execution/kthreads.h>
+#include <dekaf2/system/os/ksystem.h>
+#include <dekaf2/core/format/kformat.h>
+#include <thread>
+#include <vector>
+#include <atomic>
+
+using namespace dekaf2;
+
+namespace {
+KTempDir g_KSQLPoolTempDir;
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE("KSQLPool")
+//-----------------------------------------------------------------------------
+{
+	KSQL Prototype;
+	Prototype.SetDBType(KSQL::DBT::SQLITE3);
+	Prototype.SetDBName(kFormat("{}/ksqlpool_test.db", g_KSQLPoolTempDir.Name()));
+
+	{
+		KSQL db;
+		db.SetConnect(Prototype);
+		REQUIRE ( db.OpenConnection() );
+		REQUIRE ( db.ExecSQL("create table if not exists POOL_TEST (anum integer primary key, astring varchar(100))") );
+		REQUIRE ( db.ExecSQL("delete from POOL_TEST") );
+		REQUIRE ( db.ExecSQL("insert into POOL_TEST (anum, astring) values (1, 'one')") );
+	}
+
+	SECTION("borrow and return")
+	{
+		KSQLPool::Options Options;
+		Options.iMaxConnections = 2;
+
+		KSQLPool Pool(Prototype, Options);
+
+		KSQL* pFirst;
+
+		{
+			auto db = Pool.Get();
+			REQUIRE ( db );
+			CHECK   ( db->IsConnectionOpen() );
+			pFirst = db.get();
+
+			auto Stats = Pool.GetStats();
+			CHECK ( Stats.iBorrowed == 1 );
+			CHECK ( Stats.iIdle     == 0 );
+		}
+
+		auto Stats = Pool.GetStats();
+		CHECK ( Stats.iBorrowed == 0 );
+		CHECK ( Stats.iIdle     == 1 );
+		CHECK ( Stats.iConnects == 1 );
+
+		{
+			// the same connection is handed out again
+			auto db = Pool.Get();
+			REQUIRE ( db );
+			CHECK   ( db.get() == pFirst );
+			CHECK   ( db->SingleStringQuery("select astring from POOL_TEST where anum=1") == "one" );
+
+			// a second one is opened
+			auto db2 = Pool.Get();
+			REQUIRE ( db2 );
+			CHECK   ( db2.get() != pFirst );
+			CHECK   ( Pool.GetStats().iPeakBorrowed == 2 );
+		}
+
+		Stats = Pool.GetStats();
+		CHECK ( Stats.iIdle     == 2 );
+		CHECK ( Stats.iConnects == 2 );
+		CHECK ( Stats.iGets     == 3 );
+
+		Pool.clear();
+		CHECK ( Pool.GetStats().iIdle == 0 );
+	}
+
+	SECTION("unread results")
+	{
+		KSQLPool::Options Options;
+		Options.iMaxConnections = 1;
+
+		KSQLPool Pool(Prototype, Options);
+
+		{
+			auto db = Pool.Get();
+			REQUIRE ( db );
+			CHECK   ( db->ExecQuery("select anum from POOL_TEST") );
+			// returned with an open result set
+		}
+
+		auto db = Pool.Get();
+		REQUIRE ( db );
+		CHECK   ( db->SingleIntQuery("select count(*) from POOL_TEST") == 1 );
+	}
+
+	SECTION("discard")
+	{
+		KSQLPool Pool(Prototype);
+
+		{
+			auto db = Pool.Get();
+			REQUIRE ( db );
+			db.Discard();
+			CHECK ( !db );
+		}
+
+		auto Stats = Pool.GetStats();
+		CHECK ( Stats.iBorrowed == 0 );
+		CHECK ( Stats.iIdle     == 0 );
+
+		auto db = Pool.Get();
+		REQUIRE ( db );
+		CHECK ( Pool.GetStats().iConnects == 2 );
+	}
+
+	SECTION("validation")
+	{
+		KSQLPool::Options Options;
+		Options.ValidateAfterIdle = KDuration::zero();
+		// no background thread, to see the lazy validation at work
+		Options.Maintenance       = KDuration::zero();
+
+		KSQLPool Pool(Prototype, Options);
+
+		{
+			auto db = Pool.Get();
+			REQUIRE ( db );
+			// a closed connection is not returned into the pool
+			db->CloseConnection();
+		}
+
+		CHECK ( Pool.GetStats().iIdle == 0 );
+
+		KSQL* pIdle;
+
+		{
+			auto db = Pool.Get();
+			REQUIRE ( db );
+			pIdle = db.get();
+		}
+
+		CHECK ( Pool.GetStats().iIdle == 1 );
+		// simulate a connection lost while idle
+		pIdle->CloseConnection();
+
+		{
+			auto db = Pool.Get();
+			REQUIRE ( db );
+			CHECK   ( db.get() == pIdle );
+			CHECK   ( db->IsConnectionOpen() );
+			CHECK   ( db->SingleIntQuery("select count(*) from POOL_TEST") == 1 );
+		}
+
+		{
+			auto db = Pool.Get();
+			REQUIRE ( db );
+		}
+
+		auto Stats = Pool.GetStats();
+		CHECK ( Stats.iValidations == 2 );
+		CHECK ( Stats.iInvalid     == 1 );
+		CHECK ( Stats.iConnects    == 3 );
+	}
+
+	SECTION("timeout")
+	{
+		KSQLPool::Options Options;
+		Options.iMaxConnections = 1;
+		Options.MaxWait         = chrono::milliseconds(50);
+
+		KSQLPool Pool(Prototype, Options);
+
+		auto db = Pool.Get();
+		REQUIRE ( db );
+
+		auto db2 = Pool.Get();
+		CHECK ( !db2 );
+		CHECK ( Pool.GetLastError().contains("timeout") );
+
+		auto Stats = Pool.GetStats();
+		CHECK ( Stats.iTimeouts == 1 );
+		CHECK ( Stats.Occupancy() == 100.0 );
+
+		db.Release();
+		db2 = Pool.Get();
+		CHECK ( db2 );
+	}
+
+	SECTION("connect retry")
+	{
+		KSQL Unreachable;
+		Unreachable.SetDBType(KSQL::DBT::SQLITE3);
+		Unreachable.SetDBName(kFormat("{}/no/such/dir/ksqlpool_test.db", g_KSQLPoolTempDir.Name()));
+
+		KSQLPool::Options Options;
+		Options.MaxWait     = chrono::milliseconds(100);
+		Options.Maintenance = KDuration::zero();
+
+		KSQLPool Pool(Unreachable, Options);
+
+		KStopTime Timer;
+		auto db = Pool.Get();
+		CHECK ( !db );
+		// the failed connect was retried until MaxWait was exhausted
+		CHECK ( Timer.elapsed() >= chrono::milliseconds(100) );
+
+		auto Stats = Pool.GetStats();
+		CHECK ( Stats.iConnectErrors > 1 );
+		CHECK ( Stats.iBorrowed      == 0 );
+	}
+
+	SECTION("concurrency")
+	{
+		KSQLPool::Options Options;
+		Options.iMaxConnections = 3;
+
+		KSQLPool Pool(Prototype, Options);
+
+		std::atomic<int> iGood { 0 };
+		std::vector<std::thread> Threads;
+
+		for (int i = 0; i < 8; ++i)
+		{
+			Threads.push_back(kMakeThread([&Pool, &iGood]()
+			{
+				for (int j = 0; j < 20; ++j)
+				{
+					auto db = Pool.Get();
+
+					if (db && db->SingleIntQuery("select count(*) from POOL_TEST") == 1)
+					{
+						++iGood;
+					}
+				}
+			}));
+		}
+
+		for (auto& Thread : Threads)
+		{
+			Thread.join();
+		}
+
+		CHECK ( iGood == 8 * 20 );
+
+		auto Stats = Pool.GetStats();
+		CHECK ( Stats.iBorrowed     == 0 );
+		CHECK ( Stats.iPeakBorrowed <= 3 );
+		CHECK ( Stats.iConnects     <= 3 );
+		CHECK ( Stats.iGets         == 8 * 20 );
+	}
+
+	SECTION("background maintenance")
+	{
+		KSQLPool::Options Options;
+		Options.iMinIdle    = 2;
+		Options.MaxIdleTime = chrono::milliseconds(1);
+		Options.Maintenance = chrono::milliseconds(10);
+
+		KSQLPool Pool(Prototype, Options);
+
+		for (int i = 0; i < 100 && Pool.GetStats().iIdle < 2; ++i)
+		{
+			kSleep(chrono::milliseconds(10));
+		}
+
+		// the pool was filled up to the minimum idle count
+		CHECK ( Pool.GetStats().iIdle == 2 );
+
+		{
+			auto db1 = Pool.Get();
+			auto db2 = Pool.Get();
+			auto db3 = Pool.Get();
+			CHECK ( db3 );
+		}
+
+		for (int i = 0; i < 100 && Pool.GetStats().iIdle > 2; ++i)
+		{
+			kSleep(chrono::milliseconds(10));
+		}
+
+		// the idle connections above the minimum expired
+		auto Stats = Pool.GetStats();
+		CHECK ( Stats.iIdle    == 2 );
+		CHECK ( Stats.iExpired == 1 );
+	}
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE("KSQLPools")
+//-----------------------------------------------------------------------------
+{
+	KSQL Prototype;
+	Prototype.SetDBType(KSQL::DBT::SQLITE3);
+	Prototype.SetDBName(kFormat("{}/ksqlpools_test.db", g_KSQLPoolTempDir.Name()));
+
+	auto sDBC = kFormat("{}/pool.dbc", g_KSQLPoolTempDir.Name());
+	REQUIRE ( Prototype.SaveConnect(sDBC) );
+
+	KSQLPools Pools;
+
+	auto& Pool = Pools.GetPool(sDBC);
+	CHECK ( &Pools.GetPool(sDBC) == &Pool );
+	CHECK ( Pool.GetDBC() == sDBC );
+
+	{
+		auto db = Pools.Get(sDBC);
+		REQUIRE ( db );
+		CHECK   ( db->SingleIntQuery("select 42") == 42 );
+	}
+
+	auto Stats = Pools.GetStats();
+	REQUIRE ( Stats.size() == 1 );
+	CHECK   ( Stats.begin()->first == sDBC );
+	CHECK   ( Stats.begin()->second.iIdle == 1 );
+
+	Pools.clear();
+	CHECK ( Pool.GetStats().iIdle == 0 );
+
+	auto db = Pools.Get(kFormat("{}/missing.dbc", g_KSQLPoolTempDir.Name()));
+	CHECK ( !db );
+}
+
+#endif // DEKAF2_HAS_SQLITE3
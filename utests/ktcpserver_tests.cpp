@@ -1,11 +1,42 @@
 #include "catch.hpp"
 
 #include <dekaf2/net/tcp/ktcpserver.h>
+#include <dekaf2/net/tcp/ktcpstream.h>
 #include <dekaf2/system/os/ksystem.h>
 #include <thread>
+#include <numeric>
 
 using namespace dekaf2;
 
+namespace {
+
+class KEchoServer : public KTCPServer
+{
+
+public:
+
+	using KTCPServer::KTCPServer;
+
+protected:
+
+	virtual bool Accepted(std::unique_ptr<KIOStreamSocket>& stream) override
+	{
+		stream->SetReaderRightTrim("\r\n");
+		stream->SetWriterEndOfLine("\r\n");
+		return true;
+	}
+
+	virtual KString Request(KStringRef& sLine, Parameters& parameters) override
+	{
+		// one echo per connection
+		parameters.terminate = true;
+		return sLine + "\r\n";
+	}
+
+}; // KEchoServer
+
+} // end of anonymous namespace
+
 // This test works, but somehow the signal gets the catch framework into
 // a bad state so that other tests spuriously fail when this test is run.
 // Therefore it is in general disabled, except when we want to explicitly
@@ -20,6 +51,62 @@ TEST_CASE("KTCPServer::IsPortAvailable")
 	CHECK ( KTCPServer::IsPortAvailable(30306, "not.an.ip.address") == false );
 }
 
+TEST_CASE("KTCPServer::SetAcceptShards")
+{
+	KEchoServer Server(7615, false, 4);
+	Server.SetBindAddress("127.0.0.1");
+	Server.SetAcceptShards(4, true);
+
+	CHECK ( Server.GetAcceptShards() == 4 );
+	REQUIRE ( Server.Start(chrono::seconds(5), false) == true );
+
+	for (int i = 0; i < 16; ++i)
+	{
+		KTCPStream Stream(KTCPEndPoint("127.0.0.1:7615"), KStreamOptions(chrono::seconds(2)));
+		REQUIRE ( Stream.Good() == true );
+
+		Stream.SetReaderRightTrim("\r\n");
+		Stream.SetWriterEndOfLine("\r\n");
+		Stream.WriteLine("hello").Flush();
+
+		KString sLine;
+		CHECK ( Stream.ReadLine(sLine) == true );
+		CHECK ( sLine == "hello" );
+	}
+
+	auto Diag = Server.GetDiagnostics();
+
+	CHECK ( Diag.ShardAccepts.size() == 4 );
+	CHECK ( std::accumulate(Diag.ShardAccepts.begin(), Diag.ShardAccepts.end(), std::size_t(0)) == 16 );
+
+	Server.Stop();
+	CHECK ( Server.IsRunning() == false );
+
+	// Stop() stopped the shard io_contexts and pools, a restart sets them up again
+	REQUIRE ( Server.Start(chrono::seconds(5), false) == true );
+
+	for (int i = 0; i < 8; ++i)
+	{
+		KTCPStream Stream(KTCPEndPoint("127.0.0.1:7615"), KStreamOptions(chrono::seconds(2)));
+		REQUIRE ( Stream.Good() == true );
+
+		Stream.SetReaderRightTrim("\r\n");
+		Stream.SetWriterEndOfLine("\r\n");
+		Stream.WriteLine("again").Flush();
+
+		KString sLine;
+		CHECK ( Stream.ReadLine(sLine) == true );
+		CHECK ( sLine == "again" );
+	}
+
+	// the restart counts its accepts anew
+	Diag = Server.GetDiagnostics();
+	CHECK ( Diag.ShardAccepts.size() == 4 );
+	CHECK ( std::accumulate(Diag.ShardAccepts.begin(), Diag.ShardAccepts.end(), std::size_t(0)) == 8 );
+
+	Server.Stop();
+}
+
 #ifdef DEKAF2_ENABLE_KTCPSERVER_TEST
 
 TEST_CASE("KTCPServer")
@@ -6,6 +6,8 @@
 #include <dekaf2/core/logging/klog.h>
 #include <dekaf2/core/init/dekaf2.h>
 #include <atomic>
+#include <mutex>
+#include <vector>
 
 using namespace dekaf2;
 
@@ -123,4 +125,138 @@ TEST_CASE("KTimer")
 		// the destructor waited for the callback thread
 		CHECK ( bDone == true );
 	}
+
+	SECTION("repeating timers do not drift")
+	{
+		KTimer Timer(chrono::milliseconds(50));
+
+		std::mutex Mutex;
+		std::vector<std::chrono::steady_clock::time_point> Calls;
+
+		auto ID = Timer.CallEvery(chrono::milliseconds(10), [&](KUnixTime)
+		{
+			std::lock_guard<std::mutex> Lock(Mutex);
+			Calls.push_back(std::chrono::steady_clock::now());
+
+		}, false);
+
+		// keeps the timing thread busy, so the first timer is often seen late -
+		// this must not delay its next expirations
+		auto BusyID = Timer.CallEvery(chrono::milliseconds(6), [&](KUnixTime)
+		{
+			kSleep(chrono::milliseconds(5));
+
+		}, false);
+
+		kSleep(chrono::milliseconds(600));
+
+		CHECK ( Timer.Cancel(BusyID) );
+		CHECK ( Timer.Cancel(ID) );
+
+		std::lock_guard<std::mutex> Lock(Mutex);
+		REQUIRE ( Calls.size() > 10 );
+
+		auto Elapsed = Calls.back() - Calls.front();
+		// with drift, each period would last longer than 10 ms
+		CHECK ( chrono::milliseconds(10) * (Calls.size() - 1) >= Elapsed * 9 / 10 );
+	}
+
+	SECTION("repeating timers skip missed periods")
+	{
+		KTimer Timer(chrono::milliseconds(50));
+
+		std::mutex Mutex;
+		std::vector<std::chrono::steady_clock::time_point> Calls;
+
+		auto ID = Timer.CallEvery(chrono::milliseconds(20), [&](KUnixTime)
+		{
+			bool bFirst;
+			{
+				std::lock_guard<std::mutex> Lock(Mutex);
+				Calls.push_back(std::chrono::steady_clock::now());
+				bFirst = Calls.size() == 1;
+			}
+
+			if (bFirst)
+			{
+				// miss a few periods
+				kSleep(chrono::milliseconds(110));
+			}
+
+		}, false);
+
+		kSleep(chrono::milliseconds(400));
+
+		CHECK ( Timer.Cancel(ID) );
+
+		std::lock_guard<std::mutex> Lock(Mutex);
+		REQUIRE ( Calls.size() > 3 );
+
+		// the missed periods are not called in a burst - the late call is
+		// followed by the next one on the original period grid
+		for (std::size_t i = 2; i < Calls.size(); ++i)
+		{
+			CHECK ( Calls[i] - Calls[i - 1] >= chrono::milliseconds(5) );
+		}
+	}
+
+	SECTION("an earlier timer wakes up the timing thread")
+	{
+		// the timing thread would sleep for up to 10 seconds
+		KTimer Timer(chrono::seconds(10));
+
+		std::atomic<bool> bFired { false };
+
+		Timer.CallOnce(chrono::seconds(60), [](KUnixTime) {}, false);
+
+		// let the thread go to sleep
+		kSleep(chrono::milliseconds(50));
+
+		auto Start = std::chrono::steady_clock::now();
+
+		Timer.CallOnce(chrono::milliseconds(20), [&](KUnixTime)
+		{
+			bFired = true;
+
+		}, false);
+
+		for (int i = 0; i < 500 && !bFired; ++i)
+		{
+			kSleep(chrono::milliseconds(10));
+		}
+
+		CHECK ( bFired == true );
+		CHECK ( std::chrono::steady_clock::now() - Start < chrono::seconds(5) );
+	}
+
+	SECTION("own thread callbacks run in parallel on the pool")
+	{
+		KTimer Timer(chrono::milliseconds(10), 4);
+
+		std::atomic<int> iRunning    { 0 };
+		std::atomic<int> iMaxRunning { 0 };
+		std::atomic<int> iDone       { 0 };
+
+		for (int i = 0; i < 4; ++i)
+		{
+			Timer.CallOnce(chrono::milliseconds(10), [&](KUnixTime)
+			{
+				auto iNow = ++iRunning;
+				auto iMax = iMaxRunning.load();
+				while (iNow > iMax && !iMaxRunning.compare_exchange_weak(iMax, iNow)) {}
+				kSleep(chrono::milliseconds(100));
+				--iRunning;
+				++iDone;
+
+			}, true);
+		}
+
+		for (int i = 0; i < 500 && iDone < 4; ++i)
+		{
+			kSleep(chrono::milliseconds(10));
+		}
+
+		CHECK ( iDone == 4 );
+		CHECK ( iMaxRunning > 1 );
+	}
 }
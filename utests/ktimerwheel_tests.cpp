@@ -0,0 +1,182 @@
+#include "catch.hpp"
+#include <dekaf2/time/duration/ktimerwheel.h>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace dekaf2;
+
+namespace {
+
+struct TestNode : public KTimerWheel::Node
+{
+	int iID { 0 };
+};
+
+} // end of anonymous namespace
+
+//-----------------------------------------------------------------------------
+TEST_CASE("KTimerWheel")
+//-----------------------------------------------------------------------------
+{
+	SECTION("add and remove")
+	{
+		KTimerWheel Wheel;
+		TestNode N1, N2, N3;
+
+		CHECK ( Wheel.empty() );
+		CHECK ( Wheel.NextEvent() == KTimerWheel::NoEvent );
+
+		Wheel.Add(N1, 10);
+		Wheel.Add(N2, 5000);
+		Wheel.Add(N3, 10);
+
+		CHECK ( Wheel.size() == 3 );
+		CHECK ( N1.IsLinked() );
+		CHECK ( N2.GetExpiration() == 5000 );
+		CHECK ( Wheel.NextEvent() == 10 );
+
+		Wheel.Remove(N1);
+		Wheel.Remove(N1);
+		CHECK ( !N1.IsLinked() );
+		CHECK ( Wheel.size() == 2 );
+
+		// moving a linked node
+		Wheel.Add(N3, 3);
+		CHECK ( Wheel.size() == 2 );
+		CHECK ( Wheel.NextEvent() == 3 );
+
+		// a copy is not linked
+		TestNode N4 = N3;
+		CHECK ( !N4.IsLinked() );
+
+		Wheel.Remove(N2);
+		Wheel.Remove(N3);
+		CHECK ( Wheel.empty() );
+		CHECK ( Wheel.NextEvent() == KTimerWheel::NoEvent );
+	}
+
+	SECTION("expiration order")
+	{
+		KTimerWheel Wheel(100);
+		std::vector<KTimerWheel::Tick> Expirations { 101, 100, 50, 163, 164, 4196, 262244, 1ull << 36, (1ull << 40) + 7 };
+		std::vector<TestNode> Nodes(Expirations.size());
+
+		for (std::size_t i = 0; i < Nodes.size(); ++i)
+		{
+			Nodes[i].iID = static_cast<int>(i);
+			Wheel.Add(Nodes[i], Expirations[i]);
+		}
+
+		// expired nodes are due at once
+		CHECK ( Wheel.NextEvent() == 100 );
+
+		std::vector<std::pair<int, KTimerWheel::Tick>> Fired;
+
+		auto OnExpired = [&](KTimerWheel::Node& Node)
+		{
+			CHECK ( !Node.IsLinked() );
+			Fired.emplace_back(static_cast<TestNode&>(Node).iID, Wheel.Now());
+		};
+
+		Wheel.Advance(163, OnExpired);
+		REQUIRE ( Fired.size() == 4 );
+		CHECK ( Fired[2] == std::make_pair(0, KTimerWheel::Tick(101)) );
+		CHECK ( Fired[3] == std::make_pair(3, KTimerWheel::Tick(163)) );
+		CHECK ( Wheel.Now() == 163 );
+
+		Wheel.Advance(KTimerWheel::Tick(1) << 41, OnExpired);
+		REQUIRE ( Fired.size() == Nodes.size() );
+		CHECK ( Fired[4] == std::make_pair(4, KTimerWheel::Tick(164)) );
+		CHECK ( Fired[5] == std::make_pair(5, KTimerWheel::Tick(4196)) );
+		CHECK ( Fired[6] == std::make_pair(6, KTimerWheel::Tick(262244)) );
+		CHECK ( Fired[7] == std::make_pair(7, KTimerWheel::Tick(1) << 36) );
+		CHECK ( Fired[8] == std::make_pair(8, (KTimerWheel::Tick(1) << 40) + 7) );
+		CHECK ( Wheel.empty() );
+	}
+
+	SECTION("re-adding from the callback")
+	{
+		KTimerWheel Wheel;
+		TestNode Node;
+		std::vector<KTimerWheel::Tick> Fired;
+
+		Wheel.Add(Node, 10);
+
+		Wheel.Advance(1000, [&](KTimerWheel::Node& N)
+		{
+			Fired.push_back(Wheel.Now());
+			Wheel.Add(N, Wheel.Now() + 300);
+		});
+
+		CHECK ( Fired == (std::vector<KTimerWheel::Tick> { 10, 310, 610, 910 }) );
+		CHECK ( Node.GetExpiration() == 1210 );
+		CHECK ( Wheel.size() == 1 );
+	}
+
+	SECTION("random timers against a multimap")
+	{
+		std::mt19937_64 Random(4711);
+		KTimerWheel Wheel;
+		std::vector<TestNode> Nodes(2000);
+		std::multimap<KTimerWheel::Tick, int> Expected;
+
+		auto RandomTick = [&]()
+		{
+			// mix of close and far expirations
+			auto iBits = Random() % 40;
+			return Wheel.Now() + (Random() & ((KTimerWheel::Tick(1) << iBits) - 1));
+		};
+
+		for (std::size_t i = 0; i < Nodes.size(); ++i)
+		{
+			Nodes[i].iID = static_cast<int>(i);
+			Wheel.Add(Nodes[i], RandomTick());
+		}
+
+		// remove and move some of them
+		for (std::size_t i = 0; i < Nodes.size(); i += 3)
+		{
+			if (i % 2) Wheel.Remove(Nodes[i]);
+			else       Wheel.Add(Nodes[i], RandomTick());
+		}
+
+		for (const auto& Node : Nodes)
+		{
+			if (Node.IsLinked()) Expected.emplace(Node.GetExpiration(), Node.iID);
+		}
+
+		CHECK ( Wheel.size() == Expected.size() );
+
+		KTimerWheel::Tick iLast = 0;
+		std::size_t iFired = 0;
+		bool bOrdered = true;
+		bool bOnTime  = true;
+
+		auto OnExpired = [&](KTimerWheel::Node& Node)
+		{
+			auto& TNode = static_cast<TestNode&>(Node);
+			auto it = Expected.find(Wheel.Now());
+
+			while (it != Expected.end() && it->first == Wheel.Now() && it->second != TNode.iID) ++it;
+
+			if (it == Expected.end() || it->first != Wheel.Now()) bOnTime = false;
+			else Expected.erase(it);
+
+			if (Wheel.Now() < iLast) bOrdered = false;
+			iLast = Wheel.Now();
+			++iFired;
+		};
+
+		// advance in random steps
+		while (!Wheel.empty())
+		{
+			Wheel.Advance(Wheel.Now() + (Random() % (KTimerWheel::Tick(1) << 30)), OnExpired);
+		}
+
+		CHECK ( bOrdered );
+		CHECK ( bOnTime  );
+		CHECK ( Expected.empty() );
+		CHECK ( iFired > 0 );
+	}
+}
@@ -1,6 +1,8 @@
 #include "catch.hpp"
 
 #include <dekaf2/net/tls/ktlscontext.h>
+#include <dekaf2/net/tls/ktlsstream.h>
+#include <dekaf2/net/tcp/ktcpserver.h>
 #include <dekaf2/crypto/rsa/krsacert.h>
 #include <dekaf2/crypto/rsa/krsakey.h>
 #include <openssl/opensslv.h>
@@ -52,6 +54,9 @@ struct TLSPair
 
 	~TLSPair()
 	{
+		// a clean shutdown keeps OpenSSL from invalidating the server side session
+		::SSL_shutdown(client);
+		::SSL_shutdown(server);
 		::SSL_free(client);
 		::SSL_free(server);
 	}
@@ -106,6 +111,13 @@ struct TLSPair
 		return sCN;
 	}
 
+	// TLS 1.3 sends the session tickets after the handshake - let the client read them
+	void ReadTickets()
+	{
+		char Buffer[1];
+		::SSL_read(client, Buffer, sizeof(Buffer));
+	}
+
 	KStringView SelectedALPN()
 	{
 		const unsigned char* pProto;
@@ -119,6 +131,30 @@ struct TLSPair
 
 }; // TLSPair
 
+class KTLSEchoServer : public KTCPServer
+{
+
+public:
+
+	using KTCPServer::KTCPServer;
+
+protected:
+
+	virtual bool Accepted(std::unique_ptr<KIOStreamSocket>& stream) override
+	{
+		stream->SetReaderRightTrim("\r\n");
+		stream->SetWriterEndOfLine("\r\n");
+		return true;
+	}
+
+	virtual KString Request(KStringRef& sLine, Parameters& parameters) override
+	{
+		parameters.terminate = true;
+		return sLine + "\r\n";
+	}
+
+}; // KTLSEchoServer
+
 } // end of anonymous namespace
 
 TEST_CASE("KTLSContext")
@@ -219,6 +255,114 @@ TEST_CASE("KTLSContext")
 		}
 	}
 
+	SECTION("SessionResumption")
+	{
+		// returns true if the client offered a cached session, and the server resumed it
+		auto Connect = [&ClientCtx](KTLSContext& Server, const char* sSNI, KStringView sSessionKey) -> bool
+		{
+			TLSPair Pair(Server, ClientCtx);
+
+			if (sSNI)
+			{
+				CHECK ( ::SSL_set_tlsext_host_name(Pair.client, sSNI) == 1 );
+			}
+
+			ClientCtx.SetClientSession(Pair.client, sSessionKey);
+			REQUIRE ( Pair.Handshake() == true );
+			Pair.ReadTickets();
+
+			return ::SSL_session_reused(Pair.client) == 1;
+		};
+
+		CHECK ( Connect(*Default, nullptr, "default") == false );
+		CHECK ( Connect(*Default, nullptr, "default") == true  );
+		CHECK ( Connect(*Default, nullptr, "other"  ) == false );
+
+		// SNI contexts resume through the accepting context
+		CHECK ( Connect(*Default, "alpha.test", "alpha") == false );
+		CHECK ( Connect(*Default, "alpha.test", "alpha") == true  );
+
+		// an older ticket key still decrypts, and the ticket gets renewed
+		CHECK ( Default->RotateSessionTicketKey() == true );
+		CHECK ( Connect(*Default, nullptr, "default") == true  );
+		CHECK ( Default->RotateSessionTicketKey() == true );
+		CHECK ( Default->RotateSessionTicketKey() == true );
+		CHECK ( Connect(*Default, nullptr, "default") == false );
+		CHECK ( Connect(*Default, nullptr, "default") == true  );
+
+		// a session is not resumed for a host with another certificate
+		CHECK ( Connect(*Default, "www.wild.test", "alpha") == false );
+
+		// without tickets, the server side session cache resumes
+		CHECK ( Default->SetSessionTickets(false) == true );
+		CHECK ( Connect(*Default, nullptr, "default") == false );
+		CHECK ( Connect(*Default, nullptr, "default") == true  );
+		CHECK ( Default->SetSessionCache(0) == true );
+		CHECK ( Connect(*Default, nullptr, "default") == false );
+		CHECK ( Connect(*Default, nullptr, "default") == false );
+		CHECK ( Default->SetSessionCache(100) == true );
+		CHECK ( Default->SetSessionTickets(true) == true );
+
+		// no client cache, no resumption
+		CHECK ( ClientCtx.SetSessionCache(0) == true );
+		CHECK ( Connect(*Default, nullptr, "default") == false );
+		CHECK ( Connect(*Default, nullptr, "default") == false );
+		CHECK ( ClientCtx.SetSessionCache(10) == true );
+		CHECK ( Connect(*Default, nullptr, "default") == false );
+		CHECK ( Connect(*Default, nullptr, "default") == true  );
+		ClientCtx.ClearClientSessions();
+		CHECK ( Connect(*Default, nullptr, "default") == false );
+
+		CHECK ( ClientCtx.RotateSessionTicketKey()  == false );
+		CHECK ( Default->AddSessionTicketKey("short") == false );
+	}
+
+	SECTION("SharedTicketKeys")
+	{
+		// two servers with the same certificate and ticket key resume each other's sessions
+		KRSACert Cert(Key, "cluster.test", "US");
+		KTLSContext Server1(true);
+		KTLSContext Server2(true);
+		CHECK ( Server1.SetTLSCertificates(Cert.GetPEM(), Key.GetPEM(true)) == true );
+		CHECK ( Server2.SetTLSCertificates(Cert.GetPEM(), Key.GetPEM(true)) == true );
+
+		KString sTicketKey;
+
+		for (int i = 0; i < 80; ++i)
+		{
+			sTicketKey += static_cast<char>(i * 7);
+		}
+
+		CHECK ( Server1.AddSessionTicketKey(sTicketKey) == true );
+
+		{
+			TLSPair Pair(Server1, ClientCtx);
+			ClientCtx.SetClientSession(Pair.client, "cluster");
+			REQUIRE ( Pair.Handshake() == true );
+			Pair.ReadTickets();
+		}
+
+		{
+			// Server2 does not know the key yet
+			TLSPair Pair(Server2, ClientCtx);
+			CHECK   ( ClientCtx.SetClientSession(Pair.client, "cluster") == true );
+			REQUIRE ( Pair.Handshake() == true );
+			CHECK   ( ::SSL_session_reused(Pair.client) == 0 );
+			Pair.ReadTickets();
+		}
+
+		CHECK ( Server2.AddSessionTicketKey(sTicketKey) == true );
+
+		for (auto* Server : { &Server2, &Server1, &Server2 })
+		{
+			TLSPair Pair(*Server, ClientCtx);
+			CHECK   ( ClientCtx.SetClientSession(Pair.client, "cluster") == true );
+			REQUIRE ( Pair.Handshake() == true );
+			CHECK   ( ::SSL_session_reused(Pair.client) == 1 );
+			Pair.ReadTickets();
+		}
+	}
+
 #if OPENSSL_VERSION_NUMBER >= 0x10101000L && !defined(LIBRESSL_VERSION_NUMBER)
 	SECTION("SNICallback")
 	{
@@ -257,3 +401,37 @@ TEST_CASE("KTLSContext")
 	}
 #endif
 }
+
+TEST_CASE("KTLSStream session resumption")
+{
+	KTLSEchoServer Server(7616, true, 4);
+	Server.SetBindAddress("127.0.0.1");
+	REQUIRE ( Server.Start(chrono::seconds(5), false) == true );
+
+	KTLSContext ClientCtx(false);
+
+	auto Echo = [&ClientCtx](KStringView sEndpoint) -> bool
+	{
+		KTLSStream Stream(ClientCtx, KTCPEndPoint(sEndpoint), KStreamOptions(chrono::seconds(2)));
+		REQUIRE ( Stream.Good() == true );
+
+		Stream.SetReaderRightTrim("\r\n");
+		Stream.SetWriterEndOfLine("\r\n");
+		Stream.WriteLine("hello").Flush();
+
+		KString sLine;
+		CHECK ( Stream.ReadLine(sLine) == true );
+		CHECK ( sLine == "hello" );
+
+		return ::SSL_session_reused(Stream.GetNativeTLSHandle()) == 1;
+	};
+
+	CHECK ( Echo("127.0.0.1:7616") == false );
+	CHECK ( Echo("127.0.0.1:7616") == true  );
+	CHECK ( Echo("127.0.0.1:7616") == true  );
+	// sessions are cached per endpoint
+	CHECK ( Echo("localhost:7616") == false );
+	CHECK ( Echo("localhost:7616") == true  );
+
+	Server.Stop();
+}
@@ -600,6 +600,83 @@ TEST_CASE("KWebSocket")
 		CHECK ( RxFrame.GetPayload() == sData );
 	}
 
+	SECTION("masking of all payload sizes at the wire level")
+	{
+		for (std::size_t iSize = 0; iSize <= 200; ++iSize)
+		{
+			KString sData;
+			for (std::size_t i = 0; i < iSize; ++i) sData += static_cast<KString::value_type>(i * 7 + 3);
+
+			KWebSocket::Frame TxFrame(KWebSocket::FrameHeader::Binary, sData);
+
+			KString sWire;
+			KOutStringStream oss(sWire);
+			CHECK ( TxFrame.Write(oss, true) );
+
+			// decode the header in one step and unmask the payload byte by byte
+			KWebSocket::FrameHeader Header;
+			auto iHeaderSize = Header.DecodeHeader(sWire);
+			INFO ( "size " << iSize );
+			REQUIRE ( iHeaderSize == KWebSocket::FrameHeader::GetHeaderSize(static_cast<uint8_t>(sWire[1])) );
+			CHECK ( Header.IsMaskedRx() );
+			CHECK ( Header.AnnouncedSize() == iSize );
+			REQUIRE ( sWire.size() == iHeaderSize + iSize );
+
+			auto sMask = sWire.ToView(iHeaderSize - 4, 4);
+			KString sUnmasked = sWire.Mid(iHeaderSize);
+
+			for (std::size_t i = 0; i < sUnmasked.size(); ++i)
+			{
+				sUnmasked[i] ^= sMask[i % 4];
+			}
+
+			CHECK ( sUnmasked == sData );
+
+			// and the regular receive path unmasks in place
+			KInStringStream iss(sWire);
+			KString sOutBuf;
+			KOutStringStream oss2(sOutBuf);
+			KWebSocket::Frame RxFrame;
+			CHECK ( RxFrame.Read(iss, oss2, false) );
+			CHECK ( RxFrame.GetPayload() == sData );
+		}
+	}
+
+	SECTION("one step and byte wise header decoding agree")
+	{
+		for (auto iSize : { 0, 5, 125, 126, 300, 65535, 65536, 70000 })
+		{
+			for (bool bMask : { false, true })
+			{
+				KWebSocket::Frame TxFrame(KWebSocket::FrameHeader::Text, KString(iSize, 'x'));
+
+				KString sWire;
+				KOutStringStream oss(sWire);
+				CHECK ( TxFrame.Write(oss, bMask) );
+
+				KWebSocket::FrameHeader OneStep;
+				auto iHeaderSize = OneStep.DecodeHeader(sWire);
+				INFO ( "size " << iSize << " mask " << bMask );
+				CHECK ( iHeaderSize == sWire.size() - iSize );
+
+				// an incomplete header is not decoded
+				KWebSocket::FrameHeader Partial;
+				CHECK ( Partial.DecodeHeader(sWire.ToView(0, iHeaderSize - 1)) == 0 );
+
+				KWebSocket::FrameHeader ByteWise;
+				std::size_t iPos = 0;
+				while (!ByteWise.Decode(static_cast<uint8_t>(sWire[iPos++]))) {}
+
+				CHECK ( iPos == iHeaderSize );
+				CHECK ( OneStep.Serialize()     == ByteWise.Serialize()     );
+				CHECK ( OneStep.AnnouncedSize() == ByteWise.AnnouncedSize() );
+				CHECK ( OneStep.Type()          == KWebSocket::FrameHeader::Text );
+				CHECK ( OneStep.Finished()      );
+				CHECK ( OneStep.IsMaskedRx()    == bMask );
+			}
+		}
+	}
+
 	SECTION("Pong frame round-trip")
 	{
 		KWebSocket::Frame TxFrame(KWebSocket::FrameHeader::Pong, "pong-response");